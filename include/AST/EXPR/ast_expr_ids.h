@@ -134,6 +134,8 @@ enum {
     EXPR_DECLARE_NAMED_EXPRESSION,
     EXPR_CONDITIONLESS_BLOCK,
     EXPR_ASSERT,
+    EXPR_ASSUME,
+    EXPR_YIELD,
     EXPR_TOTAL,
 };
 
@@ -20,6 +20,7 @@ extern "C" {
 #include "AST/ast_named_expression.h"
 #include "AST/ast_type.h"
 #include "AST/meta_directives.h"
+#include "UTIL/chunked_list.h"
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
 #include "UTIL/index_id_list.h"
@@ -39,6 +40,7 @@ typedef struct {
     ast_expr_t **arg_defaults; // maybe null array of maybe null pointers
     length_t arity;
     ast_type_t return_type;
+    ast_type_t yield_type; // Only exists for generators, otherwise AST_TYPE_NONE
     trait_t traits;
     strong_cstr_t variadic_arg_name;
     source_t variadic_source;
@@ -46,6 +48,7 @@ typedef struct {
     source_t source;
     maybe_null_strong_cstr_t export_as;
     length_t instantiation_depth;
+    length_t unparsed_body_index; // Only exists if AST_FUNC_UNPARSED_BODY
     
     union {
         func_id_t virtual_origin; // can be INVALID_FUNC_ID
@@ -57,6 +60,12 @@ typedef struct {
     #endif
 } ast_func_t;
 
+// ---------------- ast_funcs_t ----------------
+// List of functions within the root AST
+// NOTE: Functions never move once created, so pointers to them stay valid
+typedef chunkedof(ast_func_t) ast_funcs_t;
+#define ast_funcs_at(LIST, INDEX) chunked_list_at((LIST), (INDEX))
+
 // ---------------- ast_func_alias_t ----------------
 // A function redirection within the root AST
 typedef struct {
@@ -95,16 +104,30 @@ typedef struct {
 #define AST_FUNC_WARN_BAD_PRINTF_FORMAT TRAIT_2_5
 #define AST_FUNC_INIT                   TRAIT_2_6
 #define AST_FUNC_DEINIT                 TRAIT_2_7
+#define AST_FUNC_INFER_PENDING          TRAIT_2_8 // Body has yet to be inferred
+#define AST_FUNC_UNPARSED_BODY          TRAIT_2_9 // Body has yet to be parsed
+#define AST_FUNC_ALWAYS_INLINE          TRAIT_2_A // 'inline' prefix
+#define AST_FUNC_NO_INLINE              TRAIT_2_B // 'noinline' prefix
+#define AST_FUNC_HOT                    TRAIT_2_C // 'hot' prefix
+#define AST_FUNC_COLD                   TRAIT_2_D // 'cold' prefix
+#define AST_FUNC_FLATTEN                TRAIT_2_E // 'flatten' prefix
+#define AST_FUNC_OPTIMIZE_NONE          TRAIT_2_F // 'optimize none' prefix
+#define AST_FUNC_OPTIMIZE_SIZE          TRAIT_2_G // 'optimize size' prefix
+#define AST_FUNC_OPTIMIZE_AGGRESSIVE    (TRAIT_2_F | TRAIT_2_G) // 'optimize aggressive' prefix
+#define AST_FUNC_OPTIMIZE_MASK          (TRAIT_2_F | TRAIT_2_G) // Per-function optimization level (when not zero)
 
 // ------------------ ast_func_prefixes_t ------------------
 // Information about the keywords that prefix a function
+// NOTE: 'performance_traits' holds the AST_FUNC_* traits for 'inline', 'noinline', 'hot', 'cold', 'flatten' and 'optimize'
 typedef struct {
     bool is_stdcall  : 1,
          is_verbatim : 1,
          is_implicit : 1,
          is_external : 1,
          is_virtual  : 1,
-         is_override : 1;
+         is_override : 1,
+         is_generator : 1;
+    trait_t performance_traits;
 } ast_func_prefixes_t;
 
 // ------------------ ast_func_head_t ------------------
@@ -167,6 +190,7 @@ typedef struct {
     ast_expr_t *initial;
     trait_t traits;
     source_t source;
+    length_t alignment; // Explicit 'align(N)' alignment, or zero for natural alignment
 } ast_global_t;
 
 // Possible ast_global_t traits
@@ -188,6 +212,18 @@ typedef struct {
     source_t source;
 } ast_enum_t;
 
+// ---------------- ast_soa_t ----------------
+// A structure-of-arrays container within the root AST
+// (e.g. 'soa Particles = 1024 Particle')
+// A composite with one fixed array column per field of the
+// element type is synthesized for it during inference
+typedef struct {
+    strong_cstr_t name;
+    ast_type_t type;         // Fixed array of the element type
+    ast_type_t element_type; // Element type (only exists after inference)
+    source_t source;
+} ast_soa_t;
+
 typedef struct {
     ast_type_t ast_int_type;
     ast_type_t ast_usize_type;
@@ -206,9 +242,7 @@ typedef struct {
 // ---------------- ast_t ----------------
 // The root AST
 typedef struct {
-    ast_func_t *funcs;
-    length_t funcs_length;
-    length_t funcs_capacity;
+    ast_funcs_t funcs;
     ast_func_alias_t *func_aliases;
     length_t func_aliases_length;
     length_t func_aliases_capacity;
@@ -225,6 +259,9 @@ typedef struct {
     ast_enum_t *enums;
     length_t enums_length;
     length_t enums_capacity;
+    ast_soa_t *soas;
+    length_t soas_length;
+    length_t soas_capacity;
     strong_cstr_t *libraries;
     char *library_kinds;
     length_t libraries_length;
@@ -266,12 +303,18 @@ void ast_free(ast_t *ast);
 
 // ---------------- ast_free_* ----------------
 // Frees a specific part of the data within an AST
-void ast_free_functions(ast_func_t *functions, length_t functions_length);
+void ast_free_functions(ast_funcs_t *functions);
 void ast_free_function_aliases(ast_func_alias_t *faliases, length_t length);
 void ast_free_composites(ast_composite_t *composites, length_t composites_length);
 void ast_free_aliases(ast_alias_t *aliases, length_t aliases_length);
 void ast_free_globals(ast_global_t *globals, length_t globals_length);
 void ast_free_enums(ast_enum_t *enums, length_t enums_length);
+void ast_free_soas(ast_soa_t *soas, length_t soas_length);
+
+// ---------------- ast_func_is_generator ----------------
+// Returns whether an AST function is a generator
+// (considered so if it has a yield type)
+bool ast_func_is_generator(ast_func_t *func);
 
 // ---------------- ast_func_is_method ----------------
 // Returns whether an AST function is method-like
@@ -304,7 +347,7 @@ func_id_t ast_new_func(ast_t *ast);
 void ast_func_create_template(struct compiler *compiler, ast_func_t *func, const ast_func_head_t *options);
 
 // ---------------- ast_func_has_polymorphic_signature ----------------
-// Returns whether an AST function has polymorphic arguments or return type
+// Returns whether an AST function has polymorphic arguments, return type, or yield type
 bool ast_func_has_polymorphic_signature(ast_func_t *func);
 
 // ---------------- ast_alias_init ----------------
@@ -349,6 +392,11 @@ maybe_index_t ast_find_alias(ast_alias_t *aliases, length_t aliases_length, cons
 // Finds a enum expression by name
 maybe_index_t ast_find_enum(ast_enum_t *enums, length_t enums_length, const char *enum_name);
 
+// ---------------- ast_find_soa ----------------
+// Finds a structure-of-arrays container by name
+// NOTE: Requires that 'soas' is sorted
+maybe_index_t ast_find_soa(ast_soa_t *soas, length_t soas_length, const char *soa_name);
+
 // ---------------- ast_find_global ----------------
 // Finds a global variable by name
 // NOTE: Requires that 'globals' is sorted
@@ -368,6 +416,10 @@ void ast_add_alias(ast_t *ast, strong_cstr_t name, ast_type_t strong_type, stron
 // Adds an enum to the global scope of an AST
 void ast_add_enum(ast_t *ast, weak_cstr_t name, weak_cstr_t *kinds, length_t length, source_t source);
 
+// ---------------- ast_add_soa ----------------
+// Adds a structure-of-arrays container to the global scope of an AST
+void ast_add_soa(ast_t *ast, strong_cstr_t name, ast_type_t strong_type, source_t source);
+
 // ---------------- ast_add_global_named_expression ----------------
 // Adds a named expression to the global scope of an AST
 void ast_add_global_named_expression(ast_t *ast, ast_named_expression_t named_expression);
@@ -404,7 +456,8 @@ ast_poly_composite_t *ast_add_poly_composite(
 
 // ---------------- ast_add_global ----------------
 // Adds a global variable to the global scope of an AST
-void ast_add_global(ast_t *ast, weak_cstr_t name, ast_type_t type, ast_expr_t *initial_value, trait_t traits, source_t source);
+// Returns a pointer to the new global, which is only valid until the next global is added
+ast_global_t *ast_add_global(ast_t *ast, weak_cstr_t name, ast_type_t type, ast_expr_t *initial_value, trait_t traits, source_t source);
 
 // ---------------- ast_add_foreign_library ----------------
 // Adds a library to the list of foreign libraries
@@ -425,6 +478,11 @@ int ast_aliases_cmp(const void *a, const void *b);
 // Used for qsort()
 int ast_enums_cmp(const void *a, const void *b);
 
+// ---------------- ast_soas_cmp ----------------
+// Compares two 'ast_soa_t' structures.
+// Used for qsort()
+int ast_soas_cmp(const void *a, const void *b);
+
 // ---------------- ast_poly_funcs_cmp ----------------
 // Compares two 'ast_func_t*' structures by name.
 // Used for qsort()
@@ -96,11 +96,12 @@ typedef struct { DERIVE_AST_EXPR; ast_expr_t *a, *b; } ast_expr_math_t, ast_expr
 
 // ---------------- ast_expr_unary_t ----------------
 // General purpose single-operand expression
-// Used for: address, dereference, bit complement, not, negate, delete, toggle
+// Used for: address, dereference, bit complement, not, negate, delete, toggle, assume
 typedef struct { DERIVE_AST_EXPR; ast_expr_t *value; } ast_expr_unary_t,
     // Aliases
     ast_expr_address_t, ast_expr_dereference_t, ast_expr_bitwise_complement_t, ast_expr_not_t,
-    ast_expr_negate_t, ast_expr_delete_t, ast_expr_toggle_t, ast_expr_va_start_t, ast_expr_va_end_t, ast_expr_sizeof_value_t;
+    ast_expr_negate_t, ast_expr_delete_t, ast_expr_toggle_t, ast_expr_va_start_t, ast_expr_va_end_t, ast_expr_sizeof_value_t,
+    ast_expr_assume_t;
 
 // ---------------- ast_expr_unary_type_t ----------------
 // Generic expression that only operates on a type
@@ -158,11 +159,13 @@ typedef ast_expr_unary_type_t ast_expr_typeinfo_t;
 
 // ---------------- ast_expr_ternary_t ----------------
 // Expression for conditionally selecting between two expressions
+// NOTE: 'likely' is whether the condition is expected to be true (TROOLEAN_UNKNOWN if no hint)
 typedef struct {
     DERIVE_AST_EXPR;
     ast_expr_t *condition;
     ast_expr_t *if_true;
     ast_expr_t *if_false;
+    troolean likely;
 } ast_expr_ternary_t;
 
 // ---------------- ast_expr_call_t ----------------
@@ -345,6 +348,7 @@ typedef struct {
     ast_expr_t *value;
     trait_t traits;
     optional_ast_expr_list_t inputs;
+    length_t alignment; // Explicit 'align(N)' alignment, or zero for natural alignment
 } ast_expr_declare_t;
 
 // ---------------- ast_expr_inline_declare_t ----------------
@@ -368,25 +372,39 @@ typedef struct {
     ast_expr_list_t last_minute;
 } ast_expr_return_t;
 
+// ---------------- ast_expr_yield_t ----------------
+// Expression for yielding a value from a generator
+// NOTE: 'value' is NULL for generators that yield 'void'
+// NOTE: 'last_minute' is only run if the generator is destroyed while suspended here
+typedef struct {
+    DERIVE_AST_EXPR;
+    ast_expr_t *value;
+    ast_expr_list_t last_minute;
+} ast_expr_yield_t;
+
 // ---------------- ast_expr_conditional_t (and variants) ----------------
 // Expressions that conditionally execute code found in a single block
+// NOTE: 'likely' is whether the condition is expected to be true (TROOLEAN_UNKNOWN if no hint)
 typedef struct {
     DERIVE_AST_EXPR;
     maybe_null_weak_cstr_t label;
     ast_expr_t *value;
     ast_expr_list_t statements;
+    troolean likely;
 } ast_expr_conditional_t,
     // Aliases
     ast_expr_if_t, ast_expr_unless_t, ast_expr_while_t, ast_expr_until_t, ast_expr_whilecontinue_t, ast_expr_untilbreak_t;
 
 // ---------------- ast_expr_conditional_else_t (and friends) ----------------
 // Expressions that conditionally execute code found in a two blocks
+// NOTE: 'likely' is whether the condition is expected to be true (TROOLEAN_UNKNOWN if no hint)
 typedef struct {
     DERIVE_AST_EXPR;
     maybe_null_weak_cstr_t label;
     ast_expr_t *value;
     ast_expr_list_t statements;
     ast_expr_list_t else_statements;
+    troolean likely;
 } ast_expr_conditional_else_t,
     // Aliases
     ast_expr_ifelse_t, ast_expr_unlesselse_t, ast_expr_ifwhileelse_t, ast_expr_unlessuntilelse_t;
@@ -406,6 +424,27 @@ typedef struct {
     ast_expr_t *message;
 } ast_expr_assert_t;
 
+// ---------------- ast_reduction_t ----------------
+// A single reduction of a 'parallel reduce(...)' loop
+// NOTE: 'op' is one of EXPR_ADD, EXPR_BIT_AND, EXPR_BIT_OR, EXPR_BIT_XOR,
+// EXPR_LESSER (for 'min') or EXPR_GREATER (for 'max')
+typedef struct {
+    unsigned int op;
+    weak_cstr_t name;
+    source_t source;
+} ast_reduction_t;
+
+// ---------------- ast_parallel_t ----------------
+// Parallel modifier of an 'each in' or 'repeat' loop
+// Iterations of parallel loops are split across threads,
+// and each variable listed in 'reductions' gets a private
+// per-thread copy that is combined once the loop finishes
+typedef struct {
+    bool is_parallel;
+    ast_reduction_t *reductions;
+    length_t reductions_length;
+} ast_parallel_t;
+
 // ---------------- ast_expr_each_in_t ----------------
 // Expression for 'each in' loop. Used for iterating
 // over a low-level array given a length.
@@ -419,6 +458,7 @@ typedef struct {
     ast_expr_t *list;
     ast_expr_list_t statements;
     bool is_static;
+    ast_parallel_t parallel;
 } ast_expr_each_in_t;
 
 // ---------------- ast_expr_repeat_t ----------------
@@ -431,6 +471,7 @@ typedef struct {
     ast_expr_list_t statements;
     maybe_null_weak_cstr_t idx_name;
     bool is_static;
+    ast_parallel_t parallel;
 } ast_expr_repeat_t;
 
 // ---------------- ast_expr_break_t ----------------
@@ -455,10 +496,12 @@ typedef struct {
 
 // ---------------- ast_case_t ----------------
 //  A single 'case' of a 'switch' statement
+// NOTE: 'likely' is whether the case is expected to be taken (TROOLEAN_UNKNOWN if no hint)
 typedef struct {
     ast_expr_t *condition;
     ast_expr_list_t statements;
     source_t source;
+    troolean likely;
 } ast_case_t;
 
 typedef listof(ast_case_t, cases) ast_case_list_t;
@@ -496,6 +539,10 @@ typedef struct {
 // Expression for declaring a named expression
 typedef struct { DERIVE_AST_EXPR; ast_named_expression_t named_expression; } ast_expr_declare_named_expression_t;
 
+// ---------------- ast_likelihood_str ----------------
+// Gets the keyword prefix for a likelihood hint ("likely ", "unlikely " or "")
+const char *ast_likelihood_str(troolean likely);
+
 // ---------------- expr_is_mutable ----------------
 // Tests to see if the result of an expression will be mutable
 bool expr_is_mutable(ast_expr_t *expr);
@@ -607,7 +654,7 @@ ast_expr_t *ast_expr_create_generic_enum_value(weak_cstr_t kind, source_t source
 
 // ---------------- ast_expr_create_ternary ----------------
 // Creates a ternary expression
-ast_expr_t *ast_expr_create_ternary(ast_expr_t *condition, ast_expr_t *if_true, ast_expr_t *if_false, source_t source);
+ast_expr_t *ast_expr_create_ternary(ast_expr_t *condition, ast_expr_t *if_true, ast_expr_t *if_false, troolean likely, source_t source);
 
 // ---------------- ast_expr_create_cast ----------------
 // Creates a cast expression
@@ -676,7 +723,7 @@ ast_expr_t *ast_expr_create_va_copy(source_t source, ast_expr_t *dest_value, ast
 
 // ---------------- ast_expr_create_simple_conditional ----------------
 // Creates an simple conditional (if or unless) statement
-ast_expr_t *ast_expr_create_simple_conditional(source_t source, unsigned int conditional_type, maybe_null_weak_cstr_t label, ast_expr_t *condition, ast_expr_list_t statements);
+ast_expr_t *ast_expr_create_simple_conditional(source_t source, unsigned int conditional_type, maybe_null_weak_cstr_t label, ast_expr_t *condition, troolean likely, ast_expr_list_t statements);
 
 // ---------------- ast_expr_create_for ----------------
 // Creates a for-loop statement
@@ -711,6 +758,15 @@ ast_expr_t *ast_expr_create_declare_named_expression(source_t source, ast_named_
 // Creates an assert statement
 ast_expr_t *ast_expr_create_assert(source_t source, ast_expr_t *assertion);
 
+// ---------------- ast_expr_create_assume ----------------
+// Creates an assume statement
+ast_expr_t *ast_expr_create_assume(source_t source, ast_expr_t *assumption);
+
+// ---------------- ast_expr_create_yield ----------------
+// Creates a yield statement
+// NOTE: Ownership of 'value' and 'last_minute' will be taken
+ast_expr_t *ast_expr_create_yield(source_t source, ast_expr_t *value, ast_expr_list_t last_minute);
+
 // ---------------- ast_expr_list_create ----------------
 // Creates an ast_expr_list_t with a given capacity
 ast_expr_list_t ast_expr_list_create(length_t initial_capacity);
@@ -757,6 +813,14 @@ void ast_case_list_free(ast_case_list_t *list);
 // and returns a temporary pointer to it
 ast_case_t *ast_case_list_append(ast_case_list_t *list, ast_case_t ast_case);
 
+// ---------------- ast_parallel_clone ----------------
+// Deep-clones an 'ast_parallel_t'
+ast_parallel_t ast_parallel_clone(ast_parallel_t *original);
+
+// ---------------- ast_parallel_free ----------------
+// Frees an 'ast_parallel_t'
+void ast_parallel_free(ast_parallel_t *parallel);
+
 #ifdef __cplusplus
 }
 #endif
@@ -145,13 +145,15 @@ typedef enum {
 typedef struct ast_layout_bone {
     ast_layout_bone_kind_t kind;
     trait_t traits;
+    length_t alignment; // Explicit 'align(N)' alignment, or zero for natural alignment
     union {
         ast_type_t type;
         ast_layout_skeleton_t children;
     };
 } ast_layout_bone_t;
 
-#define AST_LAYOUT_BONE_PACKED TRAIT_1
+#define AST_LAYOUT_BONE_PACKED  TRAIT_1
+#define AST_LAYOUT_BONE_COMPACT TRAIT_2 // (fields are physically reordered to minimize padding)
 
 
 // ---------------- ast_layout_kind_t ----------------
@@ -165,12 +167,15 @@ typedef struct ast_layout {
     ast_field_map_t field_map;
     ast_layout_skeleton_t skeleton;
     trait_t traits;
+    length_t alignment; // Explicit 'align(N)' alignment, or zero for natural alignment
 } ast_layout_t;
 
-#define AST_LAYOUT_PACKED TRAIT_1
+#define AST_LAYOUT_PACKED         TRAIT_1
+#define AST_LAYOUT_COMPACT        TRAIT_2 // (fields are physically reordered to minimize padding)
+#define AST_LAYOUT_COMPACT_FORCED TRAIT_3 // (allow 'compact' even when used by foreign functions)
 
 // ---------------- ast_layout_init ----------------
-// Constructs an 'ast_layout_t'
+// Constructs an 'ast_layout_t' with natural alignment
 void ast_layout_init(ast_layout_t *layout, ast_layout_kind_t kind, ast_field_map_t field_map, ast_layout_skeleton_t skeleton, trait_t traits);
 
 // ---------------- ast_layout_init_with_struct_fields ----------------
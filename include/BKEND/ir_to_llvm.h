@@ -82,6 +82,19 @@ typedef struct {
     LLVMValueRef deinit_function;
 } llvm_static_variable_info_t;
 
+// ---------------- llvm_coroutine_t ----------------
+// State for lowering the generator currently being exported
+// (when 'handle' is NULL, the current function isn't a generator)
+typedef struct {
+    LLVMValueRef id;
+    LLVMValueRef handle;
+    LLVMValueRef promise;
+    LLVMValueRef destroying;
+    LLVMBasicBlockRef final_block;
+    LLVMBasicBlockRef cleanup_block;
+    LLVMBasicBlockRef suspend_block;
+} llvm_coroutine_t;
+
 // ---------------- llvm_context_t ----------------
 // A general container for the LLVM exporting context
 typedef struct {
@@ -106,6 +119,7 @@ typedef struct {
 
     llvm_static_variables_t static_variables;
     llvm_static_variable_info_t static_variable_info;
+    llvm_coroutine_t coroutine;
 
     LLVMTypeRef i64_type;
     LLVMTypeRef f64_type;
@@ -115,6 +129,21 @@ typedef struct {
 // Converts an IR type to an LLVM type
 LLVMTypeRef ir_to_llvm_type(llvm_context_t *llvm, ir_type_t *ir_type);
 
+// ---------------- ir_to_llvm_alignment_of ----------------
+// Gets the alignment of an IR type, including any explicit 'align(N)' alignment
+// (LLVM types don't know about explicit alignment, since they are laid out manually)
+length_t ir_to_llvm_alignment_of(llvm_context_t *llvm, ir_type_t *ir_type);
+
+// ---------------- ir_to_llvm_member_index ----------------
+// Gets the LLVM field index for a field of an IR structure type
+// (Differs from the IR field index when padding fields are required)
+unsigned int ir_to_llvm_member_index(llvm_context_t *llvm, ir_type_t *ir_type, length_t index);
+
+// ---------------- ir_to_llvm_set_alignment ----------------
+// Raises the alignment of an LLVM global variable or alloca to satisfy
+// the alignment of its IR type and 'explicit_alignment' (zero for none)
+void ir_to_llvm_set_alignment(llvm_context_t *llvm, LLVMValueRef value, ir_type_t *ir_type, length_t explicit_alignment);
+
 // ---------------- ir_to_llvm_value ----------------
 // Converts an IR value to an LLVM value
 LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value);
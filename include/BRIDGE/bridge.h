@@ -29,6 +29,8 @@ extern "C" {
 #define BRIDGE_VAR_REFERENCE    TRAIT_2 // Variable is to be treated as a mutable reference
 #define BRIDGE_VAR_POD          TRAIT_3 // Variable is to be treated as plain old data
 #define BRIDGE_VAR_STATIC       TRAIT_4 // Variable is to static (global-like)
+#define BRIDGE_VAR_COROUTINE    TRAIT_5 // Variable holds a generator handle that is to be destroyed when it goes out of scope
+#define BRIDGE_VAR_SOA_ELEMENT  TRAIT_6 // Variable holds the index of an element within a structure-of-arrays container
 
 typedef struct {
     weak_cstr_t name;
@@ -38,10 +40,13 @@ typedef struct {
     index_id_t static_id;    // ID of the variable as a static variable (only applies to static variables)
     trait_t traits;
     source_t source;
+    length_t alignment;      // Explicit 'align(N)' alignment, or zero for natural alignment
 
     #ifndef ADEPT_INSIGHT_BUILD
     ir_type_t *ir_type;
     ir_value_t *optional_anon_global;
+    ir_value_t *soa_container; // Pointer to the container indexed by a BRIDGE_VAR_SOA_ELEMENT variable
+    weak_cstr_t soa_name;      // Name of the container indexed by a BRIDGE_VAR_SOA_ELEMENT variable
     #endif
 } bridge_var_t;
 
@@ -17,6 +17,7 @@ enum {
     DEBUG_SIGNAL_AT_INFER_DUMP,         // data = ast_t*
     DEBUG_SIGNAL_AT_ASSEMBLY,           // data = NULL
     DEBUG_SIGNAL_AT_IR_MODULE_DUMP,     // data = ir_module_t*
+    DEBUG_SIGNAL_AT_IR_MODULE_STATS,    // data = ir_module_t*
     DEBUG_SIGNAL_AT_EXPORT,             // data = NULL
     DEBUG_SIGNAL_AT_OUT,                // data = NULL
     DEBUG_SIGNAL_AT_LINKING,            // data = NULL
@@ -22,6 +22,7 @@ extern "C" {
 #include "DRVR/object.h"
 #include "UTIL/ground.h"
 #include "UTIL/index_id_list.h"
+#include "UTIL/list.h"
 #include "UTIL/string_builder.h"
 #include "UTIL/string_list.h"
 #include "UTIL/trait.h"
@@ -47,6 +48,9 @@ extern "C" {
 #define COMPILER_TYPE_COLON               TRAIT_2_3
 #define COMPILER_WINDOWED                 TRAIT_2_4
 #define COMPILER_OUTPUT_DYNAMIC_LIBRARY   TRAIT_2_5
+#define COMPILER_LAZY                     TRAIT_2_6
+#define COMPILER_STRIP_TYPEINFO           TRAIT_2_7
+#define COMPILER_REORDER_FIELDS           TRAIT_2_8
 
 // Possible compiler trait checks
 #define COMPILER_NULL_CHECKS      TRAIT_1
@@ -75,6 +79,7 @@ extern "C" {
 #define COMPILER_DEBUG_LLVMIR          TRAIT_3
 #define COMPILER_DEBUG_NO_VERIFICATION TRAIT_4
 #define COMPILER_DEBUG_NO_RESULT       TRAIT_5
+#define COMPILER_DEBUG_STATS           TRAIT_6
 
 // Possible compiler result flags (for internal use)
 #define COMPILER_RESULT_NONE                    TRAIT_NONE
@@ -87,6 +92,26 @@ typedef struct {
     source_t source;
 } adept_error_t, adept_warning_t;
 
+// Possible kinds of captured diagnostics
+#define COMPILER_DIAGNOSTIC_PANIC  0x00 // From 'compiler_panic'
+#define COMPILER_DIAGNOSTIC_PANICF 0x01 // From 'compiler_panicf' or 'compiler_vpanicf'
+#define COMPILER_DIAGNOSTIC_WARN   0x02 // From 'compiler_warn'
+#define COMPILER_DIAGNOSTIC_WARNF  0x03 // From 'compiler_warnf' or 'compiler_vwarnf'
+#define COMPILER_DIAGNOSTIC_HINT   0x04 // From 'compiler_hintf'
+
+// ---------------- compiler_diagnostic_t ----------------
+// Diagnostic that was captured instead of being reported right away
+typedef struct {
+    unsigned int kind;
+    source_t source;
+    maybe_null_strong_cstr_t message;
+} compiler_diagnostic_t;
+
+// ---------------- compiler_diagnostics_t ----------------
+// List of captured diagnostics, in the order they were raised
+typedef listof(compiler_diagnostic_t, diagnostics) compiler_diagnostics_t;
+#define compiler_diagnostics_append(LIST, VALUE) list_append((LIST), (VALUE), compiler_diagnostic_t)
+
 // ---------------- compiler_t ----------------
 // Structure that encapsulates the compiler
 typedef struct compiler {
@@ -108,8 +133,10 @@ typedef struct compiler {
     trait_t result_flags;      // Results flag (for internal use)
     trait_t checks;
     trait_t ignore;
+    trait_t ir_passes;         // IR_PASS_* passes to run before exporting
     troolean use_pic;          // Generate using PIC relocation model
     bool use_libm;             // Link to libm using '-lm'
+    bool use_libpthread;       // Link to libpthread using '-lpthread'
     bool extract_import_order;   // Parse file to extract order of all imported files
     trait_t debug_traits;      // COMPILER_DEBUG_* options
 
@@ -124,6 +151,10 @@ typedef struct compiler {
 
     bool show_unused_variables_how_to_disable;
     unsigned int cross_compile_for;
+
+    // When not NULL, diagnostics are captured into this list instead of
+    // being printed and recorded, see 'compiler_diagnostics_replay'
+    compiler_diagnostics_t *capture;
     
     weak_cstr_t entry_point;
     string_builder_t user_linker_options;
@@ -245,6 +276,18 @@ bool compiler_warn(compiler_t *compiler, source_t source, const char *message);
 bool compiler_warnf(compiler_t *compiler, source_t source, const char *format, ...);
 void compiler_vwarnf(compiler_t *compiler, source_t source, const char *format, va_list args);
 
+// ---------------- compiler_hintf ----------------
+// Prints additional information that follows a compiler error or warning
+void compiler_hintf(compiler_t *compiler, const char *format, ...);
+
+// ---------------- compiler_diagnostics_replay ----------------
+// Reports captured diagnostics as if they were raised now, and then frees them
+void compiler_diagnostics_replay(compiler_t *compiler, compiler_diagnostics_t *diagnostics);
+
+// ---------------- compiler_diagnostics_free ----------------
+// Frees captured diagnostics without reporting them
+void compiler_diagnostics_free(compiler_diagnostics_t *diagnostics);
+
 // ---------------- compiler_weak_panic (and friends) ----------------
 #ifdef ADEPT_INSIGHT_BUILD
 #define compiler_weak_panic(...)  compiler_warn(__VA_ARGS__)
@@ -272,7 +315,7 @@ func_id_list_t compiler_possibilities(compiler_t *compiler, object_t *object, we
 
 // ---------------- print_candidate ----------------
 // Prints a function/method candidate
-void print_candidate(ast_func_t *ast_func);
+void print_candidate(compiler_t *compiler, ast_func_t *ast_func);
 
 // ---------------- make_args_string ----------------
 // Helper function for generating a string for function arguments
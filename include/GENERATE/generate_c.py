@@ -130,15 +130,19 @@ tokens = [
     Token("polycount"             , TokenType.LITERAL      , ExtraDataFormat.C_STRING   , None                                ),
     Token("POD"                   , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "POD keyword"                       ),
     Token("alias"                 , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "alias keyword"                     ),
+    Token("align"                 , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "align keyword"                     ),
     Token("alignof"               , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "alignof keyword"                   ),
     Token("and"                   , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "and keyword"                       ),
     Token("as"                    , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "as keyword"                        ),
     Token("assert"                , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "assert keyword"                    ),
+    Token("assume"                , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "assume keyword"                    ),
     Token("at"                    , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "at keyword"                        ),
     Token("break"                 , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "break keyword"                     ),
     Token("case"                  , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "case keyword"                      ),
     Token("cast"                  , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "cast keyword"                      ),
     Token("class"                 , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "class keyword"                     ),
+    Token("cold"                  , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "cold keyword"                      ),
+    Token("compact"               , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "compact keyword"                   ),
     Token("const"                 , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "const keyword"                     ),
     Token("constructor"           , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "constructor keyword"               ),
     Token("continue"              , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "continue keyword"                  ),
@@ -156,24 +160,32 @@ tokens = [
     Token("external"              , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "external keyword"                  ),
     Token("fallthrough"           , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "fallthrough keyword"               ),
     Token("false"                 , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "false keyword"                     ),
+    Token("flatten"               , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "flatten keyword"                   ),
     Token("for"                   , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "for keyword"                       ),
     Token("foreign"               , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "foreign keyword"                   ),
     Token("func"                  , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "func keyword"                      ),
+    Token("generator"             , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "generator keyword"                 ),
     Token("funcptr"               , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "funcptr keyword"                   ),
     Token("global"                , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "global keyword"                    ),
+    Token("hot"                   , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "hot keyword"                       ),
     Token("if"                    , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "if keyword"                        ),
     Token("implicit"              , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "implicit keyword"                  ),
     Token("import"                , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "import keyword"                    ),
     Token("in"                    , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "in keyword"                        ),
+    Token("inline"                , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "inline keyword"                    ),
     Token("inout"                 , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "inout keyword"                     ),
+    Token("likely"                , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "likely keyword"                    ),
     Token("llvm_asm"              , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "llvm_asm keyword"                  ),
     Token("namespace"             , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "namespace keyword"                 ),
     Token("new"                   , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "new keyword"                       ),
+    Token("noinline"              , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "noinline keyword"                  ),
     Token("null"                  , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "null keyword"                      ),
+    Token("optimize"              , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "optimize keyword"                  ),
     Token("or"                    , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "or keyword"                        ),
     Token("out"                   , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "out keyword"                       ),
     Token("override"              , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "override keyword"                  ),
     Token("packed"                , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "packed keyword"                    ),
+    Token("parallel"              , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "parallel keyword"                  ),
     Token("pragma"                , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "pragma keyword"                    ),
     Token("private"               , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "private keyword"                   ),
     Token("public"                , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "public keyword"                    ),
@@ -181,6 +193,7 @@ tokens = [
     Token("repeat"                , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "repeat keyword"                    ),
     Token("return"                , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "return keyword"                    ),
     Token("sizeof"                , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "sizeof keyword"                    ),
+    Token("soa"                   , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "soa keyword"                       ),
     Token("static"                , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "static keyword"                    ),
     Token("stdcall"               , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "stdcall keyword"                   ),
     Token("struct"                , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "struct keyword"                    ),
@@ -191,6 +204,7 @@ tokens = [
     Token("typenameof"            , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "typenameof keyword"                ),
     Token("undef"                 , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "undef keyword"                     ),
     Token("union"                 , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "union keyword"                     ),
+    Token("unlikely"              , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "unlikely keyword"                  ),
     Token("unless"                , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "unless keyword"                    ),
     Token("until"                 , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "until keyword"                     ),
     Token("using"                 , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "using keyword"                     ),
@@ -200,7 +214,8 @@ tokens = [
     Token("va_start"              , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "va_start keyword"                  ),
     Token("verbatim"              , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "verbatim keyword"                  ),
     Token("virtual"               , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "virtual keyword"                   ),
-    Token("while"                 , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "while keyword"                     )
+    Token("while"                 , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "while keyword"                     ),
+    Token("yield"                 , TokenType.KEYWORD      , ExtraDataFormat.ID_ONLY    , "yield keyword"                     )
 ]
 
 # Calculate longest 'short name' of tokens
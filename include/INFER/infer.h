@@ -78,6 +78,11 @@ errorcode_t infer_layout_skeleton(infer_ctx_t *ctx, ast_layout_skeleton_t *skele
 // Infers type aliases in a list of composites
 errorcode_t infer_in_composites(infer_ctx_t *ctx, ast_composite_t *composites, length_t composites_length);
 
+// ---------------- infer_in_soas ----------------
+// Infers the types of SoA containers, and synthesizes a composite
+// for each of them that has one fixed array column per element field
+errorcode_t infer_in_soas(infer_ctx_t *ctx, ast_soa_t *soas, length_t soas_length);
+
 // ---------------- infer_in_poly_composites ----------------
 // Infers type aliases in a list of poly composites
 errorcode_t infer_in_poly_composites(infer_ctx_t *ctx, ast_poly_composite_t *poly_composites, length_t poly_composites_length);
@@ -88,7 +93,13 @@ errorcode_t infer_in_globals(infer_ctx_t *ctx, ast_global_t *globals, length_t g
 
 // ---------------- infer_in_funcs ----------------
 // Infers type/value aliases and generics in a list of functions
-errorcode_t infer_in_funcs(infer_ctx_t *ctx, ast_func_t *funcs, length_t funcs_length);
+// Large lists are inferred on multiple threads, with diagnostics reported in order
+errorcode_t infer_in_funcs(infer_ctx_t *ctx, ast_funcs_t *funcs);
+
+// ---------------- infer_func_body_on_demand ----------------
+// Infers the body of a function whose inference was deferred,
+// does nothing if the function body is already inferred
+errorcode_t infer_func_body_on_demand(compiler_t *compiler, object_t *object, func_id_t ast_func_id);
 
 // ---------------- infer_in_func_aliases ----------------
 // Infers type/value aliases in a list of function aliases
@@ -98,6 +109,11 @@ errorcode_t infer_in_func_aliases(infer_ctx_t *ctx, ast_func_alias_t *func_alias
 // Infers aliases and generics in a list of statements
 errorcode_t infer_in_stmts(infer_ctx_t *ctx, ast_func_t *func, ast_expr_list_t *statements);
 
+// ---------------- infer_in_parallel ----------------
+// Infers the reductions of a parallel loop
+// Reduced local variables are marked as used, and must be mutable
+errorcode_t infer_in_parallel(infer_ctx_t *ctx, ast_parallel_t *parallel);
+
 // ---------------- infer_expr ----------------
 // Infers an expression from the root of it
 errorcode_t infer_expr(infer_ctx_t *ctx, ast_func_t *ast_func, ast_expr_t **root, unsigned int default_assigned_type, bool must_be_mutable);
@@ -23,6 +23,7 @@ extern "C" {
 #include "IR/ir_type.h"
 #include "IR/ir_value.h"
 #include "IRGEN/ir_cache.h"
+#include "UTIL/chunked_list.h"
 #include "UTIL/datatypes.h"
 #include "UTIL/ground.h"
 #include "UTIL/list.h"
@@ -119,10 +120,55 @@ enum ir_instr_id {
     INSTRUCTION_ASM,             // ir_instr_asm_t
     INSTRUCTION_DEINIT_SVARS,    // ir_instr_t
     INSTRUCTION_UNREACHABLE,     // ir_instr_t
+    INSTRUCTION_VECTOR_SPLAT,    // ir_instr_cast_t
+    INSTRUCTION_VECTOR_SHUFFLE,  // ir_instr_shuffle_t
+    INSTRUCTION_VECTOR_REDUCE,   // ir_instr_vector_reduce_t
+    INSTRUCTION_INTRINSIC,       // ir_instr_intrinsic_t
+    INSTRUCTION_ATOMIC_LOAD,     // ir_instr_atomic_t
+    INSTRUCTION_ATOMIC_STORE,    // ir_instr_atomic_t
+    INSTRUCTION_ATOMIC_RMW,      // ir_instr_atomic_t
+    INSTRUCTION_ATOMIC_CMPXCHG,  // ir_instr_atomic_t
+    INSTRUCTION_FENCE,           // ir_instr_atomic_t
+    INSTRUCTION_PARALLEL_FOR,    // ir_instr_parallel_for_t
+    INSTRUCTION_COROUTINE_SUSPEND, // ir_instr_unary_t
+    INSTRUCTION_COROUTINE_RESUME,  // ir_instr_unary_t
+    INSTRUCTION_COROUTINE_DESTROY, // ir_instr_unary_t
+    INSTRUCTION_COROUTINE_DONE,    // ir_instr_unary_t
+    INSTRUCTION_COROUTINE_VALUE,   // ir_instr_unary_t
 };
 
 typedef enum ir_instr_id ir_instr_id_t;
 
+// =============================================================
+// ---------------- Possible IR intrinsic IDs ------------------
+// =============================================================
+enum ir_intrinsic_id {
+    IR_INTRINSIC_ASSUME,   // Hints that a boolean condition always holds
+    IR_INTRINSIC_BSWAP,    // Reverses the bytes of an integer
+    IR_INTRINSIC_CTLZ,     // Counts leading zero bits (defined for zero)
+    IR_INTRINSIC_CTPOP,    // Counts set bits
+    IR_INTRINSIC_CTTZ,     // Counts trailing zero bits (defined for zero)
+    IR_INTRINSIC_EXPECT,   // Hints that a value is likely to equal another value
+    IR_INTRINSIC_FMA,      // Fused multiply-add
+    IR_INTRINSIC_FSHL,     // Funnel shift left
+    IR_INTRINSIC_FSHR,     // Funnel shift right
+    IR_INTRINSIC_PREFETCH, // Hints that memory will soon be accessed
+    IR_INTRINSIC_SQRT,     // Square root
+};
+
+// =============================================================
+// --------------- Possible IR atomic orderings ----------------
+// =============================================================
+// NOTE: Values match those of the C11 'memory_order' enumeration
+enum ir_atomic_ordering {
+    IR_ATOMIC_RELAXED,
+    IR_ATOMIC_CONSUME,
+    IR_ATOMIC_ACQUIRE,
+    IR_ATOMIC_RELEASE,
+    IR_ATOMIC_ACQ_REL,
+    IR_ATOMIC_SEQ_CST,
+};
+
 // ---------------- ir_instr_t ----------------
 // General structure for intermediate
 // representation instructions
@@ -144,7 +190,9 @@ typedef struct {
 // ---------------- ir_instr_unary_t ----------------
 // General structure for an IR instruction that
 // takes two operands
-// (Used for: bit complement, negate, fnegate, iszero, isntzero)
+// (Used for: bit complement, negate, fnegate, iszero, isntzero, coroutine operations)
+// NOTE: For coroutine suspend, 'value' points to the value being yielded (or is a null 'ptr'),
+// and the result is whether the coroutine is being destroyed instead of resumed
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
@@ -255,12 +303,14 @@ typedef struct {
 // ---------------- ir_instr_cond_break_t ----------------
 // An IR instruction for conditionally breaking/branching
 // to other basic blocks
+// NOTE: 'likely' is whether 'value' is expected to be true (TROOLEAN_UNKNOWN if no hint was given)
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
     ir_value_t *value;
     length_t true_block_id;
     length_t false_block_id;
+    troolean likely;
 } ir_instr_cond_break_t;
 
 // ---------------- ir_instr_member_t ----------------
@@ -362,12 +412,14 @@ typedef struct {
 // ---------------- ir_instr_switch_t ----------------
 // IR instruction for general switch statement
 // NOTE: Default case exists if (default_block_id != resume_block_id)
+// NOTE: 'case_likely' is NULL when none of the cases were given a likelihood hint
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
     ir_value_t *condition;
     ir_value_t **case_values;
     length_t *case_block_ids;
+    troolean *case_likely;
     length_t cases_length;
     length_t default_block_id;
     length_t resume_block_id;
@@ -396,8 +448,86 @@ typedef struct {
     bool is_stack_align;
 } ir_instr_asm_t;
 
+// ---------------- ir_instr_shuffle_t ----------------
+// An IR instruction for rearranging the lanes of two vectors
+// Each entry of 'mask' selects a lane from the concatenation of 'a' and 'b'
+typedef struct {
+    unsigned int id;
+    ir_type_t *result_type;
+    ir_value_t *a;
+    ir_value_t *b;
+    length_t *mask;
+    length_t mask_length;
+} ir_instr_shuffle_t;
+
+// ---------------- ir_instr_vector_reduce_t ----------------
+// An IR instruction for horizontally combining the lanes of a vector
+// 'operation' is the id of the math instruction used to combine lanes,
+// where the comparison instructions stand in for minimum and maximum
+// (e.g. INSTRUCTION_FADD, INSTRUCTION_BIT_XOR, INSTRUCTION_SLESSER)
+typedef struct {
+    unsigned int id;
+    ir_type_t *result_type;
+    ir_value_t *value;
+    unsigned int operation;
+} ir_instr_vector_reduce_t;
+
+// ---------------- ir_instr_intrinsic_t ----------------
+// An IR instruction for performing a builtin operation
+// that has no equivalent IR instruction (e.g. IR_INTRINSIC_CTPOP)
+// Intrinsics are overloaded on the type of their first value
+typedef struct {
+    unsigned int id;
+    ir_type_t *result_type;
+    unsigned int intrinsic;
+    ir_value_t **values;
+    length_t values_length;
+} ir_instr_intrinsic_t;
+
+// ---------------- ir_instr_atomic_t ----------------
+// An IR instruction for atomically accessing memory, or for
+// ordering the memory accesses of different threads
+//     atomic load    - Reads from 'pointer'
+//     atomic store   - Writes 'value' to 'pointer'
+//     atomic rmw     - Combines 'value' with the contents of 'pointer' and gives back the old contents,
+//                      'operation' is the id of the math instruction used to combine them
+//                      (like 'ir_instr_vector_reduce_t'), or INSTRUCTION_STORE for exchanging
+//     atomic cmpxchg - Writes 'value' to 'pointer' if it contains 'expected' and gives back the old contents,
+//                      'failure_ordering' is used when nothing is written
+//     fence          - Only has an 'ordering'
+// 'ordering' is the ir_atomic_ordering of the operation
+typedef struct {
+    unsigned int id;
+    ir_type_t *result_type;
+    ir_value_t *pointer;
+    ir_value_t *value;
+    ir_value_t *expected;
+    unsigned int operation;
+    unsigned int ordering;
+    unsigned int failure_ordering;
+} ir_instr_atomic_t;
+
+// ---------------- ir_instr_parallel_for_t ----------------
+// An IR instruction for running the iterations [0, count) of a loop
+// across multiple threads, and waiting for them to finish
+// 'body' is the address of a function with the arguments (env, begin, end)
+// that runs the iterations [begin, end), and 'env' is passed to it unchanged
+typedef struct {
+    unsigned int id;
+    ir_type_t *result_type;
+    ir_value_t *body;
+    ir_value_t *env;
+    ir_value_t *count;
+} ir_instr_parallel_for_t;
+
 // ---------------- ir_instrs_t ----------------
 // List of instructions
+// NOTE: Instructions are referenced by pointer rather than stored inline by value,
+// since vtable initializations ('ir_vtable_init_t.store_instr') and the in-place
+// rewrites done by passes rely on instruction addresses staying stable.
+// Locality instead comes from each function allocating its instructions out of
+// its own 'instructions_pool', from instruction results being inline 32-bit
+// block/instruction indices ('ir_value_result_t'), and from literals being interned
 typedef listof(ir_instr_t*, instructions) ir_instrs_t;
 #define ir_instrs_create(CAPACITY) list_create(ir_instrs_t, ir_instr_t*, (CAPACITY))
 #define ir_instrs_append(LIST, VALUE) list_append((LIST), (VALUE), ir_instr_t*)
@@ -411,8 +541,17 @@ typedef struct {
 } ir_basicblock_t;
 
 // ---------------- ir_basicblocks_t ----------------
-// A list of basicblocks
-typedef listof(ir_basicblock_t, blocks) ir_basicblocks_t;
+// A list of basicblocks, along with the storage for their instructions
+// NOTE: The instructions of a function are allocated contiguously out of 'instructions_pool'
+// instead of being interleaved with the values and types of the module pool,
+// so walking the instructions of a function touches as little memory as possible
+// NOTE: 'instructions_pool' is NULL if the instructions were allocated out of the module pool
+typedef struct {
+    ir_basicblock_t *blocks;
+    length_t length;
+    length_t capacity;
+    ir_pool_t *instructions_pool;
+} ir_basicblocks_t;
 #define ir_basicblocks_append(LIST, VALUE) list_append((LIST), (VALUE), ir_basicblock_t)
 void ir_basicblocks_free(ir_basicblocks_t *basicblocks);
 
@@ -443,10 +582,13 @@ typedef listof(ir_vtable_init_t, initializations) ir_vtable_init_list_t;
 void ir_vtable_init_list_free(ir_vtable_init_list_t *vtable_init_list);
 
 // ---------------- ir_vtable_dispatch_t ----------------
-// Used to keep track of where vtable index injection will be required
+// Used to keep track of where vtable index injection will be required,
+// and of which call to redirect if the dispatch turns out to only have a single possible target
 typedef struct {
     func_id_t ast_func_id;
+    func_id_t ir_func_id;
     ir_value_t *index_value;
+    ir_instr_call_address_t *call_instr;
 } ir_vtable_dispatch_t;
 
 // ---------------- ir_vtable_dispatch_list_t ----------------
@@ -472,11 +614,13 @@ typedef struct {
     trait_t traits;
     ir_type_t *return_type;
     ir_type_t **argument_types;
+    trait_t *maybe_argument_traits;
     length_t arity;
     ir_basicblocks_t basicblocks;
     bridge_scope_t *scope;
     length_t variable_count;
     weak_cstr_t export_as;
+    func_id_t ast_func_id;
 } ir_func_t;
 
 // Possible traits for ir_func_t
@@ -488,6 +632,27 @@ typedef struct {
 #define IR_FUNC_VALIDATE_VTABLE TRAIT_6
 #define IR_FUNC_INIT            TRAIT_7
 #define IR_FUNC_DEINIT          TRAIT_8
+#define IR_FUNC_UNREFERENCED    TRAIT_9 // Not (yet) reachable, only exists when compiling lazily
+#define IR_FUNC_DEVIRTUALIZED   TRAIT_A // Virtual dispatcher that always calls the same implementation
+#define IR_FUNC_ADDRESS_TAKEN   TRAIT_B // Function address escapes, so it must keep the C calling convention
+#define IR_FUNC_READNONE        TRAIT_C // Never touches memory visible to the caller (inferred)
+#define IR_FUNC_READONLY        TRAIT_D // Never writes to memory visible to the caller (inferred)
+#define IR_FUNC_WILLRETURN      TRAIT_E // Always returns to the caller (inferred)
+#define IR_FUNC_NOALIAS_RETURN  TRAIT_F // Always returns a pointer to freshly allocated memory (inferred)
+#define IR_FUNC_ADDRESS_EXPOSED TRAIT_G // Function address is visible to user code, so it must stay unique
+#define IR_FUNC_ALWAYS_INLINE   TRAIT_2_1 // Always inlined into callers
+#define IR_FUNC_NO_INLINE       TRAIT_2_2 // Never inlined into callers
+#define IR_FUNC_HOT             TRAIT_2_3 // Frequently executed
+#define IR_FUNC_COLD            TRAIT_2_4 // Rarely executed
+#define IR_FUNC_FLATTEN         TRAIT_2_5 // Every call made from the function is inlined when possible
+#define IR_FUNC_OPTIMIZE_NONE   TRAIT_2_6 // Left unoptimized regardless of the optimization level
+#define IR_FUNC_OPTIMIZE_SIZE   TRAIT_2_7 // Optimized for size
+#define IR_FUNC_OPTIMIZE_AGGRESSIVE TRAIT_2_8 // Optimized aggressively regardless of the optimization level
+#define IR_FUNC_COROUTINE       TRAIT_2_9 // Generator that returns a handle to itself, and suspends at each yield
+
+// Possible traits for ir_func_t arguments
+#define IR_FUNC_ARG_NONNULL          TRAIT_1 // Pointer argument is always dereferenced (inferred)
+#define IR_FUNC_ARG_DEREFERENCEABLE  TRAIT_2 // Entire pointee of pointer argument is always accessed (inferred)
 
 // ---------------- ir_job_list_t ----------------
 // List of jobs required during IR generation
@@ -499,9 +664,11 @@ typedef struct {
     weak_cstr_t name;
     ir_type_t *type;
     trait_t traits;
+    length_t alignment; // Explicit 'align(N)' alignment, or zero for natural alignment
 
-    // Non-user static value initializer
-    // (Used for __types__ and __types_length__)
+    // Static value initializer (nullable)
+    // (Used for __types__ and __types_length__, and for
+    // user initial values that are known at compile-time)
     ir_value_t *trusted_static_initializer;
 } ir_global_t;
 
@@ -554,6 +721,7 @@ typedef struct {
 // A static variable in an IR module
 typedef struct {
     ir_type_t *type;
+    length_t alignment; // Explicit 'align(N)' alignment, or zero for natural alignment
 } ir_static_variable_t;
 
 // ---------------- ir_static_variables_t ----------------
@@ -581,8 +749,10 @@ typedef listof(ir_anon_global_t, globals) ir_anon_globals_t;
 
 // ---------------- ir_funcs_t ----------------
 // List of functions
-typedef listof(ir_func_t, funcs) ir_funcs_t;
-#define ir_funcs_append(LIST, VALUE) list_append((LIST), (VALUE), ir_func_t)
+// NOTE: Functions never move once created, so pointers to them stay valid
+typedef chunkedof(ir_func_t) ir_funcs_t;
+#define ir_funcs_append(LIST, VALUE) chunked_list_append((LIST), (VALUE), ir_func_t)
+#define ir_funcs_at(LIST, INDEX) chunked_list_at((LIST), (INDEX))
 
 // ---------------- ir_basicblock_free ----------------
 // Frees an IR basicblock
@@ -590,13 +760,31 @@ void ir_basicblock_free(ir_basicblock_t *basicblock);
 
 // ---------------- ir_funcs_free ----------------
 // Frees a list of IR functions
-void ir_funcs_free(ir_funcs_t funcs);
+void ir_funcs_free(ir_funcs_t *funcs);
 
 // ---------------- ir_implementation ----------------
 // Encodes an ID for an implementation name
 // NOTE: output_buffer is assumed to be able to hold 32 characters
 void ir_implementation(length_t id, char prefix, char *output_buffer);
 
+// ---------------- ir_vector_reduce_operation_name ----------------
+// Gets the name of the operation performed by a vector reduction
+// (e.g. "fadd" or "smin"), or NULL if the operation isn't supported
+const char *ir_vector_reduce_operation_name(unsigned int operation);
+
+// ---------------- ir_intrinsic_name ----------------
+// Gets the name of an intrinsic (e.g. "ctpop")
+const char *ir_intrinsic_name(unsigned int intrinsic);
+
+// ---------------- ir_atomic_rmw_operation_name ----------------
+// Gets the name of the operation performed by an atomic read-modify-write
+// (e.g. "xchg" or "umax"), or NULL if the operation isn't supported
+const char *ir_atomic_rmw_operation_name(unsigned int operation);
+
+// ---------------- ir_atomic_ordering_name ----------------
+// Gets the name of an atomic ordering (e.g. "acquire")
+const char *ir_atomic_ordering_name(unsigned int ordering);
+
 // ---------------- ir_value_uniqueness_value ----------------
 // Maps a literal IR value to a uniqueness value.
 // If two IR values of the same IR type have the same uniqueness value, then
@@ -605,6 +793,11 @@ void ir_implementation(length_t id, char prefix, char *output_buffer);
 // they do not share the same literal value.
 unsigned long long ir_value_uniqueness_value(ir_pool_t *pool, ir_value_t **value);
 
+// ---------------- ir_value_is_static_initializer ----------------
+// Returns whether an IR value (including everything it's made of)
+// is known at link-time, and so can be the initial value of a global variable
+bool ir_value_is_static_initializer(ir_value_t *value);
+
 // ---------------- ir_print_value ----------------
 // Prints a value to stdout
 void ir_print_value(ir_value_t *value);
@@ -0,0 +1,57 @@
+
+#ifndef _ISAAC_IR_CONST_POOL_H
+#define _ISAAC_IR_CONST_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================= ir_const_pool.h =============================
+    Module for creating IR literal values, and interning immutable ones
+    ---------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+
+#include "IR/ir_pool.h"
+#include "IR/ir_value.h"
+#include "UTIL/ground.h"
+
+// ---------------- ir_const_pool_t ----------------
+// Open-addressed table of interned scalar literal values.
+// Values are allocated out of the table's own 'storage' pool,
+// so rolling back an 'ir_pool_t' snapshot never invalidates them
+typedef struct ir_const_pool {
+    ir_pool_t storage;
+    ir_value_t **values;
+    length_t length;
+    length_t capacity;
+} ir_const_pool_t;
+
+// ---------------- ir_const_pool_free ----------------
+// Frees a constant pool and all of its interned values
+void ir_const_pool_free(ir_const_pool_t *const_pool);
+
+// ---------------- ir_const_pool_literal ----------------
+// Returns the shared literal value of type kind 'kind' holding 'data'.
+// Only scalar kinds (integers, floats and booleans) can be interned.
+// NOTE: The result is shared and must never be modified in place
+ir_value_t *ir_const_pool_literal(ir_pool_t *pool, unsigned int kind, const void *data);
+
+// ---------------- ir_literal_make ----------------
+// Creates a private literal value of type 'type' holding a copy of 'size' bytes of 'data'
+// The bytes are stored inline directly after the value within the same allocation,
+// so reading a literal never has to follow 'extra' into separate memory
+// NOTE: Unlike interned literals, the result may be modified in place
+ir_value_t *ir_literal_make(ir_pool_t *pool, ir_type_t *type, const void *data, length_t size);
+
+// ---------------- ir_const_pool_kind_is_internable ----------------
+// Returns whether literals of a type kind can be interned
+bool ir_const_pool_kind_is_internable(unsigned int kind);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_IR_CONST_POOL_H
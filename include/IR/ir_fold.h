@@ -0,0 +1,41 @@
+
+#ifndef _ISAAC_IR_FOLD_H
+#define _ISAAC_IR_FOLD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ================================ ir_fold.h ================================
+    Module for evaluating IR instructions on constant operands at compile-time
+    ---------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+
+#include "IR/ir.h"
+#include "IR/ir_pool.h"
+#include "IR/ir_value.h"
+#include "UTIL/ground.h"
+
+// ---------------- ir_fold_instr ----------------
+// Attempts to compute the result of an instruction at compile-time.
+// Supports math, comparison, bitwise, shift, unary, cast and select instructions.
+// Returns NULL if the result isn't a compile-time constant,
+// or if computing it at runtime could behave differently
+// (e.g. division by zero, signed division overflow, oversized shifts,
+// out-of-range float to integer conversions)
+ir_value_t *ir_fold_instr(ir_pool_t *pool, ir_instr_t *instr);
+
+// ---------------- ir_fold_scalar_literal ----------------
+// Evaluates a constant scalar value (a literal behind any number of constant casts)
+// into a plain literal value. Returns NULL if the value can't be evaluated.
+// NOTE: The result is interned and must never be modified in place
+ir_value_t *ir_fold_scalar_literal(ir_pool_t *pool, ir_value_t *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_IR_FOLD_H
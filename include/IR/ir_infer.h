@@ -0,0 +1,33 @@
+
+#ifndef _ISAAC_IR_INFER_H
+#define _ISAAC_IR_INFER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ================================ ir_infer.h ================================
+    Module for inferring function attributes from intermediate representation
+    ----------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+
+#include "IR/ir_module.h"
+
+// ---------------- ir_module_infer_attributes ----------------
+// Marks functions of an IR module with the attributes that can be
+// proven from their bodies (IR_FUNC_READNONE, IR_FUNC_READONLY, IR_FUNC_WILLRETURN,
+// IR_FUNC_NOALIAS_RETURN and IR_FUNC_ARG_* argument traits)
+// Functions are visited bottom-up over the call graph, so that callees are
+// always summarized before their callers
+// If 'null_checks' is true, then memory accesses are assumed to possibly
+// abort the program, since they will be guarded by runtime null checks
+void ir_module_infer_attributes(ir_module_t *ir_module, bool null_checks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_IR_INFER_H
@@ -0,0 +1,33 @@
+
+#ifndef _ISAAC_IR_MERGE_H
+#define _ISAAC_IR_MERGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ================================ ir_merge.h ================================
+    Module for merging functions of an IR module that have identical code
+    ----------------------------------------------------------------------------
+*/
+
+#include "IR/ir_module.h"
+#include "UTIL/ground.h"
+
+// ---------------- ir_module_merge_identical_funcs ----------------
+// Folds functions that have the same signature and identical bodies
+// (such as polymorphic instantiations over types with the same layout)
+// into a single function. Calls, function addresses and vtable entries
+// are redirected to the remaining function, and the folded functions
+// are marked as IR_FUNC_UNREFERENCED so that they are never emitted
+// Functions whose addresses are visible to user code are never folded,
+// since their addresses must stay unique
+// Returns the number of functions that were folded away
+length_t ir_module_merge_identical_funcs(ir_module_t *ir_module);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_IR_MERGE_H
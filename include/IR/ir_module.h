@@ -43,11 +43,16 @@ typedef struct ir_module {
     free_list_t defer_free;
     ir_vtable_init_list_t vtable_init_list;
     ir_vtable_dispatch_list_t vtable_dispatch_list;
+    struct ir_speculation *speculation; // Non-NULL while a function body is being generated speculatively
+    length_t devirtualized_calls; // Number of call sites whose virtual dispatch has only a single possible target
+    length_t merged_funcs;        // Number of functions folded into another function with identical code
+    length_t stripped_rtti;       // Number of runtime type table entries removed because they were unreachable
+    bool rtti_table_referenced;   // Whether '__types__' or '__types_length__' are referenced directly by user code
 } ir_module_t;
 
 // ---------------- ir_module_free ----------------
 // Initializes an IR module for use
-void ir_module_init(ir_module_t *ir_module, length_t funcs_length, length_t globals_length, length_t number_of_function_names_guess);
+void ir_module_init(ir_module_t *ir_module, length_t globals_length, length_t number_of_function_names_guess);
 
 // ---------------- ir_module_free ----------------
 // Frees data within an IR module
@@ -57,6 +62,15 @@ void ir_module_free(ir_module_t *ir_module);
 // Creates a new function mapping
 void ir_module_create_func_mapping(ir_module_t *module, weak_cstr_t function_name, ir_func_endpoint_t endpoint, bool add_to_job_list);
 
+// ---------------- ir_module_reference_func ----------------
+// Marks an IR function as reachable, scheduling its body to
+// be generated if it was previously unreferenced
+void ir_module_reference_func(ir_module_t *module, func_id_t ir_func_id);
+
+// ---------------- ir_module_add_func_traits ----------------
+// Adds traits to an existing IR function
+void ir_module_add_func_traits(ir_module_t *module, func_id_t ir_func_id, trait_t traits);
+
 // ---------------- ir_module_create_method_mapping ----------------
 // Create a new method mapping
 void ir_module_create_method_mapping(ir_module_t *module, weak_cstr_t struct_name, weak_cstr_t method_name, ir_func_endpoint_t endpoint);
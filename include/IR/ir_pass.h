@@ -0,0 +1,62 @@
+
+#ifndef _ISAAC_IR_PASS_H
+#define _ISAAC_IR_PASS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ================================ ir_pass.h ================================
+    Module for cleanup passes over intermediate representation
+    ---------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+
+#include "IR/ir.h"
+#include "IR/ir_module.h"
+#include "IR/ir_value.h"
+#include "UTIL/ground.h"
+#include "UTIL/trait.h"
+
+// Possible IR passes
+#define IR_PASS_NONE               TRAIT_NONE
+#define IR_PASS_FORWARD_LOADS      TRAIT_1 // Reuse values stored to local variables instead of reloading them
+#define IR_PASS_DEAD_INSTRUCTIONS  TRAIT_2 // Remove unused instructions that have no side effects
+#define IR_PASS_THREAD_JUMPS       TRAIT_3 // Branch past basicblocks that only branch elsewhere
+#define IR_PASS_UNREACHABLE_BLOCKS TRAIT_4 // Remove basicblocks that can never be executed
+#define IR_PASS_MERGE_BLOCKS       TRAIT_5 // Merge basicblocks into their only predecessor
+#define IR_PASS_FOLD_CONSTANTS     TRAIT_6 // Compute instructions and branches whose operands are known at compile-time
+#define IR_PASS_MERGE_FUNCS        TRAIT_7 // Fold functions with identical code into a single function
+#define IR_PASS_ALL (IR_PASS_FORWARD_LOADS | IR_PASS_DEAD_INSTRUCTIONS | IR_PASS_THREAD_JUMPS | IR_PASS_UNREACHABLE_BLOCKS | IR_PASS_MERGE_BLOCKS | IR_PASS_FOLD_CONSTANTS | IR_PASS_MERGE_FUNCS)
+
+// ---------------- ir_pass_value_visitor_t ----------------
+// Callback for each value slot visited by 'ir_pass_visit_operands'
+typedef void (*ir_pass_value_visitor_t)(ir_value_t **slot, void *user_data);
+
+// ---------------- ir_pass_visit_value ----------------
+// Visits a value slot and every value slot nested inside of it
+void ir_pass_visit_value(ir_value_t **slot, ir_pass_value_visitor_t visitor, void *user_data);
+
+// ---------------- ir_pass_visit_operands ----------------
+// Visits every value slot of an instruction (including values nested inside of literals),
+// returns false if the instruction isn't understood
+bool ir_pass_visit_operands(ir_instr_t *instr, ir_pass_value_visitor_t visitor, void *user_data);
+
+// ---------------- ir_module_run_passes ----------------
+// Runs the requested IR_PASS_* passes over every function in an IR module
+// If 'keep_checked' is true, then instructions that may perform
+// runtime null checks will never be removed
+void ir_module_run_passes(ir_module_t *ir_module, trait_t passes, bool keep_checked);
+
+// ---------------- ir_pass_from_name ----------------
+// Returns the IR_PASS_* trait for the pass with the given name,
+// returns IR_PASS_NONE if no such pass exists
+trait_t ir_pass_from_name(weak_cstr_t name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_IR_PASS_H
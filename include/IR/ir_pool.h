@@ -26,6 +26,7 @@ typedef struct {
     ir_pool_fragment_t *fragments; // Blocks of memory in which small allocations stored
     length_t length;
     length_t capacity;
+    struct ir_const_pool *const_pool; // Interned literal values (created on first use)
 } ir_pool_t;
 
 // ---------------- ir_pool_snapshot_t ----------------
@@ -59,6 +60,12 @@ ir_pool_snapshot_t ir_pool_snapshot_capture(ir_pool_t *pool);
 // Restores an IR pool to a previous memory usage snapshot
 void ir_pool_snapshot_restore(ir_pool_t *pool, ir_pool_snapshot_t *snapshot);
 
+// ---------------- ir_pool_adopt ----------------
+// Takes ownership of all memory allocated by another IR pool,
+// so that it lives for as long as 'pool' does.
+// 'other' is freed and cannot be used afterwards
+void ir_pool_adopt(ir_pool_t *pool, ir_pool_t *other);
+
 // ---------------- ir_pool_memclone ----------------
 // Creates a pool-allocated copy of a portion of memory
 void *ir_pool_memclone(ir_pool_t *pool, const void *bytes, length_t num_bytes);
@@ -32,13 +32,15 @@
 #define TYPE_KIND_FIXED_ARRAY       0x00000012 // extra = ir_type_extra_fixed_array_t*
 #define TYPE_KIND_UNKNOWN_ENUM      0x00000013 // extra = ir_type_extra_unknown_enum_t*
 #define TYPE_KIND_UNBUILT_COMPOSITE 0x00000014 // extra = ast_composite_t* (only used during processing)
+#define TYPE_KIND_VECTOR            0x00000015 // extra = ir_type_extra_vector_t*
 
 #define IS_TYPE_KIND_SIGNED(a) global_type_kind_signs[a]
 
 // ---------------- ir_type_t ----------------
 // An intermediate representation type
 // 'extra' can optionally contain one of the following for example:
-// 'ir_type_t', 'ir_type_extra_composite_t', 'ir_type_extra_fixed_array_t', 'ir_type_extra_unknown_enum_t'
+// 'ir_type_t', 'ir_type_extra_composite_t', 'ir_type_extra_fixed_array_t', 'ir_type_extra_unknown_enum_t',
+// 'ir_type_extra_vector_t'
 typedef struct {
     unsigned int kind;
     void *extra;
@@ -51,10 +53,18 @@ typedef struct {
     ir_type_t **subtypes;
     length_t subtypes_length;
     trait_t traits;
+
+    // Explicit minimum alignment of the composite, or zero for natural alignment
+    length_t alignment;
+
+    // Explicit minimum alignment for each subtype (nullable)
+    // Is NULL when none of the subtypes have explicit alignment
+    length_t *subtype_alignments;
 } ir_type_extra_composite_t;
 
 // Possible traits for ir_type_extra_composite_t
-#define TYPE_KIND_COMPOSITE_PACKED TRAIT_1
+#define TYPE_KIND_COMPOSITE_PACKED    TRAIT_1
+#define TYPE_KIND_COMPOSITE_REORDERED TRAIT_2 // (fields are physically laid out by descending alignment)
 
 // ---------------- ir_type_extra_fixed_array_t ----------------
 // Structure for 'extra' field of 'ir_type_t' for fixed arrays
@@ -63,6 +73,14 @@ typedef struct {
     length_t length;
 } ir_type_extra_fixed_array_t;
 
+// ---------------- ir_type_extra_vector_t ----------------
+// Structure for 'extra' field of 'ir_type_t' for SIMD vectors
+// The subtype is always a primitive integer, float or boolean type
+typedef struct {
+    ir_type_t *subtype;
+    length_t length;
+} ir_type_extra_vector_t;
+
 // ---------------- ir_type_extra_unknown_enum_t ----------------
 // Structure for 'extra' field of 'ir_type_t' for unknown enum types
 typedef struct {
@@ -91,6 +109,10 @@ ir_type_t *ir_type_make_pointer_to(ir_pool_t *pool, ir_type_t *base);
 // Gets the type of a fixed array of a type
 ir_type_t *ir_type_make_fixed_array_of(ir_pool_t *pool, length_t length, ir_type_t *base);
 
+// ---------------- ir_type_make_vector_of ----------------
+// Gets the type of a SIMD vector of a primitive type
+ir_type_t *ir_type_make_vector_of(ir_pool_t *pool, length_t length, ir_type_t *base);
+
 // ---------------- ir_type_make_function_pointer ----------------
 // Gets the type for a function pointer
 ir_type_t *ir_type_make_function_pointer(ir_pool_t *pool);
@@ -112,6 +134,11 @@ ir_type_t *ir_type_unwrap(ir_type_t *type);
 // Returns whether an IR type is a pointer to a type of a specific kind
 bool ir_type_is_pointer_to(ir_type_t *type, unsigned int child_type_kind);
 
+// ---------------- ir_type_has_manual_layout ----------------
+// Returns whether the layout of an IR type is affected by explicit 'align(N)'
+// alignment or by field reordering, either of itself or of anything it contains by value
+bool ir_type_has_manual_layout(ir_type_t *type);
+
 // ---------------- global_type_kind_sizes_in_bits_64 ----------------
 // Contains the general sizes of each TYPE_KIND_*
 // (For 64 bit systems only)
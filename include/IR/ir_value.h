@@ -8,6 +8,8 @@
     ----------------------------------------------------------------------------
 */
 
+#include <stdint.h>
+
 #include "IR/ir_type.h"
 
 // =============================================================
@@ -16,7 +18,7 @@
 #define VALUE_TYPE_NONE                 0x00000000
 
 // Non-const values
-#define VALUE_TYPE_RESULT               0x00000001 // data = pointer to an 'ir_value_result_t'
+#define VALUE_TYPE_RESULT               0x00000001 // result = inline 'ir_value_result_t'
 #define VALUE_TYPE_ANON_GLOBAL          0x00000002 // data = pointer to an 'ir_value_anon_global_t'
 #define VALUE_TYPE_CONST_STRUCT_LITERAL 0x00000003 // data = pointer to an 'ir_value_const_struct_literal_t'
 #define VALUE_TYPE_OFFSETOF             0x00000004 // data = pointer to an 'ir_value_offsetof_t'
@@ -56,22 +58,27 @@
 #define VALUE_TYPE_IS_CONSTANT(a)      (a > VALUE_TYPE_LAST_NON_CONST)
 #define VALUE_TYPE_IS_CONSTANT_CAST(a) (a > VALUE_TYPE_LAST_CONST_NON_CAST)
 
+// ---------------- ir_value_result_t ----------------
+// Structure for 'result' field of 'ir_value_t' if
+// the value is the result of an instruction
+// NOTE: Stored inline as 32-bit indices, so that referencing the
+// result of an instruction doesn't require a separate allocation
+typedef struct {
+    uint32_t block_id;
+    uint32_t instruction_id;
+} ir_value_result_t;
+
 // ---------------- ir_value_t ----------------
 // An intermediate representation value
 typedef struct {
     unsigned int value_type;
     ir_type_t *type;
-    void *extra;
+    union {
+        void *extra;
+        ir_value_result_t result; // (for VALUE_TYPE_RESULT)
+    };
 } ir_value_t;
 
-// ---------------- ir_value_result_t ----------------
-// Structure for 'extra' field of 'ir_value_t' if
-// the value is the result of an instruction
-typedef struct {
-    length_t block_id;
-    length_t instruction_id;
-} ir_value_result_t;
-
 // ---------------- ir_value_array_literal_t ----------------
 // Structure for 'extra' field of 'ir_value_t' if
 // the value is an array literal
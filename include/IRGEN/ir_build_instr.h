@@ -80,6 +80,11 @@ void build_break(ir_builder_t *builder, length_t basicblock_id);
 // Builds a conditional break instruction
 void build_cond_break(ir_builder_t *builder, ir_value_t *condition, length_t true_block_id, length_t false_block_id);
 
+// ---------------- build_hinted_cond_break ----------------
+// Builds a conditional break instruction with a hint for whether 'condition' is likely to be true
+// (TROOLEAN_TRUE for likely, TROOLEAN_FALSE for unlikely, TROOLEAN_UNKNOWN for no hint)
+void build_hinted_cond_break(ir_builder_t *builder, ir_value_t *condition, length_t true_block_id, length_t false_block_id, troolean likely);
+
 // ---------------- build_equals ----------------
 // Builds an equals instruction
 ir_value_t *build_equals(ir_builder_t *builder, ir_value_t *a, ir_value_t *b);
@@ -142,12 +147,82 @@ void build_stack_restore(ir_builder_t *builder, ir_value_t *stack_pointer);
 
 // ---------------- build_math ----------------
 // Builds a basic math instruction
+// NOTE: Returns a literal instead if the result is known at compile-time
 ir_value_t *build_math(ir_builder_t *builder, unsigned int instr_id, ir_value_t *a, ir_value_t *b, ir_type_t *result);
 
+// ---------------- build_unary ----------------
+// Builds a unary instruction (e.g. negate, bit complement, iszero)
+// NOTE: Returns a literal instead if the result is known at compile-time
+ir_value_t *build_unary(ir_builder_t *builder, unsigned int instr_id, ir_value_t *value, ir_type_t *result);
+
 // ---------------- build_phi2 ----------------
 // Builds a PHI2 instruction
 ir_value_t *build_phi2(ir_builder_t *builder, ir_type_t *result_type, ir_value_t *a, ir_value_t *b, length_t landing_a_block_id, length_t landing_b_block_id);
 
+// ---------------- build_select ----------------
+// Builds a SELECT instruction
+// NOTE: The condition can be a vector of booleans to select lane-wise
+ir_value_t *build_select(ir_builder_t *builder, ir_type_t *result_type, ir_value_t *condition, ir_value_t *if_true, ir_value_t *if_false);
+
+// ---------------- build_vector_splat ----------------
+// Builds an instruction that copies a scalar value into every lane of a vector
+ir_value_t *build_vector_splat(ir_builder_t *builder, ir_value_t *value, ir_type_t *vector_type);
+
+// ---------------- build_vector_shuffle ----------------
+// Builds an instruction that rearranges the lanes of two vectors
+// NOTE: 'mask' must be allocated inside of the IR pool
+ir_value_t *build_vector_shuffle(ir_builder_t *builder, ir_type_t *result_type, ir_value_t *a, ir_value_t *b, length_t *mask, length_t mask_length);
+
+// ---------------- build_vector_reduce ----------------
+// Builds an instruction that horizontally combines the lanes of a vector
+// NOTE: See 'ir_instr_vector_reduce_t' for possible operations
+ir_value_t *build_vector_reduce(ir_builder_t *builder, unsigned int operation, ir_value_t *value);
+
+// ---------------- build_intrinsic ----------------
+// Builds an instruction that performs a builtin intrinsic operation
+// NOTE: See 'enum ir_intrinsic_id' for possible intrinsics
+// NOTE: 'values' must be allocated inside of the IR pool
+ir_value_t *build_intrinsic(ir_builder_t *builder, unsigned int intrinsic, ir_type_t *result_type, ir_value_t **values, length_t values_length);
+
+// ---------------- build_atomic_load ----------------
+// Builds an instruction that atomically loads the value at 'pointer'
+// NOTE: See 'enum ir_atomic_ordering' for possible orderings
+ir_value_t *build_atomic_load(ir_builder_t *builder, ir_value_t *pointer, unsigned int ordering);
+
+// ---------------- build_atomic_store ----------------
+// Builds an instruction that atomically stores 'value' at 'pointer'
+// NOTE: The resulting value has the type 'void_type' and is only useful as the result of a void expression
+ir_value_t *build_atomic_store(ir_builder_t *builder, ir_type_t *void_type, ir_value_t *value, ir_value_t *pointer, unsigned int ordering);
+
+// ---------------- build_atomic_rmw ----------------
+// Builds an instruction that atomically combines 'value' with the value at 'pointer'
+// and gives back the previous value
+// NOTE: See 'ir_instr_atomic_t' for possible operations
+ir_value_t *build_atomic_rmw(ir_builder_t *builder, unsigned int operation, ir_value_t *pointer, ir_value_t *value, unsigned int ordering);
+
+// ---------------- build_atomic_cmpxchg ----------------
+// Builds an instruction that atomically replaces the value at 'pointer' with 'value'
+// if it is equal to 'expected', and gives back the previous value
+ir_value_t *build_atomic_cmpxchg(ir_builder_t *builder, ir_value_t *pointer, ir_value_t *expected, ir_value_t *value,
+        unsigned int success_ordering, unsigned int failure_ordering);
+
+// ---------------- build_fence ----------------
+// Builds a memory fence instruction
+// NOTE: The resulting value has the type 'void_type' like 'build_atomic_store'
+ir_value_t *build_fence(ir_builder_t *builder, ir_type_t *void_type, unsigned int ordering);
+
+// ---------------- build_parallel_for ----------------
+// Builds an instruction that runs the iterations [0, count) of an outlined
+// loop body across multiple threads, and waits for all of them to finish
+// NOTE: See 'ir_instr_parallel_for_t' for more information
+void build_parallel_for(ir_builder_t *builder, ir_value_t *body, ir_value_t *env, ir_value_t *count);
+
+// ---------------- build_coroutine ----------------
+// Builds a coroutine suspend/resume/destroy/done/value instruction
+// NOTE: 'value' is the coroutine handle, except for suspend where it is the pointer to the yielded value
+// NOTE: Resume and destroy have no result, so 'result_type' may be the 'void' type, or NULL (in which case NULL is returned)
+ir_value_t *build_coroutine(ir_builder_t *builder, unsigned int instr_id, ir_value_t *value, ir_type_t *result_type);
+
 // ---------------- build_llvm_asm ----------------
 // Builds an inline assembly instruction
 void build_llvm_asm(ir_builder_t *builder, bool is_intel, weak_cstr_t assembly, weak_cstr_t constraints, ir_value_t **args, length_t arity, bool has_side_effects, bool is_stack_align);
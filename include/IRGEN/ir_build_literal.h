@@ -55,12 +55,19 @@ ir_value_t *build_array_literal(ir_pool_t *pool, ir_type_t *item_type, ir_value_
 
 // ---------------- build_literal_int ----------------
 // Builds a literal int value
+// NOTE: The resulting value is interned and shared, so it must not be modified
 ir_value_t *build_literal_int(ir_pool_t *pool, adept_int value);
 
 // ---------------- build_literal_usize ----------------
 // Builds a literal usize value
+// NOTE: The resulting value is interned and shared, so it must not be modified
 ir_value_t *build_literal_usize(ir_pool_t *pool, adept_usize value);
 
+// ---------------- build_placeholder_usize ----------------
+// Builds a usize literal of zero that isn't shared with any other value,
+// so that its contents can be filled in later
+ir_value_t *build_placeholder_usize(ir_pool_t *pool);
+
 // ---------------- build_unknown_enum_value ----------------
 // Builds an enum value of an unknown type
 ir_value_t *build_unknown_enum_value(ir_pool_t *pool, source_t source, weak_cstr_t kind_name);
@@ -114,6 +121,7 @@ ir_value_t *build_const_cast(ir_pool_t *pool, unsigned int const_cast_value_type
 
 // ---------------- build_bool ----------------
 // Builds a literal boolean value
+// NOTE: The resulting value is interned and shared, so it must not be modified
 ir_value_t *build_bool(ir_pool_t *pool, adept_bool value);
 
 #endif // _ISAAC_IR_BUILD_LITERAL_H
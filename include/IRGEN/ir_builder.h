@@ -39,6 +39,21 @@ typedef listof(block_t, blocks) block_stack_t;
 #define block_stack_push(LIST, VALUE) list_append((LIST), (VALUE), block_t)
 #define block_stack_pop(LIST) ((LIST)->length--)
 
+// ---------------- ir_parallel_body_t ----------------
+// Capture state for a builder that is generating the body
+// function of a parallel loop
+// Variables of the enclosing function that are used inside of
+// the body are captured by reference and passed through
+// an environment array of pointers
+typedef struct ir_parallel_body {
+    struct ir_builder *enclosing;
+    length_t env_var_id;
+    weak_cstr_t *captures;
+    length_t captures_length;
+    length_t captures_capacity;
+    length_t reserved_slots; // Number of leading environment slots not used for captures
+} ir_parallel_body_t;
+
 // ---------------- ir_builder_t ----------------
 // Container for storing general information
 // about the building state
@@ -69,6 +84,7 @@ typedef struct ir_builder {
     ir_type_t *ptr_type;
     func_id_t noop_defer_function;
     bool has_noop_defer_function;
+    ir_parallel_body_t *parallel_body; // NULL when not generating the body of a parallel loop
 } ir_builder_t;
 
 #include "IR/ir_module.h"
@@ -138,6 +154,13 @@ void ir_builder_pop_loop_label(ir_builder_t *builder);
 // Returns a temporary pointer to the constructed variable
 bridge_var_t *ir_builder_add_variable(ir_builder_t *builder, weak_cstr_t name, ast_type_t *ast_type, ir_type_t *ir_type, trait_t traits);
 
+// ---------------- ir_builder_find_var ----------------
+// Finds a variable that is visible from the current scope
+// When generating the body of a parallel loop, variables of the
+// enclosing function will be captured by reference as needed
+// Returns NULL if no variable with the given name exists
+bridge_var_t *ir_builder_find_var(ir_builder_t *builder, weak_cstr_t name);
+
 // ---------------- handle_deference_for_variables ----------------
 // Handles deference for variables in a variable list
 // Returns FAILURE on compile time error
@@ -308,6 +331,7 @@ typedef struct {
     length_t current_block_id;
     length_t current_basicblock_instructions_length;
     length_t basicblocks_length;
+    ir_pool_snapshot_t instructions_pool_snapshot;
     length_t funcs_length;
     length_t job_list_length;
 } ir_instrs_snapshot_t;
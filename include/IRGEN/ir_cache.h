@@ -46,9 +46,12 @@ typedef struct ir_gen_sf_cache_entry {
 
 // ---------------- ir_gen_sf_cache_t ----------------
 // Special functions cache
-typedef struct {
+// New entries start out with what 'fallback' knows (if it isn't NULL),
+// which lets a small private cache be layered on top of a shared one
+typedef struct ir_gen_sf_cache {
     ir_gen_sf_cache_entry_t *storage;
     length_t capacity;
+    struct ir_gen_sf_cache *fallback;
 } ir_gen_sf_cache_t;
 
 // ---------------- ir_gen_sf_cache_init ----------------
@@ -71,6 +74,11 @@ errorcode_t ir_gen_sf_cache_read(troolean has, func_pair_t maybe_pair, optional_
 // NOTE: Does not take any ownership of 'type'
 ir_gen_sf_cache_entry_t *ir_gen_sf_cache_locate_or_insert(ir_gen_sf_cache_t *cache, ast_type_t *type);
 
+// ---------------- ir_gen_sf_cache_locate ----------------
+// Locates an existing cache entry for AST type in special functions cache
+// Returns NULL if there isn't one, never modifies the cache
+ir_gen_sf_cache_entry_t *ir_gen_sf_cache_locate(ir_gen_sf_cache_t *cache, ast_type_t *type);
+
 // ---------------- ir_gen_sf_cache_dump ----------------
 // Dumps a visual representation of an special function cache
 void ir_gen_sf_cache_dump(FILE *file, ir_gen_sf_cache_t *sf_cache);
@@ -68,7 +68,8 @@ errorcode_t ir_gen_globals_init(ir_builder_t *builder);
 
 // ---------------- ir_gen_build_rtti_table ----------------
 // Constructs the RTTI table for a module
-errorcode_t ir_gen_build_rtti_table(object_t *object);
+// Unreachable entries are left out if 'COMPILER_STRIP_TYPEINFO' is enabled
+errorcode_t ir_gen_build_rtti_table(compiler_t *compiler, object_t *object);
 
 // ---------------- ir_gen_special_global ----------------
 // Generates initializers for special global variables
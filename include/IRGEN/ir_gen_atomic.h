@@ -0,0 +1,46 @@
+
+#ifndef _ISAAC_IR_GEN_ATOMIC_H
+#define _ISAAC_IR_GEN_ATOMIC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================= ir_gen_atomic.h =============================
+    Module for generating IR for calls to builtin atomic operations
+    ---------------------------------------------------------------------------
+*/
+
+#include "AST/ast_expr.h"
+#include "AST/ast_type_lean.h"
+#include "IR/ir_value.h"
+#include "IRGEN/ir_builder.h"
+#include "UTIL/ground.h"
+
+// ---------------- ir_gen_atomic_builtin ----------------
+// Generates a call to a builtin atomic operation:
+//     atomic_load(pointer, order)                                  - Integers, floats and pointers
+//     atomic_store(pointer, value, order)                          - Integers, floats and pointers
+//     atomic_exchange(pointer, value, order)                       - Integers, floats and pointers
+//     atomic_compare_exchange(pointer, expected, desired,
+//                             success_order, failure_order)        - Integers and pointers
+//     atomic_fetch_add(pointer, value, order)                      - Integers and floats (also 'sub')
+//     atomic_fetch_and(pointer, value, order)                      - Integers (also 'or', 'xor', 'min' and 'max')
+//     atomic_fence(order)
+// Orderings are constant integers with the same values as C11's 'memory_order',
+// and can be left off to use sequentially consistent ordering
+// Like in C11, 'atomic_compare_exchange' takes a pointer to the expected value,
+// which is updated to the previous value. It returns whether the exchange happened
+// Builtin atomic operations are only considered when no user function
+// or global variable with the same name exists
+// NOTE: 'arg_types' is not freed
+// Returns ALT_FAILURE if the call isn't a builtin atomic operation
+errorcode_t ir_gen_atomic_builtin(ir_builder_t *builder, ast_expr_call_t *expr, ir_value_t **arg_values,
+        ast_type_t *arg_types, ir_value_t **ir_value, ast_type_t *out_expr_type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_IR_GEN_ATOMIC_H
@@ -0,0 +1,59 @@
+
+#ifndef _ISAAC_IR_GEN_COROUTINE_H
+#define _ISAAC_IR_GEN_COROUTINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    =========================== ir_gen_coroutine.h ===========================
+    Module for generating IR for generators, which are lowered to coroutines
+    ---------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+
+#include "AST/ast_expr.h"
+#include "AST/ast_type_lean.h"
+#include "IR/ir_value.h"
+#include "IRGEN/ir_builder.h"
+#include "UTIL/ground.h"
+
+// ---------------- ir_gen_stmt_yield ----------------
+// Generates IR instructions for a 'yield' statement
+// The generator suspends until it is resumed or destroyed,
+// if destroyed, the pending deferred statements and variable
+// deference are run before the generator finishes
+errorcode_t ir_gen_stmt_yield(ir_builder_t *builder, ast_expr_yield_t *stmt);
+
+// ---------------- ir_gen_is_generator_call ----------------
+// Returns whether an IR value is the handle returned by calling a generator
+bool ir_gen_is_generator_call(ir_builder_t *builder, ir_value_t *value);
+
+// ---------------- ir_gen_stmt_each_generator ----------------
+// Generates IR instructions for an 'each in' loop over the values
+// yielded by a generator. The generator is destroyed once the loop is exited
+// NOTE: Expects the scope of the loop to already be open
+// NOTE: Assumes that 'ir_gen_is_generator_call(builder, handle)' is true
+errorcode_t ir_gen_stmt_each_generator(ir_builder_t *builder, ast_expr_each_in_t *stmt, ir_value_t *handle, ir_value_t *idx_ptr);
+
+// ---------------- ir_gen_coroutine_builtin ----------------
+// Generates a call to a builtin operation on a generator handle:
+//     coroutine_resume(handle ptr) void   - Runs the generator until its next 'yield'
+//     coroutine_destroy(handle ptr) void  - Destroys the generator and frees its frame
+//     coroutine_done(handle ptr) bool     - Returns whether the generator has finished
+//     coroutine_value(handle ptr) ptr     - Returns a pointer to the most recently yielded value,
+//                                           which is valid until the generator is resumed
+// Builtin coroutine operations are only considered when no user function
+// or global variable with the same name exists
+// NOTE: 'arg_types' is not freed
+// Returns ALT_FAILURE if the call isn't a builtin coroutine operation
+errorcode_t ir_gen_coroutine_builtin(ir_builder_t *builder, ast_expr_call_t *expr, ir_value_t **arg_values,
+        ast_type_t *arg_types, ir_value_t **ir_value, ast_type_t *out_expr_type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_IR_GEN_COROUTINE_H
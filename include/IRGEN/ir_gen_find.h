@@ -149,4 +149,10 @@ errorcode_t ir_gen_find_method_conforming_without_defaults(
 // Returns ALT_FAILURE if something went wrong
 errorcode_t ir_gen_find_singular_special_func(compiler_t *compiler, object_t *object, weak_cstr_t func_name, func_id_t *out_ir_func_id);
 
+// ---------------- ir_gen_find_intrinsic ----------------
+// Finds a builtin intrinsic function (such as 'ctpop')
+// Sets 'out_intrinsic' to the IR_INTRINSIC_* id ONLY IF found
+// NOTE: Intrinsics are only used when no user function or global shares the name
+successful_t ir_gen_find_intrinsic(weak_cstr_t name, unsigned int *out_intrinsic);
+
 #endif // _ISAAC_IR_GEN_FIND_H
@@ -0,0 +1,39 @@
+
+#ifndef _ISAAC_IR_GEN_INTRINSIC_H
+#define _ISAAC_IR_GEN_INTRINSIC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================ ir_gen_intrinsic.h ============================
+    Module for generating IR for calls to builtin intrinsic functions
+    ----------------------------------------------------------------------------
+*/
+
+#include "AST/ast_expr.h"
+#include "AST/ast_type_lean.h"
+#include "IR/ir_value.h"
+#include "IRGEN/ir_builder.h"
+#include "UTIL/ground.h"
+
+// ---------------- ir_gen_intrinsic ----------------
+// Generates a call to a builtin intrinsic function found by 'ir_gen_find_intrinsic'
+//     ctpop(x), ctlz(x), cttz(x), bswap(x)    - Integers (and integer vectors)
+//     fshl(a, b, shift), fshr(a, b, shift)    - Integers (and integer vectors)
+//     fma(a, b, c), sqrt(x)                   - Floats (and float vectors)
+//     expect(value, expected)                 - Integers and booleans
+//     prefetch(address)                       - Pointers
+//     prefetch(address, for_write, locality)  - Pointers, with constant hints
+// Operands after the first are conformed to the type of the first,
+// which is also the type of the result (except for 'prefetch' which returns 'void')
+// NOTE: 'arg_types' is not freed
+errorcode_t ir_gen_intrinsic(ir_builder_t *builder, ast_expr_call_t *expr, unsigned int intrinsic,
+        ir_value_t **arg_values, ast_type_t *arg_types, ir_value_t **ir_value, ast_type_t *out_expr_type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_IR_GEN_INTRINSIC_H
@@ -0,0 +1,38 @@
+
+#ifndef _ISAAC_IR_GEN_PARALLEL_H
+#define _ISAAC_IR_GEN_PARALLEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================ ir_gen_parallel.h ============================
+    Module for generating IR for parallel 'each in' and 'repeat' loops
+    ---------------------------------------------------------------------------
+*/
+
+#include "AST/ast_expr.h"
+#include "IRGEN/ir_builder.h"
+#include "UTIL/ground.h"
+
+// ---------------- ir_gen_stmt_parallel_repeat ----------------
+// Generates IR instructions for a parallel 'repeat' loop
+// The body of the loop is outlined into its own function, which
+// is called by worker threads for chunks of the iteration space.
+// Local variables of the enclosing function are shared by reference,
+// and reduced variables get a private copy per chunk that is
+// atomically combined into the shared variable once the chunk is done
+errorcode_t ir_gen_stmt_parallel_repeat(ir_builder_t *builder, ast_expr_repeat_t *stmt);
+
+// ---------------- ir_gen_stmt_parallel_each ----------------
+// Generates IR instructions for a parallel 'each in' loop
+// (Same as 'ir_gen_stmt_parallel_repeat', except the array
+// and length are only computed once before the loop begins)
+errorcode_t ir_gen_stmt_parallel_each(ir_builder_t *builder, ast_expr_each_in_t *stmt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_IR_GEN_PARALLEL_H
@@ -83,6 +83,11 @@ errorcode_t ir_gen__types__pointer_entry(object_t *object, ir_value_t **array_va
 // Fills in the RTTI for a fixed array type inside the prepared global values for '__types__'
 errorcode_t ir_gen__types__fixed_array_entry(object_t *object, ir_value_t **array_values, length_t array_value_index, ir_rtti_types_t *rtti_types);
 
+// ---------------- ir_gen__types__vector_entry ----------------
+// Fills in the RTTI for a SIMD vector type inside the prepared global values for '__types__'
+// (uses the same layout as fixed arrays)
+errorcode_t ir_gen__types__vector_entry(object_t *object, ir_value_t **array_values, length_t array_value_index, ir_rtti_types_t *rtti_types);
+
 // ---------------- ir_gen__types__func_ptr_entry ----------------
 // Fills in the RTTI for a function pointer type inside the prepared global values for '__types__'
 errorcode_t ir_gen__types__func_ptr_entry(object_t *object, ir_value_t **array_values, length_t array_value_index, ir_rtti_types_t *rtti_types);
@@ -124,6 +129,12 @@ ir_value_t *ir_gen__types__composite_entry_member_names_array(ir_module_t *ir_mo
 // Returns an ir_value_t that's a null pointer if the type couldn't be found
 ir_value_t *ir_gen__types__get_rtti_pointer_for(object_t *object, ast_type_t *ast_type, ir_value_t **array_values, ir_rtti_types_t *rtti_types);
 
+// ---------------- ir_gen__types__strip_unreachable ----------------
+// Removes RTTI table entries that can't be reached from any RTTI relocation,
+// either directly or through the subtypes of another reachable entry
+// NOTE: Must only be used when user code doesn't access '__types__' directly
+errorcode_t ir_gen__types__strip_unreachable(compiler_t *compiler, object_t *object);
+
 // ---------------- rtti_collector_collect ----------------
 // Creates a list of RTTI table entries by taking data from an RTTI collector.
 rtti_table_entry_list_t rtti_collector_collect(rtti_collector_t *rtti_collector);
@@ -0,0 +1,64 @@
+
+#ifndef _ISAAC_IR_GEN_SOA_H
+#define _ISAAC_IR_GEN_SOA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================= ir_gen_soa.h =============================
+    Module for generating IR for structure-of-arrays containers, whose
+    elements only exist as separate fields stored in one column per field
+    ------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+
+#include "AST/ast.h"
+#include "AST/ast_expr.h"
+#include "AST/ast_type_lean.h"
+#include "BRIDGE/bridge.h"
+#include "DRVR/object.h"
+#include "IR/ir_value.h"
+#include "IRGEN/ir_builder.h"
+#include "UTIL/ground.h"
+
+// ---------------- ir_gen_soa_find ----------------
+// Returns the SoA container that an AST type refers to,
+// or NULL if the type isn't an SoA container
+ast_soa_t *ir_gen_soa_find(object_t *object, ast_type_t *type);
+
+// ---------------- ir_gen_soa_member ----------------
+// Generates IR instructions for accessing a field of an element of
+// an SoA container (e.g. 'particles[i].x' or 'it.x' inside of 'each in'),
+// the field is accessed directly within its column without gathering the element
+// Returns ALT_FAILURE if the expression isn't a member of an SoA container element
+errorcode_t ir_gen_soa_member(ir_builder_t *builder, ast_expr_member_t *expr, ir_value_t **ir_value, bool leave_mutable, ast_type_t *out_expr_type);
+
+// ---------------- ir_gen_soa_element ----------------
+// Generates IR instructions for using an entire element of an SoA container
+// as a value, which is gathered from each of the columns of the container
+// NOTE: Elements can't be left mutable, since they only exist as separate fields
+errorcode_t ir_gen_soa_element(ir_builder_t *builder, ast_soa_t *soa, ir_value_t *container, ir_value_t *index, source_t source,
+        ir_value_t **ir_value, bool leave_mutable, ast_type_t *out_expr_type);
+
+// ---------------- ir_gen_soa_element_variable ----------------
+// Generates IR instructions for using the value of a variable that refers
+// to an element of an SoA container
+// NOTE: Assumes that 'variable' has the trait BRIDGE_VAR_SOA_ELEMENT
+errorcode_t ir_gen_soa_element_variable(ir_builder_t *builder, bridge_var_t *variable, source_t source,
+        ir_value_t **ir_value, bool leave_mutable, ast_type_t *out_expr_type);
+
+// ---------------- ir_gen_stmt_each_soa ----------------
+// Generates IR instructions for an 'each in' loop over the elements
+// of an SoA container. 'it' refers to the current element by index,
+// so fields accessed through it are accessed within their columns
+// NOTE: Expects the scope of the loop to already be open
+errorcode_t ir_gen_stmt_each_soa(ir_builder_t *builder, ast_expr_each_in_t *stmt, ast_soa_t *soa, ir_value_t *container, ir_value_t *idx_ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_IR_GEN_SOA_H
@@ -80,6 +80,10 @@ errorcode_t ir_gen_stmt_recurrent_loop(ir_builder_t *builder, ast_expr_whilecont
 // Generates IR instructions for a 'delete' statement
 errorcode_t ir_gen_stmt_delete(ir_builder_t *builder, ast_expr_delete_t *stmt);
 
+// ---------------- ir_gen_stmt_assume ----------------
+// Generates IR instructions for an 'assume' statement
+errorcode_t ir_gen_stmt_assume(ir_builder_t *builder, ast_expr_assume_t *stmt);
+
 // ---------------- ir_gen_stmt_break ----------------
 // Generates IR instructions for a 'break' statement
 errorcode_t ir_gen_stmt_break(ir_builder_t *builder, ast_expr_t *stmt, bool *out_is_terminated);
@@ -41,6 +41,7 @@
 #define CONFORM_MODE_USER_EXPLICIT  TRAIT_C    // Allow explicit user-defined conversions via __as__
 #define CONFORM_MODE_USER_IMPLICIT  TRAIT_D    // Allow implicit user-defined conversions via __as__
 #define CONFORM_MODE_INT_TO_FLOAT   TRAIT_E    // Allow implicit conversion from integers to floats
+#define CONFORM_MODE_VECTORS        TRAIT_F    // Allow reinterpreting between vectors of the same size
 #define CONFORM_MODE_ALL            TRAIT_ALL  // Allow all conformation methods
 
 #define CONFORM_MODE_CALL_ARGUMENTS              CONFORM_MODE_STANDARD
@@ -0,0 +1,45 @@
+
+#ifndef _ISAAC_IR_GEN_VECTOR_H
+#define _ISAAC_IR_GEN_VECTOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================= ir_gen_vector.h =============================
+    Module for generating IR for operations on builtin SIMD vector types
+    ---------------------------------------------------------------------------
+*/
+
+#include "AST/ast_expr.h"
+#include "AST/ast_type_lean.h"
+#include "IR/ir_value.h"
+#include "IRGEN/ir_builder.h"
+#include "UTIL/ground.h"
+
+// ---------------- ir_gen_vector_compare ----------------
+// Compares two vectors of the same type lane by lane using the comparison
+// instruction 'instr_id'. The result is a lane mask, which is an integer
+// vector of the same size whose lanes are all ones where the comparison
+// holds and zero otherwise (e.g. comparing two 'f32x4' values gives 'i32x4')
+errorcode_t ir_gen_vector_compare(ir_builder_t *builder, unsigned int instr_id, ir_value_t *a, ir_value_t *b,
+        ast_type_t *vector_type, ir_value_t **ir_value, ast_type_t *out_expr_type);
+
+// ---------------- ir_gen_vector_builtin ----------------
+// Generates a call to a builtin vector operation:
+//     vector_shuffle(a, b, indices...)    - Picks lanes out of 'a' and 'b' using constant indices
+//     vector_select(mask, a, b)           - Picks lanes from 'a' where 'mask' is non-zero, otherwise from 'b'
+//     vector_reduce_<op>(v)               - Combines all lanes using add, mul, min, max, and, or or xor
+// Builtin vector operations are only considered when no user function
+// or global variable with the same name exists
+// NOTE: 'arg_types' is not freed
+// Returns ALT_FAILURE if the call isn't a builtin vector operation
+errorcode_t ir_gen_vector_builtin(ir_builder_t *builder, ast_expr_call_t *expr, ir_value_t **arg_values,
+        ast_type_t *arg_types, ir_value_t **ir_value, ast_type_t *out_expr_type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_IR_GEN_VECTOR_H
@@ -0,0 +1,167 @@
+
+#ifndef _ISAAC_IR_SPECULATION_H
+#define _ISAAC_IR_SPECULATION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================ ir_speculation.h ============================
+    Module for generating function bodies speculatively on multiple threads
+
+    Each job of a batch is generated against a private copy of the object,
+    using an IR pool and lists of things that the body adds to the module
+    that belong to that job alone. Tables shared by the whole module are only read.
+    Anything that would change them (instantiating polymorphic functions,
+    auto-generating functions, static variables, etc.) makes the
+    speculation give up, so that the job is generated normally instead.
+
+    Speculations are committed one at a time in the same order that jobs
+    are normally processed in. Since bodies committed or generated before
+    can add functions, the function lookups made by a speculation are
+    recorded and must still have the same answer for it to be committed
+    --------------------------------------------------------------------------
+*/
+
+#include <stdbool.h>
+
+#include "BRIDGE/rtti_collector.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "IR/ir.h"
+#include "IR/ir_func_endpoint.h"
+#include "IR/ir_pool.h"
+#include "IR/ir_proc_map.h"
+#include "IR/ir_value.h"
+#include "IRGEN/ir_cache.h"
+#include "UTIL/ground.h"
+#include "UTIL/list.h"
+#include "UTIL/trait.h"
+
+// ---------------- ir_speculation_lookup_t ----------------
+// Function lookup made by a speculation
+// 'endpoint_list' is NULL if nothing was found
+typedef struct {
+    union {
+        ir_func_key_t func;
+        ir_method_key_t method;
+    } key;
+    bool is_method;
+    ir_func_endpoint_list_t *endpoint_list;
+    length_t length;
+} ir_speculation_lookup_t;
+
+typedef listof(ir_speculation_lookup_t, lookups) ir_speculation_lookups_t;
+#define ir_speculation_lookups_append(LIST, VALUE) list_append((LIST), (VALUE), ir_speculation_lookup_t)
+
+// ---------------- ir_speculation_func_traits_t ----------------
+// Traits that a speculation wants to add to an existing IR function
+typedef struct {
+    func_id_t ir_func_id;
+    trait_t traits;
+} ir_speculation_func_traits_t;
+
+typedef listof(ir_speculation_func_traits_t, entries) ir_speculation_func_traits_list_t;
+#define ir_speculation_func_traits_list_append(LIST, VALUE) list_append((LIST), (VALUE), ir_speculation_func_traits_t)
+
+// ---------------- ir_speculation_anon_global_refs_t ----------------
+// References to the anonymous globals created by a speculation,
+// which are renumbered when it's committed
+typedef listof(ir_value_anon_global_t*, refs) ir_speculation_anon_global_refs_t;
+#define ir_speculation_anon_global_refs_append(LIST, VALUE) list_append((LIST), (VALUE), ir_value_anon_global_t*)
+
+// ---------------- ir_speculation_sf_entries_t ----------------
+// Special function cache entries learned by a speculation
+typedef listof(ir_gen_sf_cache_entry_t, entries) ir_speculation_sf_entries_t;
+#define ir_speculation_sf_entries_append(LIST, VALUE) list_append((LIST), (VALUE), ir_gen_sf_cache_entry_t)
+
+// ---------------- ir_speculation_t ----------------
+// Speculatively generated body of a single job
+typedef struct ir_speculation {
+    ir_func_endpoint_t endpoint;
+    ir_pool_t pool; // Memory allocated by the body, adopted by the module once committed
+    errorcode_t errorcode;
+    bool generated;
+    bool aborted;
+    compiler_diagnostics_t diagnostics;
+    ir_speculation_lookups_t lookups;
+    ir_speculation_func_traits_list_t func_traits;
+    ir_speculation_anon_global_refs_t anon_global_refs;
+    ir_anon_globals_t anon_globals;
+    rtti_relocations_t rtti_relocations;
+    free_list_t defer_free;
+    ir_vtable_init_list_t vtable_init_list;
+    ir_vtable_dispatch_list_t vtable_dispatch_list;
+    rtti_collector_t rtti_collector;
+    ir_speculation_sf_entries_t sf_entries;
+    bool use_libm;
+    bool use_libpthread;
+    bool rtti_table_referenced;
+} ir_speculation_t;
+
+// ---------------- ir_speculation_batch_t ----------------
+// Speculations for the jobs at the end of a job list
+// The speculation for job 'base + i' is 'speculations[i]',
+// and only the first 'remaining' of them haven't been taken yet
+typedef struct {
+    ir_speculation_t *speculations;
+    length_t base;
+    length_t remaining;
+    length_t size;
+    length_t func_map_length;   // Number of keys in 'func_map' when the batch was made
+    length_t method_map_length; // Number of keys in 'method_map' when the batch was made
+} ir_speculation_batch_t;
+
+// Minimum number of jobs each worker should get for speculating to be worthwhile
+#define IR_SPECULATION_MIN_JOBS_PER_WORKER 32
+
+// ---------------- ir_speculation_give_up ----------------
+// Marks a speculation as unusable, because generating the body
+// requires changes to the module that can't be made speculatively.
+// Returns whether there was a speculation to give up on
+// Usage: `if(ir_speculation_give_up(object->ir_module.speculation)) return FAILURE;`
+bool ir_speculation_give_up(ir_speculation_t *speculation);
+
+// ---------------- ir_speculation_record_lookup ----------------
+// Records the result of looking up 'key' in a procedure map
+// Does nothing if 'speculation' is NULL
+void ir_speculation_record_lookup(ir_speculation_t *speculation, bool is_method, const void *key, ir_func_endpoint_list_t *endpoint_list);
+
+// ---------------- ir_speculation_record_func_traits ----------------
+// Records traits to add to an existing IR function once committed
+void ir_speculation_record_func_traits(ir_speculation_t *speculation, func_id_t ir_func_id, trait_t traits);
+
+// ---------------- ir_speculation_record_anon_global ----------------
+// Records a reference to an anonymous global created by a speculation
+void ir_speculation_record_anon_global(ir_speculation_t *speculation, ir_value_anon_global_t *anon_global);
+
+// ---------------- ir_speculation_batch_run ----------------
+// Speculatively generates the bodies of the next batch of jobs
+// at the end of the job list of 'object' on multiple threads.
+// Each batch is twice as large as the previous one.
+// Returns false if speculating isn't worthwhile, in which case no batch is made
+// NOTE: The job list itself is left unchanged
+bool ir_speculation_batch_run(ir_speculation_batch_t *batch, compiler_t *compiler, object_t *object);
+
+// ---------------- ir_speculation_batch_take ----------------
+// Takes the speculation for the job at 'index' of the job list,
+// returns NULL if there isn't one
+// NOTE: Jobs must be taken from last to first
+ir_speculation_t *ir_speculation_batch_take(ir_speculation_batch_t *batch, length_t index);
+
+// ---------------- ir_speculation_commit ----------------
+// Commits a speculation taken from a batch if it can still be used,
+// otherwise it's discarded so that the job can be generated normally
+// Returns whether the speculation was committed
+bool ir_speculation_commit(ir_speculation_batch_t *batch, ir_speculation_t *speculation, compiler_t *compiler, object_t *object);
+
+// ---------------- ir_speculation_batch_free ----------------
+// Frees a batch of speculations, discarding those that weren't taken
+void ir_speculation_batch_free(ir_speculation_batch_t *batch, ir_module_t *module);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_IR_SPECULATION_H
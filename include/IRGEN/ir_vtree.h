@@ -12,6 +12,8 @@ extern "C" {
     ----------------------------------------------------------------------------
 */
 
+#include <stdbool.h>
+
 #include "AST/ast_type_lean.h"
 #include "IR/ir_func_endpoint.h"
 #include "IR/ir_value.h"
@@ -65,6 +67,16 @@ vtree_t *vtree_list_find_or_append(vtree_list_t *vtree_list, const ast_type_t *s
 // Finds a vtree in a vtree list that has the given signature
 vtree_t *vtree_list_find(vtree_list_t *vtree_list, const ast_type_t *signature);
 
+// ---------------- vtree_list_find_virtual ----------------
+// Finds the vtree that introduces a virtual method, along with the vtable index of that method
+// Returns NULL if no vtree introduces the virtual method
+vtree_t *vtree_list_find_virtual(vtree_list_t *vtree_list, func_id_t virtual_ast_func_id, length_t *out_index);
+
+// ---------------- vtree_sole_target ----------------
+// Determines whether a vtree and all of its descendants share the same implementation for a vtable entry.
+// If they do, returns true and writes the IR function ID of that implementation to 'out_ir_func_id'
+bool vtree_sole_target(vtree_t *vtree, length_t index, func_id_t *out_ir_func_id);
+
 // ---------------- vtree_print ----------------
 // Prints a vtree
 void vtree_print(vtree_t *root, length_t indentation);
@@ -104,6 +104,12 @@ maybe_null_weak_cstr_t parse_eat_word(parse_ctx_t *ctx, const char *error);
 // (NOTE: error can be NULL to indicate no error should be printed)
 maybe_null_weak_cstr_t parse_eat_string(parse_ctx_t *ctx, const char *error);
 
+// ------------------ parse_eat_likelihood ------------------
+// Eats an optional 'likely' or 'unlikely' hint at the current
+// token index. Returns TROOLEAN_TRUE for 'likely', TROOLEAN_FALSE
+// for 'unlikely', and TROOLEAN_UNKNOWN if no hint is present
+troolean parse_eat_likelihood(parse_ctx_t *ctx);
+
 // ==================================================
 //                   PARSE_TAKE_*
 //  Same as parse_eat_* except ownership is taken
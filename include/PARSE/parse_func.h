@@ -33,6 +33,11 @@ errorcode_t parse_func_head(parse_ctx_t *ctx, ast_func_head_t *out_head, ast_fun
 // Parses the body of a function
 errorcode_t parse_func_body(parse_ctx_t *ctx, ast_func_t *func);
 
+// ------------------ parse_func_body_on_demand ------------------
+// Parses the body of a function whose parsing was deferred,
+// does nothing if the function body is already parsed
+errorcode_t parse_func_body_on_demand(compiler_t *compiler, object_t *object, ast_func_t *func);
+
 // ------------------ parse_func_arguments ------------------
 // Parses the arguments that a function takes
 errorcode_t parse_func_arguments(parse_ctx_t *ctx, ast_func_t *func);
@@ -54,8 +59,13 @@ void parse_func_backfill_arguments(ast_func_t *func, length_t *backfill);
 void parse_func_grow_arguments(ast_func_t *func, length_t backfill, length_t *capacity);
 
 // ------------------ parse_func_prefixes ------------------
-// Handles 'stdcall', 'verbatim', 'implicit', and 'external' descriptive keywords in function head
-void parse_func_prefixes(parse_ctx_t *ctx, ast_func_prefixes_t *out_prefixes);
+// Handles 'stdcall', 'verbatim', 'implicit', and 'external' descriptive keywords in function head,
+// as well as the 'inline', 'noinline', 'hot', 'cold', 'flatten' and 'optimize <level>' performance keywords
+errorcode_t parse_func_prefixes(parse_ctx_t *ctx, ast_func_prefixes_t *out_prefixes);
+
+// ------------------ parse_func_is_prefix ------------------
+// Returns whether a token is a keyword that can prefix a function
+bool parse_func_is_prefix(tokenid_t id);
 
 // ------------------ parse_free_unbackfilled_arguments ------------------
 // Frees function arguments that never got backfilled
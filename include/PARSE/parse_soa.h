@@ -0,0 +1,21 @@
+
+#ifndef _ISAAC_PARSE_SOA_H
+#define _ISAAC_PARSE_SOA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "UTIL/ground.h"
+#include "PARSE/parse_ctx.h"
+
+// ---------------- parse_soa ----------------
+// Parses a structure-of-arrays container declaration
+// (e.g. 'soa Particles = 1024 Particle')
+errorcode_t parse_soa(parse_ctx_t *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_PARSE_SOA_H
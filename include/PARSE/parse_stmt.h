@@ -21,6 +21,8 @@ struct defer_scope;
 #define BREAKABLE       TRAIT_1
 #define CONTINUABLE     TRAIT_2
 #define FALLTHROUGHABLE TRAIT_3
+#define PARALLEL_LOOP   TRAIT_4 // Marks that the next 'each in' or 'repeat' loop is parallel
+#define PARALLEL_BODY   TRAIT_5 // Body of a parallel loop, which cannot be escaped
 
 typedef struct defer_scope {
     ast_expr_list_t list;
@@ -55,6 +57,11 @@ void defer_scope_fulfill_by_cloning(defer_scope_t *defer_scope, ast_expr_list_t
 // normally be skipped over by 'break' or 'continue'
 void defer_scope_rewind(defer_scope_t *defer_scope, ast_expr_list_t *stmt_list, trait_t scope_trait, weak_cstr_t label);
 
+// ------------------ defer_scope_escapes_parallel ------------------
+// Returns whether jumping to the nearest scope with the trait 'scope_trait' (and label 'label' if given)
+// would escape the body of a parallel loop. Use TRAIT_NONE for jumps that leave the function entirely
+bool defer_scope_escapes_parallel(defer_scope_t *defer_scope, trait_t scope_trait, weak_cstr_t label);
+
 // ------------------ defer_scope_unwind_completely ------------------
 // Pure function that returns a new AST expression list of a defer scope and its ancestors unwound
 ast_expr_list_t defer_scope_unwind_completely(defer_scope_t *defer_scope);
@@ -99,10 +106,25 @@ errorcode_t parse_onetime_conditional(parse_ctx_t *ctx, ast_expr_list_t *stmt_li
 // Parses a conditionless block
 errorcode_t parse_conditionless_block(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scope_t *defer_scope);
 
+// ------------------ parse_parallel ------------------
+// Parses a parallel 'each in' or 'repeat' loop
+// e.g.  parallel repeat 1000 { ... }
+//       parallel reduce(+ sum, max highest) each int in [values, count] { ... }
+errorcode_t parse_parallel(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scope_t *defer_scope);
+
 // ------------------ parse_assert ------------------
 // Parses an assert statement
 errorcode_t parse_assert(parse_ctx_t *ctx, ast_expr_list_t *stmt_list);
 
+// ------------------ parse_assume ------------------
+// Parses an assume statement
+errorcode_t parse_assume(parse_ctx_t *ctx, ast_expr_list_t *stmt_list);
+
+// ------------------ parse_yield ------------------
+// Parses a yield statement
+// e.g.  yield value    or    yield
+errorcode_t parse_yield(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scope_t *defer_scope);
+
 // ------------------ parse_mutable_expr_operation ------------------
 // Parses a statement that begins with a mutable expression
 // e.g.  variable = value     or    my_array[index].doSomething()
@@ -14,6 +14,7 @@ extern "C" {
 #include "LEX/token.h"
 #include "PARSE/parse_ctx.h"
 #include "UTIL/ground.h"
+#include "UTIL/trait.h"
 
 // ------------------ parse_generics ------------------
 // Parses a list of generics
@@ -22,8 +23,15 @@ errorcode_t parse_generics(parse_ctx_t *ctx, strong_cstr_t **out_generics, lengt
 
 // ------------------ parse_composite ------------------
 // Parses a composite
+// Composites with an 'align(N)' prefix are unions if 'union' follows the prefix
 errorcode_t parse_composite(parse_ctx_t *ctx, bool is_union);
 
+// ------------------ parse_compact ------------------
+// Parses a 'compact' or 'compact(force)' prefix of a composite
+// Fields of compact structs are physically reordered to minimize padding
+// NOTE: Only 'struct' and 'record' may follow the prefix
+errorcode_t parse_compact(parse_ctx_t *ctx, trait_t *out_traits);
+
 // ------------------ parse_composite_domain ------------------
 // Parses constructs after the fields of a composite definition
 errorcode_t parse_composite_domain(parse_ctx_t *ctx, ast_composite_t *composite);
@@ -25,6 +25,12 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type);
 // type-element form. Primary called from 'parse_type'.
 errorcode_t parse_type_func(parse_ctx_t *ctx, ast_elem_func_t *out_func_elem);
 
+// ------------------ parse_alignment ------------------
+// Parses an 'align(N)' alignment specifier
+// NOTE: Assumes the current token is the 'align' keyword
+// NOTE: The resulting alignment is always a power of two
+errorcode_t parse_alignment(parse_ctx_t *ctx, length_t *out_alignment);
+
 // ------------------ parse_can_type_start_with ------------------
 // Returns whether an AST type can start with a token
 // Won't consider '[' token unless 'allow_open_bracket' is specified as true
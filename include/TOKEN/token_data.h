@@ -4,7 +4,7 @@
 #ifndef _ISAAC_TOKEN_DATA_H
 #define _ISAAC_TOKEN_DATA_H
 
-#define TOKEN_ITERATION_VERSION 0x63FCD5C0
+#define TOKEN_ITERATION_VERSION 0x6AD4BAEE
 
 #define TOKEN_NONE                  0x00000000
 #define TOKEN_WORD                  0x00000001
@@ -83,80 +83,95 @@
 #define TOKEN_POLYCOUNT             0x0000004A
 #define TOKEN_POD                   0x0000004B
 #define TOKEN_ALIAS                 0x0000004C
-#define TOKEN_ALIGNOF               0x0000004D
-#define TOKEN_AND                   0x0000004E
-#define TOKEN_AS                    0x0000004F
-#define TOKEN_ASSERT                0x00000050
-#define TOKEN_AT                    0x00000051
-#define TOKEN_BREAK                 0x00000052
-#define TOKEN_CASE                  0x00000053
-#define TOKEN_CAST                  0x00000054
-#define TOKEN_CLASS                 0x00000055
-#define TOKEN_CONST                 0x00000056
-#define TOKEN_CONSTRUCTOR           0x00000057
-#define TOKEN_CONTINUE              0x00000058
-#define TOKEN_DEF                   0x00000059
-#define TOKEN_DEFAULT               0x0000005A
-#define TOKEN_DEFER                 0x0000005B
-#define TOKEN_DEFINE                0x0000005C
-#define TOKEN_DELETE                0x0000005D
-#define TOKEN_EACH                  0x0000005E
-#define TOKEN_ELSE                  0x0000005F
-#define TOKEN_EMBED                 0x00000060
-#define TOKEN_ENUM                  0x00000061
-#define TOKEN_EXHAUSTIVE            0x00000062
-#define TOKEN_EXTENDS               0x00000063
-#define TOKEN_EXTERNAL              0x00000064
-#define TOKEN_FALLTHROUGH           0x00000065
-#define TOKEN_FALSE                 0x00000066
-#define TOKEN_FOR                   0x00000067
-#define TOKEN_FOREIGN               0x00000068
-#define TOKEN_FUNC                  0x00000069
-#define TOKEN_FUNCPTR               0x0000006A
-#define TOKEN_GLOBAL                0x0000006B
-#define TOKEN_IF                    0x0000006C
-#define TOKEN_IMPLICIT              0x0000006D
-#define TOKEN_IMPORT                0x0000006E
-#define TOKEN_IN                    0x0000006F
-#define TOKEN_INOUT                 0x00000070
-#define TOKEN_LLVM_ASM              0x00000071
-#define TOKEN_NAMESPACE             0x00000072
-#define TOKEN_NEW                   0x00000073
-#define TOKEN_NULL                  0x00000074
-#define TOKEN_OR                    0x00000075
-#define TOKEN_OUT                   0x00000076
-#define TOKEN_OVERRIDE              0x00000077
-#define TOKEN_PACKED                0x00000078
-#define TOKEN_PRAGMA                0x00000079
-#define TOKEN_PRIVATE               0x0000007A
-#define TOKEN_PUBLIC                0x0000007B
-#define TOKEN_RECORD                0x0000007C
-#define TOKEN_REPEAT                0x0000007D
-#define TOKEN_RETURN                0x0000007E
-#define TOKEN_SIZEOF                0x0000007F
-#define TOKEN_STATIC                0x00000080
-#define TOKEN_STDCALL               0x00000081
-#define TOKEN_STRUCT                0x00000082
-#define TOKEN_SWITCH                0x00000083
-#define TOKEN_THREAD_LOCAL          0x00000084
-#define TOKEN_TRUE                  0x00000085
-#define TOKEN_TYPEINFO              0x00000086
-#define TOKEN_TYPENAMEOF            0x00000087
-#define TOKEN_UNDEF                 0x00000088
-#define TOKEN_UNION                 0x00000089
-#define TOKEN_UNLESS                0x0000008A
-#define TOKEN_UNTIL                 0x0000008B
-#define TOKEN_USING                 0x0000008C
-#define TOKEN_VA_ARG                0x0000008D
-#define TOKEN_VA_COPY               0x0000008E
-#define TOKEN_VA_END                0x0000008F
-#define TOKEN_VA_START              0x00000090
-#define TOKEN_VERBATIM              0x00000091
-#define TOKEN_VIRTUAL               0x00000092
-#define TOKEN_WHILE                 0x00000093
+#define TOKEN_ALIGN                 0x0000004D
+#define TOKEN_ALIGNOF               0x0000004E
+#define TOKEN_AND                   0x0000004F
+#define TOKEN_AS                    0x00000050
+#define TOKEN_ASSERT                0x00000051
+#define TOKEN_ASSUME                0x00000052
+#define TOKEN_AT                    0x00000053
+#define TOKEN_BREAK                 0x00000054
+#define TOKEN_CASE                  0x00000055
+#define TOKEN_CAST                  0x00000056
+#define TOKEN_CLASS                 0x00000057
+#define TOKEN_COLD                  0x00000058
+#define TOKEN_COMPACT               0x00000059
+#define TOKEN_CONST                 0x0000005A
+#define TOKEN_CONSTRUCTOR           0x0000005B
+#define TOKEN_CONTINUE              0x0000005C
+#define TOKEN_DEF                   0x0000005D
+#define TOKEN_DEFAULT               0x0000005E
+#define TOKEN_DEFER                 0x0000005F
+#define TOKEN_DEFINE                0x00000060
+#define TOKEN_DELETE                0x00000061
+#define TOKEN_EACH                  0x00000062
+#define TOKEN_ELSE                  0x00000063
+#define TOKEN_EMBED                 0x00000064
+#define TOKEN_ENUM                  0x00000065
+#define TOKEN_EXHAUSTIVE            0x00000066
+#define TOKEN_EXTENDS               0x00000067
+#define TOKEN_EXTERNAL              0x00000068
+#define TOKEN_FALLTHROUGH           0x00000069
+#define TOKEN_FALSE                 0x0000006A
+#define TOKEN_FLATTEN               0x0000006B
+#define TOKEN_FOR                   0x0000006C
+#define TOKEN_FOREIGN               0x0000006D
+#define TOKEN_FUNC                  0x0000006E
+#define TOKEN_FUNCPTR               0x0000006F
+#define TOKEN_GENERATOR             0x00000070
+#define TOKEN_GLOBAL                0x00000071
+#define TOKEN_HOT                   0x00000072
+#define TOKEN_IF                    0x00000073
+#define TOKEN_IMPLICIT              0x00000074
+#define TOKEN_IMPORT                0x00000075
+#define TOKEN_IN                    0x00000076
+#define TOKEN_INLINE                0x00000077
+#define TOKEN_INOUT                 0x00000078
+#define TOKEN_LIKELY                0x00000079
+#define TOKEN_LLVM_ASM              0x0000007A
+#define TOKEN_NAMESPACE             0x0000007B
+#define TOKEN_NEW                   0x0000007C
+#define TOKEN_NOINLINE              0x0000007D
+#define TOKEN_NULL                  0x0000007E
+#define TOKEN_OPTIMIZE              0x0000007F
+#define TOKEN_OR                    0x00000080
+#define TOKEN_OUT                   0x00000081
+#define TOKEN_OVERRIDE              0x00000082
+#define TOKEN_PACKED                0x00000083
+#define TOKEN_PARALLEL              0x00000084
+#define TOKEN_PRAGMA                0x00000085
+#define TOKEN_PRIVATE               0x00000086
+#define TOKEN_PUBLIC                0x00000087
+#define TOKEN_RECORD                0x00000088
+#define TOKEN_REPEAT                0x00000089
+#define TOKEN_RETURN                0x0000008A
+#define TOKEN_SIZEOF                0x0000008B
+#define TOKEN_SOA                   0x0000008C
+#define TOKEN_STATIC                0x0000008D
+#define TOKEN_STDCALL               0x0000008E
+#define TOKEN_STRUCT                0x0000008F
+#define TOKEN_SWITCH                0x00000090
+#define TOKEN_THREAD_LOCAL          0x00000091
+#define TOKEN_TRUE                  0x00000092
+#define TOKEN_TYPEINFO              0x00000093
+#define TOKEN_TYPENAMEOF            0x00000094
+#define TOKEN_UNDEF                 0x00000095
+#define TOKEN_UNION                 0x00000096
+#define TOKEN_UNLESS                0x00000097
+#define TOKEN_UNLIKELY              0x00000098
+#define TOKEN_UNTIL                 0x00000099
+#define TOKEN_USING                 0x0000009A
+#define TOKEN_VA_ARG                0x0000009B
+#define TOKEN_VA_COPY               0x0000009C
+#define TOKEN_VA_END                0x0000009D
+#define TOKEN_VA_START              0x0000009E
+#define TOKEN_VERBATIM              0x0000009F
+#define TOKEN_VIRTUAL               0x000000A0
+#define TOKEN_WHILE                 0x000000A1
+#define TOKEN_YIELD                 0x000000A2
 #define TOKEN_BIT_AND               0x00000021
 
-#define MAX_LEX_TOKEN 0x00000093
+#define MAX_LEX_TOKEN 0x000000A2
 #define BEGINNING_OF_KEYWORD_TOKENS 0x0000004B
 
 #define TOKEN_EXTRA_DATA_FORMAT_ID_ONLY    0x00000061
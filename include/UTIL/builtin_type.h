@@ -30,6 +30,17 @@ extern const char * const global_primitives_extended[15];
 
 #define typename_is_extended_builtin_type(base) (binary_string_search_const(global_primitives_extended, 15, base) != -1)
 
+// ---------------- global_vector_types ----------------
+// Names of the builtin SIMD vector types (sorted), along with the
+// name of the element type and the number of lanes for each of them
+// The type of the mask produced by comparing two vectors is named
+// the same, except that it starts with 'i' (e.g. 'f32x4' -> 'i32x4')
+extern const char * const global_vector_types[20];
+extern const char * const global_vector_type_elements[20];
+extern const length_t global_vector_type_lanes[20];
+
+#define typename_vector_type(base) binary_string_search_const(global_vector_types, 20, base)
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,57 @@
+
+#ifndef _ISAAC_CHUNKED_LIST_H
+#define _ISAAC_CHUNKED_LIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================== chunked_list.h ==============================
+    Module for abstract lists whose items never move once appended
+    ----------------------------------------------------------------------------
+*/
+
+#include "UTIL/ground.h"
+
+// Number of items stored in each chunk of a chunked list (must be a power of two)
+#define CHUNKED_LIST_CHUNK_LENGTH 64
+
+// ---------------- chunkedof ----------------
+// Generic chunked list struct
+// Items are stored in fixed-size chunks that are never reallocated,
+// so pointers to items stay valid while the list grows
+// Usage:
+// > typedef chunkedof(ItemType) ItemTypeChunkedList;
+#define chunkedof(TYPE) struct { TYPE **chunks; length_t length; length_t chunks_length; length_t chunks_capacity; }
+
+// ---------------- void_chunked_list_t ----------------
+// A chunked list of unknown items
+typedef chunkedof(void) void_chunked_list_t;
+
+// ---------------- chunked_list_at ----------------
+// Returns a pointer to the item at an index of a chunked list
+// NOTE: 'INDEX' is evaluated more than once
+#define chunked_list_at(LIST, INDEX) (&(LIST)->chunks[(INDEX) / CHUNKED_LIST_CHUNK_LENGTH][(INDEX) % CHUNKED_LIST_CHUNK_LENGTH])
+
+// ---------------- chunked_list_append ----------------
+// Appends an item to a chunked list
+#define chunked_list_append(LIST, VALUE, ELEMENT_TYPE) *chunked_list_append_new((LIST), ELEMENT_TYPE) = VALUE
+
+// ---------------- chunked_list_append_new ----------------
+// Returns a pointer to a new item
+#define chunked_list_append_new(LIST, ELEMENT_TYPE) ((ELEMENT_TYPE*) chunked_list_append_new_impl((LIST), sizeof(ELEMENT_TYPE)))
+
+// ---------------- chunked_list_append_new_impl ----------------
+// Returns a pointer to a new item
+void *chunked_list_append_new_impl(void *list_struct, length_t sizeof_element);
+
+// ---------------- chunked_list_free ----------------
+// Frees the storage of a chunked list (but not the items it contains)
+void chunked_list_free(void *list_struct);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_CHUNKED_LIST_H
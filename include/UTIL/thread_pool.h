@@ -0,0 +1,48 @@
+
+#ifndef _ISAAC_THREAD_POOL_H
+#define _ISAAC_THREAD_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    =============================== thread_pool.h ==============================
+    Module for running independent tasks across multiple threads
+    ----------------------------------------------------------------------------
+*/
+
+#include "UTIL/ground.h"
+
+// ---------------- thread_pool_task_t ----------------
+// Task that is run once for each index of a job
+// 'worker' is the ID of the worker running it, which is less than the
+// number of workers used for the job (the calling thread is always worker 0)
+typedef void (*thread_pool_task_t)(void *data, length_t worker, length_t index);
+
+// ---------------- thread_pool_worker_count ----------------
+// Returns how many workers should be used for a job with 'count' tasks,
+// so that each worker gets at least 'min_tasks_per_worker' tasks
+// Returns 1 when the job isn't worth running in parallel
+length_t thread_pool_worker_count(length_t count, length_t min_tasks_per_worker);
+
+// ---------------- thread_pool_force_worker_count ----------------
+// Makes every job with at least 'worker_count' tasks use exactly that many workers,
+// regardless of the hardware and of how many tasks each worker would get,
+// so that parallel code paths can be tested on any machine
+// Passing 0 restores the default behavior
+void thread_pool_force_worker_count(length_t worker_count);
+
+// ---------------- thread_pool_run ----------------
+// Runs a task for every index in [0, count) using 'worker_count' workers
+// and waits for all of them to finish. Each worker starts out with an even
+// share of the indices, and steals half of the remaining indices of another
+// worker once it runs out. No guarantees are made about which worker runs
+// which index or in what order
+void thread_pool_run(length_t count, length_t worker_count, thread_pool_task_t task, void *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ISAAC_THREAD_POOL_H
@@ -123,6 +123,11 @@ static void ast_expr_return_free(ast_expr_return_t *expr){
     ast_expr_list_free(&expr->last_minute);
 }
 
+static void ast_expr_yield_free(ast_expr_yield_t *expr){
+    ast_expr_free_fully(expr->value);
+    ast_expr_list_free(&expr->last_minute);
+}
+
 static void ast_expr_declare_free(ast_expr_declare_t *expr){
     ast_type_free(&expr->type);
     ast_expr_free_fully(expr->value);
@@ -155,11 +160,13 @@ static void ast_expr_each_in_free(ast_expr_each_in_t *expr){
     ast_expr_free_fully(expr->length);
     ast_expr_free_fully(expr->list);
     ast_expr_list_free(&expr->statements);
+    ast_parallel_free(&expr->parallel);
 }
 
 static void ast_expr_repeat_free(ast_expr_repeat_t *expr){
     ast_expr_free_fully(expr->limit);
     ast_expr_list_free(&expr->statements);
+    ast_parallel_free(&expr->parallel);
 }
 
 static void ast_expr_switch_free(ast_expr_switch_t *expr){
@@ -272,6 +279,7 @@ void ast_expr_free(ast_expr_t *expr){
     case EXPR_TOGGLE:
     case EXPR_VA_START:
     case EXPR_VA_END:
+    case EXPR_ASSUME:
         ast_expr_unary_free((ast_expr_unary_t*) expr);
         break;
     case EXPR_FUNC_ADDR:
@@ -290,6 +298,9 @@ void ast_expr_free(ast_expr_t *expr){
     case EXPR_RETURN:
         ast_expr_return_free((ast_expr_return_t*) expr);
         break;
+    case EXPR_YIELD:
+        ast_expr_yield_free((ast_expr_yield_t*) expr);
+        break;
     case EXPR_DECLARE:
     case EXPR_ILDECLARE:
     case EXPR_DECLAREUNDEF:
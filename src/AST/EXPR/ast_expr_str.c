@@ -242,7 +242,7 @@ static strong_cstr_t ast_expr_ternary_to_str(ast_expr_ternary_t *ternary_expr){
     strong_cstr_t true_str      = ast_expr_str(ternary_expr->if_true);
     strong_cstr_t false_str     = ast_expr_str(ternary_expr->if_false);
 
-    strong_cstr_t result = mallocandsprintf("(%s ? %s : %s)", condition_str, true_str, false_str);
+    strong_cstr_t result = mallocandsprintf("(%s ? %s%s : %s)", condition_str, ast_likelihood_str(ternary_expr->likely), true_str, false_str);
 
     free(condition_str);
     free(true_str);
@@ -135,6 +135,18 @@ errorcode_t ast_resolve_expr_polymorphs(compiler_t *compiler, rtti_collector_t *
             }
         }
         break;
+    case EXPR_YIELD: {
+            ast_expr_yield_t *yield_stmt = (ast_expr_yield_t*) expr;
+
+            if(yield_stmt->value != NULL && ast_resolve_expr_polymorphs(compiler, rtti_collector, catalog, yield_stmt->value)){
+                return FAILURE;
+            }
+
+            if(ast_resolve_expr_list_polymorphs(compiler, rtti_collector, catalog, &yield_stmt->last_minute)){
+                return FAILURE;
+            }
+        }
+        break;
     case EXPR_CALL: {
             ast_expr_call_t *call_stmt = (ast_expr_call_t*) expr;
             if(ast_resolve_exprs_polymorphs(compiler, rtti_collector, catalog, call_stmt->args, call_stmt->arity)) return FAILURE;
@@ -199,7 +211,7 @@ errorcode_t ast_resolve_expr_polymorphs(compiler_t *compiler, rtti_collector_t *
             }
         }
         break;
-    case EXPR_DELETE: {
+    case EXPR_ASSUME: case EXPR_DELETE: {
             ast_expr_unary_t *delete_stmt = (ast_expr_unary_t*) expr;
             if(ast_resolve_expr_polymorphs(compiler, rtti_collector, catalog, delete_stmt->value)) return FAILURE;
         }
@@ -20,9 +20,7 @@
 #endif
 
 void ast_init(ast_t *ast, unsigned int cross_compile_for){
-    ast->funcs = malloc(sizeof(ast_func_t) * 8);
-    ast->funcs_length = 0;
-    ast->funcs_capacity = 8;
+    ast->funcs = (ast_funcs_t){0};
     ast->func_aliases = NULL;
     ast->func_aliases_length = 0;
     ast->func_aliases_capacity = 0;
@@ -39,6 +37,9 @@ void ast_init(ast_t *ast, unsigned int cross_compile_for){
     ast->enums = NULL;
     ast->enums_length = 0;
     ast->enums_capacity = 0;
+    ast->soas = NULL;
+    ast->soas_length = 0;
+    ast->soas_capacity = 0;
     ast->libraries = NULL;
     ast->library_kinds = NULL;
     ast->libraries_length = 0;
@@ -169,7 +170,8 @@ void ast_init(ast_t *ast, unsigned int cross_compile_for){
 
 void ast_free(ast_t *ast){
     ast_free_enums(ast->enums, ast->enums_length);
-    ast_free_functions(ast->funcs, ast->funcs_length);
+    ast_free_soas(ast->soas, ast->soas_length);
+    ast_free_functions(&ast->funcs);
     ast_free_function_aliases(ast->func_aliases, ast->func_aliases_length);
     ast_free_composites(ast->composites, ast->composites_length);
     ast_free_globals(ast->globals, ast->globals_length);
@@ -181,7 +183,8 @@ void ast_free(ast_t *ast){
     }
 
     free(ast->enums);
-    free(ast->funcs);
+    free(ast->soas);
+    chunked_list_free(&ast->funcs);
     free(ast->func_aliases);
     free(ast->composites);
     free(ast->globals);
@@ -212,9 +215,9 @@ void ast_free(ast_t *ast){
     free(ast->poly_composites);
 }
 
-void ast_free_functions(ast_func_t *functions, length_t functions_length){
-    for(length_t i = 0; i != functions_length; i++){
-        ast_func_t *func = &functions[i];
+void ast_free_functions(ast_funcs_t *functions){
+    for(length_t i = 0; i != functions->length; i++){
+        ast_func_t *func = ast_funcs_at(functions, i);
         free(func->name);
 
         if(func->arg_names){
@@ -232,6 +235,7 @@ void ast_free_functions(ast_func_t *functions, length_t functions_length){
         free(func->variadic_arg_name);
         ast_expr_list_free(&func->statements);
         ast_type_free(&func->return_type);
+        ast_type_free(&func->yield_type);
         free(func->export_as);
     }
 }
@@ -280,6 +284,15 @@ void ast_free_enums(ast_enum_t *enums, length_t enums_length){
     }
 }
 
+void ast_free_soas(ast_soa_t *soas, length_t soas_length){
+    for(length_t i = 0; i != soas_length; i++){
+        ast_soa_t *soa = &soas[i];
+        free(soa->name);
+        ast_type_free(&soa->type);
+        ast_type_free(&soa->element_type);
+    }
+}
+
 strong_cstr_t ast_func_args_str(ast_func_t *func){
     string_builder_t builder;
     string_builder_init(&builder);
@@ -322,7 +335,7 @@ strong_cstr_t ast_func_args_str(ast_func_t *func){
 
 strong_cstr_t ast_func_head_str(ast_func_t *func){
     strong_cstr_t args_string = ast_func_args_str(func);
-    strong_cstr_t return_type_string = ast_type_str(&func->return_type);
+    strong_cstr_t return_type_string = ast_type_str(ast_func_is_generator(func) ? &func->yield_type : &func->return_type);
     weak_cstr_t no_discard = func->traits & AST_FUNC_NO_DISCARD ? " exhaustive" : "";
     weak_cstr_t disallow = func->traits & AST_FUNC_DISALLOW ? " = delete" : "";
 
@@ -334,7 +347,8 @@ strong_cstr_t ast_func_head_str(ast_func_t *func){
         weak_cstr_t maybe_dispatcher = func->traits & AST_FUNC_DISPATCHER ? "[[dispatcher]] " : "";
         weak_cstr_t maybe_virtual = func->traits & AST_FUNC_VIRTUAL ? "virtual " : "";
         weak_cstr_t maybe_override = func->traits & AST_FUNC_OVERRIDE ? "override " : "";
-        result = mallocandsprintf("%s%s%sfunc %s(%s)%s %s%s", maybe_dispatcher, maybe_virtual, maybe_override, func->name, args_string ? args_string : "", no_discard, return_type_string, disallow);
+        weak_cstr_t maybe_generator = ast_func_is_generator(func) ? "generator " : "";
+        result = mallocandsprintf("%s%s%s%sfunc %s(%s)%s %s%s", maybe_dispatcher, maybe_virtual, maybe_override, maybe_generator, func->name, args_string ? args_string : "", no_discard, return_type_string, disallow);
     }
 
     free(args_string);
@@ -342,6 +356,10 @@ strong_cstr_t ast_func_head_str(ast_func_t *func){
     return result;
 }
 
+bool ast_func_is_generator(ast_func_t *func){
+    return func->yield_type.elements_length != 0;
+}
+
 bool ast_func_is_method(ast_func_t *func){
     return func->arity > 0 && func->arg_names && streq(func->arg_names[0], "this") && !(func->traits & AST_FUNC_FOREIGN);
 }
@@ -362,8 +380,8 @@ maybe_null_weak_cstr_t ast_method_get_subject_typename(ast_func_t *method){
 }
 
 func_id_t ast_new_func(ast_t *ast){
-    expand((void**) &ast->funcs, sizeof(ast_func_t), ast->funcs_length, &ast->funcs_capacity, 1, 4);
-    return ast->funcs_length++;
+    chunked_list_append_new(&ast->funcs, ast_func_t);
+    return ast->funcs.length - 1;
 }
 
 void ast_func_create_template(compiler_t *compiler, ast_func_t *func, const ast_func_head_t *options){
@@ -379,6 +397,7 @@ void ast_func_create_template(compiler_t *compiler, ast_func_t *func, const ast_
     func->return_type.elements_length = 0;
     func->return_type.source = NULL_SOURCE;
     func->return_type.source.object_index = options->source.object_index;
+    func->yield_type = AST_TYPE_NONE;
     func->traits = TRAIT_NONE;
     func->variadic_arg_name = NULL;
     func->variadic_source = NULL_SOURCE;
@@ -388,6 +407,7 @@ void ast_func_create_template(compiler_t *compiler, ast_func_t *func, const ast_
     func->virtual_origin = INVALID_FUNC_ID;
     func->virtual_dispatcher = INVALID_FUNC_ID;
     func->instantiation_depth = 0;
+    func->unparsed_body_index = 0;
 
     #if ADEPT_INSIGHT_BUILD
     func->end_source = options->source;
@@ -400,6 +420,7 @@ void ast_func_create_template(compiler_t *compiler, ast_func_t *func, const ast_
     if(options->prefixes.is_implicit)     func->traits |= AST_FUNC_IMPLICIT;
     if(options->prefixes.is_virtual)      func->traits |= AST_FUNC_VIRTUAL;
     if(options->prefixes.is_override)     func->traits |= AST_FUNC_OVERRIDE;
+    func->traits |= options->prefixes.performance_traits;
     if(options->is_foreign)               func->traits |= AST_FUNC_FOREIGN;
 
     // Handle WinMain
@@ -414,7 +435,8 @@ void ast_func_create_template(compiler_t *compiler, ast_func_t *func, const ast_
 
 bool ast_func_has_polymorphic_signature(ast_func_t *func){
     return ast_type_list_has_polymorph(func->arg_types, func->arity)
-        || ast_type_has_polymorph(&func->return_type);
+        || ast_type_has_polymorph(&func->return_type)
+        || ast_type_has_polymorph(&func->yield_type);
 }
 
 void ast_alias_init(ast_alias_t *alias, weak_cstr_t name, ast_type_t type, strong_cstr_t *generics, length_t generics_length, trait_t traits, source_t source){
@@ -556,6 +578,24 @@ maybe_index_t ast_find_enum(ast_enum_t *enums, length_t enums_length, const char
     return -1;
 }
 
+maybe_index_t ast_find_soa(ast_soa_t *soas, length_t soas_length, const char *soa_name){
+    // If not found returns -1 else returns index inside array
+
+    maybe_index_t first, middle, last, comparison;
+    first = 0; last = soas_length - 1;
+
+    while(first <= last){
+        middle = (first + last) / 2;
+        comparison = strcmp(soas[middle].name, soa_name);
+
+        if(comparison == 0) return middle;
+        else if(comparison > 0) last = middle - 1;
+        else first = middle + 1;
+    }
+
+    return -1;
+}
+
 bool ast_enum_contains(ast_enum_t *ast_enum, const char *kind_name){
     for(size_t i = 0; i < ast_enum->length; i++){
         if(streq(ast_enum->kinds[i], kind_name)){
@@ -614,7 +654,7 @@ bool ast_func_end_is_reachable_inner(ast_expr_list_t *stmts, unsigned int max_de
 
 bool ast_func_end_is_reachable(ast_t *ast, func_id_t ast_func_id){
     // Ensure that the reference we're working with isn't one that was previously invalidated
-    return ast_func_end_is_reachable_inner(&ast->funcs[ast_func_id].statements, 20, 0);
+    return ast_func_end_is_reachable_inner(&ast_funcs_at(&ast->funcs, ast_func_id)->statements, 20, 0);
 }
 
 void ast_add_alias(ast_t *ast, strong_cstr_t name, ast_type_t strong_type, strong_cstr_t *generics, length_t generics_length, trait_t traits, source_t source){
@@ -629,6 +669,17 @@ void ast_add_enum(ast_t *ast, strong_cstr_t name, weak_cstr_t *kinds, length_t l
     ast_enum_init(&ast->enums[ast->enums_length++], name, kinds, length, source);
 }
 
+void ast_add_soa(ast_t *ast, strong_cstr_t name, ast_type_t strong_type, source_t source){
+    expand((void**) &ast->soas, sizeof(ast_soa_t), ast->soas_length, &ast->soas_capacity, 1, 4);
+
+    ast->soas[ast->soas_length++] = (ast_soa_t){
+        .name = name,
+        .type = strong_type,
+        .element_type = AST_TYPE_NONE,
+        .source = source,
+    };
+}
+
 void ast_add_global_named_expression(ast_t *ast, ast_named_expression_t named_expression){
     ast_named_expression_list_append(&ast->named_expressions, named_expression);
 }
@@ -696,7 +747,7 @@ ast_poly_composite_t *ast_add_poly_composite(
     return poly_composite;
 }
 
-void ast_add_global(ast_t *ast, strong_cstr_t name, ast_type_t type, ast_expr_t *initial_value, trait_t traits, source_t source){
+ast_global_t *ast_add_global(ast_t *ast, strong_cstr_t name, ast_type_t type, ast_expr_t *initial_value, trait_t traits, source_t source){
     expand((void**) &ast->globals, sizeof(ast_global_t), ast->globals_length, &ast->globals_capacity, 1, 8);
 
     ast_global_t *global = &ast->globals[ast->globals_length++];
@@ -708,7 +759,10 @@ void ast_add_global(ast_t *ast, strong_cstr_t name, ast_type_t type, ast_expr_t
         .initial = initial_value,
         .traits = traits,
         .source = source,
+        .alignment = 0,
     };
+
+    return global;
 }
 
 void ast_add_foreign_library(ast_t *ast, strong_cstr_t library, char kind){
@@ -780,6 +834,10 @@ int ast_enums_cmp(const void *a, const void *b){
     return strcmp(((ast_enum_t*) a)->name, ((ast_enum_t*) b)->name);
 }
 
+int ast_soas_cmp(const void *a, const void *b){
+    return strcmp(((ast_soa_t*) a)->name, ((ast_soa_t*) b)->name);
+}
+
 int ast_poly_funcs_cmp(const void *a, const void *b){
     const ast_poly_func_t *fa = (ast_poly_func_t*) a;
     const ast_poly_func_t *fb = (ast_poly_func_t*) b;
@@ -22,12 +22,23 @@ void ast_dump(ast_t *ast, const char *filename){
     ast_dump_enums(file, ast->enums, ast->enums_length);
     ast_dump_composites(file, ast->composites, ast->composites_length);
     ast_dump_globals(file, ast->globals, ast->globals_length);
-    ast_dump_funcs(file, ast->funcs, ast->funcs_length);
+    ast_dump_funcs(file, &ast->funcs);
     ast_dump_aliases(file, ast->aliases, ast->aliases_length);
+    ast_dump_soas(file, ast->soas, ast->soas_length);
     ast_dump_libraries(file, ast->libraries, ast->libraries_length);
     fclose(file);
 }
 
+static void ast_dump_stmt_yield(FILE *file, ast_expr_yield_t *stmt){
+    if(stmt->value != NULL){
+        strong_cstr_t s = ast_expr_str(stmt->value);
+        fprintf(file, "yield %s\n", s);
+        free(s);
+    } else {
+        fprintf(file, "yield\n");
+    }
+}
+
 static void ast_dump_stmt_return(FILE *file, ast_expr_return_t *stmt, length_t indentation){
     ast_expr_t *return_value = stmt->value;
     ast_expr_list_t last_minute = stmt->last_minute;
@@ -63,6 +74,8 @@ static void ast_dump_stmt_declare(FILE *file, ast_expr_declare_t *stmt){
     fprintf(file, "%s", type_str);
     free(type_str);
 
+    if(stmt->alignment != 0) fprintf(file, " align(%d)", (int) stmt->alignment);
+
     if(is_undef){
         fprintf(file, " = undef");
     } else if(stmt->value){
@@ -109,7 +122,7 @@ static void ast_dump_stmt_assert(FILE *file, ast_expr_assert_t *stmt){
 
 static void ast_dump_stmt_simple_conditional(FILE *file, ast_expr_conditional_t *stmt, const char *keyword, length_t indentation){
     strong_cstr_t s = ast_expr_str(stmt->value);
-    fprintf(file, "%s %s {\n", keyword, s);
+    fprintf(file, "%s %s%s {\n", keyword, ast_likelihood_str(stmt->likely), s);
     free(s);
 
     ast_dump_stmts_list(file, &stmt->statements, indentation + 1);
@@ -119,7 +132,7 @@ static void ast_dump_stmt_simple_conditional(FILE *file, ast_expr_conditional_t
 
 static void ast_dump_stmt_compound_conditional(FILE *file, ast_expr_conditional_else_t *stmt, const char *keyword, length_t indentation){
     strong_cstr_t s = ast_expr_str(stmt->value);
-    fprintf(file, "%s %s {\n", keyword, s);
+    fprintf(file, "%s %s%s {\n", keyword, ast_likelihood_str(stmt->likely), s);
     free(s);
 
     ast_dump_stmts_list(file, &stmt->statements, indentation + 1);
@@ -130,7 +143,37 @@ static void ast_dump_stmt_compound_conditional(FILE *file, ast_expr_conditional_
     fprintf(file, "}\n");
 }
 
+static void ast_dump_parallel(FILE *file, ast_parallel_t *parallel){
+    if(!parallel->is_parallel) return;
+
+    fprintf(file, "parallel ");
+
+    if(parallel->reductions_length == 0) return;
+
+    fprintf(file, "reduce(");
+
+    for(length_t i = 0; i != parallel->reductions_length; i++){
+        ast_reduction_t *reduction = &parallel->reductions[i];
+        const char *op;
+
+        switch(reduction->op){
+        case EXPR_ADD:     op = "+";   break;
+        case EXPR_BIT_AND: op = "&";   break;
+        case EXPR_BIT_OR:  op = "|";   break;
+        case EXPR_BIT_XOR: op = "^";   break;
+        case EXPR_LESSER:  op = "min"; break;
+        case EXPR_GREATER: op = "max"; break;
+        default:           op = "?";
+        }
+
+        fprintf(file, i == 0 ? "%s %s" : ", %s %s", op, reduction->name);
+    }
+
+    fprintf(file, ") ");
+}
+
 static void ast_dump_stmt_repeat(FILE *file, ast_expr_repeat_t *stmt, length_t indentation){
+    ast_dump_parallel(file, &stmt->parallel);
     fprintf(file, "repeat ");
 
     if(stmt->is_static){
@@ -158,6 +201,7 @@ static void ast_dump_stmt_unary(FILE *file, ast_expr_unary_t *stmt, const char *
 }
 
 static void ast_dump_stmt_each_in(FILE *file, ast_expr_each_in_t *stmt, length_t indentation){
+    ast_dump_parallel(file, &stmt->parallel);
     fprintf(file, "each ");
 
     if(stmt->it_name){
@@ -202,7 +246,7 @@ static void ast_dump_stmt_switch(FILE *file, ast_expr_switch_t *stmt, length_t i
         ast_case_t *single_case = &stmt->cases.cases[i];
 
         strong_cstr_t value = ast_expr_str(single_case->condition);
-        fprintf(file, "case (%s)\n", value);
+        fprintf(file, "case %s(%s)\n", ast_likelihood_str(single_case->likely), value);
         free(value);
 
         ast_dump_stmts_list(file, &single_case->statements, indentation + 1);
@@ -294,6 +338,12 @@ void ast_dump_stmts(FILE *file, ast_expr_t **statements, length_t length, length
         case EXPR_ASSERT:
             ast_dump_stmt_assert(file, (ast_expr_assert_t*) stmt);
             break;
+        case EXPR_ASSUME:
+            ast_dump_stmt_unary(file, (ast_expr_unary_t*) stmt, "assume");
+            break;
+        case EXPR_YIELD:
+            ast_dump_stmt_yield(file, (ast_expr_yield_t*) stmt);
+            break;
         case EXPR_IF:
             ast_dump_stmt_simple_conditional(file, (ast_expr_conditional_t*) stmt, "if", indentation);
             break;
@@ -381,6 +431,7 @@ static void ast_dump_composite_subfields(FILE *file, ast_layout_skeleton_t *skel
         ast_layout_endpoint_add_index(&endpoint, i);
 
         indent(file, indentation);
+        if(bone->alignment != 0 && bone->kind != AST_LAYOUT_BONE_KIND_TYPE) fprintf(file, "align(%d) ", (int) bone->alignment);
         if(bone->traits & AST_LAYOUT_BONE_PACKED) fprintf(file, "packed ");
 
         switch(bone->kind){
@@ -391,6 +442,8 @@ static void ast_dump_composite_subfields(FILE *file, ast_layout_skeleton_t *skel
                 strong_cstr_t s = ast_type_str(&bone->type);
                 fprintf(file, "%s %s", field_name, s);
                 free(s);
+
+                if(bone->alignment != 0) fprintf(file, " align(%d)", (int) bone->alignment);
             }
             break;
         case AST_LAYOUT_BONE_KIND_UNION:
@@ -424,6 +477,14 @@ void ast_dump_composite(FILE *file, ast_composite_t *composite, length_t additio
 
     indent(file, additional_indentation);
 
+    if(layout->alignment != 0){
+        fprintf(file, "align(%d) ", (int) layout->alignment);
+    }
+
+    if(layout->traits & AST_LAYOUT_COMPACT){
+        fprintf(file, (layout->traits & AST_LAYOUT_COMPACT_FORCED) ? "compact(force) " : "compact ");
+    }
+
     if(layout->traits & AST_LAYOUT_PACKED){
         fprintf(file, "packed ");
     }
@@ -474,11 +535,17 @@ void ast_dump_globals(FILE *file, ast_global_t *globals, length_t globals_length
         ast_global_t *global = &globals[i];
         strong_cstr_t type = ast_type_str(&global->type);
 
+        fprintf(file, "%s %s", global->name, type);
+
+        if(global->alignment != 0){
+            fprintf(file, " align(%d)", (int) global->alignment);
+        }
+
         if(global->initial == NULL){
-            fprintf(file, "%s %s\n", global->name, type);
+            fprintf(file, "\n");
         } else {
             strong_cstr_t value = ast_expr_str(global->initial);
-            fprintf(file, "%s %s = %s\n", global->name, type, value);
+            fprintf(file, " = %s\n", value);
             free(value);
         }
 
@@ -504,9 +571,9 @@ void ast_dump_enums(FILE *file, ast_enum_t *enums, length_t enums_length){
     }
 }
 
-void ast_dump_funcs(FILE *file, ast_func_t *functions, length_t functions_length){
-    for(length_t i = 0; i != functions_length; i++){
-        ast_func_t *func = &functions[i];
+void ast_dump_funcs(FILE *file, ast_funcs_t *functions){
+    for(length_t i = 0; i != functions->length; i++){
+        ast_func_t *func = ast_funcs_at(functions, i);
         
         strong_cstr_t args = ast_func_args_str(func);
         strong_cstr_t return_type = ast_type_str(&func->return_type);
@@ -514,9 +581,26 @@ void ast_dump_funcs(FILE *file, ast_func_t *functions, length_t functions_length
         if(func->traits & AST_FUNC_DISPATCHER) fprintf(file, "dispatcher ");
         if(func->traits & AST_FUNC_VIRTUAL)    fprintf(file, "virtual ");
         if(func->traits & AST_FUNC_OVERRIDE)   fprintf(file, "override ");
+        if(func->traits & AST_FUNC_ALWAYS_INLINE) fprintf(file, "inline ");
+        if(func->traits & AST_FUNC_NO_INLINE)     fprintf(file, "noinline ");
+        if(func->traits & AST_FUNC_HOT)           fprintf(file, "hot ");
+        if(func->traits & AST_FUNC_COLD)          fprintf(file, "cold ");
+        if(func->traits & AST_FUNC_FLATTEN)       fprintf(file, "flatten ");
+
+        switch(func->traits & AST_FUNC_OPTIMIZE_MASK){
+        case AST_FUNC_OPTIMIZE_NONE:       fprintf(file, "optimize none ");       break;
+        case AST_FUNC_OPTIMIZE_SIZE:       fprintf(file, "optimize size ");       break;
+        case AST_FUNC_OPTIMIZE_AGGRESSIVE: fprintf(file, "optimize aggressive "); break;
+        }
 
         if(func->traits & AST_FUNC_FOREIGN){
             fprintf(file, "foreign %s(%s) %s\n", func->name, args, return_type);
+        } else if(ast_func_is_generator(func)){
+            strong_cstr_t yield_type = ast_type_str(&func->yield_type);
+            fprintf(file, "generator func %s(%s) %s {\n", func->name, args, yield_type);
+            ast_dump_stmts_list(file, &func->statements, 1);
+            fprintf(file, "}\n");
+            free(yield_type);
         } else {
             fprintf(file, "func %s(%s) %s {\n", func->name, args, return_type);
             ast_dump_stmts_list(file, &func->statements, 1);
@@ -538,6 +622,16 @@ void ast_dump_aliases(FILE *file, ast_alias_t *aliases, length_t length){
     }
 }
 
+void ast_dump_soas(FILE *file, ast_soa_t *soas, length_t length){
+    for(length_t i = 0; i != length; i++){
+        ast_soa_t *soa = &soas[i];
+
+        strong_cstr_t type = ast_type_str(&soa->type);
+        fprintf(file, "soa %s = %s\n", soa->name, type);
+        free(type);
+    }
+}
+
 void ast_dump_libraries(FILE *file, strong_cstr_t *libraries, length_t length){
     for(length_t i = 0; i != length; i++){
         fprintf(file, "foreign '%s'\n", libraries[i]);
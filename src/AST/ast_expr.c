@@ -14,6 +14,14 @@
 #include "UTIL/trait.h"
 #include "UTIL/util.h"
 
+const char *ast_likelihood_str(troolean likely){
+    switch(likely){
+    case TROOLEAN_TRUE:  return "likely ";
+    case TROOLEAN_FALSE: return "unlikely ";
+    default:             return "";
+    }
+}
+
 bool expr_is_mutable(ast_expr_t *expr){
     switch(expr->id){
     case EXPR_VARIABLE:
@@ -181,7 +189,8 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
     case EXPR_POSTDECREMENT:
     case EXPR_TOGGLE:
     case EXPR_VA_START:
-    case EXPR_VA_END: {
+    case EXPR_VA_END:
+    case EXPR_ASSUME: {
             ast_expr_unary_t *original = (ast_expr_unary_t*) expr;
 
             return (ast_expr_t*) malloc_init(ast_expr_unary_t, {
@@ -313,6 +322,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
                 .condition = ast_expr_clone(original->condition),
                 .if_true = ast_expr_clone(original->if_true),
                 .if_false = ast_expr_clone(original->if_false),
+                .likely = original->likely,
             });
         }
     case EXPR_VA_ARG: {
@@ -382,6 +392,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
                 .value = ast_expr_clone_if_not_null(original->value),
                 .traits = original->traits,
                 .inputs = optional_ast_expr_list_clone(&original->inputs),
+                .alignment = original->alignment,
             });
         }
     case EXPR_ASSIGN:
@@ -417,6 +428,16 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
                 .last_minute = ast_expr_list_clone(&original->last_minute),
             });
         }
+    case EXPR_YIELD: {
+            ast_expr_yield_t *original = (ast_expr_yield_t*) expr;
+
+            return (ast_expr_t*) malloc_init(ast_expr_yield_t, {
+                .id = original->id,
+                .source = original->source,
+                .value = ast_expr_clone_if_not_null(original->value),
+                .last_minute = ast_expr_list_clone(&original->last_minute),
+            });
+        }
     case EXPR_IF:
     case EXPR_UNLESS:
     case EXPR_WHILE:
@@ -431,6 +452,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
                 .label = original->label,
                 .value = ast_expr_clone_if_not_null(original->value),
                 .statements = ast_expr_list_clone(&original->statements),
+                .likely = original->likely,
             });
         }
     case EXPR_IFELSE:
@@ -444,6 +466,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
                 .value = ast_expr_clone(original->value),
                 .statements = ast_expr_list_clone(&original->statements),
                 .else_statements = ast_expr_list_clone(&original->else_statements),
+                .likely = original->likely,
             });
         }
     case EXPR_EACH_IN: {
@@ -460,6 +483,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
                 .list = ast_expr_clone_if_not_null(original->list),
                 .statements = ast_expr_list_clone(&original->statements),
                 .is_static = original->is_static,
+                .parallel = ast_parallel_clone(&original->parallel),
             });
         }
     case EXPR_REPEAT: {
@@ -473,6 +497,7 @@ ast_expr_t *ast_expr_clone(ast_expr_t* expr){
                 .statements = ast_expr_list_clone(&original->statements),
                 .is_static = original->is_static,
                 .idx_name = original->idx_name,
+                .parallel = ast_parallel_clone(&original->parallel),
             });
         }
     case EXPR_BREAK_TO:
@@ -681,13 +706,14 @@ ast_expr_t *ast_expr_create_generic_enum_value(weak_cstr_t kind, source_t source
     });
 }
 
-ast_expr_t *ast_expr_create_ternary(ast_expr_t *condition, ast_expr_t *if_true, ast_expr_t *if_false, source_t source){
+ast_expr_t *ast_expr_create_ternary(ast_expr_t *condition, ast_expr_t *if_true, ast_expr_t *if_false, troolean likely, source_t source){
     return (ast_expr_t*) malloc_init(ast_expr_ternary_t, {
         .id = EXPR_TERNARY,
         .source = source,
         .condition = condition,
         .if_true = if_true,
         .if_false = if_false,
+        .likely = likely,
     });
 }
 
@@ -743,6 +769,7 @@ ast_expr_t *ast_expr_create_declaration(
         .type = type,
         .value = value,
         .inputs = inputs,
+        .alignment = 0,
     });
 }
 
@@ -809,13 +836,14 @@ ast_expr_t *ast_expr_create_va_copy(source_t source, ast_expr_t *dest_value, ast
     });
 }
 
-ast_expr_t *ast_expr_create_simple_conditional(source_t source, unsigned int conditional_type, maybe_null_weak_cstr_t label, ast_expr_t *condition, ast_expr_list_t statements){
+ast_expr_t *ast_expr_create_simple_conditional(source_t source, unsigned int conditional_type, maybe_null_weak_cstr_t label, ast_expr_t *condition, troolean likely, ast_expr_list_t statements){
     return (ast_expr_t*) malloc_init(ast_expr_conditional_t, {
         .id = conditional_type,
         .source = source,
         .label = label,
         .value = condition,
         .statements = statements,
+        .likely = likely,
     });
 }
 
@@ -884,6 +912,23 @@ ast_expr_t *ast_expr_create_assert(source_t source, ast_expr_t *assertion){
     });
 }
 
+ast_expr_t *ast_expr_create_assume(source_t source, ast_expr_t *assumption){
+    return (ast_expr_t*) malloc_init(ast_expr_assume_t, {
+        .id = EXPR_ASSUME,
+        .source = source,
+        .value = assumption,
+    });
+}
+
+ast_expr_t *ast_expr_create_yield(source_t source, ast_expr_t *value, ast_expr_list_t last_minute){
+    return (ast_expr_t*) malloc_init(ast_expr_yield_t, {
+        .id = EXPR_YIELD,
+        .source = source,
+        .value = value,
+        .last_minute = last_minute,
+    });
+}
+
 
 ast_expr_list_t ast_expr_list_create(length_t initial_capacity){
     return (ast_expr_list_t){
@@ -1014,6 +1059,7 @@ ast_case_t ast_case_clone(ast_case_t *original){
         .condition = ast_expr_clone(original->condition),
         .statements = ast_expr_list_clone(&original->statements),
         .source = original->source,
+        .likely = original->likely,
     };
 }
 
@@ -1049,6 +1095,18 @@ ast_case_t *ast_case_list_append(ast_case_list_t *list, ast_case_t ast_case){
     return new_case;
 }
 
+ast_parallel_t ast_parallel_clone(ast_parallel_t *original){
+    return (ast_parallel_t){
+        .is_parallel = original->is_parallel,
+        .reductions = original->reductions_length ? memclone(original->reductions, sizeof(ast_reduction_t) * original->reductions_length) : NULL,
+        .reductions_length = original->reductions_length,
+    };
+}
+
+void ast_parallel_free(ast_parallel_t *parallel){
+    free(parallel->reductions);
+}
+
 unsigned short from_assign[EXPR_TOTAL] = {
     [EXPR_ADD_ASSIGN] = EXPR_ADD,
     [EXPR_SUBTRACT_ASSIGN] = EXPR_SUBTRACT,
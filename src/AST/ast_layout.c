@@ -22,6 +22,7 @@ void ast_layout_init(ast_layout_t *layout, ast_layout_kind_t kind, ast_field_map
     layout->field_map = field_map;
     layout->skeleton = skeleton;
     layout->traits = traits;
+    layout->alignment = 0;
 }
 
 void ast_layout_init_with_struct_fields(ast_layout_t *layout, strong_cstr_t names[], ast_type_t strong_types[], length_t length){
@@ -55,7 +56,8 @@ ast_layout_t ast_layout_clone(const ast_layout_t *layout){
         .field_map = ast_field_map_clone(&layout->field_map),
         .skeleton = ast_layout_skeleton_clone(&layout->skeleton),
         .traits = layout->traits,
-    };;
+        .alignment = layout->alignment,
+    };
 }
 
 strong_cstr_t ast_layout_str(ast_layout_t *layout, ast_field_map_t *field_map){
@@ -69,6 +71,7 @@ strong_cstr_t ast_layout_str(ast_layout_t *layout, ast_field_map_t *field_map){
 bool ast_layouts_identical(ast_layout_t *layout_a, ast_layout_t *layout_b){
     if(layout_a->kind != layout_b->kind) return false;
     if(layout_a->traits != layout_b->traits) return false;
+    if(layout_a->alignment != layout_b->alignment) return false;
     if(!ast_field_maps_identical(&layout_a->field_map, &layout_b->field_map)) return false;
     if(!ast_layout_skeletons_identical(&layout_a->skeleton, &layout_b->skeleton)) return false;
     return true;
@@ -77,7 +80,9 @@ bool ast_layouts_identical(ast_layout_t *layout_a, ast_layout_t *layout_b){
 ast_layout_bone_t ast_layout_as_bone(ast_layout_t *layout){
     return (ast_layout_bone_t){
         .kind = (layout->kind == AST_LAYOUT_STRUCT) ? AST_LAYOUT_BONE_KIND_STRUCT : AST_LAYOUT_BONE_KIND_UNION,
-        .traits = (layout->traits & AST_LAYOUT_PACKED) ? AST_LAYOUT_BONE_PACKED : TRAIT_NONE,
+        .traits = ((layout->traits & AST_LAYOUT_PACKED) ? AST_LAYOUT_BONE_PACKED : TRAIT_NONE)
+                | ((layout->traits & AST_LAYOUT_COMPACT) ? AST_LAYOUT_BONE_COMPACT : TRAIT_NONE),
+        .alignment = layout->alignment,
         .children = layout->skeleton,
     };
 }
@@ -166,6 +171,7 @@ hash_t ast_layout_hash(const ast_layout_t *layout){
     hash = hash_combine(hash, ast_field_map_hash(&layout->field_map));
     hash = hash_combine(hash, ast_layout_skeleton_hash(&layout->skeleton));
     hash = hash_combine(hash, hash_data(&layout->traits, sizeof layout->traits));
+    hash = hash_combine(hash, hash_data(&layout->alignment, sizeof layout->alignment));
     return hash;
 }
 
@@ -288,6 +294,7 @@ ast_layout_bone_t ast_layout_bone_clone(ast_layout_bone_t *bone){
     ast_layout_bone_t clone;
     clone.kind = bone->kind;
     clone.traits = bone->traits;
+    clone.alignment = bone->alignment;
 
     switch(bone->kind){
     case AST_LAYOUT_BONE_KIND_TYPE:
@@ -364,6 +371,7 @@ strong_cstr_t ast_layout_bone_str(ast_layout_bone_t *bone, ast_field_map_t *fiel
 hash_t ast_layout_bone_hash(const ast_layout_bone_t *bone){
     hash_t hash = hash_data(&bone->kind, sizeof bone->kind);
     hash = hash_combine(hash, hash_data(&bone->traits, sizeof bone->traits));
+    hash = hash_combine(hash, hash_data(&bone->alignment, sizeof bone->alignment));
 
     switch(bone->kind){
     case AST_LAYOUT_BONE_KIND_TYPE:
@@ -384,6 +392,7 @@ hash_t ast_layout_bone_hash(const ast_layout_bone_t *bone){
 
 bool ast_layout_bones_identical(ast_layout_bone_t *bone_a, ast_layout_bone_t *bone_b){
     if(bone_a->kind != bone_b->kind) return false;
+    if(bone_a->alignment != bone_b->alignment) return false;
 
     switch(bone_a->kind){
     case AST_LAYOUT_BONE_KIND_TYPE:
@@ -462,6 +471,7 @@ void ast_layout_skeleton_add_type(ast_layout_skeleton_t *skeleton, ast_type_t st
     bone.kind = AST_LAYOUT_BONE_KIND_TYPE;
     bone.type = strong_type;
     bone.traits = TRAIT_NONE;
+    bone.alignment = 0;
 
     skeleton->bones[skeleton->bones_length++] = bone;
 }
@@ -480,6 +490,7 @@ ast_layout_skeleton_t *ast_layout_skeleton_add_child_skeleton(ast_layout_skeleto
     ast_layout_bone_t *bone = &skeleton->bones[skeleton->bones_length++];
     bone->kind = bone_kind;
     bone->traits = bone_traits;
+    bone->alignment = 0;
     ast_layout_skeleton_init(&bone->children);
     
     return &bone->children;
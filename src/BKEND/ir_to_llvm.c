@@ -2,7 +2,9 @@
 #include <ctype.h>
 #include <llvm-c/Core.h>
 #include <llvm-c/Target.h>
+#include <llvm/Config/llvm-config.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -21,7 +23,9 @@
 #include "UTIL/string_builder.h"
 #include "UTIL/util.h"
 #include "llvm-c/Analysis.h" // IWYU pragma: keep
+#include "llvm-c/Error.h"
 #include "llvm-c/TargetMachine.h"
+#include "llvm-c/Transforms/PassBuilder.h"
 #include "llvm-c/Types.h"
 
 static char *sanitize_in_place(char *string){
@@ -46,6 +50,7 @@ static void create_static_variables(llvm_context_t *llvm){
         LLVMTypeRef  type   = ir_to_llvm_type(llvm, static_variables->variables[i].type);
         LLVMValueRef global = LLVMAddGlobal(llvm->module, type, "");
         LLVMSetInitializer(global, LLVMGetUndef(type));
+        ir_to_llvm_set_alignment(llvm, global, static_variables->variables[i].type, static_variables->variables[i].alignment);
 
         llvm_static_variables_append(&llvm->static_variables, ((llvm_static_variable_t){
             .global = global,
@@ -223,6 +228,10 @@ static strong_cstr_t create_unix_link_command(
         string_builder_append(&builder, " -lm");
     }
 
+    if(compiler->use_libpthread){
+        string_builder_append(&builder, " -lpthread");
+    }
+
     string_builder_append(&builder, " -o ");
     string_builder_append_quoted(&builder, compiler->output_filename);
 
@@ -373,6 +382,138 @@ static errorcode_t emit_to_file(
     return SUCCESS;
 }
 
+static errorcode_t run_pipeline(llvm_context_t *llvm, LLVMTargetMachineRef target_machine, const char *pipeline){
+    // Runs a textual new pass manager pipeline over the entire module
+
+    LLVMPassBuilderOptionsRef options = LLVMCreatePassBuilderOptions();
+    LLVMErrorRef error = LLVMRunPasses(llvm->module, pipeline, target_machine, options);
+    LLVMDisposePassBuilderOptions(options);
+
+    if(error){
+        char *message = LLVMGetErrorMessage(error);
+        internalerrorprintf("run_pipeline() - Failed to run passes '%s': %s\n", pipeline, message);
+        LLVMDisposeErrorMessage(message);
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+static int llvm_value_ref_cmp(const void *a, const void *b){
+    uintptr_t value_a = (uintptr_t) *(const LLVMValueRef*) a;
+    uintptr_t value_b = (uintptr_t) *(const LLVMValueRef*) b;
+    return value_a < value_b ? -1 : (value_a > value_b ? 1 : 0);
+}
+
+static errorcode_t run_aggressive_function_passes(llvm_context_t *llvm, LLVMTargetMachineRef target_machine, ir_funcs_t *ir_funcs){
+    // Functions marked 'optimize aggressive' get the function simplification passes
+    // that would otherwise only be used at -O3, regardless of the optimization level of the module.
+    // Pass pipelines always run over the entire module, so every other function is
+    // temporarily marked 'optnone' in order to have the passes skip it
+
+    LLVMValueRef *aggressive = malloc(sizeof(LLVMValueRef) * ir_funcs->length);
+    length_t aggressive_length = 0;
+
+    for(length_t f = 0; f != ir_funcs->length; f++){
+        ir_func_t *ir_func = ir_funcs_at(ir_funcs, f);
+
+        // NOTE: Functions that are always inlined may no longer exist
+        if((ir_func->traits & (IR_FUNC_OPTIMIZE_AGGRESSIVE | IR_FUNC_ALWAYS_INLINE | IR_FUNC_FOREIGN | IR_FUNC_UNREFERENCED)) == IR_FUNC_OPTIMIZE_AGGRESSIVE){
+            aggressive[aggressive_length++] = llvm->func_skeletons[f];
+        }
+    }
+
+    qsort(aggressive, aggressive_length, sizeof(LLVMValueRef), llvm_value_ref_cmp);
+
+    LLVMContextRef context = LLVMGetModuleContext(llvm->module);
+    unsigned int optnone_kind = LLVMGetEnumAttributeKindForName("optnone", 7);
+    unsigned int noinline_kind = LLVMGetEnumAttributeKindForName("noinline", 8);
+
+    length_t functions_length = 0;
+    for(LLVMValueRef func = LLVMGetFirstFunction(llvm->module); func; func = LLVMGetNextFunction(func)){
+        functions_length++;
+    }
+
+    // Functions that were temporarily marked, and whether they also needed 'noinline' for 'optnone'
+    LLVMValueRef *skipped = malloc(sizeof(LLVMValueRef) * functions_length);
+    bool *skipped_added_noinline = malloc(sizeof(bool) * functions_length);
+    length_t skipped_length = 0;
+
+    for(LLVMValueRef func = LLVMGetFirstFunction(llvm->module); func; func = LLVMGetNextFunction(func)){
+        if(LLVMIsDeclaration(func)
+        || bsearch(&func, aggressive, aggressive_length, sizeof(LLVMValueRef), llvm_value_ref_cmp)
+        || LLVMGetEnumAttributeAtIndex(func, LLVMAttributeFunctionIndex, optnone_kind)){
+            continue;
+        }
+
+        bool add_noinline = LLVMGetEnumAttributeAtIndex(func, LLVMAttributeFunctionIndex, noinline_kind) == NULL;
+
+        LLVMAddAttributeAtIndex(func, LLVMAttributeFunctionIndex, LLVMCreateEnumAttribute(context, optnone_kind, 0));
+        if(add_noinline) LLVMAddAttributeAtIndex(func, LLVMAttributeFunctionIndex, LLVMCreateEnumAttribute(context, noinline_kind, 0));
+
+        skipped[skipped_length] = func;
+        skipped_added_noinline[skipped_length++] = add_noinline;
+    }
+
+    errorcode_t errorcode = run_pipeline(llvm, target_machine,
+        "function(sroa,early-cse,instcombine,reassociate,gvn,loop-mssa(licm),loop-unroll,dse,adce,simplifycfg)");
+
+    for(length_t i = 0; i != skipped_length; i++){
+        LLVMRemoveEnumAttributeAtIndex(skipped[i], LLVMAttributeFunctionIndex, optnone_kind);
+        if(skipped_added_noinline[i]) LLVMRemoveEnumAttributeAtIndex(skipped[i], LLVMAttributeFunctionIndex, noinline_kind);
+    }
+
+    free(aggressive);
+    free(skipped);
+    free(skipped_added_noinline);
+    return errorcode;
+}
+
+static errorcode_t run_passes(llvm_context_t *llvm, LLVMTargetMachineRef target_machine){
+    // Honors the performance prefixes of functions, since nothing else
+    // before code generation will inline or optimize individual functions
+
+    ir_funcs_t *ir_funcs = &llvm->object->ir_module.funcs;
+    bool has_inlining = false;
+    bool has_aggressive = false;
+    bool has_coroutines = false;
+
+    for(length_t f = 0; f != ir_funcs->length; f++){
+        trait_t traits = ir_funcs_at(ir_funcs, f)->traits;
+
+        if(traits & (IR_FUNC_ALWAYS_INLINE | IR_FUNC_FLATTEN)) has_inlining = true;
+        if(traits & IR_FUNC_OPTIMIZE_AGGRESSIVE) has_aggressive = true;
+        if((traits & (IR_FUNC_COROUTINE | IR_FUNC_UNREFERENCED)) == IR_FUNC_COROUTINE) has_coroutines = true;
+    }
+
+    // Generators must always be split into their resume/destroy parts before code generation
+    if(has_coroutines && run_pipeline(llvm, target_machine, "function(coro-early),cgscc(coro-split)")){
+        return FAILURE;
+    }
+
+    if(has_inlining && run_pipeline(llvm, target_machine, "always-inline")){
+        return FAILURE;
+    }
+
+    // Coroutine frames can only be elided once the ramp function has been inlined into the caller
+    // NOTE: 'coro-cleanup' became a module pass in LLVM 15
+    #if LLVM_VERSION_MAJOR < 15
+    const char *coroutine_cleanup_pipeline = "function(coro-elide,coro-cleanup)";
+    #else
+    const char *coroutine_cleanup_pipeline = "function(coro-elide),coro-cleanup";
+    #endif
+
+    if(has_coroutines && run_pipeline(llvm, target_machine, coroutine_cleanup_pipeline)){
+        return FAILURE;
+    }
+
+    if(has_aggressive && run_aggressive_function_passes(llvm, target_machine, ir_funcs)){
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
 errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
     LLVMInitializeAllTargetInfos();
     LLVMInitializeAllTargets();
@@ -422,14 +563,17 @@ errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
         .string_table = (llvm_string_table_t){0},
         .relocation_list = (llvm_phi2_relocation_list_t){0},
         .static_variable_info = (llvm_static_variable_info_t){0},
+        .coroutine = (llvm_coroutine_t){0},
         .i64_type = LLVMInt64Type(),
         .f64_type = LLVMDoubleType(),
     };
 
     create_static_variables(&llvm);
 
-    if(ir_to_llvm_globals(&llvm, object)
-    || ir_to_llvm_functions(&llvm, object)
+    // NOTE: Function skeletons must exist before global variables,
+    // since static initializers may contain function addresses
+    if(ir_to_llvm_functions(&llvm, object)
+    || ir_to_llvm_globals(&llvm, object)
     || ir_to_llvm_function_bodies(&llvm, object)
     || ir_to_llvm_inject_init_built(&llvm)
     || ir_to_llvm_inject_deinit_built(&llvm)){
@@ -483,6 +627,17 @@ errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
     debug_signal(compiler, DEBUG_SIGNAL_AT_OUT, NULL);
     LLVMPassManagerRef pass_manager = LLVMCreatePassManager();
 
+    if(run_passes(&llvm, target_machine)){
+        LLVMDisposeTargetData(data_layout);
+        LLVMDisposeTargetMachine(target_machine);
+        LLVMDisposePassManager(pass_manager);
+        LLVMDisposeMessage(triple);
+        LLVMDisposeModule(llvm.module);
+        free(objfile_filename);
+        free(link_command);
+        return FAILURE;
+    }
+
     #ifdef ENABLE_DEBUG_FEATURES
     bool no_result = compiler->debug_traits & COMPILER_DEBUG_NO_RESULT;
     #else
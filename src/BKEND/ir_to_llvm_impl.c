@@ -4,10 +4,15 @@
 #include <llvm-c/Target.h>
 #include <llvm/Config/llvm-config.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#ifndef _WIN32
+#include <unistd.h> // IWYU pragma: keep
+#endif
+
 #include "BKEND/ir_to_llvm.h"
 #include "BRIDGE/bridge.h"
 #include "DRVR/compiler.h"
@@ -27,6 +32,7 @@
 
 #if LLVM_VERSION_MAJOR < 14
     #define LLVMBuildGEP2(BUILDER, TYPE, POINTER, INDICES, NUM_INDICES, NAME) LLVMBuildGEP((BUILDER), (POINTER), (INDICES), (NUM_INDICES), (NAME))
+    #define LLVMBuildInBoundsGEP2(BUILDER, TYPE, POINTER, INDICES, NUM_INDICES, NAME) LLVMBuildInBoundsGEP((BUILDER), (POINTER), (INDICES), (NUM_INDICES), (NAME))
     #define LLVMConstGEP2(TYPE, POINTER, INDICES, NUM_INDICES) LLVMConstGEP((POINTER), (INDICES), (NUM_INDICES))
     #define LLVMBuildCall2(BUILDER, FTY, FUNCTION, ARGS, NUM_ARGS, NAME) LLVMBuildCall((BUILDER), (FUNCTION), (ARGS), (NUM_ARGS), (NAME))
     #define LLVMBuildLoad2(BUILDER, TY, POINTER_VAL, NAME) LLVMBuildLoad((BUILDER), (POINTER_VAL), (NAME))
@@ -76,6 +82,7 @@ static LLVMValueRef llvm_get_zero_value(llvm_context_t *llvm, ir_type_t *type){
         return LLVMConstInt(LLVMInt1Type(), 0, false);
     case TYPE_KIND_FUNCPTR:
     case TYPE_KIND_POINTER:
+    case TYPE_KIND_VECTOR:
         return LLVMConstNull(ir_to_llvm_type(llvm, type));
     default:
         return NULL;
@@ -101,6 +108,736 @@ static void llvm_build_memset(llvm_context_t *llvm, LLVMValueRef args[4]){
     LLVMBuildCall2(llvm->builder, memset_intrinsic_type, *memset_intrinsic, args, 4, "");
 }
 
+static LLVMValueRef llvm_get_overloaded_intrinsic(llvm_context_t *llvm, const char *name, LLVMTypeRef *overload_types, length_t overload_types_length, LLVMTypeRef *out_function_type){
+    // Declares an overloaded LLVM intrinsic (e.g. 'llvm.vector.reduce.add') for the given types
+    unsigned int intrinsic_id = LLVMLookupIntrinsicID(name, strlen(name));
+
+    if(intrinsic_id == 0){
+        die("llvm_get_overloaded_intrinsic() - Unknown intrinsic '%s'\n", name);
+    }
+
+    *out_function_type = LLVMIntrinsicGetType(LLVMGetModuleContext(llvm->module), intrinsic_id, overload_types, overload_types_length);
+    return LLVMGetIntrinsicDeclaration(llvm->module, intrinsic_id, overload_types, overload_types_length);
+}
+
+static LLVMValueRef llvm_build_vector_reduce(llvm_context_t *llvm, ir_instr_vector_reduce_t *instr){
+    LLVMValueRef vector = ir_to_llvm_value(llvm, instr->value);
+    LLVMTypeRef vector_type = LLVMTypeOf(vector);
+
+    char intrinsic_name[64];
+    sprintf(intrinsic_name, "llvm.vector.reduce.%s", ir_vector_reduce_operation_name(instr->operation));
+
+    LLVMTypeRef function_type;
+    LLVMValueRef intrinsic = llvm_get_overloaded_intrinsic(llvm, intrinsic_name, &vector_type, 1, &function_type);
+
+    if(instr->operation == INSTRUCTION_FADD || instr->operation == INSTRUCTION_FMULTIPLY){
+        // Floating point additions and multiplications take a starting value,
+        // and are performed in order since they aren't marked as reassociable
+        LLVMTypeRef element_type = LLVMGetElementType(vector_type);
+        LLVMValueRef args[] = {
+            LLVMConstReal(element_type, instr->operation == INSTRUCTION_FADD ? -0.0 : 1.0),
+            vector,
+        };
+        return LLVMBuildCall2(llvm->builder, function_type, intrinsic, args, NUM_ITEMS(args), "");
+    }
+
+    return LLVMBuildCall2(llvm->builder, function_type, intrinsic, &vector, 1, "");
+}
+
+static LLVMValueRef llvm_build_intrinsic(llvm_context_t *llvm, ir_instr_intrinsic_t *instr){
+    // Room for the trailing argument some intrinsics take that isn't exposed
+    LLVMValueRef *args = malloc(sizeof(LLVMValueRef) * (instr->values_length + 1));
+    length_t args_length = instr->values_length;
+
+    for(length_t i = 0; i != instr->values_length; i++){
+        args[i] = ir_to_llvm_value(llvm, instr->values[i]);
+    }
+
+    switch(instr->intrinsic){
+    case IR_INTRINSIC_CTLZ:
+    case IR_INTRINSIC_CTTZ:
+        // Counting the zeros of zero is defined (and gives the bit width)
+        args[args_length++] = LLVMConstInt(LLVMInt1Type(), 0, false);
+        break;
+    case IR_INTRINSIC_PREFETCH:
+        // Always prefetch into the data cache
+        args[args_length++] = LLVMConstInt(LLVMInt32Type(), 1, false);
+        break;
+    default:
+        break;
+    }
+
+    char intrinsic_name[64];
+    sprintf(intrinsic_name, "llvm.%s", ir_intrinsic_name(instr->intrinsic));
+
+    // Every overloaded intrinsic we use is overloaded on the type of its first argument
+    LLVMTypeRef overload_type = LLVMTypeOf(args[0]);
+    bool is_overloaded = LLVMIntrinsicIsOverloaded(LLVMLookupIntrinsicID(intrinsic_name, strlen(intrinsic_name)));
+
+    LLVMTypeRef function_type;
+    LLVMValueRef intrinsic = llvm_get_overloaded_intrinsic(llvm, intrinsic_name, &overload_type, is_overloaded ? 1 : 0, &function_type);
+    LLVMValueRef result = LLVMBuildCall2(llvm->builder, function_type, intrinsic, args, args_length, "");
+
+    free(args);
+    return result;
+}
+
+static LLVMAtomicOrdering llvm_atomic_ordering(unsigned int ordering){
+    switch(ordering){
+    case IR_ATOMIC_RELAXED:
+        return LLVMAtomicOrderingMonotonic;
+    case IR_ATOMIC_CONSUME:
+        // LLVM doesn't have 'consume', so use the stronger 'acquire' instead (like C compilers do)
+    case IR_ATOMIC_ACQUIRE:
+        return LLVMAtomicOrderingAcquire;
+    case IR_ATOMIC_RELEASE:
+        return LLVMAtomicOrderingRelease;
+    case IR_ATOMIC_ACQ_REL:
+        return LLVMAtomicOrderingAcquireRelease;
+    default:
+        return LLVMAtomicOrderingSequentiallyConsistent;
+    }
+}
+
+static LLVMAtomicRMWBinOp llvm_atomic_rmw_operation(unsigned int operation){
+    switch(operation){
+    case INSTRUCTION_ADD:       return LLVMAtomicRMWBinOpAdd;
+    case INSTRUCTION_FADD:      return LLVMAtomicRMWBinOpFAdd;
+    case INSTRUCTION_SUBTRACT:  return LLVMAtomicRMWBinOpSub;
+    case INSTRUCTION_FSUBTRACT: return LLVMAtomicRMWBinOpFSub;
+    case INSTRUCTION_BIT_AND:   return LLVMAtomicRMWBinOpAnd;
+    case INSTRUCTION_BIT_OR:    return LLVMAtomicRMWBinOpOr;
+    case INSTRUCTION_BIT_XOR:   return LLVMAtomicRMWBinOpXor;
+    case INSTRUCTION_SLESSER:   return LLVMAtomicRMWBinOpMin;
+    case INSTRUCTION_SGREATER:  return LLVMAtomicRMWBinOpMax;
+    case INSTRUCTION_ULESSER:   return LLVMAtomicRMWBinOpUMin;
+    case INSTRUCTION_UGREATER:  return LLVMAtomicRMWBinOpUMax;
+    default:                    return LLVMAtomicRMWBinOpXchg;
+    }
+}
+
+static LLVMValueRef llvm_build_atomic(llvm_context_t *llvm, ir_instr_atomic_t *instr){
+    LLVMBuilderRef builder = llvm->builder;
+    LLVMAtomicOrdering ordering = llvm_atomic_ordering(instr->ordering);
+    LLVMValueRef pointer = instr->pointer ? ir_to_llvm_value(llvm, instr->pointer) : NULL;
+    LLVMValueRef value = instr->value ? ir_to_llvm_value(llvm, instr->value) : NULL;
+
+    switch(instr->id){
+    case INSTRUCTION_ATOMIC_LOAD: {
+            LLVMValueRef load = LLVMBuildLoad2(builder, ir_to_llvm_type(llvm, instr->result_type), pointer, "");
+            LLVMSetOrdering(load, ordering);
+            return load;
+        }
+    case INSTRUCTION_ATOMIC_STORE: {
+            LLVMValueRef store = LLVMBuildStore(builder, value, pointer);
+            LLVMSetOrdering(store, ordering);
+            return store;
+        }
+    case INSTRUCTION_ATOMIC_RMW: {
+            LLVMAtomicRMWBinOp operation = llvm_atomic_rmw_operation(instr->operation);
+
+            if(LLVMGetTypeKind(LLVMTypeOf(value)) != LLVMPointerTypeKind){
+                return LLVMBuildAtomicRMW(builder, operation, pointer, value, ordering, false);
+            }
+
+            // Pointers can only be exchanged as integers
+            LLVMTypeRef pointer_type = LLVMTypeOf(value);
+            LLVMTypeRef integer_type = LLVMIntPtrType(llvm->data_layout);
+            LLVMValueRef as_integer = LLVMBuildPtrToInt(builder, value, integer_type, "");
+            LLVMValueRef integer_pointer = LLVMBuildBitCast(builder, pointer, LLVMPointerType(integer_type, 0), "");
+            LLVMValueRef previous = LLVMBuildAtomicRMW(builder, operation, integer_pointer, as_integer, ordering, false);
+            return LLVMBuildIntToPtr(builder, previous, pointer_type, "");
+        }
+    case INSTRUCTION_ATOMIC_CMPXCHG: {
+            LLVMValueRef expected = ir_to_llvm_value(llvm, instr->expected);
+            LLVMAtomicOrdering failure_ordering = llvm_atomic_ordering(instr->failure_ordering);
+            LLVMValueRef exchange = LLVMBuildAtomicCmpXchg(builder, pointer, expected, value, ordering, failure_ordering, false);
+            return LLVMBuildExtractValue(builder, exchange, 0, "");
+        }
+    case INSTRUCTION_FENCE:
+        return LLVMBuildFence(builder, ordering, false, "");
+    }
+
+    die("llvm_build_atomic() - Unrecognized atomic instruction '%d'\n", (int) instr->id);
+    return NULL;
+}
+
+static unsigned int llvm_target_os(llvm_context_t *llvm){
+    // Gets the CROSS_COMPILE_* value for the operating system being targeted
+    if(llvm->compiler->cross_compile_for != CROSS_COMPILE_NONE){
+        return llvm->compiler->cross_compile_for;
+    }
+
+    #if defined(_WIN32)
+        return CROSS_COMPILE_WINDOWS;
+    #elif defined(__APPLE__)
+        return CROSS_COMPILE_MACOS;
+    #else
+        return CROSS_COMPILE_LINUX;
+    #endif
+}
+
+static LLVMValueRef llvm_get_runtime_function(llvm_context_t *llvm, const char *name, LLVMTypeRef function_type){
+    // Declares a function provided by the system, reusing any existing declaration
+    LLVMValueRef function = LLVMGetNamedFunction(llvm->module, name);
+
+    if(function == NULL){
+        return LLVMAddFunction(llvm->module, name, function_type);
+    }
+
+    // Existing declarations (e.g. foreign functions) may have been declared with different types
+    LLVMTypeRef pointer_type = LLVMPointerType(function_type, 0);
+    return LLVMTypeOf(function) == pointer_type ? function : LLVMConstBitCast(function, pointer_type);
+}
+
+// Alignment guaranteed by 'malloc' on all supported targets
+#define LLVM_MALLOC_ALIGNMENT 16
+
+static bool llvm_needs_aligned_malloc(llvm_context_t *llvm, ir_type_t *ir_type){
+    // Returns whether heap allocations of a type need to go through the aligned allocation functions
+    return ir_type->kind != TYPE_KIND_VOID && ir_to_llvm_alignment_of(llvm, ir_type) > LLVM_MALLOC_ALIGNMENT;
+}
+
+static LLVMValueRef llvm_build_aligned_malloc(llvm_context_t *llvm, ir_type_t *ir_type, LLVMValueRef optional_count){
+    // Allocates heap memory for values of an over-aligned type
+    // Uses 'aligned_alloc' (or '_aligned_malloc' on Windows, which must be freed with '_aligned_free')
+
+    LLVMBuilderRef builder = llvm->builder;
+    LLVMTypeRef type = ir_to_llvm_type(llvm, ir_type);
+    LLVMTypeRef i8_ptr = LLVMPointerType(LLVMInt8Type(), 0);
+    length_t alignment = ir_to_llvm_alignment_of(llvm, ir_type);
+
+    LLVMValueRef size = LLVMConstInt(llvm->i64_type, LLVMABISizeOfType(llvm->data_layout, type), false);
+
+    if(optional_count){
+        size = LLVMBuildMul(builder, size, LLVMBuildZExt(builder, optional_count, llvm->i64_type, ""), "");
+    }
+
+    // 'aligned_alloc' requires the size to be a multiple of the alignment
+    size = LLVMBuildAdd(builder, size, LLVMConstInt(llvm->i64_type, alignment - 1, false), "");
+    size = LLVMBuildAnd(builder, size, LLVMConstInt(llvm->i64_type, ~(unsigned long long) (alignment - 1), false), "");
+
+    LLVMValueRef alignment_value = LLVMConstInt(llvm->i64_type, alignment, false);
+    LLVMTypeRef arg_types[] = {llvm->i64_type, llvm->i64_type};
+    LLVMTypeRef function_type = LLVMFunctionType(i8_ptr, arg_types, NUM_ITEMS(arg_types), false);
+    LLVMValueRef allocated;
+
+    if(llvm_target_os(llvm) == CROSS_COMPILE_WINDOWS){
+        LLVMValueRef args[] = {size, alignment_value};
+        allocated = LLVMBuildCall2(builder, function_type, llvm_get_runtime_function(llvm, "_aligned_malloc", function_type), args, NUM_ITEMS(args), "");
+    } else {
+        LLVMValueRef args[] = {alignment_value, size};
+        allocated = LLVMBuildCall2(builder, function_type, llvm_get_runtime_function(llvm, "aligned_alloc", function_type), args, NUM_ITEMS(args), "");
+    }
+
+    return LLVMBuildBitCast(builder, allocated, LLVMPointerType(type, 0), "");
+}
+
+static LLVMValueRef llvm_build_free(llvm_context_t *llvm, ir_value_t *pointer){
+    // Frees heap memory, taking into account whether it was allocated by 'llvm_build_aligned_malloc'
+
+    LLVMValueRef value = ir_to_llvm_value(llvm, pointer);
+
+    if(pointer->type->kind == TYPE_KIND_POINTER
+    && llvm_target_os(llvm) == CROSS_COMPILE_WINDOWS
+    && llvm_needs_aligned_malloc(llvm, (ir_type_t*) pointer->type->extra)){
+        LLVMTypeRef i8_ptr = LLVMPointerType(LLVMInt8Type(), 0);
+        LLVMTypeRef function_type = LLVMFunctionType(LLVMVoidType(), &i8_ptr, 1, false);
+        LLVMValueRef args[] = {LLVMBuildBitCast(llvm->builder, value, i8_ptr, "")};
+
+        return LLVMBuildCall2(llvm->builder, function_type, llvm_get_runtime_function(llvm, "_aligned_free", function_type), args, NUM_ITEMS(args), "");
+    }
+
+    return LLVMBuildFree(llvm->builder, value);
+}
+
+static long long llvm_sc_nprocessors_onln(llvm_context_t *llvm, unsigned int target_os){
+    // Gets the value of '_SC_NPROCESSORS_ONLN' for the targeted system
+    #if !defined(_WIN32) && defined(_SC_NPROCESSORS_ONLN)
+        if(llvm->compiler->cross_compile_for == CROSS_COMPILE_NONE) return _SC_NPROCESSORS_ONLN;
+    #endif
+
+    return target_os == CROSS_COMPILE_MACOS ? 58 : 84;
+}
+
+// Maximum number of threads used to run a parallel loop
+#define LLVM_PARALLEL_MAX_WORKERS 256
+
+// Number of chunks that the iterations of a parallel loop are split into per worker,
+// which lets workers that finish early take over work from slower ones
+#define LLVM_PARALLEL_CHUNKS_PER_WORKER 8
+
+static LLVMTypeRef llvm_parallel_job_type(void){
+    // struct { i8* body, i8* env, i64 count, i64 chunk, i64 next }
+    LLVMTypeRef i8_ptr = LLVMPointerType(LLVMInt8Type(), 0);
+    LLVMTypeRef fields[] = {i8_ptr, i8_ptr, LLVMInt64Type(), LLVMInt64Type(), LLVMInt64Type()};
+    return LLVMStructType(fields, NUM_ITEMS(fields), false);
+}
+
+static LLVMValueRef llvm_get_parallel_worker(llvm_context_t *llvm, unsigned int target_os){
+    // Creates the function that each thread of a parallel loop runs:
+    //     worker(*Job) -> (*void or int)
+    // Chunks of iterations are claimed from the shared counter 'job.next'
+    // until none are left, which balances uneven iterations between threads
+    const char *name = "____parallel_worker";
+    LLVMValueRef worker = LLVMGetNamedFunction(llvm->module, name);
+    if(worker) return worker;
+
+    LLVMTypeRef i8_ptr = LLVMPointerType(LLVMInt8Type(), 0);
+    LLVMTypeRef i64 = LLVMInt64Type();
+    LLVMTypeRef job_type = llvm_parallel_job_type();
+
+    // Threads created with 'CreateThread' return a DWORD rather than a pointer
+    LLVMTypeRef return_type = target_os == CROSS_COMPILE_WINDOWS ? LLVMInt32Type() : i8_ptr;
+    worker = LLVMAddFunction(llvm->module, name, LLVMFunctionType(return_type, &i8_ptr, 1, false));
+    LLVMSetLinkage(worker, LLVMPrivateLinkage);
+
+    LLVMTypeRef body_params[] = {i8_ptr, i64, i64};
+    LLVMTypeRef body_type = LLVMFunctionType(LLVMVoidType(), body_params, NUM_ITEMS(body_params), false);
+
+    LLVMBasicBlockRef entry = LLVMAppendBasicBlock(worker, "");
+    LLVMBasicBlockRef claim = LLVMAppendBasicBlock(worker, "");
+    LLVMBasicBlockRef run = LLVMAppendBasicBlock(worker, "");
+    LLVMBasicBlockRef done = LLVMAppendBasicBlock(worker, "");
+
+    LLVMBuilderRef builder = LLVMCreateBuilder();
+    LLVMPositionBuilderAtEnd(builder, entry);
+
+    LLVMValueRef job = LLVMBuildBitCast(builder, LLVMGetParam(worker, 0), LLVMPointerType(job_type, 0), "");
+    LLVMValueRef body = LLVMBuildLoad2(builder, i8_ptr, LLVMBuildStructGEP2(builder, job_type, job, 0, ""), "");
+    LLVMValueRef env = LLVMBuildLoad2(builder, i8_ptr, LLVMBuildStructGEP2(builder, job_type, job, 1, ""), "");
+    LLVMValueRef count = LLVMBuildLoad2(builder, i64, LLVMBuildStructGEP2(builder, job_type, job, 2, ""), "");
+    LLVMValueRef chunk = LLVMBuildLoad2(builder, i64, LLVMBuildStructGEP2(builder, job_type, job, 3, ""), "");
+    LLVMValueRef next = LLVMBuildStructGEP2(builder, job_type, job, 4, "");
+    body = LLVMBuildBitCast(builder, body, LLVMPointerType(body_type, 0), "");
+    LLVMBuildBr(builder, claim);
+
+    // begin = atomic_fetch_add(&job.next, chunk)
+    LLVMPositionBuilderAtEnd(builder, claim);
+    LLVMValueRef begin = LLVMBuildAtomicRMW(builder, LLVMAtomicRMWBinOpAdd, next, chunk, LLVMAtomicOrderingMonotonic, false);
+    LLVMBuildCondBr(builder, LLVMBuildICmp(builder, LLVMIntULT, begin, count, ""), run, done);
+
+    // body(env, begin, min(begin + chunk, count))
+    LLVMPositionBuilderAtEnd(builder, run);
+    LLVMValueRef end = LLVMBuildAdd(builder, begin, chunk, "");
+    end = LLVMBuildSelect(builder, LLVMBuildICmp(builder, LLVMIntULT, end, count, ""), end, count, "");
+
+    LLVMValueRef args[] = {env, begin, end};
+    LLVMBuildCall2(builder, body_type, body, args, NUM_ITEMS(args), "");
+    LLVMBuildBr(builder, claim);
+
+    LLVMPositionBuilderAtEnd(builder, done);
+    LLVMBuildRet(builder, LLVMConstNull(return_type));
+
+    LLVMDisposeBuilder(builder);
+    return worker;
+}
+
+static LLVMValueRef llvm_get_parallel_for(llvm_context_t *llvm, unsigned int target_os){
+    // Creates the function that runs a parallel loop:
+    //     parallel_for(body *void, env *void, count usize) void
+    // Threads are only created for the duration of the loop, and the calling
+    // thread participates as one of the workers
+    const char *name = "____parallel_for";
+    LLVMValueRef parallel_for = LLVMGetNamedFunction(llvm->module, name);
+    if(parallel_for) return parallel_for;
+
+    LLVMTypeRef i8_ptr = LLVMPointerType(LLVMInt8Type(), 0);
+    LLVMTypeRef i32 = LLVMInt32Type();
+    LLVMTypeRef i64 = LLVMInt64Type();
+    LLVMTypeRef job_type = llvm_parallel_job_type();
+    bool is_windows = target_os == CROSS_COMPILE_WINDOWS;
+
+    LLVMTypeRef params[] = {i8_ptr, i8_ptr, i64};
+    parallel_for = LLVMAddFunction(llvm->module, name, LLVMFunctionType(LLVMVoidType(), params, NUM_ITEMS(params), false));
+    LLVMSetLinkage(parallel_for, LLVMPrivateLinkage);
+
+    LLVMValueRef worker = llvm_get_parallel_worker(llvm, target_os);
+    LLVMTypeRef worker_type = LLVMFunctionType(is_windows ? i32 : i8_ptr, &i8_ptr, 1, false);
+
+    // Thread handles are 'pthread_t' (which is a pointer on macOS) or 'HANDLE'
+    LLVMTypeRef handle_type = target_os == CROSS_COMPILE_LINUX ? i64 : i8_ptr;
+
+    LLVMBasicBlockRef entry = LLVMAppendBasicBlock(parallel_for, "");
+    LLVMBasicBlockRef setup = LLVMAppendBasicBlock(parallel_for, "");
+    LLVMBasicBlockRef spawn_check = LLVMAppendBasicBlock(parallel_for, "");
+    LLVMBasicBlockRef spawn = LLVMAppendBasicBlock(parallel_for, "");
+    LLVMBasicBlockRef spawn_next = LLVMAppendBasicBlock(parallel_for, "");
+    LLVMBasicBlockRef run = LLVMAppendBasicBlock(parallel_for, "");
+    LLVMBasicBlockRef join_check = LLVMAppendBasicBlock(parallel_for, "");
+    LLVMBasicBlockRef join = LLVMAppendBasicBlock(parallel_for, "");
+    LLVMBasicBlockRef done = LLVMAppendBasicBlock(parallel_for, "");
+
+    LLVMBuilderRef builder = LLVMCreateBuilder();
+    LLVMPositionBuilderAtEnd(builder, entry);
+
+    LLVMValueRef count = LLVMGetParam(parallel_for, 2);
+    LLVMValueRef job = LLVMBuildAlloca(builder, job_type, "");
+    LLVMTypeRef handles_type = LLVMArrayType(handle_type, LLVM_PARALLEL_MAX_WORKERS);
+    LLVMValueRef handles = LLVMBuildAlloca(builder, handles_type, "");
+    LLVMBuildCondBr(builder, LLVMBuildICmp(builder, LLVMIntEQ, count, LLVMConstInt(i64, 0, false), ""), done, setup);
+
+    // Determine the number of workers, clamped to [1, LLVM_PARALLEL_MAX_WORKERS]
+    LLVMPositionBuilderAtEnd(builder, setup);
+    LLVMValueRef cpus;
+
+    if(is_windows){
+        LLVMTypeRef i16 = LLVMInt16Type();
+        LLVMValueRef get_count = llvm_get_runtime_function(llvm, "GetActiveProcessorCount", LLVMFunctionType(i32, &i16, 1, false));
+        LLVMValueRef all_groups = LLVMConstInt(i16, 0xFFFF, false);
+        cpus = LLVMBuildZExt(builder, LLVMBuildCall2(builder, LLVMFunctionType(i32, &i16, 1, false), get_count, &all_groups, 1, ""), i64, "");
+    } else {
+        LLVMValueRef sysconf = llvm_get_runtime_function(llvm, "sysconf", LLVMFunctionType(i64, &i32, 1, false));
+        LLVMValueRef which = LLVMConstInt(i32, llvm_sc_nprocessors_onln(llvm, target_os), true);
+        cpus = LLVMBuildCall2(builder, LLVMFunctionType(i64, &i32, 1, false), sysconf, &which, 1, "");
+    }
+
+    LLVMValueRef one = LLVMConstInt(i64, 1, false);
+    LLVMValueRef max_workers = LLVMConstInt(i64, LLVM_PARALLEL_MAX_WORKERS, false);
+    LLVMValueRef workers = LLVMBuildSelect(builder, LLVMBuildICmp(builder, LLVMIntSLT, cpus, one, ""), one, cpus, "");
+    workers = LLVMBuildSelect(builder, LLVMBuildICmp(builder, LLVMIntSGT, workers, max_workers, ""), max_workers, workers, "");
+
+    // chunk = max(1, count / (workers * LLVM_PARALLEL_CHUNKS_PER_WORKER))
+    LLVMValueRef chunks_per_worker = LLVMConstInt(i64, LLVM_PARALLEL_CHUNKS_PER_WORKER, false);
+    LLVMValueRef chunk = LLVMBuildUDiv(builder, count, LLVMBuildMul(builder, workers, chunks_per_worker, ""), "");
+    chunk = LLVMBuildSelect(builder, LLVMBuildICmp(builder, LLVMIntEQ, chunk, LLVMConstInt(i64, 0, false), ""), one, chunk, "");
+
+    // Don't create more threads than there are chunks, (count - 1) / chunk + 1
+    LLVMValueRef chunks = LLVMBuildAdd(builder, LLVMBuildUDiv(builder, LLVMBuildSub(builder, count, one, ""), chunk, ""), one, "");
+    LLVMValueRef threads = LLVMBuildSelect(builder, LLVMBuildICmp(builder, LLVMIntULT, chunks, workers, ""), chunks, workers, "");
+    threads = LLVMBuildSub(builder, threads, one, "");
+
+    LLVMBuildStore(builder, LLVMGetParam(parallel_for, 0), LLVMBuildStructGEP2(builder, job_type, job, 0, ""));
+    LLVMBuildStore(builder, LLVMGetParam(parallel_for, 1), LLVMBuildStructGEP2(builder, job_type, job, 1, ""));
+    LLVMBuildStore(builder, count, LLVMBuildStructGEP2(builder, job_type, job, 2, ""));
+    LLVMBuildStore(builder, chunk, LLVMBuildStructGEP2(builder, job_type, job, 3, ""));
+    LLVMBuildStore(builder, LLVMConstInt(i64, 0, false), LLVMBuildStructGEP2(builder, job_type, job, 4, ""));
+    LLVMValueRef job_pointer = LLVMBuildBitCast(builder, job, i8_ptr, "");
+    LLVMBuildBr(builder, spawn_check);
+
+    // Create helper threads
+    LLVMPositionBuilderAtEnd(builder, spawn_check);
+    LLVMValueRef spawned = LLVMBuildPhi(builder, i64, "");
+    LLVMBuildCondBr(builder, LLVMBuildICmp(builder, LLVMIntULT, spawned, threads, ""), spawn, run);
+
+    LLVMPositionBuilderAtEnd(builder, spawn);
+    LLVMValueRef indices[] = {LLVMConstInt(i64, 0, false), spawned};
+    LLVMValueRef handle_pointer = LLVMBuildInBoundsGEP2(builder, handles_type, handles, indices, NUM_ITEMS(indices), "");
+    LLVMValueRef failed;
+
+    if(is_windows){
+        LLVMTypeRef create_params[] = {i8_ptr, i64, LLVMPointerType(worker_type, 0), i8_ptr, i32, LLVMPointerType(i32, 0)};
+        LLVMTypeRef create_type = LLVMFunctionType(i8_ptr, create_params, NUM_ITEMS(create_params), false);
+        LLVMValueRef create_thread = llvm_get_runtime_function(llvm, "CreateThread", create_type);
+
+        LLVMValueRef args[] = {
+            LLVMConstNull(i8_ptr), LLVMConstInt(i64, 0, false), worker, job_pointer,
+            LLVMConstInt(i32, 0, false), LLVMConstNull(LLVMPointerType(i32, 0)),
+        };
+
+        LLVMValueRef handle = LLVMBuildCall2(builder, create_type, create_thread, args, NUM_ITEMS(args), "");
+        LLVMBuildStore(builder, handle, handle_pointer);
+        failed = LLVMBuildICmp(builder, LLVMIntEQ, handle, LLVMConstNull(i8_ptr), "");
+    } else {
+        LLVMTypeRef create_params[] = {LLVMPointerType(handle_type, 0), i8_ptr, LLVMPointerType(worker_type, 0), i8_ptr};
+        LLVMTypeRef create_type = LLVMFunctionType(i32, create_params, NUM_ITEMS(create_params), false);
+        LLVMValueRef pthread_create = llvm_get_runtime_function(llvm, "pthread_create", create_type);
+
+        LLVMValueRef args[] = {handle_pointer, LLVMConstNull(i8_ptr), worker, job_pointer};
+        LLVMValueRef result = LLVMBuildCall2(builder, create_type, pthread_create, args, NUM_ITEMS(args), "");
+        failed = LLVMBuildICmp(builder, LLVMIntNE, result, LLVMConstInt(i32, 0, false), "");
+    }
+
+    // If a thread can't be created, the remaining work is done by the threads that exist
+    LLVMBuildCondBr(builder, failed, run, spawn_next);
+
+    LLVMPositionBuilderAtEnd(builder, spawn_next);
+    LLVMValueRef spawned_next = LLVMBuildAdd(builder, spawned, one, "");
+    LLVMBuildBr(builder, spawn_check);
+
+    LLVMValueRef spawned_values[] = {LLVMConstInt(i64, 0, false), spawned_next};
+    LLVMBasicBlockRef spawned_blocks[] = {setup, spawn_next};
+    LLVMAddIncoming(spawned, spawned_values, spawned_blocks, 2);
+
+    // Do work on the calling thread too
+    LLVMPositionBuilderAtEnd(builder, run);
+    LLVMValueRef total_spawned = LLVMBuildPhi(builder, i64, "");
+    LLVMValueRef total_values[] = {spawned, spawned};
+    LLVMBasicBlockRef total_blocks[] = {spawn_check, spawn};
+    LLVMAddIncoming(total_spawned, total_values, total_blocks, 2);
+
+    LLVMBuildCall2(builder, worker_type, worker, &job_pointer, 1, "");
+    LLVMBuildBr(builder, join_check);
+
+    // Wait for helper threads to finish
+    LLVMPositionBuilderAtEnd(builder, join_check);
+    LLVMValueRef joined = LLVMBuildPhi(builder, i64, "");
+    LLVMBuildCondBr(builder, LLVMBuildICmp(builder, LLVMIntULT, joined, total_spawned, ""), join, done);
+
+    LLVMPositionBuilderAtEnd(builder, join);
+    LLVMValueRef join_indices[] = {LLVMConstInt(i64, 0, false), joined};
+    LLVMValueRef handle = LLVMBuildLoad2(builder, handle_type, LLVMBuildInBoundsGEP2(builder, handles_type, handles, join_indices, NUM_ITEMS(join_indices), ""), "");
+
+    if(is_windows){
+        LLVMTypeRef wait_params[] = {i8_ptr, i32};
+        LLVMTypeRef wait_type = LLVMFunctionType(i32, wait_params, NUM_ITEMS(wait_params), false);
+        LLVMTypeRef close_type = LLVMFunctionType(i32, &i8_ptr, 1, false);
+
+        LLVMValueRef wait_args[] = {handle, LLVMConstInt(i32, 0xFFFFFFFF, false)};
+        LLVMBuildCall2(builder, wait_type, llvm_get_runtime_function(llvm, "WaitForSingleObject", wait_type), wait_args, NUM_ITEMS(wait_args), "");
+        LLVMBuildCall2(builder, close_type, llvm_get_runtime_function(llvm, "CloseHandle", close_type), &handle, 1, "");
+    } else {
+        LLVMTypeRef join_params[] = {handle_type, LLVMPointerType(i8_ptr, 0)};
+        LLVMTypeRef join_type = LLVMFunctionType(i32, join_params, NUM_ITEMS(join_params), false);
+
+        LLVMValueRef join_args[] = {handle, LLVMConstNull(LLVMPointerType(i8_ptr, 0))};
+        LLVMBuildCall2(builder, join_type, llvm_get_runtime_function(llvm, "pthread_join", join_type), join_args, NUM_ITEMS(join_args), "");
+    }
+
+    LLVMValueRef joined_next = LLVMBuildAdd(builder, joined, one, "");
+    LLVMBuildBr(builder, join_check);
+
+    LLVMValueRef joined_values[] = {LLVMConstInt(i64, 0, false), joined_next};
+    LLVMBasicBlockRef joined_blocks[] = {run, join};
+    LLVMAddIncoming(joined, joined_values, joined_blocks, 2);
+
+    LLVMPositionBuilderAtEnd(builder, done);
+    LLVMBuildRetVoid(builder);
+
+    LLVMDisposeBuilder(builder);
+    return parallel_for;
+}
+
+static void llvm_build_parallel_for(llvm_context_t *llvm, ir_instr_parallel_for_t *instr){
+    LLVMBuilderRef builder = llvm->builder;
+    LLVMTypeRef i8_ptr = LLVMPointerType(LLVMInt8Type(), 0);
+    LLVMValueRef body = ir_to_llvm_value(llvm, instr->body);
+    LLVMValueRef env = LLVMBuildBitCast(builder, ir_to_llvm_value(llvm, instr->env), i8_ptr, "");
+    LLVMValueRef count = ir_to_llvm_value(llvm, instr->count);
+    unsigned int target_os = llvm_target_os(llvm);
+
+    if(target_os == CROSS_COMPILE_WASM32){
+        // No threads are available, so run every iteration as a single chunk
+        LLVMTypeRef body_params[] = {i8_ptr, LLVMInt64Type(), LLVMInt64Type()};
+        LLVMTypeRef body_type = LLVMFunctionType(LLVMVoidType(), body_params, NUM_ITEMS(body_params), false);
+        LLVMValueRef args[] = {env, LLVMConstInt(LLVMInt64Type(), 0, false), count};
+        body = LLVMBuildBitCast(builder, body, LLVMPointerType(body_type, 0), "");
+        LLVMBuildCall2(builder, body_type, body, args, NUM_ITEMS(args), "");
+        return;
+    }
+
+    LLVMTypeRef params[] = {i8_ptr, i8_ptr, LLVMInt64Type()};
+    LLVMTypeRef parallel_for_type = LLVMFunctionType(LLVMVoidType(), params, NUM_ITEMS(params), false);
+    LLVMValueRef args[] = {LLVMBuildBitCast(builder, body, i8_ptr, ""), env, count};
+    LLVMBuildCall2(builder, parallel_for_type, llvm_get_parallel_for(llvm, target_os), args, NUM_ITEMS(args), "");
+}
+
+static LLVMValueRef llvm_build_coroutine_intrinsic(llvm_context_t *llvm, const char *name, LLVMValueRef *args, length_t args_length){
+    // Calls an 'llvm.coro.*' intrinsic, of which only 'llvm.coro.size' is overloaded (always on i64)
+    LLVMTypeRef size_type = llvm->i64_type;
+    length_t overload_types_length = strcmp(name, "llvm.coro.size") == 0 ? 1 : 0;
+
+    LLVMTypeRef function_type;
+    LLVMValueRef intrinsic = llvm_get_overloaded_intrinsic(llvm, name, &size_type, overload_types_length, &function_type);
+    return LLVMBuildCall2(llvm->builder, function_type, intrinsic, args, args_length, "");
+}
+
+static unsigned long long llvm_coroutine_promise_alignment(llvm_context_t *llvm){
+    // The promise of a generator holds a pointer to the most recently yielded value
+    return LLVMABIAlignmentOfType(llvm->data_layout, LLVMPointerType(LLVMInt8Type(), 0));
+}
+
+static void llvm_build_coroutine_begin(llvm_context_t *llvm, LLVMValueRef func_skeleton, LLVMBasicBlockRef *exit_block){
+    // Creates the frame of a generator, as well as the blocks that finish it
+    // NOTE: Expects the stack variables of the function to already be allocated
+
+    LLVMBuilderRef builder = llvm->builder;
+    llvm_coroutine_t *coroutine = &llvm->coroutine;
+    LLVMTypeRef i8_ptr = LLVMPointerType(LLVMInt8Type(), 0);
+    LLVMValueRef null_ptr = LLVMConstNull(i8_ptr);
+    LLVMValueRef none = LLVMConstNull(LLVMTokenTypeInContext(LLVMGetGlobalContext()));
+
+    coroutine->promise = LLVMBuildAlloca(builder, i8_ptr, "");
+    coroutine->destroying = LLVMBuildAlloca(builder, LLVMInt1Type(), "");
+
+    LLVMValueRef id_args[] = {
+        LLVMConstInt(LLVMInt32Type(), llvm_coroutine_promise_alignment(llvm), false),
+        LLVMBuildBitCast(builder, coroutine->promise, i8_ptr, ""),
+        null_ptr,
+        null_ptr,
+    };
+    coroutine->id = llvm_build_coroutine_intrinsic(llvm, "llvm.coro.id", id_args, NUM_ITEMS(id_args));
+
+    // Allocate the frame on the heap, unless its allocation was elided
+    LLVMBasicBlockRef entry_block = LLVMGetInsertBlock(builder);
+    LLVMBasicBlockRef alloc_block = LLVMAppendBasicBlock(func_skeleton, "");
+    LLVMBasicBlockRef begin_block = LLVMAppendBasicBlock(func_skeleton, "");
+    LLVMBuildCondBr(builder, llvm_build_coroutine_intrinsic(llvm, "llvm.coro.alloc", &coroutine->id, 1), alloc_block, begin_block);
+
+    LLVMPositionBuilderAtEnd(builder, alloc_block);
+    LLVMTypeRef malloc_type = LLVMFunctionType(i8_ptr, &llvm->i64_type, 1, false);
+    LLVMValueRef size = llvm_build_coroutine_intrinsic(llvm, "llvm.coro.size", NULL, 0);
+    LLVMValueRef memory = LLVMBuildCall2(builder, malloc_type, llvm_get_runtime_function(llvm, "malloc", malloc_type), &size, 1, "");
+    LLVMBuildBr(builder, begin_block);
+
+    LLVMPositionBuilderAtEnd(builder, begin_block);
+    LLVMValueRef frame = LLVMBuildPhi(builder, i8_ptr, "");
+    LLVMAddIncoming(frame, &null_ptr, &entry_block, 1);
+    LLVMAddIncoming(frame, &memory, &alloc_block, 1);
+
+    LLVMValueRef begin_args[] = {coroutine->id, frame};
+    coroutine->handle = llvm_build_coroutine_intrinsic(llvm, "llvm.coro.begin", begin_args, NUM_ITEMS(begin_args));
+    LLVMBuildStore(builder, null_ptr, coroutine->promise);
+    LLVMBuildStore(builder, LLVMConstInt(LLVMInt1Type(), 0, false), coroutine->destroying);
+    *exit_block = begin_block;
+
+    coroutine->final_block = LLVMAppendBasicBlock(func_skeleton, "");
+    coroutine->cleanup_block = LLVMAppendBasicBlock(func_skeleton, "");
+    coroutine->suspend_block = LLVMAppendBasicBlock(func_skeleton, "");
+    LLVMBasicBlockRef unreachable_block = LLVMAppendBasicBlock(func_skeleton, "");
+
+    // Finished generators suspend one last time, and can only be destroyed afterwards
+    LLVMPositionBuilderAtEnd(builder, coroutine->final_block);
+    LLVMValueRef final_suspend_args[] = {none, LLVMConstInt(LLVMInt1Type(), 1, false)};
+    LLVMValueRef final_suspend = llvm_build_coroutine_intrinsic(llvm, "llvm.coro.suspend", final_suspend_args, NUM_ITEMS(final_suspend_args));
+    LLVMValueRef final_switch = LLVMBuildSwitch(builder, final_suspend, coroutine->suspend_block, 2);
+    LLVMAddCase(final_switch, LLVMConstInt(LLVMInt8Type(), 0, false), unreachable_block);
+    LLVMAddCase(final_switch, LLVMConstInt(LLVMInt8Type(), 1, false), coroutine->cleanup_block);
+
+    LLVMPositionBuilderAtEnd(builder, unreachable_block);
+    LLVMBuildUnreachable(builder);
+
+    // Free the frame once the generator is destroyed
+    LLVMPositionBuilderAtEnd(builder, coroutine->cleanup_block);
+    LLVMTypeRef free_type = LLVMFunctionType(LLVMVoidType(), &i8_ptr, 1, false);
+    LLVMValueRef free_args[] = {coroutine->id, coroutine->handle};
+    LLVMValueRef memory_to_free = llvm_build_coroutine_intrinsic(llvm, "llvm.coro.free", free_args, NUM_ITEMS(free_args));
+    LLVMBuildCall2(builder, free_type, llvm_get_runtime_function(llvm, "free", free_type), &memory_to_free, 1, "");
+    LLVMBuildBr(builder, coroutine->suspend_block);
+
+    // Return control (and the handle on the first suspension) back to the caller
+    LLVMPositionBuilderAtEnd(builder, coroutine->suspend_block);
+    // NOTE: 'llvm.coro.end' takes an additional token for the results of the coroutine since LLVM 18
+    #if LLVM_VERSION_MAJOR < 18
+    LLVMValueRef end_args[] = {coroutine->handle, LLVMConstInt(LLVMInt1Type(), 0, false)};
+    #else
+    LLVMValueRef end_args[] = {coroutine->handle, LLVMConstInt(LLVMInt1Type(), 0, false), none};
+    #endif
+    llvm_build_coroutine_intrinsic(llvm, "llvm.coro.end", end_args, NUM_ITEMS(end_args));
+    LLVMBuildRet(builder, coroutine->handle);
+
+    LLVMPositionBuilderAtEnd(builder, begin_block);
+}
+
+static LLVMValueRef llvm_build_coroutine_suspend(llvm_context_t *llvm, ir_instr_unary_t *instr, LLVMBasicBlockRef *exit_block){
+    // Suspends the current generator after making the yielded value available via its promise
+    // Returns whether the generator is being destroyed rather than resumed
+
+    LLVMBuilderRef builder = llvm->builder;
+    llvm_coroutine_t *coroutine = &llvm->coroutine;
+    LLVMBuildStore(builder, ir_to_llvm_value(llvm, instr->value), coroutine->promise);
+
+    LLVMValueRef suspend_args[] = {
+        LLVMConstNull(LLVMTokenTypeInContext(LLVMGetGlobalContext())),
+        LLVMConstInt(LLVMInt1Type(), 0, false),
+    };
+    LLVMValueRef suspend = llvm_build_coroutine_intrinsic(llvm, "llvm.coro.suspend", suspend_args, NUM_ITEMS(suspend_args));
+
+    LLVMBasicBlockRef continue_block = LLVMAppendBasicBlock(LLVMGetBasicBlockParent(LLVMGetInsertBlock(builder)), "");
+    LLVMValueRef suspend_switch = LLVMBuildSwitch(builder, suspend, coroutine->suspend_block, 2);
+    LLVMAddCase(suspend_switch, LLVMConstInt(LLVMInt8Type(), 0, false), continue_block);
+    LLVMAddCase(suspend_switch, LLVMConstInt(LLVMInt8Type(), 1, false), continue_block);
+
+    LLVMPositionBuilderAtEnd(builder, continue_block);
+    LLVMValueRef is_destroying = LLVMBuildICmp(builder, LLVMIntEQ, suspend, LLVMConstInt(LLVMInt8Type(), 1, false), "");
+    LLVMBuildStore(builder, is_destroying, coroutine->destroying);
+    *exit_block = continue_block;
+    return is_destroying;
+}
+
+static LLVMValueRef llvm_build_coroutine_operation(llvm_context_t *llvm, ir_instr_unary_t *instr){
+    // Builds an operation on a generator handle from outside of the generator
+    LLVMValueRef handle = ir_to_llvm_value(llvm, instr->value);
+
+    switch(instr->id){
+    case INSTRUCTION_COROUTINE_RESUME:
+        return llvm_build_coroutine_intrinsic(llvm, "llvm.coro.resume", &handle, 1);
+    case INSTRUCTION_COROUTINE_DESTROY:
+        return llvm_build_coroutine_intrinsic(llvm, "llvm.coro.destroy", &handle, 1);
+    case INSTRUCTION_COROUTINE_DONE:
+        return llvm_build_coroutine_intrinsic(llvm, "llvm.coro.done", &handle, 1);
+    case INSTRUCTION_COROUTINE_VALUE: {
+            LLVMTypeRef i8_ptr = LLVMPointerType(LLVMInt8Type(), 0);
+            LLVMValueRef promise_args[] = {
+                handle,
+                LLVMConstInt(LLVMInt32Type(), llvm_coroutine_promise_alignment(llvm), false),
+                LLVMConstInt(LLVMInt1Type(), 0, false),
+            };
+            LLVMValueRef promise = llvm_build_coroutine_intrinsic(llvm, "llvm.coro.promise", promise_args, NUM_ITEMS(promise_args));
+            promise = LLVMBuildBitCast(llvm->builder, promise, LLVMPointerType(i8_ptr, 0), "");
+            return LLVMBuildLoad2(llvm->builder, i8_ptr, promise, "");
+        }
+    }
+
+    die("llvm_build_coroutine_operation() - Unrecognized instruction '%d'\n", (int) instr->id);
+}
+
+// Weights given to branches that were hinted to be likely and unlikely,
+// and to switch destinations that weren't given a hint
+#define LLVM_LIKELY_BRANCH_WEIGHT 2000
+#define LLVM_UNLIKELY_BRANCH_WEIGHT 1
+#define LLVM_NEUTRAL_BRANCH_WEIGHT 100
+
+static void llvm_set_branch_weights(LLVMValueRef terminator, unsigned int *weights, length_t weights_length){
+    LLVMContextRef context = LLVMGetGlobalContext();
+    LLVMMetadataRef *operands = malloc(sizeof(LLVMMetadataRef) * (weights_length + 1));
+
+    operands[0] = LLVMMDStringInContext2(context, "branch_weights", 14);
+
+    for(length_t i = 0; i != weights_length; i++){
+        operands[i + 1] = LLVMValueAsMetadata(LLVMConstInt(LLVMInt32Type(), weights[i], false));
+    }
+
+    LLVMMetadataRef node = LLVMMDNodeInContext2(context, operands, weights_length + 1);
+    LLVMSetMetadata(terminator, LLVMGetMDKindID("prof", 4), LLVMMetadataAsValue(context, node));
+    free(operands);
+}
+
+static void llvm_build_cond_break(llvm_context_t *llvm, ir_instr_cond_break_t *instr, LLVMBasicBlockRef *llvm_blocks){
+    LLVMValueRef cond_break = LLVMBuildCondBr(llvm->builder, ir_to_llvm_value(llvm, instr->value), llvm_blocks[instr->true_block_id], llvm_blocks[instr->false_block_id]);
+
+    if(instr->likely != TROOLEAN_UNKNOWN){
+        bool likely = instr->likely == TROOLEAN_TRUE;
+
+        unsigned int weights[2] = {
+            likely ? LLVM_LIKELY_BRANCH_WEIGHT : LLVM_UNLIKELY_BRANCH_WEIGHT,
+            likely ? LLVM_UNLIKELY_BRANCH_WEIGHT : LLVM_LIKELY_BRANCH_WEIGHT,
+        };
+
+        llvm_set_branch_weights(cond_break, weights, 2);
+    }
+}
+
+static void llvm_set_switch_weights(LLVMValueRef switch_val, ir_instr_switch_t *instr){
+    // Destinations without a hint (including the default destination) are given a neutral weight,
+    // which keeps them less likely than likely cases and more likely than unlikely cases
+
+    // The weight of the default destination comes first
+    unsigned int *weights = malloc(sizeof(unsigned int) * (instr->cases_length + 1));
+    weights[0] = LLVM_NEUTRAL_BRANCH_WEIGHT;
+
+    for(length_t i = 0; i != instr->cases_length; i++){
+        switch(instr->case_likely[i]){
+        case TROOLEAN_TRUE:  weights[i + 1] = LLVM_LIKELY_BRANCH_WEIGHT;   break;
+        case TROOLEAN_FALSE: weights[i + 1] = LLVM_UNLIKELY_BRANCH_WEIGHT; break;
+        default:             weights[i + 1] = LLVM_NEUTRAL_BRANCH_WEIGHT;
+        }
+    }
+
+    llvm_set_branch_weights(switch_val, weights, instr->cases_length + 1);
+    free(weights);
+}
+
 static void reset_on_failure_phis(llvm_context_t *llvm){
     llvm->null_check.line_phi = NULL;
     llvm->null_check.column_phi = NULL;
@@ -108,6 +845,129 @@ static void reset_on_failure_phis(llvm_context_t *llvm){
     llvm->vtable_check.column_phi = NULL;
 }
 
+static length_t llvm_round_up_to_alignment(length_t value, length_t alignment){
+    // NOTE: Assumes 'alignment' is a power of two
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static length_t ir_to_llvm_field_alignment(llvm_context_t *llvm, ir_type_extra_composite_t *composite, length_t index){
+    // Gets the alignment that a field of a composite type will be placed at
+    length_t alignment = (composite->traits & TYPE_KIND_COMPOSITE_PACKED) ? 1 : ir_to_llvm_alignment_of(llvm, composite->subtypes[index]);
+
+    if(composite->subtype_alignments && composite->subtype_alignments[index] > alignment){
+        alignment = composite->subtype_alignments[index];
+    }
+
+    return alignment;
+}
+
+static LLVMTypeRef ir_to_llvm_aligned_struct_type(llvm_context_t *llvm, ir_type_extra_composite_t *composite, unsigned int *out_field_indices){
+    // Lays out a structure type that is affected by explicit alignment or field reordering
+    // LLVM struct types can't carry alignment, so fields are placed
+    // inside of a packed struct with manual padding between them
+    // 'out_field_indices' (nullable) will receive the LLVM index of each field
+
+    LLVMTypeRef fields[composite->subtypes_length * 2 + 1];
+    length_t fields_length = 0;
+    length_t offset = 0;
+    length_t alignment = ir_to_llvm_alignment_of(llvm, &(ir_type_t){.kind = TYPE_KIND_STRUCTURE, .extra = composite});
+
+    length_t field_alignments[length_max(1, composite->subtypes_length)];
+    length_t order[length_max(1, composite->subtypes_length)];
+
+    for(length_t i = 0; i != composite->subtypes_length; i++){
+        field_alignments[i] = ir_to_llvm_field_alignment(llvm, composite, i);
+        order[i] = i;
+    }
+
+    if(composite->traits & TYPE_KIND_COMPOSITE_REORDERED){
+        // Place fields by descending alignment, which leaves no padding between them
+        // since sizes are multiples of alignment. Insertion sort is used so that
+        // fields with the same alignment keep their declared order
+        for(length_t i = 1; i < composite->subtypes_length; i++){
+            length_t field_index = order[i];
+            length_t j = i;
+
+            while(j != 0 && field_alignments[order[j - 1]] < field_alignments[field_index]){
+                order[j] = order[j - 1];
+                j--;
+            }
+
+            order[j] = field_index;
+        }
+    }
+
+    for(length_t position = 0; position != composite->subtypes_length; position++){
+        length_t i = order[position];
+
+        LLVMTypeRef field = ir_to_llvm_type(llvm, composite->subtypes[i]);
+        if(field == NULL) return NULL;
+
+        length_t aligned_offset = llvm_round_up_to_alignment(offset, field_alignments[i]);
+
+        if(aligned_offset != offset){
+            fields[fields_length++] = LLVMArrayType(LLVMInt8Type(), aligned_offset - offset);
+        }
+
+        if(out_field_indices) out_field_indices[i] = fields_length;
+
+        fields[fields_length++] = field;
+        offset = aligned_offset + LLVMABISizeOfType(llvm->data_layout, field);
+    }
+
+    // Pad the end so that consecutive elements stay aligned
+    length_t size = llvm_round_up_to_alignment(offset, alignment);
+
+    if(size != offset){
+        fields[fields_length++] = LLVMArrayType(LLVMInt8Type(), size - offset);
+    }
+
+    return LLVMStructType(fields, fields_length, true);
+}
+
+length_t ir_to_llvm_alignment_of(llvm_context_t *llvm, ir_type_t *ir_type){
+    switch(ir_type->kind){
+    case TYPE_KIND_STRUCTURE: case TYPE_KIND_UNION: {
+            if(!ir_type_has_manual_layout(ir_type)) break;
+
+            ir_type_extra_composite_t *composite = (ir_type_extra_composite_t*) ir_type->extra;
+            length_t alignment = length_max(1, composite->alignment);
+
+            for(length_t i = 0; i != composite->subtypes_length; i++){
+                alignment = length_max(alignment, ir_to_llvm_field_alignment(llvm, composite, i));
+            }
+
+            return alignment;
+        }
+    case TYPE_KIND_FIXED_ARRAY:
+        return ir_to_llvm_alignment_of(llvm, ((ir_type_extra_fixed_array_t*) ir_type->extra)->subtype);
+    case TYPE_KIND_VOID:
+        return 1;
+    }
+
+    return LLVMABIAlignmentOfType(llvm->data_layout, ir_to_llvm_type(llvm, ir_type));
+}
+
+unsigned int ir_to_llvm_member_index(llvm_context_t *llvm, ir_type_t *ir_type, length_t index){
+    if(ir_type->kind != TYPE_KIND_STRUCTURE || !ir_type_has_manual_layout(ir_type)) return index;
+
+    ir_type_extra_composite_t *composite = (ir_type_extra_composite_t*) ir_type->extra;
+    unsigned int field_indices[length_max(1, composite->subtypes_length)];
+
+    ir_to_llvm_aligned_struct_type(llvm, composite, field_indices);
+    return field_indices[index];
+}
+
+void ir_to_llvm_set_alignment(llvm_context_t *llvm, LLVMValueRef value, ir_type_t *ir_type, length_t explicit_alignment){
+    if(explicit_alignment == 0 && !ir_type_has_manual_layout(ir_type)) return;
+
+    length_t alignment = length_max(explicit_alignment, ir_to_llvm_alignment_of(llvm, ir_type));
+
+    if(alignment > LLVMGetAlignment(value)){
+        LLVMSetAlignment(value, alignment);
+    }
+}
+
 LLVMTypeRef ir_to_llvm_type(llvm_context_t *llvm, ir_type_t *ir_type){
     // Converts an ir type to an llvm type
     LLVMTypeRef type_ref_tmp;
@@ -134,6 +994,11 @@ LLVMTypeRef ir_to_llvm_type(llvm_context_t *llvm, ir_type_t *ir_type){
             //           remade into LLVM types every time we use them.
 
             ir_type_extra_composite_t *composite = (ir_type_extra_composite_t*) ir_type->extra;
+
+            if(ir_type_has_manual_layout(ir_type)){
+                return ir_to_llvm_aligned_struct_type(llvm, composite, NULL);
+            }
+
             LLVMTypeRef fields[length_max(1, composite->subtypes_length)];
 
             for(length_t i = 0; i != composite->subtypes_length; i++){
@@ -162,6 +1027,11 @@ LLVMTypeRef ir_to_llvm_type(llvm_context_t *llvm, ir_type_t *ir_type){
             // Force non-zero size (since LLVM doesn't like zero sized arrays)
             if(largest_size == 0) largest_size = 1;
 
+            if(ir_type_has_manual_layout(ir_type)){
+                // Over-aligned Unions (alignment is applied by users of the type)
+                return LLVMArrayType(LLVMInt8Type(), llvm_round_up_to_alignment(largest_size, ir_to_llvm_alignment_of(llvm, ir_type)));
+            }
+
             if(composite->traits & TYPE_KIND_COMPOSITE_PACKED){
                 // Packed Unions
                 return LLVMArrayType(LLVMInt8Type(), largest_size);
@@ -188,6 +1058,13 @@ LLVMTypeRef ir_to_llvm_type(llvm_context_t *llvm, ir_type_t *ir_type){
             return LLVMArrayType(type_ref_tmp, fixed_array->length);
         }
         break;
+    case TYPE_KIND_VECTOR: {
+            ir_type_extra_vector_t *vector = (ir_type_extra_vector_t*) ir_type->extra;
+            type_ref_tmp = ir_to_llvm_type(llvm, vector->subtype);
+            if(type_ref_tmp == NULL) return NULL;
+            return LLVMVectorType(type_ref_tmp, vector->length);
+        }
+        break;
     default: return NULL; // No suitable llvm type
     }
 }
@@ -217,10 +1094,8 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
                 die("ir_to_llvm_value() - Unrecognized type kind for literal in ir_to_llvm_value\n");
             }
         }
-    case VALUE_TYPE_RESULT: {
-            ir_value_result_t *extra = (ir_value_result_t*) value->extra;
-            return llvm->catalog->blocks[extra->block_id].value_references[extra->instruction_id];
-        }
+    case VALUE_TYPE_RESULT:
+        return llvm->catalog->blocks[value->result.block_id].value_references[value->result.instruction_id];
     case VALUE_TYPE_NULLPTR:
         return LLVMConstNull(LLVMPointerType(LLVMInt8Type(), 0));
     case VALUE_TYPE_NULLPTR_OF_TYPE:
@@ -257,15 +1132,21 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
 
             // Assume that value->type is a pointer to a struct
             LLVMTypeRef type = ir_to_llvm_type(llvm, value->type);
+            length_t fields_length = LLVMCountStructElementTypes(type);
             
-            LLVMValueRef values[length_max(1, struct_literal->length)];
+            LLVMValueRef values[length_max(1, fields_length)];
+
+            // Padding fields for explicitly aligned structs are zeroed
+            for(length_t i = 0; i != fields_length; i++){
+                values[i] = LLVMConstNull(LLVMStructGetTypeAtIndex(type, i));
+            }
 
             for(length_t i = 0; i != struct_literal->length; i++){
                 // Assumes ir_value_t values are constants (should have been checked earlier)
-                values[i] = ir_to_llvm_value(llvm, struct_literal->values[i]);
+                values[ir_to_llvm_member_index(llvm, value->type, i)] = ir_to_llvm_value(llvm, struct_literal->values[i]);
             }
             
-            return LLVMConstNamedStruct(type, values, struct_literal->length);
+            return LLVMConstNamedStruct(type, values, fields_length);
         }
     case VALUE_TYPE_ANON_GLOBAL: case VALUE_TYPE_CONST_ANON_GLOBAL: {
             ir_value_anon_global_t *extra = (ir_value_anon_global_t*) value->extra;
@@ -302,8 +1183,8 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
     case VALUE_TYPE_FUNC_ADDR: {
             ir_value_func_addr_t *func_addr = value->extra;
 
-            if(llvm->object->ir_module.funcs.funcs[func_addr->ir_func_id].export_as){
-                return LLVMGetNamedFunction(llvm->module, llvm->object->ir_module.funcs.funcs[func_addr->ir_func_id].export_as);
+            if(ir_funcs_at(&llvm->object->ir_module.funcs, func_addr->ir_func_id)->export_as){
+                return LLVMGetNamedFunction(llvm->module, ir_funcs_at(&llvm->object->ir_module.funcs, func_addr->ir_func_id)->export_as);
             } else {
                 char stack_storage[256];
                 ir_implementation(func_addr->ir_func_id, 'a', stack_storage);
@@ -351,14 +1232,16 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
             LLVMValueRef constructed = LLVMGetUndef(ir_to_llvm_type(llvm, value->type));
 
             for(length_t i = 0; i != construction->length; i++){
-                constructed = LLVMBuildInsertValue(llvm->builder, constructed, ir_to_llvm_value(llvm, construction->values[i]), i, "");
+                unsigned int index = ir_to_llvm_member_index(llvm, value->type, i);
+                constructed = LLVMBuildInsertValue(llvm->builder, constructed, ir_to_llvm_value(llvm, construction->values[i]), index, "");
             }
 
             return constructed;
         }
     case VALUE_TYPE_OFFSETOF: {
             ir_value_offsetof_t *offsetof = (ir_value_offsetof_t*) value->extra;
-            unsigned long long offset = LLVMOffsetOfElement(llvm->data_layout, ir_to_llvm_type(llvm, offsetof->type), offsetof->index);
+            unsigned int index = ir_to_llvm_member_index(llvm, offsetof->type, offsetof->index);
+            unsigned long long offset = LLVMOffsetOfElement(llvm->data_layout, ir_to_llvm_type(llvm, offsetof->type), index);
             return LLVMConstInt(llvm->i64_type, offset, false);
         }
     case VALUE_TYPE_CONST_SIZEOF: {
@@ -368,7 +1251,7 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
         }
     case VALUE_TYPE_CONST_ALIGNOF: {
             ir_value_const_alignof_t *const_alignof = (ir_value_const_alignof_t*) value->extra;
-            length_t type_size = const_alignof->type->kind == TYPE_KIND_VOID ? 0 : LLVMABIAlignmentOfType(llvm->data_layout, ir_to_llvm_type(llvm, const_alignof->type));
+            length_t type_size = const_alignof->type->kind == TYPE_KIND_VOID ? 0 : ir_to_llvm_alignment_of(llvm, const_alignof->type);
             return LLVMConstInt(llvm->i64_type, type_size, false);
         }
     case VALUE_TYPE_CONST_ADD: {
@@ -382,11 +1265,88 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
     return NULL;
 }
 
+static LLVMAttributeRef llvm_create_enum_attribute(const char *name, uint64_t value){
+    return LLVMCreateEnumAttribute(LLVMGetGlobalContext(), LLVMGetEnumAttributeKindForName(name, strlen(name)), value);
+}
+
+static void ir_to_llvm_add_inferred_attributes(llvm_context_t *llvm, LLVMValueRef skeleton, ir_func_t *ir_func){
+    // Adds the attributes that were inferred for a function during IR generation
+
+    #if LLVM_VERSION_MAJOR >= 16
+    // Memory effects are encoded as two bits (read, write) for each memory location
+    if(ir_func->traits & IR_FUNC_READNONE){
+        LLVMAddAttributeAtIndex(skeleton, LLVMAttributeFunctionIndex, llvm_create_enum_attribute("memory", 0));
+    } else if(ir_func->traits & IR_FUNC_READONLY){
+        LLVMAddAttributeAtIndex(skeleton, LLVMAttributeFunctionIndex, llvm_create_enum_attribute("memory", 0x15));
+    }
+    #else
+    if(ir_func->traits & IR_FUNC_READNONE){
+        LLVMAddAttributeAtIndex(skeleton, LLVMAttributeFunctionIndex, llvm_create_enum_attribute("readnone", 0));
+    } else if(ir_func->traits & IR_FUNC_READONLY){
+        LLVMAddAttributeAtIndex(skeleton, LLVMAttributeFunctionIndex, llvm_create_enum_attribute("readonly", 0));
+    }
+    #endif
+
+    if(ir_func->traits & IR_FUNC_WILLRETURN){
+        LLVMAddAttributeAtIndex(skeleton, LLVMAttributeFunctionIndex, llvm_create_enum_attribute("willreturn", 0));
+    }
+
+    if(ir_func->traits & IR_FUNC_NOALIAS_RETURN){
+        LLVMAddAttributeAtIndex(skeleton, LLVMAttributeReturnIndex, llvm_create_enum_attribute("noalias", 0));
+    }
+
+    if(ir_func->maybe_argument_traits == NULL) return;
+
+    for(length_t i = 0; i != ir_func->arity; i++){
+        trait_t arg_traits = ir_func->maybe_argument_traits[i];
+        LLVMAttributeIndex index = (LLVMAttributeIndex) (i + 1);
+
+        if(arg_traits & IR_FUNC_ARG_NONNULL){
+            LLVMAddAttributeAtIndex(skeleton, index, llvm_create_enum_attribute("nonnull", 0));
+        }
+
+        if(arg_traits & IR_FUNC_ARG_DEREFERENCEABLE){
+            unsigned long long size = LLVMABISizeOfType(llvm->data_layout, ir_to_llvm_type(llvm, ir_type_dereference(ir_func->argument_types[i])));
+
+            if(size != 0){
+                LLVMAddAttributeAtIndex(skeleton, index, llvm_create_enum_attribute("dereferenceable", size));
+            }
+        }
+    }
+}
+
+static void ir_to_llvm_add_performance_attributes(LLVMValueRef skeleton, ir_func_t *ir_func){
+    // Adds the attributes for the performance prefixes a function was declared with
+
+    static const struct { trait_t trait; const char *attribute; } attributes[] = {
+        {IR_FUNC_ALWAYS_INLINE, "alwaysinline"},
+        {IR_FUNC_NO_INLINE,     "noinline"},
+        {IR_FUNC_HOT,           "hot"},
+        {IR_FUNC_COLD,          "cold"},
+        {IR_FUNC_OPTIMIZE_SIZE, "optsize"},
+    };
+
+    for(length_t i = 0; i != NUM_ITEMS(attributes); i++){
+        if(ir_func->traits & attributes[i].trait){
+            LLVMAddAttributeAtIndex(skeleton, LLVMAttributeFunctionIndex, llvm_create_enum_attribute(attributes[i].attribute, 0));
+        }
+    }
+
+    // Functions that are never optimized must also never be inlined
+    if(ir_func->traits & IR_FUNC_OPTIMIZE_NONE){
+        LLVMAddAttributeAtIndex(skeleton, LLVMAttributeFunctionIndex, llvm_create_enum_attribute("optnone", 0));
+
+        if(!(ir_func->traits & IR_FUNC_NO_INLINE)){
+            LLVMAddAttributeAtIndex(skeleton, LLVMAttributeFunctionIndex, llvm_create_enum_attribute("noinline", 0));
+        }
+    }
+}
+
 errorcode_t ir_to_llvm_functions(llvm_context_t *llvm, object_t *object){
     // Generates llvm function skeletons from ir function data
 
     LLVMModuleRef llvm_module = llvm->module;
-    ir_func_t *module_funcs = object->ir_module.funcs.funcs;
+    ir_funcs_t *module_funcs = &object->ir_module.funcs;
     length_t module_funcs_length = object->ir_module.funcs.length;
     LLVMValueRef *func_skeletons = llvm->func_skeletons;
     LLVMTypeRef *func_skeleton_types = llvm->func_skeleton_types;
@@ -394,7 +1354,15 @@ errorcode_t ir_to_llvm_functions(llvm_context_t *llvm, object_t *object){
     LLVMAttributeRef nounwind = LLVMCreateEnumAttribute(LLVMGetGlobalContext(), LLVMGetEnumAttributeKindForName("nounwind", 8), 0);
 
     for(length_t ir_func_id = 0; ir_func_id != module_funcs_length; ir_func_id++){
-        ir_func_t *ir_func = &module_funcs[ir_func_id];
+        ir_func_t *ir_func = ir_funcs_at(module_funcs, ir_func_id);
+
+        // Unreachable functions don't get declarations
+        if(ir_func->traits & IR_FUNC_UNREFERENCED){
+            func_skeletons[ir_func_id] = NULL;
+            func_skeleton_types[ir_func_id] = NULL;
+            continue;
+        }
+
         LLVMTypeRef parameters[length_max(1, ir_func->arity)];
 
         for(length_t a = 0; a != ir_func->arity; a++){
@@ -447,12 +1415,31 @@ errorcode_t ir_to_llvm_functions(llvm_context_t *llvm, object_t *object){
         }
 
         LLVMCallConv call_conv = ir_func->traits & IR_FUNC_STDCALL ? LLVMX86StdcallCallConv : LLVMCCallConv;
+
+        // Internal functions that are only ever called directly can use the fast calling convention,
+        // since we know every call site and nobody else is able to call them
+        if(!(ir_func->traits & (IR_FUNC_FOREIGN | IR_FUNC_MAIN | IR_FUNC_VARARG | IR_FUNC_STDCALL | IR_FUNC_INIT | IR_FUNC_DEINIT | IR_FUNC_ADDRESS_TAKEN)) && ir_func->export_as == NULL){
+            call_conv = LLVMFastCallConv;
+        }
+
         LLVMSetFunctionCallConv(*skeleton, call_conv);
         
         // Add nounwind to everything that isn't foreign
         if(!(ir_func->traits & IR_FUNC_FOREIGN)){
             LLVMAddAttributeAtIndex(*skeleton, (LLVMAttributeIndex) LLVMAttributeFunctionIndex, nounwind);
         }
+
+        ir_to_llvm_add_inferred_attributes(llvm, *skeleton, ir_func);
+        ir_to_llvm_add_performance_attributes(*skeleton, ir_func);
+
+        // Generators must be marked as not yet split in order for the coroutine passes to split them
+        if(ir_func->traits & IR_FUNC_COROUTINE){
+            #if LLVM_VERSION_MAJOR < 15
+            LLVMAddAttributeAtIndex(*skeleton, LLVMAttributeFunctionIndex, LLVMCreateStringAttribute(LLVMGetGlobalContext(), "coroutine.presplit", 18, "0", 1));
+            #else
+            LLVMAddAttributeAtIndex(*skeleton, LLVMAttributeFunctionIndex, llvm_create_enum_attribute("presplitcoroutine", 0));
+            #endif
+        }
     }
 
     // Generate function to handle deinitialization of static variables
@@ -465,23 +1452,26 @@ errorcode_t ir_to_llvm_function_bodies(llvm_context_t *llvm, object_t *object){
     // Generates llvm function bodies from ir function data
     // NOTE: Expects function skeletons to already be present
 
-    ir_func_t *module_funcs = object->ir_module.funcs.funcs;
+    ir_funcs_t *module_funcs = &object->ir_module.funcs;
     length_t module_funcs_length = object->ir_module.funcs.length;
     LLVMValueRef *func_skeletons = llvm->func_skeletons;
 
     llvm->relocation_list = (llvm_phi2_relocation_list_t){0};
 
     for(length_t f = 0; f != module_funcs_length; f++){
+        ir_func_t *ir_func = ir_funcs_at(module_funcs, f);
+        if(ir_func->traits & IR_FUNC_UNREFERENCED) continue;
+
         LLVMBuilderRef builder = LLVMCreateBuilder();
-        ir_basicblocks_t basicblocks = module_funcs[f].basicblocks;
+        ir_basicblocks_t basicblocks = ir_func->basicblocks;
 
         value_catalog_t catalog;
         value_catalog_prepare(&catalog, basicblocks);
 
         varstack_t stack_frame = (varstack_t){
-            .values = malloc(sizeof(LLVMValueRef) * module_funcs[f].variable_count),
-            .types = malloc(sizeof(LLVMTypeRef) * module_funcs[f].variable_count),
-            .length = module_funcs[f].variable_count,
+            .values = malloc(sizeof(LLVMValueRef) * ir_func->variable_count),
+            .types = malloc(sizeof(LLVMTypeRef) * ir_func->variable_count),
+            .length = ir_func->variable_count,
         };
 
         llvm->builder = builder;
@@ -499,7 +1489,7 @@ errorcode_t ir_to_llvm_function_bodies(llvm_context_t *llvm, object_t *object){
         llvm->relocation_list.length = 0;
 
         // Determine whether this function is the entry point
-        trait_t ir_func_traits = module_funcs[f].traits;
+        trait_t ir_func_traits = ir_func->traits;
         bool is_entry_function = (ir_func_traits & IR_FUNC_MAIN || ir_func_traits & IR_FUNC_INIT) && llvm->static_variable_info.init_routine == NULL;
 
         // Inject true entry before faux program entry
@@ -525,7 +1515,7 @@ errorcode_t ir_to_llvm_function_bodies(llvm_context_t *llvm, object_t *object){
             llvm,
             basicblocks,
             func_skeletons[f],
-            &module_funcs[f],
+            ir_func,
             llvm_blocks,
             llvm_exit_blocks,
             f
@@ -557,6 +1547,8 @@ errorcode_t ir_to_llvm_basicblocks(llvm_context_t *llvm, ir_basicblocks_t basicb
     if(basicblocks.length != 0){
         build_llvm_vtable_check_on_failure_block(llvm, func_skeleton, module_func);
     }
+
+    llvm->coroutine = (llvm_coroutine_t){0};
     
     for(length_t b = 0; b != basicblocks.length; b++){
         LLVMPositionBuilderAtEnd(builder, llvm_blocks[b]);
@@ -568,6 +1560,11 @@ errorcode_t ir_to_llvm_basicblocks(llvm_context_t *llvm, ir_basicblocks_t basicb
             return FAILURE;
         }
 
+        // Generators create their coroutine frame before doing anything else
+        if(b == 0 && module_func->traits & IR_FUNC_COROUTINE){
+            llvm_build_coroutine_begin(llvm, func_skeleton, &llvm_exit_blocks[0]);
+        }
+
         // Generate instructions
         if(ir_to_llvm_instructions(llvm, basicblock->instructions, b, f, llvm_blocks, llvm_exit_blocks)){
             return FAILURE;
@@ -593,7 +1590,8 @@ errorcode_t ir_to_llvm_basicblocks(llvm_context_t *llvm, ir_basicblocks_t basicb
     }
 
     // Remove basicblock and PHI nodes for vtable check failure pseudo-function if not used
-    if(module_func->traits & IR_FUNC_VALIDATE_VTABLE) {
+    // (Generators can't have any leftover incomplete PHI nodes, since they are split before code generation)
+    if(module_func->traits & (IR_FUNC_VALIDATE_VTABLE | IR_FUNC_COROUTINE)) {
         // NOTE: Assumes (LLVMCountIncoming(line_phi) == LLVMCountIncoming(column_phi))
         if(llvm->vtable_check.line_phi && LLVMCountIncoming(llvm->vtable_check.line_phi) == 0 && llvm->vtable_check.on_fail_block){
             LLVMDeleteBasicBlock(llvm->vtable_check.on_fail_block);
@@ -624,6 +1622,8 @@ errorcode_t ir_to_llvm_allocate_stack_variables(llvm_context_t *llvm, varstack_t
                 ? llvm->static_variables.variables[var->static_id].global
                 : LLVMBuildAlloca(builder, alloca_type, "");
 
+        ir_to_llvm_set_alignment(llvm, stack_frame->values[i], var->ir_type, var->alignment);
+
         stack_frame->types[i] = alloca_type;
 
         if(i < module_func->arity){
@@ -715,6 +1715,13 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
 
         switch(instr->id){
         case INSTRUCTION_RET:
+            if(llvm->coroutine.handle){
+                // Generators that are being destroyed skip their final suspension
+                LLVMValueRef is_destroying = LLVMBuildLoad2(builder, LLVMInt1Type(), llvm->coroutine.destroying, "");
+                LLVMBuildCondBr(builder, is_destroying, llvm->coroutine.cleanup_block, llvm->coroutine.final_block);
+                break;
+            }
+
             LLVMBuildRet(builder, ((ir_instr_ret_t*) instr)->value == NULL ? NULL : ir_to_llvm_value(llvm, ((ir_instr_ret_t*) instr)->value));
             break;
         case INSTRUCTION_ADD:
@@ -797,7 +1804,7 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
 
                 const char *implementation_name;
                 char stack_storage[256];
-                ir_func_t *target_ir_func = &llvm->object->ir_module.funcs.funcs[call_instr->ir_func_id];
+                ir_func_t *target_ir_func = ir_funcs_at(&llvm->object->ir_module.funcs, call_instr->ir_func_id);
 
                 if(target_ir_func->traits & IR_FUNC_VALIDATE_VTABLE){
                     // Validate that subject.__vtable__ is not NULL
@@ -822,6 +1829,13 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
                 LLVMTypeRef function_type = llvm->func_skeleton_types[call_instr->ir_func_id];
 
                 llvm_result = LLVMBuildCall2(builder, function_type, named_func, arguments, call_instr->values_length, "");
+                LLVMSetInstructionCallConv(llvm_result, LLVMGetFunctionCallConv(named_func));
+
+                // Calls made from flattened functions are inlined, unless the callee forbids it
+                if(ir_funcs_at(&llvm->object->ir_module.funcs, f)->traits & IR_FUNC_FLATTEN
+                && !(target_ir_func->traits & (IR_FUNC_FOREIGN | IR_FUNC_NO_INLINE | IR_FUNC_OPTIMIZE_NONE))){
+                    LLVMAddCallSiteAttribute(llvm_result, LLVMAttributeFunctionIndex, llvm_create_enum_attribute("alwaysinline", 0));
+                }
                 catalog->blocks[b].value_references[i] = llvm_result;
             }
             break;
@@ -883,8 +1897,7 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
             LLVMBuildBr(builder, llvm_blocks[((ir_instr_break_t*) instr)->block_id]);
             break;
         case INSTRUCTION_CONDBREAK:
-            LLVMBuildCondBr(builder, ir_to_llvm_value(llvm, ((ir_instr_cond_break_t*) instr)->value), llvm_blocks[((ir_instr_cond_break_t*) instr)->true_block_id],
-            llvm_blocks[((ir_instr_cond_break_t*) instr)->false_block_id]);
+            llvm_build_cond_break(llvm, (ir_instr_cond_break_t*) instr, llvm_blocks);
             break;
         case INSTRUCTION_EQUALS:
             llvm_result = LLVMBuildICmp(builder, LLVMIntEQ, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
@@ -952,20 +1965,21 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
         case INSTRUCTION_MEMBER: {
                 ir_instr_member_t *member_instr = (ir_instr_member_t*) instr;
                 LLVMValueRef foundation = ir_to_llvm_value(llvm, member_instr->value);
-                LLVMTypeRef struct_type = ir_to_llvm_type(llvm, ir_type_unwrap(member_instr->value->type));
+                ir_type_t *struct_ir_type = ir_type_unwrap(member_instr->value->type);
+                LLVMTypeRef struct_type = ir_to_llvm_type(llvm, struct_ir_type);
 
                 llvm_create_optional_null_check(llvm, f, foundation, member_instr->maybe_line_number, member_instr->maybe_column_number, &llvm_exit_blocks[b]);
 
                 LLVMValueRef gep_indices[] = {
                     LLVMConstInt(LLVMInt32Type(), 0, true),
-                    LLVMConstInt(LLVMInt32Type(), ((ir_instr_member_t*) instr)->member, true),
+                    LLVMConstInt(LLVMInt32Type(), ir_to_llvm_member_index(llvm, struct_ir_type, member_instr->member), true),
                 };
 
                 // For some reason, LLVM has problems with using a regular GEP for a constant value/indicies
                 catalog->blocks[b].value_references[i] =
                     LLVMIsConstant(foundation)
                         ? LLVMConstGEP2(struct_type, foundation, gep_indices, NUM_ITEMS(gep_indices))
-                        : LLVMBuildGEP2(builder, struct_type, foundation, gep_indices, NUM_ITEMS(gep_indices), "");
+                        : LLVMBuildInBoundsGEP2(builder, struct_type, foundation, gep_indices, NUM_ITEMS(gep_indices), "");
             }
             break;
         case INSTRUCTION_ARRAY_ACCESS: {
@@ -1073,7 +2087,9 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
             }
             break;
         case INSTRUCTION_OFFSETOF: {
-                unsigned long long offset = LLVMOffsetOfElement(llvm->data_layout, ir_to_llvm_type(llvm, ((ir_instr_offsetof_t*) instr)->type), ((ir_instr_offsetof_t*) instr)->index);
+                ir_instr_offsetof_t *offsetof_instr = (ir_instr_offsetof_t*) instr;
+                unsigned int index = ir_to_llvm_member_index(llvm, offsetof_instr->type, offsetof_instr->index);
+                unsigned long long offset = LLVMOffsetOfElement(llvm->data_layout, ir_to_llvm_type(llvm, offsetof_instr->type), index);
                 catalog->blocks[b].value_references[i] = LLVMConstInt(llvm->i64_type, offset, false);
             }
             break;
@@ -1099,8 +2115,10 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
                 LLVMTypeRef ty = ir_to_llvm_type(llvm, malloc_instr->type);
                 LLVMValueRef allocated;
 
+                bool is_over_aligned = llvm_needs_aligned_malloc(llvm, malloc_instr->type);
+
                 if(malloc_instr->amount == NULL){    
-                    allocated = LLVMBuildMalloc(builder, ty, "");
+                    allocated = is_over_aligned ? llvm_build_aligned_malloc(llvm, malloc_instr->type, NULL) : LLVMBuildMalloc(builder, ty, "");
                     catalog->blocks[b].value_references[i] = allocated;
                     
                     if(!(malloc_instr->is_undef || llvm->compiler->traits & COMPILER_UNSAFE_NEW)){
@@ -1108,7 +2126,7 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
                     }
                 } else {
                     LLVMValueRef count = ir_to_llvm_value(llvm, ((ir_instr_malloc_t*) instr)->amount);
-                    allocated = LLVMBuildArrayMalloc(builder, ty, count, "");
+                    allocated = is_over_aligned ? llvm_build_aligned_malloc(llvm, malloc_instr->type, count) : LLVMBuildArrayMalloc(builder, ty, count, "");
                     catalog->blocks[b].value_references[i] = allocated;
 
                     if(!(malloc_instr->is_undef || llvm->compiler->traits & COMPILER_UNSAFE_NEW)){
@@ -1128,7 +2146,7 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
             }
             break;
         case INSTRUCTION_FREE: {
-                catalog->blocks[b].value_references[i] = LLVMBuildFree(builder, ir_to_llvm_value(llvm, ((ir_instr_free_t*) instr)->value));
+                catalog->blocks[b].value_references[i] = llvm_build_free(llvm, ((ir_instr_free_t*) instr)->value);
             }
             break;
         case INSTRUCTION_MEMCPY: {
@@ -1178,9 +2196,14 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
         case INSTRUCTION_BIT_COMPLEMENT: {
                 unsigned int type_kind = ((ir_instr_unary_t*) instr)->value->type->kind;
                 LLVMValueRef base = ir_to_llvm_value(llvm, ((ir_instr_unary_t*) instr)->value);
-                
-                unsigned int bits = global_type_kind_sizes_in_bits_64[type_kind];
-                LLVMValueRef transform = LLVMConstInt(LLVMIntType(bits), (unsigned long long) ~0, global_type_kind_signs[type_kind]);
+                LLVMValueRef transform;
+
+                if(type_kind == TYPE_KIND_VECTOR){
+                    transform = LLVMConstAllOnes(LLVMTypeOf(base));
+                } else {
+                    unsigned int bits = global_type_kind_sizes_in_bits_64[type_kind];
+                    transform = LLVMConstInt(LLVMIntType(bits), (unsigned long long) ~0, global_type_kind_signs[type_kind]);
+                }
 
                 llvm_result = LLVMBuildXor(builder, base, transform, "");
                 catalog->blocks[b].value_references[i] = llvm_result;
@@ -1236,6 +2259,10 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
                     LLVMAddCase(switch_val, case_value, llvm_blocks[((ir_instr_switch_t*) instr)->case_block_ids[i]]);
                 }
 
+                if(((ir_instr_switch_t*) instr)->case_likely){
+                    llvm_set_switch_weights(switch_val, (ir_instr_switch_t*) instr);
+                }
+
                 catalog->blocks[b].value_references[i] = NULL;
             }
             break;
@@ -1254,6 +2281,8 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
                 if(alloc->alignment != 0){
                     LLVMSetAlignment(catalog->blocks[b].value_references[i], alloc->alignment);
                 }
+
+                ir_to_llvm_set_alignment(llvm, catalog->blocks[b].value_references[i], result_type->extra, 0);
             }
             break;
         case INSTRUCTION_STACK_SAVE: {
@@ -1393,6 +2422,51 @@ errorcode_t ir_to_llvm_instructions(llvm_context_t *llvm, ir_instrs_t instructio
         case INSTRUCTION_UNREACHABLE:
             LLVMBuildUnreachable(builder);
             break;
+        case INSTRUCTION_VECTOR_SPLAT: {
+                // Insert the scalar into the first lane, and then broadcast it to every lane
+                LLVMTypeRef vector_type = ir_to_llvm_type(llvm, instr->result_type);
+                LLVMValueRef zero = LLVMConstInt(LLVMInt32Type(), 0, false);
+                LLVMValueRef scalar = ir_to_llvm_value(llvm, ((ir_instr_cast_t*) instr)->value);
+                LLVMValueRef first = LLVMBuildInsertElement(builder, LLVMGetUndef(vector_type), scalar, zero, "");
+                LLVMValueRef zeros = LLVMConstNull(LLVMVectorType(LLVMInt32Type(), LLVMGetVectorSize(vector_type)));
+
+                catalog->blocks[b].value_references[i] = LLVMBuildShuffleVector(builder, first, LLVMGetUndef(vector_type), zeros, "");
+            }
+            break;
+        case INSTRUCTION_VECTOR_SHUFFLE: {
+                ir_instr_shuffle_t *shuffle_instr = (ir_instr_shuffle_t*) instr;
+                LLVMValueRef mask[length_max(1, shuffle_instr->mask_length)];
+
+                for(length_t m = 0; m != shuffle_instr->mask_length; m++){
+                    mask[m] = LLVMConstInt(LLVMInt32Type(), shuffle_instr->mask[m], false);
+                }
+
+                catalog->blocks[b].value_references[i] = LLVMBuildShuffleVector(builder,
+                    ir_to_llvm_value(llvm, shuffle_instr->a),
+                    ir_to_llvm_value(llvm, shuffle_instr->b),
+                    LLVMConstVector(mask, shuffle_instr->mask_length), "");
+            }
+            break;
+        case INSTRUCTION_VECTOR_REDUCE:
+            catalog->blocks[b].value_references[i] = llvm_build_vector_reduce(llvm, (ir_instr_vector_reduce_t*) instr);
+            break;
+        case INSTRUCTION_INTRINSIC:
+            catalog->blocks[b].value_references[i] = llvm_build_intrinsic(llvm, (ir_instr_intrinsic_t*) instr);
+            break;
+        case INSTRUCTION_ATOMIC_LOAD: case INSTRUCTION_ATOMIC_STORE: case INSTRUCTION_ATOMIC_RMW:
+        case INSTRUCTION_ATOMIC_CMPXCHG: case INSTRUCTION_FENCE:
+            catalog->blocks[b].value_references[i] = llvm_build_atomic(llvm, (ir_instr_atomic_t*) instr);
+            break;
+        case INSTRUCTION_PARALLEL_FOR:
+            llvm_build_parallel_for(llvm, (ir_instr_parallel_for_t*) instr);
+            break;
+        case INSTRUCTION_COROUTINE_SUSPEND:
+            catalog->blocks[b].value_references[i] = llvm_build_coroutine_suspend(llvm, (ir_instr_unary_t*) instr, &llvm_exit_blocks[b]);
+            break;
+        case INSTRUCTION_COROUTINE_RESUME: case INSTRUCTION_COROUTINE_DESTROY:
+        case INSTRUCTION_COROUTINE_DONE: case INSTRUCTION_COROUTINE_VALUE:
+            catalog->blocks[b].value_references[i] = llvm_build_coroutine_operation(llvm, (ir_instr_unary_t*) instr);
+            break;
         default:
             die("ir_to_llvm_instructions() - Unrecognized instruction '%d'\n", (int) instr->id);
         }
@@ -1410,11 +2484,17 @@ errorcode_t ir_to_llvm_globals(llvm_context_t *llvm, object_t *object){
     LLVMModuleRef module = llvm->module;
     char global_implementation_name[256];
 
+    // Constant casts within initializers are created through a builder,
+    // which only needs to fold them since no instructions are inserted
+    LLVMBuilderRef previous_builder = llvm->builder;
+    llvm->builder = LLVMCreateBuilder();
+
     for(length_t i = 0; i != anon_globals_length; i++){
         LLVMTypeRef anon_global_llvm_type = ir_to_llvm_type(llvm, anon_globals[i].type);
         llvm->anon_global_variables[i] = LLVMAddGlobal(module, anon_global_llvm_type, "");
         LLVMSetLinkage(llvm->anon_global_variables[i], LLVMPrivateLinkage);
         LLVMSetGlobalConstant(llvm->anon_global_variables[i], anon_globals[i].traits & IR_ANON_GLOBAL_CONSTANT);
+        ir_to_llvm_set_alignment(llvm, llvm->anon_global_variables[i], anon_globals[i].type, 0);
     }
 
     for(length_t i = 0; i != anon_globals_length; i++){
@@ -1433,14 +2513,22 @@ errorcode_t ir_to_llvm_globals(llvm_context_t *llvm, object_t *object){
 
         llvm->global_variables[i] = LLVMAddGlobal(module, global_llvm_type, is_external ? globals[i].name : global_implementation_name);
         LLVMSetLinkage(llvm->global_variables[i], is_external ? LLVMExternalLinkage : LLVMInternalLinkage);
+        ir_to_llvm_set_alignment(llvm, llvm->global_variables[i], globals[i].type, globals[i].alignment);
 
         if(globals[i].traits & IR_GLOBAL_THREAD_LOCAL)
             LLVMSetThreadLocal(llvm->global_variables[i], true);
         
         if(globals[i].trusted_static_initializer){
-            // Non-user static value initializer
-            // (Used for __types__ and __types_length__)
-            LLVMSetInitializer(llvm->global_variables[i], ir_to_llvm_value(llvm, globals[i].trusted_static_initializer));
+            // Static value initializer
+            // (Used for __types__ and __types_length__, and for user initial values known at compile-time)
+            LLVMValueRef initializer = ir_to_llvm_value(llvm, globals[i].trusted_static_initializer);
+
+            // Function addresses have the type of their function instead of the generic function pointer type
+            if(LLVMTypeOf(initializer) != global_llvm_type && LLVMGetTypeKind(global_llvm_type) == LLVMPointerTypeKind){
+                initializer = LLVMConstPointerCast(initializer, global_llvm_type);
+            }
+
+            LLVMSetInitializer(llvm->global_variables[i], initializer);
         } else if(!is_external){
             // In order to prevent the aggressive global elimination we'll perform later
             // from accidentally removing necessary user-defined global variables,
@@ -1451,6 +2539,8 @@ errorcode_t ir_to_llvm_globals(llvm_context_t *llvm, object_t *object){
         }
     }
 
+    LLVMDisposeBuilder(llvm->builder);
+    llvm->builder = previous_builder;
     return SUCCESS;
 }
 
@@ -1614,7 +2704,7 @@ errorcode_t ir_to_llvm_inject_init_built(llvm_context_t *llvm){
     llvm->stack = &stack_frame;
 
     length_t f = object->ir_module.common.ir_init_id;
-    ir_func_t *module_func = &object->ir_module.funcs.funcs[f];
+    ir_func_t *module_func = ir_funcs_at(&object->ir_module.funcs, f);
 
     LLVMBasicBlockRef *llvm_blocks = malloc(sizeof(LLVMBasicBlockRef) * basicblocks.length);
     LLVMValueRef func_skeleton = llvm->func_skeletons[f];
@@ -1708,7 +2798,7 @@ errorcode_t ir_to_llvm_inject_deinit_built(llvm_context_t *llvm){
         reset_on_failure_phis(llvm);
 
         length_t f = object->ir_module.common.ir_deinit_id;
-        ir_func_t *module_func = &object->ir_module.funcs.funcs[f];
+        ir_func_t *module_func = ir_funcs_at(&object->ir_module.funcs, f);
         errorcode = ir_to_llvm_basicblocks(llvm, basicblocks, func_skeleton, module_func, llvm_blocks, llvm_exit_blocks, f);
         free(llvm_blocks);
         free(llvm_exit_blocks);
@@ -14,7 +14,7 @@
 
 const char *any_type_kind_names[] = {
     "void", "bool", "byte", "ubyte", "short", "ushort", "int", "uint",
-    "long", "ulong", "float", "double", "pointer", "struct", "union", "function-pointer", "fixed-array", "enum"
+    "long", "ulong", "float", "double", "pointer", "struct", "union", "function-pointer", "fixed-array", "enum", "vector"
 };
 
 void any_inject_ast(ast_t *ast){
@@ -87,11 +87,11 @@ void any_inject_ast_AnyTypeKind(ast_t *ast){
     /*
     enum AnyTypeKind (
         VOID, BOOL, BYTE, UBYTE, SHORT, USHORT, INT, UINT, LONG,
-        ULONG, FLOAT, DOUBLE, PTR, STRUCT, UNION, FUNC_PTR, FIXED_ARRAY, ENUM
+        ULONG, FLOAT, DOUBLE, PTR, STRUCT, UNION, FUNC_PTR, FIXED_ARRAY, ENUM, VECTOR
     )
     */
 
-    weak_cstr_t *kinds = malloc(sizeof(weak_cstr_t) * 18);
+    weak_cstr_t *kinds = malloc(sizeof(weak_cstr_t) * 19);
     kinds[0]  = "VOID";
     kinds[1]  = "BOOL";
     kinds[2]  = "BYTE";
@@ -110,8 +110,9 @@ void any_inject_ast_AnyTypeKind(ast_t *ast){
     kinds[15] = "FUNC_PTR";
     kinds[16] = "FIXED_ARRAY";
     kinds[17] = "ENUM";
+    kinds[18] = "VECTOR";
 
-    ast_add_enum(ast, strclone("AnyTypeKind"), kinds, 18, NULL_SOURCE);
+    ast_add_enum(ast, strclone("AnyTypeKind"), kinds, 19, NULL_SOURCE);
 }
 
 void any_inject_ast_AnyPtrType(ast_t *ast){
@@ -29,7 +29,7 @@ ir_value_t* rtti_for(ir_builder_t *builder, ast_type_t *ast_type, source_t sourc
     maybe_index_t __types__ = ir_builder___types__(builder, source_on_failure);
     if(__types__ < 0) return NULL;
 
-    ir_value_t *placeholder_index = build_literal_usize(builder->pool, /* Will be filled in later */ 0);
+    ir_value_t *placeholder_index = build_placeholder_usize(builder->pool); // Will be filled in later
 
     ir_type_t *rtti_array_type = builder->object->ir_module.globals[__types__].type;
     ir_value_t *rtti_array = build_load(builder, build_gvarptr(builder, ir_type_make_pointer_to(builder->pool, rtti_array_type), __types__), NULL_SOURCE);
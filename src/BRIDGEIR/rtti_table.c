@@ -58,7 +58,7 @@ maybe_index_t rtti_table_find_index(const rtti_table_t *rtti_table, const char *
         }
     }
 
-    return comparison >= 0 ? middle : middle + 1;
+    return -1;
 }
 
 void rtti_table_free(rtti_table_t *rtti_table){
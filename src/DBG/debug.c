@@ -34,6 +34,13 @@ void handle_debug_signal(compiler_t *compiler, unsigned int sig, void *data){
     case DEBUG_SIGNAL_AT_IR_MODULE_DUMP:
         if(compiler->debug_traits & COMPILER_DEBUG_DUMP) ir_module_dump((ir_module_t*) data, "ir.txt");
         break;
+    case DEBUG_SIGNAL_AT_IR_MODULE_STATS:
+        if(compiler->debug_traits & COMPILER_DEBUG_STATS){
+            printf("STATS: %zu devirtualized call sites\n", ((ir_module_t*) data)->devirtualized_calls);
+            printf("STATS: %zu functions merged with identical functions\n", ((ir_module_t*) data)->merged_funcs);
+            printf("STATS: %zu unreachable runtime type table entries stripped\n", ((ir_module_t*) data)->stripped_rtti);
+        }
+        break;
     default:
         printf("Unknown debug signal %08X\n", (int) sig);
     }
@@ -38,6 +38,7 @@
 #include "UTIL/string.h"
 #include "UTIL/string_builder.h"
 #include "UTIL/string_list.h"
+#include "UTIL/thread_pool.h"
 #include "UTIL/trait.h"
 #include "UTIL/util.h"
 
@@ -46,6 +47,7 @@
 #include "DBG/debug.h"
 #include "INFER/infer.h"
 #include "IR/ir_module.h"
+#include "IR/ir_pass.h"
 #include "IRGEN/ir_gen.h"
 #include "IRGEN/ir_gen_polymorphable.h"
 #endif
@@ -192,6 +194,7 @@ void compiler_invoke(compiler_t *compiler, int argc, char **argv){
     if(ir_gen(compiler, object)) return;
 
     debug_signal(compiler, DEBUG_SIGNAL_AT_IR_MODULE_DUMP, &object->ir_module);
+    debug_signal(compiler, DEBUG_SIGNAL_AT_IR_MODULE_STATS, &object->ir_module);
     debug_signal(compiler, DEBUG_SIGNAL_AT_EXPORT, NULL);
     
     if(ir_export(compiler, object, BACKEND_LLVM)) return;
@@ -240,6 +243,12 @@ void compiler_init(compiler_t *compiler){
     compiler->optimization = OPTIMIZATION_LESS;
     compiler->checks = TRAIT_NONE;
 
+    #ifndef ADEPT_INSIGHT_BUILD
+    compiler->ir_passes = IR_PASS_ALL;
+    #else
+    compiler->ir_passes = TRAIT_NONE;
+    #endif
+
     #if __linux__
     compiler->use_pic = TROOLEAN_TRUE;
     #else
@@ -247,6 +256,7 @@ void compiler_init(compiler_t *compiler){
     #endif
 
     compiler->use_libm = TROOLEAN_FALSE;
+    compiler->use_libpthread = false;
     compiler->extract_import_order = false;
 
     #ifdef ENABLE_DEBUG_FEATURES
@@ -260,6 +270,7 @@ void compiler_init(compiler_t *compiler){
     compiler->warnings_capacity = 0;
     compiler->show_unused_variables_how_to_disable = false;
     compiler->cross_compile_for = CROSS_COMPILE_NONE;
+    compiler->capture = NULL;
     compiler->entry_point = "main";
     string_builder_init(&compiler->user_linker_options);
     compiler->user_search_paths = (strong_cstr_list_t){0};
@@ -444,6 +455,8 @@ errorcode_t parse_arguments(compiler_t *compiler, object_t *object, int argc, ch
                 compiler->optimization = OPTIMIZATION_AGGRESSIVE;
             } else if(streq(arg, "--fussy")){
                 compiler->traits |= COMPILER_FUSSY;
+            } else if(streq(arg, "--lazy")){
+                compiler->traits |= COMPILER_LAZY;
             } else if(streq(arg, "-v") || streq(arg, "--version")){
                 show_version(compiler);
                 return FAILURE;
@@ -454,12 +467,29 @@ errorcode_t parse_arguments(compiler_t *compiler, object_t *object, int argc, ch
                 compiler->traits |= COMPILER_NO_UNDEF;
             } else if(streq(arg, "--no-type-info") || streq(arg, "--no-typeinfo")){
                 compiler->traits |= COMPILER_NO_TYPEINFO;
+            } else if(streq(arg, "--strip-typeinfo")){
+                compiler->traits |= COMPILER_STRIP_TYPEINFO;
+            } else if(streq(arg, "--reorder-fields")){
+                compiler->traits |= COMPILER_REORDER_FIELDS;
             } else if(streq(arg, "--unsafe-meta")){
                 compiler->traits |= COMPILER_UNSAFE_META;
             } else if(streq(arg, "--unsafe-new")){
                 compiler->traits |= COMPILER_UNSAFE_NEW;
             } else if(streq(arg, "--null-checks")){
                 compiler->checks |= COMPILER_NULL_CHECKS;
+            } else if(streq(arg, "--no-ir-passes")){
+                compiler->ir_passes = TRAIT_NONE;
+            } else if(strncmp(arg, "--no-ir-pass=", 13) == 0){
+                #ifndef ADEPT_INSIGHT_BUILD
+                trait_t pass = ir_pass_from_name(&arg[13]);
+
+                if(pass == IR_PASS_NONE){
+                    redprintf("Unknown IR pass '%s'\n", &arg[13]);
+                    return FAILURE;
+                }
+
+                compiler->ir_passes &= ~pass;
+                #endif
             } else if(streq(arg, "--ignore-all")){
                 compiler->ignore |= COMPILER_IGNORE_ALL;
             } else if(streq(arg, "--ignore-deprecation")){
@@ -574,6 +604,18 @@ errorcode_t parse_arguments(compiler_t *compiler, object_t *object, int argc, ch
                 compiler->debug_traits |= COMPILER_DEBUG_NO_VERIFICATION;
             } else if(streq(arg, "--no-result")){
                 compiler->debug_traits |= COMPILER_DEBUG_NO_RESULT;
+            } else if(streq(arg, "--stats")){
+                compiler->debug_traits |= COMPILER_DEBUG_STATS;
+            } else if(strncmp(arg, "--workers=", 10) == 0){
+                char *end;
+                unsigned long worker_count = strtoul(&arg[10], &end, 10);
+
+                if(arg[10] == '\0' || *end != '\0' || worker_count == 0){
+                    redprintf("Invalid worker count '%s'\n", &arg[10]);
+                    return FAILURE;
+                }
+
+                thread_pool_force_worker_count(worker_count);
             } else if(streq(arg, "--no-update")){
                 // Ignore, this argument is handled before argument parsing
             }
@@ -747,8 +789,10 @@ void show_help(bool show_advanced_options){
     printf("    --windowed        Don't open console with executable (only applies to Windows)\n");
     printf("    -std=2.x          Set standard library version\n");
     
-    if(show_advanced_options)
+    if(show_advanced_options){
         printf("    --fussy           Show insignificant warnings\n");
+        printf("    --lazy            Only generate code reachable from the entry point\n");
+    }
 
     printf("    --version         Display compiler version\n");
     printf("    --root            Display root folder\n");
@@ -757,6 +801,8 @@ void show_help(bool show_advanced_options){
     if(show_advanced_options){
         printf("\nLanguage Options:\n");
         printf("    --no-type-info    Disable runtime type information\n");
+        printf("    --strip-typeinfo  Only keep runtime type information that is reachable\n");
+        printf("    --reorder-fields  Reorder fields of eligible structs to minimize padding\n");
         printf("    --no-undef        Force initialize for 'undef'\n");
         printf("    --unsafe-meta     Allow unsafe usage of meta constructs\n");
         printf("    --unsafe-new      Disables zero-initialization of memory allocated with new\n");
@@ -766,6 +812,8 @@ void show_help(bool show_advanced_options){
         printf("\nMachine Code Options:\n");
         printf("    --PIC             Forces PIC relocation model\n");
         printf("    --no-PIC          Forbids PIC relocation model\n");
+        printf("    --no-ir-passes    Disable IR cleanup passes\n");
+        printf("    --no-ir-pass=NAME Disable an IR cleanup pass (forward, fold, dce, thread, unreachable, merge, icf)\n");
 
         printf("\nCross Compilation:\n");
         printf("    --windows         Output Windows Executable (Requires Extension)\n");
@@ -795,6 +843,8 @@ void show_help(bool show_advanced_options){
     printf("    --llvmir          Show generated LLVM representation\n");
     printf("    --no-verification Don't verify backend output\n");
     printf("    --no-result       Don't create final binary\n");
+    printf("    --stats           Show optimization statistics\n");
+    printf("    --workers=N       Use N threads for every parallel stage\n");
     #endif // ENABLE_DEBUG_FEATURES
 }
 
@@ -955,7 +1005,31 @@ void compiler_print_source(compiler_t *compiler, int line, source_t source){
     printf("\n");
 }
 
+static strong_cstr_t compiler_vformat(const char *format, va_list args){
+    va_list measure_args;
+    va_copy(measure_args, args);
+    int length = vsnprintf(NULL, 0, format, measure_args);
+    va_end(measure_args);
+
+    strong_cstr_t buffer = malloc(length > 0 ? length + 1 : 1);
+    vsnprintf(buffer, length > 0 ? length + 1 : 1, format, args);
+    return buffer;
+}
+
+static void compiler_capture(compiler_t *compiler, unsigned int kind, source_t source, maybe_null_strong_cstr_t message){
+    compiler_diagnostics_append(compiler->capture, ((compiler_diagnostic_t){
+        .kind = kind,
+        .source = source,
+        .message = message,
+    }));
+}
+
 void compiler_panic(compiler_t *compiler, source_t source, const char *message){
+    if(compiler->capture){
+        compiler_capture(compiler, COMPILER_DIAGNOSTIC_PANIC, source, message ? strclone(message) : NULL);
+        return;
+    }
+
     #if !defined(ADEPT_INSIGHT_BUILD) || defined(__EMSCRIPTEN__)
     object_t *relevant_object = compiler->objects[source.object_index];
     int line, column;
@@ -999,6 +1073,11 @@ void compiler_panicf(compiler_t *compiler, source_t source, const char *format,
 }
 
 void compiler_vpanicf(compiler_t *compiler, source_t source, const char *format, va_list args){
+    if(compiler->capture){
+        compiler_capture(compiler, COMPILER_DIAGNOSTIC_PANICF, source, format ? compiler_vformat(format, args) : NULL);
+        return;
+    }
+
     #if !defined(ADEPT_INSIGHT_BUILD) || defined(__EMSCRIPTEN__)
     object_t *relevant_object = compiler->objects[source.object_index];
     int line, column;
@@ -1057,7 +1136,14 @@ bool compiler_warn(compiler_t *compiler, source_t source, const char *message){
         compiler_panic(compiler, source, message);
         return true;
     }
-    
+    #endif
+
+    if(compiler->capture){
+        compiler_capture(compiler, COMPILER_DIAGNOSTIC_WARN, source, strclone(message));
+        return false;
+    }
+
+    #if !defined(ADEPT_INSIGHT_BUILD) || defined(__EMSCRIPTEN__)
     object_t *relevant_object = compiler->objects[source.object_index];
     int line, column;
     lex_get_location(relevant_object->buffer, source.index, &line, &column);
@@ -1095,6 +1181,11 @@ bool compiler_warnf(compiler_t *compiler, source_t source, const char *format, .
 void compiler_vwarnf(compiler_t *compiler, source_t source, const char *format, va_list args){
     if(compiler->traits & COMPILER_NO_WARN) return;
 
+    if(compiler->capture){
+        compiler_capture(compiler, COMPILER_DIAGNOSTIC_WARNF, source, compiler_vformat(format, args));
+        return;
+    }
+
     #if !defined(ADEPT_INSIGHT_BUILD) || defined(__EMSCRIPTEN__)
     object_t *relevant_object = compiler->objects[source.object_index];
     int line, column;
@@ -1129,6 +1220,58 @@ void compiler_vwarnf(compiler_t *compiler, source_t source, const char *format,
     va_end(warning_format_args);
 }
 
+void compiler_hintf(compiler_t *compiler, const char *format, ...){
+    va_list args;
+    va_start(args, format);
+
+    if(compiler->capture){
+        compiler_capture(compiler, COMPILER_DIAGNOSTIC_HINT, NULL_SOURCE, compiler_vformat(format, args));
+    } else {
+        vprintf(format, args);
+    }
+
+    va_end(args);
+}
+
+void compiler_diagnostics_replay(compiler_t *compiler, compiler_diagnostics_t *diagnostics){
+    for(length_t i = 0; i != diagnostics->length; i++){
+        compiler_diagnostic_t *diagnostic = &diagnostics->diagnostics[i];
+
+        switch(diagnostic->kind){
+        case COMPILER_DIAGNOSTIC_PANIC:
+            compiler_panic(compiler, diagnostic->source, diagnostic->message);
+            break;
+        case COMPILER_DIAGNOSTIC_PANICF:
+            if(diagnostic->message){
+                compiler_panicf(compiler, diagnostic->source, "%s", diagnostic->message);
+            } else {
+                compiler_panicf(compiler, diagnostic->source, NULL);
+            }
+            break;
+        case COMPILER_DIAGNOSTIC_WARN:
+            compiler_warn(compiler, diagnostic->source, diagnostic->message);
+            break;
+        case COMPILER_DIAGNOSTIC_WARNF:
+            compiler_warnf(compiler, diagnostic->source, "%s", diagnostic->message);
+            break;
+        case COMPILER_DIAGNOSTIC_HINT:
+            printf("%s", diagnostic->message);
+            break;
+        }
+    }
+
+    compiler_diagnostics_free(diagnostics);
+}
+
+void compiler_diagnostics_free(compiler_diagnostics_t *diagnostics){
+    for(length_t i = 0; i != diagnostics->length; i++){
+        free(diagnostics->diagnostics[i].message);
+    }
+
+    free(diagnostics->diagnostics);
+    *diagnostics = (compiler_diagnostics_t){0};
+}
+
 #if !defined(ADEPT_INSIGHT_BUILD) || defined(__EMSCRIPTEN__)
 void compiler_undeclared_function(compiler_t *compiler, object_t *object, source_t source,
         weak_cstr_t name, ast_type_t *types, length_t arity, ast_type_t *gives, bool is_method){
@@ -1152,7 +1295,7 @@ void compiler_undeclared_function(compiler_t *compiler, object_t *object, source
             compiler_panicf(compiler, source, "Undeclared function '%s'", name);
 
             if(streq(name, "__assertion_failed__")){
-                printf("\nDo you mean to use the standard failed-assertion handlers? `import assertions`\n");
+                compiler_hintf(compiler, "\nDo you mean to use the standard failed-assertion handlers? `import assertions`\n");
             }
         }
         goto success;
@@ -1183,11 +1326,11 @@ void compiler_undeclared_function(compiler_t *compiler, object_t *object, source
         free(gives_string);
         free(args_string);
 
-        printf("Potential Candidates:\n");
+        compiler_hintf(compiler, "Potential Candidates:\n");
     }
 
     for(length_t i = 0; i != possibilities.length; i++){
-        print_candidate(&ast->funcs[possibilities.ids[i]]);
+        print_candidate(compiler, ast_funcs_at(&ast->funcs, possibilities.ids[i]));
     }
 
 success:
@@ -1218,8 +1361,8 @@ func_id_list_t compiler_possibilities(compiler_t *compiler, object_t *object, we
     ast_t *ast = &object->ast;
     func_id_list_t list = {0};
 
-    for(length_t id = 0; id != ast->funcs_length; id++){
-        ast_func_t *func = &ast->funcs[id];
+    for(length_t id = 0; id != ast->funcs.length; id++){
+        ast_func_t *func = ast_funcs_at(&ast->funcs, id);
 
         if(streq(func->name, name) && (func->traits & (AST_FUNC_VIRTUAL | AST_FUNC_OVERRIDE | AST_FUNC_NO_SUGGEST)) == TRAIT_NONE){
             if(methods_only_type_of_this){
@@ -1237,10 +1380,10 @@ func_id_list_t compiler_possibilities(compiler_t *compiler, object_t *object, we
 }
 #endif
 
-void print_candidate(ast_func_t *ast_func){
+void print_candidate(compiler_t *compiler, ast_func_t *ast_func){
     strong_cstr_t return_type_string = ast_type_str(&ast_func->return_type);
     strong_cstr_t args_string = make_args_string(ast_func->arg_types, ast_func->arg_defaults, ast_func->arity, ast_func->traits);
-    printf("    %s(%s) %s\n", ast_func->name, args_string ? args_string : "", return_type_string);
+    compiler_hintf(compiler, "    %s(%s) %s\n", ast_func->name, args_string ? args_string : "", return_type_string);
     free(args_string);
     free(return_type_string);
 }
@@ -12,7 +12,7 @@ void object_create_module(object_t *object){
     ir_module_t *module = &object->ir_module;
 
     // Initialize module
-    ir_module_init(module, ast->funcs_length, ast->globals_length, ast->funcs_length + ast->func_aliases_length + 32);
+    ir_module_init(module, ast->globals_length, ast->funcs.length + ast->func_aliases_length + 32);
 
     // Advance compilation stage
     object->compilation_stage = COMPILATION_STAGE_IR_MODULE;
@@ -4,15 +4,18 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "AST/ast_expr.h"
 #include "AST/ast_type.h"
 #include "AST/ast_poly_catalog.h"
 #include "AST/POLY/ast_resolve.h"
+#include "PARSE/parse_func.h"
 #include "UTIL/builtin_type.h"
 #include "UTIL/color.h"
 #include "UTIL/levenshtein.h"
 #include "UTIL/string.h"
+#include "UTIL/thread_pool.h"
 #include "UTIL/util.h"
 
 errorcode_t infer(compiler_t *compiler, object_t *object){
@@ -40,11 +43,18 @@ errorcode_t infer(compiler_t *compiler, object_t *object){
     qsort(ast->aliases, ast->aliases_length, sizeof(ast_alias_t), ast_aliases_cmp);
     qsort(ast->enums, ast->enums_length, sizeof(ast_enum_t), ast_enums_cmp);
     qsort(ast->globals, ast->globals_length, sizeof(ast_global_t), ast_globals_cmp);
+    qsort(ast->soas, ast->soas_length, sizeof(ast_soa_t), ast_soas_cmp);
+
+    // SoA containers must be synthesized before composites are inferred,
+    // so that their columns are inferred along with everything else
+    if(infer_in_soas(&ctx, ast->soas, ast->soas_length)){
+        return FAILURE;
+    }
 
     if(infer_in_composites(&ctx, ast->composites, ast->composites_length)
     || infer_in_poly_composites(&ctx, ast->poly_composites, ast->poly_composites_length)
     || infer_in_globals(&ctx, ast->globals, ast->globals_length)
-    || infer_in_funcs(&ctx, ast->funcs, ast->funcs_length)
+    || infer_in_funcs(&ctx, &ast->funcs)
     || infer_in_func_aliases(&ctx, ast->func_aliases, ast->func_aliases_length)){
         return FAILURE;
     }
@@ -89,6 +99,97 @@ errorcode_t infer_in_composites(infer_ctx_t *ctx, ast_composite_t *composites, l
     return SUCCESS;
 }
 
+static ast_type_t infer_soa_column_type(ast_elem_t *capacity, ast_type_t *field_type){
+    // Creates the type 'N FieldType' for a column of an SoA container
+
+    ast_type_t column = ast_type_clone(field_type);
+
+    ast_elem_t **elements = malloc(sizeof(ast_elem_t*) * (column.elements_length + 1));
+    memcpy(&elements[1], column.elements, sizeof(ast_elem_t*) * column.elements_length);
+    elements[0] = ast_elem_clone(capacity);
+
+    free(column.elements);
+    column.elements = elements;
+    column.elements_length++;
+    return column;
+}
+
+static bool infer_soa_field_is_in_union(ast_layout_t *layout, ast_layout_endpoint_t endpoint){
+    ast_layout_endpoint_path_t path;
+
+    if(!ast_layout_get_path(layout, endpoint, &path)) return true;
+
+    for(length_t i = 0; i < AST_LAYOUT_MAX_DEPTH && path.waypoints[i].kind != AST_LAYOUT_WAYPOINT_END; i++){
+        if(path.waypoints[i].kind == AST_LAYOUT_WAYPOINT_BITCAST) return true;
+    }
+
+    return false;
+}
+
+errorcode_t infer_in_soas(infer_ctx_t *ctx, ast_soa_t *soas, length_t soas_length){
+    for(length_t i = 0; i != soas_length; i++){
+        ast_soa_t *soa = &soas[i];
+
+        if(infer_type(ctx, &soa->type)) return FAILURE;
+
+        // Only fixed arrays of named structs can be split into columns
+        if(soa->type.elements_length != 2 || soa->type.elements[0]->id != AST_ELEM_FIXED_ARRAY || soa->type.elements[1]->id != AST_ELEM_BASE){
+            strong_cstr_t s = ast_type_str(&soa->type);
+            compiler_panicf(ctx->compiler, soa->type.source, "Expected fixed array of struct type for SoA container '%s', got '%s'", soa->name, s);
+            free(s);
+            return FAILURE;
+        }
+
+        weak_cstr_t element_name = ((ast_elem_base_t*) soa->type.elements[1])->base;
+        ast_composite_t *element = ast_composite_find_exact(ctx->ast, element_name);
+
+        if(element == NULL || element->layout.kind != AST_LAYOUT_STRUCT || element->is_class){
+            compiler_panicf(ctx->compiler, soa->type.source, "Element type '%s' of SoA container '%s' must be a struct", element_name, soa->name);
+            return FAILURE;
+        }
+
+        if(ast_find_soa(soas, soas_length, element_name) != -1){
+            compiler_panicf(ctx->compiler, soa->type.source, "Element type of SoA container '%s' can't be another SoA container", soa->name);
+            return FAILURE;
+        }
+
+        ast_field_map_t *field_map = &element->layout.field_map;
+        length_t length = field_map->arrows_length;
+
+        strong_cstr_t *names = malloc(sizeof(strong_cstr_t) * length);
+        ast_type_t *types = malloc(sizeof(ast_type_t) * length);
+
+        // Create a column for every field, including those of anonymous structs
+        for(length_t j = 0; j != length; j++){
+            ast_field_arrow_t *arrow = &field_map->arrows[j];
+            ast_type_t *field_type = ast_layout_skeleton_get_type(&element->layout.skeleton, arrow->endpoint);
+
+            if(field_type == NULL || infer_soa_field_is_in_union(&element->layout, arrow->endpoint)){
+                compiler_panicf(ctx->compiler, soa->type.source, "Element type '%s' of SoA container '%s' can't contain unions", element_name, soa->name);
+                free_strings(names, j);
+                ast_types_free_fully(types, j);
+                return FAILURE;
+            }
+
+            names[j] = strclone(arrow->name);
+            types[j] = infer_soa_column_type(soa->type.elements[0], field_type);
+        }
+
+        ast_layout_t layout;
+        ast_layout_init_with_struct_fields(&layout, names, types, length);
+        free(names);
+        free(types);
+
+        ast_type_t element_type = ast_type_unwrapped_view(&soa->type);
+        soa->element_type = ast_type_clone(&element_type);
+
+        // NOTE: Invalidates 'element'
+        ast_add_composite(ctx->ast, strclone(soa->name), layout, soa->source, AST_TYPE_NONE, false);
+    }
+
+    return SUCCESS;
+}
+
 errorcode_t infer_in_poly_composites(infer_ctx_t *ctx, ast_poly_composite_t *poly_composites, length_t poly_composites_length){
     for(length_t i = 0; i != poly_composites_length; i++){
         ast_poly_composite_t *poly_composite = &poly_composites[i];
@@ -119,71 +220,227 @@ errorcode_t infer_in_globals(infer_ctx_t *ctx, ast_global_t *globals, length_t g
     return SUCCESS;
 }
 
-errorcode_t infer_in_funcs(infer_ctx_t *ctx, ast_func_t *funcs, length_t funcs_length){
+// Minimum number of functions for each worker when inferring functions in parallel,
+// so that small programs don't pay for starting threads
+#define INFER_FUNCS_MIN_PER_WORKER 64
+
+static bool infer_func_arg_is_force_used(compiler_t *compiler, ast_func_t *function, length_t a){
+    return compiler->ignore & COMPILER_IGNORE_UNUSED
+        || function->traits & (AST_FUNC_MAIN | AST_FUNC_DISALLOW | AST_FUNC_DISPATCHER)
+        || (a == 0 && streq(function->arg_names[a], "this"));
+}
+
+static errorcode_t infer_in_func(infer_ctx_t *ctx, ast_func_t *function, bool defer_bodies){
     infer_var_scope_t indirect_func_scope_storage;
     infer_var_scope_t *previous_scope = ctx->scope;
     bool variadic_functions_are_allowed = ctx->object->ast.common.ast_variadic_array != NULL;
 
-    for(length_t f = 0; f != funcs_length; f++){
-        ast_func_t *function = &funcs[f];
+    // If the function is variadic, ensure that variadic functions are allowed
+    if(function->traits & AST_FUNC_VARIADIC && !variadic_functions_are_allowed){
+        compiler_panic(ctx->compiler, function->source, "In order to use variadic functions, __variadic_array__ must be defined");
+        compiler_hintf(ctx->compiler, "\nTry importing '%s/VariadicArray.adept'\n", ADEPT_VERSION_STRING);
+        return FAILURE;
+    }
 
-        // If the function is variadic, ensure that variadic functions are allowed
-        if(function->traits & AST_FUNC_VARIADIC && !variadic_functions_are_allowed){
-            compiler_panic(ctx->compiler, function->source, "In order to use variadic functions, __variadic_array__ must be defined");
-            printf("\nTry importing '%s/VariadicArray.adept'\n", ADEPT_VERSION_STRING);
-            return FAILURE;
-        }
+    // Create inference variable scope for function
+    ctx->scope = &indirect_func_scope_storage;
+    infer_var_scope_init(ctx->scope, NULL);
+    
+    // Resolve aliases in function return type
+    if(infer_type(ctx, &function->return_type)){
+        ctx->scope = previous_scope;
+        return FAILURE;
+    }
 
-        // Create inference variable scope for function
-        ctx->scope = &indirect_func_scope_storage;
-        infer_var_scope_init(ctx->scope, NULL);
-        
-        // Resolve aliases in function return type
-        if(infer_type(ctx, &function->return_type)){
+    // Resolve aliases in function arguments
+    for(length_t a = 0; a != function->arity; a++){
+        if(infer_type(ctx, &function->arg_types[a])) {
             ctx->scope = previous_scope;
             return FAILURE;
         }
 
-        // Resolve aliases in function arguments
-        for(length_t a = 0; a != function->arity; a++){
-            if(infer_type(ctx, &function->arg_types[a])) {
+        if(function->arg_defaults && function->arg_defaults[a]){
+            unsigned int default_primitive = ast_primitive_from_ast_type(&function->arg_types[a]);
+            if(infer_expr(ctx, function, &function->arg_defaults[a], default_primitive, false)){
+                infer_var_scope_free(ctx->compiler, ctx->scope);
                 ctx->scope = previous_scope;
                 return FAILURE;
             }
-
-            if(function->arg_defaults && function->arg_defaults[a]){
-                unsigned int default_primitive = ast_primitive_from_ast_type(&funcs[f].arg_types[a]);
-                if(infer_expr(ctx, function, &function->arg_defaults[a], default_primitive, false)){
-                    infer_var_scope_free(ctx->compiler, ctx->scope);
-                    ctx->scope = previous_scope;
-                    return FAILURE;
-                }
-            }
-
-            if(!(function->traits & AST_FUNC_FOREIGN)){
-                const bool force_used =
-                    ctx->compiler->ignore & COMPILER_IGNORE_UNUSED
-                    || function->traits & (AST_FUNC_MAIN | AST_FUNC_DISALLOW | AST_FUNC_DISPATCHER)
-                    || (a == 0 && streq(function->arg_names[a], "this"));
-                
-                infer_var_scope_ir_builder_add_variable(ctx->scope, function->arg_names[a], &function->arg_types[a], function->arg_sources[a], force_used, false);
-            }
         }
 
-        if(function->traits & AST_FUNC_VARIADIC){
-            // Add variadic array variable
-            infer_var_scope_ir_builder_add_variable(ctx->scope, function->variadic_arg_name, ctx->ast->common.ast_variadic_array, function->variadic_source, false, false);
+        if(!(function->traits & AST_FUNC_FOREIGN)){
+            // Arguments of deferred bodies are only present for default values,
+            // whether they're used is determined once the body is inferred
+            const bool force_used = defer_bodies || infer_func_arg_is_force_used(ctx->compiler, function, a);
+            
+            infer_var_scope_ir_builder_add_variable(ctx->scope, function->arg_names[a], &function->arg_types[a], function->arg_sources[a], force_used, false);
         }
-        
-        // Infer expressions in statements
-        if(infer_in_stmts(ctx, function, &function->statements)){
-            infer_var_scope_free(ctx->compiler, ctx->scope);
-            ctx->scope = previous_scope;
-            return FAILURE;
+    }
+
+    if(defer_bodies){
+        if(!(function->traits & AST_FUNC_FOREIGN)){
+            function->traits |= AST_FUNC_INFER_PENDING;
         }
 
         infer_var_scope_free(ctx->compiler, ctx->scope);
         ctx->scope = previous_scope;
+        return SUCCESS;
+    }
+
+    if(function->traits & AST_FUNC_VARIADIC){
+        // Add variadic array variable
+        infer_var_scope_ir_builder_add_variable(ctx->scope, function->variadic_arg_name, ctx->ast->common.ast_variadic_array, function->variadic_source, false, false);
+    }
+    
+    // Infer expressions in statements
+    if(infer_in_stmts(ctx, function, &function->statements)){
+        infer_var_scope_free(ctx->compiler, ctx->scope);
+        ctx->scope = previous_scope;
+        return FAILURE;
+    }
+
+    infer_var_scope_free(ctx->compiler, ctx->scope);
+    ctx->scope = previous_scope;
+    return SUCCESS;
+}
+
+// ---------------- infer_func_result_t ----------------
+// Outcome of inferring a single function on a worker thread
+typedef struct {
+    errorcode_t errorcode;
+    compiler_diagnostics_t diagnostics;
+    trait_t ignore;
+    bool show_unused_variables_how_to_disable;
+} infer_func_result_t;
+
+// ---------------- infer_funcs_job_t ----------------
+// Shared state for inferring functions on multiple threads
+typedef struct {
+    infer_ctx_t *ctx;
+    ast_funcs_t *funcs;
+    compiler_t *worker_compilers;
+    infer_func_result_t *results;
+} infer_funcs_job_t;
+
+static void infer_funcs_task(void *data, length_t worker, length_t f){
+    infer_funcs_job_t *job = (infer_funcs_job_t*) data;
+    infer_func_result_t *result = &job->results[f];
+
+    // Diagnostics and compiler state changes are kept per function,
+    // so that they can be applied in order once every function is done
+    compiler_t *compiler = &job->worker_compilers[worker];
+    compiler->capture = &result->diagnostics;
+    compiler->ignore = job->ctx->compiler->ignore;
+    compiler->show_unused_variables_how_to_disable = false;
+
+    infer_ctx_t ctx = *job->ctx;
+    ctx.compiler = compiler;
+
+    result->errorcode = infer_in_func(&ctx, ast_funcs_at(job->funcs, f), false);
+    result->ignore = compiler->ignore;
+    result->show_unused_variables_how_to_disable = compiler->show_unused_variables_how_to_disable;
+}
+
+errorcode_t infer_in_funcs(infer_ctx_t *ctx, ast_funcs_t *funcs){
+    // When compiling lazily, function bodies are inferred the first time they're needed instead.
+    // Fussy builds still infer everything up front, so that they get complete diagnostics
+    bool defer_bodies = ctx->compiler->traits & COMPILER_LAZY && !(ctx->compiler->traits & COMPILER_FUSSY);
+
+    length_t worker_count = defer_bodies ? 1 : thread_pool_worker_count(funcs->length, INFER_FUNCS_MIN_PER_WORKER);
+
+    if(worker_count == 1){
+        for(length_t f = 0; f != funcs->length; f++){
+            if(infer_in_func(ctx, ast_funcs_at(funcs, f), defer_bodies)) return FAILURE;
+        }
+        return SUCCESS;
+    }
+
+    // Function bodies don't depend on each other, so they can be inferred concurrently.
+    // Each worker uses its own copy of the compiler that captures diagnostics instead of printing them
+    infer_funcs_job_t job = (infer_funcs_job_t){
+        .ctx = ctx,
+        .funcs = funcs,
+        .worker_compilers = malloc(sizeof(compiler_t) * worker_count),
+        .results = calloc(funcs->length, sizeof(infer_func_result_t)),
+    };
+
+    for(length_t i = 0; i != worker_count; i++){
+        compiler_t *compiler = &job.worker_compilers[i];
+        *compiler = *ctx->compiler;
+        compiler->error = NULL;
+        compiler->warnings = NULL;
+        compiler->warnings_length = 0;
+        compiler->warnings_capacity = 0;
+    }
+
+    thread_pool_run(funcs->length, worker_count, infer_funcs_task, &job);
+
+    // Report the results in order, stopping at the first function that failed
+    errorcode_t errorcode = SUCCESS;
+
+    for(length_t f = 0; f != funcs->length; f++){
+        infer_func_result_t *result = &job.results[f];
+
+        if(errorcode){
+            compiler_diagnostics_free(&result->diagnostics);
+            continue;
+        }
+
+        compiler_diagnostics_replay(ctx->compiler, &result->diagnostics);
+        ctx->compiler->ignore |= result->ignore;
+
+        if(result->show_unused_variables_how_to_disable){
+            ctx->compiler->show_unused_variables_how_to_disable = true;
+        }
+
+        errorcode = result->errorcode;
+    }
+
+    free(job.results);
+    free(job.worker_compilers);
+    return errorcode;
+}
+
+errorcode_t infer_func_body_on_demand(compiler_t *compiler, object_t *object, func_id_t ast_func_id){
+    ast_func_t *function = ast_funcs_at(&object->ast.funcs, ast_func_id);
+
+    // Already inferred (or never deferred in the first place)
+    if(!(function->traits & AST_FUNC_INFER_PENDING)) return SUCCESS;
+
+    function->traits &= ~AST_FUNC_INFER_PENDING;
+
+    // Parse the function body if its parsing was deferred as well
+    if(parse_func_body_on_demand(compiler, object, function)) return FAILURE;
+
+    infer_var_scope_t func_scope;
+    infer_var_scope_init(&func_scope, NULL);
+
+    infer_ctx_t ctx = (infer_ctx_t){
+        .compiler = compiler,
+        .object = object,
+        .ast = &object->ast,
+        .named_expressions_recursion_depth = 0,
+        .aliases_recursion_depth = 0,
+        .scope = &func_scope,
+    };
+
+    for(length_t a = 0; a != function->arity; a++){
+        bool force_used = infer_func_arg_is_force_used(compiler, function, a);
+        infer_var_scope_ir_builder_add_variable(ctx.scope, function->arg_names[a], &function->arg_types[a], function->arg_sources[a], force_used, false);
+    }
+
+    if(function->traits & AST_FUNC_VARIADIC){
+        // Add variadic array variable
+        infer_var_scope_ir_builder_add_variable(ctx.scope, function->variadic_arg_name, ctx.ast->common.ast_variadic_array, function->variadic_source, false, false);
+    }
+
+    errorcode_t errorcode = infer_in_stmts(&ctx, function, &function->statements);
+    infer_var_scope_free(compiler, ctx.scope);
+    if(errorcode) return FAILURE;
+
+    // We had unused variables and have been told to treat them as errors
+    if(compiler->traits & COMPILER_WARN_AS_ERROR && compiler->show_unused_variables_how_to_disable){
+        return FAILURE;
     }
 
     return SUCCESS;
@@ -201,6 +458,26 @@ errorcode_t infer_in_func_aliases(infer_ctx_t *ctx, ast_func_alias_t *func_alias
     return SUCCESS;
 }
 
+errorcode_t infer_in_parallel(infer_ctx_t *ctx, ast_parallel_t *parallel){
+    for(length_t i = 0; i != parallel->reductions_length; i++){
+        ast_reduction_t *reduction = &parallel->reductions[i];
+        infer_var_t *variable = ctx->scope ? infer_var_scope_find(ctx->scope, reduction->name) : NULL;
+
+        // Reductions of global variables are validated during IR generation
+        if(variable == NULL) continue;
+
+        variable->used = true;
+
+        if(variable->is_const){
+            compiler_panicf(ctx->compiler, reduction->source, "Variable '%s' is constant, and cannot be reduced", reduction->name);
+            ctx->compiler->ignore |= COMPILER_IGNORE_UNUSED;
+            return FAILURE;
+        }
+    }
+
+    return SUCCESS;
+}
+
 errorcode_t infer_in_stmts(infer_ctx_t *ctx, ast_func_t *func, ast_expr_list_t *stmt_list){
     for(length_t s = 0; s != stmt_list->length; s++){
         ast_expr_t *stmt = stmt_list->statements[s];
@@ -212,6 +489,12 @@ errorcode_t infer_in_stmts(infer_ctx_t *ctx, ast_func_t *func, ast_expr_list_t *
                 if(infer_in_stmts(ctx, func, &return_stmt->last_minute)) return FAILURE;
             }
             break;
+        case EXPR_YIELD: {
+                ast_expr_yield_t *yield_stmt = (ast_expr_yield_t*) stmt;
+                if(yield_stmt->value != NULL && infer_expr(ctx, func, &yield_stmt->value, ast_primitive_from_ast_type(&func->yield_type), false)) return FAILURE;
+                if(infer_in_stmts(ctx, func, &yield_stmt->last_minute)) return FAILURE;
+            }
+            break;
         case EXPR_CALL: {
                 ast_expr_call_t *call_stmt = (ast_expr_call_t*) stmt;
 
@@ -351,7 +634,7 @@ errorcode_t infer_in_stmts(infer_ctx_t *ctx, ast_func_t *func, ast_expr_list_t *
                 }
             }
             break;
-        case EXPR_DELETE: case EXPR_VA_START: case EXPR_VA_END: {
+        case EXPR_ASSUME: case EXPR_DELETE: case EXPR_VA_START: case EXPR_VA_END: {
                 ast_expr_unary_t *unary_stmt = (ast_expr_unary_t*) stmt;
                 if(infer_expr(ctx, func, &unary_stmt->value, EXPR_NONE, false)) return FAILURE;
             }
@@ -365,6 +648,7 @@ errorcode_t infer_in_stmts(infer_ctx_t *ctx, ast_func_t *func, ast_expr_list_t *
                 if(loop->low_array && infer_expr(ctx, func, &loop->low_array, EXPR_NONE, true)) return FAILURE;
                 if(loop->length    && infer_expr(ctx, func, &loop->length, EXPR_USIZE, false))  return FAILURE;
                 if(loop->list      && infer_expr(ctx, func, &loop->list, EXPR_USIZE, true))     return FAILURE;
+                if(infer_in_parallel(ctx, &loop->parallel)) return FAILURE;
  
                 infer_var_scope_push(&ctx->scope);
                 infer_var_scope_ir_builder_add_variable(ctx->scope, "idx", &ctx->ast->common.ast_usize_type, loop->source, true, false);
@@ -382,6 +666,7 @@ errorcode_t infer_in_stmts(infer_ctx_t *ctx, ast_func_t *func, ast_expr_list_t *
 
                 ast_expr_repeat_t *loop = (ast_expr_repeat_t*) stmt;
                 if(infer_expr(ctx, func, &loop->limit, EXPR_USIZE, false)) return FAILURE;
+                if(infer_in_parallel(ctx, &loop->parallel)) return FAILURE;
  
                 infer_var_scope_push(&ctx->scope);
                 infer_var_scope_ir_builder_add_variable(ctx->scope, loop->idx_name ? loop->idx_name : "idx", &ctx->ast->common.ast_usize_type, loop->source, true, false);
@@ -927,7 +1212,7 @@ errorcode_t infer_expr_inner_variable(infer_ctx_t *ctx, ast_func_t *ast_func, as
     // Couldn't find identifier
     compiler_panicf(ctx->compiler, (*expr)->source, "Undeclared variable '%s'", variable_name);
     const char *nearest = ctx->scope ? infer_var_scope_nearest(ctx->scope, variable_name) : NULL;
-    if(nearest) printf("\nDid you mean '%s'?\n", nearest);
+    if(nearest) compiler_hintf(ctx->compiler, "\nDid you mean '%s'?\n", nearest);
     return FAILURE;
 
 found_named_expression:
@@ -1193,7 +1478,12 @@ unsigned int ast_primitive_from_ast_type(ast_type_t *type){
     if(type->elements_length != 1) return EXPR_NONE;
     if(type->elements[0]->id != AST_ELEM_BASE) return EXPR_NONE;
 
-    char *base = ((ast_elem_base_t*) type->elements[0])->base;
+    const char *base = ((ast_elem_base_t*) type->elements[0])->base;
+
+    // Undetermined primitives used with vectors take the type of their lanes
+    maybe_index_t vector = typename_vector_type(base);
+    if(vector != -1) base = global_vector_type_elements[vector];
+
     maybe_index_t builtin = typename_builtin_type(base);
 
     switch(builtin){
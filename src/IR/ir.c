@@ -15,6 +15,11 @@ void ir_basicblocks_free(ir_basicblocks_t *basicblocks){
         ir_basicblock_free(&basicblocks->blocks[i]);
     }
     free(basicblocks->blocks);
+
+    if(basicblocks->instructions_pool){
+        ir_pool_free(basicblocks->instructions_pool);
+        free(basicblocks->instructions_pool);
+    }
 }
 
 void ir_vtable_init_free(ir_vtable_init_t *vtable_init){
@@ -46,9 +51,9 @@ void free_list_free(free_list_t *list){
     free(list->pointers);
 }
 
-void ir_funcs_free(ir_funcs_t ir_funcs_list){
-    for(length_t f = 0; f != ir_funcs_list.length; f++){
-        ir_func_t *func = &ir_funcs_list.funcs[f];
+void ir_funcs_free(ir_funcs_t *funcs){
+    for(length_t f = 0; f != funcs->length; f++){
+        ir_func_t *func = ir_funcs_at(funcs, f);
 
         ir_basicblocks_free(&func->basicblocks);
         free(func->argument_types);
@@ -58,7 +63,7 @@ void ir_funcs_free(ir_funcs_t ir_funcs_list){
             free(func->scope);
         }
     }
-    free(ir_funcs_list.funcs);
+    chunked_list_free(funcs);
 }
 
 void ir_basicblock_free(ir_basicblock_t *basicblock){
@@ -90,6 +95,72 @@ void ir_implementation(length_t id, char prefix, char *output_buffer){
     output_buffer[length] = 0x00;
 }
 
+const char *ir_vector_reduce_operation_name(unsigned int operation){
+    switch(operation){
+    case INSTRUCTION_ADD:        return "add";
+    case INSTRUCTION_FADD:       return "fadd";
+    case INSTRUCTION_MULTIPLY:   return "mul";
+    case INSTRUCTION_FMULTIPLY:  return "fmul";
+    case INSTRUCTION_BIT_AND:    return "and";
+    case INSTRUCTION_BIT_OR:     return "or";
+    case INSTRUCTION_BIT_XOR:    return "xor";
+    case INSTRUCTION_ULESSER:    return "umin";
+    case INSTRUCTION_SLESSER:    return "smin";
+    case INSTRUCTION_FLESSER:    return "fmin";
+    case INSTRUCTION_UGREATER:   return "umax";
+    case INSTRUCTION_SGREATER:   return "smax";
+    case INSTRUCTION_FGREATER:   return "fmax";
+    default:                     return NULL;
+    }
+}
+
+const char *ir_intrinsic_name(unsigned int intrinsic){
+    switch(intrinsic){
+    case IR_INTRINSIC_ASSUME:   return "assume";
+    case IR_INTRINSIC_BSWAP:    return "bswap";
+    case IR_INTRINSIC_CTLZ:     return "ctlz";
+    case IR_INTRINSIC_CTPOP:    return "ctpop";
+    case IR_INTRINSIC_CTTZ:     return "cttz";
+    case IR_INTRINSIC_EXPECT:   return "expect";
+    case IR_INTRINSIC_FMA:      return "fma";
+    case IR_INTRINSIC_FSHL:     return "fshl";
+    case IR_INTRINSIC_FSHR:     return "fshr";
+    case IR_INTRINSIC_PREFETCH: return "prefetch";
+    case IR_INTRINSIC_SQRT:     return "sqrt";
+    default:                    return "<unknown intrinsic>";
+    }
+}
+
+const char *ir_atomic_rmw_operation_name(unsigned int operation){
+    switch(operation){
+    case INSTRUCTION_STORE:      return "xchg";
+    case INSTRUCTION_ADD:        return "add";
+    case INSTRUCTION_FADD:       return "fadd";
+    case INSTRUCTION_SUBTRACT:   return "sub";
+    case INSTRUCTION_FSUBTRACT:  return "fsub";
+    case INSTRUCTION_BIT_AND:    return "and";
+    case INSTRUCTION_BIT_OR:     return "or";
+    case INSTRUCTION_BIT_XOR:    return "xor";
+    case INSTRUCTION_ULESSER:    return "umin";
+    case INSTRUCTION_SLESSER:    return "min";
+    case INSTRUCTION_UGREATER:   return "umax";
+    case INSTRUCTION_SGREATER:   return "max";
+    default:                     return NULL;
+    }
+}
+
+const char *ir_atomic_ordering_name(unsigned int ordering){
+    switch(ordering){
+    case IR_ATOMIC_RELAXED: return "relaxed";
+    case IR_ATOMIC_CONSUME: return "consume";
+    case IR_ATOMIC_ACQUIRE: return "acquire";
+    case IR_ATOMIC_RELEASE: return "release";
+    case IR_ATOMIC_ACQ_REL: return "acq_rel";
+    case IR_ATOMIC_SEQ_CST: return "seq_cst";
+    default:                return "<unknown ordering>";
+    }
+}
+
 unsigned long long ir_value_uniqueness_value(ir_pool_t *pool, ir_value_t **value){
     if(ir_lower_const_cast(pool, value) || (*value)->value_type != VALUE_TYPE_LITERAL){
         printf("INTERNAL ERROR: ir_value_uniqueness_value received a value that isn't a constant literal\n");
@@ -112,6 +183,47 @@ unsigned long long ir_value_uniqueness_value(ir_pool_t *pool, ir_value_t **value
     }
 }
 
+bool ir_value_is_static_initializer(ir_value_t *value){
+    ir_value_t **values;
+    length_t length;
+
+    switch(value->value_type){
+    case VALUE_TYPE_LITERAL:
+    case VALUE_TYPE_NULLPTR:
+    case VALUE_TYPE_NULLPTR_OF_TYPE:
+    case VALUE_TYPE_CONST_ANON_GLOBAL:
+    case VALUE_TYPE_CSTR_OF_LEN:
+    case VALUE_TYPE_FUNC_ADDR:
+    case VALUE_TYPE_FUNC_ADDR_BY_NAME:
+    case VALUE_TYPE_CONST_SIZEOF:
+    case VALUE_TYPE_CONST_ALIGNOF:
+        return true;
+    case VALUE_TYPE_CONST_ADD:
+        return ir_value_is_static_initializer(((ir_value_const_math_t*) value->extra)->a)
+            && ir_value_is_static_initializer(((ir_value_const_math_t*) value->extra)->b);
+    case VALUE_TYPE_ARRAY_LITERAL:
+        values = ((ir_value_array_literal_t*) value->extra)->values;
+        length = ((ir_value_array_literal_t*) value->extra)->length;
+        break;
+    case VALUE_TYPE_STRUCT_LITERAL:
+        values = ((ir_value_struct_literal_t*) value->extra)->values;
+        length = ((ir_value_struct_literal_t*) value->extra)->length;
+        break;
+    case VALUE_TYPE_CONST_STRUCT_LITERAL:
+        values = ((ir_value_const_struct_literal_t*) value->extra)->values;
+        length = ((ir_value_const_struct_literal_t*) value->extra)->length;
+        break;
+    default:
+        return VALUE_TYPE_IS_CONSTANT_CAST(value->value_type) && ir_value_is_static_initializer((ir_value_t*) value->extra);
+    }
+
+    for(length_t i = 0; i != length; i++){
+        if(!ir_value_is_static_initializer(values[i])) return false;
+    }
+
+    return true;
+}
+
 void ir_print_value(ir_value_t *value){
     strong_cstr_t s = ir_value_str(value);
     printf("%s\n", s);
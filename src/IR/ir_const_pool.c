@@ -0,0 +1,119 @@
+
+#include "IR/ir_const_pool.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "IR/ir_type.h"
+#include "UTIL/ground.h"
+
+static length_t ir_const_pool_kind_size(unsigned int kind){
+    switch(kind){
+    case TYPE_KIND_S8: case TYPE_KIND_U8: case TYPE_KIND_BOOLEAN:
+        return 1;
+    case TYPE_KIND_S16: case TYPE_KIND_U16: case TYPE_KIND_HALF:
+        return 2;
+    case TYPE_KIND_S32: case TYPE_KIND_U32: case TYPE_KIND_FLOAT:
+        return 4;
+    case TYPE_KIND_S64: case TYPE_KIND_U64: case TYPE_KIND_DOUBLE:
+        return 8;
+    }
+    return 0;
+}
+
+static uint64_t ir_const_pool_bits(unsigned int kind, const void *data){
+    uint64_t bits = 0;
+    memcpy(&bits, data, ir_const_pool_kind_size(kind));
+    return bits;
+}
+
+static length_t ir_const_pool_hash(unsigned int kind, uint64_t bits){
+    // 64-bit mix (splitmix64 finalizer)
+    uint64_t hash = bits ^ ((uint64_t) kind << 56);
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    return (length_t) (hash ^ (hash >> 31));
+}
+
+static ir_value_t **ir_const_pool_slot(ir_value_t **values, length_t capacity, unsigned int kind, uint64_t bits){
+    // NOTE: 'capacity' is always a power of two
+    length_t i = ir_const_pool_hash(kind, bits) & (capacity - 1);
+
+    while(values[i] != NULL){
+        ir_value_t *value = values[i];
+
+        if(value->type->kind == kind && ir_const_pool_bits(kind, value->extra) == bits){
+            break;
+        }
+
+        i = (i + 1) & (capacity - 1);
+    }
+
+    return &values[i];
+}
+
+static void ir_const_pool_grow(ir_const_pool_t *const_pool){
+    length_t new_capacity = const_pool->capacity == 0 ? 64 : const_pool->capacity * 2;
+    ir_value_t **new_values = calloc(new_capacity, sizeof(ir_value_t*));
+
+    for(length_t i = 0; i != const_pool->capacity; i++){
+        ir_value_t *value = const_pool->values[i];
+        if(value == NULL) continue;
+
+        unsigned int kind = value->type->kind;
+        *ir_const_pool_slot(new_values, new_capacity, kind, ir_const_pool_bits(kind, value->extra)) = value;
+    }
+
+    free(const_pool->values);
+    const_pool->values = new_values;
+    const_pool->capacity = new_capacity;
+}
+
+void ir_const_pool_free(ir_const_pool_t *const_pool){
+    ir_pool_free(&const_pool->storage);
+    free(const_pool->values);
+    free(const_pool);
+}
+
+ir_value_t *ir_const_pool_literal(ir_pool_t *pool, unsigned int kind, const void *data){
+    if(pool->const_pool == NULL){
+        pool->const_pool = malloc(sizeof(ir_const_pool_t));
+        *pool->const_pool = (ir_const_pool_t){0};
+        ir_pool_init(&pool->const_pool->storage);
+    }
+
+    ir_const_pool_t *const_pool = pool->const_pool;
+
+    // Keep load factor at or below 1/2
+    if((const_pool->length + 1) * 2 > const_pool->capacity){
+        ir_const_pool_grow(const_pool);
+    }
+
+    uint64_t bits = ir_const_pool_bits(kind, data);
+    ir_value_t **slot = ir_const_pool_slot(const_pool->values, const_pool->capacity, kind, bits);
+    if(*slot != NULL) return *slot;
+
+    ir_pool_t *storage = &const_pool->storage;
+    *slot = ir_literal_make(storage, ir_type_make(storage, kind, NULL), data, ir_const_pool_kind_size(kind));
+
+    const_pool->length++;
+    return *slot;
+}
+
+ir_value_t *ir_literal_make(ir_pool_t *pool, ir_type_t *type, const void *data, length_t size){
+    ir_value_t *value = ir_pool_alloc(pool, sizeof(ir_value_t) + size);
+    void *payload = (void*) &value[1];
+
+    *value = (ir_value_t){
+        .value_type = VALUE_TYPE_LITERAL,
+        .type = type,
+        .extra = memcpy(payload, data, size),
+    };
+
+    return value;
+}
+
+bool ir_const_pool_kind_is_internable(unsigned int kind){
+    return ir_const_pool_kind_size(kind) != 0;
+}
@@ -45,7 +45,7 @@ static void ir_dump_var_scope_layout(FILE *file, bridge_scope_t *scope){
     }
 }
 
-void ir_dump_function(FILE *file, ir_func_t *function, func_id_t ir_func_id, ir_func_t *all_funcs){
+void ir_dump_function(FILE *file, ir_func_t *function, func_id_t ir_func_id, ir_funcs_t *all_funcs){
     char mangled_name[32];
     ir_implementation(ir_func_id, 'a', mangled_name);
 
@@ -71,11 +71,12 @@ void ir_dump_function(FILE *file, ir_func_t *function, func_id_t ir_func_id, ir_
 
 void ir_dump_functions(FILE *file, ir_funcs_t *funcs){
     for(length_t i = 0; i != funcs->length; i++){
-        ir_dump_function(file, &funcs->funcs[i], i, funcs->funcs);
+        if(ir_funcs_at(funcs, i)->traits & IR_FUNC_UNREFERENCED) continue;
+        ir_dump_function(file, ir_funcs_at(funcs, i), i, funcs);
     }
 }
 
-void ir_dump_basicsblocks(FILE *file, ir_basicblocks_t basicblocks, ir_func_t *all_funcs){
+void ir_dump_basicsblocks(FILE *file, ir_basicblocks_t basicblocks, ir_funcs_t *all_funcs){
     for(length_t b = 0; b != basicblocks.length; b++){
         ir_instrs_t *instructions = &basicblocks.blocks[b].instructions;
 
@@ -141,9 +142,17 @@ static void ir_dump_varptr_instruction(FILE *file, ir_instr_varptr_t *instructio
     free(result_type_str);
 }
 
+static const char *ir_dump_likelihood(troolean likely){
+    switch(likely){
+    case TROOLEAN_TRUE:  return "likely ";
+    case TROOLEAN_FALSE: return "unlikely ";
+    default:             return "";
+    }
+}
+
 static void ir_dump_condbreak_instruction(FILE *file, ir_instr_cond_break_t *instruction){
     strong_cstr_t value_str = ir_value_str(instruction->value);
-    fprintf(file, "cbr %s, |%zu|, |%zu|\n", value_str, instruction->true_block_id, instruction->false_block_id);
+    fprintf(file, "cbr %s%s, |%zu|, |%zu|\n", ir_dump_likelihood(instruction->likely), value_str, instruction->true_block_id, instruction->false_block_id);
     free(value_str);
 }
 
@@ -232,7 +241,8 @@ static void ir_dump_switch_instruction(FILE *file, ir_instr_switch_t *instructio
 
     for(length_t i = 0; i != instruction->cases_length; i++){
         strong_cstr_t case_value_str = ir_value_str(instruction->case_values[i]);
-        fprintf(file, "               (%s) -> |%zu|\n", case_value_str, instruction->case_block_ids[i]);
+        const char *likelihood = instruction->case_likely ? ir_dump_likelihood(instruction->case_likely[i]) : "";
+        fprintf(file, "               %s(%s) -> |%zu|\n", likelihood, case_value_str, instruction->case_block_ids[i]);
         free(case_value_str);
     }
 
@@ -282,8 +292,8 @@ static void ir_dump_math_instruction(FILE *file, ir_instr_math_t *instruction, c
     free(val_str_2);
 }
 
-static void ir_dump_call_instruction(FILE *file, ir_instr_call_t *instruction, ir_func_t *all_funcs){
-    const char *real_name = all_funcs[instruction->ir_func_id].name;
+static void ir_dump_call_instruction(FILE *file, ir_instr_call_t *instruction, ir_funcs_t *all_funcs){
+    const char *real_name = ir_funcs_at(all_funcs, instruction->ir_func_id)->name;
     strong_cstr_t args = ir_values_str(instruction->values, instruction->values_length);
     strong_cstr_t result_type = ir_type_str(instruction->result_type);
 
@@ -308,7 +318,90 @@ static void ir_dump_call_address_instruction(FILE *file, ir_instr_call_address_t
     free(result_type);
 }
 
-void ir_dump_instruction(FILE *file, ir_instr_t *instruction, length_t instr_index, ir_func_t *all_funcs){
+static void ir_dump_select_instruction(FILE *file, ir_instr_select_t *instruction){
+    strong_cstr_t condition = ir_value_str(instruction->condition);
+    strong_cstr_t if_true = ir_value_str(instruction->if_true);
+    strong_cstr_t if_false = ir_value_str(instruction->if_false);
+    fprintf(file, "select %s, %s, %s\n", condition, if_true, if_false);
+    free(condition);
+    free(if_true);
+    free(if_false);
+}
+
+static void ir_dump_shuffle_instruction(FILE *file, ir_instr_shuffle_t *instruction){
+    strong_cstr_t a = ir_value_str(instruction->a);
+    strong_cstr_t b = ir_value_str(instruction->b);
+    fprintf(file, "vshuffle %s, %s, [", a, b);
+
+    for(length_t i = 0; i != instruction->mask_length; i++){
+        fprintf(file, i == 0 ? "%zu" : ", %zu", instruction->mask[i]);
+    }
+
+    fprintf(file, "]\n");
+    free(a);
+    free(b);
+}
+
+static void ir_dump_vector_reduce_instruction(FILE *file, ir_instr_vector_reduce_t *instruction){
+    strong_cstr_t value_str = ir_value_str(instruction->value);
+    fprintf(file, "vreduce %s %s\n", ir_vector_reduce_operation_name(instruction->operation), value_str);
+    free(value_str);
+}
+
+static void ir_dump_intrinsic_instruction(FILE *file, ir_instr_intrinsic_t *instruction){
+    fprintf(file, "intrinsic %s(", ir_intrinsic_name(instruction->intrinsic));
+
+    for(length_t i = 0; i != instruction->values_length; i++){
+        strong_cstr_t value_str = ir_value_str(instruction->values[i]);
+        fprintf(file, i == 0 ? "%s" : ", %s", value_str);
+        free(value_str);
+    }
+
+    fprintf(file, ")\n");
+}
+
+static void ir_dump_atomic_instruction(FILE *file, ir_instr_atomic_t *instruction){
+    strong_cstr_t pointer = instruction->pointer ? ir_value_str(instruction->pointer) : NULL;
+    strong_cstr_t value = instruction->value ? ir_value_str(instruction->value) : NULL;
+    strong_cstr_t expected = instruction->expected ? ir_value_str(instruction->expected) : NULL;
+    const char *ordering = ir_atomic_ordering_name(instruction->ordering);
+
+    switch(instruction->id){
+    case INSTRUCTION_ATOMIC_LOAD:
+        fprintf(file, "atomic load %s %s\n", ordering, pointer);
+        break;
+    case INSTRUCTION_ATOMIC_STORE:
+        fprintf(file, "atomic store %s %s, %s\n", ordering, pointer, value);
+        break;
+    case INSTRUCTION_ATOMIC_RMW:
+        fprintf(file, "atomic %s %s %s, %s\n", ir_atomic_rmw_operation_name(instruction->operation), ordering, pointer, value);
+        break;
+    case INSTRUCTION_ATOMIC_CMPXCHG:
+        fprintf(file, "atomic cmpxchg %s %s %s, %s, %s\n", ordering, ir_atomic_ordering_name(instruction->failure_ordering), pointer, expected, value);
+        break;
+    case INSTRUCTION_FENCE:
+        fprintf(file, "fence %s\n", ordering);
+        break;
+    }
+
+    free(pointer);
+    free(value);
+    free(expected);
+}
+
+static void ir_dump_parallel_for_instruction(FILE *file, ir_instr_parallel_for_t *instruction){
+    strong_cstr_t body = ir_value_str(instruction->body);
+    strong_cstr_t env = ir_value_str(instruction->env);
+    strong_cstr_t count = ir_value_str(instruction->count);
+
+    fprintf(file, "parallel for %s, %s, %s\n", body, env, count);
+
+    free(body);
+    free(env);
+    free(count);
+}
+
+void ir_dump_instruction(FILE *file, ir_instr_t *instruction, length_t instr_index, ir_funcs_t *all_funcs){
     fprintf(file, "    0x%08X ", (int) instr_index);
 
     switch(instruction->id){
@@ -528,6 +621,9 @@ void ir_dump_instruction(FILE *file, ir_instr_t *instruction, length_t instr_ind
     case INSTRUCTION_FNEGATE:
         ir_dump_unary_instruction(file, (ir_instr_unary_t*) instruction, "fneg");
         break;
+    case INSTRUCTION_SELECT:
+        ir_dump_select_instruction(file, (ir_instr_select_t*) instruction);
+        break;
     case INSTRUCTION_PHI2:
         ir_dump_phi2_instruction(file, (ir_instr_phi2_t*) instruction);
         break;
@@ -564,6 +660,40 @@ void ir_dump_instruction(FILE *file, ir_instr_t *instruction, length_t instr_ind
     case INSTRUCTION_UNREACHABLE:
         fprintf(file, "unreachable\n");
         break;
+    case INSTRUCTION_VECTOR_SPLAT:
+        ir_dump_cast_instruction(file, (ir_instr_cast_t*) instruction, "vsplat");
+        break;
+    case INSTRUCTION_VECTOR_SHUFFLE:
+        ir_dump_shuffle_instruction(file, (ir_instr_shuffle_t*) instruction);
+        break;
+    case INSTRUCTION_VECTOR_REDUCE:
+        ir_dump_vector_reduce_instruction(file, (ir_instr_vector_reduce_t*) instruction);
+        break;
+    case INSTRUCTION_INTRINSIC:
+        ir_dump_intrinsic_instruction(file, (ir_instr_intrinsic_t*) instruction);
+        break;
+    case INSTRUCTION_ATOMIC_LOAD: case INSTRUCTION_ATOMIC_STORE: case INSTRUCTION_ATOMIC_RMW:
+    case INSTRUCTION_ATOMIC_CMPXCHG: case INSTRUCTION_FENCE:
+        ir_dump_atomic_instruction(file, (ir_instr_atomic_t*) instruction);
+        break;
+    case INSTRUCTION_PARALLEL_FOR:
+        ir_dump_parallel_for_instruction(file, (ir_instr_parallel_for_t*) instruction);
+        break;
+    case INSTRUCTION_COROUTINE_SUSPEND:
+        ir_dump_unary_instruction(file, (ir_instr_unary_t*) instruction, "co_suspend");
+        break;
+    case INSTRUCTION_COROUTINE_RESUME:
+        ir_dump_unary_instruction(file, (ir_instr_unary_t*) instruction, "co_resume");
+        break;
+    case INSTRUCTION_COROUTINE_DESTROY:
+        ir_dump_unary_instruction(file, (ir_instr_unary_t*) instruction, "co_destroy");
+        break;
+    case INSTRUCTION_COROUTINE_DONE:
+        ir_dump_unary_instruction(file, (ir_instr_unary_t*) instruction, "co_done");
+        break;
+    case INSTRUCTION_COROUTINE_VALUE:
+        ir_dump_unary_instruction(file, (ir_instr_unary_t*) instruction, "co_value");
+        break;
     default:
         printf("Unknown instruction id 0x%08X when dumping ir module\n", (int) instruction->id);
         fprintf(file, "<unknown instruction>\n");
@@ -0,0 +1,455 @@
+
+#include "IR/ir_fold.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "IR/ir.h"
+#include "IR/ir_const_pool.h"
+#include "IR/ir_pool.h"
+#include "IR/ir_type.h"
+#include "IR/ir_value.h"
+#include "UTIL/datatypes.h"
+#include "UTIL/ground.h"
+
+// ---------------- ir_fold_scalar_t ----------------
+// A compile-time scalar value of type kind 'kind'
+typedef struct {
+    unsigned int kind;
+    uint64_t bits; // Integers and booleans, truncated to the width of 'kind'
+    double real;   // Floats (always exactly representable by 'kind')
+} ir_fold_scalar_t;
+
+static unsigned int ir_fold_width(unsigned int kind){
+    // Returns the bit width of an integer type kind, or zero if not an integer
+
+    switch(kind){
+    case TYPE_KIND_BOOLEAN:
+        return 1;
+    case TYPE_KIND_S8: case TYPE_KIND_U8:
+        return 8;
+    case TYPE_KIND_S16: case TYPE_KIND_U16:
+        return 16;
+    case TYPE_KIND_S32: case TYPE_KIND_U32:
+        return 32;
+    case TYPE_KIND_S64: case TYPE_KIND_U64:
+        return 64;
+    }
+
+    return 0;
+}
+
+static bool ir_fold_is_float(unsigned int kind){
+    // NOTE: Half precision floats are never folded
+    return kind == TYPE_KIND_FLOAT || kind == TYPE_KIND_DOUBLE;
+}
+
+static uint64_t ir_fold_mask(unsigned int width){
+    return width == 64 ? UINT64_MAX : ((uint64_t) 1 << width) - 1;
+}
+
+static int64_t ir_fold_signed(uint64_t bits, unsigned int width){
+    // Sign-extends the lowest 'width' bits
+
+    uint64_t sign = (uint64_t) 1 << (width - 1);
+    return (int64_t) ((bits ^ sign) - sign);
+}
+
+static double ir_fold_round(unsigned int kind, double real){
+    return kind == TYPE_KIND_FLOAT ? (double) (float) real : real;
+}
+
+static bool ir_fold_read_literal(ir_value_t *value, ir_fold_scalar_t *out_scalar){
+    void *data = value->extra;
+    *out_scalar = (ir_fold_scalar_t){ .kind = value->type->kind };
+
+    switch(value->type->kind){
+    case TYPE_KIND_BOOLEAN: out_scalar->bits = *((adept_bool*) data) ? 1 : 0;  break;
+    case TYPE_KIND_S8:      out_scalar->bits = *((adept_ubyte*) data);         break;
+    case TYPE_KIND_U8:      out_scalar->bits = *((adept_ubyte*) data);         break;
+    case TYPE_KIND_S16:     out_scalar->bits = *((adept_ushort*) data);        break;
+    case TYPE_KIND_U16:     out_scalar->bits = *((adept_ushort*) data);        break;
+    case TYPE_KIND_S32:     out_scalar->bits = *((adept_uint*) data);          break;
+    case TYPE_KIND_U32:     out_scalar->bits = *((adept_uint*) data);          break;
+    case TYPE_KIND_S64:     out_scalar->bits = *((adept_ulong*) data);         break;
+    case TYPE_KIND_U64:     out_scalar->bits = *((adept_ulong*) data);         break;
+    case TYPE_KIND_FLOAT:   out_scalar->real = *((adept_float*) data);         break;
+    case TYPE_KIND_DOUBLE:  out_scalar->real = *((adept_double*) data);        break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+static ir_value_t *ir_fold_make_literal(ir_pool_t *pool, ir_fold_scalar_t *scalar){
+    switch(scalar->kind){
+    case TYPE_KIND_BOOLEAN: { adept_bool   v = scalar->bits != 0;              return ir_const_pool_literal(pool, scalar->kind, &v); }
+    case TYPE_KIND_S8:      { adept_byte   v = (adept_byte) scalar->bits;      return ir_const_pool_literal(pool, scalar->kind, &v); }
+    case TYPE_KIND_U8:      { adept_ubyte  v = (adept_ubyte) scalar->bits;     return ir_const_pool_literal(pool, scalar->kind, &v); }
+    case TYPE_KIND_S16:     { adept_short  v = (adept_short) scalar->bits;     return ir_const_pool_literal(pool, scalar->kind, &v); }
+    case TYPE_KIND_U16:     { adept_ushort v = (adept_ushort) scalar->bits;    return ir_const_pool_literal(pool, scalar->kind, &v); }
+    case TYPE_KIND_S32:     { adept_int    v = (adept_int) scalar->bits;       return ir_const_pool_literal(pool, scalar->kind, &v); }
+    case TYPE_KIND_U32:     { adept_uint   v = (adept_uint) scalar->bits;      return ir_const_pool_literal(pool, scalar->kind, &v); }
+    case TYPE_KIND_S64:     { adept_long   v = (adept_long) scalar->bits;      return ir_const_pool_literal(pool, scalar->kind, &v); }
+    case TYPE_KIND_U64:     { adept_ulong  v = (adept_ulong) scalar->bits;     return ir_const_pool_literal(pool, scalar->kind, &v); }
+    case TYPE_KIND_FLOAT:   { adept_float  v = (adept_float) scalar->real;     return ir_const_pool_literal(pool, scalar->kind, &v); }
+    case TYPE_KIND_DOUBLE:  { adept_double v = scalar->real;                   return ir_const_pool_literal(pool, scalar->kind, &v); }
+    }
+
+    return NULL;
+}
+
+static bool ir_fold_float_to_int(double real, unsigned int width, bool is_signed, uint64_t *out_bits){
+    // Converts a float to an integer, truncating towards zero
+    // NOTE: Fails if the result wouldn't fit, since the conversion is undefined at runtime
+
+    if(is_signed){
+        double limit = (double) ((uint64_t) 1 << (width - 1));
+        if(!(real < limit && (width == 64 ? real >= -limit : real > -limit - 1.0))) return false;
+
+        *out_bits = (uint64_t) (int64_t) real & ir_fold_mask(width);
+    } else {
+        double limit = width == 64 ? 18446744073709551616.0 : (double) ((uint64_t) 1 << width);
+        if(!(real > -1.0 && real < limit)) return false;
+
+        *out_bits = (uint64_t) real;
+    }
+
+    return true;
+}
+
+static double ir_fold_int_to_float(unsigned int to_kind, uint64_t bits, unsigned int width, bool is_signed){
+    // NOTE: Converts directly to the destination precision to avoid rounding twice
+
+    if(is_signed){
+        int64_t value = ir_fold_signed(bits, width);
+        return to_kind == TYPE_KIND_FLOAT ? (double) (float) value : (double) value;
+    } else {
+        return to_kind == TYPE_KIND_FLOAT ? (double) (float) bits : (double) bits;
+    }
+}
+
+static bool ir_fold_reinterpret(ir_fold_scalar_t *from, unsigned int to_kind, ir_fold_scalar_t *out_scalar){
+    // Reinterprets the bits of a value as another type of the same size
+
+    unsigned int from_width = ir_fold_is_float(from->kind) ? (from->kind == TYPE_KIND_FLOAT ? 32 : 64) : ir_fold_width(from->kind);
+    unsigned int to_width = ir_fold_is_float(to_kind) ? (to_kind == TYPE_KIND_FLOAT ? 32 : 64) : ir_fold_width(to_kind);
+    if(from_width == 0 || from_width != to_width) return false;
+    if(ir_fold_is_float(from->kind) && isnan(from->real)) return false;
+
+    uint64_t bits = from->bits;
+
+    if(from->kind == TYPE_KIND_FLOAT){
+        float32 f = (float32) from->real;
+        uint32 raw;
+        memcpy(&raw, &f, sizeof raw);
+        bits = raw;
+    } else if(from->kind == TYPE_KIND_DOUBLE){
+        memcpy(&bits, &from->real, sizeof bits);
+    }
+
+    if(to_kind == TYPE_KIND_FLOAT){
+        uint32 raw = (uint32) bits;
+        float32 f;
+        memcpy(&f, &raw, sizeof f);
+        out_scalar->real = f;
+    } else if(to_kind == TYPE_KIND_DOUBLE){
+        memcpy(&out_scalar->real, &bits, sizeof bits);
+    } else {
+        out_scalar->bits = bits;
+        return true;
+    }
+
+    // NaN payloads may not survive being carried around as a double
+    return !isnan(out_scalar->real);
+}
+
+static bool ir_fold_cast(unsigned int const_cast_value_type, ir_fold_scalar_t *from, unsigned int to_kind, ir_fold_scalar_t *out_scalar){
+    // Performs a constant cast (VALUE_TYPE_CONST_*) on a scalar value
+
+    unsigned int from_width = ir_fold_width(from->kind);
+    unsigned int to_width = ir_fold_width(to_kind);
+    bool from_float = ir_fold_is_float(from->kind);
+    bool to_float = ir_fold_is_float(to_kind);
+
+    *out_scalar = (ir_fold_scalar_t){ .kind = to_kind };
+
+    switch(const_cast_value_type){
+    case VALUE_TYPE_CONST_BITCAST:
+    case VALUE_TYPE_CONST_REINTERPRET:
+        return ir_fold_reinterpret(from, to_kind, out_scalar);
+    case VALUE_TYPE_CONST_ZEXT:
+        if(from_width == 0 || to_width < from_width) return false;
+        out_scalar->bits = from->bits;
+        return true;
+    case VALUE_TYPE_CONST_SEXT:
+        if(from_width == 0 || to_width < from_width) return false;
+        out_scalar->bits = (uint64_t) ir_fold_signed(from->bits, from_width) & ir_fold_mask(to_width);
+        return true;
+    case VALUE_TYPE_CONST_TRUNC:
+        if(from_width == 0 || to_width == 0 || to_width > from_width) return false;
+        out_scalar->bits = from->bits & ir_fold_mask(to_width);
+        return true;
+    case VALUE_TYPE_CONST_FEXT:
+    case VALUE_TYPE_CONST_FTRUNC:
+        if(!from_float || !to_float) return false;
+        out_scalar->real = ir_fold_round(to_kind, from->real);
+        return true;
+    case VALUE_TYPE_CONST_FPTOUI:
+    case VALUE_TYPE_CONST_FPTOSI:
+        if(!from_float || to_width == 0) return false;
+        return ir_fold_float_to_int(from->real, to_width, const_cast_value_type == VALUE_TYPE_CONST_FPTOSI, &out_scalar->bits);
+    case VALUE_TYPE_CONST_UITOFP:
+    case VALUE_TYPE_CONST_SITOFP:
+        if(from_width == 0 || !to_float) return false;
+        out_scalar->real = ir_fold_int_to_float(to_kind, from->bits, from_width, const_cast_value_type == VALUE_TYPE_CONST_SITOFP);
+        return true;
+    }
+
+    // Pointer casts are never folded
+    return false;
+}
+
+static bool ir_fold_evaluate(ir_value_t *value, ir_fold_scalar_t *out_scalar){
+    // Evaluates a literal behind any number of constant casts
+
+    if(value->value_type == VALUE_TYPE_LITERAL){
+        return ir_fold_read_literal(value, out_scalar);
+    }
+
+    if(!VALUE_TYPE_IS_CONSTANT_CAST(value->value_type)) return false;
+
+    ir_fold_scalar_t from;
+    return ir_fold_evaluate((ir_value_t*) value->extra, &from)
+        && ir_fold_cast(value->value_type, &from, value->type->kind, out_scalar);
+}
+
+static unsigned int ir_fold_cast_value_type(unsigned int instr_id){
+    // Returns the constant cast value type that matches a cast instruction
+
+    switch(instr_id){
+    case INSTRUCTION_BITCAST:     return VALUE_TYPE_CONST_BITCAST;
+    case INSTRUCTION_ZEXT:        return VALUE_TYPE_CONST_ZEXT;
+    case INSTRUCTION_SEXT:        return VALUE_TYPE_CONST_SEXT;
+    case INSTRUCTION_TRUNC:       return VALUE_TYPE_CONST_TRUNC;
+    case INSTRUCTION_FEXT:        return VALUE_TYPE_CONST_FEXT;
+    case INSTRUCTION_FTRUNC:      return VALUE_TYPE_CONST_FTRUNC;
+    case INSTRUCTION_FPTOUI:      return VALUE_TYPE_CONST_FPTOUI;
+    case INSTRUCTION_FPTOSI:      return VALUE_TYPE_CONST_FPTOSI;
+    case INSTRUCTION_UITOFP:      return VALUE_TYPE_CONST_UITOFP;
+    case INSTRUCTION_SITOFP:      return VALUE_TYPE_CONST_SITOFP;
+    case INSTRUCTION_REINTERPRET: return VALUE_TYPE_CONST_REINTERPRET;
+    }
+
+    return VALUE_TYPE_NONE;
+}
+
+static bool ir_fold_integer_math(unsigned int instr_id, uint64_t a, uint64_t b, unsigned int width, ir_fold_scalar_t *out_scalar){
+    uint64_t mask = ir_fold_mask(width);
+    int64_t sa = ir_fold_signed(a, width);
+    int64_t sb = ir_fold_signed(b, width);
+    int64_t smin = ir_fold_signed((uint64_t) 1 << (width - 1), width);
+
+    switch(instr_id){
+    case INSTRUCTION_ADD:           out_scalar->bits = (a + b) & mask; return true;
+    case INSTRUCTION_SUBTRACT:      out_scalar->bits = (a - b) & mask; return true;
+    case INSTRUCTION_MULTIPLY:      out_scalar->bits = (a * b) & mask; return true;
+    case INSTRUCTION_AND:
+    case INSTRUCTION_BIT_AND:       out_scalar->bits = a & b;          return true;
+    case INSTRUCTION_OR:
+    case INSTRUCTION_BIT_OR:        out_scalar->bits = a | b;          return true;
+    case INSTRUCTION_BIT_XOR:       out_scalar->bits = a ^ b;          return true;
+    case INSTRUCTION_EQUALS:        out_scalar->bits = a == b;         return true;
+    case INSTRUCTION_NOTEQUALS:     out_scalar->bits = a != b;         return true;
+    case INSTRUCTION_UGREATER:      out_scalar->bits = a > b;          return true;
+    case INSTRUCTION_ULESSER:       out_scalar->bits = a < b;          return true;
+    case INSTRUCTION_UGREATEREQ:    out_scalar->bits = a >= b;         return true;
+    case INSTRUCTION_ULESSEREQ:     out_scalar->bits = a <= b;         return true;
+    case INSTRUCTION_SGREATER:      out_scalar->bits = sa > sb;        return true;
+    case INSTRUCTION_SLESSER:       out_scalar->bits = sa < sb;        return true;
+    case INSTRUCTION_SGREATEREQ:    out_scalar->bits = sa >= sb;       return true;
+    case INSTRUCTION_SLESSEREQ:     out_scalar->bits = sa <= sb;       return true;
+    case INSTRUCTION_UDIVIDE:
+    case INSTRUCTION_UMODULUS:
+        // Division by zero traps at runtime
+        if(b == 0) return false;
+        out_scalar->bits = instr_id == INSTRUCTION_UDIVIDE ? a / b : a % b;
+        return true;
+    case INSTRUCTION_SDIVIDE:
+    case INSTRUCTION_SMODULUS:
+        // Division by zero and overflowing division trap at runtime
+        if(sb == 0 || (sa == smin && sb == -1)) return false;
+        out_scalar->bits = (uint64_t) (instr_id == INSTRUCTION_SDIVIDE ? sa / sb : sa % sb) & mask;
+        return true;
+    case INSTRUCTION_BIT_LSHIFT:
+    case INSTRUCTION_BIT_RSHIFT:
+    case INSTRUCTION_BIT_LGC_RSHIFT:
+        // Shifting by at least the bit width produces a poison value
+        if(b >= width) return false;
+
+        if(instr_id == INSTRUCTION_BIT_LSHIFT){
+            out_scalar->bits = (a << b) & mask;
+        } else if(instr_id == INSTRUCTION_BIT_LGC_RSHIFT){
+            out_scalar->bits = a >> b;
+        } else {
+            out_scalar->bits = (uint64_t) (sa < 0 ? ~(~sa >> b) : sa >> b) & mask;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+static bool ir_fold_float_math(unsigned int instr_id, double a, double b, ir_fold_scalar_t *out_scalar){
+    // NOTE: Floats are computed in double precision and then rounded,
+    //       which is always exact for the operations performed here.
+    //       Comparisons are ordered, so they're false when either side is NaN
+
+    switch(instr_id){
+    case INSTRUCTION_FADD:          out_scalar->real = ir_fold_round(out_scalar->kind, a + b);       return true;
+    case INSTRUCTION_FSUBTRACT:     out_scalar->real = ir_fold_round(out_scalar->kind, a - b);       return true;
+    case INSTRUCTION_FMULTIPLY:     out_scalar->real = ir_fold_round(out_scalar->kind, a * b);       return true;
+    case INSTRUCTION_FDIVIDE:       out_scalar->real = ir_fold_round(out_scalar->kind, a / b);       return true;
+    case INSTRUCTION_FMODULUS:      out_scalar->real = ir_fold_round(out_scalar->kind, fmod(a, b));  return true;
+    case INSTRUCTION_FEQUALS:       out_scalar->bits = a == b;           return true;
+    case INSTRUCTION_FNOTEQUALS:    out_scalar->bits = a < b || a > b;   return true;
+    case INSTRUCTION_FGREATER:      out_scalar->bits = a > b;            return true;
+    case INSTRUCTION_FLESSER:       out_scalar->bits = a < b;            return true;
+    case INSTRUCTION_FGREATEREQ:    out_scalar->bits = a >= b;           return true;
+    case INSTRUCTION_FLESSEREQ:     out_scalar->bits = a <= b;           return true;
+    }
+
+    return false;
+}
+
+static ir_value_t *ir_fold_const_add(ir_pool_t *pool, ir_instr_math_t *instr){
+    // Keeps additions of target-dependent sizes constant,
+    // so that they can still be used where constants are required
+
+    if(instr->id != INSTRUCTION_ADD || instr->result_type->kind != TYPE_KIND_U64) return NULL;
+    if(!VALUE_TYPE_IS_CONSTANT(instr->a->value_type) || !VALUE_TYPE_IS_CONSTANT(instr->b->value_type)) return NULL;
+    if(instr->a->type->kind != TYPE_KIND_U64 || instr->b->type->kind != TYPE_KIND_U64) return NULL;
+
+    ir_value_const_math_t *const_add = ir_pool_alloc_init(pool, ir_value_const_math_t, {
+        .a = instr->a,
+        .b = instr->b,
+    });
+
+    return ir_pool_alloc_init(pool, ir_value_t, {
+        .value_type = VALUE_TYPE_CONST_ADD,
+        .type = instr->result_type,
+        .extra = const_add,
+    });
+}
+
+static ir_value_t *ir_fold_math(ir_pool_t *pool, ir_instr_math_t *instr){
+    ir_fold_scalar_t a, b;
+
+    if(!ir_fold_evaluate(instr->a, &a) || !ir_fold_evaluate(instr->b, &b)){
+        return ir_fold_const_add(pool, instr);
+    }
+
+    if(a.kind != b.kind) return NULL;
+
+    ir_fold_scalar_t result = (ir_fold_scalar_t){ .kind = instr->result_type->kind };
+    unsigned int width = ir_fold_width(a.kind);
+
+    if(width != 0){
+        // Integer results must have the same type as the operands
+        if(result.kind != TYPE_KIND_BOOLEAN && result.kind != a.kind) return NULL;
+        if(!ir_fold_integer_math(instr->id, a.bits, b.bits, width, &result)) return NULL;
+    } else if(ir_fold_is_float(a.kind)){
+        if(result.kind != TYPE_KIND_BOOLEAN && result.kind != a.kind) return NULL;
+        if(!ir_fold_float_math(instr->id, a.real, b.real, &result)) return NULL;
+    } else {
+        return NULL;
+    }
+
+    return ir_fold_make_literal(pool, &result);
+}
+
+static ir_value_t *ir_fold_unary(ir_pool_t *pool, ir_instr_unary_t *instr){
+    ir_fold_scalar_t value;
+    if(!ir_fold_evaluate(instr->value, &value)) return NULL;
+
+    ir_fold_scalar_t result = (ir_fold_scalar_t){ .kind = instr->result_type->kind };
+    unsigned int width = ir_fold_width(value.kind);
+    bool is_float = ir_fold_is_float(value.kind);
+
+    if(width == 0 && !is_float) return NULL;
+
+    switch(instr->id){
+    case INSTRUCTION_ISZERO:
+        if(result.kind != TYPE_KIND_BOOLEAN) return NULL;
+        result.bits = is_float ? value.real == 0.0 : value.bits == 0;
+        break;
+    case INSTRUCTION_ISNTZERO:
+        // NOTE: Ordered comparison, so NaN is neither zero nor non-zero
+        if(result.kind != TYPE_KIND_BOOLEAN) return NULL;
+        result.bits = is_float ? (value.real < 0.0 || value.real > 0.0) : value.bits != 0;
+        break;
+    case INSTRUCTION_NEGATE:
+        if(is_float || result.kind != value.kind) return NULL;
+        result.bits = (0 - value.bits) & ir_fold_mask(width);
+        break;
+    case INSTRUCTION_BIT_COMPLEMENT:
+        if(is_float || result.kind != value.kind) return NULL;
+        result.bits = ~value.bits & ir_fold_mask(width);
+        break;
+    case INSTRUCTION_FNEGATE:
+        if(!is_float || result.kind != value.kind) return NULL;
+        result.real = -value.real;
+        break;
+    default:
+        return NULL;
+    }
+
+    return ir_fold_make_literal(pool, &result);
+}
+
+static ir_value_t *ir_fold_select(ir_instr_select_t *instr){
+    ir_fold_scalar_t condition;
+    if(!ir_fold_evaluate(instr->condition, &condition) || condition.kind != TYPE_KIND_BOOLEAN) return NULL;
+
+    return condition.bits ? instr->if_true : instr->if_false;
+}
+
+ir_value_t *ir_fold_instr(ir_pool_t *pool, ir_instr_t *instr){
+    if(instr->result_type == NULL) return NULL;
+
+    switch(instr->id){
+    case INSTRUCTION_ADD: case INSTRUCTION_FADD: case INSTRUCTION_SUBTRACT: case INSTRUCTION_FSUBTRACT:
+    case INSTRUCTION_MULTIPLY: case INSTRUCTION_FMULTIPLY: case INSTRUCTION_UDIVIDE: case INSTRUCTION_SDIVIDE:
+    case INSTRUCTION_FDIVIDE: case INSTRUCTION_UMODULUS: case INSTRUCTION_SMODULUS: case INSTRUCTION_FMODULUS:
+    case INSTRUCTION_EQUALS: case INSTRUCTION_FEQUALS: case INSTRUCTION_NOTEQUALS: case INSTRUCTION_FNOTEQUALS:
+    case INSTRUCTION_UGREATER: case INSTRUCTION_SGREATER: case INSTRUCTION_FGREATER:
+    case INSTRUCTION_ULESSER: case INSTRUCTION_SLESSER: case INSTRUCTION_FLESSER:
+    case INSTRUCTION_UGREATEREQ: case INSTRUCTION_SGREATEREQ: case INSTRUCTION_FGREATEREQ:
+    case INSTRUCTION_ULESSEREQ: case INSTRUCTION_SLESSEREQ: case INSTRUCTION_FLESSEREQ:
+    case INSTRUCTION_AND: case INSTRUCTION_OR: case INSTRUCTION_BIT_AND: case INSTRUCTION_BIT_OR: case INSTRUCTION_BIT_XOR:
+    case INSTRUCTION_BIT_LSHIFT: case INSTRUCTION_BIT_RSHIFT: case INSTRUCTION_BIT_LGC_RSHIFT:
+        return ir_fold_math(pool, (ir_instr_math_t*) instr);
+    case INSTRUCTION_ISZERO: case INSTRUCTION_ISNTZERO: case INSTRUCTION_BIT_COMPLEMENT:
+    case INSTRUCTION_NEGATE: case INSTRUCTION_FNEGATE:
+        return ir_fold_unary(pool, (ir_instr_unary_t*) instr);
+    case INSTRUCTION_SELECT:
+        return ir_fold_select((ir_instr_select_t*) instr);
+    }
+
+    unsigned int cast_value_type = ir_fold_cast_value_type(instr->id);
+    if(cast_value_type == VALUE_TYPE_NONE) return NULL;
+
+    ir_fold_scalar_t from, result;
+    if(!ir_fold_evaluate(((ir_instr_cast_t*) instr)->value, &from)) return NULL;
+    if(!ir_fold_cast(cast_value_type, &from, instr->result_type->kind, &result)) return NULL;
+
+    return ir_fold_make_literal(pool, &result);
+}
+
+ir_value_t *ir_fold_scalar_literal(ir_pool_t *pool, ir_value_t *value){
+    ir_fold_scalar_t scalar;
+    return ir_fold_evaluate(value, &scalar) ? ir_fold_make_literal(pool, &scalar) : NULL;
+}
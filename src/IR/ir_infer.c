@@ -0,0 +1,758 @@
+
+#include "IR/ir_infer.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "BRIDGE/bridge.h"
+#include "IR/ir.h"
+#include "IR/ir_pass.h"
+#include "IR/ir_pool.h"
+#include "IR/ir_type.h"
+#include "IR/ir_value.h"
+#include "UTIL/datatypes.h"
+#include "UTIL/ground.h"
+#include "UTIL/trait.h"
+#include "UTIL/util.h"
+
+// Possible effects that a function can have on its caller
+#define IR_INFER_READS          TRAIT_1 // May read memory visible to the caller
+#define IR_INFER_WRITES         TRAIT_2 // May write memory visible to the caller
+#define IR_INFER_MAY_NOT_RETURN TRAIT_3 // May loop forever or exit the program
+#define IR_INFER_UNKNOWN (IR_INFER_READS | IR_INFER_WRITES | IR_INFER_MAY_NOT_RETURN)
+
+#define IR_INFER_UNVISITED ((length_t) -1)
+
+// ---------------- ir_infer_func_t ----------------
+// Per-function scratch state for looking at a single function body
+typedef struct {
+    ir_func_t *func;
+    length_t *block_offsets;  // [block] -> flattened index of first instruction
+    length_t instructions_length;
+    bool *variable_is_static; // [variable]
+    bool *variable_escapes;   // [variable] -> whether its address is used for anything other than direct loads/stores
+} ir_infer_func_t;
+
+// ---------------- ir_infer_t ----------------
+// State for walking the call graph of an IR module
+typedef struct {
+    ir_module_t *module;
+    bool null_checks;
+    trait_t *effects;   // [func] -> IR_INFER_* effects of calling the function
+    length_t *index;    // [func] -> visitation index (or IR_INFER_UNVISITED)
+    length_t *lowlink;  // [func] -> lowest visitation index reachable
+    length_t *scc;      // [func] -> id of strongly connected component (or IR_INFER_UNVISITED)
+    func_id_t *stack;
+    length_t stack_length;
+    length_t next_index;
+    length_t next_scc;
+} ir_infer_t;
+
+static ir_instr_t *ir_infer_result_instr(ir_func_t *func, ir_value_t *value){
+    if(value == NULL || value->value_type != VALUE_TYPE_RESULT) return NULL;
+
+    ir_value_result_t *result = &value->result;
+    return func->basicblocks.blocks[result->block_id].instructions.instructions[result->instruction_id];
+}
+
+static length_t ir_infer_result_index(ir_infer_func_t *state, ir_value_t *value){
+    // Returns the flattened instruction index of an instruction result,
+    // or IR_INFER_UNVISITED if the value isn't an instruction result
+
+    if(value == NULL || value->value_type != VALUE_TYPE_RESULT) return IR_INFER_UNVISITED;
+
+    ir_value_result_t *result = &value->result;
+    return state->block_offsets[result->block_id] + result->instruction_id;
+}
+
+static bool ir_infer_is_variable_pointer(ir_infer_func_t *state, ir_value_t *value, length_t *out_index){
+    // Returns whether a value is the address of a non-static local variable
+
+    ir_instr_t *instr = ir_infer_result_instr(state->func, value);
+    if(instr == NULL || instr->id != INSTRUCTION_VARPTR) return false;
+
+    length_t index = ((ir_instr_varptr_t*) instr)->index;
+    if(index >= state->func->variable_count || state->variable_is_static[index]) return false;
+
+    if(out_index) *out_index = index;
+    return true;
+}
+
+static bool ir_infer_is_local(ir_infer_func_t *state, ir_value_t *value){
+    // Returns whether a pointer is known to point into the stack frame of the function
+
+    while(true){
+        ir_instr_t *instr = ir_infer_result_instr(state->func, value);
+        if(instr == NULL) return false;
+
+        switch(instr->id){
+        case INSTRUCTION_VARPTR:
+            return ir_infer_is_variable_pointer(state, value, NULL);
+        case INSTRUCTION_ALLOC:
+            return true;
+        case INSTRUCTION_BITCAST:
+            value = ((ir_instr_cast_t*) instr)->value;
+            break;
+        case INSTRUCTION_MEMBER:
+            value = ((ir_instr_member_t*) instr)->value;
+            break;
+        case INSTRUCTION_ARRAY_ACCESS:
+            value = ((ir_instr_array_access_t*) instr)->value;
+            break;
+        default:
+            return false;
+        }
+    }
+}
+
+static bool ir_infer_is_null(ir_value_t *value){
+    while(value->value_type == VALUE_TYPE_CONST_BITCAST){
+        value = (ir_value_t*) value->extra;
+    }
+
+    return value->value_type == VALUE_TYPE_NULLPTR || value->value_type == VALUE_TYPE_NULLPTR_OF_TYPE;
+}
+
+static bool ir_infer_is_unknown(ir_func_t *func){
+    // Functions we can't see (or that will have code injected into them later)
+    return func->traits & (IR_FUNC_FOREIGN | IR_FUNC_MAIN | IR_FUNC_INIT | IR_FUNC_DEINIT | IR_FUNC_UNREFERENCED | IR_FUNC_COROUTINE)
+        || func->basicblocks.length == 0;
+}
+
+typedef struct {
+    ir_infer_func_t *state;
+    length_t *uses;
+} ir_infer_count_t;
+
+static void ir_infer_count_variable_use(ir_value_t **slot, void *user_data){
+    ir_infer_count_t *count = (ir_infer_count_t*) user_data;
+    length_t index;
+
+    if(ir_infer_is_variable_pointer(count->state, *slot, &index)){
+        count->uses[index]++;
+    }
+}
+
+static void ir_infer_func_init(ir_infer_func_t *state, ir_func_t *func){
+    ir_basicblocks_t *basicblocks = &func->basicblocks;
+
+    state->func = func;
+    state->block_offsets = malloc(sizeof(length_t) * basicblocks->length);
+    state->instructions_length = 0;
+
+    for(length_t b = 0; b != basicblocks->length; b++){
+        state->block_offsets[b] = state->instructions_length;
+        state->instructions_length += basicblocks->blocks[b].instructions.length;
+    }
+
+    length_t variable_count = func->variable_count;
+    state->variable_is_static = calloc(length_max(1, variable_count), sizeof(bool));
+    state->variable_escapes = calloc(length_max(1, variable_count), sizeof(bool));
+
+    for(length_t v = 0; v != variable_count; v++){
+        bridge_var_t *var = func->scope ? bridge_scope_find_var_by_id(func->scope, v) : NULL;
+        state->variable_is_static[v] = var == NULL || var->traits & BRIDGE_VAR_STATIC;
+    }
+
+    // Find variables whose addresses are used for anything other than loading from and storing to them
+    length_t *uses = calloc(length_max(1, variable_count), sizeof(length_t));
+    length_t *allowed_uses = calloc(length_max(1, variable_count), sizeof(length_t));
+    ir_infer_count_t count = (ir_infer_count_t){ .state = state, .uses = uses };
+    length_t index;
+
+    for(length_t b = 0; b != basicblocks->length; b++){
+        ir_instrs_t *instructions = &basicblocks->blocks[b].instructions;
+
+        for(length_t i = 0; i != instructions->length; i++){
+            ir_instr_t *instr = instructions->instructions[i];
+            ir_value_t *address = NULL;
+
+            if(!ir_pass_visit_operands(instr, ir_infer_count_variable_use, &count)){
+                // Can't tell what happens to variables used by instructions we don't understand
+                memset(state->variable_escapes, true, sizeof(bool) * variable_count);
+            }
+
+            switch(instr->id){
+            case INSTRUCTION_LOAD:
+                address = ((ir_instr_load_t*) instr)->value;
+                break;
+            case INSTRUCTION_STORE:
+                address = ((ir_instr_store_t*) instr)->destination;
+                break;
+            case INSTRUCTION_ZEROINIT:
+                address = ((ir_instr_zeroinit_t*) instr)->destination;
+                break;
+            }
+
+            if(address && ir_infer_is_variable_pointer(state, address, &index)){
+                allowed_uses[index]++;
+            }
+        }
+    }
+
+    for(length_t v = 0; v != variable_count; v++){
+        if(uses[v] != allowed_uses[v] || state->variable_is_static[v]){
+            state->variable_escapes[v] = true;
+        }
+    }
+
+    free(uses);
+    free(allowed_uses);
+}
+
+static void ir_infer_func_free(ir_infer_func_t *state){
+    free(state->block_offsets);
+    free(state->variable_is_static);
+    free(state->variable_escapes);
+}
+
+static void ir_infer_visit_nothing(ir_value_t **slot, void *user_data){
+    (void) slot;
+    (void) user_data;
+}
+
+static trait_t ir_infer_access(ir_infer_t *infer, ir_infer_func_t *state, ir_value_t *address, trait_t effect, bool checked){
+    if(ir_infer_is_local(state, address)) return 0;
+
+    // Runtime null checks may print an error and exit the program
+    return checked && infer->null_checks ? effect | IR_INFER_WRITES | IR_INFER_MAY_NOT_RETURN : effect;
+}
+
+static trait_t ir_infer_instr_effects(ir_infer_t *infer, ir_infer_func_t *state, ir_instr_t *instr){
+    // Returns the effects of an instruction, not including the effects of the functions it calls
+
+    switch(instr->id){
+    case INSTRUCTION_LOAD:
+        return ir_infer_access(infer, state, ((ir_instr_load_t*) instr)->value, IR_INFER_READS, true);
+    case INSTRUCTION_STORE:
+        return ir_infer_access(infer, state, ((ir_instr_store_t*) instr)->destination, IR_INFER_WRITES, true);
+    case INSTRUCTION_MEMBER:
+        return ir_infer_access(infer, state, ((ir_instr_member_t*) instr)->value, TRAIT_NONE, true);
+    case INSTRUCTION_ARRAY_ACCESS:
+        return ir_infer_access(infer, state, ((ir_instr_array_access_t*) instr)->value, TRAIT_NONE, true);
+    case INSTRUCTION_ZEROINIT:
+        return ir_infer_access(infer, state, ((ir_instr_zeroinit_t*) instr)->destination, IR_INFER_WRITES, false);
+    case INSTRUCTION_MEMCPY:
+        return ir_infer_access(infer, state, ((ir_instr_memcpy_t*) instr)->destination, IR_INFER_WRITES, false)
+             | ir_infer_access(infer, state, ((ir_instr_memcpy_t*) instr)->value, IR_INFER_READS, false);
+    case INSTRUCTION_CALL:
+        // Calls to virtual dispatchers validate the vtable of the subject at runtime
+        return ir_funcs_at(&infer->module->funcs, ((ir_instr_call_t*) instr)->ir_func_id)->traits & IR_FUNC_VALIDATE_VTABLE
+            ? IR_INFER_WRITES | IR_INFER_MAY_NOT_RETURN : TRAIT_NONE;
+    case INSTRUCTION_MALLOC: case INSTRUCTION_FREE:
+    case INSTRUCTION_STACK_SAVE: case INSTRUCTION_STACK_RESTORE:
+    case INSTRUCTION_VA_START: case INSTRUCTION_VA_END: case INSTRUCTION_VA_ARG: case INSTRUCTION_VA_COPY:
+        return IR_INFER_READS | IR_INFER_WRITES;
+    case INSTRUCTION_ATOMIC_LOAD: case INSTRUCTION_ATOMIC_STORE: case INSTRUCTION_ATOMIC_RMW:
+    case INSTRUCTION_ATOMIC_CMPXCHG: case INSTRUCTION_FENCE:
+        // Atomic operations synchronize with other threads, even when only reading
+        return IR_INFER_READS | IR_INFER_WRITES;
+    case INSTRUCTION_CALL_ADDRESS: case INSTRUCTION_ASM: case INSTRUCTION_DEINIT_SVARS: case INSTRUCTION_PARALLEL_FOR:
+    case INSTRUCTION_COROUTINE_SUSPEND: case INSTRUCTION_COROUTINE_RESUME: case INSTRUCTION_COROUTINE_DESTROY:
+    case INSTRUCTION_COROUTINE_DONE: case INSTRUCTION_COROUTINE_VALUE:
+        return IR_INFER_UNKNOWN;
+    }
+
+    return ir_pass_visit_operands(instr, ir_infer_visit_nothing, NULL) ? TRAIT_NONE : IR_INFER_UNKNOWN;
+}
+
+static length_t ir_infer_successors(ir_instr_t *terminator, length_t storage[2], length_t **out_block_ids, length_t *out_extra){
+    // Gets the basicblock ids that a terminator can transfer control to,
+    // switches additionally return their default/resume basicblocks via 'storage'
+
+    switch(terminator->id){
+    case INSTRUCTION_BREAK:
+        storage[0] = ((ir_instr_break_t*) terminator)->block_id;
+        *out_block_ids = storage;
+        *out_extra = 0;
+        return 1;
+    case INSTRUCTION_CONDBREAK:
+        storage[0] = ((ir_instr_cond_break_t*) terminator)->true_block_id;
+        storage[1] = ((ir_instr_cond_break_t*) terminator)->false_block_id;
+        *out_block_ids = storage;
+        *out_extra = 0;
+        return 2;
+    case INSTRUCTION_SWITCH:
+        storage[0] = ((ir_instr_switch_t*) terminator)->default_block_id;
+        storage[1] = ((ir_instr_switch_t*) terminator)->resume_block_id;
+        *out_block_ids = ((ir_instr_switch_t*) terminator)->case_block_ids;
+        *out_extra = 2;
+        return ((ir_instr_switch_t*) terminator)->cases_length;
+    }
+
+    *out_block_ids = NULL;
+    *out_extra = 0;
+    return 0;
+}
+
+static length_t ir_infer_successor(ir_basicblocks_t *basicblocks, length_t block_id, length_t n){
+    // Returns the n-th successor of a basicblock, or IR_INFER_UNVISITED if there isn't one
+
+    ir_instrs_t *instructions = &basicblocks->blocks[block_id].instructions;
+    if(instructions->length == 0) return IR_INFER_UNVISITED;
+
+    length_t storage[2];
+    length_t *block_ids;
+    length_t extra;
+    length_t count = ir_infer_successors(instructions->instructions[instructions->length - 1], storage, &block_ids, &extra);
+
+    if(n < count) return block_ids[n];
+    if(n < count + extra) return storage[n - count];
+    return IR_INFER_UNVISITED;
+}
+
+static bool ir_infer_has_loop(ir_func_t *func){
+    // Returns whether the control flow graph of a function contains a cycle
+
+    ir_basicblocks_t *basicblocks = &func->basicblocks;
+
+    // 0 = unvisited, 1 = on path, 2 = finished
+    unsigned char *color = calloc(basicblocks->length, sizeof(unsigned char));
+    length_t *path = malloc(sizeof(length_t) * basicblocks->length);
+    length_t *next_successor = malloc(sizeof(length_t) * basicblocks->length);
+    length_t path_length = 1;
+    bool has_loop = false;
+
+    path[0] = 0;
+    next_successor[0] = 0;
+    color[0] = 1;
+
+    while(path_length != 0 && !has_loop){
+        length_t block_id = path[path_length - 1];
+        length_t successor = ir_infer_successor(basicblocks, block_id, next_successor[path_length - 1]++);
+
+        if(successor == IR_INFER_UNVISITED){
+            color[block_id] = 2;
+            path_length--;
+        } else if(successor >= basicblocks->length || color[successor] == 1){
+            has_loop = true;
+        } else if(color[successor] == 0){
+            color[successor] = 1;
+            path[path_length] = successor;
+            next_successor[path_length++] = 0;
+        }
+    }
+
+    free(color);
+    free(path);
+    free(next_successor);
+    return has_loop;
+}
+
+static void ir_infer_summarize(ir_infer_t *infer, func_id_t *members, length_t members_length){
+    // Computes the effects of a strongly connected component of the call graph,
+    // all functions called from outside of the component have already been summarized
+
+    length_t scc = infer->next_scc++;
+    trait_t effects = members_length > 1 ? IR_INFER_MAY_NOT_RETURN : TRAIT_NONE;
+
+    for(length_t m = 0; m != members_length; m++){
+        infer->scc[members[m]] = scc;
+    }
+
+    for(length_t m = 0; m != members_length && effects != IR_INFER_UNKNOWN; m++){
+        ir_func_t *func = ir_funcs_at(&infer->module->funcs, members[m]);
+
+        if(ir_infer_is_unknown(func)){
+            effects = IR_INFER_UNKNOWN;
+            break;
+        }
+
+        if(ir_infer_has_loop(func)){
+            effects |= IR_INFER_MAY_NOT_RETURN;
+        }
+
+        ir_infer_func_t state;
+        ir_infer_func_init(&state, func);
+
+        for(length_t b = 0; b != func->basicblocks.length; b++){
+            ir_instrs_t *instructions = &func->basicblocks.blocks[b].instructions;
+
+            for(length_t i = 0; i != instructions->length; i++){
+                ir_instr_t *instr = instructions->instructions[i];
+                effects |= ir_infer_instr_effects(infer, &state, instr);
+
+                if(instr->id == INSTRUCTION_CALL){
+                    func_id_t callee = ((ir_instr_call_t*) instr)->ir_func_id;
+
+                    // Calls within the same component are recursive
+                    effects |= infer->scc[callee] == scc ? IR_INFER_MAY_NOT_RETURN : infer->effects[callee];
+                }
+            }
+        }
+
+        ir_infer_func_free(&state);
+    }
+
+    for(length_t m = 0; m != members_length; m++){
+        infer->effects[members[m]] = effects;
+    }
+}
+
+static void ir_infer_visit(ir_infer_t *infer, func_id_t func_id){
+    // Tarjan's strongly connected components algorithm,
+    // which finishes components in bottom-up order
+
+    ir_func_t *func = ir_funcs_at(&infer->module->funcs, func_id);
+
+    infer->index[func_id] = infer->lowlink[func_id] = infer->next_index++;
+    infer->stack[infer->stack_length++] = func_id;
+
+    if(!ir_infer_is_unknown(func)){
+        for(length_t b = 0; b != func->basicblocks.length; b++){
+            ir_instrs_t *instructions = &func->basicblocks.blocks[b].instructions;
+
+            for(length_t i = 0; i != instructions->length; i++){
+                if(instructions->instructions[i]->id != INSTRUCTION_CALL) continue;
+
+                func_id_t callee = ((ir_instr_call_t*) instructions->instructions[i])->ir_func_id;
+
+                if(infer->index[callee] == IR_INFER_UNVISITED){
+                    ir_infer_visit(infer, callee);
+                    infer->lowlink[func_id] = length_min(infer->lowlink[func_id], infer->lowlink[callee]);
+                } else if(infer->scc[callee] == IR_INFER_UNVISITED){
+                    // Callee is still on the stack
+                    infer->lowlink[func_id] = length_min(infer->lowlink[func_id], infer->index[callee]);
+                }
+            }
+        }
+    }
+
+    if(infer->lowlink[func_id] == infer->index[func_id]){
+        length_t start = infer->stack_length;
+
+        do {
+            start--;
+        } while(infer->stack[start] != func_id);
+
+        ir_infer_summarize(infer, &infer->stack[start], infer->stack_length - start);
+        infer->stack_length = start;
+    }
+}
+
+static bool ir_infer_noalias_derived_instr(ir_infer_func_t *state, ir_instr_t *instr, bool *derived, bool *candidates){
+    // Returns whether an instruction result points into memory freshly allocated by this function
+
+    length_t index;
+
+    switch(instr->id){
+    case INSTRUCTION_MALLOC:
+        return true;
+    case INSTRUCTION_BITCAST: case INSTRUCTION_MEMBER: case INSTRUCTION_ARRAY_ACCESS: {
+            // (all of these have their pointer operand as the first value)
+            length_t source = ir_infer_result_index(state, ((ir_instr_cast_t*) instr)->value);
+            return source != IR_INFER_UNVISITED && derived[source];
+        }
+    case INSTRUCTION_LOAD:
+        return ir_infer_is_variable_pointer(state, ((ir_instr_load_t*) instr)->value, &index) && candidates[index];
+    }
+
+    return false;
+}
+
+typedef struct {
+    ir_infer_func_t *state;
+    bool *derived;
+    length_t uses;
+} ir_infer_derived_count_t;
+
+static void ir_infer_count_derived_use(ir_value_t **slot, void *user_data){
+    ir_infer_derived_count_t *count = (ir_infer_derived_count_t*) user_data;
+    length_t index = ir_infer_result_index(count->state, *slot);
+
+    if(index != IR_INFER_UNVISITED && count->derived[index]){
+        count->uses++;
+    }
+}
+
+static bool ir_infer_noalias_return(ir_infer_func_t *state){
+    // Returns whether a function always returns either null or memory
+    // that it allocated, which nothing else has a pointer to
+
+    ir_func_t *func = state->func;
+    if(func->return_type->kind != TYPE_KIND_POINTER) return false;
+
+    bool *derived = calloc(length_max(1, state->instructions_length), sizeof(bool));
+    bool *candidates = malloc(sizeof(bool) * length_max(1, func->variable_count));
+    bool changed;
+
+    // Local variables are candidates for holding freshly allocated memory
+    // if they are only ever loaded from and stored to (arguments start out with the caller's values)
+    for(length_t v = 0; v != func->variable_count; v++){
+        candidates[v] = v >= func->arity && !state->variable_escapes[v];
+    }
+
+    // Find the greatest set of instructions and variables that only ever point to freshly allocated memory
+    do {
+        changed = false;
+        memset(derived, false, sizeof(bool) * state->instructions_length);
+
+        bool derived_changed;
+
+        do {
+            derived_changed = false;
+
+            for(length_t b = 0; b != func->basicblocks.length; b++){
+                ir_instrs_t *instructions = &func->basicblocks.blocks[b].instructions;
+
+                for(length_t i = 0; i != instructions->length; i++){
+                    length_t k = state->block_offsets[b] + i;
+
+                    if(!derived[k] && ir_infer_noalias_derived_instr(state, instructions->instructions[i], derived, candidates)){
+                        derived[k] = true;
+                        derived_changed = true;
+                    }
+                }
+            }
+        } while(derived_changed);
+
+        // Variables stop being candidates once they are assigned anything else
+        for(length_t b = 0; b != func->basicblocks.length; b++){
+            ir_instrs_t *instructions = &func->basicblocks.blocks[b].instructions;
+
+            for(length_t i = 0; i != instructions->length; i++){
+                ir_instr_t *instr = instructions->instructions[i];
+                if(instr->id != INSTRUCTION_STORE) continue;
+
+                ir_instr_store_t *store = (ir_instr_store_t*) instr;
+                length_t variable, source = ir_infer_result_index(state, store->value);
+
+                if(ir_infer_is_variable_pointer(state, store->destination, &variable) && candidates[variable]
+                && !ir_infer_is_null(store->value) && (source == IR_INFER_UNVISITED || !derived[source])){
+                    candidates[variable] = false;
+                    changed = true;
+                }
+            }
+        }
+    } while(changed);
+
+    // Every use of freshly allocated memory must not let its address escape
+    // and every return value must be freshly allocated memory (or null)
+    ir_infer_derived_count_t count = (ir_infer_derived_count_t){ .state = state, .derived = derived, .uses = 0 };
+    length_t allowed_uses = 0;
+    bool returns_allocation = false;
+    bool noalias = true;
+
+    for(length_t b = 0; b != func->basicblocks.length && noalias; b++){
+        ir_instrs_t *instructions = &func->basicblocks.blocks[b].instructions;
+
+        for(length_t i = 0; i != instructions->length && noalias; i++){
+            ir_instr_t *instr = instructions->instructions[i];
+            ir_value_t *uses[2] = {NULL, NULL};
+            length_t variable;
+
+            ir_pass_visit_operands(instr, ir_infer_count_derived_use, &count);
+
+            switch(instr->id){
+            case INSTRUCTION_LOAD:
+                uses[0] = ((ir_instr_load_t*) instr)->value;
+                break;
+            case INSTRUCTION_STORE:
+                uses[0] = ((ir_instr_store_t*) instr)->destination;
+
+                if(ir_infer_is_variable_pointer(state, ((ir_instr_store_t*) instr)->destination, &variable) && candidates[variable]){
+                    uses[1] = ((ir_instr_store_t*) instr)->value;
+                }
+                break;
+            case INSTRUCTION_BITCAST: case INSTRUCTION_MEMBER: case INSTRUCTION_ARRAY_ACCESS:
+            case INSTRUCTION_ISZERO: case INSTRUCTION_ISNTZERO:
+                // (all of these have their pointer operand as the first value)
+                uses[0] = ((ir_instr_cast_t*) instr)->value;
+                break;
+            case INSTRUCTION_ZEROINIT:
+                uses[0] = ((ir_instr_zeroinit_t*) instr)->destination;
+                break;
+            case INSTRUCTION_MEMCPY:
+                uses[0] = ((ir_instr_memcpy_t*) instr)->destination;
+                uses[1] = ((ir_instr_memcpy_t*) instr)->value;
+                break;
+            case INSTRUCTION_RET: {
+                    ir_value_t *value = ((ir_instr_ret_t*) instr)->value;
+                    length_t source = ir_infer_result_index(state, value);
+
+                    if(source != IR_INFER_UNVISITED && derived[source]){
+                        uses[0] = value;
+                        returns_allocation = true;
+                    } else if(value == NULL || !ir_infer_is_null(value)){
+                        noalias = false;
+                    }
+                }
+                break;
+            }
+
+            for(length_t u = 0; u != 2; u++){
+                length_t source = ir_infer_result_index(state, uses[u]);
+                if(source != IR_INFER_UNVISITED && derived[source]) allowed_uses++;
+            }
+        }
+    }
+
+    free(derived);
+    free(candidates);
+    return noalias && returns_allocation && count.uses == allowed_uses;
+}
+
+static bool ir_infer_block_is_targeted(ir_basicblocks_t *basicblocks, length_t block_id){
+    for(length_t b = 0; b != basicblocks->length; b++){
+        for(length_t n = 0; ; n++){
+            length_t successor = ir_infer_successor(basicblocks, b, n);
+            if(successor == IR_INFER_UNVISITED) break;
+            if(successor == block_id) return true;
+        }
+    }
+
+    return false;
+}
+
+static void ir_infer_arguments(ir_infer_t *infer, ir_infer_func_t *state){
+    // Finds pointer arguments that are unconditionally dereferenced
+    // by the entry basicblock, before anything that might not return
+
+    ir_func_t *func = state->func;
+    if(func->arity == 0 || infer->null_checks) return;
+
+    // Arguments can only be reassigned before the entry block if something branches back to it
+    if(ir_infer_block_is_targeted(&func->basicblocks, 0)) return;
+
+    ir_instrs_t *instructions = &func->basicblocks.blocks[0].instructions;
+    trait_t *arg_traits = calloc(func->arity, sizeof(trait_t));
+    bool *reassigned = calloc(func->arity, sizeof(bool));
+    length_t *origin = calloc(length_max(1, instructions->length), sizeof(length_t)); // [instruction] -> argument + 1 (or 0)
+    bool *exact = calloc(length_max(1, instructions->length), sizeof(bool));
+    bool any = false;
+
+    for(length_t i = 0; i != instructions->length; i++){
+        ir_instr_t *instr = instructions->instructions[i];
+        ir_value_t *address = NULL;
+        length_t variable;
+
+        switch(instr->id){
+        case INSTRUCTION_LOAD: {
+                ir_value_t *value = ((ir_instr_load_t*) instr)->value;
+
+                if(ir_infer_is_variable_pointer(state, value, &variable) && variable < func->arity){
+                    if(!reassigned[variable] && !state->variable_escapes[variable] && func->argument_types[variable]->kind == TYPE_KIND_POINTER){
+                        origin[i] = variable + 1;
+                        exact[i] = true;
+                    }
+                } else {
+                    address = value;
+                }
+            }
+            break;
+        case INSTRUCTION_STORE:
+            if(ir_infer_is_variable_pointer(state, ((ir_instr_store_t*) instr)->destination, &variable)){
+                if(variable < func->arity) reassigned[variable] = true;
+            } else {
+                address = ((ir_instr_store_t*) instr)->destination;
+            }
+            break;
+        case INSTRUCTION_ZEROINIT:
+            if(ir_infer_is_variable_pointer(state, ((ir_instr_zeroinit_t*) instr)->destination, &variable) && variable < func->arity){
+                reassigned[variable] = true;
+            }
+            break;
+        case INSTRUCTION_BITCAST: case INSTRUCTION_MEMBER: {
+                // Member accesses are inbounds, so accessing a member proves the base isn't null
+                length_t source = ir_infer_result_index(state, ((ir_instr_cast_t*) instr)->value);
+
+                if(source != IR_INFER_UNVISITED && source < instructions->length){
+                    origin[i] = origin[source];
+                }
+            }
+            break;
+        }
+
+        if(address){
+            length_t source = ir_infer_result_index(state, address);
+
+            if(source != IR_INFER_UNVISITED && source < instructions->length && origin[source]){
+                trait_t *traits = &arg_traits[origin[source] - 1];
+                *traits |= exact[source] ? IR_FUNC_ARG_NONNULL | IR_FUNC_ARG_DEREFERENCEABLE : IR_FUNC_ARG_NONNULL;
+                any = true;
+            }
+        }
+
+        // Nothing after this point is guaranteed to execute
+        trait_t effects = ir_infer_instr_effects(infer, state, instr);
+
+        if(instr->id == INSTRUCTION_CALL){
+            effects |= infer->effects[((ir_instr_call_t*) instr)->ir_func_id];
+        }
+
+        if(effects & IR_INFER_MAY_NOT_RETURN) break;
+    }
+
+    if(any){
+        func->maybe_argument_traits = ir_pool_alloc(&infer->module->pool, sizeof(trait_t) * func->arity);
+        memcpy(func->maybe_argument_traits, arg_traits, sizeof(trait_t) * func->arity);
+    }
+
+    free(arg_traits);
+    free(reassigned);
+    free(origin);
+    free(exact);
+}
+
+void ir_module_infer_attributes(ir_module_t *ir_module, bool null_checks){
+    length_t funcs_length = ir_module->funcs.length;
+    if(funcs_length == 0) return;
+
+    ir_infer_t infer = (ir_infer_t){
+        .module = ir_module,
+        .null_checks = null_checks,
+        .effects = malloc(sizeof(trait_t) * funcs_length),
+        .index = malloc(sizeof(length_t) * funcs_length),
+        .lowlink = malloc(sizeof(length_t) * funcs_length),
+        .scc = malloc(sizeof(length_t) * funcs_length),
+        .stack = malloc(sizeof(func_id_t) * funcs_length),
+        .stack_length = 0,
+        .next_index = 0,
+        .next_scc = 0,
+    };
+
+    for(length_t f = 0; f != funcs_length; f++){
+        infer.effects[f] = IR_INFER_UNKNOWN;
+        infer.index[f] = IR_INFER_UNVISITED;
+        infer.scc[f] = IR_INFER_UNVISITED;
+    }
+
+    // Summarize the effects of every function, callees first
+    for(length_t f = 0; f != funcs_length; f++){
+        if(infer.index[f] == IR_INFER_UNVISITED){
+            ir_infer_visit(&infer, (func_id_t) f);
+        }
+    }
+
+    for(length_t f = 0; f != funcs_length; f++){
+        ir_func_t *func = ir_funcs_at(&ir_module->funcs, f);
+        if(ir_infer_is_unknown(func)) continue;
+
+        trait_t effects = infer.effects[f];
+
+        if(!(effects & IR_INFER_WRITES)){
+            func->traits |= effects & IR_INFER_READS ? IR_FUNC_READONLY : IR_FUNC_READNONE;
+        }
+
+        if(!(effects & IR_INFER_MAY_NOT_RETURN)){
+            func->traits |= IR_FUNC_WILLRETURN;
+        }
+
+        ir_infer_func_t state;
+        ir_infer_func_init(&state, func);
+
+        if(ir_infer_noalias_return(&state)){
+            func->traits |= IR_FUNC_NOALIAS_RETURN;
+        }
+
+        ir_infer_arguments(&infer, &state);
+        ir_infer_func_free(&state);
+    }
+
+    free(infer.effects);
+    free(infer.index);
+    free(infer.lowlink);
+    free(infer.scc);
+    free(infer.stack);
+}
@@ -3,6 +3,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "IR/ir_const_pool.h"
 #include "IR/ir_lowering.h"
 #include "IR/ir_pool.h"
 #include "IR/ir_type.h"
@@ -12,6 +13,17 @@
 #include "UTIL/datatypes.h"
 #include "UTIL/ground.h"
 
+static void ir_lower_const_cast_own_child(ir_pool_t *pool, ir_value_t **child){
+    // Literals may be interned and shared between many values, so lowering
+    // operates on a private copy of the child literal instead of the original
+    if((*child)->value_type != VALUE_TYPE_LITERAL) return;
+
+    ir_type_spec_t spec;
+    if(!ir_type_get_spec((*child)->type, &spec)) return;
+
+    *child = ir_literal_make(pool, (*child)->type, (*child)->extra, spec.bytes);
+}
+
 errorcode_t ir_lower_const_cast(ir_pool_t *pool, ir_value_t **inout_value){
     unsigned int value_type = (*inout_value)->value_type;
     if(!VALUE_TYPE_IS_CONSTANT_CAST(value_type)) return SUCCESS;
@@ -20,6 +32,8 @@ errorcode_t ir_lower_const_cast(ir_pool_t *pool, ir_value_t **inout_value){
     ir_value_t **child = (ir_value_t**) &((*inout_value)->extra);
     if(VALUE_TYPE_IS_CONSTANT_CAST((*child)->value_type) && ir_lower_const_cast(pool, child)) return FAILURE;
 
+    ir_lower_const_cast_own_child(pool, child);
+
     switch(value_type){
     case VALUE_TYPE_CONST_BITCAST:
         if(ir_lower_const_bitcast(inout_value)) return FAILURE;
@@ -309,20 +323,8 @@ errorcode_t ir_lower_const_fptoui(ir_pool_t *pool, ir_value_t **inout_value){
     
     const char *bits = (char*) &as_unsigned;
 
-    // Copy bytes of value to proper place of zero-initalized IR pool-allocated memory
-    void *new_value = memcpy(
-        memset(ir_pool_alloc(pool, to_spec.bytes), 0, to_spec.bytes),
-        is_little_endian() ? bits : &bits[sizeof(uint64_t) - to_spec.bytes],
-        to_spec.bytes
-    );
-
-    // Give back result
-    *inout_value = ir_pool_alloc_init(pool, ir_value_t, {
-        .value_type = VALUE_TYPE_LITERAL,
-        .type = type,
-        .extra = new_value,
-    });
-
+    // Give back result made from the proper bytes of the value
+    *inout_value = ir_literal_make(pool, type, is_little_endian() ? bits : &bits[sizeof(uint64_t) - to_spec.bytes], to_spec.bytes);
     return SUCCESS;
 }
 
@@ -358,12 +360,9 @@ errorcode_t ir_lower_const_fptosi(ir_pool_t *pool, ir_value_t **inout_value){
 
     const char *bits = (char*) &as_signed;
 
-    // Copy bytes of value to proper place of zero-initalized IR pool-allocated memory
-    void *new_value = memcpy(
-        memset(ir_pool_alloc(pool, to_spec.bytes), 0, to_spec.bytes),
-        is_little_endian() ? bits : &bits[sizeof(uint64_t) - to_spec.bytes],
-        to_spec.bytes
-    );
+    // Give back result made from the proper bytes of the value
+    *inout_value = ir_literal_make(pool, type, is_little_endian() ? bits : &bits[sizeof(uint64_t) - to_spec.bytes], to_spec.bytes);
+    void *new_value = (*inout_value)->extra;
 
     // Treat as signed integer of same size for platform independent sign swap and representation formatting
     if(is_signed){
@@ -386,13 +385,6 @@ errorcode_t ir_lower_const_fptosi(ir_pool_t *pool, ir_value_t **inout_value){
         }
     }
 
-    // Give back result
-    *inout_value = ir_pool_alloc_init(pool, ir_value_t, {
-        .value_type = VALUE_TYPE_LITERAL,
-        .type = type,
-        .extra = new_value,
-    });
-    
     return SUCCESS;
 }
 
@@ -0,0 +1,650 @@
+
+#include "IR/ir_merge.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "BRIDGE/bridge.h"
+#include "IR/ir.h"
+#include "IR/ir_pass.h"
+#include "IR/ir_type.h"
+#include "IR/ir_value.h"
+#include "UTIL/datatypes.h"
+#include "UTIL/ground.h"
+#include "UTIL/trait.h"
+#include "UTIL/util.h"
+
+// Function traits that change how a function is called or optimized, and so must match for functions to be merged
+#define IR_MERGE_SIGNATURE_TRAITS (IR_FUNC_VARARG | IR_FUNC_STDCALL | IR_FUNC_VALIDATE_VTABLE | IR_FUNC_COROUTINE | IR_MERGE_PERFORMANCE_TRAITS)
+#define IR_MERGE_PERFORMANCE_TRAITS (IR_FUNC_ALWAYS_INLINE | IR_FUNC_NO_INLINE | IR_FUNC_HOT | IR_FUNC_COLD | IR_FUNC_FLATTEN \
+        | IR_FUNC_OPTIMIZE_NONE | IR_FUNC_OPTIMIZE_SIZE | IR_FUNC_OPTIMIZE_AGGRESSIVE)
+
+// ---------------- ir_merge_t ----------------
+// State for merging the functions of an IR module
+typedef struct {
+    ir_module_t *module;
+    func_id_t *leaders; // [func] -> function that will be used in its place
+    bool *eligible;     // [func] -> whether the function can be merged with others
+} ir_merge_t;
+
+// ---------------- ir_merge_candidate_t ----------------
+// A function and the hash of its code
+typedef struct {
+    uint64_t hash;
+    func_id_t ir_func_id;
+} ir_merge_candidate_t;
+
+static func_id_t ir_merge_resolve(ir_merge_t *merge, func_id_t ir_func_id){
+    while(merge->leaders[ir_func_id] != ir_func_id){
+        ir_func_id = merge->leaders[ir_func_id];
+    }
+    return ir_func_id;
+}
+
+static uint64_t ir_merge_hash_combine(uint64_t hash, uint64_t value){
+    // FNV-1a style mixing
+    return (hash ^ value) * 0x100000001B3ull;
+}
+
+static uint64_t ir_merge_hash_type(uint64_t hash, ir_type_t *type){
+    if(type == NULL) return ir_merge_hash_combine(hash, 0xFFFF);
+
+    hash = ir_merge_hash_combine(hash, type->kind);
+
+    switch(type->kind){
+    case TYPE_KIND_POINTER:
+        return ir_merge_hash_type(hash, (ir_type_t*) type->extra);
+    case TYPE_KIND_STRUCTURE: case TYPE_KIND_UNION: {
+            ir_type_extra_composite_t *composite = (ir_type_extra_composite_t*) type->extra;
+            hash = ir_merge_hash_combine(hash, composite->subtypes_length);
+            hash = ir_merge_hash_combine(hash, composite->alignment);
+
+            for(length_t i = 0; i != composite->subtypes_length; i++){
+                hash = ir_merge_hash_type(hash, composite->subtypes[i]);
+            }
+        }
+        return hash;
+    case TYPE_KIND_FIXED_ARRAY:
+        hash = ir_merge_hash_combine(hash, ((ir_type_extra_fixed_array_t*) type->extra)->length);
+        return ir_merge_hash_type(hash, ((ir_type_extra_fixed_array_t*) type->extra)->subtype);
+    case TYPE_KIND_VECTOR:
+        hash = ir_merge_hash_combine(hash, ((ir_type_extra_vector_t*) type->extra)->length);
+        return ir_merge_hash_type(hash, ((ir_type_extra_vector_t*) type->extra)->subtype);
+    }
+
+    return hash;
+}
+
+static bool ir_merge_types_equal(ir_type_t *a, ir_type_t *b){
+    // Like 'ir_types_identical', except that fixed array lengths
+    // and composite traits also have to match
+
+    if(a == b) return true;
+    if(a == NULL || b == NULL || a->kind != b->kind) return false;
+
+    switch(a->kind){
+    case TYPE_KIND_POINTER:
+        return ir_merge_types_equal((ir_type_t*) a->extra, (ir_type_t*) b->extra);
+    case TYPE_KIND_STRUCTURE: case TYPE_KIND_UNION: {
+            ir_type_extra_composite_t *composite_a = (ir_type_extra_composite_t*) a->extra;
+            ir_type_extra_composite_t *composite_b = (ir_type_extra_composite_t*) b->extra;
+
+            if(composite_a->subtypes_length != composite_b->subtypes_length) return false;
+            if(composite_a->traits != composite_b->traits) return false;
+            if(composite_a->alignment != composite_b->alignment) return false;
+            if((composite_a->subtype_alignments == NULL) != (composite_b->subtype_alignments == NULL)) return false;
+
+            for(length_t i = 0; i != composite_a->subtypes_length; i++){
+                if(!ir_merge_types_equal(composite_a->subtypes[i], composite_b->subtypes[i])) return false;
+
+                if(composite_a->subtype_alignments && composite_a->subtype_alignments[i] != composite_b->subtype_alignments[i]){
+                    return false;
+                }
+            }
+        }
+        return true;
+    case TYPE_KIND_FIXED_ARRAY: {
+            ir_type_extra_fixed_array_t *fixed_a = (ir_type_extra_fixed_array_t*) a->extra;
+            ir_type_extra_fixed_array_t *fixed_b = (ir_type_extra_fixed_array_t*) b->extra;
+            return fixed_a->length == fixed_b->length && ir_merge_types_equal(fixed_a->subtype, fixed_b->subtype);
+        }
+    case TYPE_KIND_VECTOR: {
+            ir_type_extra_vector_t *vector_a = (ir_type_extra_vector_t*) a->extra;
+            ir_type_extra_vector_t *vector_b = (ir_type_extra_vector_t*) b->extra;
+            return vector_a->length == vector_b->length && ir_merge_types_equal(vector_a->subtype, vector_b->subtype);
+        }
+    case TYPE_KIND_UNKNOWN_ENUM: case TYPE_KIND_UNBUILT_COMPOSITE:
+        return false;
+    }
+
+    return true;
+}
+
+static length_t ir_merge_literal_size(unsigned int kind){
+    switch(kind){
+    case TYPE_KIND_S8:      return sizeof(adept_byte);
+    case TYPE_KIND_U8:      return sizeof(adept_ubyte);
+    case TYPE_KIND_S16:     return sizeof(adept_short);
+    case TYPE_KIND_U16:     return sizeof(adept_ushort);
+    case TYPE_KIND_S32:     return sizeof(adept_int);
+    case TYPE_KIND_U32:     return sizeof(adept_uint);
+    case TYPE_KIND_S64:     return sizeof(adept_long);
+    case TYPE_KIND_U64:     return sizeof(adept_ulong);
+    case TYPE_KIND_FLOAT:   return sizeof(adept_float);
+    case TYPE_KIND_DOUBLE:  return sizeof(adept_double);
+    case TYPE_KIND_BOOLEAN: return sizeof(adept_bool);
+    }
+    return 0;
+}
+
+static bool ir_merge_values_equal(ir_merge_t *merge, ir_value_t *a, ir_value_t *b);
+
+static bool ir_merge_value_lists_equal(ir_merge_t *merge, ir_value_t **a, length_t a_length, ir_value_t **b, length_t b_length){
+    if(a_length != b_length) return false;
+
+    for(length_t i = 0; i != a_length; i++){
+        if(!ir_merge_values_equal(merge, a[i], b[i])) return false;
+    }
+    return true;
+}
+
+static bool ir_merge_values_equal(ir_merge_t *merge, ir_value_t *a, ir_value_t *b){
+    if(a == b) return true;
+    if(a == NULL || b == NULL) return false;
+    if(a->value_type != b->value_type || !ir_merge_types_equal(a->type, b->type)) return false;
+
+    switch(a->value_type){
+    case VALUE_TYPE_RESULT:
+        return a->result.block_id == b->result.block_id && a->result.instruction_id == b->result.instruction_id;
+    case VALUE_TYPE_ANON_GLOBAL: case VALUE_TYPE_CONST_ANON_GLOBAL:
+        return ((ir_value_anon_global_t*) a->extra)->anon_global_id == ((ir_value_anon_global_t*) b->extra)->anon_global_id;
+    case VALUE_TYPE_ARRAY_LITERAL: {
+            ir_value_array_literal_t *literal_a = (ir_value_array_literal_t*) a->extra;
+            ir_value_array_literal_t *literal_b = (ir_value_array_literal_t*) b->extra;
+            return ir_merge_value_lists_equal(merge, literal_a->values, literal_a->length, literal_b->values, literal_b->length);
+        }
+    case VALUE_TYPE_STRUCT_LITERAL: {
+            ir_value_struct_literal_t *literal_a = (ir_value_struct_literal_t*) a->extra;
+            ir_value_struct_literal_t *literal_b = (ir_value_struct_literal_t*) b->extra;
+            return ir_merge_value_lists_equal(merge, literal_a->values, literal_a->length, literal_b->values, literal_b->length);
+        }
+    case VALUE_TYPE_CONST_STRUCT_LITERAL: {
+            ir_value_const_struct_literal_t *literal_a = (ir_value_const_struct_literal_t*) a->extra;
+            ir_value_const_struct_literal_t *literal_b = (ir_value_const_struct_literal_t*) b->extra;
+            return ir_merge_value_lists_equal(merge, literal_a->values, literal_a->length, literal_b->values, literal_b->length);
+        }
+    case VALUE_TYPE_OFFSETOF: {
+            ir_value_offsetof_t *offsetof_a = (ir_value_offsetof_t*) a->extra;
+            ir_value_offsetof_t *offsetof_b = (ir_value_offsetof_t*) b->extra;
+            return offsetof_a->index == offsetof_b->index && ir_merge_types_equal(offsetof_a->type, offsetof_b->type);
+        }
+    case VALUE_TYPE_LITERAL: {
+            length_t size = ir_merge_literal_size(a->type->kind);
+            return size != 0 && memcmp(a->extra, b->extra, size) == 0;
+        }
+    case VALUE_TYPE_NULLPTR: case VALUE_TYPE_NULLPTR_OF_TYPE:
+        return true;
+    case VALUE_TYPE_CSTR_OF_LEN: {
+            ir_value_cstr_of_len_t *cstr_a = (ir_value_cstr_of_len_t*) a->extra;
+            ir_value_cstr_of_len_t *cstr_b = (ir_value_cstr_of_len_t*) b->extra;
+            return cstr_a->size == cstr_b->size && memcmp(cstr_a->array, cstr_b->array, cstr_a->size) == 0;
+        }
+    case VALUE_TYPE_FUNC_ADDR:
+        return ir_merge_resolve(merge, ((ir_value_func_addr_t*) a->extra)->ir_func_id)
+            == ir_merge_resolve(merge, ((ir_value_func_addr_t*) b->extra)->ir_func_id);
+    case VALUE_TYPE_FUNC_ADDR_BY_NAME:
+        return streq(((ir_value_func_addr_by_name_t*) a->extra)->name, ((ir_value_func_addr_by_name_t*) b->extra)->name);
+    case VALUE_TYPE_CONST_SIZEOF:
+        return ir_merge_types_equal(((ir_value_const_sizeof_t*) a->extra)->type, ((ir_value_const_sizeof_t*) b->extra)->type);
+    case VALUE_TYPE_CONST_ALIGNOF:
+        return ir_merge_types_equal(((ir_value_const_alignof_t*) a->extra)->type, ((ir_value_const_alignof_t*) b->extra)->type);
+    case VALUE_TYPE_CONST_ADD: {
+            ir_value_const_math_t *math_a = (ir_value_const_math_t*) a->extra;
+            ir_value_const_math_t *math_b = (ir_value_const_math_t*) b->extra;
+            return ir_merge_values_equal(merge, math_a->a, math_b->a) && ir_merge_values_equal(merge, math_a->b, math_b->b);
+        }
+    }
+
+    if(VALUE_TYPE_IS_CONSTANT_CAST(a->value_type)){
+        return ir_merge_values_equal(merge, (ir_value_t*) a->extra, (ir_value_t*) b->extra);
+    }
+
+    return false;
+}
+
+static bool ir_merge_instrs_equal(ir_merge_t *merge, ir_instr_t *a, ir_instr_t *b){
+    if(a->id != b->id) return false;
+
+    // NOTE: Zero-initialization instructions don't have a result type
+    if(a->id != INSTRUCTION_ZEROINIT && !ir_merge_types_equal(a->result_type, b->result_type)) return false;
+
+    #define ir_merge_instrs_equal_values(TYPE, FIELD) ir_merge_values_equal(merge, ((TYPE*) a)->FIELD, ((TYPE*) b)->FIELD)
+    #define ir_merge_instrs_equal_fields(TYPE, FIELD) (((TYPE*) a)->FIELD == ((TYPE*) b)->FIELD)
+
+    switch(a->id){
+    case INSTRUCTION_ADD: case INSTRUCTION_FADD: case INSTRUCTION_SUBTRACT: case INSTRUCTION_FSUBTRACT:
+    case INSTRUCTION_MULTIPLY: case INSTRUCTION_FMULTIPLY: case INSTRUCTION_UDIVIDE: case INSTRUCTION_SDIVIDE:
+    case INSTRUCTION_FDIVIDE: case INSTRUCTION_UMODULUS: case INSTRUCTION_SMODULUS: case INSTRUCTION_FMODULUS:
+    case INSTRUCTION_EQUALS: case INSTRUCTION_FEQUALS: case INSTRUCTION_NOTEQUALS: case INSTRUCTION_FNOTEQUALS:
+    case INSTRUCTION_UGREATER: case INSTRUCTION_SGREATER: case INSTRUCTION_FGREATER:
+    case INSTRUCTION_ULESSER: case INSTRUCTION_SLESSER: case INSTRUCTION_FLESSER:
+    case INSTRUCTION_UGREATEREQ: case INSTRUCTION_SGREATEREQ: case INSTRUCTION_FGREATEREQ:
+    case INSTRUCTION_ULESSEREQ: case INSTRUCTION_SLESSEREQ: case INSTRUCTION_FLESSEREQ:
+    case INSTRUCTION_AND: case INSTRUCTION_OR: case INSTRUCTION_BIT_AND: case INSTRUCTION_BIT_OR: case INSTRUCTION_BIT_XOR:
+    case INSTRUCTION_BIT_LSHIFT: case INSTRUCTION_BIT_RSHIFT: case INSTRUCTION_BIT_LGC_RSHIFT:
+        return ir_merge_instrs_equal_values(ir_instr_math_t, a) && ir_merge_instrs_equal_values(ir_instr_math_t, b);
+    case INSTRUCTION_BITCAST: case INSTRUCTION_ZEXT: case INSTRUCTION_SEXT: case INSTRUCTION_TRUNC:
+    case INSTRUCTION_FEXT: case INSTRUCTION_FTRUNC: case INSTRUCTION_INTTOPTR: case INSTRUCTION_PTRTOINT:
+    case INSTRUCTION_FPTOUI: case INSTRUCTION_FPTOSI: case INSTRUCTION_UITOFP: case INSTRUCTION_SITOFP:
+    case INSTRUCTION_REINTERPRET: case INSTRUCTION_VECTOR_SPLAT:
+        return ir_merge_instrs_equal_values(ir_instr_cast_t, value);
+    case INSTRUCTION_ISZERO: case INSTRUCTION_ISNTZERO: case INSTRUCTION_BIT_COMPLEMENT:
+    case INSTRUCTION_NEGATE: case INSTRUCTION_FNEGATE: case INSTRUCTION_STACK_RESTORE:
+    case INSTRUCTION_VA_START: case INSTRUCTION_VA_END:
+    case INSTRUCTION_COROUTINE_SUSPEND: case INSTRUCTION_COROUTINE_RESUME: case INSTRUCTION_COROUTINE_DESTROY:
+    case INSTRUCTION_COROUTINE_DONE: case INSTRUCTION_COROUTINE_VALUE:
+        return ir_merge_instrs_equal_values(ir_instr_unary_t, value);
+    case INSTRUCTION_RET:
+        return ir_merge_instrs_equal_values(ir_instr_ret_t, value);
+    case INSTRUCTION_CALL: {
+            ir_instr_call_t *call_a = (ir_instr_call_t*) a;
+            ir_instr_call_t *call_b = (ir_instr_call_t*) b;
+
+            return ir_merge_resolve(merge, call_a->ir_func_id) == ir_merge_resolve(merge, call_b->ir_func_id)
+                && ir_merge_value_lists_equal(merge, call_a->values, call_a->values_length, call_b->values, call_b->values_length);
+        }
+    case INSTRUCTION_CALL_ADDRESS: {
+            ir_instr_call_address_t *call_a = (ir_instr_call_address_t*) a;
+            ir_instr_call_address_t *call_b = (ir_instr_call_address_t*) b;
+
+            if(call_a->function_is_vararg != call_b->function_is_vararg) return false;
+            if(call_a->function_arg_types_length != call_b->function_arg_types_length) return false;
+
+            for(length_t i = 0; i != call_a->function_arg_types_length; i++){
+                if(!ir_merge_types_equal(call_a->function_arg_types[i], call_b->function_arg_types[i])) return false;
+            }
+
+            return ir_merge_values_equal(merge, call_a->function_address, call_b->function_address)
+                && ir_merge_value_lists_equal(merge, call_a->values, call_a->values_length, call_b->values, call_b->values_length);
+        }
+    case INSTRUCTION_ALLOC:
+        return ir_merge_instrs_equal_fields(ir_instr_alloc_t, alignment) && ir_merge_instrs_equal_values(ir_instr_alloc_t, count);
+    case INSTRUCTION_MALLOC:
+        return ir_merge_instrs_equal_fields(ir_instr_malloc_t, is_undef)
+            && ir_merge_types_equal(((ir_instr_malloc_t*) a)->type, ((ir_instr_malloc_t*) b)->type)
+            && ir_merge_instrs_equal_values(ir_instr_malloc_t, amount);
+    case INSTRUCTION_FREE:
+        return ir_merge_instrs_equal_values(ir_instr_free_t, value);
+    case INSTRUCTION_STORE:
+        return ir_merge_instrs_equal_values(ir_instr_store_t, value) && ir_merge_instrs_equal_values(ir_instr_store_t, destination);
+    case INSTRUCTION_LOAD:
+        return ir_merge_instrs_equal_values(ir_instr_load_t, value);
+    case INSTRUCTION_VARPTR: case INSTRUCTION_GLOBALVARPTR:
+        return ir_merge_instrs_equal_fields(ir_instr_varptr_t, index);
+    case INSTRUCTION_BREAK:
+        return ir_merge_instrs_equal_fields(ir_instr_break_t, block_id);
+    case INSTRUCTION_CONDBREAK:
+        return ir_merge_instrs_equal_fields(ir_instr_cond_break_t, true_block_id)
+            && ir_merge_instrs_equal_fields(ir_instr_cond_break_t, false_block_id)
+            && ir_merge_instrs_equal_fields(ir_instr_cond_break_t, likely)
+            && ir_merge_instrs_equal_values(ir_instr_cond_break_t, value);
+    case INSTRUCTION_MEMBER:
+        return ir_merge_instrs_equal_fields(ir_instr_member_t, member) && ir_merge_instrs_equal_values(ir_instr_member_t, value);
+    case INSTRUCTION_ARRAY_ACCESS:
+        return ir_merge_instrs_equal_values(ir_instr_array_access_t, value) && ir_merge_instrs_equal_values(ir_instr_array_access_t, index);
+    case INSTRUCTION_SIZEOF:
+        return ir_merge_types_equal(((ir_instr_sizeof_t*) a)->type, ((ir_instr_sizeof_t*) b)->type);
+    case INSTRUCTION_OFFSETOF:
+        return ir_merge_instrs_equal_fields(ir_instr_offsetof_t, index)
+            && ir_merge_types_equal(((ir_instr_offsetof_t*) a)->type, ((ir_instr_offsetof_t*) b)->type);
+    case INSTRUCTION_ZEROINIT:
+        return ir_merge_instrs_equal_values(ir_instr_zeroinit_t, destination);
+    case INSTRUCTION_MEMCPY:
+        return ir_merge_instrs_equal_fields(ir_instr_memcpy_t, is_volatile)
+            && ir_merge_instrs_equal_values(ir_instr_memcpy_t, destination)
+            && ir_merge_instrs_equal_values(ir_instr_memcpy_t, value)
+            && ir_merge_instrs_equal_values(ir_instr_memcpy_t, bytes);
+    case INSTRUCTION_SELECT:
+        return ir_merge_instrs_equal_values(ir_instr_select_t, condition)
+            && ir_merge_instrs_equal_values(ir_instr_select_t, if_true)
+            && ir_merge_instrs_equal_values(ir_instr_select_t, if_false);
+    case INSTRUCTION_PHI2:
+        return ir_merge_instrs_equal_fields(ir_instr_phi2_t, block_id_a)
+            && ir_merge_instrs_equal_fields(ir_instr_phi2_t, block_id_b)
+            && ir_merge_instrs_equal_values(ir_instr_phi2_t, a)
+            && ir_merge_instrs_equal_values(ir_instr_phi2_t, b);
+    case INSTRUCTION_SWITCH: {
+            ir_instr_switch_t *switch_a = (ir_instr_switch_t*) a;
+            ir_instr_switch_t *switch_b = (ir_instr_switch_t*) b;
+
+            if(switch_a->default_block_id != switch_b->default_block_id) return false;
+            if(switch_a->resume_block_id != switch_b->resume_block_id) return false;
+            if(switch_a->cases_length != switch_b->cases_length) return false;
+
+            for(length_t i = 0; i != switch_a->cases_length; i++){
+                if(switch_a->case_block_ids[i] != switch_b->case_block_ids[i]) return false;
+            }
+
+            if((switch_a->case_likely == NULL) != (switch_b->case_likely == NULL)) return false;
+
+            if(switch_a->case_likely && memcmp(switch_a->case_likely, switch_b->case_likely, sizeof(troolean) * switch_a->cases_length) != 0){
+                return false;
+            }
+
+            return ir_merge_values_equal(merge, switch_a->condition, switch_b->condition)
+                && ir_merge_value_lists_equal(merge, switch_a->case_values, switch_a->cases_length, switch_b->case_values, switch_b->cases_length);
+        }
+    case INSTRUCTION_VECTOR_SHUFFLE: {
+            ir_instr_shuffle_t *shuffle_a = (ir_instr_shuffle_t*) a;
+            ir_instr_shuffle_t *shuffle_b = (ir_instr_shuffle_t*) b;
+
+            if(shuffle_a->mask_length != shuffle_b->mask_length) return false;
+
+            for(length_t i = 0; i != shuffle_a->mask_length; i++){
+                if(shuffle_a->mask[i] != shuffle_b->mask[i]) return false;
+            }
+
+            return ir_merge_values_equal(merge, shuffle_a->a, shuffle_b->a) && ir_merge_values_equal(merge, shuffle_a->b, shuffle_b->b);
+        }
+    case INSTRUCTION_VECTOR_REDUCE:
+        return ir_merge_instrs_equal_fields(ir_instr_vector_reduce_t, operation) && ir_merge_instrs_equal_values(ir_instr_vector_reduce_t, value);
+    case INSTRUCTION_INTRINSIC: {
+            ir_instr_intrinsic_t *intrinsic_a = (ir_instr_intrinsic_t*) a;
+            ir_instr_intrinsic_t *intrinsic_b = (ir_instr_intrinsic_t*) b;
+
+            return intrinsic_a->intrinsic == intrinsic_b->intrinsic
+                && ir_merge_value_lists_equal(merge, intrinsic_a->values, intrinsic_a->values_length, intrinsic_b->values, intrinsic_b->values_length);
+        }
+    case INSTRUCTION_ATOMIC_LOAD: case INSTRUCTION_ATOMIC_STORE: case INSTRUCTION_ATOMIC_RMW:
+    case INSTRUCTION_ATOMIC_CMPXCHG: case INSTRUCTION_FENCE:
+        return ir_merge_instrs_equal_fields(ir_instr_atomic_t, operation)
+            && ir_merge_instrs_equal_fields(ir_instr_atomic_t, ordering)
+            && ir_merge_instrs_equal_fields(ir_instr_atomic_t, failure_ordering)
+            && ir_merge_instrs_equal_values(ir_instr_atomic_t, pointer)
+            && ir_merge_instrs_equal_values(ir_instr_atomic_t, value)
+            && ir_merge_instrs_equal_values(ir_instr_atomic_t, expected);
+    case INSTRUCTION_PARALLEL_FOR:
+        return ir_merge_instrs_equal_values(ir_instr_parallel_for_t, body)
+            && ir_merge_instrs_equal_values(ir_instr_parallel_for_t, env)
+            && ir_merge_instrs_equal_values(ir_instr_parallel_for_t, count);
+    case INSTRUCTION_VA_ARG:
+        return ir_merge_instrs_equal_values(ir_instr_va_arg_t, va_list);
+    case INSTRUCTION_VA_COPY:
+        return ir_merge_instrs_equal_values(ir_instr_va_copy_t, dest_value) && ir_merge_instrs_equal_values(ir_instr_va_copy_t, src_value);
+    case INSTRUCTION_ASM: {
+            ir_instr_asm_t *asm_a = (ir_instr_asm_t*) a;
+            ir_instr_asm_t *asm_b = (ir_instr_asm_t*) b;
+
+            return asm_a->is_intel == asm_b->is_intel
+                && asm_a->has_side_effects == asm_b->has_side_effects
+                && asm_a->is_stack_align == asm_b->is_stack_align
+                && streq(asm_a->assembly, asm_b->assembly)
+                && streq(asm_a->constraints, asm_b->constraints)
+                && ir_merge_value_lists_equal(merge, asm_a->args, asm_a->arity, asm_b->args, asm_b->arity);
+        }
+    case INSTRUCTION_STACK_SAVE: case INSTRUCTION_UNREACHABLE:
+        return true;
+    }
+
+    #undef ir_merge_instrs_equal_values
+    #undef ir_merge_instrs_equal_fields
+
+    // Static variable pointers and anything unknown are never considered equal
+    return false;
+}
+
+static bool ir_merge_funcs_equal(ir_merge_t *merge, ir_func_t *a, ir_func_t *b){
+    if(a->arity != b->arity) return false;
+    if((a->traits & IR_MERGE_SIGNATURE_TRAITS) != (b->traits & IR_MERGE_SIGNATURE_TRAITS)) return false;
+    if(!ir_merge_types_equal(a->return_type, b->return_type)) return false;
+
+    for(length_t i = 0; i != a->arity; i++){
+        if(!ir_merge_types_equal(a->argument_types[i], b->argument_types[i])) return false;
+    }
+
+    if(a->variable_count != b->variable_count) return false;
+
+    for(length_t v = 0; v != a->variable_count; v++){
+        bridge_var_t *var_a = bridge_scope_find_var_by_id(a->scope, v);
+        bridge_var_t *var_b = bridge_scope_find_var_by_id(b->scope, v);
+        if(!ir_merge_types_equal(var_a->ir_type, var_b->ir_type)) return false;
+    }
+
+    if(a->basicblocks.length != b->basicblocks.length) return false;
+
+    for(length_t block_id = 0; block_id != a->basicblocks.length; block_id++){
+        ir_instrs_t *instructions_a = &a->basicblocks.blocks[block_id].instructions;
+        ir_instrs_t *instructions_b = &b->basicblocks.blocks[block_id].instructions;
+
+        if(instructions_a->length != instructions_b->length) return false;
+
+        for(length_t i = 0; i != instructions_a->length; i++){
+            if(!ir_merge_instrs_equal(merge, instructions_a->instructions[i], instructions_b->instructions[i])) return false;
+        }
+    }
+
+    return true;
+}
+
+static uint64_t ir_merge_hash_func(ir_merge_t *merge, ir_func_t *func){
+    // NOTE: Only has to be cheap and consistent with 'ir_merge_funcs_equal',
+    // functions with the same hash still get compared in full
+
+    uint64_t hash = 0xCBF29CE484222325ull;
+    hash = ir_merge_hash_combine(hash, func->arity);
+    hash = ir_merge_hash_combine(hash, func->traits & IR_MERGE_SIGNATURE_TRAITS);
+    hash = ir_merge_hash_type(hash, func->return_type);
+
+    for(length_t i = 0; i != func->arity; i++){
+        hash = ir_merge_hash_type(hash, func->argument_types[i]);
+    }
+
+    hash = ir_merge_hash_combine(hash, func->variable_count);
+    hash = ir_merge_hash_combine(hash, func->basicblocks.length);
+
+    for(length_t b = 0; b != func->basicblocks.length; b++){
+        ir_instrs_t *instructions = &func->basicblocks.blocks[b].instructions;
+        hash = ir_merge_hash_combine(hash, instructions->length);
+
+        for(length_t i = 0; i != instructions->length; i++){
+            ir_instr_t *instr = instructions->instructions[i];
+            hash = ir_merge_hash_combine(hash, instr->id);
+
+            if(instr->id == INSTRUCTION_CALL){
+                hash = ir_merge_hash_combine(hash, ir_merge_resolve(merge, ((ir_instr_call_t*) instr)->ir_func_id));
+            } else if(instr->id != INSTRUCTION_ZEROINIT && instr->result_type){
+                hash = ir_merge_hash_combine(hash, instr->result_type->kind);
+            }
+        }
+    }
+
+    return hash;
+}
+
+static bool ir_merge_is_eligible(ir_module_t *module, func_id_t ir_func_id){
+    ir_func_t *func = ir_funcs_at(&module->funcs, ir_func_id);
+
+    // Functions that are visible outside of the module, that get code injected into them,
+    // or whose address can be compared by user code must stay unique
+    if(func->traits & (IR_FUNC_FOREIGN | IR_FUNC_MAIN | IR_FUNC_INIT | IR_FUNC_DEINIT | IR_FUNC_UNREFERENCED | IR_FUNC_ADDRESS_EXPOSED)) return false;
+    if(func->export_as || func->basicblocks.length == 0 || func->scope == NULL) return false;
+    if(module->common.has_init && module->common.ir_init_id == ir_func_id) return false;
+    if(module->common.has_deinit && module->common.ir_deinit_id == ir_func_id) return false;
+
+    // Static variables are unique to each function
+    for(length_t v = 0; v != func->variable_count; v++){
+        bridge_var_t *var = bridge_scope_find_var_by_id(func->scope, v);
+        if(var == NULL || var->traits & BRIDGE_VAR_STATIC) return false;
+    }
+
+    for(length_t b = 0; b != func->basicblocks.length; b++){
+        ir_instrs_t *instructions = &func->basicblocks.blocks[b].instructions;
+
+        for(length_t i = 0; i != instructions->length; i++){
+            ir_instr_t *instr = instructions->instructions[i];
+
+            switch(instr->id){
+            case INSTRUCTION_STATICVARPTR:
+            case INSTRUCTION_DEINIT_SVARS:
+                return false;
+            case INSTRUCTION_CALL:
+                // Runtime vtable checks report which function they failed in
+                if(ir_funcs_at(&module->funcs, ((ir_instr_call_t*) instr)->ir_func_id)->traits & IR_FUNC_VALIDATE_VTABLE) return false;
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+static int ir_merge_candidate_cmp(const void *a, const void *b){
+    const ir_merge_candidate_t *candidate_a = (const ir_merge_candidate_t*) a;
+    const ir_merge_candidate_t *candidate_b = (const ir_merge_candidate_t*) b;
+
+    if(candidate_a->hash != candidate_b->hash) return candidate_a->hash < candidate_b->hash ? -1 : 1;
+    if(candidate_a->ir_func_id != candidate_b->ir_func_id) return candidate_a->ir_func_id < candidate_b->ir_func_id ? -1 : 1;
+    return 0;
+}
+
+static length_t ir_merge_round(ir_merge_t *merge, ir_merge_candidate_t *candidates){
+    // Merges functions that are identical given the merges made so far,
+    // returns the number of functions that were merged
+
+    ir_funcs_t *funcs = &merge->module->funcs;
+    length_t candidates_length = 0;
+    length_t merged = 0;
+
+    for(length_t f = 0; f != funcs->length; f++){
+        if(!merge->eligible[f] || merge->leaders[f] != f) continue;
+
+        candidates[candidates_length++] = (ir_merge_candidate_t){
+            .hash = ir_merge_hash_func(merge, ir_funcs_at(funcs, f)),
+            .ir_func_id = f,
+        };
+    }
+
+    qsort(candidates, candidates_length, sizeof(ir_merge_candidate_t), ir_merge_candidate_cmp);
+
+    for(length_t start = 0; start != candidates_length;){
+        length_t end = start + 1;
+        while(end != candidates_length && candidates[end].hash == candidates[start].hash) end++;
+
+        // Always keep the function that was created first
+        for(length_t i = start; i != end; i++){
+            func_id_t leader = candidates[i].ir_func_id;
+            if(merge->leaders[leader] != leader) continue;
+
+            for(length_t j = i + 1; j != end; j++){
+                func_id_t other = candidates[j].ir_func_id;
+                if(merge->leaders[other] != other) continue;
+
+                if(ir_merge_funcs_equal(merge, ir_funcs_at(funcs, leader), ir_funcs_at(funcs, other))){
+                    merge->leaders[other] = leader;
+                    merged++;
+                }
+            }
+        }
+
+        start = end;
+    }
+
+    return merged;
+}
+
+static void ir_merge_redirect_value(ir_value_t **slot, void *user_data){
+    ir_value_t *value = *slot;
+
+    if(value->value_type == VALUE_TYPE_FUNC_ADDR){
+        ir_value_func_addr_t *func_addr = (ir_value_func_addr_t*) value->extra;
+        func_addr->ir_func_id = ir_merge_resolve((ir_merge_t*) user_data, func_addr->ir_func_id);
+    }
+}
+
+static void ir_merge_redirect(ir_merge_t *merge){
+    ir_module_t *module = merge->module;
+
+    for(length_t f = 0; f != module->funcs.length; f++){
+        ir_func_t *func = ir_funcs_at(&module->funcs, f);
+        if(func->traits & IR_FUNC_UNREFERENCED) continue;
+
+        for(length_t b = 0; b != func->basicblocks.length; b++){
+            ir_instrs_t *instructions = &func->basicblocks.blocks[b].instructions;
+
+            for(length_t i = 0; i != instructions->length; i++){
+                ir_instr_t *instr = instructions->instructions[i];
+
+                if(instr->id == INSTRUCTION_CALL){
+                    ir_instr_call_t *call = (ir_instr_call_t*) instr;
+                    call->ir_func_id = ir_merge_resolve(merge, call->ir_func_id);
+                }
+
+                ir_pass_visit_operands(instr, ir_merge_redirect_value, merge);
+            }
+        }
+    }
+
+    for(length_t i = 0; i != module->globals_length; i++){
+        ir_pass_visit_value(&module->globals[i].trusted_static_initializer, ir_merge_redirect_value, merge);
+    }
+
+    for(length_t i = 0; i != module->anon_globals.length; i++){
+        ir_pass_visit_value(&module->anon_globals.globals[i].initializer, ir_merge_redirect_value, merge);
+    }
+}
+
+length_t ir_module_merge_identical_funcs(ir_module_t *ir_module){
+    ir_funcs_t *funcs = &ir_module->funcs;
+
+    ir_merge_t merge = (ir_merge_t){
+        .module = ir_module,
+        .leaders = malloc(sizeof(func_id_t) * length_max(1, funcs->length)),
+        .eligible = malloc(sizeof(bool) * length_max(1, funcs->length)),
+    };
+
+    length_t eligible_count = 0;
+
+    for(length_t f = 0; f != funcs->length; f++){
+        merge.leaders[f] = f;
+        merge.eligible[f] = ir_merge_is_eligible(ir_module, f);
+        if(merge.eligible[f]) eligible_count++;
+    }
+
+    length_t total_merged = 0;
+
+    if(eligible_count > 1){
+        ir_merge_candidate_t *candidates = malloc(sizeof(ir_merge_candidate_t) * eligible_count);
+
+        // Merging callees can make their callers identical, so repeat until nothing changes
+        length_t merged;
+        while((merged = ir_merge_round(&merge, candidates)) != 0){
+            total_merged += merged;
+        }
+
+        free(candidates);
+    }
+
+    if(total_merged != 0){
+        ir_merge_redirect(&merge);
+
+        for(length_t f = 0; f != funcs->length; f++){
+            if(merge.leaders[f] == f) continue;
+
+            func_id_t leader_id = ir_merge_resolve(&merge, f);
+            ir_func_t *func = ir_funcs_at(funcs, f);
+            ir_func_t *leader = ir_funcs_at(funcs, leader_id);
+
+            // Vtable entries that pointed to the folded function now point to the remaining one
+            leader->traits |= func->traits & IR_FUNC_ADDRESS_TAKEN;
+            func->traits |= IR_FUNC_UNREFERENCED;
+        }
+    }
+
+    free(merge.leaders);
+    free(merge.eligible);
+
+    ir_module->merged_funcs += total_merged;
+    return total_merged;
+}
@@ -6,6 +6,7 @@
 
 #include "IR/ir_type.h"
 #include "IRGEN/ir_builder.h"
+#include "IRGEN/ir_speculation.h"
 #include "UTIL/builtin_type.h"
 
 static rtti_collector_t *create_rtti_collector(ir_pool_t *pool){
@@ -20,15 +21,11 @@ static rtti_collector_t *create_rtti_collector(ir_pool_t *pool){
     return rtti_collector;
 }
 
-void ir_module_init(ir_module_t *ir_module, length_t funcs_capacity, length_t globals_length, length_t number_of_function_names_guess){
+void ir_module_init(ir_module_t *ir_module, length_t globals_length, length_t number_of_function_names_guess){
     ir_pool_t *pool = &ir_module->pool;
     ir_pool_init(pool);
 
-    ir_module->funcs = (ir_funcs_t){
-        .funcs = malloc(sizeof(ir_func_t) * funcs_capacity),
-        .length = 0,
-        .capacity = funcs_capacity,
-    };
+    ir_module->funcs = (ir_funcs_t){0};
 
     ir_proc_map_init(&ir_module->func_map, sizeof(ir_func_key_t), number_of_function_names_guess);
     ir_proc_map_init(&ir_module->method_map, sizeof(ir_method_key_t), 0);
@@ -51,6 +48,11 @@ void ir_module_init(ir_module_t *ir_module, length_t funcs_capacity, length_t gl
     ir_module->defer_free = (free_list_t){0};
     ir_module->vtable_init_list = (ir_vtable_init_list_t){0};
     ir_module->vtable_dispatch_list = (ir_vtable_dispatch_list_t){0};
+    ir_module->speculation = NULL;
+    ir_module->devirtualized_calls = 0;
+    ir_module->merged_funcs = 0;
+    ir_module->stripped_rtti = 0;
+    ir_module->rtti_table_referenced = false;
 
     // Create shared resources
     ir_module->common = (ir_shared_common_t){
@@ -66,7 +68,7 @@ void ir_module_init(ir_module_t *ir_module, length_t funcs_capacity, length_t gl
 }
 
 void ir_module_free(ir_module_t *ir_module){
-    ir_funcs_free(ir_module->funcs);
+    ir_funcs_free(&ir_module->funcs);
     ir_proc_map_free(&ir_module->func_map);
     ir_proc_map_free(&ir_module->method_map);
     ir_type_map_free(&ir_module->type_map);
@@ -117,6 +119,30 @@ void ir_module_create_func_mapping(ir_module_t *module, weak_cstr_t function_nam
     }
 }
 
+void ir_module_reference_func(ir_module_t *module, func_id_t ir_func_id){
+    ir_func_t *ir_func = ir_funcs_at(&module->funcs, ir_func_id);
+
+    if(ir_func->traits & IR_FUNC_UNREFERENCED){
+        // Scheduling a job would change the job list
+        if(ir_speculation_give_up(module->speculation)) return;
+
+        ir_func->traits &= ~IR_FUNC_UNREFERENCED;
+
+        ir_job_list_append(&module->job_list, ((ir_func_endpoint_t){
+            .ast_func_id = ir_func->ast_func_id,
+            .ir_func_id = ir_func_id,
+        }));
+    }
+}
+
+void ir_module_add_func_traits(ir_module_t *module, func_id_t ir_func_id, trait_t traits){
+    if(module->speculation){
+        ir_speculation_record_func_traits(module->speculation, ir_func_id, traits);
+    } else {
+        ir_funcs_at(&module->funcs, ir_func_id)->traits |= traits;
+    }
+}
+
 void ir_module_create_method_mapping(ir_module_t *module, weak_cstr_t struct_name, weak_cstr_t method_name, ir_func_endpoint_t endpoint){
     ir_method_key_t key = (ir_method_key_t){
         .method_name = method_name,
@@ -146,14 +172,19 @@ ir_value_t *ir_module_create_anon_global(ir_module_t *module, ir_type_t *type, b
         }
     ));
 
-    length_t anon_global_id = module->anon_globals.length - 1;
+    ir_value_anon_global_t *extra = ir_pool_alloc_init(&module->pool, ir_value_anon_global_t, {
+        .anon_global_id = module->anon_globals.length - 1,
+    });
+
+    // Speculative anonymous globals are renumbered once they're committed
+    if(module->speculation){
+        ir_speculation_record_anon_global(module->speculation, extra);
+    }
 
     return ir_pool_alloc_init(&module->pool, ir_value_t, {
         .value_type = value_type,
         .type = ir_type_make_pointer_to(&module->pool, type),
-        .extra = ir_pool_alloc_init(&module->pool, ir_value_anon_global_t, {
-            .anon_global_id = anon_global_id,
-        })
+        .extra = extra,
     });
 }
 
@@ -0,0 +1,1231 @@
+
+#include "IR/ir_pass.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "IR/ir.h"
+#include "IR/ir_fold.h"
+#include "IR/ir_merge.h"
+#include "IR/ir_pool.h"
+#include "IR/ir_type.h"
+#include "IR/ir_value.h"
+#include "UTIL/datatypes.h"
+#include "UTIL/ground.h"
+#include "UTIL/list.h"
+#include "UTIL/trait.h"
+#include "UTIL/util.h"
+
+#define IR_PASS_REMOVED ((length_t) -1)
+
+typedef listof(ir_value_result_t*, results) ir_pass_results_t;
+
+// ---------------- ir_pass_state_t ----------------
+// Per-function scratch state shared by the instruction-level passes
+typedef struct {
+    ir_func_t *func;
+    ir_pool_t *pool;
+    bool keep_checked;
+    ir_value_t ***replacements; // [block][instruction] -> value to use instead (nullable rows)
+    bool **removed;             // [block][instruction] -> whether instruction will be removed
+    bool any_removed;
+} ir_pass_state_t;
+
+void ir_pass_visit_value(ir_value_t **slot, ir_pass_value_visitor_t visitor, void *user_data){
+    if(*slot == NULL) return;
+
+    visitor(slot, user_data);
+
+    ir_value_t *value = *slot;
+    ir_value_t **values;
+    length_t length;
+
+    switch(value->value_type){
+    case VALUE_TYPE_ARRAY_LITERAL:
+        values = ((ir_value_array_literal_t*) value->extra)->values;
+        length = ((ir_value_array_literal_t*) value->extra)->length;
+        break;
+    case VALUE_TYPE_STRUCT_LITERAL:
+        values = ((ir_value_struct_literal_t*) value->extra)->values;
+        length = ((ir_value_struct_literal_t*) value->extra)->length;
+        break;
+    case VALUE_TYPE_CONST_STRUCT_LITERAL:
+        values = ((ir_value_const_struct_literal_t*) value->extra)->values;
+        length = ((ir_value_const_struct_literal_t*) value->extra)->length;
+        break;
+    case VALUE_TYPE_CONST_ADD:
+        ir_pass_visit_value(&((ir_value_const_math_t*) value->extra)->a, visitor, user_data);
+        ir_pass_visit_value(&((ir_value_const_math_t*) value->extra)->b, visitor, user_data);
+        return;
+    default:
+        if(VALUE_TYPE_IS_CONSTANT_CAST(value->value_type)){
+            ir_pass_visit_value((ir_value_t**) &value->extra, visitor, user_data);
+        }
+        return;
+    }
+
+    for(length_t i = 0; i != length; i++){
+        ir_pass_visit_value(&values[i], visitor, user_data);
+    }
+}
+
+bool ir_pass_visit_operands(ir_instr_t *instr, ir_pass_value_visitor_t visitor, void *user_data){
+    switch(instr->id){
+    case INSTRUCTION_ADD: case INSTRUCTION_FADD: case INSTRUCTION_SUBTRACT: case INSTRUCTION_FSUBTRACT:
+    case INSTRUCTION_MULTIPLY: case INSTRUCTION_FMULTIPLY: case INSTRUCTION_UDIVIDE: case INSTRUCTION_SDIVIDE:
+    case INSTRUCTION_FDIVIDE: case INSTRUCTION_UMODULUS: case INSTRUCTION_SMODULUS: case INSTRUCTION_FMODULUS:
+    case INSTRUCTION_EQUALS: case INSTRUCTION_FEQUALS: case INSTRUCTION_NOTEQUALS: case INSTRUCTION_FNOTEQUALS:
+    case INSTRUCTION_UGREATER: case INSTRUCTION_SGREATER: case INSTRUCTION_FGREATER:
+    case INSTRUCTION_ULESSER: case INSTRUCTION_SLESSER: case INSTRUCTION_FLESSER:
+    case INSTRUCTION_UGREATEREQ: case INSTRUCTION_SGREATEREQ: case INSTRUCTION_FGREATEREQ:
+    case INSTRUCTION_ULESSEREQ: case INSTRUCTION_SLESSEREQ: case INSTRUCTION_FLESSEREQ:
+    case INSTRUCTION_AND: case INSTRUCTION_OR: case INSTRUCTION_BIT_AND: case INSTRUCTION_BIT_OR: case INSTRUCTION_BIT_XOR:
+    case INSTRUCTION_BIT_LSHIFT: case INSTRUCTION_BIT_RSHIFT: case INSTRUCTION_BIT_LGC_RSHIFT:
+        ir_pass_visit_value(&((ir_instr_math_t*) instr)->a, visitor, user_data);
+        ir_pass_visit_value(&((ir_instr_math_t*) instr)->b, visitor, user_data);
+        return true;
+    case INSTRUCTION_BITCAST: case INSTRUCTION_ZEXT: case INSTRUCTION_SEXT: case INSTRUCTION_TRUNC:
+    case INSTRUCTION_FEXT: case INSTRUCTION_FTRUNC: case INSTRUCTION_INTTOPTR: case INSTRUCTION_PTRTOINT:
+    case INSTRUCTION_FPTOUI: case INSTRUCTION_FPTOSI: case INSTRUCTION_UITOFP: case INSTRUCTION_SITOFP:
+    case INSTRUCTION_REINTERPRET: case INSTRUCTION_VECTOR_SPLAT:
+        ir_pass_visit_value(&((ir_instr_cast_t*) instr)->value, visitor, user_data);
+        return true;
+    case INSTRUCTION_ISZERO: case INSTRUCTION_ISNTZERO: case INSTRUCTION_BIT_COMPLEMENT:
+    case INSTRUCTION_NEGATE: case INSTRUCTION_FNEGATE: case INSTRUCTION_STACK_RESTORE:
+    case INSTRUCTION_VA_START: case INSTRUCTION_VA_END:
+    case INSTRUCTION_COROUTINE_SUSPEND: case INSTRUCTION_COROUTINE_RESUME: case INSTRUCTION_COROUTINE_DESTROY:
+    case INSTRUCTION_COROUTINE_DONE: case INSTRUCTION_COROUTINE_VALUE:
+        ir_pass_visit_value(&((ir_instr_unary_t*) instr)->value, visitor, user_data);
+        return true;
+    case INSTRUCTION_RET:
+        ir_pass_visit_value(&((ir_instr_ret_t*) instr)->value, visitor, user_data);
+        return true;
+    case INSTRUCTION_CALL: {
+            ir_instr_call_t *call = (ir_instr_call_t*) instr;
+
+            for(length_t i = 0; i != call->values_length; i++){
+                ir_pass_visit_value(&call->values[i], visitor, user_data);
+            }
+        }
+        return true;
+    case INSTRUCTION_CALL_ADDRESS: {
+            ir_instr_call_address_t *call = (ir_instr_call_address_t*) instr;
+            ir_pass_visit_value(&call->function_address, visitor, user_data);
+
+            for(length_t i = 0; i != call->values_length; i++){
+                ir_pass_visit_value(&call->values[i], visitor, user_data);
+            }
+        }
+        return true;
+    case INSTRUCTION_ALLOC:
+        ir_pass_visit_value(&((ir_instr_alloc_t*) instr)->count, visitor, user_data);
+        return true;
+    case INSTRUCTION_MALLOC:
+        ir_pass_visit_value(&((ir_instr_malloc_t*) instr)->amount, visitor, user_data);
+        return true;
+    case INSTRUCTION_FREE:
+        ir_pass_visit_value(&((ir_instr_free_t*) instr)->value, visitor, user_data);
+        return true;
+    case INSTRUCTION_STORE:
+        ir_pass_visit_value(&((ir_instr_store_t*) instr)->value, visitor, user_data);
+        ir_pass_visit_value(&((ir_instr_store_t*) instr)->destination, visitor, user_data);
+        return true;
+    case INSTRUCTION_LOAD:
+        ir_pass_visit_value(&((ir_instr_load_t*) instr)->value, visitor, user_data);
+        return true;
+    case INSTRUCTION_CONDBREAK:
+        ir_pass_visit_value(&((ir_instr_cond_break_t*) instr)->value, visitor, user_data);
+        return true;
+    case INSTRUCTION_MEMBER:
+        ir_pass_visit_value(&((ir_instr_member_t*) instr)->value, visitor, user_data);
+        return true;
+    case INSTRUCTION_ARRAY_ACCESS:
+        ir_pass_visit_value(&((ir_instr_array_access_t*) instr)->value, visitor, user_data);
+        ir_pass_visit_value(&((ir_instr_array_access_t*) instr)->index, visitor, user_data);
+        return true;
+    case INSTRUCTION_ZEROINIT:
+        ir_pass_visit_value(&((ir_instr_zeroinit_t*) instr)->destination, visitor, user_data);
+        return true;
+    case INSTRUCTION_MEMCPY:
+        ir_pass_visit_value(&((ir_instr_memcpy_t*) instr)->destination, visitor, user_data);
+        ir_pass_visit_value(&((ir_instr_memcpy_t*) instr)->value, visitor, user_data);
+        ir_pass_visit_value(&((ir_instr_memcpy_t*) instr)->bytes, visitor, user_data);
+        return true;
+    case INSTRUCTION_SELECT:
+        ir_pass_visit_value(&((ir_instr_select_t*) instr)->condition, visitor, user_data);
+        ir_pass_visit_value(&((ir_instr_select_t*) instr)->if_true, visitor, user_data);
+        ir_pass_visit_value(&((ir_instr_select_t*) instr)->if_false, visitor, user_data);
+        return true;
+    case INSTRUCTION_PHI2:
+        ir_pass_visit_value(&((ir_instr_phi2_t*) instr)->a, visitor, user_data);
+        ir_pass_visit_value(&((ir_instr_phi2_t*) instr)->b, visitor, user_data);
+        return true;
+    case INSTRUCTION_VECTOR_SHUFFLE:
+        ir_pass_visit_value(&((ir_instr_shuffle_t*) instr)->a, visitor, user_data);
+        ir_pass_visit_value(&((ir_instr_shuffle_t*) instr)->b, visitor, user_data);
+        return true;
+    case INSTRUCTION_VECTOR_REDUCE:
+        ir_pass_visit_value(&((ir_instr_vector_reduce_t*) instr)->value, visitor, user_data);
+        return true;
+    case INSTRUCTION_INTRINSIC: {
+            ir_instr_intrinsic_t *intrinsic = (ir_instr_intrinsic_t*) instr;
+
+            for(length_t i = 0; i != intrinsic->values_length; i++){
+                ir_pass_visit_value(&intrinsic->values[i], visitor, user_data);
+            }
+        }
+        return true;
+    case INSTRUCTION_ATOMIC_LOAD: case INSTRUCTION_ATOMIC_STORE: case INSTRUCTION_ATOMIC_RMW: case INSTRUCTION_ATOMIC_CMPXCHG:
+        ir_pass_visit_value(&((ir_instr_atomic_t*) instr)->pointer, visitor, user_data);
+        ir_pass_visit_value(&((ir_instr_atomic_t*) instr)->value, visitor, user_data);
+        ir_pass_visit_value(&((ir_instr_atomic_t*) instr)->expected, visitor, user_data);
+        return true;
+    case INSTRUCTION_PARALLEL_FOR:
+        ir_pass_visit_value(&((ir_instr_parallel_for_t*) instr)->body, visitor, user_data);
+        ir_pass_visit_value(&((ir_instr_parallel_for_t*) instr)->env, visitor, user_data);
+        ir_pass_visit_value(&((ir_instr_parallel_for_t*) instr)->count, visitor, user_data);
+        return true;
+    case INSTRUCTION_SWITCH: {
+            ir_instr_switch_t *switch_instr = (ir_instr_switch_t*) instr;
+            ir_pass_visit_value(&switch_instr->condition, visitor, user_data);
+
+            for(length_t i = 0; i != switch_instr->cases_length; i++){
+                ir_pass_visit_value(&switch_instr->case_values[i], visitor, user_data);
+            }
+        }
+        return true;
+    case INSTRUCTION_VA_ARG:
+        ir_pass_visit_value(&((ir_instr_va_arg_t*) instr)->va_list, visitor, user_data);
+        return true;
+    case INSTRUCTION_VA_COPY:
+        ir_pass_visit_value(&((ir_instr_va_copy_t*) instr)->dest_value, visitor, user_data);
+        ir_pass_visit_value(&((ir_instr_va_copy_t*) instr)->src_value, visitor, user_data);
+        return true;
+    case INSTRUCTION_ASM: {
+            ir_instr_asm_t *asm_instr = (ir_instr_asm_t*) instr;
+
+            for(length_t i = 0; i != asm_instr->arity; i++){
+                ir_pass_visit_value(&asm_instr->args[i], visitor, user_data);
+            }
+        }
+        return true;
+    case INSTRUCTION_VARPTR: case INSTRUCTION_GLOBALVARPTR: case INSTRUCTION_STATICVARPTR:
+    case INSTRUCTION_BREAK: case INSTRUCTION_SIZEOF: case INSTRUCTION_OFFSETOF:
+    case INSTRUCTION_STACK_SAVE: case INSTRUCTION_DEINIT_SVARS: case INSTRUCTION_UNREACHABLE: case INSTRUCTION_FENCE:
+        return true;
+    }
+
+    return false;
+}
+
+static bool ir_pass_is_pure(unsigned int id){
+    // Returns whether an instruction only computes a result from its operands
+    // and so can be removed when its result goes unused
+
+    switch(id){
+    case INSTRUCTION_ADD: case INSTRUCTION_FADD: case INSTRUCTION_SUBTRACT: case INSTRUCTION_FSUBTRACT:
+    case INSTRUCTION_MULTIPLY: case INSTRUCTION_FMULTIPLY: case INSTRUCTION_UDIVIDE: case INSTRUCTION_SDIVIDE:
+    case INSTRUCTION_FDIVIDE: case INSTRUCTION_UMODULUS: case INSTRUCTION_SMODULUS: case INSTRUCTION_FMODULUS:
+    case INSTRUCTION_EQUALS: case INSTRUCTION_FEQUALS: case INSTRUCTION_NOTEQUALS: case INSTRUCTION_FNOTEQUALS:
+    case INSTRUCTION_UGREATER: case INSTRUCTION_SGREATER: case INSTRUCTION_FGREATER:
+    case INSTRUCTION_ULESSER: case INSTRUCTION_SLESSER: case INSTRUCTION_FLESSER:
+    case INSTRUCTION_UGREATEREQ: case INSTRUCTION_SGREATEREQ: case INSTRUCTION_FGREATEREQ:
+    case INSTRUCTION_ULESSEREQ: case INSTRUCTION_SLESSEREQ: case INSTRUCTION_FLESSEREQ:
+    case INSTRUCTION_AND: case INSTRUCTION_OR: case INSTRUCTION_BIT_AND: case INSTRUCTION_BIT_OR: case INSTRUCTION_BIT_XOR:
+    case INSTRUCTION_BIT_LSHIFT: case INSTRUCTION_BIT_RSHIFT: case INSTRUCTION_BIT_LGC_RSHIFT:
+    case INSTRUCTION_BITCAST: case INSTRUCTION_ZEXT: case INSTRUCTION_SEXT: case INSTRUCTION_TRUNC:
+    case INSTRUCTION_FEXT: case INSTRUCTION_FTRUNC: case INSTRUCTION_INTTOPTR: case INSTRUCTION_PTRTOINT:
+    case INSTRUCTION_FPTOUI: case INSTRUCTION_FPTOSI: case INSTRUCTION_UITOFP: case INSTRUCTION_SITOFP:
+    case INSTRUCTION_REINTERPRET:
+    case INSTRUCTION_ISZERO: case INSTRUCTION_ISNTZERO: case INSTRUCTION_BIT_COMPLEMENT:
+    case INSTRUCTION_NEGATE: case INSTRUCTION_FNEGATE:
+    case INSTRUCTION_VARPTR: case INSTRUCTION_GLOBALVARPTR: case INSTRUCTION_STATICVARPTR:
+    case INSTRUCTION_SIZEOF: case INSTRUCTION_OFFSETOF: case INSTRUCTION_SELECT: case INSTRUCTION_PHI2:
+    case INSTRUCTION_VECTOR_SPLAT: case INSTRUCTION_VECTOR_SHUFFLE: case INSTRUCTION_VECTOR_REDUCE:
+        return true;
+    }
+
+    return false;
+}
+
+static bool ir_pass_is_terminator(unsigned int id){
+    switch(id){
+    case INSTRUCTION_RET: case INSTRUCTION_BREAK: case INSTRUCTION_CONDBREAK:
+    case INSTRUCTION_SWITCH: case INSTRUCTION_UNREACHABLE:
+        return true;
+    }
+
+    return false;
+}
+
+static ir_instr_t *ir_pass_result_instr(ir_func_t *func, ir_value_t *value){
+    if(value == NULL || value->value_type != VALUE_TYPE_RESULT) return NULL;
+
+    ir_value_result_t *result = &value->result;
+    return func->basicblocks.blocks[result->block_id].instructions.instructions[result->instruction_id];
+}
+
+static bool ir_pass_is_variable_pointer(ir_func_t *func, ir_value_t *value, length_t *out_index){
+    // Returns whether a value is the address of a local variable
+
+    ir_instr_t *instr = ir_pass_result_instr(func, value);
+    if(instr == NULL || instr->id != INSTRUCTION_VARPTR) return false;
+
+    if(out_index) *out_index = ((ir_instr_varptr_t*) instr)->index;
+    return true;
+}
+
+static bool ir_pass_is_address_of_storage(ir_func_t *func, ir_value_t *value){
+    // Returns whether a value is the address of a variable, which is never null
+
+    ir_instr_t *instr = ir_pass_result_instr(func, value);
+    if(instr == NULL) return false;
+
+    return instr->id == INSTRUCTION_VARPTR || instr->id == INSTRUCTION_GLOBALVARPTR || instr->id == INSTRUCTION_STATICVARPTR;
+}
+
+static bool ir_pass_has_valid_terminators(ir_basicblocks_t *basicblocks){
+    // Returns whether every basicblock ends in exactly one terminator
+
+    for(length_t b = 0; b != basicblocks->length; b++){
+        ir_instrs_t *instructions = &basicblocks->blocks[b].instructions;
+        if(instructions->length == 0) return false;
+
+        for(length_t i = 0; i != instructions->length; i++){
+            if(ir_pass_is_terminator(instructions->instructions[i]->id) != (i + 1 == instructions->length)) return false;
+        }
+    }
+
+    return true;
+}
+
+static ir_instr_t *ir_pass_terminator(ir_basicblock_t *basicblock){
+    return basicblock->instructions.instructions[basicblock->instructions.length - 1];
+}
+
+static void ir_pass_collect_result(ir_value_t **slot, void *user_data){
+    if((*slot)->value_type == VALUE_TYPE_RESULT){
+        list_append((ir_pass_results_t*) user_data, &(*slot)->result, ir_value_result_t*);
+    }
+}
+
+static void ir_pass_visit_nothing(ir_value_t **slot, void *user_data){
+    (void) slot;
+    (void) user_data;
+}
+
+static int ir_pass_result_cmp(const void *a, const void *b){
+    ir_value_result_t *result_a = *(ir_value_result_t**) a;
+    ir_value_result_t *result_b = *(ir_value_result_t**) b;
+    return result_a < result_b ? -1 : result_a > result_b;
+}
+
+static ir_pass_results_t ir_pass_unique_results(ir_func_t *func, bool **maybe_removed){
+    // Collects each result reference of the remaining instructions exactly once,
+    // since result values may be shared between operands
+
+    ir_pass_results_t results = (ir_pass_results_t){0};
+    ir_basicblocks_t *basicblocks = &func->basicblocks;
+
+    for(length_t b = 0; b != basicblocks->length; b++){
+        ir_instrs_t *instructions = &basicblocks->blocks[b].instructions;
+
+        for(length_t i = 0; i != instructions->length; i++){
+            if(maybe_removed && maybe_removed[b][i]) continue;
+            ir_pass_visit_operands(instructions->instructions[i], ir_pass_collect_result, &results);
+        }
+    }
+
+    list_qsort(&results, sizeof(ir_value_result_t*), ir_pass_result_cmp);
+
+    length_t unique = 0;
+    for(length_t i = 0; i != results.length; i++){
+        if(unique == 0 || results.results[unique - 1] != results.results[i]){
+            results.results[unique++] = results.results[i];
+        }
+    }
+
+    results.length = unique;
+    return results;
+}
+
+static void ir_pass_apply_replacement(ir_value_t **slot, void *user_data){
+    ir_pass_state_t *state = (ir_pass_state_t*) user_data;
+
+    while((*slot)->value_type == VALUE_TYPE_RESULT){
+        ir_value_result_t *result = &(*slot)->result;
+        ir_value_t **row = state->replacements[result->block_id];
+        if(row == NULL || row[result->instruction_id] == NULL) return;
+
+        *slot = row[result->instruction_id];
+    }
+}
+
+static ir_value_t *ir_pass_resolve(ir_pass_state_t *state, ir_value_t *value){
+    ir_pass_apply_replacement(&value, state);
+    return value;
+}
+
+static ir_value_t *ir_pass_build_result(ir_pool_t *pool, length_t block_id, length_t instruction_id, ir_type_t *type){
+    ir_value_t *value = ir_pool_alloc(pool, sizeof(ir_value_t));
+    value->value_type = VALUE_TYPE_RESULT;
+    value->type = type;
+    value->result.block_id = block_id;
+    value->result.instruction_id = instruction_id;
+    return value;
+}
+
+static ir_type_t *ir_pass_written_type(ir_instr_t *instr){
+    // Returns the type of the value written by a store or zero-initialization
+    // NOTE: Returns NULL if unknown
+
+    switch(instr->id){
+    case INSTRUCTION_STORE:
+        return ((ir_instr_store_t*) instr)->value->type;
+    case INSTRUCTION_ZEROINIT:
+        return ir_type_dereference(((ir_instr_zeroinit_t*) instr)->destination->type);
+    }
+
+    return NULL;
+}
+
+static void ir_pass_forward_loads(ir_pass_state_t *state){
+    // Within each basicblock, reuses the last value stored to or loaded from
+    // a local variable instead of loading it again, and removes stores
+    // that are overwritten before the variable could have been read
+
+    ir_func_t *func = state->func;
+    length_t variable_count = func->variable_count;
+    if(variable_count == 0) return;
+
+    // Known contents of each variable, only valid when '*_generation' matches the current one
+    ir_value_t **known_values = malloc(sizeof(ir_value_t*) * variable_count);
+    length_t *known_loads = malloc(sizeof(length_t) * variable_count);
+    length_t *known_generation = calloc(variable_count, sizeof(length_t));
+    length_t *pending_stores = malloc(sizeof(length_t) * variable_count);
+    length_t *pending_generation = calloc(variable_count, sizeof(length_t));
+    length_t generation = 0;
+    length_t store_generation = 0;
+
+    for(length_t b = 0; b != func->basicblocks.length; b++){
+        ir_instrs_t *instructions = &func->basicblocks.blocks[b].instructions;
+        generation++;
+        store_generation++;
+
+        for(length_t i = 0; i != instructions->length; i++){
+            ir_instr_t *instr = instructions->instructions[i];
+            length_t index;
+
+            switch(instr->id){
+            case INSTRUCTION_STORE: {
+                    ir_instr_store_t *store = (ir_instr_store_t*) instr;
+
+                    if(!ir_pass_is_variable_pointer(func, store->destination, &index)){
+                        // Storing through an unknown pointer may change any variable whose address was taken
+                        generation++;
+                        break;
+                    }
+
+                    ir_value_t *value = ir_pass_resolve(state, store->value);
+
+                    if(pending_generation[index] == store_generation){
+                        ir_type_t *overwritten = ir_pass_written_type(instructions->instructions[pending_stores[index]]);
+
+                        if(overwritten && ir_types_identical(overwritten, value->type)){
+                            state->removed[b][pending_stores[index]] = true;
+                            state->any_removed = true;
+                        }
+                    }
+
+                    known_values[index] = value;
+                    known_generation[index] = generation;
+                    pending_stores[index] = i;
+                    pending_generation[index] = store_generation;
+                }
+                break;
+            case INSTRUCTION_LOAD: {
+                    ir_instr_load_t *load = (ir_instr_load_t*) instr;
+
+                    if(!ir_pass_is_variable_pointer(func, load->value, &index)){
+                        // Loading through an unknown pointer may read any variable whose address was taken
+                        store_generation++;
+                        break;
+                    }
+
+                    pending_generation[index] = 0;
+
+                    if(known_generation[index] != generation){
+                        known_values[index] = NULL;
+                        known_loads[index] = i;
+                        known_generation[index] = generation;
+                        break;
+                    }
+
+                    if(known_values[index] == NULL){
+                        ir_instr_t *previous = instructions->instructions[known_loads[index]];
+                        known_values[index] = ir_pass_build_result(state->pool, b, known_loads[index], previous->result_type);
+                    }
+
+                    if(!ir_types_identical(known_values[index]->type, load->result_type)) break;
+
+                    if(state->replacements[b] == NULL){
+                        state->replacements[b] = calloc(instructions->length, sizeof(ir_value_t*));
+                    }
+
+                    state->replacements[b][i] = known_values[index];
+                }
+                break;
+            case INSTRUCTION_ZEROINIT:
+            case INSTRUCTION_MEMCPY: {
+                    ir_value_t *destination = instr->id == INSTRUCTION_ZEROINIT
+                        ? ((ir_instr_zeroinit_t*) instr)->destination
+                        : ((ir_instr_memcpy_t*) instr)->destination;
+
+                    if(instr->id == INSTRUCTION_MEMCPY) store_generation++;
+
+                    if(ir_pass_is_variable_pointer(func, destination, &index)){
+                        known_generation[index] = 0;
+
+                        // Zero-initialization is overwritten by a later store just like a store would be
+                        pending_stores[index] = i;
+                        pending_generation[index] = instr->id == INSTRUCTION_ZEROINIT ? store_generation : 0;
+                    } else {
+                        generation++;
+                    }
+                }
+                break;
+            default:
+                if(ir_pass_is_pure(instr->id) || ir_pass_is_terminator(instr->id)) break;
+                if(instr->id == INSTRUCTION_MEMBER || instr->id == INSTRUCTION_ARRAY_ACCESS) break;
+                if(instr->id == INSTRUCTION_ALLOC || instr->id == INSTRUCTION_SIZEOF) break;
+
+                // Anything else may read or write arbitrary memory
+                generation++;
+                store_generation++;
+            }
+        }
+    }
+
+    free(known_values);
+    free(known_loads);
+    free(known_generation);
+    free(pending_stores);
+    free(pending_generation);
+
+    // Redirect uses of forwarded loads
+    for(length_t b = 0; b != func->basicblocks.length; b++){
+        ir_instrs_t *instructions = &func->basicblocks.blocks[b].instructions;
+
+        for(length_t i = 0; i != instructions->length; i++){
+            ir_pass_visit_operands(instructions->instructions[i], ir_pass_apply_replacement, state);
+        }
+    }
+}
+
+static bool ir_pass_names_phi_incoming(ir_basicblock_t *basicblock, length_t incoming_block_id){
+    // Returns whether a basicblock has a phi instruction that expects
+    // to be entered from the given basicblock
+
+    for(length_t i = 0; i != basicblock->instructions.length; i++){
+        ir_instr_t *instr = basicblock->instructions.instructions[i];
+        if(instr->id != INSTRUCTION_PHI2) continue;
+
+        ir_instr_phi2_t *phi = (ir_instr_phi2_t*) instr;
+        if(phi->block_id_a == incoming_block_id || phi->block_id_b == incoming_block_id) return true;
+    }
+
+    return false;
+}
+
+static void ir_pass_fold_branch(ir_pass_state_t *state, length_t block_id, length_t instruction_id){
+    // Turns a conditional branch on a constant condition into an unconditional branch
+
+    ir_instrs_t *instructions = &state->func->basicblocks.blocks[block_id].instructions;
+    ir_instr_cond_break_t *cond_break = (ir_instr_cond_break_t*) instructions->instructions[instruction_id];
+
+    ir_value_t *condition = ir_fold_scalar_literal(state->pool, cond_break->value);
+    if(condition == NULL || condition->type->kind != TYPE_KIND_BOOLEAN) return;
+
+    bool is_true = *((adept_bool*) condition->extra);
+    length_t taken = is_true ? cond_break->true_block_id : cond_break->false_block_id;
+    length_t dropped = is_true ? cond_break->false_block_id : cond_break->true_block_id;
+
+    // Phi instructions of the basicblock no longer branched to would be left with a missing predecessor
+    if(dropped != taken && ir_pass_names_phi_incoming(&state->func->basicblocks.blocks[dropped], block_id)) return;
+
+    // Rewrite the branch in place, so it stays within the instructions of the function
+    // NOTE: Unconditional breaks are always smaller than conditional ones
+    *((ir_instr_break_t*) cond_break) = (ir_instr_break_t){
+        .id = INSTRUCTION_BREAK,
+        .result_type = NULL,
+        .block_id = taken,
+    };
+}
+
+static void ir_pass_fold_constants(ir_pass_state_t *state){
+    // Computes instructions whose operands are known at compile-time
+    // (including values made known by forwarding) and replaces them with their results
+
+    ir_func_t *func = state->func;
+    ir_basicblocks_t *basicblocks = &func->basicblocks;
+    bool any_folded = false;
+
+    for(length_t b = 0; b != basicblocks->length; b++){
+        ir_instrs_t *instructions = &basicblocks->blocks[b].instructions;
+
+        for(length_t i = 0; i != instructions->length; i++){
+            if(state->removed[b][i]) continue;
+
+            // Use already folded results, since basicblocks are visited in order
+            ir_instr_t *instr = instructions->instructions[i];
+            ir_pass_visit_operands(instr, ir_pass_apply_replacement, state);
+
+            if(instr->id == INSTRUCTION_CONDBREAK){
+                ir_pass_fold_branch(state, b, i);
+                continue;
+            }
+
+            ir_value_t *folded = ir_fold_instr(state->pool, instr);
+            if(folded == NULL) continue;
+
+            if(state->replacements[b] == NULL){
+                state->replacements[b] = calloc(instructions->length, sizeof(ir_value_t*));
+            }
+
+            state->replacements[b][i] = folded;
+            state->removed[b][i] = true;
+            state->any_removed = true;
+            any_folded = true;
+        }
+    }
+
+    if(!any_folded) return;
+
+    // Redirect uses that come before their folded instruction (e.g. phi instructions of loops)
+    for(length_t b = 0; b != basicblocks->length; b++){
+        ir_instrs_t *instructions = &basicblocks->blocks[b].instructions;
+
+        for(length_t i = 0; i != instructions->length; i++){
+            ir_pass_visit_operands(instructions->instructions[i], ir_pass_apply_replacement, state);
+        }
+    }
+}
+
+static bool ir_pass_is_removable(ir_pass_state_t *state, ir_instr_t *instr){
+    if(ir_pass_is_pure(instr->id)) return true;
+
+    switch(instr->id){
+    case INSTRUCTION_LOAD:
+        return !state->keep_checked || ir_pass_is_address_of_storage(state->func, ((ir_instr_load_t*) instr)->value);
+    case INSTRUCTION_MEMBER:
+        return !state->keep_checked || ir_pass_is_address_of_storage(state->func, ((ir_instr_member_t*) instr)->value);
+    case INSTRUCTION_ARRAY_ACCESS:
+        return !state->keep_checked || ir_pass_is_address_of_storage(state->func, ((ir_instr_array_access_t*) instr)->value);
+    case INSTRUCTION_ZEROINIT: {
+            // Zero-initializing a value without any storage does nothing
+            ir_type_t *type = ir_type_dereference(((ir_instr_zeroinit_t*) instr)->destination->type);
+            if(type == NULL) return false;
+
+            switch(type->kind){
+            case TYPE_KIND_STRUCTURE:
+                return ((ir_type_extra_composite_t*) type->extra)->subtypes_length == 0;
+            case TYPE_KIND_FIXED_ARRAY:
+                return ((ir_type_extra_fixed_array_t*) type->extra)->length == 0;
+            }
+        }
+        return false;
+    }
+
+    return false;
+}
+
+typedef struct {
+    ir_pass_state_t *state;
+    length_t **uses;
+    int delta;
+    ir_value_result_t **worklist;
+    length_t worklist_length;
+    length_t worklist_capacity;
+} ir_pass_dce_t;
+
+static void ir_pass_count_use(ir_value_t **slot, void *user_data){
+    if((*slot)->value_type != VALUE_TYPE_RESULT) return;
+
+    ir_pass_dce_t *dce = (ir_pass_dce_t*) user_data;
+    ir_value_result_t *result = &(*slot)->result;
+    length_t *uses = &dce->uses[result->block_id][result->instruction_id];
+
+    *uses += dce->delta;
+
+    if(*uses == 0){
+        expand((void**) &dce->worklist, sizeof(ir_value_result_t*), dce->worklist_length, &dce->worklist_capacity, 1, 16);
+        dce->worklist[dce->worklist_length++] = result;
+    }
+}
+
+static void ir_pass_remove_dead_instructions(ir_pass_state_t *state){
+    // Removes instructions without side effects whose results are never used
+
+    ir_func_t *func = state->func;
+    ir_basicblocks_t *basicblocks = &func->basicblocks;
+
+    ir_pass_dce_t dce = (ir_pass_dce_t){
+        .state = state,
+        .uses = malloc(sizeof(length_t*) * basicblocks->length),
+        .delta = 1,
+    };
+
+    for(length_t b = 0; b != basicblocks->length; b++){
+        dce.uses[b] = calloc(basicblocks->blocks[b].instructions.length, sizeof(length_t));
+    }
+
+    for(length_t b = 0; b != basicblocks->length; b++){
+        ir_instrs_t *instructions = &basicblocks->blocks[b].instructions;
+
+        for(length_t i = 0; i != instructions->length; i++){
+            if(!state->removed[b][i]) ir_pass_visit_operands(instructions->instructions[i], ir_pass_count_use, &dce);
+        }
+    }
+
+    // Uses only ever increased so far, so nothing was queued
+    dce.delta = -1;
+
+    for(length_t b = 0; b != basicblocks->length; b++){
+        ir_instrs_t *instructions = &basicblocks->blocks[b].instructions;
+
+        for(length_t i = 0; i != instructions->length; i++){
+            ir_instr_t *instr = instructions->instructions[i];
+            if(state->removed[b][i] || dce.uses[b][i] != 0 || !ir_pass_is_removable(state, instr)) continue;
+
+            state->removed[b][i] = true;
+            state->any_removed = true;
+            ir_pass_visit_operands(instr, ir_pass_count_use, &dce);
+
+            while(dce.worklist_length != 0){
+                ir_value_result_t *result = dce.worklist[--dce.worklist_length];
+                length_t block_id = result->block_id;
+                length_t instruction_id = result->instruction_id;
+
+                ir_instr_t *operand = basicblocks->blocks[block_id].instructions.instructions[instruction_id];
+                if(state->removed[block_id][instruction_id] || !ir_pass_is_removable(state, operand)) continue;
+
+                state->removed[block_id][instruction_id] = true;
+                ir_pass_visit_operands(operand, ir_pass_count_use, &dce);
+            }
+        }
+    }
+
+    for(length_t b = 0; b != basicblocks->length; b++){
+        free(dce.uses[b]);
+    }
+
+    free(dce.uses);
+    free(dce.worklist);
+}
+
+static void ir_pass_compact_instructions(ir_pass_state_t *state){
+    // Drops instructions marked as removed and renumbers the remaining ones
+
+    ir_func_t *func = state->func;
+    ir_basicblocks_t *basicblocks = &func->basicblocks;
+    ir_pass_results_t results = ir_pass_unique_results(func, state->removed);
+
+    length_t **new_ids = malloc(sizeof(length_t*) * basicblocks->length);
+
+    for(length_t b = 0; b != basicblocks->length; b++){
+        ir_instrs_t *instructions = &basicblocks->blocks[b].instructions;
+        new_ids[b] = malloc(sizeof(length_t) * instructions->length);
+
+        length_t kept = 0;
+        for(length_t i = 0; i != instructions->length; i++){
+            new_ids[b][i] = state->removed[b][i] ? IR_PASS_REMOVED : kept++;
+        }
+    }
+
+    for(length_t r = 0; r != results.length; r++){
+        ir_value_result_t *result = results.results[r];
+        result->instruction_id = new_ids[result->block_id][result->instruction_id];
+    }
+
+    for(length_t b = 0; b != basicblocks->length; b++){
+        ir_instrs_t *instructions = &basicblocks->blocks[b].instructions;
+
+        length_t kept = 0;
+        for(length_t i = 0; i != instructions->length; i++){
+            if(!state->removed[b][i]) instructions->instructions[kept++] = instructions->instructions[i];
+        }
+
+        instructions->length = kept;
+        free(new_ids[b]);
+    }
+
+    free(new_ids);
+    free(results.results);
+}
+
+static void ir_pass_run_on_instructions(ir_func_t *func, ir_pool_t *pool, trait_t passes, bool keep_checked){
+    ir_basicblocks_t *basicblocks = &func->basicblocks;
+
+    ir_pass_state_t state = (ir_pass_state_t){
+        .func = func,
+        .pool = pool,
+        .keep_checked = keep_checked,
+        .replacements = calloc(basicblocks->length, sizeof(ir_value_t**)),
+        .removed = malloc(sizeof(bool*) * basicblocks->length),
+        .any_removed = false,
+    };
+
+    for(length_t b = 0; b != basicblocks->length; b++){
+        state.removed[b] = calloc(basicblocks->blocks[b].instructions.length, sizeof(bool));
+    }
+
+    if(passes & IR_PASS_FORWARD_LOADS) ir_pass_forward_loads(&state);
+    if(passes & IR_PASS_FOLD_CONSTANTS) ir_pass_fold_constants(&state);
+    if(passes & IR_PASS_DEAD_INSTRUCTIONS) ir_pass_remove_dead_instructions(&state);
+    if(state.any_removed) ir_pass_compact_instructions(&state);
+
+    for(length_t b = 0; b != basicblocks->length; b++){
+        free(state.replacements[b]);
+        free(state.removed[b]);
+    }
+
+    free(state.replacements);
+    free(state.removed);
+}
+
+static bool *ir_pass_blocks_with_phis(ir_basicblocks_t *basicblocks, bool *out_phi_incoming){
+    // Returns which basicblocks contain phi instructions,
+    // and marks which basicblocks are named as incoming blocks of phi instructions
+
+    bool *has_phi = calloc(basicblocks->length, sizeof(bool));
+
+    for(length_t b = 0; b != basicblocks->length; b++){
+        ir_instrs_t *instructions = &basicblocks->blocks[b].instructions;
+
+        for(length_t i = 0; i != instructions->length; i++){
+            if(instructions->instructions[i]->id != INSTRUCTION_PHI2) continue;
+
+            ir_instr_phi2_t *phi = (ir_instr_phi2_t*) instructions->instructions[i];
+            has_phi[b] = true;
+            out_phi_incoming[phi->block_id_a] = true;
+            out_phi_incoming[phi->block_id_b] = true;
+        }
+    }
+
+    return has_phi;
+}
+
+static length_t ir_pass_successors(ir_instr_t *terminator, length_t pair[2], length_t **out_block_ids){
+    // Gets the basicblock ids that a terminator can transfer control to,
+    // 'pair' is used as storage for branches and the case list is borrowed for switches
+    // NOTE: The default/resume basicblocks of switches are not included
+
+    switch(terminator->id){
+    case INSTRUCTION_BREAK:
+        pair[0] = ((ir_instr_break_t*) terminator)->block_id;
+        *out_block_ids = pair;
+        return 1;
+    case INSTRUCTION_CONDBREAK:
+        pair[0] = ((ir_instr_cond_break_t*) terminator)->true_block_id;
+        pair[1] = ((ir_instr_cond_break_t*) terminator)->false_block_id;
+        *out_block_ids = pair;
+        return 2;
+    case INSTRUCTION_SWITCH:
+        *out_block_ids = ((ir_instr_switch_t*) terminator)->case_block_ids;
+        return ((ir_instr_switch_t*) terminator)->cases_length;
+    }
+
+    *out_block_ids = NULL;
+    return 0;
+}
+
+static void ir_pass_thread_jumps(ir_func_t *func){
+    // Redirects branches that target basicblocks which do nothing but
+    // branch elsewhere, so that those basicblocks become unreachable
+
+    ir_basicblocks_t *basicblocks = &func->basicblocks;
+    bool *phi_incoming = calloc(basicblocks->length, sizeof(bool));
+    bool *has_phi = ir_pass_blocks_with_phis(basicblocks, phi_incoming);
+
+    length_t *final_targets = malloc(sizeof(length_t) * basicblocks->length);
+
+    for(length_t b = 0; b != basicblocks->length; b++){
+        length_t target = b;
+
+        // Follow chains of trivial basicblocks, guarding against cycles
+        for(length_t steps = 0; steps != basicblocks->length && target != 0; steps++){
+            ir_instrs_t *instructions = &basicblocks->blocks[target].instructions;
+            if(instructions->length != 1 || instructions->instructions[0]->id != INSTRUCTION_BREAK) break;
+
+            length_t next = ((ir_instr_break_t*) instructions->instructions[0])->block_id;
+            if(next == target || has_phi[next] || phi_incoming[target]) break;
+            target = next;
+        }
+
+        final_targets[b] = target;
+    }
+
+    for(length_t b = 0; b != basicblocks->length; b++){
+        ir_instr_t *terminator = ir_pass_terminator(&basicblocks->blocks[b]);
+
+        switch(terminator->id){
+        case INSTRUCTION_BREAK: {
+                ir_instr_break_t *instr = (ir_instr_break_t*) terminator;
+                instr->block_id = final_targets[instr->block_id];
+            }
+            break;
+        case INSTRUCTION_CONDBREAK: {
+                ir_instr_cond_break_t *instr = (ir_instr_cond_break_t*) terminator;
+                instr->true_block_id = final_targets[instr->true_block_id];
+                instr->false_block_id = final_targets[instr->false_block_id];
+            }
+            break;
+        }
+    }
+
+    free(final_targets);
+    free(has_phi);
+    free(phi_incoming);
+}
+
+typedef struct {
+    length_t *merged_into;   // Basicblock that now holds the instructions of a basicblock
+    length_t *merged_offset; // Offset of those instructions within that basicblock
+    length_t *new_ids;       // New id of each remaining basicblock
+} ir_pass_block_map_t;
+
+static length_t ir_pass_map_block(ir_pass_block_map_t *map, length_t block_id){
+    while(map->merged_into[block_id] != block_id){
+        block_id = map->merged_into[block_id];
+    }
+    return map->new_ids[block_id];
+}
+
+static void ir_pass_renumber_blocks(ir_func_t *func, bool *keep, ir_pass_block_map_t *map){
+    // Removes basicblocks that aren't kept, and updates every reference
+    // to a basicblock or instruction result to match
+
+    ir_basicblocks_t *basicblocks = &func->basicblocks;
+    ir_pass_results_t results = ir_pass_unique_results(func, NULL);
+
+    length_t kept = 0;
+    for(length_t b = 0; b != basicblocks->length; b++){
+        map->new_ids[b] = keep[b] ? kept++ : IR_PASS_REMOVED;
+    }
+
+    for(length_t r = 0; r != results.length; r++){
+        ir_value_result_t *result = results.results[r];
+        length_t block_id = result->block_id;
+
+        while(map->merged_into[block_id] != block_id){
+            result->instruction_id += map->merged_offset[block_id];
+            block_id = map->merged_into[block_id];
+        }
+
+        result->block_id = map->new_ids[block_id];
+    }
+
+    free(results.results);
+
+    for(length_t b = 0; b != basicblocks->length; b++){
+        if(!keep[b]) continue;
+
+        ir_instrs_t *instructions = &basicblocks->blocks[b].instructions;
+
+        for(length_t i = 0; i != instructions->length; i++){
+            ir_instr_t *instr = instructions->instructions[i];
+
+            switch(instr->id){
+            case INSTRUCTION_BREAK: {
+                    ir_instr_break_t *break_instr = (ir_instr_break_t*) instr;
+                    break_instr->block_id = ir_pass_map_block(map, break_instr->block_id);
+                }
+                break;
+            case INSTRUCTION_CONDBREAK: {
+                    ir_instr_cond_break_t *cond_break = (ir_instr_cond_break_t*) instr;
+                    cond_break->true_block_id = ir_pass_map_block(map, cond_break->true_block_id);
+                    cond_break->false_block_id = ir_pass_map_block(map, cond_break->false_block_id);
+                }
+                break;
+            case INSTRUCTION_SWITCH: {
+                    ir_instr_switch_t *switch_instr = (ir_instr_switch_t*) instr;
+
+                    for(length_t c = 0; c != switch_instr->cases_length; c++){
+                        switch_instr->case_block_ids[c] = ir_pass_map_block(map, switch_instr->case_block_ids[c]);
+                    }
+
+                    switch_instr->default_block_id = ir_pass_map_block(map, switch_instr->default_block_id);
+                    switch_instr->resume_block_id = ir_pass_map_block(map, switch_instr->resume_block_id);
+                }
+                break;
+            case INSTRUCTION_PHI2: {
+                    ir_instr_phi2_t *phi = (ir_instr_phi2_t*) instr;
+                    phi->block_id_a = ir_pass_map_block(map, phi->block_id_a);
+                    phi->block_id_b = ir_pass_map_block(map, phi->block_id_b);
+                }
+                break;
+            }
+        }
+    }
+
+    kept = 0;
+    for(length_t b = 0; b != basicblocks->length; b++){
+        if(keep[b]){
+            basicblocks->blocks[kept++] = basicblocks->blocks[b];
+        } else {
+            ir_basicblock_free(&basicblocks->blocks[b]);
+        }
+    }
+
+    basicblocks->length = kept;
+}
+
+typedef struct {
+    ir_func_t *func;
+    bool *keep;
+    bool references_removed;
+} ir_pass_reference_check_t;
+
+static void ir_pass_check_reference(ir_value_t **slot, void *user_data){
+    ir_pass_reference_check_t *check = (ir_pass_reference_check_t*) user_data;
+
+    if((*slot)->value_type == VALUE_TYPE_RESULT && !check->keep[(*slot)->result.block_id]){
+        check->references_removed = true;
+    }
+}
+
+static void ir_pass_remove_unreachable_blocks(ir_func_t *func){
+    // Removes basicblocks that can't be reached from the entry basicblock
+
+    ir_basicblocks_t *basicblocks = &func->basicblocks;
+    length_t length = basicblocks->length;
+
+    bool *keep = calloc(length, sizeof(bool));
+    length_t *stack = malloc(sizeof(length_t) * length);
+    length_t stack_length = 0;
+
+    // Start from the entry basicblock and any basicblock a phi instruction
+    // still names, then keep everything those can reach
+    bool *phi_incoming = calloc(length, sizeof(bool));
+    free(ir_pass_blocks_with_phis(basicblocks, phi_incoming));
+    phi_incoming[0] = true;
+
+    for(length_t b = 0; b != length; b++){
+        if(phi_incoming[b]){
+            keep[b] = true;
+            stack[stack_length++] = b;
+        }
+    }
+
+    free(phi_incoming);
+
+    while(stack_length != 0){
+        ir_instr_t *terminator = ir_pass_terminator(&basicblocks->blocks[stack[--stack_length]]);
+
+        length_t pair[2];
+        length_t *successors;
+        length_t successors_length = ir_pass_successors(terminator, pair, &successors);
+        length_t extra[2];
+        length_t extra_length = 0;
+
+        if(terminator->id == INSTRUCTION_SWITCH){
+            extra[extra_length++] = ((ir_instr_switch_t*) terminator)->default_block_id;
+            extra[extra_length++] = ((ir_instr_switch_t*) terminator)->resume_block_id;
+        }
+
+        for(length_t s = 0; s != successors_length + extra_length; s++){
+            length_t successor = s < successors_length ? successors[s] : extra[s - successors_length];
+
+            if(!keep[successor]){
+                keep[successor] = true;
+                stack[stack_length++] = successor;
+            }
+        }
+    }
+
+    free(stack);
+
+    length_t kept = 0;
+    for(length_t b = 0; b != length; b++){
+        if(keep[b]) kept++;
+    }
+
+    if(kept == length){
+        free(keep);
+        return;
+    }
+
+    // Don't touch functions where remaining code still uses values from removed code
+    ir_pass_reference_check_t check = (ir_pass_reference_check_t){
+        .func = func,
+        .keep = keep,
+        .references_removed = false,
+    };
+
+    for(length_t b = 0; b != length && !check.references_removed; b++){
+        if(!keep[b]) continue;
+
+        ir_instrs_t *instructions = &basicblocks->blocks[b].instructions;
+
+        for(length_t i = 0; i != instructions->length; i++){
+            ir_pass_visit_operands(instructions->instructions[i], ir_pass_check_reference, &check);
+        }
+    }
+
+    if(!check.references_removed){
+        ir_pass_block_map_t map = (ir_pass_block_map_t){
+            .merged_into = malloc(sizeof(length_t) * length),
+            .merged_offset = calloc(length, sizeof(length_t)),
+            .new_ids = malloc(sizeof(length_t) * length),
+        };
+
+        for(length_t b = 0; b != length; b++){
+            map.merged_into[b] = b;
+        }
+
+        ir_pass_renumber_blocks(func, keep, &map);
+
+        free(map.merged_into);
+        free(map.merged_offset);
+        free(map.new_ids);
+    }
+
+    free(keep);
+}
+
+static void ir_pass_merge_blocks(ir_func_t *func){
+    // Appends basicblocks onto their only predecessor
+    // when that predecessor unconditionally branches to them
+
+    ir_basicblocks_t *basicblocks = &func->basicblocks;
+    length_t length = basicblocks->length;
+
+    length_t *predecessors = calloc(length, sizeof(length_t));
+    bool *is_resume = calloc(length, sizeof(bool));
+    bool *phi_incoming = calloc(length, sizeof(bool));
+    bool *has_phi = ir_pass_blocks_with_phis(basicblocks, phi_incoming);
+    free(phi_incoming);
+
+    for(length_t b = 0; b != length; b++){
+        ir_instr_t *terminator = ir_pass_terminator(&basicblocks->blocks[b]);
+
+        length_t pair[2];
+        length_t *successors;
+        length_t successors_length = ir_pass_successors(terminator, pair, &successors);
+
+        for(length_t s = 0; s != successors_length; s++){
+            predecessors[successors[s]]++;
+        }
+
+        if(terminator->id == INSTRUCTION_SWITCH){
+            ir_instr_switch_t *switch_instr = (ir_instr_switch_t*) terminator;
+            predecessors[switch_instr->default_block_id]++;
+            is_resume[switch_instr->resume_block_id] = true;
+        }
+    }
+
+    ir_pass_block_map_t map = (ir_pass_block_map_t){
+        .merged_into = malloc(sizeof(length_t) * length),
+        .merged_offset = calloc(length, sizeof(length_t)),
+        .new_ids = malloc(sizeof(length_t) * length),
+    };
+
+    bool *keep = malloc(sizeof(bool) * length);
+
+    for(length_t b = 0; b != length; b++){
+        map.merged_into[b] = b;
+        keep[b] = true;
+    }
+
+    bool any_merged = false;
+
+    for(length_t a = 0; a != length; a++){
+        if(!keep[a]) continue;
+
+        ir_instrs_t *instructions = &basicblocks->blocks[a].instructions;
+
+        while(true){
+            ir_instr_t *terminator = instructions->instructions[instructions->length - 1];
+            if(terminator->id != INSTRUCTION_BREAK) break;
+
+            length_t b = ((ir_instr_break_t*) terminator)->block_id;
+            if(b == 0 || b == a || !keep[b] || predecessors[b] != 1 || has_phi[b] || is_resume[b]) break;
+
+            ir_instrs_t *absorbed = &basicblocks->blocks[b].instructions;
+
+            map.merged_into[b] = a;
+            map.merged_offset[b] = instructions->length - 1;
+            keep[b] = false;
+            any_merged = true;
+
+            instructions->length--;
+            for(length_t i = 0; i != absorbed->length; i++){
+                ir_instrs_append(instructions, absorbed->instructions[i]);
+            }
+
+            absorbed->length = 0;
+        }
+    }
+
+    if(any_merged) ir_pass_renumber_blocks(func, keep, &map);
+
+    free(keep);
+    free(map.merged_into);
+    free(map.merged_offset);
+    free(map.new_ids);
+    free(predecessors);
+    free(is_resume);
+    free(has_phi);
+}
+
+static void ir_pass_run_on_func(ir_func_t *func, ir_pool_t *pool, trait_t passes, bool keep_checked){
+    ir_basicblocks_t *basicblocks = &func->basicblocks;
+
+    if(basicblocks->length == 0 || !ir_pass_has_valid_terminators(basicblocks)) return;
+
+    // Every instruction must be understood before anything is changed
+    for(length_t b = 0; b != basicblocks->length; b++){
+        ir_instrs_t *instructions = &basicblocks->blocks[b].instructions;
+
+        for(length_t i = 0; i != instructions->length; i++){
+            if(!ir_pass_visit_operands(instructions->instructions[i], ir_pass_visit_nothing, NULL)) return;
+        }
+    }
+
+    if(passes & (IR_PASS_FORWARD_LOADS | IR_PASS_FOLD_CONSTANTS | IR_PASS_DEAD_INSTRUCTIONS)){
+        ir_pass_run_on_instructions(func, pool, passes, keep_checked);
+    }
+
+    if(passes & IR_PASS_THREAD_JUMPS) ir_pass_thread_jumps(func);
+    if(passes & IR_PASS_UNREACHABLE_BLOCKS) ir_pass_remove_unreachable_blocks(func);
+    if(passes & IR_PASS_MERGE_BLOCKS) ir_pass_merge_blocks(func);
+}
+
+void ir_module_run_passes(ir_module_t *ir_module, trait_t passes, bool keep_checked){
+    if(passes == IR_PASS_NONE) return;
+
+    for(length_t f = 0; f != ir_module->funcs.length; f++){
+        ir_func_t *func = ir_funcs_at(&ir_module->funcs, f);
+        // Functions marked 'optimize none' are left exactly as they were generated
+        if(func->traits & (IR_FUNC_FOREIGN | IR_FUNC_UNREFERENCED | IR_FUNC_OPTIMIZE_NONE)) continue;
+
+        ir_pass_run_on_func(func, &ir_module->pool, passes, keep_checked);
+    }
+
+    // Runtime checks report the function they failed in, so functions can't be merged when they're enabled
+    if(passes & IR_PASS_MERGE_FUNCS && !keep_checked){
+        ir_module_merge_identical_funcs(ir_module);
+    }
+}
+
+trait_t ir_pass_from_name(weak_cstr_t name){
+    if(streq(name, "forward"))     return IR_PASS_FORWARD_LOADS;
+    if(streq(name, "fold"))        return IR_PASS_FOLD_CONSTANTS;
+    if(streq(name, "dce"))         return IR_PASS_DEAD_INSTRUCTIONS;
+    if(streq(name, "thread"))      return IR_PASS_THREAD_JUMPS;
+    if(streq(name, "unreachable")) return IR_PASS_UNREACHABLE_BLOCKS;
+    if(streq(name, "merge"))       return IR_PASS_MERGE_BLOCKS;
+    if(streq(name, "icf"))         return IR_PASS_MERGE_FUNCS;
+    return IR_PASS_NONE;
+}
@@ -4,11 +4,14 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "IR/ir_const_pool.h"
+
 void ir_pool_init(ir_pool_t *pool){
     *pool = (ir_pool_t){
         .fragments = malloc(sizeof(ir_pool_fragment_t) * 4),
         .length = 1,
         .capacity = 4,
+        .const_pool = NULL,
     };
 
     pool->fragments[0] = (ir_pool_fragment_t){
@@ -59,6 +62,10 @@ void ir_pool_free(ir_pool_t *pool){
         free(pool->fragments[f].memory);
     }
     free(pool->fragments);
+
+    if(pool->const_pool != NULL){
+        ir_const_pool_free(pool->const_pool);
+    }
 }
 
 ir_pool_snapshot_t ir_pool_snapshot_capture(ir_pool_t *pool){
@@ -77,6 +84,32 @@ void ir_pool_snapshot_restore(ir_pool_t *pool, ir_pool_snapshot_t *snapshot){
     pool->fragments[snapshot->fragments_length - 1].used = snapshot->used;
 }
 
+void ir_pool_adopt(ir_pool_t *pool, ir_pool_t *other){
+    // Interned values live in a pool of their own
+    if(other->const_pool != NULL){
+        ir_pool_adopt(pool, &other->const_pool->storage);
+        ir_const_pool_free(other->const_pool);
+    }
+
+    length_t length = pool->length + other->length;
+
+    if(length > pool->capacity){
+        // Pools are adopted once per committed function body, so grow geometrically
+        pool->capacity = length > pool->capacity * 2 ? length : pool->capacity * 2;
+        pool->fragments = realloc(pool->fragments, sizeof(ir_pool_fragment_t) * pool->capacity);
+    }
+
+    // Adopted fragments go before the most recent fragment,
+    // so that allocations keep being made from it
+    ir_pool_fragment_t recent_fragment = pool->fragments[pool->length - 1];
+    memcpy(&pool->fragments[pool->length - 1], other->fragments, sizeof(ir_pool_fragment_t) * other->length);
+    pool->fragments[length - 1] = recent_fragment;
+    pool->length = length;
+
+    free(other->fragments);
+    *other = (ir_pool_t){0};
+}
+
 void *ir_pool_memclone(ir_pool_t *pool, const void *bytes, length_t num_bytes){
     return memcpy(ir_pool_alloc(pool, num_bytes), bytes, num_bytes);
 }
@@ -57,6 +57,13 @@ strong_cstr_t ir_type_str(ir_type_t *type){
             free(inside);
             return result;
         }
+    case TYPE_KIND_VECTOR: {
+            ir_type_extra_vector_t *vector = (ir_type_extra_vector_t*) type->extra;
+            strong_cstr_t inside = ir_type_str(vector->subtype);
+            strong_cstr_t result = mallocandsprintf("<%d x %s>", (int) vector->length, inside);
+            free(inside);
+            return result;
+        }
     case TYPE_KIND_STRUCTURE:
         return strclone("struct_t");
     case TYPE_KIND_UNION:
@@ -83,6 +90,9 @@ bool ir_types_identical(ir_type_t *a, ir_type_t *b){
             if(!ir_types_identical(((ir_type_extra_composite_t*) a->extra)->subtypes[i], ((ir_type_extra_composite_t*) b->extra)->subtypes[i])) return false;
         }
         return true;
+    case TYPE_KIND_VECTOR:
+        return ((ir_type_extra_vector_t*) a->extra)->length == ((ir_type_extra_vector_t*) b->extra)->length
+            && ir_types_identical(((ir_type_extra_vector_t*) a->extra)->subtype, ((ir_type_extra_vector_t*) b->extra)->subtype);
     }
 
     return true;
@@ -115,6 +125,13 @@ ir_type_t* ir_type_make_fixed_array_of(ir_pool_t *pool, length_t length, ir_type
     return fixed_array_type;
 }
 
+ir_type_t *ir_type_make_vector_of(ir_pool_t *pool, length_t length, ir_type_t *base){
+    return ir_type_make(pool, TYPE_KIND_VECTOR, ir_pool_alloc_init(pool, ir_type_extra_vector_t, {
+        .subtype = base,
+        .length = length,
+    }));
+}
+
 ir_type_t *ir_type_make_function_pointer(ir_pool_t *pool){
     return ir_type_make(pool, TYPE_KIND_FUNCPTR, NULL);
 }
@@ -148,6 +165,25 @@ bool ir_type_is_pointer_to(ir_type_t *type, unsigned int child_type_kind){
     return true;
 }
 
+bool ir_type_has_manual_layout(ir_type_t *type){
+    switch(type->kind){
+    case TYPE_KIND_STRUCTURE: case TYPE_KIND_UNION: {
+            ir_type_extra_composite_t *composite = (ir_type_extra_composite_t*) type->extra;
+            if(composite->alignment != 0 || composite->subtype_alignments != NULL) return true;
+            if(composite->traits & TYPE_KIND_COMPOSITE_REORDERED) return true;
+
+            for(length_t i = 0; i != composite->subtypes_length; i++){
+                if(ir_type_has_manual_layout(composite->subtypes[i])) return true;
+            }
+        }
+        return false;
+    case TYPE_KIND_FIXED_ARRAY:
+        return ir_type_has_manual_layout(((ir_type_extra_fixed_array_t*) type->extra)->subtype);
+    }
+
+    return false;
+}
+
 // (For 64 bit systems)
 unsigned int global_type_kind_sizes_in_bits_64[] = {
      0, // TYPE_KIND_NONE
@@ -169,6 +205,9 @@ unsigned int global_type_kind_sizes_in_bits_64[] = {
      0, // TYPE_KIND_VOID
     64, // TYPE_KIND_FUNCPTR
      0, // TYPE_KIND_FIXED_ARRAY
+     0, // TYPE_KIND_UNKNOWN_ENUM
+     0, // TYPE_KIND_UNBUILT_COMPOSITE
+     0, // TYPE_KIND_VECTOR
 };
 
 bool global_type_kind_signs[] = { // (0 == unsigned, 1 == signed)
@@ -191,6 +230,9 @@ bool global_type_kind_signs[] = { // (0 == unsigned, 1 == signed)
     0, // TYPE_KIND_VOID
     0, // TYPE_KIND_FUNCPTR
     0, // TYPE_KIND_FIXED_ARRAY
+    0, // TYPE_KIND_UNKNOWN_ENUM
+    0, // TYPE_KIND_UNBUILT_COMPOSITE
+    0, // TYPE_KIND_VECTOR
 };
 
 bool global_type_kind_is_integer[] = { // (0 == non-integer, 1 == integer)
@@ -213,6 +255,9 @@ bool global_type_kind_is_integer[] = { // (0 == non-integer, 1 == integer)
     0, // TYPE_KIND_VOID
     0, // TYPE_KIND_FUNCPTR
     0, // TYPE_KIND_FIXED_ARRAY
+    0, // TYPE_KIND_UNKNOWN_ENUM
+    0, // TYPE_KIND_UNBUILT_COMPOSITE
+    0, // TYPE_KIND_VECTOR
 };
 
 bool global_type_kind_is_float[] = { // (0 == non-float, 1 == float)
@@ -235,4 +280,7 @@ bool global_type_kind_is_float[] = { // (0 == non-float, 1 == float)
     0, // TYPE_KIND_VOID
     0, // TYPE_KIND_FUNCPTR
     0, // TYPE_KIND_FIXED_ARRAY
+    0, // TYPE_KIND_UNKNOWN_ENUM
+    0, // TYPE_KIND_UNBUILT_COMPOSITE
+    0, // TYPE_KIND_VECTOR
 };
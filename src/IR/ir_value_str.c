@@ -70,7 +70,7 @@ static strong_cstr_t literal_to_str(ir_value_t *value, weak_cstr_t typename){
 }
 
 static strong_cstr_t value_result_to_str(ir_value_t *value, weak_cstr_t typename){
-    ir_value_result_t *reference = (ir_value_result_t*) value->extra;
+    ir_value_result_t *reference = &value->result;
 
     size_t max_size = strlen(typename) + 28;
     strong_cstr_t result = malloc(max_size);
@@ -1,4 +1,5 @@
 
+#include "IR/ir_fold.h"
 #include "IRGEN/ir_build_instr.h"
 #include "IRGEN/ir_build_literal.h"
 #include "LEX/lex.h"
@@ -125,10 +126,13 @@ void build_call_ignore_result(ir_builder_t *builder, func_id_t ir_func_id, ir_ty
     int line = -1, column = -1;
 
     // If vtable validation is enabled, remember origin line/column
-    if(builder->object->ir_module.funcs.funcs[ir_func_id].traits & IR_FUNC_VALIDATE_VTABLE){
+    if(ir_funcs_at(&builder->object->ir_module.funcs, ir_func_id)->traits & IR_FUNC_VALIDATE_VTABLE){
         lex_get_location(builder->compiler->objects[code_source.object_index]->buffer, code_source.index, &line, &column);
     }
 
+    // Calling a function makes it reachable
+    ir_module_reference_func(&builder->object->ir_module, ir_func_id);
+
     BUILD_INSTR(ir_instr_call_t, {
         .id = INSTRUCTION_CALL,
         .result_type = result_type,
@@ -162,12 +166,17 @@ void build_break(ir_builder_t *builder, length_t basicblock_id){
 }
 
 void build_cond_break(ir_builder_t *builder, ir_value_t *condition, length_t true_block_id, length_t false_block_id){
+    build_hinted_cond_break(builder, condition, true_block_id, false_block_id, TROOLEAN_UNKNOWN);
+}
+
+void build_hinted_cond_break(ir_builder_t *builder, ir_value_t *condition, length_t true_block_id, length_t false_block_id, troolean likely){
     BUILD_INSTR(ir_instr_cond_break_t, {
         .id = INSTRUCTION_CONDBREAK,
         .result_type = NULL,
         .value = condition,
         .true_block_id = true_block_id,
         .false_block_id = false_block_id,
+        .likely = likely,
     });
 }
 
@@ -243,14 +252,16 @@ ir_value_t *build_cast(ir_builder_t *builder, unsigned int const_cast_value_type
 }
 
 ir_value_t *build_nonconst_cast(ir_builder_t *builder, unsigned int cast_instr_id, ir_value_t *from, ir_type_t* to){
-    ir_instr_cast_t *instruction = (ir_instr_cast_t*) build_instruction(builder, sizeof(ir_instr_cast_t));
-
-    *instruction = (ir_instr_cast_t){
+    ir_instr_cast_t cast = (ir_instr_cast_t){
         .id = cast_instr_id,
         .result_type = to,
         .value = from,
     };
 
+    ir_value_t *folded = ir_fold_instr(builder->pool, (ir_instr_t*) &cast);
+    if(folded) return folded;
+
+    *((ir_instr_cast_t*) build_instruction(builder, sizeof(ir_instr_cast_t))) = cast;
     return build_value_from_prev_instruction(builder);
 }
 
@@ -297,12 +308,32 @@ void build_stack_restore(ir_builder_t *builder, ir_value_t *stack_pointer){
 }
 
 ir_value_t *build_math(ir_builder_t *builder, unsigned int instr_id, ir_value_t *a, ir_value_t *b, ir_type_t *result){
-    return BUILD_VALUE(ir_instr_math_t, {
+    ir_instr_math_t math = (ir_instr_math_t){
         .id = instr_id,
         .a = a,
         .b = b,
         .result_type = result,
-    });
+    };
+
+    ir_value_t *folded = ir_fold_instr(builder->pool, (ir_instr_t*) &math);
+    if(folded) return folded;
+
+    *((ir_instr_math_t*) build_instruction(builder, sizeof(ir_instr_math_t))) = math;
+    return build_value_from_prev_instruction(builder);
+}
+
+ir_value_t *build_unary(ir_builder_t *builder, unsigned int instr_id, ir_value_t *value, ir_type_t *result){
+    ir_instr_unary_t unary = (ir_instr_unary_t){
+        .id = instr_id,
+        .result_type = result,
+        .value = value,
+    };
+
+    ir_value_t *folded = ir_fold_instr(builder->pool, (ir_instr_t*) &unary);
+    if(folded) return folded;
+
+    *((ir_instr_unary_t*) build_instruction(builder, sizeof(ir_instr_unary_t))) = unary;
+    return build_value_from_prev_instruction(builder);
 }
 
 ir_value_t *build_phi2(ir_builder_t *builder, ir_type_t *result_type, ir_value_t *a, ir_value_t *b, length_t landing_a_block_id, length_t landing_b_block_id){
@@ -316,6 +347,132 @@ ir_value_t *build_phi2(ir_builder_t *builder, ir_type_t *result_type, ir_value_t
     });
 }
 
+ir_value_t *build_select(ir_builder_t *builder, ir_type_t *result_type, ir_value_t *condition, ir_value_t *if_true, ir_value_t *if_false){
+    return BUILD_VALUE(ir_instr_select_t, {
+        .id = INSTRUCTION_SELECT,
+        .result_type = result_type,
+        .condition = condition,
+        .if_true = if_true,
+        .if_false = if_false,
+    });
+}
+
+ir_value_t *build_vector_splat(ir_builder_t *builder, ir_value_t *value, ir_type_t *vector_type){
+    return BUILD_VALUE(ir_instr_cast_t, {
+        .id = INSTRUCTION_VECTOR_SPLAT,
+        .result_type = vector_type,
+        .value = value,
+    });
+}
+
+ir_value_t *build_vector_shuffle(ir_builder_t *builder, ir_type_t *result_type, ir_value_t *a, ir_value_t *b, length_t *mask, length_t mask_length){
+    return BUILD_VALUE(ir_instr_shuffle_t, {
+        .id = INSTRUCTION_VECTOR_SHUFFLE,
+        .result_type = result_type,
+        .a = a,
+        .b = b,
+        .mask = mask,
+        .mask_length = mask_length,
+    });
+}
+
+ir_value_t *build_vector_reduce(ir_builder_t *builder, unsigned int operation, ir_value_t *value){
+    return BUILD_VALUE(ir_instr_vector_reduce_t, {
+        .id = INSTRUCTION_VECTOR_REDUCE,
+        .result_type = ((ir_type_extra_vector_t*) value->type->extra)->subtype,
+        .value = value,
+        .operation = operation,
+    });
+}
+
+ir_value_t *build_intrinsic(ir_builder_t *builder, unsigned int intrinsic, ir_type_t *result_type, ir_value_t **values, length_t values_length){
+    return BUILD_VALUE(ir_instr_intrinsic_t, {
+        .id = INSTRUCTION_INTRINSIC,
+        .result_type = result_type,
+        .intrinsic = intrinsic,
+        .values = values,
+        .values_length = values_length,
+    });
+}
+
+ir_value_t *build_atomic_load(ir_builder_t *builder, ir_value_t *pointer, unsigned int ordering){
+    return BUILD_VALUE(ir_instr_atomic_t, {
+        .id = INSTRUCTION_ATOMIC_LOAD,
+        .result_type = ir_type_dereference(pointer->type),
+        .pointer = pointer,
+        .ordering = ordering,
+    });
+}
+
+ir_value_t *build_atomic_store(ir_builder_t *builder, ir_type_t *void_type, ir_value_t *value, ir_value_t *pointer, unsigned int ordering){
+    return BUILD_VALUE(ir_instr_atomic_t, {
+        .id = INSTRUCTION_ATOMIC_STORE,
+        .result_type = void_type,
+        .pointer = pointer,
+        .value = value,
+        .ordering = ordering,
+    });
+}
+
+ir_value_t *build_atomic_rmw(ir_builder_t *builder, unsigned int operation, ir_value_t *pointer, ir_value_t *value, unsigned int ordering){
+    return BUILD_VALUE(ir_instr_atomic_t, {
+        .id = INSTRUCTION_ATOMIC_RMW,
+        .result_type = value->type,
+        .pointer = pointer,
+        .value = value,
+        .operation = operation,
+        .ordering = ordering,
+    });
+}
+
+ir_value_t *build_atomic_cmpxchg(ir_builder_t *builder, ir_value_t *pointer, ir_value_t *expected, ir_value_t *value,
+        unsigned int success_ordering, unsigned int failure_ordering){
+    return BUILD_VALUE(ir_instr_atomic_t, {
+        .id = INSTRUCTION_ATOMIC_CMPXCHG,
+        .result_type = value->type,
+        .pointer = pointer,
+        .value = value,
+        .expected = expected,
+        .ordering = success_ordering,
+        .failure_ordering = failure_ordering,
+    });
+}
+
+ir_value_t *build_fence(ir_builder_t *builder, ir_type_t *void_type, unsigned int ordering){
+    return BUILD_VALUE(ir_instr_atomic_t, {
+        .id = INSTRUCTION_FENCE,
+        .result_type = void_type,
+        .ordering = ordering,
+    });
+}
+
+void build_parallel_for(ir_builder_t *builder, ir_value_t *body, ir_value_t *env, ir_value_t *count){
+    BUILD_INSTR(ir_instr_parallel_for_t, {
+        .id = INSTRUCTION_PARALLEL_FOR,
+        .result_type = NULL,
+        .body = body,
+        .env = env,
+        .count = count,
+    });
+}
+
+ir_value_t *build_coroutine(ir_builder_t *builder, unsigned int instr_id, ir_value_t *value, ir_type_t *result_type){
+    if(result_type == NULL){
+        BUILD_INSTR(ir_instr_unary_t, {
+            .id = instr_id,
+            .result_type = NULL,
+            .value = value,
+        });
+        return NULL;
+    }
+
+    return BUILD_VALUE(ir_instr_unary_t, {
+        .id = instr_id,
+        .result_type = result_type,
+        .value = value,
+    });
+}
+
 void build_llvm_asm(ir_builder_t *builder, bool is_intel, weak_cstr_t assembly, weak_cstr_t constraints, ir_value_t **args, length_t arity, bool has_side_effects, bool is_stack_align){
     BUILD_INSTR(ir_instr_asm_t, {
         .id = INSTRUCTION_ASM,
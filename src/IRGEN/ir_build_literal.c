@@ -1,6 +1,10 @@
 
 #include "IRGEN/ir_build_literal.h"
 
+#include "IR/ir_const_pool.h"
+#include "IR/ir_fold.h"
+#include "IRGEN/ir_speculation.h"
+
 ir_value_t *build_struct_literal(ir_module_t *module, ir_type_t *type, ir_value_t **values, length_t length, bool make_mutable){
     // Create struct literal
     ir_value_t *result = ir_pool_alloc_init(&module->pool, ir_value_t, {
@@ -94,19 +98,16 @@ ir_value_t *build_array_literal(ir_pool_t *pool, ir_type_t *item_type, ir_value_
 }
 
 ir_value_t *build_literal_int(ir_pool_t *pool, adept_int value){
-    return ir_pool_alloc_init(pool, ir_value_t, {
-        .value_type = VALUE_TYPE_LITERAL,
-        .type = ir_type_make(pool, TYPE_KIND_S32, NULL),
-        .extra = ir_pool_memclone(pool, &value, sizeof value),
-    });
+    return ir_const_pool_literal(pool, TYPE_KIND_S32, &value);
 }
 
 ir_value_t *build_literal_usize(ir_pool_t *pool, adept_usize value){
-    return ir_pool_alloc_init(pool, ir_value_t, {
-        .value_type = VALUE_TYPE_LITERAL,
-        .type = ir_type_make(pool, TYPE_KIND_U64, NULL),
-        .extra = ir_pool_memclone(pool, &value, sizeof value),
-    });
+    return ir_const_pool_literal(pool, TYPE_KIND_U64, &value);
+}
+
+ir_value_t *build_placeholder_usize(ir_pool_t *pool){
+    adept_usize value = 0;
+    return ir_literal_make(pool, ir_type_make(pool, TYPE_KIND_U64, NULL), &value, sizeof value);
 }
 
 ir_value_t *build_unknown_enum_value(ir_pool_t *pool, source_t source, weak_cstr_t kind_name){
@@ -121,6 +122,9 @@ ir_value_t *build_literal_str(ir_builder_t *builder, char *array, length_t lengt
     ir_type_t *ir_string_type = builder->object->ir_module.common.ir_string_struct;
 
     if(ir_string_type == NULL){
+        // Let the message be printed when the body is generated normally
+        if(ir_speculation_give_up(builder->object->ir_module.speculation)) return NULL;
+
         redprintf("Can't create string literal without String type present");
         printf("\nTry importing '%s/String.adept'\n", ADEPT_VERSION_STRING);
         return NULL;
@@ -209,17 +213,19 @@ ir_value_t *build_func_addr_by_name(ir_pool_t *pool, ir_type_t *result_type, con
 }
 
 ir_value_t *build_const_cast(ir_pool_t *pool, unsigned int cast_value_type, ir_value_t *from, ir_type_t *to){
-    return ir_pool_alloc_init(pool, ir_value_t, {
+    ir_value_t cast = (ir_value_t){
         .value_type = cast_value_type,
         .type = to,
         .extra = from,
-    });
+    };
+
+    // Casts of scalar literals become plain literals
+    ir_value_t *folded = ir_fold_scalar_literal(pool, &cast);
+    if(folded) return folded;
+
+    return ir_pool_memclone(pool, &cast, sizeof cast);
 }
 
 ir_value_t *build_bool(ir_pool_t *pool, adept_bool value){
-    return ir_pool_alloc_init(pool, ir_value_t, {
-        .value_type = VALUE_TYPE_LITERAL,
-        .type = ir_type_make(pool, TYPE_KIND_BOOLEAN, NULL),
-        .extra = ir_pool_memclone(pool, &value, sizeof value),
-    });
+    return ir_const_pool_literal(pool, TYPE_KIND_BOOLEAN, &value);
 }
@@ -16,6 +16,7 @@
 #include "BRIDGE/bridge.h"
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
+#include "INFER/infer.h"
 #include "IR/ir.h"
 #include "IR/ir_func_endpoint.h"
 #include "IR/ir_pool.h"
@@ -31,6 +32,7 @@
 #include "IRGEN/ir_gen_find.h"
 #include "IRGEN/ir_gen_find_sf.h"
 #include "IRGEN/ir_gen_type.h"
+#include "IRGEN/ir_speculation.h"
 #include "LEX/lex.h"
 #include "UTIL/builtin_type.h"
 #include "UTIL/color.h"
@@ -39,14 +41,18 @@
 #include "UTIL/ground.h"
 #include "UTIL/string.h"
 #include "UTIL/trait.h"
+#include "UTIL/util.h"
 
 void ir_builder_init(ir_builder_t *builder, compiler_t *compiler, object_t *object, func_id_t ast_func_id, func_id_t ir_func_id, bool static_builder){
     builder->basicblocks = (ir_basicblocks_t){
         .blocks = malloc(sizeof(ir_basicblock_t) * 4),
         .length = 1,
         .capacity = 4,
+        .instructions_pool = malloc(sizeof(ir_pool_t)),
     };
 
+    ir_pool_init(builder->basicblocks.instructions_pool);
+
     builder->pool = &object->ir_module.pool;
     builder->type_map = &object->ir_module.type_map;
     builder->compiler = compiler;
@@ -77,7 +83,7 @@ void ir_builder_init(ir_builder_t *builder, compiler_t *compiler, object_t *obje
     builder->block_stack = (block_stack_t){0};
 
     if(!static_builder){
-        ir_func_t *module_func = &object->ir_module.funcs.funcs[ir_func_id];
+        ir_func_t *module_func = ir_funcs_at(&object->ir_module.funcs, ir_func_id);
         module_func->scope = malloc(sizeof(bridge_scope_t));
         bridge_scope_init(module_func->scope, NULL);
         module_func->scope->first_var_id = 0;
@@ -109,6 +115,7 @@ void ir_builder_init(ir_builder_t *builder, compiler_t *compiler, object_t *obje
     builder->ptr_type = ir_type_make_pointer_to(builder->pool, builder->s8_type);
     builder->has_noop_defer_function = false;
     builder->noop_defer_function = 0;
+    builder->parallel_body = NULL;
 }
 
 void ir_builder_free(ir_builder_t *builder){
@@ -149,7 +156,7 @@ void build_using_basicblock(ir_builder_t *builder, length_t basicblock_id){
 ir_instr_t* build_instruction(ir_builder_t *builder, length_t size){
     // NOTE: Builds an empty instruction of the size 'size'
     ir_instrs_t *instrs = &builder->current_block->instructions;
-    ir_instrs_append(instrs, (ir_instr_t*) ir_pool_alloc(builder->pool, size));
+    ir_instrs_append(instrs, (ir_instr_t*) ir_pool_alloc(builder->basicblocks.instructions_pool, size));
     return ir_instrs_last_unchecked(instrs);
 }
 
@@ -174,10 +181,10 @@ ir_value_t *build_value_from_prev_instruction(ir_builder_t *builder){
     return ir_pool_alloc_init(builder->pool, ir_value_t, {
         .value_type = VALUE_TYPE_RESULT,
         .type = result_type,
-        .extra = ir_pool_alloc_init(builder->pool, ir_value_result_t, {
+        .result = {
             .block_id = builder->current_block_id,
             .instruction_id = instruction_id,
-        })
+        },
     });
 }
 
@@ -299,6 +306,53 @@ bridge_var_t *ir_builder_add_variable(ir_builder_t *builder, weak_cstr_t name, a
     return &list->variables[list->length - 1];
 }
 
+bridge_var_t *ir_builder_find_var(ir_builder_t *builder, weak_cstr_t name){
+    bridge_var_t *variable = bridge_scope_find_var(builder->scope, name);
+    if(variable || builder->parallel_body == NULL) return variable;
+
+    // Not declared inside of the parallel loop body, so attempt to capture it
+    // from the function that encloses the loop
+    ir_parallel_body_t *parallel_body = builder->parallel_body;
+    bridge_var_t *outer = ir_builder_find_var(parallel_body->enclosing, name);
+    if(outer == NULL) return NULL;
+
+    // Elements of SoA containers only exist as indices into containers of the enclosing function
+    if(outer->traits & BRIDGE_VAR_SOA_ELEMENT) return NULL;
+
+    ir_func_t *module_func = ir_funcs_at(&builder->object->ir_module.funcs, builder->ir_func_id);
+    bridge_scope_t *root_scope = module_func->scope;
+
+    // Static variables are global-like, so they can be referred to directly
+    if(outer->traits & BRIDGE_VAR_STATIC){
+        bridge_var_list_append(&root_scope->list, *outer);
+        return &root_scope->list.variables[root_scope->list.length - 1];
+    }
+
+    length_t slot = parallel_body->reserved_slots + parallel_body->captures_length;
+    expand((void**) &parallel_body->captures, sizeof(weak_cstr_t), parallel_body->captures_length, &parallel_body->captures_capacity, 1, 4);
+    parallel_body->captures[parallel_body->captures_length++] = name;
+
+    // Captured variables are references to the storage of the enclosing function
+    ir_type_t *ir_type = outer->traits & BRIDGE_VAR_REFERENCE ? outer->ir_type : ir_type_make_pointer_to(builder->pool, outer->ir_type);
+
+    bridge_scope_t *current_scope = builder->scope;
+    builder->scope = root_scope;
+    bridge_var_t *captured = ir_builder_add_variable(builder, name, outer->ast_type, ir_type, BRIDGE_VAR_POD | BRIDGE_VAR_REFERENCE);
+    builder->scope = current_scope;
+
+    // Initialize the reference from the environment at the start of the function
+    length_t current_block_id = builder->current_block_id;
+    build_using_basicblock(builder, 0);
+
+    ir_type_t *env_type = ir_type_make_pointer_to(builder->pool, builder->ptr_type);
+    ir_value_t *env = build_load(builder, build_lvarptr(builder, ir_type_make_pointer_to(builder->pool, env_type), parallel_body->env_var_id), NULL_SOURCE);
+    ir_value_t *address = build_load(builder, build_array_access(builder, env, build_literal_usize(builder->pool, slot), NULL_SOURCE), NULL_SOURCE);
+    build_store(builder, build_bitcast(builder, address, ir_type), build_lvarptr(builder, ir_type_make_pointer_to(builder->pool, ir_type), captured->id), NULL_SOURCE);
+
+    build_using_basicblock(builder, current_block_id);
+    return captured;
+}
+
 errorcode_t handle_deference_for_variables(ir_builder_t *builder, bridge_var_list_t *list){
     for(length_t i = 0; i != list->length; i++){
         bridge_var_t *variable = &list->variables[i];
@@ -306,6 +360,12 @@ errorcode_t handle_deference_for_variables(ir_builder_t *builder, bridge_var_lis
         trait_t traits = variable->traits;
         unsigned int ir_type_kind = variable->ir_type->kind;
 
+        if(traits & BRIDGE_VAR_COROUTINE){
+            ir_value_t *handle = build_load(builder, build_varptr(builder, ir_type_make_pointer_to(builder->pool, variable->ir_type), variable), variable->source);
+            build_coroutine(builder, INSTRUCTION_COROUTINE_DESTROY, handle, NULL);
+            continue;
+        }
+
         if(traits & (BRIDGE_VAR_POD | BRIDGE_VAR_REFERENCE) || !(ir_type_kind == TYPE_KIND_STRUCTURE && ir_type_kind != TYPE_KIND_FIXED_ARRAY)){
             continue;
         }
@@ -441,7 +501,7 @@ errorcode_t handle_single_deference(ir_builder_t *builder, ast_type_t *ast_type,
 
             // Call __defer__()
             if(pair.has){
-                ir_type_t *result_type = builder->object->ir_module.funcs.funcs[pair.value.ir_func_id].return_type;
+                ir_type_t *result_type = ir_funcs_at(&builder->object->ir_module.funcs, pair.value.ir_func_id)->return_type;
                 ir_value_t **arguments = ir_pool_alloc_init(builder->pool, ir_value_t*, mutable_value);
 
                 build_call_ignore_result(builder, pair.value.ir_func_id, result_type, arguments, 1, from_source);
@@ -462,8 +522,7 @@ errorcode_t handle_single_deference(ir_builder_t *builder, ast_type_t *ast_type,
 errorcode_t handle_children_deference(ir_builder_t *builder){
     // Generates __defer__ calls for children of the parent type of a __defer__ function
 
-    // DANGEROUS: 'func' could be invalidated by generation of new functions
-    ast_func_t *func = &builder->object->ast.funcs[builder->ast_func_id];
+    ast_func_t *func = ast_funcs_at(&builder->object->ast.funcs, builder->ast_func_id);
     ast_type_t *this_ast_type = func->arity == 1 ? &func->arg_types[0] : NULL;
 
     if(this_ast_type == NULL || this_ast_type->elements_length != 2){
@@ -536,7 +595,7 @@ errorcode_t handle_pass_management(ir_builder_t *builder, ir_value_t **values, a
                     func_id_t ir_func_id = pair.value.ir_func_id;
 
                     ir_value_t **arguments = ir_pool_alloc_init(builder->pool, ir_value_t*, values[i]);
-                    ir_type_t *return_type = builder->object->ir_module.funcs.funcs[ir_func_id].return_type;                
+                    ir_type_t *return_type = ir_funcs_at(&builder->object->ir_module.funcs, ir_func_id)->return_type;                
 
                     values[i] = build_call(builder, ir_func_id, return_type, arguments, 1, NULL_SOURCE);
                 }
@@ -570,7 +629,7 @@ errorcode_t handle_single_pass(ir_builder_t *builder, ast_type_t *ast_type, ir_v
                 func_id_t ir_func_id = pair.value.ir_func_id;
 
                 ir_value_t **arguments = ir_pool_alloc_init(builder->pool, ir_value_t*, build_load(builder, mutable_value, ast_type->source));
-                ir_type_t *result_type = builder->object->ir_module.funcs.funcs[ir_func_id].return_type;
+                ir_type_t *result_type = ir_funcs_at(&builder->object->ir_module.funcs, ir_func_id)->return_type;
 
                 // Perform __pass__
                 build_store(builder, build_call(builder, ir_func_id, result_type, arguments, 1, from_source), mutable_value, ast_type->source);
@@ -592,8 +651,7 @@ errorcode_t handle_children_pass_root(ir_builder_t *builder, bool already_has_re
     errorcode_t res = handle_children_pass(builder);
     if(res) return res;
 
-    // DANGEROUS: 'func' could be invalidated by generation of new functions
-    ast_func_t *autogen_func = &builder->object->ast.funcs[builder->ast_func_id];
+    ast_func_t *autogen_func = ast_funcs_at(&builder->object->ast.funcs, builder->ast_func_id);
 
     ast_type_t *passed_ast_type = autogen_func->arity == 1 ? &autogen_func->arg_types[0] : NULL;
     if(passed_ast_type == NULL) return FAILURE;
@@ -617,8 +675,7 @@ errorcode_t handle_children_pass_root(ir_builder_t *builder, bool already_has_re
 errorcode_t handle_children_pass(ir_builder_t *builder){
     // Generates __pass__ calls for children of the parent type of a __pass__ function
 
-    // DANGEROUS: 'func' could be invalidated by generation of new functions
-    ast_func_t *func = &builder->object->ast.funcs[builder->ast_func_id];
+    ast_func_t *func = ast_funcs_at(&builder->object->ast.funcs, builder->ast_func_id);
     ast_type_t *passed_ast_type = func->arity == 1 ? &func->arg_types[0] : NULL;
 
     if(passed_ast_type == NULL || passed_ast_type->elements_length < 1){
@@ -737,7 +794,7 @@ errorcode_t handle_assign_management(
         ast_t *ast = &builder->object->ast;
         func_pair_t pair = result.value;
 
-        if(ast->funcs[pair.ast_func_id].traits & AST_FUNC_DISALLOW){
+        if(ast_funcs_at(&ast->funcs, pair.ast_func_id)->traits & AST_FUNC_DISALLOW){
             strong_cstr_t typename = ast_type_str(value_ast_type);
             compiler_panicf(builder->compiler, source_on_failure, "Assignment for type '%s' is not allowed", typename);
             free(typename);
@@ -760,12 +817,12 @@ errorcode_t handle_assign_management(
         arguments[0] = destination;
         arguments[1] = value;
 
-        errorcode = handle_pass_management(builder, arguments, ast->funcs[pair.ast_func_id].arg_types, ast->funcs[pair.ast_func_id].arg_type_traits, 2);
+        errorcode = handle_pass_management(builder, arguments, ast_funcs_at(&ast->funcs, pair.ast_func_id)->arg_types, ast_funcs_at(&ast->funcs, pair.ast_func_id)->arg_type_traits, 2);
         ast_type_free(&arg_types[0]);
 
         if(errorcode) goto handle_errorcode;
     
-        ir_type_t *result_type = builder->object->ir_module.funcs.funcs[pair.ir_func_id].return_type;
+        ir_type_t *result_type = ir_funcs_at(&builder->object->ir_module.funcs, pair.ir_func_id)->return_type;
         build_call_ignore_result(builder, pair.ir_func_id, result_type, arguments, 2, source_on_failure);
         return SUCCESS;
     }
@@ -797,16 +854,16 @@ ir_value_t *handle_math_management(ir_builder_t *builder, ir_math_operands_t *op
 
         if(ir_gen_find_func_conforming_without_defaults(builder, overload_name, arguments, types, 2, NULL, false, from_source, &result)
         || !result.has
-        || handle_pass_management(builder, arguments, ast->funcs[result.value.ast_func_id].arg_types, ast->funcs[result.value.ast_func_id].arg_type_traits, 2)){
+        || handle_pass_management(builder, arguments, ast_funcs_at(&ast->funcs, result.value.ast_func_id)->arg_types, ast_funcs_at(&ast->funcs, result.value.ast_func_id)->arg_type_traits, 2)){
             ir_pool_snapshot_restore(builder->pool, &snapshot);
             return NULL;
         }
 
         func_pair_t pair = result.value;
-        ir_type_t *result_type = module->funcs.funcs[pair.ir_func_id].return_type;
+        ir_type_t *result_type = ir_funcs_at(&module->funcs, pair.ir_func_id)->return_type;
 
         if(out_type != NULL){
-            *out_type = ast_type_clone(&ast->funcs[pair.ast_func_id].return_type);
+            *out_type = ast_type_clone(&ast_funcs_at(&ast->funcs, pair.ast_func_id)->return_type);
         }
 
         return build_call(builder, pair.ir_func_id, result_type, arguments, 2, from_source);
@@ -864,9 +921,9 @@ ir_value_t *handle_access_management(
     errorcode_t search_error = ir_gen_find_method_conforming_without_defaults(builder, struct_name, "__access__", arguments, argument_ast_types, 2, NULL, NULL_SOURCE, &result);
 
     ast_t *ast = &builder->object->ast;
-    trait_t *arg_type_traits = ast->funcs[result.value.ast_func_id].arg_type_traits;
+    trait_t *arg_type_traits = ast_funcs_at(&ast->funcs, result.value.ast_func_id)->arg_type_traits;
 
-    bool error = search_error || !result.has || handle_pass_management(builder, arguments, ast->funcs[result.value.ast_func_id].arg_types, arg_type_traits, 2);
+    bool error = search_error || !result.has || handle_pass_management(builder, arguments, ast_funcs_at(&ast->funcs, result.value.ast_func_id)->arg_types, arg_type_traits, 2);
     ast_type_free(&argument_ast_types[0]);
     
     if(error){
@@ -875,10 +932,10 @@ ir_value_t *handle_access_management(
     }
 
     func_pair_t pair = result.value;
-    ir_type_t *result_ir_type = builder->object->ir_module.funcs.funcs[pair.ir_func_id].return_type;
+    ir_type_t *result_ir_type = ir_funcs_at(&builder->object->ir_module.funcs, pair.ir_func_id)->return_type;
 
     if(out_ptr_to_element_type != NULL){
-        *out_ptr_to_element_type = ast_type_clone(&ast->funcs[pair.ast_func_id].return_type);
+        *out_ptr_to_element_type = ast_type_clone(&ast_funcs_at(&ast->funcs, pair.ast_func_id)->return_type);
     }
 
     return build_call(builder, pair.ir_func_id, result_ir_type, arguments, 2, source);
@@ -887,7 +944,10 @@ ir_value_t *handle_access_management(
 errorcode_t instantiate_poly_func(compiler_t *compiler, object_t *object, source_t instantiation_source, func_id_t ast_poly_func_id, ast_type_t *types,
         length_t types_list_length, ast_poly_catalog_t *catalog, length_t instantiation_depth, ir_func_endpoint_t *out_endpoint){
 
-    ast_func_t *poly_func = &object->ast.funcs[ast_poly_func_id];
+    // Instances are cloned from the inferred body of the polymorphic function
+    if(infer_func_body_on_demand(compiler, object, ast_poly_func_id)) return FAILURE;
+
+    ast_func_t *poly_func = ast_funcs_at(&object->ast.funcs, ast_poly_func_id);
     length_t required_arity = poly_func->arity;
 
     // Require compatible arity
@@ -928,10 +988,7 @@ errorcode_t instantiate_poly_func(compiler_t *compiler, object_t *object, source
     ast_t *ast = &object->ast;
     func_id_t ast_func_id = ast_new_func(ast);
 
-    // Revalidate poly_func
-    poly_func = &object->ast.funcs[ast_poly_func_id];
-
-    ast_func_t *func = &ast->funcs[ast_func_id];
+    ast_func_t *func = ast_funcs_at(&ast->funcs, ast_func_id);
     bool is_entry = streq(poly_func->name, compiler->entry_point);
 
     maybe_null_strong_cstr_t export_name = poly_func->export_as ? strclone(poly_func->export_as) : NULL;
@@ -1025,6 +1082,11 @@ errorcode_t instantiate_poly_func(compiler_t *compiler, object_t *object, source
         goto failure;
     }
 
+    if(ast_func_is_generator(poly_func)
+    && ast_resolve_type_polymorphs(compiler, rtti_collector, catalog, &poly_func->yield_type, &func->yield_type)){
+        goto failure;
+    }
+
     ir_func_endpoint_t newest_endpoint;
     if(ir_gen_func_head(compiler, object, func, ast_func_id, &newest_endpoint)){
         goto failure;
@@ -1038,7 +1100,7 @@ errorcode_t instantiate_poly_func(compiler_t *compiler, object_t *object, source
         }
 
         // Change virtual origin to be concrete version
-        func = &ast->funcs[ast_func_id];
+        func = ast_funcs_at(&ast->funcs, ast_func_id);
         func->virtual_origin = ast_concrete_virtual_origin;
     }
 
@@ -1061,7 +1123,7 @@ errorcode_t instantiate_default_for_virtual_dispatcher(
     // With the instantiation of a concrete dispatcher, instantiate the associated default implementation
 
     ast_t *ast = &object->ast;
-    ast_func_t *dispatcher = &ast->funcs[dispatcher_id];
+    ast_func_t *dispatcher = ast_funcs_at(&ast->funcs, dispatcher_id);
 
     assert(dispatcher->arity > 0);
     assert(ast_type_is_pointer_to_base_like(&dispatcher->arg_types[0]));
@@ -1069,7 +1131,7 @@ errorcode_t instantiate_default_for_virtual_dispatcher(
     func_id_t virtual_ast_id = dispatcher->virtual_origin;
     assert(virtual_ast_id != INVALID_FUNC_ID);
 
-    ast_func_t *originating_virtual = &ast->funcs[virtual_ast_id];
+    ast_func_t *originating_virtual = ast_funcs_at(&ast->funcs, virtual_ast_id);
     ast_type_t parent_type = ast_type_unwrapped_view(&originating_virtual->arg_types[0]);
 
     // Hook up link from concrete virtual to concrete dispatcher
@@ -1115,7 +1177,7 @@ errorcode_t instantiate_default_for_virtual_dispatcher(
         goto failure;
     }
 
-    ast_func_t *default_impl = &object->ast.funcs[result.value.ast_func_id];
+    ast_func_t *default_impl = ast_funcs_at(&object->ast.funcs, result.value.ast_func_id);
 
     if(!(default_impl->traits & AST_FUNC_VIRTUAL)){
         strong_cstr_t head_str = ast_func_head_str(default_impl);
@@ -1152,7 +1214,7 @@ errorcode_t attempt_autogen___defer__(compiler_t *compiler, object_t *object, as
         return SUCCESS;
     }
 
-    if(ast->funcs_length >= MAX_FUNC_ID){
+    if(ast->funcs.length >= MAX_FUNC_ID){
         compiler_panic(compiler, arg_types[0].source, "Maximum number of AST functions reached\n");
         return FAILURE;
     }
@@ -1228,9 +1290,12 @@ errorcode_t attempt_autogen___defer__(compiler_t *compiler, object_t *object, as
         return SUCCESS;
     }
 
+    // Functions can't be auto-generated speculatively
+    if(ir_speculation_give_up(object->ir_module.speculation)) return ALT_FAILURE;
+
     // Create AST function
     func_id_t ast_func_id = ast_new_func(ast);
-    ast_func_t *func = &ast->funcs[ast_func_id];
+    ast_func_t *func = ast_funcs_at(&ast->funcs, ast_func_id);
 
     ast_func_create_template(compiler, func, &(ast_func_head_t){
         .name = strclone("__defer__"),
@@ -1324,13 +1389,16 @@ errorcode_t attempt_autogen___pass__(compiler_t *compiler, object_t *object, ast
         if(!ast_layout_is_simple_struct(&template->layout)) return FAILURE;
     }
 
-    if(ast->funcs_length >= MAX_FUNC_ID){
+    if(ast->funcs.length >= MAX_FUNC_ID){
         compiler_panic(compiler, arg_types[0].source, "Maximum number of AST functions reached\n");
         return FAILURE;
     }
 
+    // Functions can't be auto-generated speculatively
+    if(ir_speculation_give_up(object->ir_module.speculation)) return ALT_FAILURE;
+
     func_id_t ast_func_id = ast_new_func(ast);
-    ast_func_t *func = &ast->funcs[ast_func_id];
+    ast_func_t *func = ast_funcs_at(&ast->funcs, ast_func_id);
     
     ast_func_create_template(compiler, func, &(ast_func_head_t){
         .name = strclone("__pass__"),
@@ -1404,7 +1472,7 @@ errorcode_t attempt_autogen___assign__(compiler_t *compiler, object_t *object, a
         return SUCCESS;
     }
 
-    if(ast->funcs_length >= MAX_FUNC_ID){
+    if(ast->funcs.length >= MAX_FUNC_ID){
         compiler_panic(compiler, arg_types[0].source, "Maximum number of AST functions reached\n");
         return FAILURE;
     }
@@ -1477,7 +1545,7 @@ errorcode_t attempt_autogen___assign__(compiler_t *compiler, object_t *object, a
         }
 
         if(errorcode == SUCCESS && result.has){
-            trait_t ast_func_traits = ast->funcs[result.value.ast_func_id].traits;
+            trait_t ast_func_traits = ast_funcs_at(&ast->funcs, result.value.ast_func_id)->traits;
 
             some_have_assign = true;
             disallowed |= ast_func_traits & AST_FUNC_DISALLOW;
@@ -1494,9 +1562,12 @@ errorcode_t attempt_autogen___assign__(compiler_t *compiler, object_t *object, a
         return SUCCESS;
     }
 
+    // Functions can't be auto-generated speculatively
+    if(ir_speculation_give_up(object->ir_module.speculation)) return ALT_FAILURE;
+
     // Create AST function
     func_id_t ast_func_id = ast_new_func(ast);
-    ast_func_t *func = &ast->funcs[ast_func_id];
+    ast_func_t *func = ast_funcs_at(&ast->funcs, ast_func_id);
 
     ast_func_create_template(compiler, func, &(ast_func_head_t){
         .name = strclone("__assign__"),
@@ -1617,7 +1688,7 @@ errorcode_t ir_builder_get_noop_defer_func(ir_builder_t *builder, source_t sourc
     if(ir_gen_func_template(builder->compiler, builder->object, "__noop_defer__", source_on_error, &ir_func_id)) return FAILURE;
 
     ir_module_t *module = &builder->object->ir_module;
-    ir_func_t *module_func = &module->funcs.funcs[ir_func_id];
+    ir_func_t *module_func = ir_funcs_at(&module->funcs, ir_func_id);
     module_func->argument_types = malloc(sizeof(ir_type_t) * 1);
     module_func->arity = 1;
 
@@ -1736,7 +1807,7 @@ failure:
 }
 
 length_t ir_builder_instantiation_depth(ir_builder_t *builder){
-    return builder->object->ast.funcs[builder->ast_func_id].instantiation_depth;
+    return ast_funcs_at(&builder->object->ast.funcs, builder->ast_func_id)->instantiation_depth;
 }
 
 ir_instrs_snapshot_t ir_instrs_snapshot_capture(ir_builder_t *builder){
@@ -1744,6 +1815,7 @@ ir_instrs_snapshot_t ir_instrs_snapshot_capture(ir_builder_t *builder){
         .current_block_id = builder->current_block_id,
         .current_basicblock_instructions_length = builder->current_block->instructions.length,
         .basicblocks_length = builder->basicblocks.length,
+        .instructions_pool_snapshot = ir_pool_snapshot_capture(builder->basicblocks.instructions_pool),
         .funcs_length = builder->object->ir_module.funcs.length,
         .job_list_length = builder->job_list->length,
     };
@@ -1755,5 +1827,16 @@ void ir_instrs_snapshot_restore(ir_builder_t *builder, ir_instrs_snapshot_t *sna
     builder->current_block->instructions.length = snapshot->current_basicblock_instructions_length;
     builder->basicblocks.length = snapshot->basicblocks_length;
     builder->object->ir_module.funcs.length = snapshot->funcs_length;
+    ir_pool_snapshot_restore(builder->basicblocks.instructions_pool, &snapshot->instructions_pool_snapshot);
+
+    // Functions that were only referenced by the discarded instructions are unreferenced again
+    for(length_t i = snapshot->job_list_length; i < builder->job_list->length; i++){
+        func_id_t ir_func_id = builder->job_list->jobs[i].ir_func_id;
+
+        if(ir_func_id < snapshot->funcs_length && builder->compiler->traits & COMPILER_LAZY){
+            ir_funcs_at(&builder->object->ir_module.funcs, ir_func_id)->traits |= IR_FUNC_UNREFERENCED;
+        }
+    }
+
     builder->job_list->length = snapshot->job_list_length;
 }
@@ -13,6 +13,7 @@
 
 void ir_gen_sf_cache_init(ir_gen_sf_cache_t *cache, length_t num_buckets){
     cache->capacity = num_buckets;
+    cache->fallback = NULL;
     cache->storage = malloc(sizeof(ir_gen_sf_cache_entry_t) * cache->capacity);
     memset(cache->storage, 0, sizeof(ir_gen_sf_cache_entry_t) * cache->capacity);
 }
@@ -52,6 +53,25 @@ errorcode_t ir_gen_sf_cache_read(troolean has, func_pair_t maybe_pair, optional_
     return FAILURE;
 }
 
+static void ir_gen_sf_cache_entry_init(ir_gen_sf_cache_t *cache, ir_gen_sf_cache_entry_t *entry, ast_type_t *type){
+    ir_gen_sf_cache_entry_t *known = cache->fallback ? ir_gen_sf_cache_locate(cache->fallback, type) : NULL;
+
+    entry->ast_type = ast_type_clone(type);
+
+    if(known){
+        entry->has_pass = known->has_pass;
+        entry->has_defer = known->has_defer;
+        entry->has_assign = known->has_assign;
+        entry->pass = known->pass;
+        entry->defer = known->defer;
+        entry->assign = known->assign;
+    } else {
+        entry->has_pass = TROOLEAN_UNKNOWN;
+        entry->has_defer = TROOLEAN_UNKNOWN;
+        entry->has_assign = TROOLEAN_UNKNOWN;
+    }
+}
+
 ir_gen_sf_cache_entry_t *ir_gen_sf_cache_locate_or_insert(ir_gen_sf_cache_t *cache, ast_type_t *type){
     hash_t hash = ast_type_hash(type);
     ir_gen_sf_cache_entry_t *entry = &cache->storage[hash % cache->capacity];
@@ -69,10 +89,7 @@ ir_gen_sf_cache_entry_t *ir_gen_sf_cache_locate_or_insert(ir_gen_sf_cache_t *cac
                 entry = entry->next;
 
                 memset(entry, 0, sizeof(ir_gen_sf_cache_entry_t));
-                entry->ast_type = ast_type_clone(type);
-                entry->has_pass = TROOLEAN_UNKNOWN;
-                entry->has_defer = TROOLEAN_UNKNOWN;
-                entry->has_assign = TROOLEAN_UNKNOWN;
+                ir_gen_sf_cache_entry_init(cache, entry, type);
                 return entry;
             }
             entry = entry->next;
@@ -80,13 +97,22 @@ ir_gen_sf_cache_entry_t *ir_gen_sf_cache_locate_or_insert(ir_gen_sf_cache_t *cac
     }
 
     // New entry here
-    entry->ast_type = ast_type_clone(type);
-    entry->has_pass = TROOLEAN_UNKNOWN;
-    entry->has_defer = TROOLEAN_UNKNOWN;
-    entry->has_assign = TROOLEAN_UNKNOWN;
+    ir_gen_sf_cache_entry_init(cache, entry, type);
     return entry;
 }
 
+ir_gen_sf_cache_entry_t *ir_gen_sf_cache_locate(ir_gen_sf_cache_t *cache, ast_type_t *type){
+    ir_gen_sf_cache_entry_t *entry = &cache->storage[ast_type_hash(type) % cache->capacity];
+
+    if(!ir_gen_sf_cache_entry_is_occupied(entry)) return NULL;
+
+    for(; entry; entry = entry->next){
+        if(ast_types_identical(type, &entry->ast_type)) return entry;
+    }
+
+    return NULL;
+}
+
 void ir_gen_sf_cache_dump(FILE *file, ir_gen_sf_cache_t *sf_cache){
     for(length_t i = 0; i < sf_cache->capacity; i++){
         ir_gen_sf_cache_entry_t *entry = &sf_cache->storage[i];
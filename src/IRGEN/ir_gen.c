@@ -14,9 +14,12 @@
 #include "BRIDGEIR/rtti.h"
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
+#include "INFER/infer.h"
 #include "IR/ir.h"
 #include "IR/ir_func_endpoint.h"
+#include "IR/ir_infer.h"
 #include "IR/ir_module.h"
+#include "IR/ir_pass.h"
 #include "IR/ir_pool.h"
 #include "IR/ir_proc_map.h"
 #include "IR/ir_type.h"
@@ -32,6 +35,7 @@
 #include "IRGEN/ir_gen_stmt.h"
 #include "IRGEN/ir_gen_type.h"
 #include "IRGEN/ir_gen_vtree.h"
+#include "IRGEN/ir_speculation.h"
 #include "IRGEN/ir_vtree.h"
 #include "LEX/lex.h"
 #include "UTIL/builtin_type.h"
@@ -47,15 +51,21 @@
 errorcode_t ir_gen(compiler_t *compiler, object_t *object){
     object_create_module(object);
 
-    return ir_gen_type_mappings(compiler, object)
+    if(ir_gen_type_mappings(compiler, object)
         || ir_gen_globals(compiler, object)
         || ir_gen_functions(compiler, object)
         || ir_gen_auxiliary_builders(compiler, object)
         || ir_gen_functions_body(compiler, object, NULL)
         || ir_gen_vtables(compiler, object)
-        || ir_gen_build_rtti_table(object)
+        || ir_gen_build_rtti_table(compiler, object)
         || ir_gen_special_globals(compiler, object)
-        || ir_gen_fill_in_rtti(object);
+        || ir_gen_fill_in_rtti(object)){
+        return FAILURE;
+    }
+
+    ir_module_run_passes(&object->ir_module, compiler->ir_passes, compiler->checks & COMPILER_NULL_CHECKS);
+    ir_module_infer_attributes(&object->ir_module, compiler->checks & COMPILER_NULL_CHECKS);
+    return SUCCESS;
 }
 
 errorcode_t ir_gen_vtables(compiler_t *compiler, object_t *object){
@@ -80,7 +90,7 @@ errorcode_t ir_gen_vtables(compiler_t *compiler, object_t *object){
         
         for(length_t i = 0; i != endpoint_list->length; i++){
             ir_func_endpoint_t endpoint = endpoint_list->endpoints[i];
-            ast_func_t *func = &ast->funcs[endpoint.ast_func_id];
+            ast_func_t *func = ast_funcs_at(&ast->funcs, endpoint.ast_func_id);
 
             if(func->traits & AST_FUNC_VIRTUAL && endpoint.ir_func_id != INVALID_FUNC_ID){
                 ast_type_t subject_type = ast_type_unwrapped_view(&func->arg_types[0]);
@@ -91,8 +101,8 @@ errorcode_t ir_gen_vtables(compiler_t *compiler, object_t *object){
     }
 
     // Grab all remaining descendent classes of root classes by examining all existing concrete class constructors
-    for(length_t i = 0; i != ast->funcs_length; i++){
-        ast_func_t *func = &ast->funcs[i];
+    for(length_t i = 0; i != ast->funcs.length; i++){
+        ast_func_t *func = ast_funcs_at(&ast->funcs, i);
 
         if(func->traits & AST_FUNC_CLASS_CONSTRUCTOR && !(func->traits & AST_FUNC_POLYMORPHIC)){
             ast_type_t subject_type = ast_type_unwrapped_view(&func->arg_types[0]);
@@ -122,7 +132,7 @@ errorcode_t ir_gen_vtables(compiler_t *compiler, object_t *object){
         // generating the function bodies for the instantiated overrides
         recent_jobs.length = 0;
 
-        length_t start_ast_func_i = ast->funcs_length;
+        length_t start_ast_func_i = ast->funcs.length;
 
         // Instantiate new function bodies
         if(ir_gen_functions_body(compiler, object, &recent_jobs)){
@@ -138,7 +148,7 @@ errorcode_t ir_gen_vtables(compiler_t *compiler, object_t *object){
         // Create list of virtual additions (process may include creating new vtrees)
         for(length_t i = 0; i != recent_jobs.length; i++){
             ir_func_endpoint_t endpoint = recent_jobs.jobs[i];
-            ast_func_t *func = &ast->funcs[endpoint.ast_func_id];
+            ast_func_t *func = ast_funcs_at(&ast->funcs, endpoint.ast_func_id);
 
             if(ast_func_is_method(func) && func->traits & AST_FUNC_VIRTUAL && endpoint.ir_func_id != INVALID_FUNC_ID){
                 ast_type_t subject_type = ast_type_unwrapped_view(&func->arg_types[0]);
@@ -153,8 +163,8 @@ errorcode_t ir_gen_vtables(compiler_t *compiler, object_t *object){
         }
 
         // Grab all new concrete classes by looking over new AST functions for any new concrete class constructors
-        for(length_t i = start_ast_func_i; i != ast->funcs_length; i++){
-            ast_func_t *func = &ast->funcs[i];
+        for(length_t i = start_ast_func_i; i != ast->funcs.length; i++){
+            ast_func_t *func = ast_funcs_at(&ast->funcs, i);
 
             if(func->traits & AST_FUNC_CLASS_CONSTRUCTOR && !(func->traits & AST_FUNC_POLYMORPHIC)){
                 ast_type_t subject_type = ast_type_unwrapped_view(&func->arg_types[0]);
@@ -197,7 +207,9 @@ errorcode_t ir_gen_vtables(compiler_t *compiler, object_t *object){
             ir_value_t **ir_vtable_entries = ir_pool_alloc(&module->pool, sizeof(ir_value_t*) * vtree->table.length);
 
             for(length_t j = 0; j != vtree->table.length; j++){
-                ir_vtable_entries[j] = build_func_addr(&module->pool, module->common.ir_ptr, vtree->table.endpoints[j].ir_func_id);
+                func_id_t endpoint_ir_func_id = vtree->table.endpoints[j].ir_func_id;
+                ir_vtable_entries[j] = build_func_addr(&module->pool, module->common.ir_ptr, endpoint_ir_func_id);
+                ir_funcs_at(&module->funcs, endpoint_ir_func_id)->traits |= IR_FUNC_ADDRESS_TAKEN;
             }
 
             ir_value_t *vtable = build_array_literal(&module->pool, module->common.ir_ptr, ir_vtable_entries, vtree->table.length);
@@ -226,38 +238,53 @@ errorcode_t ir_gen_vtables(compiler_t *compiler, object_t *object){
     }
 
     // Inject vtable indices for each virtual dispatcher
-    for(length_t i = 0; i != vtree_list.length; i++){
-        vtree_t *vtree = vtree_list.vtrees[i];
-
-        for(length_t j = 0; j != vtree->virtuals.length; j++){
-            ir_func_endpoint_t endpoint = vtree->virtuals.endpoints[j];
-
-            ast_func_t *func = &ast->funcs[endpoint.ast_func_id];
+    // NOTE: Each instantiation of a dispatcher (one per receiver type) has its own index placeholder
+    for(length_t i = 0; i != module->vtable_dispatch_list.length; i++){
+        ir_vtable_dispatch_t *dispatch = &module->vtable_dispatch_list.dispatches[i];
+        ast_func_t *dispatcher = ast_funcs_at(&ast->funcs, dispatch->ast_func_id);
+
+        length_t index;
+        if(vtree_list_find_virtual(&vtree_list, dispatcher->virtual_origin, &index) == NULL) continue;
+
+        *((adept_usize*) dispatch->index_value->extra) = index;
+
+        // Devirtualize dispatchers whose receiver type and all of its descendants use the same implementation.
+        // Since every class in the program is known by now, the dispatch will always end up calling that implementation
+        ast_type_t receiver_type = ast_type_unwrapped_view(&dispatcher->arg_types[0]);
+        vtree_t *receiver = vtree_list_find(&vtree_list, &receiver_type);
+        func_id_t target_ir_func_id;
+
+        if(receiver && vtree_sole_target(receiver, index, &target_ir_func_id)){
+            ir_instr_call_address_t *call_instr = dispatch->call_instr;
+            ir_value_t *target = build_func_addr(&module->pool, module->common.ir_ptr, target_ir_func_id);
+
+            // Call the implementation directly instead of looking it up in the vtable,
+            // the vtable lookup is left unused and will be removed along with other dead instructions
+            call_instr->function_address = build_const_bitcast(&module->pool, target, call_instr->function_address->type);
+            ir_funcs_at(&module->funcs, dispatch->ir_func_id)->traits |= IR_FUNC_DEVIRTUALIZED;
+        }
+    }
 
-            length_t parent_table_size = vtree->parent ? vtree->parent->table.length : 0;
-            length_t index = parent_table_size + j;
+    // Count the number of call sites that no longer require virtual dispatch
+    for(length_t i = 0; i != module->funcs.length; i++){
+        ir_basicblocks_t *basicblocks = &ir_funcs_at(&module->funcs, i)->basicblocks;
 
-            // Linear search for corresponding index
-            ir_value_t *index_value = NULL;
+        for(length_t b = 0; b != basicblocks->length; b++){
+            ir_instrs_t *instructions = &basicblocks->blocks[b].instructions;
 
-            for(length_t k = 0; k != module->vtable_dispatch_list.length; k++){
-                ir_vtable_dispatch_t *dispatch = &module->vtable_dispatch_list.dispatches[k];
+            for(length_t j = 0; j != instructions->length; j++){
+                ir_instr_t *instr = instructions->instructions[j];
 
-                if(dispatch->ast_func_id == func->virtual_dispatcher){
-                    index_value = dispatch->index_value;
-                    break;
+                if(instr->id == INSTRUCTION_CALL && ir_funcs_at(&module->funcs, ((ir_instr_call_t*) instr)->ir_func_id)->traits & IR_FUNC_DEVIRTUALIZED){
+                    module->devirtualized_calls++;
                 }
             }
-
-            if(index_value != NULL){
-                *((adept_usize*) index_value->extra) = index;
-            }
         }
     }
 
     // Don't allow unused concrete method overrides
-    for(length_t i = 0; i != ast->funcs_length; i++){
-        ast_func_t *func = &ast->funcs[i];
+    for(length_t i = 0; i != ast->funcs.length; i++){
+        ast_func_t *func = ast_funcs_at(&ast->funcs, i);
 
         if(func->traits & AST_FUNC_OVERRIDE && !(func->traits & AST_FUNC_POLYMORPHIC) && !(func->traits & AST_FUNC_USED_OVERRIDE)){
             compiler_panicf(compiler, func->source, "No corresponding virtual method exists to override");
@@ -282,7 +309,6 @@ errorcode_t ir_gen_functions(compiler_t *compiler, object_t *object){
 
     ast_t *ast = &object->ast;
     ir_module_t *ir_module = &object->ir_module;
-    ast_func_t **ast_funcs = &ast->funcs;
     ast_func_alias_t **ast_func_aliases = &ast->func_aliases;
 
     // Setup IR variadic array type if it exists
@@ -294,8 +320,8 @@ errorcode_t ir_gen_functions(compiler_t *compiler, object_t *object){
     }
 
     // Generate function skeletons
-    for(length_t ast_func_id = 0; ast_func_id != ast->funcs_length; ast_func_id++){
-        ast_func_t *ast_func = &(*ast_funcs)[ast_func_id];
+    for(length_t ast_func_id = 0; ast_func_id != ast->funcs.length; ast_func_id++){
+        ast_func_t *ast_func = ast_funcs_at(&ast->funcs, ast_func_id);
 
         if(ast_func->traits & AST_FUNC_POLYMORPHIC){
             ir_func_endpoint_t endpoint = (ir_func_endpoint_t){
@@ -374,18 +400,20 @@ errorcode_t ir_gen_functions(compiler_t *compiler, object_t *object){
 errorcode_t ir_gen_func_template(compiler_t *compiler, object_t *object, weak_cstr_t name, source_t from_source, func_id_t *out_ir_func_id){
     ir_module_t *module = &object->ir_module;
 
+    // New functions can't be created speculatively
+    if(ir_speculation_give_up(module->speculation)) return FAILURE;
+
     if(module->funcs.length >= MAX_FUNC_ID){
         compiler_panic(compiler, from_source, "Maximum number of IR functions reached\n");
         return FAILURE;
     }
 
-    expand((void**) &module->funcs, sizeof(ir_func_t), module->funcs.length, &module->funcs.capacity, 1, object->ast.funcs_length);
-    ir_func_t *module_func = &module->funcs.funcs[module->funcs.length];
-
-    *out_ir_func_id = module->funcs.length++;
+    ir_func_t *module_func = chunked_list_append_new(&module->funcs, ir_func_t);
+    *out_ir_func_id = module->funcs.length - 1;
 
     memset(module_func, 0, sizeof *module_func);
     module_func->name = name;
+    module_func->ast_func_id = INVALID_FUNC_ID;
     module_func->maybe_line_number = -1;
     module_func->maybe_column_number = -1;
     return SUCCESS;
@@ -398,7 +426,7 @@ errorcode_t ir_gen_func_head(compiler_t *compiler, object_t *object, ast_func_t
     if(ir_gen_func_template(compiler, object, ast_func->name, ast_func->source, &ir_func_id)) return FAILURE;
 
     ir_module_t *module = &object->ir_module;
-    ir_func_t *module_func = &module->funcs.funcs[ir_func_id];
+    ir_func_t *module_func = ir_funcs_at(&module->funcs, ir_func_id);
 
     module_func->export_as = ast_func->export_as;
     module_func->argument_types = malloc(sizeof(ir_type_t*) * (ast_func->traits & AST_FUNC_VARIADIC ? ast_func->arity + 1 : ast_func->arity));
@@ -434,12 +462,38 @@ errorcode_t ir_gen_func_head(compiler_t *compiler, object_t *object, ast_func_t
     if(ast_func->traits & AST_FUNC_INIT)   module_func->traits |= IR_FUNC_INIT;
     if(ast_func->traits & AST_FUNC_DEINIT) module_func->traits |= IR_FUNC_DEINIT;
 
+    if(ast_func->traits & AST_FUNC_ALWAYS_INLINE) module_func->traits |= IR_FUNC_ALWAYS_INLINE;
+    if(ast_func->traits & AST_FUNC_NO_INLINE)     module_func->traits |= IR_FUNC_NO_INLINE;
+    if(ast_func->traits & AST_FUNC_HOT)           module_func->traits |= IR_FUNC_HOT;
+    if(ast_func->traits & AST_FUNC_COLD)          module_func->traits |= IR_FUNC_COLD;
+    if(ast_func->traits & AST_FUNC_FLATTEN)       module_func->traits |= IR_FUNC_FLATTEN;
+
+    if(ast_func_is_generator(ast_func)) module_func->traits |= IR_FUNC_COROUTINE;
+
+    switch(ast_func->traits & AST_FUNC_OPTIMIZE_MASK){
+    case AST_FUNC_OPTIMIZE_NONE:       module_func->traits |= IR_FUNC_OPTIMIZE_NONE;       break;
+    case AST_FUNC_OPTIMIZE_SIZE:       module_func->traits |= IR_FUNC_OPTIMIZE_SIZE;       break;
+    case AST_FUNC_OPTIMIZE_AGGRESSIVE: module_func->traits |= IR_FUNC_OPTIMIZE_AGGRESSIVE; break;
+    }
+
+    module_func->ast_func_id = ast_func_id;
+
     ir_func_endpoint_t new_endpoint = (ir_func_endpoint_t){
         .ast_func_id = ast_func_id,
         .ir_func_id = ir_func_id,
     };
+
+    // When compiling lazily, only functions that are roots of reachability get
+    // their bodies generated up front, the rest are generated once referenced
+    bool is_reachability_root = !(compiler->traits & COMPILER_LAZY)
+        || ast_func->export_as != NULL
+        || ast_func->traits & (AST_FUNC_MAIN | AST_FUNC_INIT | AST_FUNC_DEINIT | AST_FUNC_VIRTUAL | AST_FUNC_OVERRIDE | AST_FUNC_DISPATCHER);
+
+    if(!is_reachability_root){
+        module_func->traits |= IR_FUNC_UNREFERENCED;
+    }
     
-    ir_module_create_func_mapping(module, ast_func->name, new_endpoint, true);
+    ir_module_create_func_mapping(module, ast_func->name, new_endpoint, is_reachability_root);
 
     if(optional_out_new_endpoint){
         *optional_out_new_endpoint = new_endpoint;
@@ -514,7 +568,7 @@ errorcode_t ir_gen_func_head(compiler_t *compiler, object_t *object, ast_func_t
 
     if(ast_func->traits & AST_FUNC_MAIN){
         if(module->common.has_init){
-            source_t source = object->ast.funcs[module->common.ast_init_id].source;
+            source_t source = ast_funcs_at(&object->ast.funcs, module->common.ast_init_id)->source;
             compiler_panic(compiler, ast_func->source, "Cannot define main function when one already exists");
             compiler_panic(compiler, source, "Original main function defined here");
             return FAILURE;
@@ -530,7 +584,7 @@ errorcode_t ir_gen_func_head(compiler_t *compiler, object_t *object, ast_func_t
 
     if(ast_func->traits & AST_FUNC_INIT){
         if(module->common.has_init){
-            source_t source = object->ast.funcs[module->common.ast_init_id].source;
+            source_t source = ast_funcs_at(&object->ast.funcs, module->common.ast_init_id)->source;
             compiler_panic(compiler, ast_func->source, "Cannot define shared library init function when one already exists");
             compiler_panic(compiler, source, "Original init function defined here");
             return FAILURE;
@@ -543,7 +597,7 @@ errorcode_t ir_gen_func_head(compiler_t *compiler, object_t *object, ast_func_t
 
     if(ast_func->traits & AST_FUNC_DEINIT){
         if(module->common.has_deinit){
-            source_t source = object->ast.funcs[module->common.ast_init_id].source;
+            source_t source = ast_funcs_at(&object->ast.funcs, module->common.ast_init_id)->source;
             compiler_panic(compiler, ast_func->source, "Cannot define shared library deinit function when one already exists");
             compiler_panic(compiler, source, "Original deinit function defined here");
             return FAILURE;
@@ -579,16 +633,33 @@ errorcode_t ir_gen_auxiliary_builders(compiler_t *compiler, object_t *object){
 errorcode_t ir_gen_functions_body(compiler_t *compiler, object_t *object, ir_job_list_t *optional_out_completed_jobs){
     // NOTE: Only ir_gens function body; assumes skeleton already exists
 
-    ast_func_t **ast_funcs = &object->ast.funcs;
+    // NOTE: Jobs are committed one at a time in order on the calling thread.
+    // Generating a body can instantiate polymorphic functions and create autogen functions,
+    // which grows 'ast.funcs', 'ir_module.funcs', 'func_map' and the special function cache.
+    // So bodies are first generated speculatively in batches on multiple threads,
+    // and any speculation that would have changed those (or was affected by such a change)
+    // is generated again here instead, which keeps the output the same as doing it serially.
+
     ir_job_list_t *job_list = &object->ir_module.job_list;
+    ir_speculation_batch_t batch = {0};
+    bool speculate = !(compiler->traits & COMPILER_LAZY);
 
     while(job_list->length != 0){
-        ir_func_endpoint_t job = job_list->jobs[--job_list->length];
-        trait_t traits = (*ast_funcs)[job.ast_func_id].traits;
+        if(speculate && batch.remaining == 0){
+            speculate = ir_speculation_batch_run(&batch, compiler, object);
+        }
+
+        length_t index = --job_list->length;
+        ir_func_endpoint_t job = job_list->jobs[index];
+        ir_speculation_t *speculation = ir_speculation_batch_take(&batch, index);
+        trait_t traits = ast_funcs_at(&object->ast.funcs, job.ast_func_id)->traits;
 
         if(traits & AST_FUNC_FOREIGN) continue;
 
-        if(ir_gen_functions_body_statements(compiler, object, job.ast_func_id, job.ir_func_id)){
+        bool committed = speculation != NULL && ir_speculation_commit(&batch, speculation, compiler, object);
+
+        if(!committed && ir_gen_functions_body_statements(compiler, object, job.ast_func_id, job.ir_func_id)){
+            ir_speculation_batch_free(&batch, &object->ir_module);
             return FAILURE;
         }
 
@@ -596,32 +667,32 @@ errorcode_t ir_gen_functions_body(compiler_t *compiler, object_t *object, ir_job
             ir_job_list_append(optional_out_completed_jobs, job);
         }
     }
-    
+
+    ir_speculation_batch_free(&batch, &object->ir_module);
     return SUCCESS;
 }
 
 errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *object, func_id_t ast_func_id, func_id_t ir_func_id){
     // Generates IR instructions from AST statements and then stores them in the IR function with the ID 'ir_func_id' as groups of basicblocks
 
-    // Since the location of the AST function may shift around
-    // during this procedure, we will read/write to a local copy
-    ast_func_t ast_func = object->ast.funcs[ast_func_id];
-    
-    // We also won't retain a pointer to the actual IR function
-    // we are working with, since that too may shift around.
-    // Instead we'll retain a reference to its container
-    ir_funcs_t *ir_funcs = &object->ir_module.funcs;
+    // Infer the function body if its inference was deferred
+    if(infer_func_body_on_demand(compiler, object, ast_func_id)) return FAILURE;
+
+    // NOTE: AST and IR functions never move once created, so these pointers
+    // stay valid even when generating the body creates more functions
+    ast_func_t *ast_func = ast_funcs_at(&object->ast.funcs, ast_func_id);
+    ir_func_t *ir_func = ir_funcs_at(&object->ir_module.funcs, ir_func_id);
     
-    bool is_init_like = ast_func.traits & AST_FUNC_MAIN || ast_func.traits & AST_FUNC_WINMAIN || ast_func.traits & AST_FUNC_INIT;
-    bool is_deinit_like = ast_func.traits & AST_FUNC_MAIN || ast_func.traits & AST_FUNC_WINMAIN || ast_func.traits & AST_FUNC_DEINIT;
+    bool is_init_like = ast_func->traits & AST_FUNC_MAIN || ast_func->traits & AST_FUNC_WINMAIN || ast_func->traits & AST_FUNC_INIT;
+    bool is_deinit_like = ast_func->traits & AST_FUNC_MAIN || ast_func->traits & AST_FUNC_WINMAIN || ast_func->traits & AST_FUNC_DEINIT;
 
-    bool show_is_empty_warning = ast_func.statements.length == 0
-                              && !(ast_func.traits & AST_FUNC_GENERATED)
-                              && !(ast_func.traits & AST_FUNC_CLASS_CONSTRUCTOR)
+    bool show_is_empty_warning = ast_func->statements.length == 0
+                              && !(ast_func->traits & AST_FUNC_GENERATED)
+                              && !(ast_func->traits & AST_FUNC_CLASS_CONSTRUCTOR)
                               && compiler->traits & COMPILER_FUSSY;
 
     if(show_is_empty_warning){
-        if(compiler_warnf(compiler, ast_func.source, "Function '%s' is empty", ast_func.name)){
+        if(compiler_warnf(compiler, ast_func->source, "Function '%s' is empty", ast_func->name)){
             return FAILURE;
         }
     }
@@ -632,28 +703,28 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
     ir_builder_t builder;
     ir_builder_init(&builder, compiler, object, ast_func_id, ir_func_id, false);
 
-    for(length_t i = 0; i != ast_func.arity; i++){
+    for(length_t i = 0; i != ast_func->arity; i++){
         trait_t arg_traits = BRIDGE_VAR_UNDEF;
 
-        if(ast_func.arg_type_traits[i] & AST_FUNC_ARG_TYPE_TRAIT_POD){
+        if(ast_func->arg_type_traits[i] & AST_FUNC_ARG_TYPE_TRAIT_POD){
             arg_traits |= BRIDGE_VAR_POD;
         }
 
-        ir_builder_add_variable(&builder, ast_func.arg_names[i], &ast_func.arg_types[i], ir_funcs->funcs[ir_func_id].argument_types[i], arg_traits);
+        ir_builder_add_variable(&builder, ast_func->arg_names[i], &ast_func->arg_types[i], ir_func->argument_types[i], arg_traits);
     }
 
     // Append variadic array argument for variadic functions
-    if(ast_func.traits & AST_FUNC_VARIADIC){
+    if(ast_func->traits & AST_FUNC_VARIADIC){
         // AST variadic type is already guaranteed to exist
-        ir_builder_add_variable(&builder, ast_func.variadic_arg_name, object->ast.common.ast_variadic_array, object->ir_module.common.ir_variadic_array, TRAIT_NONE);
+        ir_builder_add_variable(&builder, ast_func->variadic_arg_name, object->ast.common.ast_variadic_array, object->ir_module.common.ir_variadic_array, TRAIT_NONE);
     }
 
     // Initialize all global variables
     if(is_init_like && ir_gen_globals_init(&builder)) goto failure;
 
     // Create vtable initialization instruction for this function if it's a class constructor
-    if(ast_func.traits & AST_FUNC_CLASS_CONSTRUCTOR){
-        ast_type_t subject_type = ast_type_dereferenced_view(&ast_func.arg_types[0]);
+    if(ast_func->traits & AST_FUNC_CLASS_CONSTRUCTOR){
+        ast_type_t subject_type = ast_type_dereferenced_view(&ast_func->arg_types[0]);
         
         // Find 'this' argument
         bridge_var_t *bridge_var = bridge_scope_find_var(builder.scope, "this");
@@ -663,17 +734,17 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
         ir_value_t *this_value = build_load(
             &builder, 
             build_varptr(&builder, ir_type_make_pointer_to(builder.pool, bridge_var->ir_type), bridge_var),
-            ast_func.source
+            ast_func->source
         );
 
         // Create 'this.__vtable__' value
         ir_type_t *ir_ptr = builder.object->ir_module.common.ir_ptr;
         ir_type_t *ir_ptr_ptr = ir_type_make_pointer_to(builder.pool, ir_ptr);
-        ir_value_t *destination = build_member(&builder, this_value, /*index of __vtable__ field*/ 0, ir_ptr_ptr, ast_func.source);
+        ir_value_t *destination = build_member(&builder, this_value, /*index of __vtable__ field*/ 0, ir_ptr_ptr, ast_func->source);
 
         // Create placeholder store instruction,
         // The value to be stored will be filled in later during vtable resolution
-        ir_instr_store_t *store_instr = build_store(&builder, NULL, destination, ast_func.source);
+        ir_instr_store_t *store_instr = build_store(&builder, NULL, destination, ast_func->source);
 
         // Get persistent pointer to the dummy store instruction
         assert(store_instr->id == INSTRUCTION_STORE);
@@ -685,7 +756,7 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
         }));
     }
 
-    if(ast_func.traits & AST_FUNC_DISPATCHER){
+    if(ast_func->traits & AST_FUNC_DISPATCHER){
         // Find 'this' argument
         bridge_var_t *bridge_var = bridge_scope_find_var(builder.scope, "this");
         assert(bridge_var);
@@ -694,17 +765,17 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
         ir_value_t *this_value = build_load(
             &builder,
             build_varptr(&builder, ir_type_make_pointer_to(builder.pool, bridge_var->ir_type), bridge_var),
-            ast_func.source
+            ast_func->source
         );
 
         // Create 'this.__vtable__' value
         ir_type_t *ir_ptr = builder.object->ir_module.common.ir_ptr;
         ir_type_t *ir_ptr_ptr = ir_type_make_pointer_to(builder.pool, ir_ptr);
-        ir_value_t *vtable = build_load(&builder, build_member(&builder, this_value, /*index of __vtable__ field*/ 0, ir_ptr_ptr, ast_func.source), NULL_SOURCE);
+        ir_value_t *vtable = build_load(&builder, build_member(&builder, this_value, /*index of __vtable__ field*/ 0, ir_ptr_ptr, ast_func->source), NULL_SOURCE);
 
         ir_value_t *table = build_bitcast(&builder, vtable, ir_type_make_pointer_to(builder.pool, object->ir_module.common.ir_ptr));
 
-        ir_value_t *index = build_literal_usize(builder.pool, 0);
+        ir_value_t *index = build_placeholder_usize(builder.pool); // Will be filled in during vtable resolution
         ir_value_t *raw_function_pointer = build_load(&builder, build_array_access(&builder, table, index, NULL_SOURCE), NULL_SOURCE);
 
         ir_type_t *function_pointer_type = ir_type_make_function_pointer(builder.pool);
@@ -715,12 +786,10 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
         bool is_vararg;
 
         {
-            ir_func_t *ir_func = &builder.object->ir_module.funcs.funcs[ir_func_id];
-
             result_type = ir_func->return_type;
             arity = ir_func->arity;
             param_types = ir_func->argument_types;
-            is_vararg = ast_func.traits & AST_FUNC_VARARG;
+            is_vararg = ast_func->traits & AST_FUNC_VARARG;
 
             arg_values = ir_pool_alloc(builder.pool, sizeof(ir_type_t*) * arity);
 
@@ -732,11 +801,17 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
         ir_value_t *function_pointer = build_bitcast(&builder, raw_function_pointer, function_pointer_type);
         ir_value_t *result = build_call_address(&builder, result_type, function_pointer, arg_values, arity, param_types, arity, is_vararg);
 
+        // Get persistent pointer to the call instruction, so it can be redirected during devirtualization
+        ir_instr_call_address_t *call_instr = (ir_instr_call_address_t*) ir_instrs_last_unchecked(&builder.current_block->instructions);
+        assert(call_instr->id == INSTRUCTION_CALL_ADDRESS);
+
         build_return(&builder, result_type->kind != TYPE_KIND_VOID ? result : NULL);
 
         ir_vtable_dispatch_t dispatch = (ir_vtable_dispatch_t){
             .ast_func_id = ast_func_id,
+            .ir_func_id = ir_func_id,
             .index_value = index,
+            .call_instr = call_instr,
         };
 
         ir_vtable_dispatch_list_append(&builder.object->ir_module.vtable_dispatch_list, dispatch);
@@ -744,7 +819,7 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
     }
 
     bool terminated;
-    if(ir_gen_stmts(&builder, &ast_func.statements, &terminated)) goto failure;
+    if(ir_gen_stmts(&builder, &ast_func->statements, &terminated)) goto failure;
     if(terminated) goto success;
 
     handle_deference_for_variables(&builder, &builder.scope->list);
@@ -753,13 +828,13 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
         build_global_cleanup(&builder);
     }
 
-    if(ast_func.traits & AST_FUNC_AUTOGEN){
+    if(ast_func->traits & AST_FUNC_AUTOGEN){
         // Auto-generate part of function if requested
 
-        if(ast_func.traits & AST_FUNC_DEFER){
+        if(ast_func->traits & AST_FUNC_DEFER){
             if(handle_children_deference(&builder)) goto failure;
         }
-        else if(ast_func.traits & AST_FUNC_PASS){
+        else if(ast_func->traits & AST_FUNC_PASS){
             if(handle_children_pass_root(&builder, false)) goto failure;
             terminated = true;
         }
@@ -768,35 +843,35 @@ errorcode_t ir_gen_functions_body_statements(compiler_t *compiler, object_t *obj
     // TODO: CLEANUP: Clean this up
     // NOTE: We have to recheck if the function was terminated because of 'handle_children_pass_root(&builder)'
     if(!terminated){
-        ir_type_t *ir_return_type = ir_funcs->funcs[ir_func_id].return_type;
+        ir_type_t *ir_return_type = ir_func->return_type;
 
         // Handle auto-return
-        if(ir_return_type->kind == TYPE_KIND_VOID){
+        // NOTE: Generators finish by returning nothing, their handle is returned by the backend
+        if(ir_return_type->kind == TYPE_KIND_VOID || ir_func->traits & IR_FUNC_COROUTINE){
             build_return(&builder, NULL);
-        } else if(ast_func.traits & AST_FUNC_MAIN
+        } else if(ast_func->traits & AST_FUNC_MAIN
                 && ir_return_type->kind == TYPE_KIND_S32
-                && ast_type_is_void(&ast_func.return_type)){
+                && ast_type_is_void(&ast_func->return_type)){
             // Return an int under the hood for 'func main() void'
             build_return(&builder, build_literal_int(builder.pool, 0));
         } else if(!ast_func_end_is_reachable(&object->ast, ast_func_id)){
             build_unreachable(&builder);
         } else {
-            source_t where = ast_func.return_type.source;
-            strong_cstr_t return_typename = ast_type_str(&ast_func.return_type);
-            compiler_panicf(compiler, where, "Must return a value of type '%s' before exiting function '%s'", return_typename, ast_func.name);
+            source_t where = ast_func->return_type.source;
+            strong_cstr_t return_typename = ast_type_str(&ast_func->return_type);
+            compiler_panicf(compiler, where, "Must return a value of type '%s' before exiting function '%s'", return_typename, ast_func->name);
             free(return_typename);
             goto failure;
         }
     }
 
 success:
-    ir_funcs->funcs[ir_func_id].scope->following_var_id = builder.next_var_id;
-    ir_funcs->funcs[ir_func_id].variable_count = builder.next_var_id;
+    ir_func->scope->following_var_id = builder.next_var_id;
+    ir_func->variable_count = builder.next_var_id;
     errorcode = SUCCESS;
 
 failure:
-    ir_funcs->funcs[ir_func_id].basicblocks = builder.basicblocks;
-    object->ast.funcs[ast_func_id] = ast_func;
+    ir_func->basicblocks = builder.basicblocks;
     free(builder.block_stack.blocks);
     return errorcode;
 }
@@ -820,6 +895,7 @@ errorcode_t ir_gen_globals(compiler_t *compiler, object_t *object){
         module->globals[i] = (ir_global_t){
             .name = ast_global->name,
             .traits = traits,
+            .alignment = ast_global->alignment,
             .trusted_static_initializer = NULL,
             .type = ir_type,
         };
@@ -842,6 +918,10 @@ errorcode_t ir_gen_globals_init(ir_builder_t *builder){
         ir_value_t *value;
         ast_type_t value_ast_type;
 
+        // Remember where we are, so we can tell whether the initial value required any instructions
+        length_t block_id = builder->current_block_id;
+        length_t instructions_length = builder->current_block->instructions.length;
+
         if(ir_gen_expr(builder, ast_global->initial, &value, false, &value_ast_type)) return FAILURE;
 
         if(!ast_types_conform(builder, &value, &value_ast_type, &ast_global->type, CONFORM_MODE_ASSIGNING)){
@@ -856,14 +936,27 @@ errorcode_t ir_gen_globals_init(ir_builder_t *builder){
 
         ast_type_free(&value_ast_type);
 
-        ir_type_t *ptr_to_type = ir_type_make_pointer_to(builder->pool, builder->object->ir_module.globals[g].type);
+        ir_global_t *ir_global = &builder->object->ir_module.globals[g];
+
+        bool is_static = !(ir_global->traits & IR_GLOBAL_EXTERNAL)
+                      && block_id == builder->current_block_id
+                      && instructions_length == builder->current_block->instructions.length
+                      && ir_value_is_static_initializer(value);
+
+        if(is_static){
+            // Initial values known at compile-time are stored in the global variable itself
+            ir_global->trusted_static_initializer = value;
+            continue;
+        }
+
+        ir_type_t *ptr_to_type = ir_type_make_pointer_to(builder->pool, ir_global->type);
         ir_value_t *destination = build_gvarptr(builder, ptr_to_type, g);
         build_store(builder, value, destination, ast_global->source);
     }
     return SUCCESS;
 }
 
-errorcode_t ir_gen_build_rtti_table(object_t *object){
+errorcode_t ir_gen_build_rtti_table(compiler_t *compiler, object_t *object){
     ir_module_t *ir_module = &object->ir_module;
 
     rtti_collector_t rtti_collector = *ir_module->rtti_collector;
@@ -871,6 +964,12 @@ errorcode_t ir_gen_build_rtti_table(object_t *object){
 
     ir_module->rtti_table = ir_pool_alloc(&ir_module->pool, sizeof(rtti_table_t));
     *ir_module->rtti_table = rtti_table_create(rtti_collector, &object->ast);
+
+    // The whole table must be kept if user code can iterate over it
+    if(compiler->traits & COMPILER_STRIP_TYPEINFO && !(compiler->traits & COMPILER_NO_TYPEINFO) && !ir_module->rtti_table_referenced){
+        return ir_gen__types__strip_unreachable(compiler, object);
+    }
+
     return SUCCESS;
 }
 
@@ -1066,7 +1165,7 @@ errorcode_t ir_gen_do_builtin_warn_bad_printf_format(ir_builder_t *builder, func
     // Find index of 'format' argument
     maybe_index_t format_index = -1;
 
-    ast_func_t *ast_func = &builder->object->ast.funcs[pair.ast_func_id];
+    ast_func_t *ast_func = ast_funcs_at(&builder->object->ast.funcs, pair.ast_func_id);
 
     for(length_t name_index = 0; name_index != ast_func->arity; name_index++){
         if(streq(ast_func->arg_names[name_index], "format")){
@@ -1087,7 +1186,7 @@ errorcode_t ir_gen_do_builtin_warn_bad_printf_format(ir_builder_t *builder, func
 
     // Undo __pass__ call
     if(ir_values[format_index]->value_type != VALUE_TYPE_RESULT) return SUCCESS;
-    ir_value_result_t *pass_result = (ir_value_result_t*) ir_values[format_index]->extra;
+    ir_value_result_t *pass_result = &ir_values[format_index]->result;
     
     // Undo result value to get call instruction
     ir_instr_call_t *call_instr = (ir_instr_call_t*) builder->basicblocks.blocks[pass_result->block_id].instructions.instructions[pass_result->instruction_id];
@@ -1145,7 +1244,7 @@ errorcode_t ir_gen_do_builtin_warn_bad_printf_format(ir_builder_t *builder, func
             return FAILURE;
         }
 
-        ast_func_t *ast_func = &builder->object->ast.funcs[pair.ast_func_id];
+        ast_func_t *ast_func = ast_funcs_at(&builder->object->ast.funcs, pair.ast_func_id);
         ast_type_t *given_type = &ast_types[ast_func->arity + substitutions_gotten++];
         weak_cstr_t target = NULL;
 
@@ -1268,15 +1367,15 @@ void bad_printf_format(compiler_t *compiler, source_t source, ast_type_t *given_
     if(specifier == 'z') additional_part = "u";
 
     compiler_panicf(compiler, source, "Got value of incorrect type for format specifier '%%%s%c%s'", modifiers, specifier, additional_part);
-    printf("\n");
+    compiler_hintf(compiler, "\n");
 
     strong_cstr_t incorrect_type = ast_type_str(given_type);
-    printf("    Expected value of type '%s', got value of type '%s'\n", expected, incorrect_type);
-    printf("    For %d%s variadic argument\n", variadic_argument_number, get_numeric_ending(variadic_argument_number));
+    compiler_hintf(compiler, "    Expected value of type '%s', got value of type '%s'\n", expected, incorrect_type);
+    compiler_hintf(compiler, "    For %d%s variadic argument\n", variadic_argument_number, get_numeric_ending(variadic_argument_number));
     free(incorrect_type);
     
     if(is_semimatch){
-        printf("    Support for this type mismatch requires runtime type information\n");
+        compiler_hintf(compiler, "    Support for this type mismatch requires runtime type information\n");
     }
 }
 
@@ -0,0 +1,282 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "AST/TYPE/ast_type_identical.h"
+#include "AST/ast_expr.h"
+#include "AST/ast_type.h"
+#include "AST/ast_type_lean.h"
+#include "DRVR/compiler.h"
+#include "IR/ir.h"
+#include "IR/ir_fold.h"
+#include "IR/ir_type.h"
+#include "IR/ir_type_map.h"
+#include "IR/ir_value.h"
+#include "IRGEN/ir_build_instr.h"
+#include "IRGEN/ir_builder.h"
+#include "IRGEN/ir_gen_atomic.h"
+#include "IRGEN/ir_gen_expr.h"
+#include "IRGEN/ir_gen_type.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+#include "UTIL/trait.h"
+
+enum ir_gen_atomic_kind {
+    IR_GEN_ATOMIC_LOAD,
+    IR_GEN_ATOMIC_STORE,
+    IR_GEN_ATOMIC_EXCHANGE,
+    IR_GEN_ATOMIC_COMPARE_EXCHANGE,
+    IR_GEN_ATOMIC_FETCH,
+    IR_GEN_ATOMIC_FENCE,
+};
+
+// Classes of types that atomic operations can be used on
+#define IR_GEN_ATOMIC_INTEGER TRAIT_1
+#define IR_GEN_ATOMIC_FLOAT   TRAIT_2
+#define IR_GEN_ATOMIC_POINTER TRAIT_3
+
+typedef struct {
+    const char *name;
+    enum ir_gen_atomic_kind kind;
+    unsigned int expr_id; // Math expression used to combine values (only for fetch operations)
+    length_t operands;    // Number of arguments before the memory orderings
+    length_t orderings;   // Number of memory orderings that can follow
+    trait_t accepts;      // Classes of types that can be operated on
+} ir_gen_atomic_builtin_t;
+
+static const ir_gen_atomic_builtin_t *ir_gen_atomic_find(weak_cstr_t name){
+    #define ANY_VALUE (IR_GEN_ATOMIC_INTEGER | IR_GEN_ATOMIC_FLOAT | IR_GEN_ATOMIC_POINTER)
+
+    static const ir_gen_atomic_builtin_t builtins[] = {
+        {"atomic_compare_exchange", IR_GEN_ATOMIC_COMPARE_EXCHANGE, 0, 3, 2, IR_GEN_ATOMIC_INTEGER | IR_GEN_ATOMIC_POINTER},
+        {"atomic_exchange",         IR_GEN_ATOMIC_EXCHANGE,         0, 2, 1, ANY_VALUE},
+        {"atomic_fence",            IR_GEN_ATOMIC_FENCE,            0, 0, 1, TRAIT_NONE},
+        {"atomic_fetch_add",        IR_GEN_ATOMIC_FETCH, EXPR_ADD,      2, 1, IR_GEN_ATOMIC_INTEGER | IR_GEN_ATOMIC_FLOAT},
+        {"atomic_fetch_and",        IR_GEN_ATOMIC_FETCH, EXPR_BIT_AND,  2, 1, IR_GEN_ATOMIC_INTEGER},
+        {"atomic_fetch_max",        IR_GEN_ATOMIC_FETCH, EXPR_GREATER,  2, 1, IR_GEN_ATOMIC_INTEGER},
+        {"atomic_fetch_min",        IR_GEN_ATOMIC_FETCH, EXPR_LESSER,   2, 1, IR_GEN_ATOMIC_INTEGER},
+        {"atomic_fetch_or",         IR_GEN_ATOMIC_FETCH, EXPR_BIT_OR,   2, 1, IR_GEN_ATOMIC_INTEGER},
+        {"atomic_fetch_sub",        IR_GEN_ATOMIC_FETCH, EXPR_SUBTRACT, 2, 1, IR_GEN_ATOMIC_INTEGER | IR_GEN_ATOMIC_FLOAT},
+        {"atomic_fetch_xor",        IR_GEN_ATOMIC_FETCH, EXPR_BIT_XOR,  2, 1, IR_GEN_ATOMIC_INTEGER},
+        {"atomic_load",             IR_GEN_ATOMIC_LOAD,             0, 1, 1, ANY_VALUE},
+        {"atomic_store",            IR_GEN_ATOMIC_STORE,            0, 2, 1, ANY_VALUE},
+    };
+
+    #undef ANY_VALUE
+
+    for(length_t i = 0; i != NUM_ITEMS(builtins); i++){
+        if(streq(name, builtins[i].name)) return &builtins[i];
+    }
+
+    return NULL;
+}
+
+static trait_t ir_gen_atomic_type_class(ir_type_t *type){
+    switch(type->kind){
+    case TYPE_KIND_S8: case TYPE_KIND_S16: case TYPE_KIND_S32: case TYPE_KIND_S64:
+    case TYPE_KIND_U8: case TYPE_KIND_U16: case TYPE_KIND_U32: case TYPE_KIND_U64:
+        return IR_GEN_ATOMIC_INTEGER;
+    case TYPE_KIND_HALF: case TYPE_KIND_FLOAT: case TYPE_KIND_DOUBLE:
+        return IR_GEN_ATOMIC_FLOAT;
+    case TYPE_KIND_POINTER: case TYPE_KIND_FUNCPTR:
+        return IR_GEN_ATOMIC_POINTER;
+    default:
+        // Booleans aren't a whole number of bytes, and aggregates are too large
+        return TRAIT_NONE;
+    }
+}
+
+static bool ir_gen_atomic_ordering_allowed(enum ir_gen_atomic_kind kind, unsigned int ordering, bool is_failure_ordering){
+    switch(kind){
+    case IR_GEN_ATOMIC_LOAD:
+        return ordering != IR_ATOMIC_RELEASE && ordering != IR_ATOMIC_ACQ_REL;
+    case IR_GEN_ATOMIC_STORE:
+        return ordering == IR_ATOMIC_RELAXED || ordering == IR_ATOMIC_RELEASE || ordering == IR_ATOMIC_SEQ_CST;
+    case IR_GEN_ATOMIC_COMPARE_EXCHANGE:
+        // When nothing is written, the operation only reads
+        return !is_failure_ordering || (ordering != IR_ATOMIC_RELEASE && ordering != IR_ATOMIC_ACQ_REL);
+    case IR_GEN_ATOMIC_FENCE:
+        return ordering != IR_ATOMIC_RELAXED;
+    default:
+        return true;
+    }
+}
+
+static errorcode_t ir_gen_atomic_ordering(ir_builder_t *builder, ast_expr_call_t *expr, const ir_gen_atomic_builtin_t *builtin,
+        ir_value_t **arg_values, length_t index, unsigned int *out_ordering){
+
+    // Orderings that are left off are sequentially consistent
+    if(index >= expr->arity){
+        *out_ordering = IR_ATOMIC_SEQ_CST;
+        return SUCCESS;
+    }
+
+    ir_value_t *ordering = ir_fold_scalar_literal(builder->pool, arg_values[index]);
+    source_t source = expr->args[index]->source;
+
+    if(ordering == NULL || ordering->value_type != VALUE_TYPE_LITERAL || ir_type_get_category(ordering->type) == PRIMITIVE_FP){
+        compiler_panicf(builder->compiler, source, "Memory ordering for '%s' must be a constant integer", expr->name);
+        return FAILURE;
+    }
+
+    unsigned long long value = ir_value_uniqueness_value(builder->pool, &ordering);
+
+    if(value > IR_ATOMIC_SEQ_CST){
+        compiler_panicf(builder->compiler, source, "Memory ordering for '%s' must be between 0 and %d", expr->name, (int) IR_ATOMIC_SEQ_CST);
+        return FAILURE;
+    }
+
+    bool is_failure_ordering = index != builtin->operands;
+
+    if(!ir_gen_atomic_ordering_allowed(builtin->kind, value, is_failure_ordering)){
+        compiler_panicf(builder->compiler, source, "Cannot use memory ordering '%s' %sfor '%s'",
+                ir_atomic_ordering_name(value), is_failure_ordering ? "on failure " : "", expr->name);
+        return FAILURE;
+    }
+
+    *out_ordering = value;
+    return SUCCESS;
+}
+
+static errorcode_t ir_gen_atomic_operands(ir_builder_t *builder, ast_expr_call_t *expr, const ir_gen_atomic_builtin_t *builtin,
+        ir_value_t **arg_values, ast_type_t *arg_types, ast_type_t *out_element_type){
+
+    // The first operand points to the value operated on
+    if(!ast_type_is_pointer(&arg_types[0])){
+        strong_cstr_t given = ast_type_str(&arg_types[0]);
+        compiler_panicf(builder->compiler, expr->args[0]->source, "Builtin '%s' expects a pointer to the value to operate on, got '%s'", expr->name, given);
+        free(given);
+        return FAILURE;
+    }
+
+    ast_type_t element_type = ast_type_dereferenced_view(&arg_types[0]);
+    ir_type_t *ir_element_type = ir_type_dereference(arg_values[0]->type);
+
+    if(!(ir_gen_atomic_type_class(ir_element_type) & builtin->accepts)){
+        strong_cstr_t given = ast_type_str(&element_type);
+        compiler_panicf(builder->compiler, expr->source, "Builtin '%s' cannot be used on values of type '%s'", expr->name, given);
+        free(given);
+        return FAILURE;
+    }
+
+    for(length_t i = 1; i != builtin->operands; i++){
+        // The expected value of a compare-exchange is passed by pointer
+        if(builtin->kind == IR_GEN_ATOMIC_COMPARE_EXCHANGE && i == 1){
+            if(!ast_types_identical(&arg_types[0], &arg_types[1])){
+                strong_cstr_t expected = ast_type_str(&arg_types[0]);
+                strong_cstr_t given = ast_type_str(&arg_types[1]);
+                compiler_panicf(builder->compiler, expr->args[1]->source, "Argument 2 of '%s' must be of type '%s', got '%s'", expr->name, expected, given);
+                free(expected);
+                free(given);
+                return FAILURE;
+            }
+            continue;
+        }
+
+        if(!ast_types_conform(builder, &arg_values[i], &arg_types[i], &element_type, CONFORM_MODE_CALCULATION)){
+            strong_cstr_t expected = ast_type_str(&element_type);
+            strong_cstr_t given = ast_type_str(&arg_types[i]);
+            compiler_panicf(builder->compiler, expr->args[i]->source, "Argument %d of '%s' must be of type '%s', got '%s'",
+                    (int) (i + 1), expr->name, expected, given);
+            free(expected);
+            free(given);
+            return FAILURE;
+        }
+    }
+
+    *out_element_type = element_type;
+    return SUCCESS;
+}
+
+errorcode_t ir_gen_atomic_builtin(ir_builder_t *builder, ast_expr_call_t *expr, ir_value_t **arg_values,
+        ast_type_t *arg_types, ir_value_t **ir_value, ast_type_t *out_expr_type){
+
+    const ir_gen_atomic_builtin_t *builtin = ir_gen_atomic_find(expr->name);
+    if(builtin == NULL) return ALT_FAILURE;
+
+    if(expr->arity != builtin->operands && expr->arity != builtin->operands + builtin->orderings){
+        compiler_panicf(builder->compiler, expr->source, "Builtin '%s' expects %d argument%s, optionally followed by %d memory ordering%s, got %d",
+                expr->name, (int) builtin->operands, builtin->operands == 1 ? "" : "s",
+                (int) builtin->orderings, builtin->orderings == 1 ? "" : "s", (int) expr->arity);
+        return FAILURE;
+    }
+
+    unsigned int orderings[2];
+
+    for(length_t i = 0; i != builtin->orderings; i++){
+        if(ir_gen_atomic_ordering(builder, expr, builtin, arg_values, builtin->operands + i, &orderings[i])) return FAILURE;
+    }
+
+    ir_type_t *void_type;
+    if(!ir_type_map_find(builder->type_map, "void", &void_type)) return FAILURE;
+
+    if(builtin->kind == IR_GEN_ATOMIC_FENCE){
+        ir_value_t *result = build_fence(builder, void_type, orderings[0]);
+
+        if(ir_value) *ir_value = result;
+        if(out_expr_type) *out_expr_type = ast_type_make_base(strclone("void"));
+        return SUCCESS;
+    }
+
+    ast_type_t element_type;
+    if(ir_gen_atomic_operands(builder, expr, builtin, arg_values, arg_types, &element_type)) return FAILURE;
+
+    ir_value_t *pointer = arg_values[0];
+    ir_value_t *result = NULL;
+    ast_type_t result_type = AST_TYPE_NONE;
+
+    switch(builtin->kind){
+    case IR_GEN_ATOMIC_LOAD:
+        result = build_atomic_load(builder, pointer, orderings[0]);
+        result_type = ast_type_clone(&element_type);
+        break;
+    case IR_GEN_ATOMIC_STORE:
+        result = build_atomic_store(builder, void_type, arg_values[1], pointer, orderings[0]);
+        result_type = ast_type_make_base(strclone("void"));
+        break;
+    case IR_GEN_ATOMIC_EXCHANGE:
+        result = build_atomic_rmw(builder, INSTRUCTION_STORE, pointer, arg_values[1], orderings[0]);
+        result_type = ast_type_clone(&element_type);
+        break;
+    case IR_GEN_ATOMIC_FETCH: {
+            // Reuse the same instruction choices as the corresponding math operator
+            unsigned int operation = ir_instr_choosing_run(&ir_gen_math_specs[builtin->expr_id].choices, arg_values[1]->type);
+
+            if(ir_atomic_rmw_operation_name(operation) == NULL){
+                strong_cstr_t given = ast_type_str(&element_type);
+                compiler_panicf(builder->compiler, expr->source, "Builtin '%s' cannot be used on values of type '%s'", expr->name, given);
+                free(given);
+                return FAILURE;
+            }
+
+            result = build_atomic_rmw(builder, operation, pointer, arg_values[1], orderings[0]);
+            result_type = ast_type_clone(&element_type);
+        }
+        break;
+    case IR_GEN_ATOMIC_COMPARE_EXCHANGE: {
+            // Like C11, the previous value is always written back to 'expected',
+            // which leaves it unchanged when the exchange happens
+            ir_value_t *expected_pointer = arg_values[1];
+            ir_value_t *expected = build_load(builder, expected_pointer, expr->source);
+            ir_value_t *previous = build_atomic_cmpxchg(builder, pointer, expected, arg_values[2], orderings[0], orderings[1]);
+
+            result = build_math(builder, INSTRUCTION_EQUALS, previous, expected, ir_builder_bool(builder));
+            build_store(builder, previous, expected_pointer, expr->source);
+            result_type = ast_type_make_base(strclone("bool"));
+        }
+        break;
+    default:
+        internalerrorprintf("ir_gen_atomic_builtin() got unknown kind of atomic operation\n");
+        return FAILURE;
+    }
+
+    if(ir_value) *ir_value = result;
+
+    if(out_expr_type){
+        *out_expr_type = result_type;
+    } else {
+        ast_type_free(&result_type);
+    }
+
+    return SUCCESS;
+}
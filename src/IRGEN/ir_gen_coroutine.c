@@ -0,0 +1,275 @@
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "AST/TYPE/ast_type_identical.h"
+#include "AST/TYPE/ast_type_make.h"
+#include "AST/ast.h"
+#include "AST/ast_expr.h"
+#include "AST/ast_type.h"
+#include "BRIDGE/bridge.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "IR/ir.h"
+#include "IR/ir_type.h"
+#include "IR/ir_type_map.h"
+#include "IR/ir_value.h"
+#include "IRGEN/ir_build_instr.h"
+#include "IRGEN/ir_build_literal.h"
+#include "IRGEN/ir_builder.h"
+#include "IRGEN/ir_gen_coroutine.h"
+#include "IRGEN/ir_gen_expr.h"
+#include "IRGEN/ir_gen_stmt.h"
+#include "IRGEN/ir_gen_type.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+#include "UTIL/trait.h"
+
+errorcode_t ir_gen_stmt_yield(ir_builder_t *builder, ast_expr_yield_t *stmt){
+    ast_type_t yield_type = ast_funcs_at(&builder->object->ast.funcs, builder->ast_func_id)->yield_type;
+    bool yields_void = ast_type_is_void(&yield_type);
+
+    ir_value_t *yielded_pointer;
+
+    if(stmt->value != NULL){
+        if(yields_void){
+            compiler_panicf(builder->compiler, stmt->source, "Cannot yield a value from a generator that yields void");
+            return FAILURE;
+        }
+
+        ir_value_t *value;
+        ast_type_t value_type;
+        if(ir_gen_expr(builder, stmt->value, &value, false, &value_type)) return FAILURE;
+
+        if(!ast_types_conform(builder, &value, &value_type, &yield_type, CONFORM_MODE_RETURN)){
+            strong_cstr_t a_type_str = ast_type_str(&value_type);
+            strong_cstr_t b_type_str = ast_type_str(&yield_type);
+            compiler_panicf(builder->compiler, stmt->source, "Attempting to yield type '%s' when generator yields type '%s'", a_type_str, b_type_str);
+            free(a_type_str);
+            free(b_type_str);
+            ast_type_free(&value_type);
+            return FAILURE;
+        }
+
+        ast_type_free(&value_type);
+
+        // Keep the yielded value in the generator's frame, so that it
+        // stays valid for the consumer until the generator is resumed
+        bridge_var_t *yielded = ir_builder_add_variable(builder, "$____yielded____$", &ast_funcs_at(&builder->object->ast.funcs, builder->ast_func_id)->yield_type,
+            value->type, BRIDGE_VAR_POD | BRIDGE_VAR_UNDEF);
+
+        ir_value_t *destination = build_lvarptr(builder, ir_type_make_pointer_to(builder->pool, value->type), yielded->id);
+        build_store(builder, value, destination, stmt->source);
+        yielded_pointer = build_bitcast(builder, destination, builder->ptr_type);
+    } else if(!yields_void){
+        strong_cstr_t type_str = ast_type_str(&yield_type);
+        compiler_panicf(builder->compiler, stmt->source, "Expected value of type '%s' to yield", type_str);
+        free(type_str);
+        return FAILURE;
+    } else {
+        yielded_pointer = build_null_pointer(builder->pool);
+    }
+
+    ir_value_t *is_destroying = build_coroutine(builder, INSTRUCTION_COROUTINE_SUSPEND, yielded_pointer, ir_builder_bool(builder));
+
+    length_t destroy_block_id = build_basicblock(builder);
+    length_t resume_block_id = build_basicblock(builder);
+    build_cond_break(builder, is_destroying, destroy_block_id, resume_block_id);
+
+    // When destroyed while suspended, clean up as if returning from here
+    build_using_basicblock(builder, destroy_block_id);
+
+    bool illegally_terminated;
+    if(ir_gen_stmts(builder, &stmt->last_minute, &illegally_terminated)) return FAILURE;
+
+    if(illegally_terminated){
+        compiler_panicf(builder->compiler, stmt->source, "Cannot expand a previously deferred terminating statement");
+        return FAILURE;
+    }
+
+    if(ir_gen_variable_deference(builder, NULL)) return FAILURE;
+    build_return(builder, NULL);
+
+    build_using_basicblock(builder, resume_block_id);
+    return SUCCESS;
+}
+
+static ast_func_t *ir_gen_generator_of_call(ir_builder_t *builder, ir_value_t *value){
+    // Finds the generator that was called to produce a value (if any)
+
+    if(value->value_type != VALUE_TYPE_RESULT) return NULL;
+
+    ir_value_result_t *result = &value->result;
+    ir_instr_t *instr = builder->basicblocks.blocks[result->block_id].instructions.instructions[result->instruction_id];
+    if(instr->id != INSTRUCTION_CALL) return NULL;
+
+    ir_func_t *callee = ir_funcs_at(&builder->object->ir_module.funcs, ((ir_instr_call_t*) instr)->ir_func_id);
+    if(!(callee->traits & IR_FUNC_COROUTINE)) return NULL;
+
+    return ast_funcs_at(&builder->object->ast.funcs, callee->ast_func_id);
+}
+
+bool ir_gen_is_generator_call(ir_builder_t *builder, ir_value_t *value){
+    return ir_gen_generator_of_call(builder, value) != NULL;
+}
+
+errorcode_t ir_gen_stmt_each_generator(ir_builder_t *builder, ast_expr_each_in_t *stmt, ir_value_t *handle, ir_value_t *idx_ptr){
+    ast_func_t *generator = ir_gen_generator_of_call(builder, handle);
+
+    if(ast_type_is_void(&generator->yield_type)){
+        compiler_panicf(builder->compiler, stmt->list->source, "Cannot use 'each in' on generator '%s' that yields void", generator->name);
+        return FAILURE;
+    }
+
+    // Verify that the item type matches the type yielded
+    if(!ast_types_identical(&generator->yield_type, stmt->it_type)){
+        compiler_panic(builder->compiler, stmt->it_type->source, "Element type doesn't match given generator's yield type");
+
+        char *s1 = ast_type_str(stmt->it_type);
+        char *s2 = ast_type_str(&generator->yield_type);
+        compiler_hintf(builder->compiler, "(given element type : '%s', generator yield type : '%s')\n", s1, s2);
+        free(s1);
+        free(s2);
+        return FAILURE;
+    }
+
+    ir_type_t *item_ir_type;
+    if(ir_gen_resolve_type(builder->compiler, builder->object, stmt->it_type, &item_ir_type)) return FAILURE;
+
+    ir_type_t *item_ir_type_ptr = ir_type_make_pointer_to(builder->pool, item_ir_type);
+    ir_type_t *handle_ptr_type = ir_type_make_pointer_to(builder->pool, handle->type);
+    ir_type_t *void_type;
+    if(!ir_type_map_find(builder->type_map, "void", &void_type)) return FAILURE;
+
+    // Store the handle in a variable that destroys the generator when
+    // exiting the loop early (via 'return', or 'break' to an outer loop)
+    bridge_var_t *handle_var = ir_builder_add_variable(builder, "$____each_in_generator____$", &generator->return_type, handle->type,
+        BRIDGE_VAR_POD | BRIDGE_VAR_UNDEF | BRIDGE_VAR_COROUTINE);
+
+    build_store(builder, handle, build_lvarptr(builder, handle_ptr_type, handle_var->id), stmt->source);
+
+    length_t test_basicblock_id = build_basicblock(builder);
+    length_t new_basicblock_id  = build_basicblock(builder);
+    length_t inc_basicblock_id  = build_basicblock(builder);
+    length_t end_basicblock_id  = build_basicblock(builder);
+
+    // Hook up labels
+    if(stmt->label != NULL) ir_builder_push_loop_label(builder, stmt->label, end_basicblock_id, inc_basicblock_id);
+
+    length_t prev_break_block_id = builder->break_block_id;
+    length_t prev_continue_block_id = builder->continue_block_id;
+    bridge_scope_t *prev_break_continue_scope = builder->break_continue_scope;
+
+    builder->break_block_id = end_basicblock_id;
+    builder->continue_block_id = inc_basicblock_id;
+    builder->break_continue_scope = builder->scope;
+
+    // Keep going until the generator finishes
+    build_break(builder, test_basicblock_id);
+    build_using_basicblock(builder, test_basicblock_id);
+
+    ir_value_t *loaded_handle = build_load(builder, build_lvarptr(builder, handle_ptr_type, handle_var->id), stmt->source);
+    ir_value_t *is_done = build_coroutine(builder, INSTRUCTION_COROUTINE_DONE, loaded_handle, ir_builder_bool(builder));
+    build_cond_break(builder, is_done, end_basicblock_id, new_basicblock_id);
+
+    // Update 'it' to refer to the most recently yielded value
+    build_using_basicblock(builder, new_basicblock_id);
+    ir_builder_open_scope(builder);
+
+    bridge_var_t *it_var = ir_builder_add_variable(builder, stmt->it_name ? stmt->it_name : "it", stmt->it_type, item_ir_type_ptr, BRIDGE_VAR_POD | BRIDGE_VAR_REFERENCE);
+
+    loaded_handle = build_load(builder, build_lvarptr(builder, handle_ptr_type, handle_var->id), stmt->source);
+    ir_value_t *yielded = build_coroutine(builder, INSTRUCTION_COROUTINE_VALUE, loaded_handle, builder->ptr_type);
+    build_store(builder, build_bitcast(builder, yielded, item_ir_type_ptr), build_lvarptr(builder, ir_type_make_pointer_to(builder->pool, item_ir_type_ptr), it_var->id), stmt->source);
+
+    // Generate user-defined statements
+    bool terminated;
+    if(ir_gen_stmts(builder, &stmt->statements, &terminated)){
+        ir_builder_close_scope(builder);
+        return FAILURE;
+    }
+
+    if(!terminated){
+        if(handle_deference_for_variables(builder, &builder->scope->list)){
+            ir_builder_close_scope(builder);
+            return FAILURE;
+        }
+
+        build_break(builder, inc_basicblock_id);
+    }
+
+    ir_builder_close_scope(builder);
+
+    // Resume the generator and increment 'idx'
+    build_using_basicblock(builder, inc_basicblock_id);
+    loaded_handle = build_load(builder, build_lvarptr(builder, handle_ptr_type, handle_var->id), stmt->source);
+    build_coroutine(builder, INSTRUCTION_COROUTINE_RESUME, loaded_handle, NULL);
+
+    ir_value_t *incremented = build_math(builder, INSTRUCTION_ADD, build_load(builder, idx_ptr, stmt->source), build_literal_usize(builder->pool, 1), ir_builder_usize(builder));
+    build_store(builder, incremented, idx_ptr, stmt->source);
+    build_break(builder, test_basicblock_id);
+
+    // Destroy the generator once done with it
+    build_using_basicblock(builder, end_basicblock_id);
+    loaded_handle = build_load(builder, build_lvarptr(builder, handle_ptr_type, handle_var->id), stmt->source);
+    build_coroutine(builder, INSTRUCTION_COROUTINE_DESTROY, loaded_handle, NULL);
+
+    ir_builder_close_scope(builder);
+
+    if(stmt->label != NULL) ir_builder_pop_loop_label(builder);
+
+    builder->break_block_id = prev_break_block_id;
+    builder->continue_block_id = prev_continue_block_id;
+    builder->break_continue_scope = prev_break_continue_scope;
+    return SUCCESS;
+}
+
+typedef struct {
+    const char *name;
+    unsigned int instr_id;
+    const char *result_typename;
+} ir_gen_coroutine_builtin_t;
+
+static const ir_gen_coroutine_builtin_t ir_gen_coroutine_builtins[] = {
+    {"coroutine_destroy", INSTRUCTION_COROUTINE_DESTROY, "void"},
+    {"coroutine_done",    INSTRUCTION_COROUTINE_DONE,    "bool"},
+    {"coroutine_resume",  INSTRUCTION_COROUTINE_RESUME,  "void"},
+    {"coroutine_value",   INSTRUCTION_COROUTINE_VALUE,   "ptr"},
+};
+
+errorcode_t ir_gen_coroutine_builtin(ir_builder_t *builder, ast_expr_call_t *expr, ir_value_t **arg_values,
+        ast_type_t *arg_types, ir_value_t **ir_value, ast_type_t *out_expr_type){
+
+    const ir_gen_coroutine_builtin_t *builtin = NULL;
+
+    for(length_t i = 0; i != NUM_ITEMS(ir_gen_coroutine_builtins); i++){
+        if(streq(ir_gen_coroutine_builtins[i].name, expr->name)){
+            builtin = &ir_gen_coroutine_builtins[i];
+            break;
+        }
+    }
+
+    if(builtin == NULL) return ALT_FAILURE;
+
+    if(expr->arity != 1){
+        compiler_panicf(builder->compiler, expr->source, "Builtin '%s' expects 1 argument, got %d", expr->name, (int) expr->arity);
+        return FAILURE;
+    }
+
+    if(!ast_type_is_base_of(&arg_types[0], "ptr")){
+        strong_cstr_t given = ast_type_str(&arg_types[0]);
+        compiler_panicf(builder->compiler, expr->args[0]->source, "Builtin '%s' expects a generator handle of type 'ptr', got '%s'", expr->name, given);
+        free(given);
+        return FAILURE;
+    }
+
+    ir_type_t *result_type;
+    if(!ir_type_map_find(builder->type_map, builtin->result_typename, &result_type)) return FAILURE;
+
+    ir_value_t *result = build_coroutine(builder, builtin->instr_id, arg_values[0], result_type);
+
+    if(ir_value) *ir_value = result;
+    if(out_expr_type) *out_expr_type = ast_type_make_base(strclone(builtin->result_typename));
+    return SUCCESS;
+}
@@ -21,6 +21,7 @@
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
 #include "IR/ir.h"
+#include "IR/ir_const_pool.h"
 #include "IR/ir_module.h"
 #include "IR/ir_pool.h"
 #include "IR/ir_type.h"
@@ -30,11 +31,16 @@
 #include "IRGEN/ir_build_literal.h"
 #include "IRGEN/ir_builder.h"
 #include "IRGEN/ir_gen.h"
+#include "IRGEN/ir_gen_atomic.h"
+#include "IRGEN/ir_gen_coroutine.h"
 #include "IRGEN/ir_gen_expr.h"
 #include "IRGEN/ir_gen_find.h"
+#include "IRGEN/ir_gen_intrinsic.h"
 #include "IRGEN/ir_gen_qualifiers.h"
+#include "IRGEN/ir_gen_soa.h"
 #include "IRGEN/ir_gen_stmt.h"
 #include "IRGEN/ir_gen_type.h"
+#include "IRGEN/ir_gen_vector.h"
 #include "UTIL/builtin_type.h"
 #include "UTIL/color.h"
 #include "UTIL/datatypes.h"
@@ -61,14 +67,17 @@ errorcode_t ir_gen_expr(ir_builder_t *builder, ast_expr_t *expr, ir_value_t **ir
     switch(expr->id){
 
     #define build_literal_ir_value(ast_expr_type, typename, storage_type) {              \
-        /* Allocate memory for literal value */                                          \
-        *ir_value = ir_pool_alloc(builder->pool, sizeof(ir_value_t));                    \
-        (*ir_value)->value_type = VALUE_TYPE_LITERAL;                                    \
+        /* Resolve the IR type */                                                        \
+        ir_type_t *literal_type;                                                         \
+        ir_type_map_find(builder->type_map, typename, &literal_type);                    \
+        storage_type literal_storage = ((ast_expr_type*) expr)->value;                   \
                                                                                          \
-        /* Store the literal value and resolve the IR type */                            \
-        ir_type_map_find(builder->type_map, typename, &((*ir_value)->type));             \
-        (*ir_value)->extra = ir_pool_alloc(builder->pool, sizeof(storage_type));         \
-        *((storage_type*) (*ir_value)->extra) = ((ast_expr_type*) expr)->value;          \
+        /* Share the literal value with identical literals when possible */              \
+        if(ir_const_pool_kind_is_internable(literal_type->kind)){                        \
+            *ir_value = ir_const_pool_literal(builder->pool, literal_type->kind, &literal_storage); \
+        } else {                                                                         \
+            *ir_value = ir_literal_make(builder->pool, literal_type, &literal_storage, sizeof(storage_type)); \
+        }                                                                                \
                                                                                          \
         /* Result type is an AST type with that typename */                              \
         if(out_expr_type != NULL){                                                       \
@@ -399,10 +408,15 @@ errorcode_t ir_gen_expr_cstr(ir_builder_t *builder, ast_expr_cstr_t *expr, ir_va
 
 errorcode_t ir_gen_expr_variable(ir_builder_t *builder, ast_expr_variable_t *expr, ir_value_t **ir_value, bool leave_mutable, ast_type_t *out_expr_type){
     char *variable_name = expr->name;
-    bridge_var_t *variable = bridge_scope_find_var(builder->scope, variable_name);
+    bridge_var_t *variable = ir_builder_find_var(builder, variable_name);
 
     // Found variable in nearby scope
     if(variable){
+        // Elements of SoA containers are gathered from their columns
+        if(variable->traits & BRIDGE_VAR_SOA_ELEMENT){
+            return ir_gen_soa_element_variable(builder, variable, expr->source, ir_value, leave_mutable, out_expr_type);
+        }
+
         if(out_expr_type != NULL){
             *out_expr_type = ast_type_clone(variable->ast_type);
         }
@@ -435,6 +449,11 @@ errorcode_t ir_gen_expr_variable(ir_builder_t *builder, ast_expr_variable_t *exp
     if(global_variable_index != -1){
         if(out_expr_type != NULL) *out_expr_type = ast_type_clone(&ast->globals[global_variable_index].type);
 
+        // Direct access to the runtime type table means that none of its entries can be stripped
+        if(ast->globals[global_variable_index].traits & (AST_GLOBAL___TYPES__ | AST_GLOBAL___TYPES_LENGTH__)){
+            ir_module->rtti_table_referenced = true;
+        }
+
         // DANGEROUS: Using AST global variable index as IR global variable index
         ir_global_t *ir_global = &ir_module->globals[global_variable_index];
         *ir_value = build_gvarptr(builder, ir_type_make_pointer_to(builder->pool, ir_global->type), global_variable_index);
@@ -447,7 +466,7 @@ errorcode_t ir_gen_expr_variable(ir_builder_t *builder, ast_expr_variable_t *exp
     // No suitable variable or global variable found
     compiler_panicf(builder->compiler, ((ast_expr_variable_t*) expr)->source, "Undeclared variable '%s'", variable_name);
     const char *nearest = bridge_scope_var_nearest(builder->scope, variable_name);
-    if(nearest) printf("\nDid you mean '%s'?\n", nearest);
+    if(nearest) compiler_hintf(builder->compiler, "\nDid you mean '%s'?\n", nearest);
     return FAILURE;
 }
 
@@ -472,7 +491,7 @@ errorcode_t ir_gen_expr_call(ir_builder_t *builder, ast_expr_call_t *expr, ir_va
     ir_type_t *tmp_ir_variable_type;
 
     // Check for variable of name in nearby scope
-    bridge_var_t *var = bridge_scope_find_var(builder->scope, expr->name);
+    bridge_var_t *var = ir_builder_find_var(builder, expr->name);
     bool is_var_function_like = var && ast_type_is_func(var->ast_type);
 
     // Found variable of name in nearby scope
@@ -488,6 +507,7 @@ errorcode_t ir_gen_expr_call(ir_builder_t *builder, ast_expr_call_t *expr, ir_va
 
         // Load function pointer value from variable
         *ir_value = build_varptr(builder, tmp_ir_variable_type, var);
+        if(var->traits & BRIDGE_VAR_REFERENCE) *ir_value = build_load(builder, *ir_value, expr->source);
         *ir_value = build_load(builder, *ir_value, expr->source);
 
         // Call function pointer value
@@ -551,7 +571,7 @@ errorcode_t ir_gen_expr_call(ir_builder_t *builder, ast_expr_call_t *expr, ir_va
         ast_type_t ast_func_return_type;
 
         {
-            ast_func_t *ast_func = &ast->funcs[pair.ast_func_id];
+            ast_func_t *ast_func = ast_funcs_at(&ast->funcs, pair.ast_func_id);
             ast_func_traits = ast_func->traits;
             ast_func_arg_types = ast_func->arg_types;
             ast_func_arity = ast_func->arity;
@@ -569,8 +589,8 @@ errorcode_t ir_gen_expr_call(ir_builder_t *builder, ast_expr_call_t *expr, ir_va
             return SUCCESS;
         }
 
-        if(ensure_not_violating_disallow(builder->compiler, expr->source, &ast->funcs[pair.ast_func_id])
-        || ensure_not_violating_no_discard(builder->compiler, expr->no_discard, expr->source, &ast->funcs[pair.ast_func_id])){
+        if(ensure_not_violating_disallow(builder->compiler, expr->source, ast_funcs_at(&ast->funcs, pair.ast_func_id))
+        || ensure_not_violating_no_discard(builder->compiler, expr->no_discard, expr->source, ast_funcs_at(&ast->funcs, pair.ast_func_id))){
             ast_types_free_fully(arg_types, arg_arity);
             return ALT_FAILURE;
         }
@@ -596,7 +616,7 @@ errorcode_t ir_gen_expr_call(ir_builder_t *builder, ast_expr_call_t *expr, ir_va
         ast_types_free_fully(arg_types, unpacked_arity);
         
         // Call the actual function and store resulting value from call expression if requested
-        ir_type_t *result_type = builder->object->ir_module.funcs.funcs[pair.ir_func_id].return_type;
+        ir_type_t *result_type = ir_funcs_at(&builder->object->ir_module.funcs, pair.ir_func_id)->return_type;
 
         if(ir_value){
             *ir_value = build_call(builder, pair.ir_func_id, result_type, arg_values, arg_arity, expr->source);
@@ -680,6 +700,39 @@ errorcode_t ir_gen_expr_call(ir_builder_t *builder, ast_expr_call_t *expr, ir_va
     // Otherwise no function or variable with a matching name was found
     // ...
 
+    // Builtin vector operations, only used when not shadowed by a user function or global
+    error = ir_gen_vector_builtin(builder, expr, arg_values, arg_types, ir_value, out_expr_type);
+
+    if(error != ALT_FAILURE){
+        ast_types_free_fully(arg_types, arg_arity);
+        return error;
+    }
+
+    // Builtin atomic operations, also only used when not shadowed
+    error = ir_gen_atomic_builtin(builder, expr, arg_values, arg_types, ir_value, out_expr_type);
+
+    if(error != ALT_FAILURE){
+        ast_types_free_fully(arg_types, arg_arity);
+        return error;
+    }
+
+    // Builtin coroutine operations, also only used when not shadowed
+    error = ir_gen_coroutine_builtin(builder, expr, arg_values, arg_types, ir_value, out_expr_type);
+
+    if(error != ALT_FAILURE){
+        ast_types_free_fully(arg_types, arg_arity);
+        return error;
+    }
+
+    // Builtin intrinsics, also only used when not shadowed
+    unsigned int intrinsic;
+
+    if(ir_gen_find_intrinsic(expr->name, &intrinsic)){
+        error = ir_gen_intrinsic(builder, expr, intrinsic, arg_values, arg_types, ir_value, out_expr_type);
+        ast_types_free_fully(arg_types, arg_arity);
+        return error;
+    }
+
     if(streq(expr->name, "__pass__") && expr->arity == 1){
         // If __pass__function can't be found or generated, just return the argument
 
@@ -712,7 +765,7 @@ errorcode_t ir_gen_expr_super(ir_builder_t *builder, ast_expr_super_t *expr, ir_
     // super(a, b, c, d)  ->  (this as Super).__constructor__(a, b, c); this.__vtable__ = <__vtable__>
 
     // Find 'this' argument
-    bridge_var_t *bridge_var = bridge_scope_find_var(builder->scope, "this");
+    bridge_var_t *bridge_var = ir_builder_find_var(builder, "this");
     assert(bridge_var);
 
     ast_type_t subject_type = ast_type_dereferenced_view(bridge_var->ast_type);
@@ -731,11 +784,9 @@ errorcode_t ir_gen_expr_super(ir_builder_t *builder, ast_expr_super_t *expr, ir_
     }
 
     // Get value of 'this'
-    ir_value_t *this_value = build_load(
-        builder, 
-        build_varptr(builder, ir_type_make_pointer_to(builder->pool, bridge_var->ir_type), bridge_var),
-        expr->source
-    );
+    ir_value_t *this_value = build_varptr(builder, ir_type_make_pointer_to(builder->pool, bridge_var->ir_type), bridge_var);
+    if(bridge_var->traits & BRIDGE_VAR_REFERENCE) this_value = build_load(builder, this_value, expr->source);
+    this_value = build_load(builder, this_value, expr->source);
 
     ast_expr_t *this_pointer = ast_expr_create_phantom(ast_type_clone(bridge_var->ast_type), this_value, expr->source, false);
     ast_expr_t *this_as_super = ast_expr_create_cast(ast_type_pointer_to(parent_class_type), this_pointer, expr->source);
@@ -838,13 +889,13 @@ errorcode_t ir_gen_expr_call_procedure_handle_variadic_packing(ir_builder_t *bui
     // -----
     
     ast_t *ast = &builder->object->ast;
-    trait_t ast_func_traits = ast->funcs[pair->ast_func_id].traits;
+    trait_t ast_func_traits = ast_funcs_at(&ast->funcs, pair->ast_func_id)->traits;
     
     // Don't pack arguments unless function is variadic
     if(!(ast_func_traits & AST_FUNC_VARIADIC)) return SUCCESS;
 
     // Everything after the natural arity of the function will be packed inside the variadic argument list
-    length_t natural_arity = ast->funcs[pair->ast_func_id].arity;
+    length_t natural_arity = ast_funcs_at(&ast->funcs, pair->ast_func_id)->arity;
 
     // Calculate number of variadic arguments
     length_t variadic_count = *arity - natural_arity;
@@ -977,6 +1028,10 @@ errorcode_t ir_gen_expr_member(ir_builder_t *builder, ast_expr_member_t *expr, i
     ir_value_t *value_of_composite;
     ast_type_t ast_type_of_composite;
 
+    // Fields of elements of SoA containers are accessed within their columns
+    errorcode_t soa_errorcode = ir_gen_soa_member(builder, expr, ir_value, leave_mutable, out_expr_type);
+    if(soa_errorcode != ALT_FAILURE) return soa_errorcode;
+
     // This expression should be able to be mutable (Checked during parsing)
     if(ir_gen_expr(builder, expr->value, &value_of_composite, true, &ast_type_of_composite)) return FAILURE;
 
@@ -1341,7 +1396,7 @@ errorcode_t ir_gen_expr_initlist(ir_builder_t *builder, ast_expr_initlist_t *exp
 
     if(ast_type_is_void(&temporary_type)){
         compiler_panicf(builder->compiler, expr->source, "__initializer_list__ must be defined in order to use initializer lists");
-        printf("\nTry importing '%s/InitializerList.adept'\n", ADEPT_VERSION_STRING);
+        compiler_hintf(builder->compiler, "\nTry importing '%s/InitializerList.adept'\n", ADEPT_VERSION_STRING);
         ast_type_free(&temporary_type);
         return FAILURE;
     }
@@ -1375,7 +1430,7 @@ errorcode_t ir_gen_expr_func_addr(ir_builder_t *builder, ast_expr_func_addr_t *e
         }
 
         // Ensure found function is not disallowed
-        if(ensure_not_violating_disallow(builder->compiler, expr->source, &builder->object->ast.funcs[pair.ast_func_id])){
+        if(ensure_not_violating_disallow(builder->compiler, expr->source, ast_funcs_at(&builder->object->ast.funcs, pair.ast_func_id))){
             return FAILURE;
         }
         
@@ -1407,7 +1462,7 @@ errorcode_t ir_gen_expr_func_addr(ir_builder_t *builder, ast_expr_func_addr_t *e
         pair = result.value;
 
         // Ensure found function is not disallowed
-        if(ensure_not_violating_disallow(builder->compiler, expr->source, &builder->object->ast.funcs[pair.ast_func_id])){
+        if(ensure_not_violating_disallow(builder->compiler, expr->source, ast_funcs_at(&builder->object->ast.funcs, pair.ast_func_id))){
             return FAILURE;
         }
     }
@@ -1420,15 +1475,18 @@ errorcode_t ir_gen_expr_func_addr(ir_builder_t *builder, ast_expr_func_addr_t *e
 
     // If the function is only referenced by C-mangled name, then get its address by it
     // Otherwise, just get its function address like normal using its IR function id
+    ir_module_reference_func(&builder->object->ir_module, pair.ir_func_id);
+
     if(ast_func_traits & AST_FUNC_FOREIGN || ast_func_traits & AST_FUNC_MAIN){
         *ir_value = build_func_addr_by_name(builder->pool, ir_funcptr_type, expr->name);
     } else {
         *ir_value = build_func_addr(builder->pool, ir_funcptr_type, pair.ir_func_id);
+        ir_module_add_func_traits(&builder->object->ir_module, pair.ir_func_id, IR_FUNC_ADDRESS_TAKEN | IR_FUNC_ADDRESS_EXPOSED);
     }
 
     // Write resulting type if requested
     if(out_expr_type != NULL){
-        ast_func_t *ast_func = &ast->funcs[pair.ast_func_id];
+        ast_func_t *ast_func = ast_funcs_at(&ast->funcs, pair.ast_func_id);
 
         // Force return type of result type of be 'int' if target function is entry point function
         // (e.g. func &main will give back either 'func() int' or 'func(int, **ubyte) int', but never func() void)
@@ -1479,6 +1537,7 @@ errorcode_t ir_gen_expr_func_addr_noop_result_for_defer(ir_builder_t *builder, a
 
     // Get function address
     *ir_value = build_func_addr(builder->pool, ir_noop_funcptr_type, ir_func_id);
+    ir_module_add_func_traits(module, ir_func_id, IR_FUNC_ADDRESS_TAKEN | IR_FUNC_ADDRESS_EXPOSED);
 
     // Cast to proper type
     *ir_value = build_const_bitcast(builder->pool, *ir_value, module->common.ir_ptr);
@@ -1572,6 +1631,16 @@ errorcode_t ir_gen_expr_array_access(ir_builder_t *builder, ast_expr_array_acces
 
         ir_type_t *casted_ir_type = ir_type_make_pointer_to(builder->pool, ((ir_type_extra_fixed_array_t*) ((ir_type_t*) array_value->type->extra)->extra)->subtype);
         array_value = build_bitcast(builder, array_value, casted_ir_type);
+    } else if(((ir_type_t*) array_value->type->extra)->kind == TYPE_KIND_VECTOR){
+        // Bitcast reference to vector to pointer of element in order to access lanes
+        // (*)  f32x4 -> *float
+
+        const char *element_name = global_vector_type_elements[typename_vector_type(ast_type_base_name(&array_type))];
+        ast_type_free(&array_type);
+        array_type = ast_type_make_base_ptr(strclone(element_name));
+
+        ir_type_t *casted_ir_type = ir_type_make_pointer_to(builder->pool, ((ir_type_extra_vector_t*) ((ir_type_t*) array_value->type->extra)->extra)->subtype);
+        array_value = build_bitcast(builder, array_value, casted_ir_type);
     } else if(((ir_type_t*) array_value->type->extra)->kind == TYPE_KIND_STRUCTURE){
         // Keep structure value mutable
     } else if(expr_is_mutable(expr->value)){
@@ -1592,6 +1661,15 @@ errorcode_t ir_gen_expr_array_access(ir_builder_t *builder, ast_expr_array_acces
 
         // Access array via index
         *ir_value = build_array_access(builder, array_value, index_value, expr->source);
+    } else if(ir_type_is_pointer_to(array_value->type, TYPE_KIND_STRUCTURE) && ir_gen_soa_find(builder->object, &array_type)){
+        // Elements of SoA containers are gathered from their columns
+        // (The 'at' operator always requires the element to exist in memory)
+        ast_soa_t *soa = ir_gen_soa_find(builder->object, &array_type);
+
+        errorcode_t errorcode = ir_gen_soa_element(builder, soa, array_value, index_value, expr->source, ir_value, leave_mutable || expr->id == EXPR_AT, out_expr_type);
+        ast_type_free(&array_type);
+        ast_type_free(&index_type);
+        return errorcode;
     } else if(ir_type_is_pointer_to(array_value->type, TYPE_KIND_STRUCTURE)){
         // If standard [] access isn't allowed on this type, then try
         // to use the __access__ management method (if the array value is a structure)
@@ -1844,14 +1922,14 @@ errorcode_t ir_gen_expr_call_method(ir_builder_t *builder, ast_expr_call_method_
 
     func_pair_t pair = result.value;
 
-    if(ensure_not_violating_disallow(builder->compiler, expr->source, &ast->funcs[pair.ast_func_id])
-    || ensure_not_violating_no_discard(builder->compiler, expr->no_discard, expr->source, &ast->funcs[pair.ast_func_id])){
+    if(ensure_not_violating_disallow(builder->compiler, expr->source, ast_funcs_at(&ast->funcs, pair.ast_func_id))
+    || ensure_not_violating_no_discard(builder->compiler, expr->no_discard, expr->source, ast_funcs_at(&ast->funcs, pair.ast_func_id))){
         ast_types_free_fully(arg_types, arg_arity);
         return ALT_FAILURE;
     }
 
     {
-        ast_func_t *ast_func = &ast->funcs[pair.ast_func_id];
+        ast_func_t *ast_func = ast_funcs_at(&ast->funcs, pair.ast_func_id);
 
         if(ir_gen_expr_call_procedure_handle_pass_management(builder, arg_arity, arg_values, arg_types, ast_func->arg_types, ast_func->traits, ast_func->arg_type_traits, ast_func->arity)){
             ast_types_free_fully(arg_types, arg_arity);
@@ -1868,7 +1946,7 @@ errorcode_t ir_gen_expr_call_method(ir_builder_t *builder, ast_expr_call_method_
         return FAILURE;
     }
 
-    ir_type_t *ir_return_type = builder->object->ir_module.funcs.funcs[pair.ir_func_id].return_type;
+    ir_type_t *ir_return_type = ir_funcs_at(&builder->object->ir_module.funcs, pair.ir_func_id)->return_type;
 
     // Don't even bother with result unless we care about the it
     if(ir_value){
@@ -1896,7 +1974,7 @@ errorcode_t ir_gen_expr_call_method(ir_builder_t *builder, ast_expr_call_method_
 
     // Result type is the return type of the method
     if(out_expr_type != NULL){
-        *out_expr_type = ast_type_clone(&ast->funcs[pair.ast_func_id].return_type);
+        *out_expr_type = ast_type_clone(&ast_funcs_at(&ast->funcs, pair.ast_func_id)->return_type);
     }
 
     return SUCCESS;
@@ -1935,18 +2013,17 @@ errorcode_t ir_gen_expr_unary(ir_builder_t *builder, ast_expr_unary_t *expr, ir_
     if(ir_gen_expr(builder, expr->value, &expr_value, false, &expr_type)) return FAILURE;
 
     unsigned int category = ir_type_get_category(expr_value->type);
-    
-    ir_instr_unary_t *instruction = (ir_instr_unary_t*) build_instruction(builder, sizeof(ir_instr_unary_t));
-    instruction->value = expr_value;
+    unsigned int instr_id;
+    ir_type_t *result_type;
 
     if(expr->id == EXPR_NOT){
         // Build '!'
 
         // Must be either integer or float like
-        if(category == PRIMITIVE_NA) goto cant_use_operator_on_that_type;
+        if(category == PRIMITIVE_NA || expr_value->type->kind == TYPE_KIND_VECTOR) goto cant_use_operator_on_that_type;
 
-        instruction->id = INSTRUCTION_ISZERO;
-        instruction->result_type = ir_builder_bool(builder);
+        instr_id = INSTRUCTION_ISZERO;
+        result_type = ir_builder_bool(builder);
 
         // Result type is bool
         if(out_expr_type != NULL){
@@ -1954,17 +2031,17 @@ errorcode_t ir_gen_expr_unary(ir_builder_t *builder, ast_expr_unary_t *expr, ir_
         }
     } else {
         // Build '-' or '~'
-        instruction->result_type = expr_value->type;
+        result_type = expr_value->type;
 
         // Determine instruction
         switch(category){
         case PRIMITIVE_UI:
         case PRIMITIVE_SI:
-            instruction->id = expr->id == EXPR_NEGATE ? INSTRUCTION_NEGATE : INSTRUCTION_BIT_COMPLEMENT;
+            instr_id = expr->id == EXPR_NEGATE ? INSTRUCTION_NEGATE : INSTRUCTION_BIT_COMPLEMENT;
             break;
         case PRIMITIVE_FP:
             if(expr->id == EXPR_BIT_COMPLEMENT) goto cant_use_operator_on_that_type;        
-            instruction->id = INSTRUCTION_FNEGATE;
+            instr_id = INSTRUCTION_FNEGATE;
             break;
         default:
             goto cant_use_operator_on_that_type;
@@ -1975,7 +2052,7 @@ errorcode_t ir_gen_expr_unary(ir_builder_t *builder, ast_expr_unary_t *expr, ir_
     }
 
     // We successfully generated the value for the unary expression
-    *ir_value = build_value_from_prev_instruction(builder);
+    *ir_value = build_unary(builder, instr_id, expr_value, result_type);
     ast_type_free(&expr_type);
     return SUCCESS;
 
@@ -2275,7 +2352,7 @@ errorcode_t ir_gen_expr_ternary(ir_builder_t *builder, ast_expr_ternary_t *expr,
     length_t when_false_block_id = build_basicblock(builder);
 
     // Jump to appropriate block based on condition
-    build_cond_break(builder, condition, when_true_block_id, when_false_block_id);
+    build_hinted_cond_break(builder, condition, when_true_block_id, when_false_block_id, expr->likely);
 
     // Generate instructions for when condition is true
     build_using_basicblock(builder, when_true_block_id);
@@ -2367,44 +2444,26 @@ errorcode_t ir_gen_expr_crement(ir_builder_t *builder, ast_expr_unary_t *expr, i
     }
 
     ir_type_t *type = (ir_type_t*) mutable_expr->type->extra;
-    void *extra = NULL;
-    
+    ir_value_t *one = NULL;
+
+    // Generate an IR value of '1' for the type we're working with,
+    // which is shared with other identical literals
     switch(type->kind){
-    case TYPE_KIND_S8:
-        extra = ir_pool_alloc_init(builder->pool, adept_byte, 1);
-        break;
-    case TYPE_KIND_U8:
-        extra = ir_pool_alloc_init(builder->pool, adept_ubyte, 1);
-        break;
-    case TYPE_KIND_S16:
-        extra = ir_pool_alloc_init(builder->pool, adept_short, 1);
-        break;
-    case TYPE_KIND_U16:
-        extra = ir_pool_alloc_init(builder->pool, adept_ushort, 1);
-        break;
-    case TYPE_KIND_S32:
-        extra = ir_pool_alloc_init(builder->pool, adept_int, 1);
-        break;
-    case TYPE_KIND_U32:
-        extra = ir_pool_alloc_init(builder->pool, adept_uint, 1);
-        break;
-    case TYPE_KIND_S64:
-        extra = ir_pool_alloc_init(builder->pool, adept_long, 1);
-        break;
-    case TYPE_KIND_U64:
-        extra = ir_pool_alloc_init(builder->pool, adept_ulong, 1);
-        break;
-    case TYPE_KIND_FLOAT:
-        extra = ir_pool_alloc_init(builder->pool, adept_float, 1.0f);
-        break;
-    case TYPE_KIND_DOUBLE:
-        extra = ir_pool_alloc_init(builder->pool, adept_double, 1.0);
-        break;
+    case TYPE_KIND_S8:     one = ir_const_pool_literal(builder->pool, type->kind, &(adept_byte){1});     break;
+    case TYPE_KIND_U8:     one = ir_const_pool_literal(builder->pool, type->kind, &(adept_ubyte){1});    break;
+    case TYPE_KIND_S16:    one = ir_const_pool_literal(builder->pool, type->kind, &(adept_short){1});    break;
+    case TYPE_KIND_U16:    one = ir_const_pool_literal(builder->pool, type->kind, &(adept_ushort){1});   break;
+    case TYPE_KIND_S32:    one = ir_const_pool_literal(builder->pool, type->kind, &(adept_int){1});      break;
+    case TYPE_KIND_U32:    one = ir_const_pool_literal(builder->pool, type->kind, &(adept_uint){1});     break;
+    case TYPE_KIND_S64:    one = ir_const_pool_literal(builder->pool, type->kind, &(adept_long){1});     break;
+    case TYPE_KIND_U64:    one = ir_const_pool_literal(builder->pool, type->kind, &(adept_ulong){1});    break;
+    case TYPE_KIND_FLOAT:  one = ir_const_pool_literal(builder->pool, type->kind, &(adept_float){1.0f}); break;
+    case TYPE_KIND_DOUBLE: one = ir_const_pool_literal(builder->pool, type->kind, &(adept_double){1.0}); break;
     }
 
     // If we couldn't create a value for 'one' of that type, so
     // we can't perform the -crement instruction on this value
-    if(extra == NULL){
+    if(one == NULL){
         strong_cstr_t typename = ast_type_str(&mutable_expr_ast_type);
         compiler_panicf(builder->compiler, expr->source, "Can't %s type '%s'",
             expr->id == EXPR_PREINCREMENT || expr->id == EXPR_POSTINCREMENT ? "increment" : "decrement", typename);
@@ -2413,13 +2472,6 @@ errorcode_t ir_gen_expr_crement(ir_builder_t *builder, ast_expr_unary_t *expr, i
         return FAILURE;
     }
 
-    // Generate an IR value of '1' for the type we're working with
-    ir_value_t *one = ir_pool_alloc_init(builder->pool, ir_value_t, {
-        .value_type = VALUE_TYPE_LITERAL,
-        .type = type,
-        .extra = extra,
-    });
-
     ir_value_t *before_value_immutable = build_load(builder, mutable_expr, expr->source);
     unsigned int instr_id = INSTRUCTION_NONE;
 
@@ -2500,11 +2552,7 @@ errorcode_t ir_gen_expr_toggle(ir_builder_t *builder, ast_expr_unary_t *expr, ir
     ir_value_t *loaded = build_load(builder, mutable_value, expr->source);
     
     // Perform 'not' operation
-    ir_instr_unary_t *isz_instr = (ir_instr_unary_t*) build_instruction(builder, sizeof(ir_instr_unary_t));
-    isz_instr->id = INSTRUCTION_ISZERO;
-    isz_instr->result_type = ir_builder_bool(builder);
-    isz_instr->value = loaded;
-    ir_value_t *notted = build_value_from_prev_instruction(builder);
+    ir_value_t *notted = build_unary(builder, INSTRUCTION_ISZERO, loaded, ir_builder_bool(builder));
     
     // Store it back into memory
     build_store(builder, notted, mutable_value, expr->source);
@@ -2747,6 +2795,13 @@ errorcode_t ir_gen_math(
         return FAILURE;
     }
 
+    if(info->result_is_boolean && common_ir_type->kind == TYPE_KIND_VECTOR){
+        // Comparing vectors produces a lane mask instead of a single boolean
+        errorcode_t errorcode = ir_gen_vector_compare(builder, instr_id, ops->lhs, ops->rhs, &common_ast_type, ir_value, out_expr_type);
+        ast_type_free(&common_ast_type);
+        return errorcode;
+    }
+
     *ir_value = build_math(builder, instr_id, ops->lhs, ops->rhs, info->result_is_boolean ? ir_builder_bool(builder) : common_ir_type);
 
     // Write the result type, will either be a boolean or the same type as the given arguments
@@ -2823,12 +2878,12 @@ errorcode_t ir_gen_call_function_value(ir_builder_t *builder, ast_type_t *tmp_as
             compiler_panic(builder->compiler, call->source, "INTERNAL ERROR: Expected actual and calling argument types to be the same");
             strong_cstr_t a = ir_type_str(param_types[i]);
             strong_cstr_t b = ir_type_str(arg_values[i]->type);
-            printf("Expected: %s vs Actual: %s for argument #%d\n", a, b, 1 + (int) i);
+            compiler_hintf(builder->compiler, "Expected: %s vs Actual: %s for argument #%d\n", a, b, 1 + (int) i);
             free(a);
             free(b);
             strong_cstr_t expected_ast_type_name = ast_type_str(&function_elem->arg_types[i]);
             strong_cstr_t actual_ast_type_name = ast_type_str(&arg_types[i]);
-            printf("Expected value of AST type: %s, Actual AST type: %s\n", expected_ast_type_name, actual_ast_type_name);
+            compiler_hintf(builder->compiler, "Expected value of AST type: %s, Actual AST type: %s\n", expected_ast_type_name, actual_ast_type_name);
             free(expected_ast_type_name);
             free(actual_ast_type_name);
             return FAILURE;
@@ -2995,6 +3050,9 @@ enum ir_type_category ir_type_get_category(ir_type_t *type){
     case TYPE_KIND_DOUBLE:
         // Floating point like values
         return PRIMITIVE_FP;
+    case TYPE_KIND_VECTOR:
+        // Vectors behave like their elements
+        return ir_type_get_category(((ir_type_extra_vector_t*) type->extra)->subtype);
     default:
         // Otherwise, no category
         return PRIMITIVE_NA;
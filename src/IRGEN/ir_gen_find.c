@@ -10,6 +10,7 @@
 #include "AST/ast_type.h"
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
+#include "IR/ir.h"
 #include "IR/ir_func_endpoint.h"
 #include "IR/ir_module.h"
 #include "IR/ir_pool.h"
@@ -22,9 +23,11 @@
 #include "IRGEN/ir_gen_find.h"
 #include "IRGEN/ir_gen_polymorphable.h"
 #include "IRGEN/ir_gen_type.h"
+#include "IRGEN/ir_speculation.h"
 #include "UTIL/color.h"
 #include "UTIL/func_pair.h"
 #include "UTIL/ground.h"
+#include "UTIL/search.h"
 #include "UTIL/trait.h"
 
 static const trait_t normal_forbidden_traits = AST_FUNC_VIRTUAL | AST_FUNC_OVERRIDE;
@@ -177,7 +180,7 @@ static errorcode_t actualize_suitable_polymorphic(ir_proc_query_t *query, option
 
     // Validate and fill in argument gaps
     {
-        ast_func_t *ast_func = &object->ast.funcs[ast_func_id];
+        ast_func_t *ast_func = ast_funcs_at(&object->ast.funcs, ast_func_id);
 
         if(ast_func->traits & AST_FUNC_DISALLOW){
             strong_cstr_t display = ast_func_head_str(ast_func);
@@ -192,6 +195,9 @@ static errorcode_t actualize_suitable_polymorphic(ir_proc_query_t *query, option
         }
     }
 
+    // Polymorphic functions can't be instantiated speculatively
+    if(ir_speculation_give_up(object->ir_module.speculation)) return ALT_FAILURE;
+
     // Instantiate polymorphic function
     ir_func_endpoint_t instance;
 
@@ -199,7 +205,7 @@ static errorcode_t actualize_suitable_polymorphic(ir_proc_query_t *query, option
     length_t arg_types_length = ir_proc_query_getter_length(query);
 
     if(instantiate_poly_func(compiler, object, query->from_source, endpoint.ast_func_id, arg_types, arg_types_length, catalog, query->instantiation_depth, &instance)){
-        ast_func_t *poly_func = &object->ast.funcs[ast_func_id];
+        ast_func_t *poly_func = ast_funcs_at(&object->ast.funcs, ast_func_id);
 
         strong_cstr_t display = ast_func_head_str(poly_func);
         compiler_panicf(compiler, poly_func->source, "Cannot instantiate polymorphic function with given types", display);
@@ -221,7 +227,7 @@ static errorcode_t actualize_suitable_polymorphic(ir_proc_query_t *query, option
 static errorcode_t actualize_suitable_nonpolymorphic(ir_proc_query_t *query, optional_func_pair_t *result, ir_func_endpoint_t endpoint){
     object_t *object = ir_proc_query_getter_object(query);
 
-    if(ir_gen_fill_in_default_arguments(query, &object->ast.funcs[endpoint.ast_func_id], NULL)){
+    if(ir_gen_fill_in_default_arguments(query, ast_funcs_at(&object->ast.funcs, endpoint.ast_func_id), NULL)){
         return ALT_FAILURE;
     }
 
@@ -232,7 +238,7 @@ static errorcode_t actualize_suitable_nonpolymorphic(ir_proc_query_t *query, opt
 static errorcode_t ir_gen_find_proc_sweep_partial(ir_proc_query_t *query, optional_func_pair_t *result, unsigned int conform_mode_if_applicable, ir_func_endpoint_t endpoint){
     compiler_t *compiler = ir_proc_query_getter_compiler(query);
     object_t *object = ir_proc_query_getter_object(query);
-    ast_func_t *ast_func = &object->ast.funcs[endpoint.ast_func_id];
+    ast_func_t *ast_func = ast_funcs_at(&object->ast.funcs, endpoint.ast_func_id);
 
     // Do function trait restrictions
     if((ast_func->traits & query->traits_mask) != query->traits_match || (ast_func->traits & query->forbid_traits)){
@@ -318,7 +324,9 @@ static errorcode_t ir_gen_find_proc_sweep_proc_map(
     int (*compare)(const void*, const void*)
 ){
     ir_func_endpoint_list_t *endpoint_list = ir_proc_map_find(proc_map, key, sizeof_key, compare);
-    
+    ir_module_t *ir_module = &ir_proc_query_getter_object(query)->ir_module;
+
+    ir_speculation_record_lookup(ir_module->speculation, compare == &compare_ir_method_key, key, endpoint_list);
     return ir_gen_find_proc_sweep_endpoint_list(query, result, conform_mode_if_applicable, endpoint_list);
 }
 
@@ -405,6 +413,8 @@ errorcode_t ir_gen_find_func_named(object_t *object, weak_cstr_t name, bool *out
         &compare_ir_func_key
     );
 
+    ir_speculation_record_lookup(object->ir_module.speculation, false, &(ir_func_key_t){ .name = name }, endpoint_list);
+
     if(endpoint_list == NULL) return FAILURE;
 
     ir_func_endpoint_t endpoint;
@@ -414,13 +424,11 @@ errorcode_t ir_gen_find_func_named(object_t *object, weak_cstr_t name, bool *out
         endpoint = endpoint_list->endpoints[0];
         goto found;
     } else {
-        ast_func_t *funcs = object->ast.funcs;
-
         // Find first endpoint that isn't polymorphic
         for(length_t i = 0; i != endpoint_list->length; i++){
             endpoint = endpoint_list->endpoints[i];
 
-            if(!(funcs[endpoint.ast_func_id].traits & AST_FUNC_POLYMORPHIC)){
+            if(!(ast_funcs_at(&object->ast.funcs, endpoint.ast_func_id)->traits & AST_FUNC_POLYMORPHIC)){
                 goto found;
             }
         }
@@ -568,7 +576,7 @@ errorcode_t ir_gen_find_singular_special_func(compiler_t *compiler, object_t *ob
     if(ir_gen_find_func_named(object, func_name, &is_unique, &result, false) == SUCCESS){
         // Found special function
 
-        source_t source = object->ast.funcs[result.ast_func_id].source;
+        source_t source = ast_funcs_at(&object->ast.funcs, result.ast_func_id)->source;
         
         if(!is_unique && compiler_warnf(compiler, source, "Using this definition of %s, but there are multiple possibilities", func_name)){
             return ALT_FAILURE;
@@ -580,3 +588,21 @@ errorcode_t ir_gen_find_singular_special_func(compiler_t *compiler, object_t *ob
     
     return FAILURE;
 }
+
+successful_t ir_gen_find_intrinsic(weak_cstr_t name, unsigned int *out_intrinsic){
+    // NOTE: Must be kept sorted
+    static const char * const intrinsic_names[] = {
+        "bswap", "ctlz", "ctpop", "cttz", "expect", "fma", "fshl", "fshr", "prefetch", "sqrt"
+    };
+
+    static const unsigned int intrinsic_ids[] = {
+        IR_INTRINSIC_BSWAP, IR_INTRINSIC_CTLZ, IR_INTRINSIC_CTPOP, IR_INTRINSIC_CTTZ, IR_INTRINSIC_EXPECT,
+        IR_INTRINSIC_FMA, IR_INTRINSIC_FSHL, IR_INTRINSIC_FSHR, IR_INTRINSIC_PREFETCH, IR_INTRINSIC_SQRT
+    };
+
+    maybe_index_t index = binary_string_search_const(intrinsic_names, NUM_ITEMS(intrinsic_names), name);
+    if(index == -1) return false;
+
+    *out_intrinsic = intrinsic_ids[index];
+    return true;
+}
@@ -0,0 +1,174 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "AST/ast_expr.h"
+#include "AST/ast_type.h"
+#include "AST/ast_type_lean.h"
+#include "DRVR/compiler.h"
+#include "IR/ir.h"
+#include "IR/ir_fold.h"
+#include "IR/ir_pool.h"
+#include "IR/ir_type.h"
+#include "IR/ir_type_map.h"
+#include "IR/ir_value.h"
+#include "IRGEN/ir_build_instr.h"
+#include "IRGEN/ir_build_literal.h"
+#include "IRGEN/ir_builder.h"
+#include "IRGEN/ir_gen_expr.h"
+#include "IRGEN/ir_gen_intrinsic.h"
+#include "IRGEN/ir_gen_type.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+
+static errorcode_t ir_gen_intrinsic_constant_hint(ir_builder_t *builder, ast_expr_call_t *expr, ir_value_t *value, length_t index, unsigned long long max_value, ir_value_t **out_hint){
+    // Hints given to intrinsics must be constant integers (or booleans) known at compile time
+    ir_value_t *hint = ir_fold_scalar_literal(builder->pool, value);
+    source_t source = expr->args[index]->source;
+
+    if(hint == NULL || hint->value_type != VALUE_TYPE_LITERAL || ir_type_get_category(hint->type) == PRIMITIVE_FP){
+        compiler_panicf(builder->compiler, source, "Argument %d of '%s' must be a constant integer", (int) (index + 1), expr->name);
+        return FAILURE;
+    }
+
+    unsigned long long hint_value = ir_value_uniqueness_value(builder->pool, &hint);
+
+    if(hint_value > max_value){
+        compiler_panicf(builder->compiler, source, "Argument %d of '%s' must be between 0 and %d", (int) (index + 1), expr->name, (int) max_value);
+        return FAILURE;
+    }
+
+    *out_hint = build_literal_int(builder->pool, hint_value);
+    return SUCCESS;
+}
+
+static errorcode_t ir_gen_intrinsic_prefetch(ir_builder_t *builder, ast_expr_call_t *expr, ir_value_t **arg_values,
+        ir_value_t **ir_value, ast_type_t *out_expr_type){
+
+    if((expr->arity != 1 && expr->arity != 3) || arg_values[0]->type->kind != TYPE_KIND_POINTER){
+        compiler_panicf(builder->compiler, expr->source, "Builtin 'prefetch' expects a pointer, optionally followed by constant 'for_write' and 'locality' hints");
+        return FAILURE;
+    }
+
+    ir_value_t **values = ir_pool_alloc(builder->pool, sizeof(ir_value_t*) * 3);
+    values[0] = build_bitcast(builder, arg_values[0], builder->ptr_type);
+
+    if(expr->arity == 3){
+        // Whether the memory will be written to (0 or 1), and how long to keep it cached (0 to 3)
+        if(ir_gen_intrinsic_constant_hint(builder, expr, arg_values[1], 1, 1, &values[1])
+        || ir_gen_intrinsic_constant_hint(builder, expr, arg_values[2], 2, 3, &values[2])){
+            return FAILURE;
+        }
+    } else {
+        // By default, prefetch for reading and keep the memory in all levels of cache
+        values[1] = build_literal_int(builder->pool, 0);
+        values[2] = build_literal_int(builder->pool, 3);
+    }
+
+    ir_type_t *void_type;
+    if(!ir_type_map_find(builder->type_map, "void", &void_type)) return FAILURE;
+
+    *ir_value = build_intrinsic(builder, IR_INTRINSIC_PREFETCH, void_type, values, 3);
+
+    if(out_expr_type != NULL){
+        *out_expr_type = ast_type_make_base(strclone("void"));
+    }
+
+    return SUCCESS;
+}
+
+static bool ir_gen_intrinsic_accepts(unsigned int intrinsic, ir_type_t *type){
+    // Intrinsics operate on scalars and on each lane of vectors
+    bool is_vector = type->kind == TYPE_KIND_VECTOR;
+    ir_type_t *element_type = is_vector ? ((ir_type_extra_vector_t*) type->extra)->subtype : type;
+
+    enum ir_type_category category = ir_type_get_category(element_type);
+    bool is_integer = category == PRIMITIVE_SI || category == PRIMITIVE_UI;
+
+    switch(intrinsic){
+    case IR_INTRINSIC_FMA:
+    case IR_INTRINSIC_SQRT:
+        return category == PRIMITIVE_FP;
+    case IR_INTRINSIC_EXPECT:
+        return !is_vector && (is_integer || element_type->kind == TYPE_KIND_BOOLEAN);
+    case IR_INTRINSIC_BSWAP:
+        // Byte swapping requires at least two bytes
+        return is_integer && global_type_kind_sizes_in_bits_64[element_type->kind] >= 16;
+    default:
+        return is_integer;
+    }
+}
+
+errorcode_t ir_gen_intrinsic(ir_builder_t *builder, ast_expr_call_t *expr, unsigned int intrinsic,
+        ir_value_t **arg_values, ast_type_t *arg_types, ir_value_t **ir_value, ast_type_t *out_expr_type){
+
+    ir_value_t *result;
+
+    if(intrinsic == IR_INTRINSIC_PREFETCH){
+        if(ir_gen_intrinsic_prefetch(builder, expr, arg_values, &result, out_expr_type)) return FAILURE;
+        if(ir_value) *ir_value = result;
+        return SUCCESS;
+    }
+
+    length_t arity;
+
+    switch(intrinsic){
+    case IR_INTRINSIC_FMA: case IR_INTRINSIC_FSHL: case IR_INTRINSIC_FSHR:
+        arity = 3;
+        break;
+    case IR_INTRINSIC_EXPECT:
+        arity = 2;
+        break;
+    default:
+        arity = 1;
+    }
+
+    if(expr->arity != arity){
+        compiler_panicf(builder->compiler, expr->source, "Builtin '%s' expects %d argument%s, got %d",
+                expr->name, (int) arity, arity == 1 ? "" : "s", (int) expr->arity);
+        return FAILURE;
+    }
+
+    // Every operand has the same type as the first
+    for(length_t i = 1; i != arity; i++){
+        if(!ast_types_conform(builder, &arg_values[i], &arg_types[i], &arg_types[0], CONFORM_MODE_CALCULATION)){
+            strong_cstr_t expected = ast_type_str(&arg_types[0]);
+            strong_cstr_t given = ast_type_str(&arg_types[i]);
+            compiler_panicf(builder->compiler, expr->args[i]->source, "Argument %d of '%s' must be of type '%s', got '%s'",
+                    (int) (i + 1), expr->name, expected, given);
+            free(expected);
+            free(given);
+            return FAILURE;
+        }
+    }
+
+    ir_type_t *type = arg_values[0]->type;
+
+    if(!ir_gen_intrinsic_accepts(intrinsic, type)){
+        strong_cstr_t given = ast_type_str(&arg_types[0]);
+        compiler_panicf(builder->compiler, expr->source, "Builtin '%s' cannot be used on values of type '%s'", expr->name, given);
+        free(given);
+        return FAILURE;
+    }
+
+    if(intrinsic == IR_INTRINSIC_FMA || intrinsic == IR_INTRINSIC_SQRT){
+        // These may be lowered to calls into the C math library when the target lacks instructions for them
+        builder->compiler->use_libm = true;
+    }
+
+    ir_value_t **values = ir_pool_alloc(builder->pool, sizeof(ir_value_t*) * arity);
+
+    for(length_t i = 0; i != arity; i++){
+        values[i] = arg_values[i];
+    }
+
+    result = build_intrinsic(builder, intrinsic, type, values, arity);
+
+    if(ir_value) *ir_value = result;
+
+    if(out_expr_type != NULL){
+        *out_expr_type = ast_type_clone(&arg_types[0]);
+    }
+
+    return SUCCESS;
+}
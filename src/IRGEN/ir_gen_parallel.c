@@ -0,0 +1,512 @@
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "AST/TYPE/ast_type_identical.h"
+#include "AST/ast.h"
+#include "AST/ast_expr.h"
+#include "AST/ast_type.h"
+#include "BRIDGE/bridge.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "IR/ir.h"
+#include "IR/ir_pool.h"
+#include "IR/ir_type.h"
+#include "IR/ir_value.h"
+#include "IRGEN/ir_build_instr.h"
+#include "IRGEN/ir_build_literal.h"
+#include "IRGEN/ir_builder.h"
+#include "IRGEN/ir_gen.h"
+#include "IRGEN/ir_gen_expr.h"
+#include "IRGEN/ir_gen_parallel.h"
+#include "IRGEN/ir_gen_soa.h"
+#include "IRGEN/ir_gen_stmt.h"
+#include "IRGEN/ir_gen_type.h"
+#include "UTIL/ground.h"
+#include "UTIL/trait.h"
+
+// Indices of the parameters of the outlined loop body function,
+// which is called as 'body(env, begin, end)' for each chunk
+#define PARALLEL_ENV_ARG   0
+#define PARALLEL_BEGIN_ARG 1
+#define PARALLEL_END_ARG   2
+
+typedef struct {
+    weak_cstr_t label;
+    weak_cstr_t idx_name;
+    weak_cstr_t it_name;
+    ast_type_t *it_type;  // NULL for 'repeat' loops
+    ir_type_t *array_type; // NULL for 'repeat' loops
+    ast_expr_list_t *statements;
+    ast_parallel_t *parallel;
+    source_t source;
+} ir_gen_parallel_loop_t;
+
+typedef struct {
+    ast_type_t ast_type;
+    ir_value_t *shared;
+    length_t private_id;
+    unsigned int operation;
+} ir_gen_reduction_t;
+
+static const char *ir_gen_reduction_operator(unsigned int op){
+    switch(op){
+    case EXPR_ADD:     return "+";
+    case EXPR_BIT_AND: return "&";
+    case EXPR_BIT_OR:  return "|";
+    case EXPR_BIT_XOR: return "^";
+    case EXPR_LESSER:  return "min";
+    case EXPR_GREATER: return "max";
+    default:           return "<unknown reduction>";
+    }
+}
+
+static bool ir_gen_reduction_allowed(unsigned int op, ir_type_t *type){
+    switch(type->kind){
+    case TYPE_KIND_S8: case TYPE_KIND_S16: case TYPE_KIND_S32: case TYPE_KIND_S64:
+    case TYPE_KIND_U8: case TYPE_KIND_U16: case TYPE_KIND_U32: case TYPE_KIND_U64:
+        return true;
+    case TYPE_KIND_HALF: case TYPE_KIND_FLOAT: case TYPE_KIND_DOUBLE:
+        return op == EXPR_ADD;
+    default:
+        return false;
+    }
+}
+
+static errorcode_t ir_gen_reductions_init(ir_builder_t *body, ast_parallel_t *parallel, ir_gen_reduction_t *reductions){
+    for(length_t i = 0; i != parallel->reductions_length; i++){
+        ast_reduction_t *reduction = &parallel->reductions[i];
+        ir_gen_reduction_t *ir_reduction = &reductions[i];
+
+        // Get a pointer to the shared variable before it's shadowed by the private copy
+        ast_expr_variable_t variable = {
+            .id = EXPR_VARIABLE,
+            .source = reduction->source,
+            .name = reduction->name,
+        };
+
+        if(ir_gen_expr_variable(body, &variable, &ir_reduction->shared, true, &ir_reduction->ast_type)){
+            ir_reduction->ast_type = AST_TYPE_NONE;
+            return FAILURE;
+        }
+
+        ir_type_t *ir_type = ir_type_dereference(ir_reduction->shared->type);
+        ir_reduction->operation = ir_instr_choosing_run(&ir_gen_math_specs[reduction->op].choices, ir_type);
+
+        if(!ir_gen_reduction_allowed(reduction->op, ir_type) || ir_atomic_rmw_operation_name(ir_reduction->operation) == NULL){
+            strong_cstr_t typename = ast_type_str(&ir_reduction->ast_type);
+            compiler_panicf(body->compiler, reduction->source, "Cannot reduce variable '%s' of type '%s' using '%s'",
+                    reduction->name, typename, ir_gen_reduction_operator(reduction->op));
+            free(typename);
+            return FAILURE;
+        }
+
+        bridge_var_t *private = ir_builder_add_variable(body, reduction->name, &ir_reduction->ast_type, ir_type, BRIDGE_VAR_POD | BRIDGE_VAR_UNDEF);
+        ir_reduction->private_id = private->id;
+
+        ir_value_t *private_ptr = build_lvarptr(body, ir_type_make_pointer_to(body->pool, ir_type), private->id);
+
+        switch(reduction->op){
+        case EXPR_ADD:
+        case EXPR_BIT_OR:
+        case EXPR_BIT_XOR:
+            build_zeroinit(body, private_ptr);
+            break;
+        default:
+            // These operations are idempotent, so starting from the
+            // shared value is the same as starting from their identity
+            build_store(body, build_atomic_load(body, ir_reduction->shared, IR_ATOMIC_RELAXED), private_ptr, reduction->source);
+        }
+    }
+
+    return SUCCESS;
+}
+
+static errorcode_t ir_gen_parallel_body(ir_builder_t *enclosing, ir_gen_parallel_loop_t *loop, ir_parallel_body_t *parallel_body, func_id_t *out_ir_func_id){
+    compiler_t *compiler = enclosing->compiler;
+    object_t *object = enclosing->object;
+    ir_pool_t *pool = enclosing->pool;
+
+    func_id_t ir_func_id;
+    if(ir_gen_func_template(compiler, object, "__parallel_loop__", loop->source, &ir_func_id)) return FAILURE;
+
+    ir_func_t *enclosing_func = ir_funcs_at(&object->ir_module.funcs, enclosing->ir_func_id);
+    ir_func_t *module_func = ir_funcs_at(&object->ir_module.funcs, ir_func_id);
+
+    ast_type_t *usize_ast_type = &object->ast.common.ast_usize_type;
+    ir_type_t *usize_type = ir_builder_usize(enclosing);
+    ir_type_t *usize_ptr_type = ir_builder_usize_ptr(enclosing);
+    ir_type_t *env_type = ir_type_make_pointer_to(pool, enclosing->ptr_type);
+
+    module_func->argument_types = malloc(sizeof(ir_type_t*) * 3);
+    module_func->argument_types[PARALLEL_ENV_ARG] = env_type;
+    module_func->argument_types[PARALLEL_BEGIN_ARG] = usize_type;
+    module_func->argument_types[PARALLEL_END_ARG] = usize_type;
+    module_func->arity = 3;
+    module_func->return_type = ir_pool_alloc(pool, sizeof(ir_type_t));
+    module_func->return_type->kind = TYPE_KIND_VOID;
+
+    // The address of the body is handed to the runtime, and it should be
+    // optimized the same way as the function that contains the loop
+    module_func->traits = IR_FUNC_ADDRESS_TAKEN | (enclosing_func->traits & (IR_FUNC_HOT | IR_FUNC_COLD
+            | IR_FUNC_OPTIMIZE_NONE | IR_FUNC_OPTIMIZE_SIZE | IR_FUNC_OPTIMIZE_AGGRESSIVE));
+
+    module_func->maybe_filename = enclosing_func->maybe_filename;
+    module_func->maybe_definition_string = enclosing_func->maybe_definition_string;
+    module_func->maybe_line_number = enclosing_func->maybe_line_number;
+    module_func->maybe_column_number = enclosing_func->maybe_column_number;
+
+    ir_builder_t body;
+    ir_builder_init(&body, compiler, object, enclosing->ast_func_id, ir_func_id, false);
+    body.parallel_body = parallel_body;
+
+    ir_builder_add_variable(&body, "$____parallel_env____$", usize_ast_type, env_type, BRIDGE_VAR_POD | BRIDGE_VAR_UNDEF);
+    ir_builder_add_variable(&body, "$____parallel_begin____$", usize_ast_type, usize_type, BRIDGE_VAR_POD | BRIDGE_VAR_UNDEF);
+    ir_builder_add_variable(&body, "$____parallel_end____$", usize_ast_type, usize_type, BRIDGE_VAR_POD | BRIDGE_VAR_UNDEF);
+    parallel_body->env_var_id = PARALLEL_ENV_ARG;
+
+    bridge_scope_t *root_scope = body.scope;
+    ir_builder_open_scope(&body);
+
+    errorcode_t errorcode = FAILURE;
+    length_t reductions_length = loop->parallel->reductions_length;
+    ir_gen_reduction_t *reductions = calloc(reductions_length ? reductions_length : 1, sizeof(ir_gen_reduction_t));
+
+    // Create index variable, starting at the beginning of the chunk
+    ir_builder_add_variable(&body, loop->idx_name, usize_ast_type, usize_type, BRIDGE_VAR_POD | BRIDGE_VAR_UNDEF);
+    ir_value_t *idx_ptr = build_lvarptr(&body, usize_ptr_type, body.next_var_id - 1);
+    build_store(&body, build_load(&body, build_lvarptr(&body, usize_ptr_type, PARALLEL_BEGIN_ARG), loop->source), idx_ptr, loop->source);
+
+    // Array of 'each in' loops is always the first item of the environment
+    ir_value_t *array = NULL;
+    length_t it_var_id = 0;
+
+    if(loop->array_type){
+        ir_value_t *env = build_load(&body, build_lvarptr(&body, ir_type_make_pointer_to(pool, env_type), PARALLEL_ENV_ARG), loop->source);
+        array = build_bitcast(&body, build_load(&body, env, loop->source), loop->array_type);
+
+        bridge_var_t *it = ir_builder_add_variable(&body, loop->it_name, loop->it_type, loop->array_type, BRIDGE_VAR_POD | BRIDGE_VAR_REFERENCE);
+        it_var_id = it->id;
+    }
+
+    if(ir_gen_reductions_init(&body, loop->parallel, reductions)) goto failure;
+
+    length_t prep_basicblock_id = build_basicblock(&body);
+    length_t new_basicblock_id  = build_basicblock(&body);
+    length_t inc_basicblock_id  = build_basicblock(&body);
+    length_t end_basicblock_id  = build_basicblock(&body);
+
+    // Generate (idx < end)
+    build_using_basicblock(&body, prep_basicblock_id);
+    ir_value_t *end = build_load(&body, build_lvarptr(&body, usize_ptr_type, PARALLEL_END_ARG), loop->source);
+    ir_value_t *whether_keep_going_value = build_math(&body, INSTRUCTION_ULESSER, build_load(&body, idx_ptr, loop->source), end, ir_builder_bool(&body));
+    build_cond_break(&body, whether_keep_going_value, new_basicblock_id, end_basicblock_id);
+
+    build_using_basicblock(&body, new_basicblock_id);
+
+    // Update 'it' value
+    if(array){
+        ir_value_t *it_idx = build_load(&body, idx_ptr, loop->source);
+        ir_value_t *it_ptr = build_lvarptr(&body, ir_type_make_pointer_to(pool, loop->array_type), it_var_id);
+        build_store(&body, build_array_access(&body, array, it_idx, loop->source), it_ptr, loop->source);
+    }
+
+    // Breaking out of the loop is rejected during parsing, so only continuing is possible
+    if(loop->label != NULL) ir_builder_push_loop_label(&body, loop->label, end_basicblock_id, inc_basicblock_id);
+
+    body.continue_block_id = inc_basicblock_id;
+    body.break_continue_scope = root_scope;
+
+    // Generate new_block user-defined statements
+    bool terminated;
+    if(ir_gen_stmts(&body, loop->statements, &terminated)) goto failure;
+
+    if(!terminated){
+        if(handle_deference_for_variables(&body, &body.scope->list)) goto failure;
+        build_break(&body, inc_basicblock_id);
+    }
+
+    // Increment
+    build_using_basicblock(&body, inc_basicblock_id);
+    ir_value_t *incremented = build_math(&body, INSTRUCTION_ADD, build_load(&body, idx_ptr, loop->source), build_literal_usize(pool, 1), usize_type);
+    build_store(&body, incremented, idx_ptr, loop->source);
+    build_break(&body, prep_basicblock_id);
+
+    // Combine private copies of reduced variables into the shared variables
+    build_using_basicblock(&body, end_basicblock_id);
+
+    for(length_t i = 0; i != reductions_length; i++){
+        ir_value_t *private_ptr = build_lvarptr(&body, reductions[i].shared->type, reductions[i].private_id);
+        build_atomic_rmw(&body, reductions[i].operation, reductions[i].shared, build_load(&body, private_ptr, loop->source), IR_ATOMIC_RELAXED);
+    }
+
+    build_return(&body, NULL);
+
+    // Finish off initial basic block, now that every captured variable is known
+    build_using_basicblock(&body, 0);
+    build_break(&body, prep_basicblock_id);
+
+    *out_ir_func_id = ir_func_id;
+    errorcode = SUCCESS;
+
+failure:
+    ir_builder_close_scope(&body);
+
+    for(length_t i = 0; i != reductions_length; i++){
+        ast_type_free(&reductions[i].ast_type);
+    }
+
+    free(reductions);
+
+    module_func->scope->following_var_id = body.next_var_id;
+    module_func->variable_count = body.next_var_id;
+    module_func->basicblocks = body.basicblocks;
+    free(body.block_stack.blocks);
+    return errorcode;
+}
+
+static errorcode_t ir_gen_parallel_launch(ir_builder_t *builder, ir_gen_parallel_loop_t *loop, ir_value_t *array, ir_value_t *count){
+    ir_pool_t *pool = builder->pool;
+
+    ir_parallel_body_t parallel_body = {
+        .enclosing = builder,
+        .env_var_id = 0,
+        .captures = NULL,
+        .captures_length = 0,
+        .captures_capacity = 0,
+        .reserved_slots = array ? 1 : 0,
+    };
+
+    func_id_t body_func_id;
+    if(ir_gen_parallel_body(builder, loop, &parallel_body, &body_func_id)){
+        free(parallel_body.captures);
+        return FAILURE;
+    }
+
+    // Build environment, which is an array of pointers to everything the body uses
+    ir_type_t *env_type = ir_type_make_pointer_to(pool, builder->ptr_type);
+    length_t slots = parallel_body.reserved_slots + parallel_body.captures_length;
+    ir_value_t *env;
+
+    if(slots == 0){
+        env = build_null_pointer_of_type(pool, env_type);
+    } else {
+        ir_type_t *env_array_type = ir_type_make_fixed_array_of(pool, slots, builder->ptr_type);
+        bridge_var_t *env_var = ir_builder_add_variable(builder, "$____parallel_env____$", &builder->object->ast.common.ast_usize_type, env_array_type, BRIDGE_VAR_POD | BRIDGE_VAR_UNDEF);
+        env = build_bitcast(builder, build_lvarptr(builder, ir_type_make_pointer_to(pool, env_array_type), env_var->id), env_type);
+    }
+
+    if(array){
+        ir_value_t *slot = build_array_access(builder, env, build_literal_usize(pool, 0), loop->source);
+        build_store(builder, build_bitcast(builder, array, builder->ptr_type), slot, loop->source);
+    }
+
+    for(length_t i = 0; i != parallel_body.captures_length; i++){
+        bridge_var_t *variable = ir_builder_find_var(builder, parallel_body.captures[i]);
+        ir_value_t *address = build_varptr(builder, ir_type_make_pointer_to(pool, variable->ir_type), variable);
+
+        // Share what a reference refers to, rather than the reference itself
+        if(variable->traits & BRIDGE_VAR_REFERENCE){
+            address = build_load(builder, address, loop->source);
+        }
+
+        ir_value_t *slot = build_array_access(builder, env, build_literal_usize(pool, parallel_body.reserved_slots + i), loop->source);
+        build_store(builder, build_bitcast(builder, address, builder->ptr_type), slot, loop->source);
+    }
+
+    free(parallel_body.captures);
+
+    ir_value_t *body = build_func_addr(pool, ir_type_make_function_pointer(pool), body_func_id);
+    build_parallel_for(builder, body, env, count);
+
+    builder->compiler->use_libpthread = true;
+    return SUCCESS;
+}
+
+static void ir_gen_parallel_element_mismatch(ir_builder_t *builder, ast_type_t *given, ast_type_t *actual){
+    compiler_panic(builder->compiler, given->source, "Element type doesn't match given array's element type");
+
+    char *s1 = ast_type_str(given);
+    char *s2 = ast_type_str(actual);
+    compiler_hintf(builder->compiler, "(given element type : '%s', array element type : '%s')\n", s1, s2);
+    free(s1);
+    free(s2);
+}
+
+errorcode_t ir_gen_stmt_parallel_repeat(ir_builder_t *builder, ast_expr_repeat_t *stmt){
+    ast_type_t *idx_ast_type = &builder->object->ast.common.ast_usize_type;
+
+    // Generate length
+    const char *error_format = "Received type '%s' when array length should be '%s'";
+    ir_value_t *limit = ir_gen_conforming_expr(builder, stmt->limit, idx_ast_type, CONFORM_MODE_CALCULATION, stmt->source, error_format);
+    if(limit == NULL) return FAILURE;
+
+    ir_gen_parallel_loop_t loop = {
+        .label = stmt->label,
+        .idx_name = stmt->idx_name ? stmt->idx_name : "idx",
+        .it_name = NULL,
+        .it_type = NULL,
+        .array_type = NULL,
+        .statements = &stmt->statements,
+        .parallel = &stmt->parallel,
+        .source = stmt->source,
+    };
+
+    ir_builder_open_scope(builder);
+    errorcode_t errorcode = ir_gen_parallel_launch(builder, &loop, NULL, limit);
+    ir_builder_close_scope(builder);
+    return errorcode;
+}
+
+errorcode_t ir_gen_stmt_parallel_each(ir_builder_t *builder, ast_expr_each_in_t *stmt){
+    ast_type_t *idx_ast_type = &builder->object->ast.common.ast_usize_type;
+
+    ir_builder_open_scope(builder);
+
+    ast_expr_phantom_t *single_expr = NULL;
+
+    // NOTE: The follow values only exist if 'single_expr' isn't null
+    ir_value_t *single_value = NULL;
+    ast_type_t single_type;
+
+    bool list_was_mutable = true;
+
+    if(stmt->list){
+        if(ir_gen_expr(builder, stmt->list, &single_value, true, &single_type)) goto failure;
+
+        if(ir_gen_soa_find(builder->object, &single_type)){
+            compiler_panicf(builder->compiler, stmt->list->source, "SoA containers can't be iterated by parallel 'each in' loops");
+            ast_type_free(&single_type);
+            goto failure;
+        }
+
+        if(!expr_is_mutable(stmt->list)){
+            list_was_mutable = false;
+            ir_builder_add_variable(builder, "$____each_in_list____$", &single_type, single_value->type, BRIDGE_VAR_POD | BRIDGE_VAR_UNDEF);
+            ir_value_t *list_on_stack = build_lvarptr(builder, ir_type_make_pointer_to(builder->pool, single_value->type), builder->next_var_id - 1);
+            build_store(builder, single_value, list_on_stack, stmt->source);
+            single_value = list_on_stack;
+        }
+
+        single_expr = (ast_expr_phantom_t*) ast_expr_create_phantom(single_type, single_value, stmt->list->source, true);
+    }
+
+    // Unlike regular 'each in' loops, the array and its length are only computed once
+    ir_value_t *array;
+    ir_value_t *array_length;
+    ast_type_t temporary_type;
+
+    if(single_expr && ast_type_is_fixed_array(&single_type)){
+        // FIXED ARRAY
+        ast_type_t remaining_type = ast_type_unwrapped_view(&single_type);
+
+        if(!ast_types_identical(&remaining_type, stmt->it_type)){
+            ir_gen_parallel_element_mismatch(builder, stmt->it_type, &remaining_type);
+            goto failure;
+        }
+
+        if(!single_expr->is_mutable){
+            compiler_panicf(builder->compiler, single_type.source, "Fixed array given to 'each in' statement must be mutable");
+            goto failure;
+        }
+
+        ir_type_t *item_ir_type;
+        if(ir_gen_resolve_type(builder->compiler, builder->object, &remaining_type, &item_ir_type)) goto failure;
+
+        array = build_bitcast(builder, single_value, ir_type_make_pointer_to(builder->pool, item_ir_type));
+
+        // NOTE: Assumes element->id == AST_ELEM_FIXED_ARRAY because of earlier 'ast_type_is_fixed_array' call should've verified
+        ast_elem_fixed_array_t *fixed_array_element = (ast_elem_fixed_array_t*) single_type.elements[0];
+        array_length = build_literal_usize(builder->pool, fixed_array_element->length);
+    } else {
+        source_t length_source = single_expr ? single_expr->source : stmt->length->source;
+        source_t array_source = single_expr ? single_expr->source : stmt->low_array->source;
+
+        if(single_expr){
+            // STRUCTURE
+            ast_expr_call_method_t length_call;
+            ast_expr_create_call_method_in_place(&length_call, "__length__", (ast_expr_t*) single_expr, 0, NULL, false, true, NULL, single_expr->source);
+
+            if(ir_gen_expr(builder, (ast_expr_t*) &length_call, &array_length, false, &temporary_type)) goto failure;
+        } else if(ir_gen_expr(builder, stmt->length, &array_length, false, &temporary_type)){
+            goto failure;
+        }
+
+        // Ensure the given value for the array length is of type 'usize'
+        if(!ast_types_conform(builder, &array_length, &temporary_type, idx_ast_type, CONFORM_MODE_CALCULATION)){
+            char *a_type_str = ast_type_str(&temporary_type);
+            compiler_panicf(builder->compiler, length_source, "Received type '%s' when array length should be 'usize'", a_type_str);
+            free(a_type_str);
+
+            ast_type_free(&temporary_type);
+            goto failure;
+        }
+
+        ast_type_free(&temporary_type);
+
+        if(single_expr){
+            ast_expr_call_method_t array_call;
+            ast_expr_create_call_method_in_place(&array_call, "__array__", (ast_expr_t*) single_expr, 0, NULL, false, true, NULL, single_expr->source);
+
+            if(ir_gen_expr(builder, (ast_expr_t*) &array_call, &array, false, &temporary_type)) goto failure;
+        } else if(ir_gen_expr(builder, stmt->low_array, &array, false, &temporary_type)){
+            goto failure;
+        }
+
+        // Ensure the given value for the array is of a pointer type
+        if(!ast_type_is_pointer(&temporary_type)){
+            compiler_panic(builder->compiler, array_source, "Low-level array type for 'each in' statement must be a pointer");
+            ast_type_free(&temporary_type);
+            goto failure;
+        }
+
+        // Ensure the item type matches the item type provided
+        ast_type_dereference(&temporary_type);
+
+        if(!ast_types_identical(&temporary_type, stmt->it_type)){
+            ir_gen_parallel_element_mismatch(builder, stmt->it_type, &temporary_type);
+            ast_type_free(&temporary_type);
+            goto failure;
+        }
+
+        ast_type_free(&temporary_type);
+    }
+
+    ir_gen_parallel_loop_t loop = {
+        .label = stmt->label,
+        .idx_name = "idx",
+        .it_name = stmt->it_name ? stmt->it_name : "it",
+        .it_type = stmt->it_type,
+        .array_type = array->type,
+        .statements = &stmt->statements,
+        .parallel = &stmt->parallel,
+        .source = stmt->source,
+    };
+
+    if(ir_gen_parallel_launch(builder, &loop, array, array_length)) goto failure;
+
+    if(stmt->list && !list_was_mutable){
+        // Call '__defer__' on list value
+        if(handle_single_deference(builder, &single_type, single_value, stmt->list->source) == ALT_FAILURE) goto failure;
+    }
+
+    ir_builder_close_scope(builder);
+
+    if(single_expr){
+        ast_type_free(&single_expr->type);
+        free(single_expr);
+    }
+
+    return SUCCESS;
+
+failure:
+    ir_builder_close_scope(builder);
+
+    if(single_expr){
+        ast_type_free(&single_expr->type);
+        free(single_expr);
+    }
+
+    return FAILURE;
+}
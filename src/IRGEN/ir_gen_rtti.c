@@ -186,6 +186,52 @@ errorcode_t ir_gen__types__fixed_array_entry(object_t *object, ir_value_t **arra
     return SUCCESS;
 }
 
+errorcode_t ir_gen__types__vector_entry(object_t *object, ir_value_t **array_values, length_t array_value_index, ir_rtti_types_t *rtti_types){
+    // ---------------------------------------------------------------------------------------------
+    // struct AnyFixedArrayType (
+    //     kind AnyTypeKind,
+    //     name *ubyte,
+    //     is_alias bool,
+    //     size usize,
+    //     subtype *AnyType,
+    //     length usize
+    // )
+    // ---------------------------------------------------------------------------------------------
+
+    rtti_table_t *rtti_table = object->ir_module.rtti_table;
+    ir_module_t *ir_module = &object->ir_module;
+    ir_pool_t *pool = &ir_module->pool;
+
+    ir_value_t **result = &array_values[array_value_index];
+    rtti_table_entry_t *entry = &rtti_table->entries[array_value_index];
+
+    // Vectors are described by the type of their lanes and the number of lanes
+    ir_type_extra_vector_t *vector = (ir_type_extra_vector_t*) entry->ir_type->extra;
+    maybe_index_t vector_index = typename_vector_type(ast_type_base_name(&entry->resolved_ast_type));
+
+    if(vector_index == -1){
+        internalerrorprintf("ir_gen__types__vector_entry() - Received non-vector AST type in entry\n");
+        return FAILURE;
+    }
+
+    ast_type_t element_type = ast_type_make_base(strclone(global_vector_type_elements[vector_index]));
+    ir_value_t *subtype_rtti = ir_gen__types__get_rtti_pointer_for(object, &element_type, array_values, rtti_types);
+    ast_type_free(&element_type);
+
+    ir_value_t **fields = ir_pool_alloc(pool, sizeof(ir_value_t*) * 6);
+    ir_gen__types__entry_common_header(ir_module, entry, ANY_TYPE_KIND_VECTOR, fields);
+    fields[4] = as_vernacular_pointer(ir_module, subtype_rtti); // subtype
+    fields[5] = build_literal_usize(pool, vector->length);      // length
+
+    // Create struct literal and set as initializer
+    ir_value_t *initializer = build_struct_literal(ir_module, rtti_types->any_fixed_array_type_type, fields, 6, false);
+    ir_module_set_anon_global_initializer(ir_module, *result, initializer);
+
+    // Bitcast '*AnyFixedArrayType' to '*AnyType'
+    *result = build_const_bitcast(pool, *result, rtti_types->any_type_ptr_type);
+    return SUCCESS;
+}
+
 errorcode_t ir_gen__types__func_ptr_entry(object_t *object, ir_value_t **array_values, length_t array_value_index, ir_rtti_types_t *rtti_types){
     // ---------------------------------------------------------------------------------------------
     // struct AnyFuncPtrType (
@@ -620,6 +666,10 @@ ir_value_t **ir_gen__types__values(compiler_t *compiler, object_t *object, ir_rt
             // Fixed Array Types
             if(ir_gen__types__fixed_array_entry(object, array_values, i, rtti_types)) return NULL;
             continue;
+        case TYPE_KIND_VECTOR:
+            // SIMD Vector Types
+            if(ir_gen__types__vector_entry(object, array_values, i, rtti_types)) return NULL;
+            continue;
         case TYPE_KIND_FUNCPTR:
             // Function Pointer Types
             if(ir_gen__types__func_ptr_entry(object, array_values, i, rtti_types)) return NULL;
@@ -668,6 +718,7 @@ errorcode_t ir_gen__types__prepare_each_value(compiler_t *compiler, object_t *ob
             any_type_variant = rtti_types->any_funcptr_type_type;
             break;
         case TYPE_KIND_FIXED_ARRAY:
+        case TYPE_KIND_VECTOR:
             any_type_variant = rtti_types->any_fixed_array_type_type;
             break;
         default:
@@ -702,6 +753,139 @@ ir_value_t *ir_gen__types__get_rtti_pointer_for(object_t *object, ast_type_t *as
     }
 }
 
+static void ir_gen__types__mark_name_reachable(rtti_table_t *rtti_table, const char *name, bool *reachable, length_t *worklist, length_t *worklist_length){
+    maybe_index_t index = rtti_table_find_index(rtti_table, name);
+
+    if(index >= 0 && !reachable[index]){
+        reachable[index] = true;
+        worklist[(*worklist_length)++] = index;
+    }
+}
+
+static void ir_gen__types__mark_reachable(rtti_table_t *rtti_table, ast_type_t *ast_type, bool *reachable, length_t *worklist, length_t *worklist_length){
+    strong_cstr_t lookup_name = ast_type_str(ast_type);
+    ir_gen__types__mark_name_reachable(rtti_table, lookup_name, reachable, worklist, worklist_length);
+    free(lookup_name);
+}
+
+static errorcode_t ir_gen__types__mark_subtypes_reachable(compiler_t *compiler, object_t *object, rtti_table_entry_t *entry, bool *reachable, length_t *worklist, length_t *worklist_length){
+    // Marks the entries that the RTTI for 'entry' will point to
+    // NOTE: Mirrors the lookups done by the ir_gen__types__*_entry functions
+
+    rtti_table_t *rtti_table = object->ir_module.rtti_table;
+    ast_type_t *ast_type = &entry->resolved_ast_type;
+
+    if(ir_gen_resolve_type(compiler, object, ast_type, &entry->ir_type)){
+        return FAILURE;
+    }
+
+    switch(entry->ir_type->kind){
+    case TYPE_KIND_POINTER: case TYPE_KIND_FIXED_ARRAY:
+        if(ast_type->elements_length > 1){
+            ast_type_t subtype_view = ast_type_unwrapped_view(ast_type);
+            ir_gen__types__mark_reachable(rtti_table, &subtype_view, reachable, worklist, worklist_length);
+        }
+        return SUCCESS;
+    case TYPE_KIND_VECTOR: {
+            maybe_index_t vector_index = typename_vector_type(ast_type_base_name(ast_type));
+
+            if(vector_index != -1){
+                ir_gen__types__mark_name_reachable(rtti_table, global_vector_type_elements[vector_index], reachable, worklist, worklist_length);
+            }
+        }
+        return SUCCESS;
+    case TYPE_KIND_FUNCPTR:
+        if(ast_type->elements[0]->id == AST_ELEM_FUNC){
+            ast_elem_func_t *fp = (ast_elem_func_t*) ast_type->elements[0];
+
+            for(length_t i = 0; i != fp->arity; i++){
+                ir_gen__types__mark_reachable(rtti_table, &fp->arg_types[i], reachable, worklist, worklist_length);
+            }
+
+            ir_gen__types__mark_reachable(rtti_table, fp->return_type, reachable, worklist, worklist_length);
+        }
+        return SUCCESS;
+    case TYPE_KIND_STRUCTURE: case TYPE_KIND_UNION: {
+            ir_gen_composite_rtti_info_t info;
+            if(ir_gen__types__composite_entry_get_info(object, NULL, entry, NULL, &info)) return FAILURE;
+
+            ast_field_map_t *field_map = &info.core_composite_info->layout.field_map;
+            ast_layout_skeleton_t *skeleton = &info.core_composite_info->layout.skeleton;
+            bool is_polymorphic = info.core_composite_info->is_polymorphic;
+
+            for(length_t i = 0; i != field_map->arrows_length; i++){
+                ast_type_t *field_type = ast_layout_skeleton_get_type(skeleton, field_map->arrows[i].endpoint);
+
+                if(is_polymorphic){
+                    ast_type_t resolved_field_type;
+
+                    if(ast_resolve_type_polymorphs(compiler, NULL, &info.poly_catalog, field_type, &resolved_field_type)){
+                        ir_gen__types__composite_entry_free_info(&info);
+                        return FAILURE;
+                    }
+
+                    ir_gen__types__mark_reachable(rtti_table, &resolved_field_type, reachable, worklist, worklist_length);
+                    ast_type_free(&resolved_field_type);
+                } else {
+                    ir_gen__types__mark_reachable(rtti_table, field_type, reachable, worklist, worklist_length);
+                }
+            }
+
+            ir_gen__types__composite_entry_free_info(&info);
+        }
+        return SUCCESS;
+    default:
+        // Primitive and enum types don't refer to any other types
+        return SUCCESS;
+    }
+}
+
+errorcode_t ir_gen__types__strip_unreachable(compiler_t *compiler, object_t *object){
+    ir_module_t *ir_module = &object->ir_module;
+    rtti_table_t *rtti_table = ir_module->rtti_table;
+    rtti_relocations_t *rtti_relocations = &ir_module->rtti_relocations;
+
+    if(rtti_table->length == 0) return SUCCESS;
+
+    bool *reachable = calloc(rtti_table->length, sizeof(bool));
+    length_t *worklist = malloc(sizeof(length_t) * rtti_table->length);
+    length_t worklist_length = 0;
+
+    // Types requested by 'typeinfo', conversions to 'Any' and variadic argument type information
+    for(length_t i = 0; i != rtti_relocations->length; i++){
+        ir_gen__types__mark_name_reachable(rtti_table, rtti_relocations->relocations[i].human_notation, reachable, worklist, &worklist_length);
+    }
+
+    // Types that can be reached by following the RTTI of other reachable types
+    while(worklist_length != 0){
+        rtti_table_entry_t *entry = &rtti_table->entries[worklist[--worklist_length]];
+
+        if(ir_gen__types__mark_subtypes_reachable(compiler, object, entry, reachable, worklist, &worklist_length)){
+            free(reachable);
+            free(worklist);
+            return FAILURE;
+        }
+    }
+
+    // Remove unreachable entries while preserving the sorted order of the table
+    length_t kept = 0;
+
+    for(length_t i = 0; i != rtti_table->length; i++){
+        if(reachable[i]){
+            rtti_table->entries[kept++] = rtti_table->entries[i];
+        } else {
+            rtti_table_entry_free(&rtti_table->entries[i]);
+        }
+    }
+
+    ir_module->stripped_rtti += rtti_table->length - kept;
+    rtti_table->length = kept;
+
+    free(reachable);
+    free(worklist);
+    return SUCCESS;
+}
+
 static void collect_into_preallocated_rtti_table_entry_list(void *item, void *user_pointer){
     ast_type_t *ast_type = (ast_type_t*) item;
     rtti_table_entry_list_t *list = (rtti_table_entry_list_t*) user_pointer;
@@ -0,0 +1,312 @@
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "AST/TYPE/ast_type_identical.h"
+#include "AST/ast.h"
+#include "AST/ast_expr.h"
+#include "AST/ast_layout.h"
+#include "AST/ast_type.h"
+#include "BRIDGE/bridge.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "IR/ir.h"
+#include "IR/ir_type.h"
+#include "IR/ir_value.h"
+#include "IRGEN/ir_build_instr.h"
+#include "IRGEN/ir_build_literal.h"
+#include "IRGEN/ir_builder.h"
+#include "IRGEN/ir_gen_expr.h"
+#include "IRGEN/ir_gen_soa.h"
+#include "IRGEN/ir_gen_stmt.h"
+#include "IRGEN/ir_gen_type.h"
+#include "UTIL/ground.h"
+#include "UTIL/trait.h"
+
+ast_soa_t *ir_gen_soa_find(object_t *object, ast_type_t *type){
+    ast_t *ast = &object->ast;
+
+    if(ast->soas_length == 0 || type->elements_length != 1 || type->elements[0]->id != AST_ELEM_BASE){
+        return NULL;
+    }
+
+    maybe_index_t index = ast_find_soa(ast->soas, ast->soas_length, ((ast_elem_base_t*) type->elements[0])->base);
+    return index != -1 ? &ast->soas[index] : NULL;
+}
+
+static ast_soa_t *ir_gen_soa_of_variable(ir_builder_t *builder, bridge_var_t *variable){
+    ast_t *ast = &builder->object->ast;
+    return &ast->soas[ast_find_soa(ast->soas, ast->soas_length, variable->soa_name)];
+}
+
+static errorcode_t ir_gen_soa_check_index(ir_builder_t *builder, ir_value_t *index, source_t source){
+    if(!global_type_kind_is_integer[index->type->kind]){
+        compiler_panic(builder->compiler, source, "Array index value must be an integer type");
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+static errorcode_t ir_gen_soa_field(ir_builder_t *builder, ast_soa_t *soa, ir_value_t *container, ir_value_t *index, weak_cstr_t member, source_t source,
+        ir_value_t **out_pointer, ast_type_t *out_field_type){
+    // Gets a pointer to a field of an element of an SoA container
+
+    ast_composite_t *columns = ast_composite_find_exact(&builder->object->ast, soa->name);
+    ast_layout_endpoint_t endpoint;
+    ast_layout_endpoint_path_t path;
+
+    if(columns == NULL){
+        compiler_panicf(builder->compiler, source, "INTERNAL ERROR: Failed to find columns of SoA container '%s'", soa->name);
+        return FAILURE;
+    }
+
+    if(!ast_composite_find_exact_field(columns, member, &endpoint, &path)){
+        strong_cstr_t s = ast_type_str(&soa->element_type);
+        compiler_panicf(builder->compiler, source, "Field '%s' doesn't exist in struct '%s'", member, s);
+        free(s);
+        return FAILURE;
+    }
+
+    ast_type_t *column_type = ast_layout_skeleton_get_type(&columns->layout.skeleton, endpoint);
+    ast_type_t field_type = ast_type_unwrapped_view(column_type);
+
+    ir_type_t *field_ir_type;
+    if(ir_gen_resolve_type(builder->compiler, builder->object, &field_type, &field_ir_type)) return FAILURE;
+
+    // Columns are always direct members of the container
+    // (*)  Particles -> *1024 float -> *float
+    ir_type_extra_composite_t *composite_extra = (ir_type_extra_composite_t*) ((ir_type_t*) container->type->extra)->extra;
+    ir_type_t *column_ir_type = composite_extra->subtypes[endpoint.indices[0]];
+    ir_value_t *column = build_member(builder, container, path.waypoints[0].index, ir_type_make_pointer_to(builder->pool, column_ir_type), source);
+
+    column = build_bitcast(builder, column, ir_type_make_pointer_to(builder->pool, field_ir_type));
+    *out_pointer = build_array_access(builder, column, index, source);
+
+    if(out_field_type) *out_field_type = ast_type_clone(&field_type);
+    return SUCCESS;
+}
+
+errorcode_t ir_gen_soa_member(ir_builder_t *builder, ast_expr_member_t *expr, ir_value_t **ir_value, bool leave_mutable, ast_type_t *out_expr_type){
+    ast_soa_t *soa;
+    ir_value_t *container;
+    ir_value_t *index;
+
+    if(expr->value->id == EXPR_VARIABLE){
+        // Element of an SoA container that is being iterated over
+        bridge_var_t *variable = bridge_scope_find_var(builder->scope, ((ast_expr_variable_t*) expr->value)->name);
+        if(variable == NULL || !(variable->traits & BRIDGE_VAR_SOA_ELEMENT)) return ALT_FAILURE;
+
+        soa = ir_gen_soa_of_variable(builder, variable);
+        container = variable->soa_container;
+        index = build_load(builder, build_varptr(builder, ir_type_make_pointer_to(builder->pool, variable->ir_type), variable), expr->source);
+    } else if(expr->value->id == EXPR_ARRAY_ACCESS){
+        // Element of an SoA container that is accessed by index
+        ast_expr_array_access_t *access = (ast_expr_array_access_t*) expr->value;
+
+        // Phantom array values only come from resuming a regular member access (see below)
+        if(access->value->id == EXPR_PHANTOM) return ALT_FAILURE;
+
+        ast_type_t container_type;
+        if(ir_gen_expr(builder, access->value, &container, true, &container_type)) return FAILURE;
+
+        soa = container->type->kind == TYPE_KIND_POINTER ? ir_gen_soa_find(builder->object, &container_type) : NULL;
+
+        if(soa == NULL){
+            // Not an SoA container, so resume as a regular member access
+            // without generating the array value a second time
+            ast_expr_phantom_t generated = (ast_expr_phantom_t){
+                .id = EXPR_PHANTOM,
+                .source = access->value->source,
+                .type = container_type,
+                .ir_value = container,
+                .is_mutable = expr_is_mutable(access->value),
+            };
+
+            ast_expr_array_access_t resumed_access = *access;
+            resumed_access.value = (ast_expr_t*) &generated;
+
+            ast_expr_member_t resumed = *expr;
+            resumed.value = (ast_expr_t*) &resumed_access;
+
+            errorcode_t errorcode = ir_gen_expr_member(builder, &resumed, ir_value, leave_mutable, out_expr_type);
+            ast_type_free(&container_type);
+            return errorcode;
+        }
+
+        ast_type_free(&container_type);
+
+        ast_type_t index_type;
+        if(ir_gen_expr(builder, access->index, &index, false, &index_type)) return FAILURE;
+        ast_type_free(&index_type);
+
+        if(ir_gen_soa_check_index(builder, index, access->index->source)) return FAILURE;
+    } else {
+        return ALT_FAILURE;
+    }
+
+    if(ir_gen_soa_field(builder, soa, container, index, expr->member, expr->source, ir_value, out_expr_type)) return FAILURE;
+
+    // If not requested to leave the expression mutable, dereference it
+    if(!leave_mutable) *ir_value = build_load(builder, *ir_value, expr->source);
+    return SUCCESS;
+}
+
+errorcode_t ir_gen_soa_element(ir_builder_t *builder, ast_soa_t *soa, ir_value_t *container, ir_value_t *index, source_t source,
+        ir_value_t **ir_value, bool leave_mutable, ast_type_t *out_expr_type){
+
+    if(leave_mutable){
+        compiler_panicf(builder->compiler, source, "Elements of SoA container '%s' can't be used as mutable values", soa->name);
+        compiler_hintf(builder->compiler, "    Access the fields of the element individually instead\n");
+        return FAILURE;
+    }
+
+    if(ir_gen_soa_check_index(builder, index, source)) return FAILURE;
+
+    ast_composite_t *element = ast_composite_find_exact(&builder->object->ast, ast_type_base_name(&soa->element_type));
+
+    ir_type_t *element_ir_type;
+    if(element == NULL || ir_gen_resolve_type(builder->compiler, builder->object, &soa->element_type, &element_ir_type)) return FAILURE;
+
+    ir_type_t *element_ir_type_ptr = ir_type_make_pointer_to(builder->pool, element_ir_type);
+
+    // Gather the element into a temporary variable one field at a time
+    bridge_var_t *gathered = ir_builder_add_variable(builder, "$____soa_element____$", &soa->element_type, element_ir_type, BRIDGE_VAR_POD | BRIDGE_VAR_UNDEF);
+    ir_value_t *destination = build_lvarptr(builder, element_ir_type_ptr, gathered->id);
+
+    ast_expr_phantom_t phantom_destination = (ast_expr_phantom_t){
+        .id = EXPR_PHANTOM,
+        .source = source,
+        .type = soa->element_type,
+        .ir_value = destination,
+        .is_mutable = true,
+    };
+
+    ast_field_map_t *field_map = &element->layout.field_map;
+
+    for(length_t i = 0; i != field_map->arrows_length; i++){
+        ast_expr_member_t member = (ast_expr_member_t){
+            .id = EXPR_MEMBER,
+            .source = source,
+            .value = (ast_expr_t*) &phantom_destination,
+            .member = field_map->arrows[i].name,
+        };
+
+        ir_value_t *from, *to;
+
+        if(ir_gen_soa_field(builder, soa, container, index, member.member, source, &from, NULL)
+        || ir_gen_expr_member(builder, &member, &to, true, NULL)){
+            return FAILURE;
+        }
+
+        build_store(builder, build_load(builder, from, source), to, source);
+    }
+
+    *ir_value = build_load(builder, destination, source);
+
+    if(out_expr_type) *out_expr_type = ast_type_clone(&soa->element_type);
+    return SUCCESS;
+}
+
+errorcode_t ir_gen_soa_element_variable(ir_builder_t *builder, bridge_var_t *variable, source_t source,
+        ir_value_t **ir_value, bool leave_mutable, ast_type_t *out_expr_type){
+
+    ast_soa_t *soa = ir_gen_soa_of_variable(builder, variable);
+    ir_value_t *index = build_load(builder, build_varptr(builder, ir_type_make_pointer_to(builder->pool, variable->ir_type), variable), source);
+
+    return ir_gen_soa_element(builder, soa, variable->soa_container, index, source, ir_value, leave_mutable, out_expr_type);
+}
+
+errorcode_t ir_gen_stmt_each_soa(ir_builder_t *builder, ast_expr_each_in_t *stmt, ast_soa_t *soa, ir_value_t *container, ir_value_t *idx_ptr){
+    // Verify that the item type matches the element type of the container
+    if(!ast_types_identical(&soa->element_type, stmt->it_type)){
+        compiler_panic(builder->compiler, stmt->it_type->source, "Element type doesn't match given SoA container's element type");
+
+        char *s1 = ast_type_str(stmt->it_type);
+        char *s2 = ast_type_str(&soa->element_type);
+        compiler_hintf(builder->compiler, "(given element type : '%s', container element type : '%s')\n", s1, s2);
+        free(s1);
+        free(s2);
+        return FAILURE;
+    }
+
+    // Verify that the container that was given is mutable
+    if(!expr_is_mutable(stmt->list) || container->type->kind != TYPE_KIND_POINTER){
+        compiler_panicf(builder->compiler, stmt->list->source, "SoA container given to 'each in' statement must be mutable");
+        return FAILURE;
+    }
+
+    // Get the number of elements from the type signature of the container
+    ast_elem_fixed_array_t *fixed_array_element = (ast_elem_fixed_array_t*) soa->type.elements[0];
+    ir_value_t *length = build_literal_usize(builder->pool, fixed_array_element->length);
+
+    ir_type_t *idx_ir_type = ir_builder_usize(builder);
+
+    length_t test_basicblock_id = build_basicblock(builder);
+    length_t new_basicblock_id  = build_basicblock(builder);
+    length_t inc_basicblock_id  = build_basicblock(builder);
+    length_t end_basicblock_id  = build_basicblock(builder);
+
+    // Hook up labels
+    if(stmt->label != NULL) ir_builder_push_loop_label(builder, stmt->label, end_basicblock_id, inc_basicblock_id);
+
+    length_t prev_break_block_id = builder->break_block_id;
+    length_t prev_continue_block_id = builder->continue_block_id;
+    bridge_scope_t *prev_break_continue_scope = builder->break_continue_scope;
+
+    builder->break_block_id = end_basicblock_id;
+    builder->continue_block_id = inc_basicblock_id;
+    builder->break_continue_scope = builder->scope;
+
+    // Generate (idx < length)
+    build_break(builder, test_basicblock_id);
+    build_using_basicblock(builder, test_basicblock_id);
+
+    ir_value_t *whether_keep_going = build_math(builder, INSTRUCTION_ULESSER, build_load(builder, idx_ptr, stmt->source), length, ir_builder_bool(builder));
+    build_cond_break(builder, whether_keep_going, new_basicblock_id, end_basicblock_id);
+
+    // Update 'it' to refer to the current element
+    build_using_basicblock(builder, new_basicblock_id);
+    ir_builder_open_scope(builder);
+
+    bridge_var_t *it_var = ir_builder_add_variable(builder, stmt->it_name ? stmt->it_name : "it", stmt->it_type, idx_ir_type, BRIDGE_VAR_POD | BRIDGE_VAR_SOA_ELEMENT);
+    it_var->soa_container = container;
+    it_var->soa_name = soa->name;
+
+    build_store(builder, build_load(builder, idx_ptr, stmt->source), build_lvarptr(builder, ir_builder_usize_ptr(builder), it_var->id), stmt->source);
+
+    // Generate user-defined statements
+    bool terminated;
+    if(ir_gen_stmts(builder, &stmt->statements, &terminated)){
+        ir_builder_close_scope(builder);
+        return FAILURE;
+    }
+
+    if(!terminated){
+        if(handle_deference_for_variables(builder, &builder->scope->list)){
+            ir_builder_close_scope(builder);
+            return FAILURE;
+        }
+
+        build_break(builder, inc_basicblock_id);
+    }
+
+    ir_builder_close_scope(builder);
+
+    // Increment 'idx'
+    build_using_basicblock(builder, inc_basicblock_id);
+    ir_value_t *incremented = build_math(builder, INSTRUCTION_ADD, build_load(builder, idx_ptr, stmt->source), build_literal_usize(builder->pool, 1), idx_ir_type);
+    build_store(builder, incremented, idx_ptr, stmt->source);
+    build_break(builder, test_basicblock_id);
+
+    build_using_basicblock(builder, end_basicblock_id);
+    ir_builder_close_scope(builder);
+
+    if(stmt->label != NULL) ir_builder_pop_loop_label(builder);
+
+    builder->break_block_id = prev_break_block_id;
+    builder->continue_block_id = prev_continue_block_id;
+    builder->break_continue_scope = prev_break_continue_scope;
+    return SUCCESS;
+}
@@ -13,17 +13,23 @@
 #include "DRVR/compiler.h"
 #include "DRVR/object.h"
 #include "IR/ir.h"
+#include "IR/ir_fold.h"
 #include "IR/ir_module.h"
 #include "IR/ir_pool.h"
 #include "IR/ir_type.h"
+#include "IR/ir_type_map.h"
 #include "IR/ir_value.h"
 #include "IRGEN/ir_build_instr.h"
 #include "IRGEN/ir_build_literal.h"
 #include "IRGEN/ir_builder.h"
+#include "IRGEN/ir_gen_coroutine.h"
 #include "IRGEN/ir_gen_expr.h"
 #include "IRGEN/ir_gen_find.h"
+#include "IRGEN/ir_gen_parallel.h"
+#include "IRGEN/ir_gen_soa.h"
 #include "IRGEN/ir_gen_stmt.h"
 #include "IRGEN/ir_gen_type.h"
+#include "IRGEN/ir_speculation.h"
 #include "LEX/lex.h"
 #include "UTIL/builtin_type.h"
 #include "UTIL/func_pair.h"
@@ -51,7 +57,7 @@ errorcode_t ir_gen_stmts(ir_builder_t *builder, ast_expr_list_t *stmt_list, bool
             // Warn if there are statements following
             if(builder->compiler->traits & COMPILER_FUSSY && !(builder->compiler->ignore & COMPILER_IGNORE_EARLY_RETURN)){
                 if(s + 1 != stmt_list->length){
-                    const char *f_name = builder->object->ast.funcs[builder->ast_func_id].name;
+                    const char *f_name = ast_funcs_at(&builder->object->ast.funcs, builder->ast_func_id)->name;
 
                     if(compiler_warnf(builder->compiler, stmt_list->statements[s + 1]->source, "Statements after 'return' in function '%s'", f_name))
                         return FAILURE;
@@ -110,6 +116,12 @@ errorcode_t ir_gen_stmts(ir_builder_t *builder, ast_expr_list_t *stmt_list, bool
         case EXPR_DELETE:
             if(ir_gen_stmt_delete(builder, (ast_expr_delete_t*) stmt)) return FAILURE;
             break;
+        case EXPR_ASSUME:
+            if(ir_gen_stmt_assume(builder, (ast_expr_assume_t*) stmt)) return FAILURE;
+            break;
+        case EXPR_YIELD:
+            if(ir_gen_stmt_yield(builder, (ast_expr_yield_t*) stmt)) return FAILURE;
+            break;
         case EXPR_BREAK:
             if(ir_gen_stmt_break(builder, stmt, out_is_terminated)) return FAILURE;
 
@@ -131,10 +143,18 @@ errorcode_t ir_gen_stmts(ir_builder_t *builder, ast_expr_list_t *stmt_list, bool
             
             return SUCCESS; // Return since no other statements can be after this one
         case EXPR_EACH_IN:
-            if(ir_gen_stmt_each(builder, (ast_expr_each_in_t*) stmt)) return FAILURE;
+            if(((ast_expr_each_in_t*) stmt)->parallel.is_parallel){
+                if(ir_gen_stmt_parallel_each(builder, (ast_expr_each_in_t*) stmt)) return FAILURE;
+            } else if(ir_gen_stmt_each(builder, (ast_expr_each_in_t*) stmt)){
+                return FAILURE;
+            }
             break;
         case EXPR_REPEAT:
-            if(ir_gen_stmt_repeat(builder, (ast_expr_repeat_t*) stmt)) return FAILURE;
+            if(((ast_expr_repeat_t*) stmt)->parallel.is_parallel){
+                if(ir_gen_stmt_parallel_repeat(builder, (ast_expr_repeat_t*) stmt)) return FAILURE;
+            } else if(ir_gen_stmt_repeat(builder, (ast_expr_repeat_t*) stmt)){
+                return FAILURE;
+            }
             break;
         case EXPR_SWITCH: {
                 // TODO: CLEANUP: Refactor this code
@@ -213,6 +233,10 @@ errorcode_t ir_gen_stmts(ir_builder_t *builder, ast_expr_list_t *stmt_list, bool
 
                     ast_type_free(&slave_ast_type);
 
+                    // Case values are emitted as plain literals whenever they can be evaluated now
+                    ir_value_t *folded_case_value = ir_fold_scalar_literal(builder->pool, case_values[c]);
+                    if(folded_case_value) case_values[c] = folded_case_value;
+
                     unsigned int value_type = case_values[c]->value_type;
                     if(!VALUE_TYPE_IS_CONSTANT(value_type)){
                         compiler_panicf(builder->compiler, switch_case->source, "Value given to case must be constant");
@@ -308,6 +332,20 @@ errorcode_t ir_gen_stmts(ir_builder_t *builder, ast_expr_list_t *stmt_list, bool
 
                 ast_type_free(&master_ast_type);
 
+                // Only keep track of case likelihoods when at least one case was given a hint
+                troolean *case_likely = NULL;
+
+                for(length_t c = 0; c != switch_expr->cases.length; c++){
+                    if(switch_expr->cases.cases[c].likely != TROOLEAN_UNKNOWN){
+                        case_likely = ir_pool_alloc(builder->pool, sizeof(troolean) * switch_expr->cases.length);
+
+                        for(length_t i = 0; i != switch_expr->cases.length; i++){
+                            case_likely[i] = switch_expr->cases.cases[i].likely;
+                        }
+                        break;
+                    }
+                }
+
                 build_using_basicblock(builder, starting_block_id);
                 built_instr = build_instruction(builder, sizeof(ir_instr_switch_t));
                 ((ir_instr_switch_t*) built_instr)->id = INSTRUCTION_SWITCH;
@@ -316,6 +354,7 @@ errorcode_t ir_gen_stmts(ir_builder_t *builder, ast_expr_list_t *stmt_list, bool
                 ((ir_instr_switch_t*) built_instr)->cases_length = switch_expr->cases.length;
                 ((ir_instr_switch_t*) built_instr)->case_values = case_values;
                 ((ir_instr_switch_t*) built_instr)->case_block_ids = case_block_ids;
+                ((ir_instr_switch_t*) built_instr)->case_likely = case_likely;
                 ((ir_instr_switch_t*) built_instr)->default_block_id = default_block_id;
                 ((ir_instr_switch_t*) built_instr)->resume_block_id = resume_block_id;
                 build_using_basicblock(builder, resume_block_id);
@@ -576,14 +615,13 @@ errorcode_t ir_gen_stmt_return(ir_builder_t *builder, ast_expr_return_t *stmt, b
     bool is_in_defer_function;
     bool is_in_winmain_function;
     bool autogen_enabled;
+    bool is_in_generator;
     
-    // 'ast_func' is only guaranteed to be valid within this scope.
-    // Afterwards, it may or may not be shifted around in memory.
-    // Because of this, no pointers should be taken relative to 'ast_func'.
     {
-        ast_func_t *ast_func = &ast->funcs[builder->ast_func_id];
+        ast_func_t *ast_func = ast_funcs_at(&ast->funcs, builder->ast_func_id);
 
         return_type = ast_func->return_type;
+        is_in_generator        = ast_func_is_generator(ast_func);
         is_in_main_function    = ast_func->traits & AST_FUNC_MAIN;
         is_in_pass_function    = ast_func->traits & AST_FUNC_PASS;
         is_in_defer_function   = ast_func->traits & AST_FUNC_DEFER;
@@ -592,9 +630,14 @@ errorcode_t ir_gen_stmt_return(ir_builder_t *builder, ast_expr_return_t *stmt, b
     }
 
     ir_value_t *ir_value_to_be_returned = NULL;
-    bool returns_void = ast_type_is_void(&return_type);
+    bool returns_void = is_in_generator || ast_type_is_void(&return_type);
 
     if(stmt->value != NULL){
+        if(is_in_generator){
+            compiler_panicf(builder->compiler, stmt->source, "Cannot return a value from a generator function (use 'yield' instead)");
+            return FAILURE;
+        }
+
         if(returns_void){
             compiler_panicf(builder->compiler, stmt->source, "Can't return a value from function that returns void");
             return FAILURE;
@@ -720,12 +763,24 @@ errorcode_t ir_gen_stmt_declare(ir_builder_t *builder, ast_expr_declare_t *stmt)
     if(stmt->traits & AST_EXPR_DECLARATION_STATIC) traits |= BRIDGE_VAR_STATIC;
     if(is_undef)                                   traits |= BRIDGE_VAR_UNDEF;
 
+    // Static variables are initialized and destroyed by the entry point
+    if(traits & BRIDGE_VAR_STATIC && ir_speculation_give_up(builder->object->ir_module.speculation)) return FAILURE;
+
     // Resolve AST type to IR type
     if(ir_gen_resolve_type(builder->compiler, builder->object, &stmt->type, &ir_type)) return FAILURE;
 
     // Add the variable
     bridge_var_t *bridge_variable = ir_builder_add_variable(builder, stmt->name, &stmt->type, ir_type, traits);
 
+    // Over-align variable if requested
+    if(stmt->alignment != 0){
+        bridge_variable->alignment = stmt->alignment;
+
+        if(traits & BRIDGE_VAR_STATIC){
+            builder->object->ir_module.static_variables.variables[bridge_variable->static_id].alignment = stmt->alignment;
+        }
+    }
+
     ir_value_t *variable = stmt->inputs.has
         ? build_varptr(builder, ir_type_make_pointer_to(builder->pool, ir_type), bridge_variable)
         : NULL;
@@ -793,7 +848,7 @@ errorcode_t ir_gen_do_construct(
     func_pair_t pair = result.value;
 
     {
-        ast_func_t *ast_func = &object->ast.funcs[pair.ast_func_id];
+        ast_func_t *ast_func = ast_funcs_at(&object->ast.funcs, pair.ast_func_id);
 
         if(handle_pass_management(builder, arg_values, ast_func->arg_types, ast_func->arg_type_traits, arity)){
             goto failure;
@@ -801,7 +856,7 @@ errorcode_t ir_gen_do_construct(
     }
 
     func_id_t ir_func_id = pair.ir_func_id;
-    ir_type_t *ir_return_type = object->ir_module.funcs.funcs[ir_func_id].return_type;
+    ir_type_t *ir_return_type = ir_funcs_at(&object->ir_module.funcs, ir_func_id)->return_type;
     build_call_ignore_result(builder, ir_func_id, ir_return_type, arg_values, arity, source);
 
     ast_types_free(arg_types, arity);
@@ -986,9 +1041,9 @@ errorcode_t ir_gen_stmt_simple_conditional(ir_builder_t *builder, ast_expr_if_t
     length_t end_basicblock_id = build_basicblock(builder); // Create block for when the condition is false
 
     if(stmt->id == EXPR_IF){
-        build_cond_break(builder, condition, new_basicblock_id, end_basicblock_id);
+        build_hinted_cond_break(builder, condition, new_basicblock_id, end_basicblock_id, stmt->likely);
     } else {
-        build_cond_break(builder, condition, end_basicblock_id, new_basicblock_id);
+        build_hinted_cond_break(builder, condition, end_basicblock_id, new_basicblock_id, stmt->likely);
     }
 
     // Prepare for block statements
@@ -1028,9 +1083,9 @@ errorcode_t ir_gen_stmt_dual_conditional(ir_builder_t *builder, ast_expr_ifelse_
     length_t end_basicblock_id  = build_basicblock(builder); // Create block for the continuation point
 
     if(stmt->id == EXPR_IFELSE){
-        build_cond_break(builder, condition, new_basicblock_id, else_basicblock_id);
+        build_hinted_cond_break(builder, condition, new_basicblock_id, else_basicblock_id, stmt->likely);
     } else {
-        build_cond_break(builder, condition, else_basicblock_id, new_basicblock_id);
+        build_hinted_cond_break(builder, condition, else_basicblock_id, new_basicblock_id, stmt->likely);
     }
 
     // Open primary block scope and prepare for block statements
@@ -1109,9 +1164,9 @@ errorcode_t ir_gen_stmt_simple_loop(ir_builder_t *builder, ast_expr_while_t *stm
 
     // Continue/exit depending on condition and conditional kind
     if(stmt->id == EXPR_WHILE){
-        build_cond_break(builder, condition, new_basicblock_id, end_basicblock_id);
+        build_hinted_cond_break(builder, condition, new_basicblock_id, end_basicblock_id, stmt->likely);
     } else {
-        build_cond_break(builder, condition, end_basicblock_id, new_basicblock_id);
+        build_hinted_cond_break(builder, condition, end_basicblock_id, new_basicblock_id, stmt->likely);
     }
 
     // Prepare for block statements
@@ -1214,6 +1269,21 @@ errorcode_t ir_gen_stmt_delete(ir_builder_t *builder, ast_expr_unary_t *stmt){
     return SUCCESS;
 }
 
+errorcode_t ir_gen_stmt_assume(ir_builder_t *builder, ast_expr_unary_t *stmt){
+    ir_value_t *assumption = ir_gen_conforming_expr(builder, stmt->value, &builder->static_bool, CONFORM_MODE_CALCULATION, stmt->source, "Received type '%s' when assumption expects type '%s'");
+    if(assumption == NULL) return FAILURE;
+
+    ir_type_t *void_type;
+    if(!ir_type_map_find(builder->type_map, "void", &void_type)) return FAILURE;
+
+    ir_value_t **values = ir_pool_alloc(builder->pool, sizeof(ir_value_t*));
+    values[0] = assumption;
+
+    // Let the optimizer rely on the assumption without checking it at runtime
+    build_intrinsic(builder, IR_INTRINSIC_ASSUME, void_type, values, 1);
+    return SUCCESS;
+}
+
 errorcode_t ir_gen_stmt_break(ir_builder_t *builder, ast_expr_t *stmt, bool *out_is_terminated){
     // Ensure we have a valid point to break to
     if(builder->break_block_id == 0){
@@ -1342,6 +1412,22 @@ errorcode_t ir_gen_stmt_each(ir_builder_t *builder, ast_expr_each_in_t *stmt){
     if(stmt->list){
         if(ir_gen_expr(builder, stmt->list, &single_value, true, &single_type)) return FAILURE;
 
+        if(ir_gen_is_generator_call(builder, single_value)){
+            // Iterate over the values yielded by a generator instead
+            errorcode_t errorcode = ir_gen_stmt_each_generator(builder, stmt, single_value, idx_ptr);
+            ast_type_free(&single_type);
+            return errorcode;
+        }
+
+        ast_soa_t *soa = ir_gen_soa_find(builder->object, &single_type);
+
+        if(soa != NULL){
+            // Iterate over the elements of an SoA container by index instead
+            errorcode_t errorcode = ir_gen_stmt_each_soa(builder, stmt, soa, single_value, idx_ptr);
+            ast_type_free(&single_type);
+            return errorcode;
+        }
+
         if(!expr_is_mutable(stmt->list)){
             list_was_mutable = false;
             ir_builder_add_variable(builder, "$____each_in_list____$", &single_type, single_value->type, BRIDGE_VAR_POD | BRIDGE_VAR_UNDEF);
@@ -1376,7 +1462,7 @@ errorcode_t ir_gen_stmt_each(ir_builder_t *builder, ast_expr_each_in_t *stmt){
 
                 char *s1 = ast_type_str(stmt->it_type);
                 char *s2 = ast_type_str(&remaining_type);
-                printf("(given element type : '%s', array element type : '%s')\n", s1, s2);
+                compiler_hintf(builder->compiler, "(given element type : '%s', array element type : '%s')\n", s1, s2);
                 free(s1);
                 free(s2);
                 goto failure;
@@ -1505,7 +1591,7 @@ errorcode_t ir_gen_stmt_each(ir_builder_t *builder, ast_expr_each_in_t *stmt){
 
             char *s1 = ast_type_str(stmt->it_type);
             char *s2 = ast_type_str(&temporary_type);
-            printf("(given element type : '%s', array element type : '%s')\n", s1, s2);
+            compiler_hintf(builder->compiler, "(given element type : '%s', array element type : '%s')\n", s1, s2);
             free(s1);
             free(s2);
 
@@ -1714,7 +1800,7 @@ errorcode_t ir_gen_stmt_assert(ir_builder_t *builder, ast_expr_assert_t *stmt){
     filename_cstr = ir_pool_memclone(builder->pool, full_filename, strlen(full_filename) + 1);
 
     {
-        strong_cstr_t on_heap = ast_func_head_str(&builder->object->ast.funcs[builder->ast_func_id]);
+        strong_cstr_t on_heap = ast_func_head_str(ast_funcs_at(&builder->object->ast.funcs, builder->ast_func_id));
         function_signature = ir_pool_memclone(builder->pool, on_heap, strlen(on_heap) + 1);
         free(on_heap);
     }
@@ -1736,7 +1822,7 @@ errorcode_t ir_gen_stmt_assert(ir_builder_t *builder, ast_expr_assert_t *stmt){
     ast_expr_list_t on_fail_statements = {0};
     ast_expr_list_append(&on_fail_statements, call_stmt);
 
-    ast_expr_t *conditional = ast_expr_create_simple_conditional(stmt->source, EXPR_UNLESS, NULL, ast_expr_clone(stmt->assertion), on_fail_statements);
+    ast_expr_t *conditional = ast_expr_create_simple_conditional(stmt->source, EXPR_UNLESS, NULL, ast_expr_clone(stmt->assertion), TROOLEAN_TRUE, on_fail_statements);
 
     ast_expr_list_t assertion_code = {0};
     ast_expr_list_append(&assertion_code, conditional);
@@ -1793,10 +1879,10 @@ errorcode_t exhaustive_switch_check(ir_builder_t *builder, weak_cstr_t enum_name
             is_missing_case = true;
 
             compiler_panic(builder->compiler, switch_source, "Not all cases covered in exhaustive switch");
-            printf("\nMissing cases:\n");
+            compiler_hintf(builder->compiler, "\nMissing cases:\n");
         }
         
-        printf("    case ::%s\n", enum_definition->kinds[i]);
+        compiler_hintf(builder->compiler, "    case ::%s\n", enum_definition->kinds[i]);
     }
 
     return is_missing_case ? FAILURE : SUCCESS;
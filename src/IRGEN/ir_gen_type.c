@@ -29,12 +29,14 @@
 #include "UTIL/builtin_type.h"
 #include "UTIL/color.h"
 #include "UTIL/ground.h"
+#include "UTIL/string.h"
+#include "UTIL/string_list.h"
 #include "UTIL/trait.h"
 
 ir_type_map_t ir_type_map_create(ast_t *ast, ir_module_t *module){
     ir_pool_t *pool = &module->pool;
 
-    length_t estimate = ast->composites_length + ast->enums_length + 24;
+    length_t estimate = ast->composites_length + ast->enums_length + 44;
     ir_type_map_t type_map = list_create(ir_type_map_t, ir_type_mapping_t, estimate);
 
     // Create type mappings for all builtin types
@@ -61,6 +63,21 @@ ir_type_map_t ir_type_map_create(ast_t *ast, ir_module_t *module){
         ir_type_map_append(&type_map, builtin_type_mappings[i]);
     }
 
+    // Create type mappings for all builtin vector types
+    for(length_t i = 0; i < NUM_ITEMS(global_vector_types); i++){
+        ir_type_t *element_type = NULL;
+
+        for(length_t j = 0; j < NUM_ITEMS(builtin_type_mappings); j++){
+            if(streq(builtin_type_mappings[j].name, global_vector_type_elements[i])){
+                element_type = builtin_type_mappings[j].type;
+                break;
+            }
+        }
+
+        ir_type_t *vector_type = ir_type_make_vector_of(pool, global_vector_type_lanes[i], element_type);
+        ir_type_map_append(&type_map, ir_type_mapping_create((weak_cstr_t) global_vector_types[i], vector_type));
+    }
+
     // Create type mappings for every composite type.
     // Each mapping will have a placeholder value for the IR type, since the IR type of a composite
     // may depend on the type mappings of other composites.
@@ -83,6 +100,72 @@ ir_type_map_t ir_type_map_create(ast_t *ast, ir_module_t *module){
     return type_map;
 }
 
+static void ir_gen_foreign_type_name_mention(strong_cstr_list_t *names, const ast_type_t *type){
+    // Remembers the name of the composite that a type refers to (if any)
+    // NOTE: Composites behind pointers are included, since foreign code may read their fields
+    if(type->elements_length == 0) return;
+
+    ast_elem_t *elem = type->elements[type->elements_length - 1];
+
+    switch(elem->id){
+    case AST_ELEM_BASE:
+        strong_cstr_list_append(names, strclone(((ast_elem_base_t*) elem)->base));
+        break;
+    case AST_ELEM_GENERIC_BASE:
+        strong_cstr_list_append(names, strclone(((ast_elem_generic_base_t*) elem)->name));
+        break;
+    }
+}
+
+static strong_cstr_list_t ir_gen_foreign_type_names(ast_t *ast){
+    // Collects the sorted names of all types used in the signatures of foreign functions
+    strong_cstr_list_t names = (strong_cstr_list_t){0};
+
+    for(length_t i = 0; i != ast->funcs.length; i++){
+        ast_func_t *func = ast_funcs_at(&ast->funcs, i);
+        if(!(func->traits & AST_FUNC_FOREIGN)) continue;
+
+        for(length_t j = 0; j != func->arity; j++){
+            ir_gen_foreign_type_name_mention(&names, &func->arg_types[j]);
+        }
+
+        ir_gen_foreign_type_name_mention(&names, &func->return_type);
+    }
+
+    strong_cstr_list_sort(&names);
+    strong_cstr_list_presorted_remove_duplicates(&names);
+    return names;
+}
+
+static errorcode_t ir_gen_composite_compact_traits(compiler_t *compiler, ast_composite_t *composite, strong_cstr_list_t *foreign_type_names, trait_t *inout_bone_traits){
+    // Determines whether the fields of a composite will be physically reordered to minimize padding
+    // Either explicitly requested using 'compact' or globally using '--reorder-fields'
+    ast_layout_t *layout = &composite->layout;
+
+    if(layout->traits & AST_LAYOUT_COMPACT){
+        if(!(layout->traits & AST_LAYOUT_COMPACT_FORCED) && strong_cstr_list_bsearch(foreign_type_names, composite->name) != -1){
+            compiler_panicf(compiler, composite->source, "Cannot reorder fields of struct '%s' since it is used in a foreign function signature", composite->name);
+            printf("    Use 'compact(force)' if the foreign code is aware of the reordered layout\n");
+            return FAILURE;
+        }
+
+        *inout_bone_traits |= AST_LAYOUT_BONE_COMPACT;
+        return SUCCESS;
+    }
+
+    // Structs that are shared with foreign code always keep their declared layout when reordering globally
+    if(compiler->traits & COMPILER_REORDER_FIELDS
+    && layout->kind == AST_LAYOUT_STRUCT
+    && !(layout->traits & AST_LAYOUT_PACKED)
+    && !composite->is_class
+    && !composite->is_polymorphic
+    && strong_cstr_list_bsearch(foreign_type_names, composite->name) == -1){
+        *inout_bone_traits |= AST_LAYOUT_BONE_COMPACT;
+    }
+
+    return SUCCESS;
+}
+
 errorcode_t ir_gen_type_mappings(compiler_t *compiler, object_t *object){
     ast_t *ast = &object->ast;
     ir_module_t *module = &object->ir_module;
@@ -136,6 +219,20 @@ errorcode_t ir_gen_type_mappings(compiler_t *compiler, object_t *object){
         }
     }
 
+    // Names of types that foreign functions depend on the layout of
+    strong_cstr_list_t foreign_type_names = ir_gen_foreign_type_names(ast);
+
+    // Explicitly compact polymorphic composites are checked up front, since they are instantiated on demand
+    for(length_t i = 0; i != ast->poly_composites_length; i++){
+        ast_poly_composite_t *poly_composite = &ast->poly_composites[i];
+        trait_t unused_bone_traits = TRAIT_NONE;
+
+        if(ir_gen_composite_compact_traits(compiler, (ast_composite_t*) poly_composite, &foreign_type_names, &unused_bone_traits)){
+            strong_cstr_list_free(&foreign_type_names);
+            return FAILURE;
+        }
+    }
+
     // Fill in composite types
     for(length_t i = 0; i != type_map->length; i++){
         ir_type_t **mapping_type = &type_map->mappings[i].type;
@@ -144,14 +241,25 @@ errorcode_t ir_gen_type_mappings(compiler_t *compiler, object_t *object){
             ast_composite_t *composite = (*mapping_type)->extra;
             ast_layout_bone_t layout_as_bone = ast_layout_as_bone(&composite->layout);
 
+            if(ir_gen_composite_compact_traits(compiler, composite, &foreign_type_names, &layout_as_bone.traits)){
+                strong_cstr_list_free(&foreign_type_names);
+                return FAILURE;
+            }
+
             ir_type_t *composite_type = ast_layout_bone_to_ir_type(compiler, object, &layout_as_bone, NULL);
-            if(composite_type == NULL) return FAILURE;
+
+            if(composite_type == NULL){
+                strong_cstr_list_free(&foreign_type_names);
+                return FAILURE;
+            }
 
             // Replace by value so that the pointer remains the same
             **mapping_type = *composite_type;
         }
     }
 
+    strong_cstr_list_free(&foreign_type_names);
+
     // Cache string IR type
     ir_type_map_find(type_map, "String", &module->common.ir_string_struct);
     return SUCCESS;
@@ -200,6 +308,11 @@ errorcode_t ir_gen_resolve_type(compiler_t *compiler, object_t *object, const as
                 compiler_panicf(compiler, unresolved_type->source, "Undeclared type '%s'", base_name);
                 return FAILURE;
             }
+
+            // Runtime type information for vectors refers to their element type
+            if((*resolved_type)->kind == TYPE_KIND_VECTOR && object->ir_module.rtti_collector){
+                rtti_collector_mention_base(object->ir_module.rtti_collector, global_vector_type_elements[typename_vector_type(base_name)]);
+            }
         }
         break;
     case AST_ELEM_FUNC:
@@ -321,6 +434,7 @@ errorcode_t ir_gen_resolve_type(compiler_t *compiler, object_t *object, const as
 #define TYPE_TRAIT_INTEGER     TRAIT_4 // integer
 #define TYPE_TRAIT_FIXED_ARRAY TRAIT_5 // fixed array
 #define TYPE_TRAIT_BASE_ANY    TRAIT_6 // Any
+#define TYPE_TRAIT_VECTOR      TRAIT_7 // SIMD vector
 
 static trait_t get_type_traits(const ast_type_t *ast_type){
     trait_t traits = TRAIT_NONE;
@@ -336,6 +450,8 @@ static trait_t get_type_traits(const ast_type_t *ast_type){
         traits |= TYPE_TRAIT_FIXED_ARRAY;
     } else if(ast_type_is_base_of(ast_type, "Any")){
         traits |= TYPE_TRAIT_BASE_ANY;
+    } else if(ast_type_is_base(ast_type) && typename_vector_type(ast_type_base_name(ast_type)) != -1){
+        traits |= TYPE_TRAIT_VECTOR;
     } else if(type_kind != TYPE_KIND_NONE && type_kind != TYPE_KIND_FLOAT && type_kind != TYPE_KIND_DOUBLE){
         traits |= TYPE_TRAIT_INTEGER;
     }
@@ -478,6 +594,38 @@ successful_t ast_types_conform(ir_builder_t *builder, ir_value_t **ir_value, ast
         }
     }
 
+    // Attempt to conform to vectors
+    if(to_traits & TYPE_TRAIT_VECTOR && !ast_types_identical(ast_from_type, ast_to_type)){
+        if(mode & CONFORM_MODE_PRIMITIVES && from_type_kind != TYPE_KIND_NONE && from_type_kind != TYPE_KIND_BOOLEAN){
+            // Copy scalar into every lane
+            maybe_index_t vector_index = typename_vector_type(ast_type_base_name(ast_to_type));
+            ast_type_t element_type = ast_type_make_base(strclone(global_vector_type_elements[vector_index]));
+            bool is_element = ast_types_conform(builder, ir_value, ast_from_type, &element_type, mode);
+            ast_type_free(&element_type);
+
+            if(!is_element || ir_gen_resolve_type(builder->compiler, builder->object, ast_to_type, &ir_to_type)) return false;
+
+            *ir_value = build_vector_splat(builder, *ir_value, ir_to_type);
+            return true;
+        }
+
+        if(mode & CONFORM_MODE_VECTORS && from_traits & TYPE_TRAIT_VECTOR){
+            // Reinterpret the bits of a vector that has the same size
+            if(ir_gen_resolve_type(builder->compiler, builder->object, ast_to_type, &ir_to_type)) return false;
+
+            ir_type_extra_vector_t *from_vector = (ir_type_extra_vector_t*) (*ir_value)->type->extra;
+            ir_type_extra_vector_t *to_vector = (ir_type_extra_vector_t*) ir_to_type->extra;
+
+            if(from_vector->length * global_type_kind_sizes_in_bits_64[from_vector->subtype->kind]
+            != to_vector->length * global_type_kind_sizes_in_bits_64[to_vector->subtype->kind]){
+                return false;
+            }
+
+            *ir_value = build_bitcast(builder, *ir_value, ir_to_type);
+            return true;
+        }
+    }
+
     if(mode & CONFORM_MODE_INTENUM){
         // Convert enum to integer
         if((*ir_value)->type->kind == TYPE_KIND_U64 && to_traits & TYPE_TRAIT_INTEGER){
@@ -841,10 +989,37 @@ ir_type_t *ast_layout_bone_to_ir_type(compiler_t *compiler, object_t *object, as
     extra->subtypes_length = bone->children.bones_length;
     extra->traits = bone->traits & AST_LAYOUT_BONE_PACKED;
 
+    if(bone->kind == AST_LAYOUT_BONE_KIND_STRUCT && bone->traits & AST_LAYOUT_BONE_COMPACT){
+        extra->traits |= TYPE_KIND_COMPOSITE_REORDERED;
+    }
+
+    extra->alignment = bone->alignment;
+    extra->subtype_alignments = NULL;
+
     for(length_t i = 0; i != bone->children.bones_length; i++){
-        ir_type_t *subtype = ast_layout_bone_to_ir_type(compiler, object, &bone->children.bones[i], optional_catalog);
+        ast_layout_bone_t *child = &bone->children.bones[i];
+        ast_layout_bone_t compact_child;
+
+        // Anonymous structs inside of compact composites are compact as well (unless packed)
+        if(bone->traits & AST_LAYOUT_BONE_COMPACT && child->kind != AST_LAYOUT_BONE_KIND_TYPE && !(child->traits & AST_LAYOUT_BONE_PACKED)){
+            compact_child = *child;
+            compact_child.traits |= AST_LAYOUT_BONE_COMPACT;
+            child = &compact_child;
+        }
+
+        ir_type_t *subtype = ast_layout_bone_to_ir_type(compiler, object, child, optional_catalog);
         if(subtype == NULL) return NULL;
         extra->subtypes[i] = subtype;
+
+        // Only remember explicit subtype alignments when there are any
+        if(child->alignment != 0){
+            if(extra->subtype_alignments == NULL){
+                extra->subtype_alignments = ir_pool_alloc(pool, sizeof(length_t) * bone->children.bones_length);
+                memset(extra->subtype_alignments, 0, sizeof(length_t) * bone->children.bones_length);
+            }
+
+            extra->subtype_alignments[i] = child->alignment;
+        }
     }
 
     switch(bone->kind){
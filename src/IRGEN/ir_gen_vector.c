@@ -0,0 +1,227 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "AST/TYPE/ast_type_identical.h"
+#include "AST/ast_expr.h"
+#include "AST/ast_type.h"
+#include "AST/ast_type_lean.h"
+#include "DRVR/compiler.h"
+#include "IR/ir.h"
+#include "IR/ir_const_pool.h"
+#include "IR/ir_fold.h"
+#include "IR/ir_pool.h"
+#include "IR/ir_type.h"
+#include "IR/ir_type_map.h"
+#include "IR/ir_value.h"
+#include "IRGEN/ir_build_instr.h"
+#include "IRGEN/ir_builder.h"
+#include "IRGEN/ir_gen_expr.h"
+#include "IRGEN/ir_gen_vector.h"
+#include "UTIL/builtin_type.h"
+#include "UTIL/color.h"
+#include "UTIL/ground.h"
+#include "UTIL/string.h"
+
+static maybe_index_t vector_type_index(ast_type_t *type){
+    maybe_null_weak_cstr_t base = ast_type_base_name(type);
+    return base ? typename_vector_type(base) : -1;
+}
+
+static strong_cstr_t vector_mask_type_name(const char *vector_name){
+    // The lane mask of a vector has integer lanes of the same width
+    // (e.g.  f32x4 -> i32x4,  u8x16 -> i8x16)
+    strong_cstr_t mask_name = strclone(vector_name);
+    mask_name[0] = 'i';
+    return mask_name;
+}
+
+errorcode_t ir_gen_vector_compare(ir_builder_t *builder, unsigned int instr_id, ir_value_t *a, ir_value_t *b,
+        ast_type_t *vector_type, ir_value_t **ir_value, ast_type_t *out_expr_type){
+
+    maybe_index_t index = vector_type_index(vector_type);
+
+    if(index == -1){
+        internalerrorprintf("ir_gen_vector_compare() received non-vector type\n");
+        return FAILURE;
+    }
+
+    strong_cstr_t mask_name = vector_mask_type_name(global_vector_types[index]);
+
+    ir_type_t *mask_type;
+    if(!ir_type_map_find(builder->type_map, mask_name, &mask_type)){
+        internalerrorprintf("ir_gen_vector_compare() failed to find lane mask type '%s'\n", mask_name);
+        free(mask_name);
+        return FAILURE;
+    }
+
+    // Compare into a vector of booleans, and then widen each lane to all ones or all zeros
+    ir_type_t *bool_vector_type = ir_type_make_vector_of(builder->pool, global_vector_type_lanes[index], ir_builder_bool(builder));
+    ir_value_t *comparison = build_math(builder, instr_id, a, b, bool_vector_type);
+    *ir_value = build_sext(builder, comparison, mask_type);
+
+    if(out_expr_type != NULL){
+        *out_expr_type = ast_type_make_base(mask_name);
+    } else {
+        free(mask_name);
+    }
+
+    return SUCCESS;
+}
+
+static errorcode_t ir_gen_vector_shuffle(ir_builder_t *builder, ast_expr_call_t *expr, ir_value_t **arg_values,
+        ast_type_t *arg_types, ir_value_t **ir_value, ast_type_t *out_expr_type){
+
+    maybe_index_t index = expr->arity >= 2 ? vector_type_index(&arg_types[0]) : -1;
+
+    if(index == -1 || !ast_types_identical(&arg_types[0], &arg_types[1])){
+        compiler_panicf(builder->compiler, expr->source, "Builtin 'vector_shuffle' expects two vectors of the same type followed by lane indices");
+        return FAILURE;
+    }
+
+    length_t lanes = global_vector_type_lanes[index];
+
+    if(expr->arity - 2 != lanes){
+        compiler_panicf(builder->compiler, expr->source, "Builtin 'vector_shuffle' for '%s' expects %d lane indices, got %d",
+                global_vector_types[index], (int) lanes, (int) (expr->arity - 2));
+        return FAILURE;
+    }
+
+    length_t *mask = ir_pool_alloc(builder->pool, sizeof(length_t) * lanes);
+
+    for(length_t i = 0; i != lanes; i++){
+        ir_value_t *lane_index = ir_fold_scalar_literal(builder->pool, arg_values[i + 2]);
+        source_t source = expr->args[i + 2]->source;
+
+        if(lane_index == NULL || lane_index->value_type != VALUE_TYPE_LITERAL || ir_type_get_category(lane_index->type) == PRIMITIVE_FP){
+            compiler_panicf(builder->compiler, source, "Lane index for 'vector_shuffle' must be a constant integer");
+            return FAILURE;
+        }
+
+        unsigned long long value = ir_value_uniqueness_value(builder->pool, &lane_index);
+
+        if(value >= 2 * lanes){
+            compiler_panicf(builder->compiler, source, "Lane index %d is out of range for shuffling two '%s' vectors",
+                    (int) value, global_vector_types[index]);
+            return FAILURE;
+        }
+
+        mask[i] = value;
+    }
+
+    *ir_value = build_vector_shuffle(builder, arg_values[0]->type, arg_values[0], arg_values[1], mask, lanes);
+
+    if(out_expr_type != NULL){
+        *out_expr_type = ast_type_clone(&arg_types[0]);
+    }
+
+    return SUCCESS;
+}
+
+static errorcode_t ir_gen_vector_select(ir_builder_t *builder, ast_expr_call_t *expr, ir_value_t **arg_values,
+        ast_type_t *arg_types, ir_value_t **ir_value, ast_type_t *out_expr_type){
+
+    maybe_index_t index = expr->arity == 3 ? vector_type_index(&arg_types[1]) : -1;
+
+    if(index == -1 || !ast_types_identical(&arg_types[1], &arg_types[2])){
+        compiler_panicf(builder->compiler, expr->source, "Builtin 'vector_select' expects a lane mask followed by two vectors of the same type");
+        return FAILURE;
+    }
+
+    strong_cstr_t mask_name = vector_mask_type_name(global_vector_types[index]);
+    bool is_mask = ast_type_is_base_of(&arg_types[0], mask_name);
+
+    if(!is_mask){
+        strong_cstr_t given = ast_type_str(&arg_types[0]);
+        compiler_panicf(builder->compiler, expr->args[0]->source, "Builtin 'vector_select' expects a mask of type '%s' for '%s' vectors, got '%s'",
+                mask_name, global_vector_types[index], given);
+        free(given);
+        free(mask_name);
+        return FAILURE;
+    }
+
+    free(mask_name);
+
+    // Lanes of the mask that are non-zero select from the first vector
+    ir_value_t *mask = arg_values[0];
+    ir_type_t *mask_element_type = ((ir_type_extra_vector_t*) mask->type->extra)->subtype;
+    length_t lanes = global_vector_type_lanes[index];
+
+    adept_ulong zero = 0;
+    ir_value_t *zeros = build_vector_splat(builder, ir_const_pool_literal(builder->pool, mask_element_type->kind, &zero), mask->type);
+    ir_type_t *bool_vector_type = ir_type_make_vector_of(builder->pool, lanes, ir_builder_bool(builder));
+    ir_value_t *condition = build_math(builder, INSTRUCTION_NOTEQUALS, mask, zeros, bool_vector_type);
+
+    *ir_value = build_select(builder, arg_values[1]->type, condition, arg_values[1], arg_values[2]);
+
+    if(out_expr_type != NULL){
+        *out_expr_type = ast_type_clone(&arg_types[1]);
+    }
+
+    return SUCCESS;
+}
+
+static errorcode_t ir_gen_vector_reduce(ir_builder_t *builder, ast_expr_call_t *expr, unsigned int expr_id, ir_value_t **arg_values,
+        ast_type_t *arg_types, ir_value_t **ir_value, ast_type_t *out_expr_type){
+
+    maybe_index_t index = expr->arity == 1 ? vector_type_index(&arg_types[0]) : -1;
+
+    if(index == -1){
+        compiler_panicf(builder->compiler, expr->source, "Builtin '%s' expects a single vector", expr->name);
+        return FAILURE;
+    }
+
+    // Reuse the same instruction choices as the corresponding math operator
+    ir_instr_id_t operation = ir_instr_choosing_run(&ir_gen_math_specs[expr_id].choices, arg_values[0]->type);
+
+    if(operation == INSTRUCTION_NONE || ir_vector_reduce_operation_name(operation) == NULL){
+        compiler_panicf(builder->compiler, expr->source, "Cannot use '%s' on vectors of type '%s'", expr->name, global_vector_types[index]);
+        return FAILURE;
+    }
+
+    *ir_value = build_vector_reduce(builder, operation, arg_values[0]);
+
+    if(out_expr_type != NULL){
+        *out_expr_type = ast_type_make_base(strclone(global_vector_type_elements[index]));
+    }
+
+    return SUCCESS;
+}
+
+errorcode_t ir_gen_vector_builtin(ir_builder_t *builder, ast_expr_call_t *expr, ir_value_t **arg_values,
+        ast_type_t *arg_types, ir_value_t **ir_value, ast_type_t *out_expr_type){
+
+    static const struct { const char *name; unsigned int expr_id; } reductions[] = {
+        {"vector_reduce_add", EXPR_ADD},
+        {"vector_reduce_and", EXPR_BIT_AND},
+        {"vector_reduce_max", EXPR_GREATER},
+        {"vector_reduce_min", EXPR_LESSER},
+        {"vector_reduce_mul", EXPR_MULTIPLY},
+        {"vector_reduce_or",  EXPR_BIT_OR},
+        {"vector_reduce_xor", EXPR_BIT_XOR},
+    };
+
+    const char *name = expr->name;
+    ir_value_t *result;
+    errorcode_t errorcode = ALT_FAILURE;
+
+    if(streq(name, "vector_shuffle")){
+        errorcode = ir_gen_vector_shuffle(builder, expr, arg_values, arg_types, &result, out_expr_type);
+    } else if(streq(name, "vector_select")){
+        errorcode = ir_gen_vector_select(builder, expr, arg_values, arg_types, &result, out_expr_type);
+    } else {
+        for(length_t i = 0; i != NUM_ITEMS(reductions); i++){
+            if(streq(name, reductions[i].name)){
+                errorcode = ir_gen_vector_reduce(builder, expr, reductions[i].expr_id, arg_values, arg_types, &result, out_expr_type);
+                break;
+            }
+        }
+    }
+
+    // The resulting value is only given back if requested
+    if(errorcode == SUCCESS && ir_value != NULL){
+        *ir_value = result;
+    }
+
+    return errorcode;
+}
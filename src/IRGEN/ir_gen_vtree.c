@@ -63,7 +63,7 @@ errorcode_t ir_gen_vtree_overrides(
     // (this may mean instantiating new functions)
     for(length_t i = 0; i != start->virtuals.length; i++){
         func_id_t ast_func_id = start->virtuals.endpoints[i].ast_func_id;
-        ast_func_t *ast_func = &ast->funcs[ast_func_id];
+        ast_func_t *ast_func = ast_funcs_at(&ast->funcs, ast_func_id);
 
         source_t source_on_error = start->signature.source;
         optional_func_pair_t result;
@@ -131,7 +131,7 @@ errorcode_t ir_gen_vtree_search_for_single_override(
     optional_func_pair_t *out_result
 ){
     ast_t *ast = &object->ast;
-    ast_func_t *ast_func = &ast->funcs[ast_func_id];
+    ast_func_t *ast_func = ast_funcs_at(&ast->funcs, ast_func_id);
 
     source_t source_on_error = child_subject_type->source;
     optional_func_pair_t result;
@@ -147,10 +147,6 @@ errorcode_t ir_gen_vtree_search_for_single_override(
 
     errorcode_t errorcode = ir_gen_find_dispatchee(compiler, object, struct_name, ast_func->name, arg_types, ast_func->arity, instantiation_depth, source_on_error, &result);
 
-    // TODO: Clean up code so that this revalidation isn't needed
-    // Revalidate AST function
-    ast_func = &ast->funcs[ast_func_id];
-
     switch(errorcode){
     case ALT_FAILURE: {
             strong_cstr_t typename = ast_type_str(child_subject_type);
@@ -159,7 +155,7 @@ errorcode_t ir_gen_vtree_search_for_single_override(
             goto failure;
         }
     case SUCCESS: {
-            ast_func_t *dispatchee = &ast->funcs[result.value.ast_func_id];
+            ast_func_t *dispatchee = ast_funcs_at(&ast->funcs, result.value.ast_func_id);
 
             if(result.has){
                 if(!(dispatchee->traits & AST_FUNC_OVERRIDE)){
@@ -0,0 +1,385 @@
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "AST/TYPE/ast_type_set.h"
+#include "AST/ast.h"
+#include "AST/ast_type.h"
+#include "BRIDGE/bridge.h"
+#include "BRIDGE/rtti_collector.h"
+#include "DRVR/compiler.h"
+#include "DRVR/object.h"
+#include "IR/ir.h"
+#include "IR/ir_func_endpoint.h"
+#include "IR/ir_module.h"
+#include "IR/ir_pool.h"
+#include "IR/ir_proc_map.h"
+#include "IRGEN/ir_cache.h"
+#include "IRGEN/ir_gen.h"
+#include "IRGEN/ir_speculation.h"
+#include "UTIL/ground.h"
+#include "UTIL/set.h"
+#include "UTIL/thread_pool.h"
+#include "UTIL/trait.h"
+
+// Number of buckets used for the special function cache of each speculation,
+// which only holds what a single body looks up on top of the shared cache
+#define IR_SPECULATION_SF_CACHE_NUM_BUCKETS 16
+
+// ---------------- ir_speculation_run_t ----------------
+// Shared state for speculating a batch on multiple threads
+typedef struct {
+    ir_speculation_batch_t *batch;
+    compiler_t *compiler;
+    object_t *object;
+    object_t *worker_objects;
+} ir_speculation_run_t;
+
+bool ir_speculation_give_up(ir_speculation_t *speculation){
+    if(speculation == NULL) return false;
+
+    speculation->aborted = true;
+    return true;
+}
+
+void ir_speculation_record_lookup(ir_speculation_t *speculation, bool is_method, const void *key, ir_func_endpoint_list_t *endpoint_list){
+    if(speculation == NULL) return;
+
+    ir_speculation_lookup_t lookup = (ir_speculation_lookup_t){
+        .is_method = is_method,
+        .endpoint_list = endpoint_list,
+        .length = endpoint_list ? endpoint_list->length : 0,
+    };
+
+    if(is_method){
+        lookup.key.method = *(const ir_method_key_t*) key;
+    } else {
+        lookup.key.func = *(const ir_func_key_t*) key;
+    }
+
+    ir_speculation_lookups_append(&speculation->lookups, lookup);
+}
+
+void ir_speculation_record_func_traits(ir_speculation_t *speculation, func_id_t ir_func_id, trait_t traits){
+    ir_speculation_func_traits_list_append(&speculation->func_traits, ((ir_speculation_func_traits_t){
+        .ir_func_id = ir_func_id,
+        .traits = traits,
+    }));
+}
+
+void ir_speculation_record_anon_global(ir_speculation_t *speculation, ir_value_anon_global_t *anon_global){
+    ir_speculation_anon_global_refs_append(&speculation->anon_global_refs, anon_global);
+}
+
+static bool ir_speculation_sf_entry_is_learned(ir_gen_sf_cache_entry_t *entry, ir_gen_sf_cache_entry_t *known){
+    if(known == NULL){
+        return entry->has_pass != TROOLEAN_UNKNOWN || entry->has_defer != TROOLEAN_UNKNOWN || entry->has_assign != TROOLEAN_UNKNOWN;
+    }
+
+    return entry->has_pass != known->has_pass || entry->has_defer != known->has_defer || entry->has_assign != known->has_assign;
+}
+
+static void ir_speculation_learn_sf_entries(ir_speculation_t *speculation, ir_gen_sf_cache_t *cache){
+    // Keep entries that found out something the shared cache doesn't know yet
+    for(length_t i = 0; i != cache->capacity; i++){
+        if(!ir_gen_sf_cache_entry_is_occupied(&cache->storage[i])) continue;
+
+        for(ir_gen_sf_cache_entry_t *entry = &cache->storage[i]; entry; entry = entry->next){
+            ir_gen_sf_cache_entry_t *known = ir_gen_sf_cache_locate(cache->fallback, &entry->ast_type);
+
+            if(!ir_speculation_sf_entry_is_learned(entry, known)) continue;
+
+            ir_gen_sf_cache_entry_t learned = *entry;
+            learned.ast_type = ast_type_clone(&entry->ast_type);
+            learned.next = NULL;
+            ir_speculation_sf_entries_append(&speculation->sf_entries, learned);
+        }
+    }
+}
+
+static void ir_speculation_task(void *data, length_t worker, length_t index){
+    ir_speculation_run_t *run = (ir_speculation_run_t*) data;
+    ir_speculation_t *speculation = &run->batch->speculations[index];
+    ir_func_endpoint_t endpoint = speculation->endpoint;
+
+    object_t *object = &run->worker_objects[worker];
+    ir_module_t *module = &object->ir_module;
+    ir_module_t *shared_module = &run->object->ir_module;
+
+    // Foreign functions don't have bodies, and entry points initialize
+    // global variables which changes the module as a whole
+    trait_t traits = ast_funcs_at(&object->ast.funcs, endpoint.ast_func_id)->traits;
+
+    if(traits & (AST_FUNC_FOREIGN | AST_FUNC_MAIN | AST_FUNC_WINMAIN | AST_FUNC_INIT | AST_FUNC_DEINIT)){
+        speculation->aborted = true;
+        return;
+    }
+
+    // Diagnostics are kept until the speculation is committed
+    compiler_t compiler = *run->compiler;
+    compiler.capture = &speculation->diagnostics;
+    compiler.use_libm = false;
+    compiler.use_libpthread = false;
+
+    // Everything the body adds to the module goes into lists of its own
+    module->speculation = speculation;
+    module->anon_globals = (ir_anon_globals_t){0};
+    module->rtti_relocations = (rtti_relocations_t){0};
+    module->job_list = (ir_job_list_t){0};
+    module->defer_free = (free_list_t){0};
+    module->vtable_init_list = (ir_vtable_init_list_t){0};
+    module->vtable_dispatch_list = (ir_vtable_dispatch_list_t){0};
+    module->rtti_table_referenced = false;
+
+    ast_type_set_init(&speculation->rtti_collector.ast_types_used, 16);
+    module->rtti_collector = shared_module->rtti_collector ? &speculation->rtti_collector : NULL;
+
+    ir_gen_sf_cache_init(&module->sf_cache, IR_SPECULATION_SF_CACHE_NUM_BUCKETS);
+    module->sf_cache.fallback = &shared_module->sf_cache;
+
+    // Allocate out of a pool of its own, so that its memory can be freed if it's discarded
+    ir_pool_init(&module->pool);
+
+    speculation->errorcode = ir_gen_functions_body_statements(&compiler, object, endpoint.ast_func_id, endpoint.ir_func_id);
+    speculation->generated = true;
+
+    speculation->pool = module->pool;
+    speculation->anon_globals = module->anon_globals;
+    speculation->rtti_relocations = module->rtti_relocations;
+    speculation->defer_free = module->defer_free;
+    speculation->vtable_init_list = module->vtable_init_list;
+    speculation->vtable_dispatch_list = module->vtable_dispatch_list;
+    speculation->use_libm = compiler.use_libm;
+    speculation->use_libpthread = compiler.use_libpthread;
+    speculation->rtti_table_referenced = module->rtti_table_referenced;
+
+    // Referencing a function that doesn't have a job yet already gave up
+    ir_job_list_free(&module->job_list);
+
+    ir_speculation_learn_sf_entries(speculation, &module->sf_cache);
+    ir_gen_sf_cache_free(&module->sf_cache);
+    module->pool = (ir_pool_t){0};
+    module->speculation = NULL;
+}
+
+bool ir_speculation_batch_run(ir_speculation_batch_t *batch, compiler_t *compiler, object_t *object){
+    ir_module_t *module = &object->ir_module;
+    ir_job_list_t *job_list = &module->job_list;
+
+    length_t worker_count = thread_pool_worker_count(job_list->length, IR_SPECULATION_MIN_JOBS_PER_WORKER);
+    if(worker_count <= 1) return false;
+
+    // Start out small, so that functions which are instantiated while committing
+    // the first batches already exist by the time that later ones are speculated
+    length_t size = batch->size != 0 ? batch->size * 2 : worker_count * IR_SPECULATION_MIN_JOBS_PER_WORKER;
+    if(size > job_list->length) size = job_list->length;
+
+    ir_speculation_batch_free(batch, module);
+
+    *batch = (ir_speculation_batch_t){
+        .speculations = calloc(size, sizeof(ir_speculation_t)),
+        .base = job_list->length - size,
+        .remaining = size,
+        .size = size,
+        .func_map_length = module->func_map.length,
+        .method_map_length = module->method_map.length,
+    };
+
+    for(length_t i = 0; i != size; i++){
+        batch->speculations[i].endpoint = job_list->jobs[batch->base + i];
+    }
+
+    // Each worker uses its own copy of the object, and each job gets its own pool
+    ir_speculation_run_t run = (ir_speculation_run_t){
+        .batch = batch,
+        .compiler = compiler,
+        .object = object,
+        .worker_objects = malloc(sizeof(object_t) * worker_count),
+    };
+
+    for(length_t i = 0; i != worker_count; i++){
+        object_t *worker_object = &run.worker_objects[i];
+        *worker_object = *object;
+
+        worker_object->ir_module.pool = (ir_pool_t){0};
+        worker_object->ir_module.init_builder = NULL;
+        worker_object->ir_module.deinit_builder = NULL;
+        worker_object->ir_module.speculation = NULL;
+    }
+
+    thread_pool_run(size, worker_count, ir_speculation_task, &run);
+
+    free(run.worker_objects);
+    return true;
+}
+
+ir_speculation_t *ir_speculation_batch_take(ir_speculation_batch_t *batch, length_t index){
+    if(batch->remaining == 0 || index != batch->base + batch->remaining - 1) return NULL;
+
+    return &batch->speculations[--batch->remaining];
+}
+
+static bool ir_speculation_lookup_is_valid(ir_speculation_batch_t *batch, ir_speculation_lookup_t *lookup, ir_module_t *module){
+    // Endpoint lists never move and only ever grow
+    if(lookup->endpoint_list){
+        return lookup->endpoint_list->length == lookup->length;
+    }
+
+    ir_func_endpoint_list_t *endpoint_list;
+
+    if(lookup->is_method){
+        if(module->method_map.length == batch->method_map_length) return true;
+        endpoint_list = ir_proc_map_find(&module->method_map, &lookup->key.method, sizeof(ir_method_key_t), &compare_ir_method_key);
+    } else {
+        if(module->func_map.length == batch->func_map_length) return true;
+        endpoint_list = ir_proc_map_find(&module->func_map, &lookup->key.func, sizeof(ir_func_key_t), &compare_ir_func_key);
+    }
+
+    return endpoint_list == NULL;
+}
+
+static void ir_speculation_collect_rtti(void *item, void *user_pointer){
+    rtti_collector_mention((rtti_collector_t*) user_pointer, (ast_type_t*) item);
+}
+
+static void ir_speculation_free(ir_speculation_t *speculation){
+    compiler_diagnostics_free(&speculation->diagnostics);
+    free(speculation->lookups.lookups);
+    free(speculation->func_traits.entries);
+    free(speculation->anon_global_refs.refs);
+    free(speculation->anon_globals.globals);
+    rtti_relocations_free(&speculation->rtti_relocations);
+    free_list_free(&speculation->defer_free);
+    ir_vtable_init_list_free(&speculation->vtable_init_list);
+    ir_vtable_dispatch_list_free(&speculation->vtable_dispatch_list);
+    ast_type_set_free(&speculation->rtti_collector.ast_types_used);
+
+    if(speculation->pool.fragments != NULL){
+        ir_pool_free(&speculation->pool);
+    }
+
+    for(length_t i = 0; i != speculation->sf_entries.length; i++){
+        ast_type_free(&speculation->sf_entries.entries[i].ast_type);
+    }
+    free(speculation->sf_entries.entries);
+
+    *speculation = (ir_speculation_t){0};
+}
+
+static void ir_speculation_discard(ir_speculation_t *speculation, ir_module_t *module){
+    // Remove the body so that the function can be generated again
+    if(speculation->generated){
+        ir_func_t *ir_func = ir_funcs_at(&module->funcs, speculation->endpoint.ir_func_id);
+
+        ir_basicblocks_free(&ir_func->basicblocks);
+        ir_func->basicblocks = (ir_basicblocks_t){0};
+
+        if(ir_func->scope != NULL){
+            bridge_scope_free(ir_func->scope);
+            free(ir_func->scope);
+            ir_func->scope = NULL;
+        }
+
+        ir_func->variable_count = 0;
+    }
+
+    ir_speculation_free(speculation);
+}
+
+bool ir_speculation_commit(ir_speculation_batch_t *batch, ir_speculation_t *speculation, compiler_t *compiler, object_t *object){
+    ir_module_t *module = &object->ir_module;
+
+    bool usable = speculation->generated && !speculation->aborted && speculation->errorcode == SUCCESS;
+
+    for(length_t i = 0; usable && i != speculation->lookups.length; i++){
+        usable = ir_speculation_lookup_is_valid(batch, &speculation->lookups.lookups[i], module);
+    }
+
+    if(!usable){
+        ir_speculation_discard(speculation, module);
+        return false;
+    }
+
+    compiler_diagnostics_replay(compiler, &speculation->diagnostics);
+
+    // Memory allocated by the body must now live as long as the module does
+    ir_pool_adopt(&module->pool, &speculation->pool);
+
+    for(length_t i = 0; i != speculation->func_traits.length; i++){
+        ir_speculation_func_traits_t *entry = &speculation->func_traits.entries[i];
+        ir_funcs_at(&module->funcs, entry->ir_func_id)->traits |= entry->traits;
+    }
+
+    // Anonymous globals are numbered after the ones that already exist
+    length_t anon_globals_offset = module->anon_globals.length;
+
+    for(length_t i = 0; i != speculation->anon_global_refs.length; i++){
+        speculation->anon_global_refs.refs[i]->anon_global_id += anon_globals_offset;
+    }
+
+    for(length_t i = 0; i != speculation->anon_globals.length; i++){
+        ir_anon_globals_append(&module->anon_globals, speculation->anon_globals.globals[i]);
+    }
+
+    // Ownership of the contents of these lists moves to the module
+    for(length_t i = 0; i != speculation->rtti_relocations.length; i++){
+        rtti_relocations_append(&module->rtti_relocations, speculation->rtti_relocations.relocations[i]);
+    }
+    speculation->rtti_relocations.length = 0;
+
+    for(length_t i = 0; i != speculation->defer_free.length; i++){
+        free_list_append(&module->defer_free, speculation->defer_free.pointers[i]);
+    }
+    speculation->defer_free.length = 0;
+
+    for(length_t i = 0; i != speculation->vtable_init_list.length; i++){
+        ir_vtable_init_list_append(&module->vtable_init_list, speculation->vtable_init_list.initializations[i]);
+    }
+    speculation->vtable_init_list.length = 0;
+
+    for(length_t i = 0; i != speculation->vtable_dispatch_list.length; i++){
+        ir_vtable_dispatch_list_append(&module->vtable_dispatch_list, speculation->vtable_dispatch_list.dispatches[i]);
+    }
+
+    if(module->rtti_collector){
+        set_collect(&speculation->rtti_collector.ast_types_used.impl, &ir_speculation_collect_rtti, module->rtti_collector);
+    }
+
+    // Only fill in what isn't known yet
+    for(length_t i = 0; i != speculation->sf_entries.length; i++){
+        ir_gen_sf_cache_entry_t *learned = &speculation->sf_entries.entries[i];
+        ir_gen_sf_cache_entry_t *entry = ir_gen_sf_cache_locate_or_insert(&module->sf_cache, &learned->ast_type);
+
+        if(entry->has_pass == TROOLEAN_UNKNOWN){
+            entry->has_pass = learned->has_pass;
+            entry->pass = learned->pass;
+        }
+
+        if(entry->has_defer == TROOLEAN_UNKNOWN){
+            entry->has_defer = learned->has_defer;
+            entry->defer = learned->defer;
+        }
+
+        if(entry->has_assign == TROOLEAN_UNKNOWN){
+            entry->has_assign = learned->has_assign;
+            entry->assign = learned->assign;
+        }
+    }
+
+    if(speculation->use_libm) compiler->use_libm = true;
+    if(speculation->use_libpthread) compiler->use_libpthread = true;
+    if(speculation->rtti_table_referenced) module->rtti_table_referenced = true;
+
+    ir_speculation_free(speculation);
+    return true;
+}
+
+void ir_speculation_batch_free(ir_speculation_batch_t *batch, ir_module_t *module){
+    for(length_t i = 0; i != batch->remaining; i++){
+        ir_speculation_discard(&batch->speculations[i], module);
+    }
+
+    free(batch->speculations);
+    batch->speculations = NULL;
+    batch->remaining = 0;
+}
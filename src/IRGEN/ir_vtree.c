@@ -1,4 +1,5 @@
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -47,6 +48,38 @@ vtree_t *vtree_list_find(vtree_list_t *vtree_list, const ast_type_t *signature){
     return NULL;
 }
 
+vtree_t *vtree_list_find_virtual(vtree_list_t *vtree_list, func_id_t virtual_ast_func_id, length_t *out_index){
+    for(length_t i = 0; i != vtree_list->length; i++){
+        vtree_t *vtree = vtree_list->vtrees[i];
+
+        for(length_t j = 0; j != vtree->virtuals.length; j++){
+            if(vtree->virtuals.endpoints[j].ast_func_id == virtual_ast_func_id){
+                length_t parent_table_size = vtree->parent ? vtree->parent->table.length : 0;
+                *out_index = parent_table_size + j;
+                return vtree;
+            }
+        }
+    }
+    return NULL;
+}
+
+bool vtree_sole_target(vtree_t *vtree, length_t index, func_id_t *out_ir_func_id){
+    if(index >= vtree->table.length) return false;
+
+    func_id_t ir_func_id = vtree->table.endpoints[index].ir_func_id;
+
+    for(length_t i = 0; i != vtree->children.length; i++){
+        func_id_t child_ir_func_id;
+
+        if(!vtree_sole_target(vtree->children.vtrees[i], index, &child_ir_func_id) || child_ir_func_id != ir_func_id){
+            return false;
+        }
+    }
+
+    *out_ir_func_id = ir_func_id;
+    return true;
+}
+
 void vtree_free_fully(vtree_t *vtree){
     // Free array of children
     free(vtree->children.vtrees);
@@ -17,6 +17,7 @@
 #include "PARSE/parse_meta.h"
 #include "PARSE/parse_namespace.h"
 #include "PARSE/parse_pragma.h"
+#include "PARSE/parse_soa.h"
 #include "PARSE/parse_struct.h"
 #include "PARSE/parse_util.h"
 #include "TOKEN/token_data.h"
@@ -62,6 +63,7 @@ errorcode_t parse_tokens(parse_ctx_t *ctx){
             }
             /* fall through */
         case TOKEN_FUNC: case TOKEN_STDCALL: case TOKEN_VERBATIM: case TOKEN_IMPLICIT: case TOKEN_CONSTRUCTOR: case TOKEN_VIRTUAL: case TOKEN_OVERRIDE:
+        case TOKEN_INLINE: case TOKEN_NOINLINE: case TOKEN_HOT: case TOKEN_COLD: case TOKEN_FLATTEN: case TOKEN_OPTIMIZE: case TOKEN_GENERATOR:
             if(parse_func(ctx)) return FAILURE;
             break;
         case TOKEN_FOREIGN: {
@@ -77,7 +79,7 @@ errorcode_t parse_tokens(parse_ctx_t *ctx){
                 }
             }
             break;
-        case TOKEN_STRUCT: case TOKEN_PACKED: case TOKEN_RECORD: case TOKEN_CLASS:
+        case TOKEN_STRUCT: case TOKEN_PACKED: case TOKEN_RECORD: case TOKEN_CLASS: case TOKEN_ALIGN: case TOKEN_COMPACT:
             if(parse_composite(ctx, false)) return FAILURE;
             break;
         case TOKEN_UNION:
@@ -96,7 +98,7 @@ errorcode_t parse_tokens(parse_ctx_t *ctx){
             break;
         case TOKEN_EXTERNAL: {
                 tokenid_t next = tokens[i + 1].id;
-                if(next == TOKEN_FUNC || next == TOKEN_STDCALL || next == TOKEN_VERBATIM || next == TOKEN_IMPLICIT){
+                if(next == TOKEN_FUNC || parse_func_is_prefix(next)){
                     if(parse_func(ctx)) return FAILURE;
                 } else {
                     if(parse_global(ctx)) return FAILURE;
@@ -115,6 +117,9 @@ errorcode_t parse_tokens(parse_ctx_t *ctx){
         case TOKEN_ENUM:
             if(parse_enum(ctx, false)) return FAILURE;
             break;
+        case TOKEN_SOA:
+            if(parse_soa(ctx)) return FAILURE;
+            break;
         case TOKEN_META:
             if(parse_meta(ctx)) return FAILURE;
             break;
@@ -11,6 +11,7 @@
 #include "PARSE/parse_type.h"
 #include "PARSE/parse_util.h"
 #include "TOKEN/token_data.h"
+#include "UTIL/builtin_type.h"
 #include "UTIL/ground.h"
 #include "UTIL/search.h"
 #include "UTIL/string.h"
@@ -57,7 +58,7 @@ errorcode_t parse_alias(parse_ctx_t *ctx){
     };
     length_t invalid_names_length = sizeof(invalid_names) / sizeof(const char*);
 
-    if(binary_string_search_const(invalid_names, invalid_names_length, name) != -1){
+    if(binary_string_search_const(invalid_names, invalid_names_length, name) != -1 || typename_vector_type(name) != -1){
         compiler_panicf(ctx->compiler, source, "Reserved type name '%s' can't be used to create an alias", name);
         goto failure;
     }
@@ -123,6 +123,19 @@ maybe_null_weak_cstr_t parse_eat_string(parse_ctx_t *ctx, const char *error){
     return NULL;
 }
 
+troolean parse_eat_likelihood(parse_ctx_t *ctx){
+    switch(parse_ctx_peek(ctx)){
+    case TOKEN_LIKELY:
+        *ctx->i += 1;
+        return TROOLEAN_TRUE;
+    case TOKEN_UNLIKELY:
+        *ctx->i += 1;
+        return TROOLEAN_FALSE;
+    default:
+        return TROOLEAN_UNKNOWN;
+    }
+}
+
 // =================================================
 //                   parse_take_*
 // =================================================
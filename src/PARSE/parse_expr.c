@@ -496,6 +496,7 @@ static tokenid_t parse_expr_has_terminating_token(tokenid_t id){
     case TOKEN_VA_END:
     case TOKEN_VA_START:
     case TOKEN_WHILE:
+    case TOKEN_YIELD:
         return id;
     }
 
@@ -516,10 +517,17 @@ static errorcode_t parse_expr_ternary(parse_ctx_t *ctx, ast_expr_t **inout_condi
     // "when true" expression
     ast_expr_t *expr_a;
 
+    // Allow newlines between '?' and when true expression
+    if(parse_ignore_newlines(ctx, "Unexpected end of expression")){
+        ast_expr_free_fully(*inout_condition);
+        return FAILURE;
+    }
+
+    // Optional 'likely' or 'unlikely' hint for whether the "when true" expression is chosen
+    troolean likely = parse_eat_likelihood(ctx);
+
     // Parse the "when true" expression
-    // (allowing newlines between '?' and when true expression)
-    if(parse_ignore_newlines(ctx, "Unexpected end of expression")
-    || parse_expr(ctx, &expr_a)){
+    if(parse_expr(ctx, &expr_a)){
         ast_expr_free_fully(*inout_condition);
         return FAILURE;
     }
@@ -548,7 +556,7 @@ static errorcode_t parse_expr_ternary(parse_ctx_t *ctx, ast_expr_t **inout_condi
     }
 
     // Construct and yield ternary expression
-    *inout_condition = ast_expr_create_ternary(*inout_condition, expr_a, expr_b, source);
+    *inout_condition = ast_expr_create_ternary(*inout_condition, expr_a, expr_b, likely, source);
     return SUCCESS;
 
 failure:
@@ -41,8 +41,8 @@ static errorcode_t add_dispatcher(parse_ctx_t *ctx, func_id_t virtual_origin){
 
     ast_t *ast = ctx->ast;
     func_id_t ast_func_id = ast_new_func(ast);
-    ast_func_t *func = &ast->funcs[ast_func_id];
-    ast_func_t *virtual = &ast->funcs[virtual_origin];
+    ast_func_t *func = ast_funcs_at(&ast->funcs, ast_func_id);
+    ast_func_t *virtual = ast_funcs_at(&ast->funcs, virtual_origin);
 
     if(virtual->traits & AST_FUNC_VARARG){
         compiler_panicf(ctx->compiler, virtual->source, "Virtual dispatcher cannot use old-style variadic arguments");
@@ -98,6 +98,38 @@ static errorcode_t add_dispatcher(parse_ctx_t *ctx, func_id_t virtual_origin){
     return SUCCESS;
 }
 
+static errorcode_t make_generator(parse_ctx_t *ctx, ast_func_t *func, bool is_constructor, source_t source){
+    // Turns a function into a generator.
+    // The declared type becomes the yield type, and the function
+    // itself returns a 'ptr' handle to the suspended coroutine
+
+    const char *reason = NULL;
+
+    if(func->traits & AST_FUNC_FOREIGN){
+        reason = "Foreign functions cannot be generators";
+    } else if(is_constructor){
+        reason = "Constructors cannot be generators";
+    } else if(func->traits & AST_FUNC_MAIN){
+        reason = "Entry point cannot be a generator";
+    } else if(func->traits & (AST_FUNC_VIRTUAL | AST_FUNC_OVERRIDE)){
+        reason = "Virtual methods cannot be generators";
+    } else if(func->traits & (AST_FUNC_DEFER | AST_FUNC_PASS)){
+        reason = "Management functions cannot be generators";
+    } else if(func->traits & (AST_FUNC_VARARG | AST_FUNC_VARIADIC)){
+        reason = "Generators cannot take a variable number of arguments";
+    }
+
+    if(reason){
+        compiler_panic(ctx->compiler, source, reason);
+        return FAILURE;
+    }
+
+    func->yield_type = func->return_type;
+    func->return_type = ast_type_make_base(strclone("ptr"));
+    func->return_type.source = func->yield_type.source;
+    return SUCCESS;
+}
+
 errorcode_t parse_func(parse_ctx_t *ctx){
     ast_t *ast = ctx->ast;
     token_t *tokens = ctx->tokenlist->tokens;
@@ -108,7 +140,7 @@ errorcode_t parse_func(parse_ctx_t *ctx){
         return parse_func_alias(ctx);
     }
 
-    if(ctx->ast->funcs_length >= MAX_FUNC_ID){
+    if(ctx->ast->funcs.length >= MAX_FUNC_ID){
         compiler_panic(ctx->compiler, source, "Maximum number of AST functions reached\n");
         return FAILURE;
     }
@@ -118,7 +150,7 @@ errorcode_t parse_func(parse_ctx_t *ctx){
     if(parse_func_head(ctx, &func_head, &func_head_parse_info)) return FAILURE;
 
     func_id_t ast_func_id = ast_new_func(ast);
-    ast_func_t *func = &ast->funcs[ast_func_id];
+    ast_func_t *func = ast_funcs_at(&ast->funcs, ast_func_id);
 
     ast_func_create_template(ctx->compiler, func, &func_head);
 
@@ -169,6 +201,10 @@ errorcode_t parse_func(parse_ctx_t *ctx){
         }
     }
 
+    if(func_head.prefixes.is_generator && make_generator(ctx, func, func_head_parse_info.is_constructor, source)){
+        return FAILURE;
+    }
+
     if(validate_func_requirements(ctx, func, source)){
         return FAILURE;
     }
@@ -236,7 +272,7 @@ void parse_func_solidify_constructor(compiler_t *compiler, ast_t *ast, ast_func_
     };
 
     func_id_t ast_func_id = ast_new_func(ast);
-    ast_func_t *func = &ast->funcs[ast_func_id];
+    ast_func_t *func = ast_funcs_at(&ast->funcs, ast_func_id);
 
     ast_func_create_template(compiler, func, &func_head);
 
@@ -296,7 +332,7 @@ errorcode_t parse_func_head(parse_ctx_t *ctx, ast_func_head_t *out_head, ast_fun
     source_t source = parse_ctx_peek_source(ctx);
 
     ast_func_prefixes_t prefixes;
-    parse_func_prefixes(ctx, &prefixes);
+    if(parse_func_prefixes(ctx, &prefixes)) return FAILURE;
 
     bool is_in_only_constructor = parse_eat(ctx, TOKEN_IN, NULL) == SUCCESS;
 
@@ -363,6 +399,81 @@ errorcode_t parse_func_head(parse_ctx_t *ctx, ast_func_head_t *out_head, ast_fun
     return SUCCESS;
 }
 
+static bool parse_func_body_skip_if_deferrable(parse_ctx_t *ctx, ast_func_t *func){
+    // When compiling lazily, bodies of functions from imported files are skipped over
+    // and only parsed if they're ever needed (see 'parse_func_body_on_demand').
+    // Fussy builds parse everything, so that syntax errors in unused functions are still reported
+    // NOTE: Expects '*ctx->i' to be the first token after the opening '{'
+
+    trait_t compiler_traits = ctx->compiler->traits;
+
+    if(!(compiler_traits & COMPILER_LAZY) || compiler_traits & COMPILER_FUSSY || ctx->object->index == 0){
+        return false;
+    }
+
+    token_t *tokens = ctx->tokenlist->tokens;
+    length_t tokens_length = ctx->tokenlist->length;
+    length_t depth = 1;
+
+    // Find the matching '}' by brace matching
+    for(length_t i = *ctx->i; i != tokens_length; i++){
+        switch(tokens[i].id){
+        case TOKEN_BEGIN:
+            depth++;
+            break;
+        case TOKEN_END:
+            if(--depth == 0){
+                func->traits |= AST_FUNC_UNPARSED_BODY;
+                func->unparsed_body_index = *ctx->i;
+                *ctx->i = i;
+                return true;
+            }
+            break;
+        case TOKEN_META:
+            // Meta directives depend on the state of the parser at this point, so parse normally
+            return false;
+        }
+    }
+
+    return false;
+}
+
+errorcode_t parse_func_body_on_demand(compiler_t *compiler, object_t *object, ast_func_t *func){
+    if(!(func->traits & AST_FUNC_UNPARSED_BODY)) return SUCCESS;
+
+    func->traits &= ~AST_FUNC_UNPARSED_BODY;
+
+    // Parse using the tokens of the file that the function is from
+    parse_ctx_t ctx;
+    parse_ctx_init(&ctx, compiler, compiler->objects[func->source.object_index]);
+    ctx.ast = &object->ast;
+    ctx.func = func;
+
+    // Constructors of classes need to know which class they belong to (for 'super'),
+    // which is found using the type of 'this' since it's no longer known by the parser
+    if(func->traits & AST_FUNC_CLASS_CONSTRUCTOR){
+        ast_type_t subject_type = ast_type_dereferenced_view(&func->arg_types[0]);
+        ctx.composite_association = (ast_poly_composite_t*) ast_find_composite(ctx.ast, &subject_type);
+        assert(ctx.composite_association);
+    }
+
+    length_t i = func->unparsed_body_index;
+    ctx.i = &i;
+
+    defer_scope_t defer_scope = defer_scope_create(NULL, NULL, TRAIT_NONE);
+    ast_expr_list_t stmts = ast_expr_list_create(16);
+
+    if(parse_stmts(&ctx, &stmts, &defer_scope, PARSE_STMTS_STANDARD)){
+        ast_expr_list_free(&stmts);
+        defer_scope_free(&defer_scope);
+        return FAILURE;
+    }
+
+    defer_scope_free(&defer_scope);
+    func->statements = stmts;
+    return SUCCESS;
+}
+
 errorcode_t parse_func_body(parse_ctx_t *ctx, ast_func_t *func){
     if(func->traits & AST_FUNC_FOREIGN) {
         #ifdef ADEPT_INSIGHT_BUILD
@@ -407,6 +518,16 @@ errorcode_t parse_func_body(parse_ctx_t *ctx, ast_func_t *func){
 
     if(parse_eat(ctx, TOKEN_BEGIN, "Expected '{' after function prototype")) return FAILURE;
 
+    if(parse_func_body_skip_if_deferrable(ctx, func)){
+        defer_scope_free(&defer_scope);
+
+        #ifdef ADEPT_INSIGHT_BUILD
+        func->end_source = parse_ctx_peek_source(ctx);
+        #endif
+
+        return SUCCESS;
+    }
+
     stmts = ast_expr_list_create(16);
     ctx->func = func;
 
@@ -784,9 +905,64 @@ void parse_func_grow_arguments(ast_func_t *func, length_t backfill, length_t *ca
     }
 }
 
-void parse_func_prefixes(parse_ctx_t *ctx, ast_func_prefixes_t *out_prefixes){
+static errorcode_t parse_func_optimization_prefix(parse_ctx_t *ctx, trait_t *inout_traits){
+    // optimize none
+    //    ^
+
+    source_t source = parse_ctx_peek_source(ctx);
+    *ctx->i += 1;
+
+    maybe_null_weak_cstr_t level = parse_eat_word(ctx, "Expected optimization level after 'optimize' keyword");
+    trait_t optimization;
+
+    if(level == NULL){
+        return FAILURE;
+    } else if(streq(level, "none")){
+        optimization = AST_FUNC_OPTIMIZE_NONE;
+    } else if(streq(level, "size")){
+        optimization = AST_FUNC_OPTIMIZE_SIZE;
+    } else if(streq(level, "aggressive")){
+        optimization = AST_FUNC_OPTIMIZE_AGGRESSIVE;
+    } else {
+        compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*ctx->i - 1], "Unrecognized optimization level '%s', valid levels are: 'none', 'size', 'aggressive'", level);
+        return FAILURE;
+    }
+
+    if(*inout_traits & AST_FUNC_OPTIMIZE_MASK){
+        compiler_panic(ctx->compiler, source, "Function cannot have more than one optimization level");
+        return FAILURE;
+    }
+
+    *inout_traits |= optimization;
+    return SUCCESS;
+}
+
+static errorcode_t parse_func_validate_performance_traits(parse_ctx_t *ctx, trait_t traits, source_t source){
+    if((traits & (AST_FUNC_ALWAYS_INLINE | AST_FUNC_NO_INLINE)) == (AST_FUNC_ALWAYS_INLINE | AST_FUNC_NO_INLINE)){
+        compiler_panic(ctx->compiler, source, "Function cannot be both 'inline' and 'noinline'");
+        return FAILURE;
+    }
+
+    if((traits & (AST_FUNC_HOT | AST_FUNC_COLD)) == (AST_FUNC_HOT | AST_FUNC_COLD)){
+        compiler_panic(ctx->compiler, source, "Function cannot be both 'hot' and 'cold'");
+        return FAILURE;
+    }
+
+    // Unoptimized functions are never inlined
+    if(traits & AST_FUNC_ALWAYS_INLINE && (traits & AST_FUNC_OPTIMIZE_MASK) == AST_FUNC_OPTIMIZE_NONE){
+        compiler_panic(ctx->compiler, source, "Function cannot be both 'inline' and 'optimize none'");
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+errorcode_t parse_func_prefixes(parse_ctx_t *ctx, ast_func_prefixes_t *out_prefixes){
     memset(out_prefixes, 0, sizeof(ast_func_prefixes_t));
 
+    source_t source = parse_ctx_peek_source(ctx);
+    trait_t *performance_traits = &out_prefixes->performance_traits;
+
     while(true){
         switch(parse_ctx_peek(ctx)){
         case TOKEN_STDCALL:  out_prefixes->is_stdcall  = true; break;
@@ -795,13 +971,34 @@ void parse_func_prefixes(parse_ctx_t *ctx, ast_func_prefixes_t *out_prefixes){
         case TOKEN_EXTERNAL: out_prefixes->is_external = true; break;
         case TOKEN_VIRTUAL:  out_prefixes->is_virtual = true; break;
         case TOKEN_OVERRIDE: out_prefixes->is_override = true; break;
-        default: return;
+        case TOKEN_INLINE:   *performance_traits |= AST_FUNC_ALWAYS_INLINE; break;
+        case TOKEN_NOINLINE: *performance_traits |= AST_FUNC_NO_INLINE; break;
+        case TOKEN_HOT:      *performance_traits |= AST_FUNC_HOT; break;
+        case TOKEN_COLD:     *performance_traits |= AST_FUNC_COLD; break;
+        case TOKEN_FLATTEN:  *performance_traits |= AST_FUNC_FLATTEN; break;
+        case TOKEN_GENERATOR: out_prefixes->is_generator = true; break;
+        case TOKEN_OPTIMIZE:
+            if(parse_func_optimization_prefix(ctx, performance_traits)) return FAILURE;
+            continue;
+        default:
+            return parse_func_validate_performance_traits(ctx, *performance_traits, source);
         }
 
         *ctx->i += 1;
     }
 }
 
+bool parse_func_is_prefix(tokenid_t id){
+    switch(id){
+    case TOKEN_STDCALL: case TOKEN_VERBATIM: case TOKEN_IMPLICIT: case TOKEN_EXTERNAL: case TOKEN_VIRTUAL: case TOKEN_OVERRIDE:
+    case TOKEN_INLINE: case TOKEN_NOINLINE: case TOKEN_HOT: case TOKEN_COLD: case TOKEN_FLATTEN: case TOKEN_OPTIMIZE:
+    case TOKEN_GENERATOR:
+        return true;
+    default:
+        return false;
+    }
+}
+
 void parse_free_unbackfilled_arguments(ast_func_t *func, length_t backfill){
     for(length_t i = 0; i != backfill; i++){
         free(func->arg_names[func->arity + backfill - i - 1]);
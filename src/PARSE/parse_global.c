@@ -46,6 +46,7 @@ errorcode_t parse_global(parse_ctx_t *ctx){
     
     ast_type_t type = {0};
     ast_expr_t *initial_value = NULL;
+    length_t alignment = 0;
     strong_cstr_t name = parse_take_word(ctx, "INTERNAL ERROR: Expected word");
 
     if(name == NULL) goto failure;
@@ -68,6 +69,8 @@ errorcode_t parse_global(parse_ctx_t *ctx){
     
     if(parse_type(ctx, &type)) goto failure;
 
+    if(parse_ctx_peek(ctx) == TOKEN_ALIGN && parse_alignment(ctx, &alignment)) goto failure;
+
     if(parse_eat(ctx, TOKEN_ASSIGN, NULL) == SUCCESS){
         if(parse_eat(ctx, TOKEN_UNDEF, NULL) == SUCCESS){
             // 'undef' does nothing for globals, so pretend like this is a plain definition
@@ -81,7 +84,7 @@ errorcode_t parse_global(parse_ctx_t *ctx){
         goto failure;
     }
 
-    ast_add_global(ast, name, type, initial_value, traits, source);
+    ast_add_global(ast, name, type, initial_value, traits, source)->alignment = alignment;
     return SUCCESS;
 
 failure:
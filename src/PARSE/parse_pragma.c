@@ -37,8 +37,8 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
         "__builtin_warn_bad_printf_format", "compiler_supports", "compiler_version", "default_stdlib", "deprecated", "disable_warnings", "dylib",
         "enable_warnings", "entry_point", "help", "ignore_all", "ignore_deprecation", "ignore_early_return", "ignore_obsolete",
         "ignore_partial_support", "ignore_unrecognized_directives", "ignore_unused", "libm", "linux_only", "mac_only", "mwindows",
-        "no_type_info", "no_typeinfo", "no_undef", "null_checks", "optimization", "options", "package", "project_name", "search_path",
-        "short_warnings", "unsafe_meta", "unsafe_new", "unsupported", "warn_as_error", "warn_short", "windowed", "windows_only", "windres"
+        "no_type_info", "no_typeinfo", "no_undef", "null_checks", "optimization", "options", "package", "project_name", "reorder_fields", "search_path",
+        "short_warnings", "strip_typeinfo", "unsafe_meta", "unsafe_new", "unsupported", "warn_as_error", "warn_short", "windowed", "windows_only", "windres"
     };
 
     const length_t directives_length = sizeof(directives) / sizeof(const char * const);
@@ -75,16 +75,18 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
     #define PRAGMA_OPTIONS                          0x0000001A
     #define PRAGMA_PACKAGE                          0x0000001B
     #define PRAGMA_PROJECT_NAME                     0x0000001C
-    #define PRAGMA_SEARCH_PATH                      0x0000001D
-    #define PRAGMA_SHORT_WARNINGS                   0x0000001E
-    #define PRAGMA_UNSAFE_META                      0x0000001F
-    #define PRAGMA_UNSAFE_NEW                       0x00000020
-    #define PRAGMA_UNSUPPORTED                      0x00000021
-    #define PRAGMA_WARN_AS_ERROR                    0x00000022
-    #define PRAGMA_WARN_SHORT                       0x00000023
-    #define PRAGMA_WINDOWED                         0x00000024
-    #define PRAGMA_WINDOWS_ONLY                     0x00000025
-    #define PRAGMA_WINDRES                          0x00000026
+    #define PRAGMA_REORDER_FIELDS                   0x0000001D
+    #define PRAGMA_SEARCH_PATH                      0x0000001E
+    #define PRAGMA_SHORT_WARNINGS                   0x0000001F
+    #define PRAGMA_STRIP_TYPEINFO                   0x00000020
+    #define PRAGMA_UNSAFE_META                      0x00000021
+    #define PRAGMA_UNSAFE_NEW                       0x00000022
+    #define PRAGMA_UNSUPPORTED                      0x00000023
+    #define PRAGMA_WARN_AS_ERROR                    0x00000024
+    #define PRAGMA_WARN_SHORT                       0x00000025
+    #define PRAGMA_WINDOWED                         0x00000026
+    #define PRAGMA_WINDOWS_ONLY                     0x00000027
+    #define PRAGMA_WINDRES                          0x00000028
 
     maybe_index_t directive = binary_string_search_const(directives, directives_length, directive_string);
 
@@ -172,7 +174,7 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
         return SUCCESS;
     case PRAGMA_DYLIB: { // 'dylib' directive
             // Don't allow changing the binary type after functions are declared
-            if(ctx->object->ast.funcs_length != 0){
+            if(ctx->object->ast.funcs.length != 0){
                 compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*i - 1], "Cannot change output type to dynamic library after functions are already defined");
                 return FAILURE;
             }
@@ -217,7 +219,7 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
         }
 
         // Don't allow changing the name of the entry point if functions are already defined
-        if(ctx->object->ast.funcs_length != 0){
+        if(ctx->object->ast.funcs.length != 0){
             compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*i - 1], "Cannot set entry point after functions are already defined");
             return FAILURE;
         }
@@ -333,12 +335,18 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
         free(ctx->compiler->output_filename);
         ctx->compiler->output_filename = filename_local(ctx->object->filename, read);
         return SUCCESS;
+    case PRAGMA_REORDER_FIELDS: // 'reorder_fields' directive
+        ctx->compiler->traits |= COMPILER_REORDER_FIELDS;
+        return SUCCESS;
     case PRAGMA_SEARCH_PATH: // 'search_path' directive
         read = parse_grab_string(ctx, "Expected search path 'pragma search_path'");
         if(read == NULL) return FAILURE;
 
         compiler_add_user_search_path(ctx->compiler, read, ctx->object->full_filename);
         return SUCCESS;
+    case PRAGMA_STRIP_TYPEINFO: // 'strip_typeinfo' directive
+        ctx->compiler->traits |= COMPILER_STRIP_TYPEINFO;
+        return SUCCESS;
     case PRAGMA_UNSAFE_META: // 'unsafe_meta' directive
         ctx->compiler->traits |= COMPILER_UNSAFE_META;
         return SUCCESS;
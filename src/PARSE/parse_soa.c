@@ -0,0 +1,71 @@
+
+#include <stdlib.h>
+
+#include "AST/ast.h"
+#include "AST/ast_type_lean.h"
+#include "DRVR/compiler.h"
+#include "LEX/token.h"
+#include "PARSE/parse_ctx.h"
+#include "PARSE/parse_soa.h"
+#include "PARSE/parse_type.h"
+#include "PARSE/parse_util.h"
+#include "TOKEN/token_data.h"
+#include "UTIL/builtin_type.h"
+#include "UTIL/ground.h"
+#include "UTIL/search.h"
+#include "UTIL/string.h"
+
+errorcode_t parse_soa(parse_ctx_t *ctx){
+    // soa Particles = 1024 Particle
+    //  ^
+
+    // NOTE: Assumes 'soa' keyword
+
+    ast_type_t type;
+    source_t source = ctx->tokenlist->sources[(*ctx->i)++];
+
+    if(ctx->composite_association != NULL){
+        compiler_panicf(ctx->compiler, source, "Cannot declare SoA container within struct domain");
+        return FAILURE;
+    }
+
+    maybe_null_strong_cstr_t name;
+
+    if(ctx->compiler->traits & COMPILER_COLON_COLON && ctx->prename){
+        name = ctx->prename;
+        ctx->prename = NULL;
+    } else {
+        name = parse_take_word(ctx, "Expected SoA container name after 'soa' keyword");
+    }
+
+    // Ensure we have a name for the SoA container
+    if(name == NULL) return FAILURE;
+
+    // Prepend namespace name
+    parse_prepend_namespace(ctx, &name);
+
+    const char *invalid_names[] = {
+        "Any", "AnyFixedArrayType", "AnyFuncPtrType", "AnyPtrType", "AnyStructType",
+        "AnyType", "AnyTypeKind", "String", "StringOwnership", "bool", "byte", "double", "float", "int", "long", "ptr",
+        "short", "successful", "ubyte", "uint", "ulong", "ushort", "usize", "void"
+    };
+    length_t invalid_names_length = sizeof(invalid_names) / sizeof(const char*);
+
+    if(binary_string_search_const(invalid_names, invalid_names_length, name) != -1 || typename_vector_type(name) != -1){
+        compiler_panicf(ctx->compiler, source, "Reserved type name '%s' can't be used to create an SoA container", name);
+        goto failure;
+    }
+
+    if(parse_eat(ctx, TOKEN_ASSIGN, "Expected '=' after SoA container name")
+    || parse_ignore_newlines(ctx, "Expected element type after '=' in SoA container")
+    || parse_type(ctx, &type)){
+        goto failure;
+    }
+
+    ast_add_soa(ctx->ast, name, type, source);
+    return SUCCESS;
+
+failure:
+    free(name);
+    return FAILURE;
+}
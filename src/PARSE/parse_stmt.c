@@ -70,6 +70,17 @@ void defer_scope_rewind(defer_scope_t *defer_scope, ast_expr_list_t *stmt_list,
     }
 }
 
+bool defer_scope_escapes_parallel(defer_scope_t *defer_scope, trait_t scope_trait, weak_cstr_t label){
+    for(; defer_scope; defer_scope = defer_scope->parent){
+        bool is_destination = (defer_scope->traits & scope_trait) && (label == NULL || (defer_scope->label && streq(defer_scope->label, label)));
+        if(is_destination) return false;
+
+        if(defer_scope->traits & PARALLEL_BODY) return true;
+    }
+
+    return false;
+}
+
 ast_expr_list_t defer_scope_unwind_completely(defer_scope_t *defer_scope){
     ast_expr_list_t list = ast_expr_list_create(defer_scope_total(defer_scope));
 
@@ -111,6 +122,11 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                 ast_expr_t *return_expression;
                 source = sources[(*i)++]; // Pass over return keyword
 
+                if(defer_scope_escapes_parallel(defer_scope, TRAIT_NONE, NULL)){
+                    compiler_panic(ctx->compiler, source, "Cannot return from inside of a parallel loop");
+                    return FAILURE;
+                }
+
                 if(tokens[*i].id == TOKEN_NEWLINE){
                     return_expression = NULL;
                 } else if(parse_expr(ctx, &return_expression)){
@@ -197,6 +213,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                 ast_expr_t *conditional = NULL;
                 trait_t stmts_mode;
                 maybe_null_weak_cstr_t label = NULL;
+                troolean likely = TROOLEAN_UNKNOWN;
 
                 *i += 1;
 
@@ -222,6 +239,9 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                         *i += 2;
                     }
 
+                    // Optional 'likely' or 'unlikely' hint for the condition
+                    likely = parse_eat_likelihood(ctx);
+
                     if(parse_expr(ctx, &conditional)) return FAILURE;
                 }
 
@@ -261,6 +281,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                     stmt->label = label;
                     stmt->value = NULL;
                     stmt->statements = while_stmt_list;
+                    stmt->likely = TROOLEAN_UNKNOWN;
                     ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) stmt);
                 } else {
                     // 'while <expr>' or 'until <expr>' loop
@@ -270,6 +291,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                     stmt->label = label;
                     stmt->value = conditional;
                     stmt->statements = while_stmt_list;
+                    stmt->likely = likely;
                     ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) stmt);
                 }
             }
@@ -371,8 +393,12 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                     return FAILURE;
                 }
 
+                // Parallel loops can only be continued, since iterations are independent
+                bool is_parallel = defer_scope->traits & PARALLEL_LOOP;
+                defer_scope->traits &= ~PARALLEL_LOOP;
+
                 ast_expr_list_t each_in_stmt_list = ast_expr_list_create(4);
-                defer_scope_t each_in_defer_scope = defer_scope_create(defer_scope, label, BREAKABLE | CONTINUABLE);
+                defer_scope_t each_in_defer_scope = defer_scope_create(defer_scope, label, is_parallel ? CONTINUABLE | PARALLEL_BODY : BREAKABLE | CONTINUABLE);
 
                 if(parse_stmts(ctx, &each_in_stmt_list, &each_in_defer_scope, stmts_mode)){
                     ast_expr_list_free(&each_in_stmt_list);
@@ -405,6 +431,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                 stmt->list = list_expr;
                 stmt->statements = each_in_stmt_list;
                 stmt->is_static = is_static;
+                stmt->parallel = (ast_parallel_t){ .is_parallel = is_parallel };
                 ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) stmt);
             }
             break;
@@ -451,8 +478,12 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                     return FAILURE;
                 }
 
+                // Parallel loops can only be continued, since iterations are independent
+                bool is_parallel = defer_scope->traits & PARALLEL_LOOP;
+                defer_scope->traits &= ~PARALLEL_LOOP;
+
                 ast_expr_list_t repeat_stmt_list = ast_expr_list_create(4);
-                defer_scope_t repeat_defer_scope = defer_scope_create(defer_scope, label, BREAKABLE | CONTINUABLE);
+                defer_scope_t repeat_defer_scope = defer_scope_create(defer_scope, label, is_parallel ? CONTINUABLE | PARALLEL_BODY : BREAKABLE | CONTINUABLE);
 
                 if(parse_stmts(ctx, &repeat_stmt_list, &repeat_defer_scope, stmts_mode)){
                     ast_expr_list_free(&repeat_stmt_list);
@@ -477,6 +508,7 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
                 stmt->statements = repeat_stmt_list;
                 stmt->is_static = is_static;
                 stmt->idx_name = idx_name;
+                stmt->parallel = (ast_parallel_t){ .is_parallel = is_parallel };
                 ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) stmt);
             }
             break;
@@ -503,6 +535,13 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
             }
             break;
         case TOKEN_BREAK: {
+                maybe_null_weak_cstr_t target_label = tokens[*i + 1].id == TOKEN_WORD ? tokens[*i + 1].data : NULL;
+
+                if(defer_scope_escapes_parallel(defer_scope, BREAKABLE, target_label)){
+                    compiler_panic(ctx->compiler, sources[*i], "Cannot break out of a parallel loop");
+                    return FAILURE;
+                }
+
                 if(tokens[++(*i)].id == TOKEN_WORD){
                     ast_expr_break_to_t *stmt = malloc(sizeof(ast_expr_break_to_t));
                     stmt->id = EXPR_BREAK_TO;
@@ -523,6 +562,13 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
             }
             break;
         case TOKEN_CONTINUE: {
+                maybe_null_weak_cstr_t target_label = tokens[*i + 1].id == TOKEN_WORD ? tokens[*i + 1].data : NULL;
+
+                if(defer_scope_escapes_parallel(defer_scope, CONTINUABLE, target_label)){
+                    compiler_panic(ctx->compiler, sources[*i], "Cannot continue a loop outside of the parallel loop");
+                    return FAILURE;
+                }
+
                 if(tokens[++(*i)].id == TOKEN_WORD){
                     ast_expr_continue_to_t *stmt = malloc(sizeof(ast_expr_continue_to_t));
                     stmt->id = EXPR_CONTINUE_TO;
@@ -543,6 +589,11 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
             }
             break;
         case TOKEN_FALLTHROUGH: {
+                if(defer_scope_escapes_parallel(defer_scope, FALLTHROUGHABLE, NULL)){
+                    compiler_panic(ctx->compiler, sources[*i], "Cannot fallthrough out of a parallel loop");
+                    return FAILURE;
+                }
+
                 ast_expr_fallthrough_t *stmt = malloc(sizeof(ast_expr_fallthrough_t));
 
                 *stmt = (ast_expr_fallthrough_t){
@@ -711,6 +762,15 @@ errorcode_t parse_stmts(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scop
         case TOKEN_ASSERT:
             if(parse_assert(ctx, stmt_list)) return FAILURE;
             break;
+        case TOKEN_ASSUME:
+            if(parse_assume(ctx, stmt_list)) return FAILURE;
+            break;
+        case TOKEN_YIELD:
+            if(parse_yield(ctx, stmt_list, defer_scope)) return FAILURE;
+            break;
+        case TOKEN_PARALLEL:
+            if(parse_parallel(ctx, stmt_list, defer_scope)) return FAILURE;
+            break;
         default:
             parse_panic_token(ctx, sources[*i], tokens[*i].id, "Encountered unexpected token '%s' at beginning of statement");
             return FAILURE;
@@ -866,6 +926,12 @@ errorcode_t parse_stmt_mid_declare(parse_ctx_t *ctx, ast_expr_list_t *stmt_list,
     unsigned int declare_stmt_type = EXPR_DECLARE;
     ast_expr_t *initial_value = NULL;
     optional_ast_expr_list_t inputs = {0};
+    length_t alignment = 0;
+
+    // Handle explicit alignment
+    if(parse_ctx_peek(ctx) == TOKEN_ALIGN && parse_alignment(ctx, &alignment)){
+        goto failure;
+    }
 
     // Handle initial value assignment
     if(parse_eat(ctx, TOKEN_ASSIGN, NULL) == SUCCESS){
@@ -897,7 +963,9 @@ errorcode_t parse_stmt_mid_declare(parse_ctx_t *ctx, ast_expr_list_t *stmt_list,
         ast_type_t type = is_last ? master_type : ast_type_clone(&master_type);
         ast_expr_t *value = is_last ? initial_value : ast_expr_clone_if_not_null(initial_value);
 
-        ast_expr_list_append(stmt_list, ast_expr_create_declaration(declare_stmt_type, source_list[i], names[i], type, traits, value, inputs));
+        ast_expr_declare_t *declaration = (ast_expr_declare_t*) ast_expr_create_declaration(declare_stmt_type, source_list[i], names[i], type, traits, value, inputs);
+        declaration->alignment = alignment;
+        ast_expr_list_append(stmt_list, (ast_expr_t*) declaration);
     }
 
     return SUCCESS;
@@ -939,8 +1007,14 @@ errorcode_t parse_switch(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_sco
                 ast_expr_t *condition;
                 source_t case_source = parse_ctx_peek_source(ctx);
                 
-                if( parse_eat(ctx, TOKEN_CASE, "Expected 'case' keyword for switch case")
-                 || parse_expr(ctx, &condition)
+                if(parse_eat(ctx, TOKEN_CASE, "Expected 'case' keyword for switch case")){
+                    goto failure;
+                }
+
+                // Optional 'likely' or 'unlikely' hint for whether the case is taken
+                troolean likely = parse_eat_likelihood(ctx);
+
+                if( parse_expr(ctx, &condition)
                  || parse_eat(ctx, TOKEN_NEXT, NULL) == ALT_FAILURE // Skip over ',' if present
                 ){
                     goto failure;
@@ -954,6 +1028,7 @@ errorcode_t parse_switch(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_sco
                     .condition = condition,
                     .source = case_source,
                     .statements = {0},
+                    .likely = likely,
                 });
 
                 list = &newest_case->statements;
@@ -1051,6 +1126,160 @@ failure:
     return FAILURE;
 }
 
+errorcode_t parse_assume(parse_ctx_t *ctx, ast_expr_list_t *stmt_list){
+    // assume <condition>
+    //   ^
+
+    source_t source = ctx->tokenlist->sources[(*ctx->i)++];
+    ast_expr_t *assumption;
+
+    if(parse_expr(ctx, &assumption)) return FAILURE;
+
+    ast_expr_list_append_unchecked(stmt_list, ast_expr_create_assume(source, assumption));
+    return SUCCESS;
+}
+
+errorcode_t parse_yield(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scope_t *defer_scope){
+    // yield <value>
+    //   ^
+
+    source_t source = ctx->tokenlist->sources[(*ctx->i)++];
+
+    if(ctx->func == NULL || !ast_func_is_generator(ctx->func)){
+        compiler_panic(ctx->compiler, source, "Cannot yield outside of a generator function");
+        return FAILURE;
+    }
+
+    if(defer_scope_escapes_parallel(defer_scope, TRAIT_NONE, NULL)){
+        compiler_panic(ctx->compiler, source, "Cannot yield from inside of a parallel loop");
+        return FAILURE;
+    }
+
+    ast_expr_t *value = NULL;
+
+    if(parse_ctx_peek(ctx) != TOKEN_NEWLINE && parse_expr(ctx, &value)){
+        return FAILURE;
+    }
+
+    // Keep copies of all pending deferred statements,
+    // in case the generator is destroyed while suspended here
+    ast_expr_list_t last_minute = ast_expr_list_create(defer_scope_total(defer_scope));
+
+    for(defer_scope_t *traverse = defer_scope; traverse; traverse = traverse->parent){
+        defer_scope_fulfill_by_cloning(traverse, &last_minute);
+    }
+
+    ast_expr_list_append_unchecked(stmt_list, ast_expr_create_yield(source, value, last_minute));
+    return SUCCESS;
+}
+
+static errorcode_t parse_reductions(parse_ctx_t *ctx, ast_parallel_t *parallel){
+    // reduce(+ sum, max highest)
+    //   ^
+
+    length_t *i = ctx->i;
+    token_t *tokens = ctx->tokenlist->tokens;
+    source_t *sources = ctx->tokenlist->sources;
+    length_t capacity = 0;
+
+    // Skip over 'reduce' and eat '('
+    (*i)++;
+    if(parse_eat(ctx, TOKEN_OPEN, "Expected '(' after 'reduce'")) return FAILURE;
+
+    do {
+        source_t source = sources[*i];
+        unsigned int op;
+
+        switch(tokens[*i].id){
+        case TOKEN_ADD:     op = EXPR_ADD;     break;
+        case TOKEN_BIT_AND: op = EXPR_BIT_AND; break;
+        case TOKEN_BIT_OR:  op = EXPR_BIT_OR;  break;
+        case TOKEN_BIT_XOR: op = EXPR_BIT_XOR; break;
+        case TOKEN_WORD:
+            if(streq(tokens[*i].data, "min")){
+                op = EXPR_LESSER;
+                break;
+            } else if(streq(tokens[*i].data, "max")){
+                op = EXPR_GREATER;
+                break;
+            }
+            /* fallthrough */
+        default:
+            compiler_panic(ctx->compiler, source, "Expected reduction operator, valid operators are '+', '&', '|', '^', 'min' and 'max'");
+            return FAILURE;
+        }
+
+        (*i)++;
+
+        weak_cstr_t name = parse_eat_word(ctx, "Expected name of variable to reduce");
+        if(name == NULL) return FAILURE;
+
+        for(length_t r = 0; r != parallel->reductions_length; r++){
+            if(streq(parallel->reductions[r].name, name)){
+                compiler_panicf(ctx->compiler, source, "Variable '%s' is already reduced by this loop", name);
+                return FAILURE;
+            }
+        }
+
+        expand((void**) &parallel->reductions, sizeof(ast_reduction_t), parallel->reductions_length, &capacity, 1, 4);
+
+        parallel->reductions[parallel->reductions_length++] = (ast_reduction_t){
+            .op = op,
+            .name = name,
+            .source = source,
+        };
+    } while(parse_eat(ctx, TOKEN_NEXT, NULL) == SUCCESS);
+
+    return parse_eat(ctx, TOKEN_CLOSE, "Expected ')' after reductions");
+}
+
+errorcode_t parse_parallel(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scope_t *defer_scope){
+    // parallel reduce(+ sum) each int in [values, count] { ... }
+    //    ^
+
+    length_t *i = ctx->i;
+    token_t *tokens = ctx->tokenlist->tokens;
+    source_t source = ctx->tokenlist->sources[(*i)++];
+
+    ast_parallel_t parallel = (ast_parallel_t){
+        .is_parallel = true,
+        .reductions = NULL,
+        .reductions_length = 0,
+    };
+
+    if(tokens[*i].id == TOKEN_WORD && streq(tokens[*i].data, "reduce") && parse_reductions(ctx, &parallel)){
+        ast_parallel_free(&parallel);
+        return FAILURE;
+    }
+
+    if(tokens[*i].id != TOKEN_EACH && tokens[*i].id != TOKEN_REPEAT){
+        compiler_panic(ctx->compiler, source, "Only 'each in' and 'repeat' loops can be parallel");
+        ast_parallel_free(&parallel);
+        return FAILURE;
+    }
+
+    // Parse the loop as a single statement, the loop will see
+    // that it is parallel by the trait of the intermediate defer scope
+    length_t loop_index = stmt_list->length;
+    defer_scope_t parallel_defer_scope = defer_scope_create(defer_scope, NULL, PARALLEL_LOOP);
+
+    if(parse_stmts(ctx, stmt_list, &parallel_defer_scope, PARSE_STMTS_SINGLE)){
+        defer_scope_free(&parallel_defer_scope);
+        ast_parallel_free(&parallel);
+        return FAILURE;
+    }
+
+    (*i)--; // Go back to newline because we used PARSE_STMTS_SINGLE
+    defer_scope_free(&parallel_defer_scope);
+
+    ast_expr_t *loop = stmt_list->statements[loop_index];
+    ast_parallel_t *loop_parallel = loop->id == EXPR_EACH_IN ? &((ast_expr_each_in_t*) loop)->parallel : &((ast_expr_repeat_t*) loop)->parallel;
+
+    ast_parallel_free(loop_parallel);
+    *loop_parallel = parallel;
+    return SUCCESS;
+}
+
 errorcode_t parse_onetime_conditional(parse_ctx_t *ctx, ast_expr_list_t *stmt_list, defer_scope_t *defer_scope){
     token_t *tokens = ctx->tokenlist->tokens;
     length_t *i = ctx->i;
@@ -1061,6 +1290,9 @@ errorcode_t parse_onetime_conditional(parse_ctx_t *ctx, ast_expr_list_t *stmt_li
     ast_expr_t *condition;
     trait_t stmts_mode;
 
+    // Optional 'likely' or 'unlikely' hint for the condition
+    troolean likely = parse_eat_likelihood(ctx);
+
     if(parse_expr(ctx, &condition)) return FAILURE;
 
     if(parse_ignore_newlines(ctx, "Expected '{' or ',' after conditional expression")){
@@ -1136,6 +1368,7 @@ errorcode_t parse_onetime_conditional(parse_ctx_t *ctx, ast_expr_list_t *stmt_li
         stmt->value = condition;
         stmt->statements = if_stmt_list;
         stmt->else_statements = else_stmt_list;
+        stmt->likely = likely;
         ast_expr_list_append_unchecked(stmt_list, (ast_expr_t*) stmt);
     } else {
         if(stmts_mode & PARSE_STMTS_SINGLE){
@@ -1144,7 +1377,7 @@ errorcode_t parse_onetime_conditional(parse_ctx_t *ctx, ast_expr_list_t *stmt_li
 
         ast_expr_list_append_unchecked(
             stmt_list,
-            ast_expr_create_simple_conditional(source, (conditional_type == TOKEN_UNLESS) ? EXPR_UNLESS : EXPR_IF, NULL, condition, if_stmt_list)
+            ast_expr_create_simple_conditional(source, (conditional_type == TOKEN_UNLESS) ? EXPR_UNLESS : EXPR_IF, NULL, condition, likely, if_stmt_list)
         );
     }
 
@@ -1585,6 +1818,7 @@ errorcode_t parse_block_beginning(parse_ctx_t *ctx, weak_cstr_t block_readable_m
     case TOKEN_VA_END:
     case TOKEN_VA_START:
     case TOKEN_WHILE:
+    case TOKEN_YIELD:
         // Specially allowed expression terminators
         *out_stmts_mode = PARSE_STMTS_SINGLE;
         return SUCCESS;
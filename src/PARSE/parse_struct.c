@@ -86,6 +86,29 @@ errorcode_t parse_composite(parse_ctx_t *ctx, bool is_union){
         return FAILURE;
     }
 
+    length_t alignment = 0;
+
+    if(parse_ctx_peek(ctx) == TOKEN_ALIGN){
+        if(parse_alignment(ctx, &alignment)) return FAILURE;
+
+        switch(parse_ctx_peek(ctx)){
+        case TOKEN_STRUCT: case TOKEN_PACKED: case TOKEN_RECORD: case TOKEN_CLASS: case TOKEN_COMPACT:
+            break;
+        case TOKEN_UNION:
+            is_union = true;
+            break;
+        default:
+            compiler_panic(ctx->compiler, source, "Expected composite definition after 'align' prefix, global variables are aligned using 'name Type align(N)'");
+            return FAILURE;
+        }
+    }
+
+    trait_t compact_traits = TRAIT_NONE;
+
+    if(parse_ctx_peek(ctx) == TOKEN_COMPACT){
+        if(parse_compact(ctx, &compact_traits)) return FAILURE;
+    }
+
     strong_cstr_t name;
     bool is_packed, is_record, is_class;
     strong_cstr_t *generics = NULL;
@@ -102,7 +125,7 @@ errorcode_t parse_composite(parse_ctx_t *ctx, bool is_union){
     };
     length_t invalid_names_length = sizeof(invalid_names) / sizeof(const char*);
 
-    if(binary_string_search_const(invalid_names, invalid_names_length, name) != -1){
+    if(binary_string_search_const(invalid_names, invalid_names_length, name) != -1 || typename_vector_type(name) != -1){
         compiler_panicf(ctx->compiler, source, "Reserved type name '%s' can't be used to create a %s", name, is_union ? "union" : "struct");
         goto body_failure;
     }
@@ -115,12 +138,13 @@ errorcode_t parse_composite(parse_ctx_t *ctx, bool is_union){
     }
 
     ast_composite_t *domain = NULL;
-    trait_t traits = is_packed ? AST_LAYOUT_PACKED : TRAIT_NONE;
+    trait_t traits = (is_packed ? AST_LAYOUT_PACKED : TRAIT_NONE) | compact_traits;
     ast_layout_kind_t layout_kind = is_union ? AST_LAYOUT_UNION : AST_LAYOUT_STRUCT;
 
     // AST type of composite being declared (if it's a record)
     ast_layout_t layout;
     ast_layout_init(&layout, layout_kind, field_map, skeleton, traits);
+    layout.alignment = alignment;
     
     if(generics){
         domain = (ast_composite_t*) ast_add_poly_composite(ast, name, layout, source, maybe_parent_class, is_class, generics, generics_length);
@@ -143,6 +167,52 @@ body_failure:
     return FAILURE;
 }
 
+errorcode_t parse_compact(parse_ctx_t *ctx, trait_t *out_traits){
+    // compact struct Name (...)
+    //    ^
+
+    source_t source = parse_ctx_peek_source(ctx);
+
+    // Eat 'compact' keyword
+    *ctx->i += 1;
+
+    *out_traits = AST_LAYOUT_COMPACT;
+
+    if(parse_ctx_peek(ctx) == TOKEN_OPEN){
+        *ctx->i += 1;
+
+        source_t option_source = parse_ctx_peek_source(ctx);
+        maybe_null_weak_cstr_t option = parse_eat_word(ctx, "Expected 'force' after 'compact('");
+        if(option == NULL) return FAILURE;
+
+        if(!streq(option, "force")){
+            compiler_panicf(ctx->compiler, option_source, "Unknown compact option '%s', the only option is 'force'", option);
+            return FAILURE;
+        }
+
+        if(parse_eat(ctx, TOKEN_CLOSE, "Expected ')' after 'compact(force'")) return FAILURE;
+
+        *out_traits |= AST_LAYOUT_COMPACT_FORCED;
+    }
+
+    switch(parse_ctx_peek(ctx)){
+    case TOKEN_STRUCT: case TOKEN_RECORD:
+        return SUCCESS;
+    case TOKEN_PACKED:
+        compiler_panic(ctx->compiler, source, "Packed structs cannot be compact, since they have no padding to remove");
+        return FAILURE;
+    case TOKEN_UNION:
+        compiler_panic(ctx->compiler, source, "Unions cannot be compact, since all of their fields share the same location");
+        return FAILURE;
+    case TOKEN_CLASS:
+        compiler_panic(ctx->compiler, source, "Classes cannot be compact, since subclasses must share the layout of their parent");
+        return FAILURE;
+    default:
+        compiler_panic(ctx->compiler, source, "Expected 'struct' or 'record' after 'compact' prefix");
+        return FAILURE;
+    }
+}
+
 errorcode_t parse_composite_domain(parse_ctx_t *ctx, ast_composite_t *composite){
     length_t anchor = *ctx->i;
 
@@ -179,6 +249,13 @@ bool parse_struct_is_function_like_beginning(tokenid_t token){
     case TOKEN_VERBATIM:
     case TOKEN_VIRTUAL:
     case TOKEN_OVERRIDE:
+    case TOKEN_INLINE:
+    case TOKEN_NOINLINE:
+    case TOKEN_HOT:
+    case TOKEN_COLD:
+    case TOKEN_FLATTEN:
+    case TOKEN_OPTIMIZE:
+    case TOKEN_GENERATOR:
         return true;
     default:
         return false;
@@ -381,7 +458,7 @@ errorcode_t parse_composite_field(
         return errorcode;
     }
 
-    if(leading_token == TOKEN_PACKED || leading_token == TOKEN_STRUCT || leading_token == TOKEN_UNION){
+    if(leading_token == TOKEN_ALIGN || leading_token == TOKEN_PACKED || leading_token == TOKEN_STRUCT || leading_token == TOKEN_UNION){
         // Anonymous struct/union
 
         if(*inout_backfill != 0){
@@ -411,12 +488,28 @@ errorcode_t parse_composite_field(
     ast_type_t field_type;
     if(parse_type(ctx, &field_type)) return FAILURE;
 
+    // Fields can be over-aligned via 'name Type align(N)',
+    // which applies to every field in the field list
+    length_t alignment = 0;
+
+    if(tokens[*i].id == TOKEN_ALIGN && parse_alignment(ctx, &alignment)){
+        ast_type_free(&field_type);
+        return FAILURE;
+    }
+
+    length_t fields_added = *inout_backfill + 1;
+
     while(*inout_backfill != 0){
         ast_layout_skeleton_add_type(inout_skeleton, ast_type_clone(&field_type));
         *inout_backfill -= 1;
     }
 
     ast_layout_skeleton_add_type(inout_skeleton, field_type);
+
+    for(length_t j = inout_skeleton->bones_length - fields_added; j != inout_skeleton->bones_length; j++){
+        inout_skeleton->bones[j].alignment = alignment;
+    }
+
     return SUCCESS;
 }
 
@@ -547,6 +640,7 @@ errorcode_t parse_composite_integrate_another(
 
         ast_field_map_add(inout_field_map, strclone(field_name), *inout_next_endpoint);
         ast_layout_skeleton_add_type(inout_skeleton, ast_type_clone(field_type));
+        inout_skeleton->bones[inout_skeleton->bones_length - 1].alignment = layout->skeleton.bones[i].alignment;
         ast_layout_endpoint_increment(inout_next_endpoint);
     }
 
@@ -568,15 +662,23 @@ errorcode_t parse_anonymous_composite(
     token_t *tokens = ctx->tokenlist->tokens;
     source_t *sources = ctx->tokenlist->sources;
 
+    length_t alignment = 0;
+    if(tokens[*i].id == TOKEN_ALIGN && parse_alignment(ctx, &alignment)) return FAILURE;
+
     bool is_packed = tokens[*i].id == TOKEN_PACKED;
     if(is_packed) (*i)++;
 
-    // Assumes either TOKEN_STRUCT or TOKEN_UNION
+    if(tokens[*i].id != TOKEN_STRUCT && tokens[*i].id != TOKEN_UNION){
+        compiler_panic(ctx->compiler, sources[*i], "Expected 'struct' or 'union' for anonymous composite");
+        return FAILURE;
+    }
+
     ast_layout_bone_kind_t bone_kind = tokens[*i].id == TOKEN_STRUCT ? AST_LAYOUT_BONE_KIND_STRUCT : AST_LAYOUT_BONE_KIND_UNION;
     (*i)++;
 
     trait_t bone_traits = is_packed ? AST_LAYOUT_BONE_PACKED : TRAIT_NONE;
     ast_layout_skeleton_t *child_skeleton = ast_layout_skeleton_add_child_skeleton(inout_skeleton, bone_kind, bone_traits);
+    inout_skeleton->bones[inout_skeleton->bones_length - 1].alignment = alignment;
     ast_layout_endpoint_t child_next_endpoint = *inout_next_endpoint;
 
     if(!ast_layout_endpoint_add_index(&child_next_endpoint, 0)){
@@ -647,7 +749,7 @@ errorcode_t parse_create_record_constructor(parse_ctx_t *ctx, weak_cstr_t name,
 
     // Add function
     func_id_t ast_func_id = ast_new_func(ast);
-    ast_func_t *func = &ast->funcs[ast_func_id];
+    ast_func_t *func = ast_funcs_at(&ast->funcs, ast_func_id);
 
     ast_func_create_template(ctx->compiler, func, &(ast_func_head_t){
         .name = strclone(name),
@@ -113,17 +113,24 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
             out_type->elements[out_type->elements_length] = (ast_elem_t*) func_elem;
         }
         break;
-    case TOKEN_PACKED: case TOKEN_STRUCT: case TOKEN_UNION: {
+    case TOKEN_ALIGN: case TOKEN_PACKED: case TOKEN_STRUCT: case TOKEN_UNION: {
             ast_field_map_t field_map;
             ast_layout_skeleton_t skeleton;
             trait_t traits = TRAIT_NONE;
             ast_layout_kind_t layout_kind;
+            length_t alignment = 0;
+
+            if(parse_ctx_peek(ctx) == TOKEN_ALIGN && parse_alignment(ctx, &alignment)) goto failure;
 
             if(parse_eat(ctx, TOKEN_PACKED, NULL) == SUCCESS){
                 traits |= AST_LAYOUT_PACKED;
             }
 
-            // Assumes token is either TOKEN_UNION or TOKEN_STRUCT
+            if(parse_ctx_peek(ctx) != TOKEN_STRUCT && parse_ctx_peek(ctx) != TOKEN_UNION){
+                compiler_panicf(ctx->compiler, sources[*i], "Expected 'struct' or 'union' for anonymous composite type");
+                goto failure;
+            }
+
             layout_kind = parse_ctx_peek(ctx) == TOKEN_UNION ? AST_LAYOUT_UNION : AST_LAYOUT_STRUCT;
             (*i)++;
 
@@ -136,6 +143,7 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
             layout_elem->id = AST_ELEM_LAYOUT;
             layout_elem->source = sources[*i];
             ast_layout_init(&layout_elem->layout, layout_kind, field_map, skeleton, traits);
+            layout_elem->layout.alignment = alignment;
 
             out_type->elements[out_type->elements_length] = (ast_elem_t*) layout_elem;
         }
@@ -382,6 +390,36 @@ failure:
     return FAILURE;
 }
 
+errorcode_t parse_alignment(parse_ctx_t *ctx, length_t *out_alignment){
+    // align(64)
+    //   ^
+
+    // Eat 'align' keyword
+    *ctx->i += 1;
+
+    if(parse_eat(ctx, TOKEN_OPEN, "Expected '(' after 'align' keyword")) return FAILURE;
+
+    source_t source = parse_ctx_peek_source(ctx);
+
+    if(parse_ctx_peek(ctx) != TOKEN_GENERIC_INT){
+        compiler_panic(ctx->compiler, source, "Expected integer alignment after 'align('");
+        return FAILURE;
+    }
+
+    adept_generic_int alignment = *((adept_generic_int*) parse_ctx_peek_data(ctx));
+    *ctx->i += 1;
+
+    if(alignment <= 0 || alignment > (1 << 29) || (alignment & (alignment - 1)) != 0){
+        compiler_panicf(ctx->compiler, source, "Alignment must be a power of two, got %lld", (long long) alignment);
+        return FAILURE;
+    }
+
+    if(parse_eat(ctx, TOKEN_CLOSE, "Expected ')' after alignment")) return FAILURE;
+
+    *out_alignment = (length_t) alignment;
+    return SUCCESS;
+}
+
 bool parse_can_type_start_with(tokenid_t id, bool allow_open_bracket){
     switch(id){
         case TOKEN_WORD:
@@ -392,6 +430,7 @@ bool parse_can_type_start_with(tokenid_t id, bool allow_open_bracket){
         case TOKEN_LESSTHAN:
         case TOKEN_FUNC:
         case TOKEN_STDCALL:
+        case TOKEN_ALIGN:
         case TOKEN_PACKED:
         case TOKEN_STRUCT:
         case TOKEN_UNION:
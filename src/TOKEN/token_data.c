@@ -79,93 +79,112 @@ const char *global_token_name_table[] = {
     "polycount",                          // 0x0000004A
     "POD keyword",                        // 0x0000004B
     "alias keyword",                      // 0x0000004C
-    "alignof keyword",                    // 0x0000004D
-    "and keyword",                        // 0x0000004E
-    "as keyword",                         // 0x0000004F
-    "assert keyword",                     // 0x00000050
-    "at keyword",                         // 0x00000051
-    "break keyword",                      // 0x00000052
-    "case keyword",                       // 0x00000053
-    "cast keyword",                       // 0x00000054
-    "class keyword",                      // 0x00000055
-    "const keyword",                      // 0x00000056
-    "constructor keyword",                // 0x00000057
-    "continue keyword",                   // 0x00000058
-    "def keyword",                        // 0x00000059
-    "default keyword",                    // 0x0000005A
-    "defer keyword",                      // 0x0000005B
-    "define keyword",                     // 0x0000005C
-    "delete keyword",                     // 0x0000005D
-    "each keyword",                       // 0x0000005E
-    "else keyword",                       // 0x0000005F
-    "embed keyword",                      // 0x00000060
-    "enum keyword",                       // 0x00000061
-    "exhaustive keyword",                 // 0x00000062
-    "extends keyword",                    // 0x00000063
-    "external keyword",                   // 0x00000064
-    "fallthrough keyword",                // 0x00000065
-    "false keyword",                      // 0x00000066
-    "for keyword",                        // 0x00000067
-    "foreign keyword",                    // 0x00000068
-    "func keyword",                       // 0x00000069
-    "funcptr keyword",                    // 0x0000006A
-    "global keyword",                     // 0x0000006B
-    "if keyword",                         // 0x0000006C
-    "implicit keyword",                   // 0x0000006D
-    "import keyword",                     // 0x0000006E
-    "in keyword",                         // 0x0000006F
-    "inout keyword",                      // 0x00000070
-    "llvm_asm keyword",                   // 0x00000071
-    "namespace keyword",                  // 0x00000072
-    "new keyword",                        // 0x00000073
-    "null keyword",                       // 0x00000074
-    "or keyword",                         // 0x00000075
-    "out keyword",                        // 0x00000076
-    "override keyword",                   // 0x00000077
-    "packed keyword",                     // 0x00000078
-    "pragma keyword",                     // 0x00000079
-    "private keyword",                    // 0x0000007A
-    "public keyword",                     // 0x0000007B
-    "record keyword",                     // 0x0000007C
-    "repeat keyword",                     // 0x0000007D
-    "return keyword",                     // 0x0000007E
-    "sizeof keyword",                     // 0x0000007F
-    "static keyword",                     // 0x00000080
-    "stdcall keyword",                    // 0x00000081
-    "struct keyword",                     // 0x00000082
-    "switch keyword",                     // 0x00000083
-    "thread_local keyword",               // 0x00000084
-    "true keyword",                       // 0x00000085
-    "typeinfo keyword",                   // 0x00000086
-    "typenameof keyword",                 // 0x00000087
-    "undef keyword",                      // 0x00000088
-    "union keyword",                      // 0x00000089
-    "unless keyword",                     // 0x0000008A
-    "until keyword",                      // 0x0000008B
-    "using keyword",                      // 0x0000008C
-    "va_arg keyword",                     // 0x0000008D
-    "va_copy keyword",                    // 0x0000008E
-    "va_end keyword",                     // 0x0000008F
-    "va_start keyword",                   // 0x00000090
-    "verbatim keyword",                   // 0x00000091
-    "virtual keyword",                    // 0x00000092
-    "while keyword",                      // 0x00000093
+    "align keyword",                      // 0x0000004D
+    "alignof keyword",                    // 0x0000004E
+    "and keyword",                        // 0x0000004F
+    "as keyword",                         // 0x00000050
+    "assert keyword",                     // 0x00000051
+    "assume keyword",                     // 0x00000052
+    "at keyword",                         // 0x00000053
+    "break keyword",                      // 0x00000054
+    "case keyword",                       // 0x00000055
+    "cast keyword",                       // 0x00000056
+    "class keyword",                      // 0x00000057
+    "cold keyword",                       // 0x00000058
+    "compact keyword",                    // 0x00000059
+    "const keyword",                      // 0x0000005A
+    "constructor keyword",                // 0x0000005B
+    "continue keyword",                   // 0x0000005C
+    "def keyword",                        // 0x0000005D
+    "default keyword",                    // 0x0000005E
+    "defer keyword",                      // 0x0000005F
+    "define keyword",                     // 0x00000060
+    "delete keyword",                     // 0x00000061
+    "each keyword",                       // 0x00000062
+    "else keyword",                       // 0x00000063
+    "embed keyword",                      // 0x00000064
+    "enum keyword",                       // 0x00000065
+    "exhaustive keyword",                 // 0x00000066
+    "extends keyword",                    // 0x00000067
+    "external keyword",                   // 0x00000068
+    "fallthrough keyword",                // 0x00000069
+    "false keyword",                      // 0x0000006A
+    "flatten keyword",                    // 0x0000006B
+    "for keyword",                        // 0x0000006C
+    "foreign keyword",                    // 0x0000006D
+    "func keyword",                       // 0x0000006E
+    "funcptr keyword",                    // 0x0000006F
+    "generator keyword",                  // 0x00000070
+    "global keyword",                     // 0x00000071
+    "hot keyword",                        // 0x00000072
+    "if keyword",                         // 0x00000073
+    "implicit keyword",                   // 0x00000074
+    "import keyword",                     // 0x00000075
+    "in keyword",                         // 0x00000076
+    "inline keyword",                     // 0x00000077
+    "inout keyword",                      // 0x00000078
+    "likely keyword",                     // 0x00000079
+    "llvm_asm keyword",                   // 0x0000007A
+    "namespace keyword",                  // 0x0000007B
+    "new keyword",                        // 0x0000007C
+    "noinline keyword",                   // 0x0000007D
+    "null keyword",                       // 0x0000007E
+    "optimize keyword",                   // 0x0000007F
+    "or keyword",                         // 0x00000080
+    "out keyword",                        // 0x00000081
+    "override keyword",                   // 0x00000082
+    "packed keyword",                     // 0x00000083
+    "parallel keyword",                   // 0x00000084
+    "pragma keyword",                     // 0x00000085
+    "private keyword",                    // 0x00000086
+    "public keyword",                     // 0x00000087
+    "record keyword",                     // 0x00000088
+    "repeat keyword",                     // 0x00000089
+    "return keyword",                     // 0x0000008A
+    "sizeof keyword",                     // 0x0000008B
+    "soa keyword",                        // 0x0000008C
+    "static keyword",                     // 0x0000008D
+    "stdcall keyword",                    // 0x0000008E
+    "struct keyword",                     // 0x0000008F
+    "switch keyword",                     // 0x00000090
+    "thread_local keyword",               // 0x00000091
+    "true keyword",                       // 0x00000092
+    "typeinfo keyword",                   // 0x00000093
+    "typenameof keyword",                 // 0x00000094
+    "undef keyword",                      // 0x00000095
+    "union keyword",                      // 0x00000096
+    "unless keyword",                     // 0x00000097
+    "unlikely keyword",                   // 0x00000098
+    "until keyword",                      // 0x00000099
+    "using keyword",                      // 0x0000009A
+    "va_arg keyword",                     // 0x0000009B
+    "va_copy keyword",                    // 0x0000009C
+    "va_end keyword",                     // 0x0000009D
+    "va_start keyword",                   // 0x0000009E
+    "verbatim keyword",                   // 0x0000009F
+    "virtual keyword",                    // 0x000000A0
+    "while keyword",                      // 0x000000A1
+    "yield keyword",                      // 0x000000A2
 };
 
-const char global_token_extra_format_table[] = "abccaaaaaaaaaaaaaaaaadddddddddddaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaabbaaaaaaabaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa";
+const char global_token_extra_format_table[] = "abccaaaaaaaaaaaaaaaaadddddddddddaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaabbaaaaaaabaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa";
 
 const char *global_token_keywords_list[] = {
     "POD",
     "alias",
+    "align",
     "alignof",
     "and",
     "as",
     "assert",
+    "assume",
     "at",
     "break",
     "case",
     "cast",
     "class",
+    "cold",
+    "compact",
     "const",
     "constructor",
     "continue",
@@ -183,24 +202,32 @@ const char *global_token_keywords_list[] = {
     "external",
     "fallthrough",
     "false",
+    "flatten",
     "for",
     "foreign",
     "func",
     "funcptr",
+    "generator",
     "global",
+    "hot",
     "if",
     "implicit",
     "import",
     "in",
+    "inline",
     "inout",
+    "likely",
     "llvm_asm",
     "namespace",
     "new",
+    "noinline",
     "null",
+    "optimize",
     "or",
     "out",
     "override",
     "packed",
+    "parallel",
     "pragma",
     "private",
     "public",
@@ -208,6 +235,7 @@ const char *global_token_keywords_list[] = {
     "repeat",
     "return",
     "sizeof",
+    "soa",
     "static",
     "stdcall",
     "struct",
@@ -219,6 +247,7 @@ const char *global_token_keywords_list[] = {
     "undef",
     "union",
     "unless",
+    "unlikely",
     "until",
     "using",
     "va_arg",
@@ -228,6 +257,7 @@ const char *global_token_keywords_list[] = {
     "verbatim",
     "virtual",
     "while",
+    "yield",
 };
 
-unsigned long long global_token_keywords_list_length = 73;
+unsigned long long global_token_keywords_list_length = 88;
@@ -10,3 +10,18 @@ const char * const global_primitives_extended[15] = {
     "bool", "byte", "double", "float", "int", "long", /* Extra */ "ptr",
     "short", "successful", "ubyte", "uint", "ulong", "ushort", "usize", /* Extra */ "void"
 };
+
+const char * const global_vector_types[20] = {
+    "f32x4", "f32x8", "f64x2", "f64x4", "i16x16", "i16x8", "i32x4", "i32x8", "i64x2", "i64x4",
+    "i8x16", "i8x32", "u16x16", "u16x8", "u32x4", "u32x8", "u64x2", "u64x4", "u8x16", "u8x32"
+};
+
+const char * const global_vector_type_elements[20] = {
+    "float", "float", "double", "double", "short", "short", "int", "int", "long", "long",
+    "byte", "byte", "ushort", "ushort", "uint", "uint", "ulong", "ulong", "ubyte", "ubyte"
+};
+
+const length_t global_vector_type_lanes[20] = {
+    4, 8, 2, 4, 16, 8, 4, 8, 2, 4,
+    16, 32, 16, 8, 4, 8, 2, 4, 16, 32
+};
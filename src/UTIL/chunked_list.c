@@ -0,0 +1,34 @@
+
+#include "UTIL/chunked_list.h"
+
+#include <stdlib.h>
+
+#include "UTIL/ground.h"
+#include "UTIL/util.h"
+
+void *chunked_list_append_new_impl(void *list_struct, length_t sizeof_element){
+    void_chunked_list_t *list = (void_chunked_list_t*) list_struct;
+
+    length_t chunk_index = list->length / CHUNKED_LIST_CHUNK_LENGTH;
+    length_t index_in_chunk = list->length % CHUNKED_LIST_CHUNK_LENGTH;
+
+    // Make room for new chunk (chunks are kept when the list is truncated, so reuse them if possible)
+    if(chunk_index == list->chunks_length){
+        expand((void**) &list->chunks, sizeof(void*), list->chunks_length, &list->chunks_capacity, 1, 4);
+        list->chunks[list->chunks_length++] = malloc(sizeof_element * CHUNKED_LIST_CHUNK_LENGTH);
+    }
+
+    // Return new item
+    list->length++;
+    return (void*) &(((char*) list->chunks[chunk_index])[index_in_chunk * sizeof_element]);
+}
+
+void chunked_list_free(void *list_struct){
+    void_chunked_list_t *list = (void_chunked_list_t*) list_struct;
+
+    for(length_t i = 0; i != list->chunks_length; i++){
+        free(list->chunks[i]);
+    }
+
+    free(list->chunks);
+}
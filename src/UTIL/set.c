@@ -32,6 +32,8 @@ void set_free(set_t *set, set_free_item_func_t optional_free_func){
             entry = next;
         }
     }
+
+    free(set->entries);
 }
 
 bool set_insert(set_t *set, void *item){
@@ -0,0 +1,241 @@
+
+#if defined(ADEPT_INSIGHT_BUILD) || defined(__EMSCRIPTEN__)
+#define THREAD_POOL_SERIAL_ONLY
+#elif defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "UTIL/ground.h"
+#include "UTIL/thread_pool.h"
+
+// Upper limit on the number of workers used for a single job
+#define THREAD_POOL_MAX_WORKERS 16
+
+// Number of workers that every job uses (if it has enough tasks), 0 if not forced
+static length_t thread_pool_forced_worker_count = 0;
+
+#ifndef THREAD_POOL_SERIAL_ONLY
+
+#ifdef _WIN32
+typedef CRITICAL_SECTION thread_pool_lock_t;
+#define thread_pool_lock_init(LOCK)    InitializeCriticalSection(LOCK)
+#define thread_pool_lock_destroy(LOCK) DeleteCriticalSection(LOCK)
+#define thread_pool_lock(LOCK)         EnterCriticalSection(LOCK)
+#define thread_pool_unlock(LOCK)       LeaveCriticalSection(LOCK)
+#else
+typedef pthread_mutex_t thread_pool_lock_t;
+#define thread_pool_lock_init(LOCK)    pthread_mutex_init(LOCK, NULL)
+#define thread_pool_lock_destroy(LOCK) pthread_mutex_destroy(LOCK)
+#define thread_pool_lock(LOCK)         pthread_mutex_lock(LOCK)
+#define thread_pool_unlock(LOCK)       pthread_mutex_unlock(LOCK)
+#endif
+
+// ---------------- thread_pool_range_t ----------------
+// Indices [next, end) that a worker hasn't run yet
+typedef struct {
+    thread_pool_lock_t lock;
+    length_t next;
+    length_t end;
+} thread_pool_range_t;
+
+// ---------------- thread_pool_job_t ----------------
+// Shared state of a job that is being run
+typedef struct {
+    thread_pool_range_t *ranges;
+    length_t worker_count;
+    thread_pool_task_t task;
+    void *data;
+} thread_pool_job_t;
+
+// ---------------- thread_pool_worker_t ----------------
+// Argument given to each worker thread
+typedef struct {
+    thread_pool_job_t *job;
+    length_t worker;
+} thread_pool_worker_t;
+
+static bool thread_pool_take(thread_pool_job_t *job, length_t worker, length_t *out_index){
+    thread_pool_range_t *own = &job->ranges[worker];
+
+    thread_pool_lock(&own->lock);
+    if(own->next != own->end){
+        *out_index = own->next++;
+        thread_pool_unlock(&own->lock);
+        return true;
+    }
+    thread_pool_unlock(&own->lock);
+
+    // Out of work, so steal the back half of what another worker has left
+    for(length_t i = 1; i != job->worker_count; i++){
+        thread_pool_range_t *victim = &job->ranges[(worker + i) % job->worker_count];
+
+        thread_pool_lock(&victim->lock);
+        length_t remaining = victim->end - victim->next;
+
+        if(remaining == 0){
+            thread_pool_unlock(&victim->lock);
+            continue;
+        }
+
+        length_t stolen = (remaining + 1) / 2;
+        length_t begin = victim->end - stolen;
+        victim->end = begin;
+        thread_pool_unlock(&victim->lock);
+
+        // Keep the first stolen index, the rest become our own share
+        thread_pool_lock(&own->lock);
+        own->next = begin + 1;
+        own->end = begin + stolen;
+        thread_pool_unlock(&own->lock);
+
+        *out_index = begin;
+        return true;
+    }
+
+    return false;
+}
+
+static void thread_pool_work(thread_pool_job_t *job, length_t worker){
+    length_t index;
+
+    while(thread_pool_take(job, worker, &index)){
+        job->task(job->data, worker, index);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI thread_pool_worker_main(LPVOID argument){
+    thread_pool_worker_t *worker = (thread_pool_worker_t*) argument;
+    thread_pool_work(worker->job, worker->worker);
+    return 0;
+}
+#else
+static void *thread_pool_worker_main(void *argument){
+    thread_pool_worker_t *worker = (thread_pool_worker_t*) argument;
+    thread_pool_work(worker->job, worker->worker);
+    return NULL;
+}
+#endif
+
+#endif // THREAD_POOL_SERIAL_ONLY
+
+static length_t thread_pool_hardware_concurrency(void){
+    #if defined(THREAD_POOL_SERIAL_ONLY)
+    return 1;
+    #elif defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (length_t) info.dwNumberOfProcessors : 1;
+    #else
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    return processors > 0 ? (length_t) processors : 1;
+    #endif
+}
+
+void thread_pool_force_worker_count(length_t worker_count){
+    thread_pool_forced_worker_count = worker_count;
+}
+
+length_t thread_pool_worker_count(length_t count, length_t min_tasks_per_worker){
+    if(thread_pool_forced_worker_count != 0){
+        length_t worker_count = thread_pool_forced_worker_count < count ? thread_pool_forced_worker_count : count;
+        return worker_count != 0 ? worker_count : 1;
+    }
+
+    length_t worker_count = thread_pool_hardware_concurrency();
+
+    if(worker_count > THREAD_POOL_MAX_WORKERS){
+        worker_count = THREAD_POOL_MAX_WORKERS;
+    }
+
+    if(min_tasks_per_worker != 0 && worker_count > count / min_tasks_per_worker){
+        worker_count = count / min_tasks_per_worker;
+    }
+
+    return worker_count != 0 ? worker_count : 1;
+}
+
+void thread_pool_run(length_t count, length_t worker_count, thread_pool_task_t task, void *data){
+    #ifdef THREAD_POOL_SERIAL_ONLY
+    worker_count = 1;
+    #endif
+
+    if(worker_count > count) worker_count = count;
+
+    if(worker_count <= 1){
+        for(length_t i = 0; i != count; i++){
+            task(data, 0, i);
+        }
+        return;
+    }
+
+    #ifndef THREAD_POOL_SERIAL_ONLY
+    thread_pool_job_t job = (thread_pool_job_t){
+        .ranges = malloc(sizeof(thread_pool_range_t) * worker_count),
+        .worker_count = worker_count,
+        .task = task,
+        .data = data,
+    };
+
+    for(length_t i = 0; i != worker_count; i++){
+        thread_pool_range_t *range = &job.ranges[i];
+        thread_pool_lock_init(&range->lock);
+        range->next = count * i / worker_count;
+        range->end = count * (i + 1) / worker_count;
+    }
+
+    thread_pool_worker_t *workers = malloc(sizeof(thread_pool_worker_t) * worker_count);
+
+    #ifdef _WIN32
+    HANDLE *threads = malloc(sizeof(HANDLE) * worker_count);
+    #else
+    pthread_t *threads = malloc(sizeof(pthread_t) * worker_count);
+    #endif
+
+    bool *started = calloc(worker_count, sizeof(bool));
+
+    // Worker 0 is the calling thread. If a thread fails to start,
+    // its share of the work will be stolen by the other workers
+    for(length_t i = 1; i != worker_count; i++){
+        workers[i] = (thread_pool_worker_t){
+            .job = &job,
+            .worker = i,
+        };
+
+        #ifdef _WIN32
+        threads[i] = CreateThread(NULL, 0, thread_pool_worker_main, &workers[i], 0, NULL);
+        started[i] = threads[i] != NULL;
+        #else
+        started[i] = pthread_create(&threads[i], NULL, thread_pool_worker_main, &workers[i]) == 0;
+        #endif
+    }
+
+    thread_pool_work(&job, 0);
+
+    for(length_t i = 1; i != worker_count; i++){
+        if(!started[i]) continue;
+
+        #ifdef _WIN32
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+        #else
+        pthread_join(threads[i], NULL);
+        #endif
+    }
+
+    for(length_t i = 0; i != worker_count; i++){
+        thread_pool_lock_destroy(&job.ranges[i].lock);
+    }
+
+    free(started);
+    free(threads);
+    free(workers);
+    free(job.ranges);
+    #endif // !THREAD_POOL_SERIAL_ONLY
+}
@@ -7,9 +7,47 @@ from framework import test, e2e_framework_run
 e2e_root_dir = dirname(abspath(__file__))
 src_dir = join(e2e_root_dir, "src")
 
+def llvm_function(llvmir, name):
+    # Returns the attributes and the 'define' line of a function in '--llvmir' output
+    lines = llvmir.splitlines()
+    for i, line in enumerate(lines):
+        if line.startswith(b"define ") and b" @" + name + b"(" in line:
+            attributes = lines[i - 1].split(b": ", 1)[1].split() if lines[i - 1].startswith(b"; Function Attrs:") else []
+            return set(attributes), line
+    return None, b""
+
+def has_inferred_function_attributes(llvmir):
+    # Functions are mangled as 'a<N>' in declaration order: square, getX, readCounter, bump, fact, makePoint, makeSavedPoint
+    # NOTE: LLVM 16+ spells 'readnone' and 'readonly' as 'memory(none)' and 'memory(read)'
+    readnone = lambda attributes: b"readnone" in attributes or b"memory(none)" in attributes
+    readonly = lambda attributes: b"readonly" in attributes or b"memory(read)" in attributes
+    square, getX, readCounter, bump, fact, makePoint, makeSavedPoint = [llvm_function(llvmir, b"a%d" % i) for i in range(1, 8)]
+
+    return (None not in [square[0], getX[0], readCounter[0], bump[0], fact[0], makePoint[0], makeSavedPoint[0]]
+        and readnone(square[0]) and b"willreturn" in square[0]
+        and readonly(getX[0]) and b"willreturn" in getX[0] and b"nonnull %0" in getX[1]
+        and readonly(readCounter[0]) and b"willreturn" in readCounter[0]
+        and not readnone(bump[0]) and not readonly(bump[0]) and b"willreturn" in bump[0]
+        and readnone(fact[0]) and b"willreturn" not in fact[0]
+        and b" noalias " in makePoint[1].split(b"@")[0]
+        and b" noalias " not in makeSavedPoint[1].split(b"@")[0])
+
+def has_fast_calling_convention_only_where_safe(llvmir):
+    # Functions are mangled as 'a<N>' in declaration order: 'Animal.legs' is a3, 'Dog.legs' is a6, 'add' is a7 and 'multiply' is a8
+    return (b"define private fastcc i32 @a7(i32 %0, i32 %1)" in llvmir and b"call fastcc i32 @a7(i32 2, i32 3)" in llvmir
+        and b"define private i32 @a8(i32 %0, i32 %1)" in llvmir and b"call i32 @a8(i32 6, i32 7)" in llvmir
+        and b"define private i32 @a3(" in llvmir and b"define private i32 @a6(" in llvmir
+        and b"define i32 @exportedTriple(i32 %0)" in llvmir and b"call i32 @exportedTriple(i32 8)" in llvmir
+        and b"define i32 @negate(i32 %0)" in llvmir and b"call i32 @negate(i32 9)" in llvmir
+        and b"call fastcc i32 %" not in llvmir)
+
 def run_all_tests():
     executable = sys.argv[1]
     compiles = lambda _: True
+    dumped_ir = lambda: open("ir.txt", "rb").read()
+    serial_outputs = {}
+    remember_serial_output = lambda name: lambda output: serial_outputs.setdefault(name, output) is not None
+    same_as_serial_output = lambda name: lambda output: output == serial_outputs[name]
     
     test("Adept",
         [executable],
@@ -18,6 +56,10 @@ def run_all_tests():
     test("address", [executable, join(src_dir, "address/main.adept")], compiles)
     test("aliases", [executable, join(src_dir, "aliases/main.adept")], compiles)
     test("aliases_polymorphic", [executable, join(src_dir, "aliases_polymorphic/main.adept")], compiles)
+    test("align", [executable, join(src_dir, "align/main.adept")], compiles)
+    test("align check output",
+        [join(src_dir, "align/main")],
+        lambda output: b"sizeof CacheLine = 64, alignof CacheLine = 64\nsizeof Counters = 128, alignof Counters = 64\nsizeof Mixed = 192, alignof Mixed = 64\nsizeof Vec = 16, alignof Vec = 16\nsizeof PackedAligned = 16, alignof PackedAligned = 8\nsizeof 4 CacheLine = 256\nCounters offsets: 0 64\nMixed offsets: 0 16 64 128 136\nPackedAligned offsets: 0 8\nmixed = 7 1.500000 100 2.000000 3.000000\nmixed.values misalignment = 0\nmixed.line misalignment = 0\npair = 1 2\nlocals misalignment = 0 0\nstatic misalignment = 0\nglobals misalignment = 0 0 0\nnew misalignment = 0 0 0\nnew zeroed = 0 0\n" in output)
     test("alignof", [executable, join(src_dir, "alignof/main.adept")], compiles)
     test("andor", [executable, join(src_dir, "andor/main.adept")], compiles)
     test("andor_circuit", [executable, join(src_dir, "andor_circuit/main.adept")], compiles)
@@ -44,10 +86,18 @@ def run_all_tests():
     test("assign_func_autogen", [executable, join(src_dir, "assign_func_autogen/main.adept")], compiles)
     test("assignment", [executable, join(src_dir, "assignment/main.adept")], compiles)
     test("at", [executable, join(src_dir, "at/main.adept")], compiles)
+    test("atomics", [executable, join(src_dir, "atomics/main.adept")], compiles)
+    test("atomics check output",
+        [join(src_dir, "atomics/main")],
+        lambda output: b"400000 -400000 400000\n2.0 30 40 10 1\n0 5 5\n1 5 9 9\n10 8\n" in output)
     test("bitwise", [executable, join(src_dir, "bitwise/main.adept")], compiles)
     test("bitwise_assign", [executable, join(src_dir, "bitwise_assign/main.adept")], compiles)
     test("break", [executable, join(src_dir, "break/main.adept")], compiles)
     test("break_to", [executable, join(src_dir, "break_to/main.adept")], compiles)
+    test("builtin_intrinsics", [executable, join(src_dir, "builtin_intrinsics/main.adept")], compiles)
+    test("builtin_intrinsics check output",
+        [join(src_dir, "builtin_intrinsics/main")],
+        lambda output: b"1 5 4 1\n3 3 24 63\n4 4 32\n3412 44332211\n18 18000000\n7.0 4.0\n72.0\n32\nlikely\n240\n" in output)
     test("cast", [executable, join(src_dir, "cast/main.adept")], compiles)
     test("character_literals", [executable, join(src_dir, "character_literals/main.adept")], compiles)
     test("circular_pointers", [executable, join(src_dir, "circular_pointers/main.adept")], compiles)
@@ -78,12 +128,20 @@ def run_all_tests():
         lambda output: b"main.adept:10:5: error: No corresponding virtual method exists to override\n  10|     override func myUnusedOverride {\n          ^^^^^^^^" in output,
         expected_exitcode=1)
     test("class_virtual_methods_9", [executable, join(src_dir, "class_virtual_methods_9/main.adept")], compiles)
+    test("class_virtual_methods_10", [executable, join(src_dir, "class_virtual_methods_10/main.adept")], compiles)
+    test("class_virtual_methods_10 check output",
+        [join(src_dir, "class_virtual_methods_10/main")],
+        lambda output: b"shape square rectangle square\n0 4 4 4\n" in output)
     test("colons_alternative_syntax", [executable, join(src_dir, "colons_alternative_syntax/main.adept")], compiles)
     test("complement", [executable, join(src_dir, "complement/main.adept")], compiles)
     test("complex_composite_rtti", [executable, join(src_dir, "complex_composite_rtti/main.adept")], compiles)
     test("conditionless_block", [executable, join(src_dir, "conditionless_block/main.adept")], compiles)
     test("conditionless_break_label", [executable, join(src_dir, "conditionless_break_label/main.adept")], compiles)
     test("const_variables", [executable, join(src_dir, "const_variables/main.adept")], compiles)
+    test("constant_folding", [executable, join(src_dir, "constant_folding/main.adept")], compiles)
+    test("constant_folding check output",
+        [join(src_dir, "constant_folding/main")],
+        lambda output: b"-2147483648 -3 -1 0\n0 0\n1 2 3 0\n" in output)
     test("constructor", [executable, join(src_dir, "constructor/main.adept")], compiles)
     test("constructor_in_only",
         [executable, join(src_dir, "constructor_in_only/main.adept")],
@@ -139,6 +197,16 @@ def run_all_tests():
     test("equals_func", [executable, join(src_dir, "equals_func/main.adept")], compiles)
     test("external", [executable, join(src_dir, "external/main.adept")], compiles)
     test("fallthrough", [executable, join(src_dir, "fallthrough/main.adept")], compiles)
+    test("fast_calling_convention",
+        [executable, join(src_dir, "fast_calling_convention/main.adept"), "--llvmir"],
+        has_fast_calling_convention_only_where_safe)
+    test("fast_calling_convention check output",
+        [join(src_dir, "fast_calling_convention/main")],
+        lambda output: b"5 20 42 24 -9 4\n" in output)
+    test("field_reordering", [executable, join(src_dir, "field_reordering/main.adept")], compiles)
+    test("field_reordering check output",
+        [join(src_dir, "field_reordering/main")],
+        lambda output: b"sizeof Loose = 40, sizeof Tight = 24\nsizeof Point = 24, sizeof Nested = 24\nsizeof <long> Generic = 16, sizeof Aligned = 32, alignof Aligned = 32\nsizeof 3 Tight = 72\nLoose offsets: 0 8 16 20 24 32\nTight offsets: 20 0 21 16 22 8\nNested offsets: 20 8 0 16\nAligned offsets: 12 0 8\ntight = 11 12 13 14 15 16.000000\ntight.a offset = 20\nliteral = 21 22 23 24 25 26.000000\nglobal = 1 2 3 4 5 6.000000\npoint = 1 2.500000 3 4.500000\nnested = 1 7 8 9\ngeneric = 1 2 3\nmany[2].d = 42, stride = 24\n" in output)
     test("fixed_array", [executable, join(src_dir, "fixed_array/main.adept")], compiles)
     test("fixed_array_alternative_syntax", [executable, join(src_dir, "fixed_array_alternative_syntax/main.adept")], compiles)
     test("fixed_array_assign", [executable, join(src_dir, "fixed_array_assign/main.adept")], compiles)
@@ -156,10 +224,30 @@ def run_all_tests():
     test("funcaddr_autogen_noop_defer", [executable, join(src_dir, "funcaddr_autogen_noop_defer/main.adept")], compiles)
     test("funcaddrnull", [executable, join(src_dir, "funcaddrnull/main.adept")], compiles)
     test("funcptr", [executable, join(src_dir, "funcptr/main.adept")], compiles)
+    test("function_attributes",
+        [executable, join(src_dir, "function_attributes/main.adept"), "--llvmir"],
+        has_inferred_function_attributes)
+    test("function_attributes check output",
+        [join(src_dir, "function_attributes/main")],
+        lambda output: b"16 3 120 0 1\n5 7 0\n" in output)
     test("functions", [executable, join(src_dir, "functions/main.adept")], compiles)
+    test("generators", [executable, join(src_dir, "generators/main.adept")], compiles)
+    test("generators check output",
+        [join(src_dir, "generators/main")],
+        lambda output: b"sum 55\n0 1 1 2 3 5 8 13 21 34 55 89 \ngot 0 (idx 0)\n[step 0 done]\ngot 10 (idx 1)\n[step 1 done]\nnoisy cleanup\ntick 0\ntick 1\ntick 2\n1.500000\n1.500000\n1\n2\ndone 1\n" in output)
     test("globals", [executable, join(src_dir, "globals/main.adept")], compiles)
+    test("globals_static_init", [executable, join(src_dir, "globals_static_init/main.adept")], compiles)
+    test("globals_static_init check output",
+        [join(src_dir, "globals_static_init/main")],
+        lambda output: b"43 1.500000 hi 8 1 42 0\n" in output)
     test("hello_world", [executable, join(src_dir, "hello_world/main.adept")], compiles)
     test("hexadecimal", [executable, join(src_dir, "hexadecimal/main.adept")], compiles)
+    test("identical_code_folding",
+        [executable, join(src_dir, "identical_code_folding/main.adept"), "--dump"],
+        lambda _: dumped_ir().count(b"\nfn sum ") == 1 and dumped_ir().count(b"\nfn sumTwice ") == 1)
+    test("identical_code_folding check output",
+        [join(src_dir, "identical_code_folding/main")],
+        lambda output: b"3 7 6 14 11\n5 11 0\n2:1 4:2 9:3 12:3 \n" in output)
     test("idx_manipulation", [executable, join(src_dir, "idx_manipulation/main.adept")], compiles)
     test("if", [executable, join(src_dir, "if/main.adept")], compiles)
     test("ifelse", [executable, join(src_dir, "ifelse/main.adept")], compiles)
@@ -178,6 +266,39 @@ def run_all_tests():
     test("int_to_float_promotion_in_math", [executable, join(src_dir, "int_to_float_promotion_in_math/main.adept")], compiles)
     test("internal_deference", [executable, join(src_dir, "internal_deference/main.adept")], compiles)
     test("internal_deference_generic", [executable, join(src_dir, "internal_deference_generic/main.adept")], compiles)
+    test("ir_passes",
+        [executable, join(src_dir, "ir_passes/main.adept"), "--dump"],
+        lambda _: b'"%d %d %d %d %d\\n\\0", s32 2,' in dumped_ir() and b"|\n    0x00000000 br |" not in dumped_ir())
+    test("ir_passes check output",
+        [join(src_dir, "ir_passes/main")],
+        lambda output: b"2 6 30 2 1\n" in output)
+    test("ir_passes disabled",
+        [executable, join(src_dir, "ir_passes/main.adept"), "--dump", "--no-ir-passes"],
+        lambda _: b'"%d %d %d %d %d\\n\\0", s32 >|0|' in dumped_ir() and b"|\n    0x00000000 br |" in dumped_ir())
+    test("ir_passes disabled check output",
+        [join(src_dir, "ir_passes/main")],
+        lambda output: b"2 6 30 2 1\n" in output)
+    test("ir_passes without forwarding",
+        [executable, join(src_dir, "ir_passes/main.adept"), "--dump", "--no-ir-pass=forward"],
+        lambda _: b'"%d %d %d %d %d\\n\\0", s32 >|0|' in dumped_ir() and b"|\n    0x00000000 br |" not in dumped_ir())
+    test("lazy", [executable, join(src_dir, "lazy/main.adept"), "--lazy"], compiles)
+    test("lazy check output",
+        [join(src_dir, "lazy/main")],
+        lambda output: b"9 5\n" in output)
+    test("lazy_imports", [executable, join(src_dir, "lazy_imports/main.adept"), "--lazy"], compiles)
+    test("lazy_imports check output",
+        [join(src_dir, "lazy_imports/main")],
+        lambda output: b"6 9 7\n" in output)
+    test("lazy_imports fussy",
+        [executable, join(src_dir, "lazy_imports/main.adept"), "--lazy", "--fussy"],
+        lambda output: b"library.adept:21:24: error:" in output,
+        expected_exitcode=1)
+    test("likelihood_hints",
+        [executable, join(src_dir, "likelihood_hints/main.adept"), "--llvmir"],
+        lambda output: b'!{!"branch_weights", i32 100, i32 2000, i32 1, i32 100}' in output and b"call void @llvm.assume(i1 " in output)
+    test("likelihood_hints check output",
+        [join(src_dir, "likelihood_hints/main")],
+        lambda output: b"1109 5\nfive\nzero one two many\n" in output)
     test("list_map", [executable, join(src_dir, "list_map/main.adept")], compiles)
     test("llvm_asm", [executable, join(src_dir, "llvm_asm/main.adept")], compiles)
     test("loose_struct_syntax", [executable, join(src_dir, "loose_struct_syntax/main.adept")], compiles)
@@ -228,7 +349,42 @@ def run_all_tests():
         lambda output: b"123456789\n" in output
     )
     test("order", [executable, join(src_dir, "order/main.adept")], compiles)
+    test("parallel_bodies serial",
+        [executable, join(src_dir, "parallel_bodies/main.adept"), "--llvmir"],
+        remember_serial_output("parallel_bodies"))
+    test("parallel_bodies with workers",
+        [executable, join(src_dir, "parallel_bodies/main.adept"), "--llvmir", "--workers=4"],
+        same_as_serial_output("parallel_bodies"))
+    test("parallel_bodies check output",
+        [join(src_dir, "parallel_bodies/main")],
+        lambda output: b"10 12 15 12\n4.5 7.5\n22 23 24\n3.0 5.0\n46\n[drop 7][drop 8][drop 7][drop 8]\n30\nfizz other buzz\nfizz buzz other\n4 3.0 8\n30\n[drop 1][drop 2]" in output)
+    test("parallel_inference serial",
+        [executable, join(src_dir, "parallel_inference/main.adept")],
+        remember_serial_output("parallel_inference"),
+        expected_exitcode=1)
+    test("parallel_inference with workers",
+        [executable, join(src_dir, "parallel_inference/main.adept"), "--workers=4"],
+        lambda output: b"main.adept:165:5: error: Undeclared variable 'missingVariable'" in output and output.count(b"warning:") == 39 and same_as_serial_output("parallel_inference")(output),
+        expected_exitcode=1)
+    test("parallel_inference -Werror serial",
+        [executable, join(src_dir, "parallel_inference/main.adept"), "-Werror"],
+        remember_serial_output("parallel_inference -Werror"),
+        expected_exitcode=1)
+    test("parallel_inference with workers and -Werror",
+        [executable, join(src_dir, "parallel_inference/main.adept"), "-Werror", "--workers=4"],
+        lambda output: b"main.adept:11:5: error: 'unused0' is never used" in output and same_as_serial_output("parallel_inference -Werror")(output),
+        expected_exitcode=1)
+    test("parallel_loops", [executable, join(src_dir, "parallel_loops/main.adept")], compiles)
+    test("parallel_loops check output",
+        [join(src_dir, "parallel_loops/main")],
+        lambda output: b"sum 499500\nlo 0 hi 294 total 7350\ngrid 1344\nbits 1048575\n" in output)
     test("pass_func", [executable, join(src_dir, "pass_func/main.adept")], compiles)
+    test("performance_prefixes",
+        [executable, join(src_dir, "performance_prefixes/main.adept"), "--llvmir"],
+        lambda output: all(attribute in output for attribute in [b"alwaysinline", b"cold noinline", b"optnone", b"optsize"]))
+    test("performance_prefixes check output",
+        [join(src_dir, "performance_prefixes/main")],
+        lambda output: b"7 25 8\n20 2 42\n15 42 3.0\n" in output)
     test("permissive_blocks", [executable, join(src_dir, "permissive_blocks/main.adept")], compiles)
     test("poly_default_args", [executable, join(src_dir, "poly_default_args/main.adept")], compiles)
     test("poly_prereq_extends", [executable, join(src_dir, "poly_prereq_extends/main.adept")], compiles)
@@ -264,16 +420,28 @@ def run_all_tests():
     test("return_ten", [executable, join(src_dir, "return_ten/main.adept")], compiles)
     test("rtti_enum",
         [executable, join(src_dir, "rtti_enum/main.adept"), "-e"],
-        lambda output: b"Information about every enum used:\n  AnyTypeKind : ['VOID', 'BOOL', 'BYTE', 'UBYTE', 'SHORT', 'USHORT', 'INT', 'UINT', 'LONG', 'ULONG', 'FLOAT', 'DOUBLE', 'PTR', 'STRUCT', 'UNION', 'FUNC_PTR', 'FIXED_ARRAY', 'ENUM']\n  MyEnum : ['NONE', 'ERROR', 'WARNING', 'INFO', 'ICON']\n  Ownership : ['REFERENCE', 'OWN', 'GIVEN', 'DONOR']\n  StringOwnership : ['REFERENCE', 'OWN', 'GIVEN', 'DONOR']\n  StringReplaceNothingBehavior : ['OR_CLONE', 'OR_VIEW']\n" in output
+        lambda output: b"Information about every enum used:\n  AnyTypeKind : ['VOID', 'BOOL', 'BYTE', 'UBYTE', 'SHORT', 'USHORT', 'INT', 'UINT', 'LONG', 'ULONG', 'FLOAT', 'DOUBLE', 'PTR', 'STRUCT', 'UNION', 'FUNC_PTR', 'FIXED_ARRAY', 'ENUM', 'VECTOR']\n  MyEnum : ['NONE', 'ERROR', 'WARNING', 'INFO', 'ICON']\n  Ownership : ['REFERENCE', 'OWN', 'GIVEN', 'DONOR']\n  StringOwnership : ['REFERENCE', 'OWN', 'GIVEN', 'DONOR']\n  StringReplaceNothingBehavior : ['OR_CLONE', 'OR_VIEW']\n" in output
+    )
+    test("rtti_strip",
+        [executable, join(src_dir, "rtti_strip/main.adept"), "-e"],
+        lambda output: b"Point 3\n  x int 0\n  y float 4\n  pair Pair 8\nPair ushort ubyte\ndouble 8\n*Pair Pair 4\n" in output
     )
     test("runtime_resource", [executable, join(src_dir, "runtime_resource/main.adept")], compiles)
     test("scientific", [executable, join(src_dir, "scientific/main.adept")], compiles)
     test("scoped_variables", [executable, join(src_dir, "scoped_variables/main.adept")], compiles)
     test("search_path", [executable, join(src_dir, "search_path/main.adept")], compiles)
+    test("simd_vectors", [executable, join(src_dir, "simd_vectors/main.adept")], compiles)
+    test("simd_vectors check output",
+        [join(src_dir, "simd_vectors/main")],
+        lambda output: b"3.0 5.0 7.0 9.0\n-1 -1 0 0\n1.0 2.0 7.0 9.0\n4.0 3.0 5.0 3.0\n10.0 9.0 3.0\n155 107 -9\n3F800000\n44\n" in output)
     test("similar", [executable, join(src_dir, "similar/main.adept")], compiles)
     test("sizeof", [executable, join(src_dir, "sizeof/main.adept")], compiles)
     test("sizeof_value", [executable, join(src_dir, "sizeof_value/main.adept")], compiles)
     test("small_functions", [executable, join(src_dir, "small_functions/main.adept")], compiles)
+    test("soa", [executable, join(src_dir, "soa/main.adept")], compiles)
+    test("soa check output",
+        [join(src_dir, "soa/main")],
+        lambda output: b"sizeof Particle = 32, sizeof Particles = 88\nParticles offsets: 0 16 32 36 56\nx column = 0.000000 1.000000 2.000000 3.000000\nx stride = 4\nparticles[3] = 3.000000 30.000000 0 103 4.500000\ngathered = 2.000000 20.000000 1 102 3.000000\nx column = 0.500000 1.500000 2.500000 3.500000\ntotal mass = 12.000000, last.id = 103\ncontainer = 42, global = 7.000000 0.000000\n" in output)
     test("standard", [executable, join(src_dir, "standard/main.adept")], compiles)
     test("static_arrays", [executable, join(src_dir, "static_arrays/main.adept")], compiles)
     test("static_structs", [executable, join(src_dir, "static_structs/main.adept")], compiles)